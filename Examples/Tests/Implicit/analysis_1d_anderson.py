@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+#
+# This is a script that analyses the simulation results from the script `inputs_1d`
+# run with Anderson acceleration of the Picard solver (picard.anderson_depth = 3).
+# - With the time step of `inputs_1d`, the Picard iterations must converge, so that energy
+#   is conserved to near machine precision as with plain Picard iterations.
+# - With a time step close to the stability limit of plain Picard iterations, the same number
+#   of Anderson-accelerated iterations must conserve energy better than plain Picard iterations.
+import glob
+import os
+import sys
+
+import numpy as np
+
+
+def max_energy_change(path):
+    field_energy = np.loadtxt(path + 'field_energy.txt', skiprows=1)
+    particle_energy = np.loadtxt(path + 'particle_energy.txt', skiprows=1)
+    total_energy = field_energy[:,2] + particle_energy[:,2]
+    delta_E = (total_energy - total_energy[0])/total_energy[0]
+    return np.abs(delta_E).max()
+
+def run(executable, name, params):
+    path = 'diags/' + name + '/'
+    os.system("./" + executable + " inputs_1d " + params +
+              " diag1.file_prefix=diags/" + name + "_" +
+              " field_energy.path=" + path + " particle_energy.path=" + path)
+    return max_energy_change(path)
+
+# this will be the name of the plot file
+fn = sys.argv[1]
+
+max_delta_E = max_energy_change('diags/reducedfiles/')
+
+# This case should have near machine precision conservation of energy
+tolerance_rel = 1.e-14
+
+print(f"max change in energy: {max_delta_E}")
+print(f"tolerance: {tolerance_rel}")
+
+assert( max_delta_E < tolerance_rel )
+
+executables = glob.glob("*.ex")
+assert(len(executables) == 1)
+
+large_dt = "max_step=20 my_constants.dt=1.5/wpe picard.max_iterations=10"
+max_delta_E_anderson = run(executables[0], "anderson", large_dt + " picard.anderson_depth=3")
+max_delta_E_plain = run(executables[0], "plain", large_dt + " picard.anderson_depth=0")
+
+print(f"max change in energy with wpe*dt = 1.5, Anderson: {max_delta_E_anderson}, plain: {max_delta_E_plain}")
+
+assert( max_delta_E_anderson < max_delta_E_plain )
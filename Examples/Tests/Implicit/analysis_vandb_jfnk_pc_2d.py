@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+#
+# This is a script that analyses the simulation results from the script `inputs_vandb_jfnk_2d`
+# run with the curl-curl MLMG preconditioner of the GMRES solver (jacobian.pc_type = pc_curl_curl_mlmg).
+# The preconditioner must not change the converged solution: energy and charge must be conserved
+# to near machine precision as without preconditioner, and the Newton solver must converge
+# in fewer GMRES iterations than without preconditioner.
+import glob
+import os
+import re
+import sys
+
+import numpy as np
+import yt
+from scipy.constants import e, epsilon_0
+
+# this will be the name of the plot file
+fn = sys.argv[1]
+
+field_energy = np.loadtxt('diags/reducedfiles/field_energy.txt', skiprows=1)
+particle_energy = np.loadtxt('diags/reducedfiles/particle_energy.txt', skiprows=1)
+
+total_energy = field_energy[:,2] + particle_energy[:,2]
+
+delta_E = (total_energy - total_energy[0])/total_energy[0]
+max_delta_E = np.abs(delta_E).max()
+
+# This case should have near machine precision conservation of energy
+tolerance_rel_energy = 2.e-14
+tolerance_rel_charge = 2.e-15
+
+print(f"max change in energy: {max_delta_E}")
+print(f"tolerance: {tolerance_rel_energy}")
+
+assert( max_delta_E < tolerance_rel_energy )
+
+# check for machine precision conservation of charge density
+n0 = 1.e30
+
+ds = yt.load(fn)
+data = ds.covering_grid(level = 0, left_edge = ds.domain_left_edge, dims = ds.domain_dimensions)
+
+divE = data['boxlib', 'divE'].value
+rho  = data['boxlib', 'rho'].value
+
+# compute local error in Gauss's law
+drho = (rho - epsilon_0*divE)/e/n0
+
+# compute RMS on in error on the grid
+nX = drho.shape[0]
+nZ = drho.shape[1]
+drho2_avg = (drho**2).sum()/(nX*nZ)
+drho_rms = np.sqrt(drho2_avg)
+
+print(f"rms error in charge conservation: {drho_rms}")
+print(f"tolerance: {tolerance_rel_charge}")
+
+assert( drho_rms < tolerance_rel_charge )
+
+# Run the first step with and without preconditioner, and compare the total number
+# of GMRES iterations, as printed by the GMRES solver with gmres.verbose_int = 2
+def count_gmres_iterations(executable, pc_type):
+    log = "gmres_" + pc_type + ".log"
+    os.system("./" + executable + " inputs_vandb_jfnk_2d max_step=1 jacobian.pc_type=" + pc_type +
+              " diag1.file_prefix=diags/step1_" + pc_type + "_" +
+              " field_energy.path=diags/step1_" + pc_type + "/" +
+              " particle_energy.path=diags/step1_" + pc_type + "/ > " + log)
+    with open(log) as f:
+        return len(re.findall(r"GMRES: iter =", f.read()))
+
+executables = glob.glob("*.ex")
+assert(len(executables) == 1)
+n_iter_pc = count_gmres_iterations(executables[0], "pc_curl_curl_mlmg")
+n_iter_none = count_gmres_iterations(executables[0], "none")
+
+print(f"GMRES iterations with preconditioner: {n_iter_pc}, without: {n_iter_none}")
+
+assert( 0 < n_iter_pc < n_iter_none )
@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This file is part of the WarpX automated test suite. It tests the time-dependent
+# external particle fields read from an openPMD series
+# (particles.E_ext_particle_init_style = read_from_file).
+#
+# - Write an openPMD series with three iterations, at the times 0, T/2 and T, of the field
+#   Ez = E0 f(t) (1 + x/L), with f = 1, 3 and 2, and of a zero magnetic field.
+# - Run WarpX up to the time 1.5 T, with protons initially at rest. Ez does not depend
+#   on z and the protons only move along z, so that x is constant for each proton.
+# - In the simulation, f is interpolated linearly between the iterations and is constant
+#   after the last one, so that the final momentum of each proton is
+#   uz = q E0 (1 + x/L) (T + 1.25 T + T)/(m c).
+
+import glob
+import os
+
+import numpy as np
+import openpmd_api as io
+import yt
+from scipy.constants import c, m_p, q_e
+
+L = 1.
+T = 1.e-9
+E0 = 1.e3
+f = [1., 3., 2.]
+times = [0., 0.5*T, T]
+n = 17  # number of nodes along each axis
+
+def write_fields():
+    series = io.Series("external_fields/fields_%T.h5", io.Access.create)
+    x = np.linspace(-L, L, n)
+    X = x[:, np.newaxis, np.newaxis]*np.ones((n, n, n))
+    for i, (t, fi) in enumerate(zip(times, f)):
+        it = series.iterations[i]
+        it.time = t
+        it.dt = 0.5*T
+        it.time_unit_SI = 1.
+        values = {'E': [np.zeros((n, n, n)), np.zeros((n, n, n)), E0*fi*(1. + X/L)],
+                  'B': [np.zeros((n, n, n))]*3}
+        for name, components in values.items():
+            mesh = it.meshes[name]
+            mesh.geometry = io.Geometry.cartesian
+            mesh.data_order = 'C'
+            mesh.axis_labels = ['x', 'y', 'z']
+            mesh.grid_spacing = [2.*L/(n-1)]*3
+            mesh.grid_global_offset = [-L]*3
+            mesh.grid_unit_SI = 1.
+            for coord, data in zip(['x', 'y', 'z'], components):
+                data = np.ascontiguousarray(data)
+                component = mesh[coord]
+                component.position = [0., 0., 0.]
+                component.unit_SI = 1.
+                component.reset_dataset(io.Dataset(data.dtype, data.shape))
+                component.store_chunk(data)
+        it.close()
+    series.close()
+
+def main():
+    write_fields()
+
+    executables = glob.glob("*.ex")
+    assert(len(executables) == 1)
+    os.system("./" + executables[0] + " inputs_3d_time_dependent diag1.file_prefix=diags/plotfiles/plt")
+
+    ds = yt.load(sorted(glob.glob("diags/plotfiles/plt??????"))[-1])
+    ad = ds.all_data()
+    x = ad['proton', 'particle_position_x'].to_ndarray()
+    ux = ad['proton', 'particle_momentum_x'].to_ndarray()/(m_p*c)
+    uy = ad['proton', 'particle_momentum_y'].to_ndarray()/(m_p*c)
+    uz = ad['proton', 'particle_momentum_z'].to_ndarray()/(m_p*c)
+    assert(len(uz) == 3)
+
+    uz_th = q_e*E0*(1. + x/L)*3.25*T/(m_p*c)
+    error = np.amax(np.abs(uz - uz_th))/np.amax(np.abs(uz_th))
+    tolerance = 1.e-2
+    print(f'uz = {uz}, expected {uz_th}')
+    print(f'error = {error}')
+    print(f'tolerance = {tolerance}')
+    assert(error < tolerance)
+    assert(np.all(ux == 0.) and np.all(uy == 0.))
+
+    print('Passed')
+
+if __name__ == "__main__":
+    main()
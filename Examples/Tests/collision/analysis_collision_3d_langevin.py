@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script tests the Langevin Coulomb collisions (collision type langevincoulomb)
+# using the temperature relaxation of electrons and ions in 3D.
+# Initially, the electrons and the ions (of mass 4 m_e) are Maxwellian, with different temperatures.
+# - The temperatures relax through collisions at the energy exchange rate
+#   of the NRL plasma formulary, which is integrated in time here.
+# - The collisions conserve the total momentum and kinetic energy exactly.
+
+import glob
+import sys
+
+import numpy as np
+import scipy.constants as sc
+import yt
+
+e = sc.e
+pi = sc.pi
+ep0 = sc.epsilon_0
+m_e = sc.m_e
+m_i = 4.*m_e
+
+dt = 4.e-16
+nt = 100
+n0 = 1.e28
+log = 5.0
+Te0 = 200.*e
+Ti0 = 100.*e
+
+def moments(ds, species, m):
+    ad = ds.all_data()
+    w = ad[species, 'particle_weight'].to_ndarray()
+    p = [ad[species, 'particle_momentum_' + d].to_ndarray() for d in ['x', 'y', 'z']]
+    # momentum, kinetic energy and temperature (non-relativistic)
+    momentum = np.array([np.sum(w*pd) for pd in p])
+    energy = np.sum(w*sum(pd**2 for pd in p))/(2.*m)
+    v_mean = momentum/(m*np.sum(w))
+    T = m*np.sum(w*sum((pd/m - vd)**2 for pd, vd in zip(p, v_mean)))/(3.*np.sum(w))
+    return momentum, energy, T
+
+fn = sys.argv[1]
+fn0 = sorted(glob.glob(fn.rstrip('/')[:-6] + '??????'))[0]
+
+ds0 = yt.load(fn0)
+ds = yt.load(fn)
+P_e0, W_e0, _ = moments(ds0, 'electron', m_e)
+P_i0, W_i0, _ = moments(ds0, 'ion', m_i)
+P_e, W_e, Te = moments(ds, 'electron', m_e)
+P_i, W_i, Ti = moments(ds, 'ion', m_i)
+
+# Conservation of the momentum and energy
+p_scale = np.sqrt(2.*m_e*W_e0*np.sum(ds0.all_data()['electron', 'particle_weight'].to_ndarray()))
+error_momentum = np.amax(np.abs((P_e + P_i) - (P_e0 + P_i0)))/p_scale
+error_energy = abs((W_e + W_i) - (W_e0 + W_i0))/(W_e0 + W_i0)
+print(f'error on the momentum = {error_momentum}')
+print(f'error on the energy = {error_energy}')
+assert(error_momentum < 1.e-10)
+assert(error_energy < 1.e-10)
+
+# Temperature relaxation: dTe/dt = nu_e (Ti - Te), dTi/dt = nu_i (Te - Ti), with the
+# energy exchange rate nu_e = nu_i = sqrt(2) n q^4 lnL / (6 pi^1.5 ep0^2 m_e m_i (Te/m_e + Ti/m_i)^1.5)
+Te_th = Te0
+Ti_th = Ti0
+nsub = 10
+for _ in range(nt*nsub):
+    nu = (np.sqrt(2.)*n0*e**4*log/(6.*pi**1.5*ep0**2*m_e*m_i*(Te_th/m_e + Ti_th/m_i)**1.5))
+    dT = (dt/nsub)*nu*(Ti_th - Te_th)
+    Te_th, Ti_th = Te_th + dT, Ti_th - dT
+
+# Compare the temperature difference, which is what relaxes
+tolerance = 0.1
+error = abs((Te - Ti) - (Te_th - Ti_th))/(Te_th - Ti_th)
+
+print(f'Te = {Te/e} eV, expected {Te_th/e} eV')
+print(f'Ti = {Ti/e} eV, expected {Ti_th/e} eV')
+print(f'error = {error}')
+print(f'tolerance = {tolerance}')
+assert(error < tolerance)
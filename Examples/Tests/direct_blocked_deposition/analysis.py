@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This file is part of the WarpX automated test suite. It checks that the
+# register-blocked direct current deposition (algo.current_deposition = direct_blocked)
+# gives the same current as the direct deposition up to round-off:
+#
+# - The main run uses direct_blocked at order 3.
+# - The same input is run again with direct at order 3, and with both algorithms
+#   at the orders 1, 2 and 4, with the particles binned by super-cell and unsorted.
+# - jx, jy and jz are compared at the last step.
+
+import glob
+import os
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(50)
+
+tolerance = 1.e-12
+
+def get_current(fn):
+    ds = yt.load(fn)
+    data = ds.covering_grid(
+        level=0,
+        left_edge=ds.domain_left_edge,
+        dims=ds.domain_dimensions)
+    return [data[('boxlib', field)].to_ndarray() for field in ['jx', 'jy', 'jz']]
+
+def run(executable, prefix, params):
+    os.system("./" + executable + " inputs_3d " + params +
+              " diag1.file_prefix=diags/" + prefix)
+    return sorted(glob.glob("diags/" + prefix + "??????"))[-1]
+
+def compare(fn_test, fn_ref, label):
+    for field, j_test, j_ref in zip(['jx', 'jy', 'jz'],
+                                    get_current(fn_test), get_current(fn_ref)):
+        error_rel = np.amax(np.abs(j_test - j_ref)) / np.amax(np.abs(j_ref))
+        print("{}, {}: error_rel = {}, tolerance = {}".format(
+            label, field, error_rel, tolerance))
+        assert(error_rel < tolerance)
+
+# Plotfile data set of the main run
+fn = sys.argv[1]
+
+executables = glob.glob("*.ex")
+assert(len(executables) == 1)
+executable = executables[0]
+
+fn_direct = run(executable, "direct3_", "algo.current_deposition=direct")
+compare(fn, fn_direct, "order 3")
+
+for order in [1, 2, 4]:
+    shape = " algo.particle_shape={}".format(order)
+    fn_direct = run(executable, "direct{}_".format(order),
+                    "algo.current_deposition=direct" + shape)
+    fn_blocked = run(executable, "blocked{}_".format(order),
+                     "algo.current_deposition=direct_blocked" + shape)
+    fn_unsorted = run(executable, "unsorted{}_".format(order),
+                      "algo.current_deposition=direct_blocked" + shape +
+                      " warpx.blocked_deposition_supercell_size=0 0 0")
+    compare(fn_blocked, fn_direct, "order {}".format(order))
+    compare(fn_unsorted, fn_direct, "order {}, unsorted".format(order))
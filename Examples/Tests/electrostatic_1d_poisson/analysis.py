@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This file is part of the WarpX automated test suite. It checks the 1D
+# electrostatic solver, which solves the Poisson equation on distributed boxes
+# with prefix sums, for its different boundary conditions.
+#
+# The charge density of immobile electrons and ions is zero near the boundaries
+# and its integral is zero. Ez is cell-centered in 1D and is written exactly, while
+# phi and rho are averaged from the nodes to the cell centers. With
+# Ez_{i+1/2} = -(phi_{i+1} - phi_i)/dz, the discrete Poisson equation at the nodes
+# i and i+1 gives (Ez_{i+3/2} - Ez_{i-1/2})/(2 dz) = rho_{i+1/2}/epsilon_0, and:
+# - at a PEC boundary, the potential at the boundary node, phi_0 = phi_{1/2} + dz Ez_{1/2}/2
+#   (or phi_N = phi_{N-1/2} - dz Ez_{N-1/2}/2), is the applied potential,
+# - at a Neumann boundary, with no charge on the boundary node, Ez is zero in the boundary cell,
+# - with periodic boundaries, the equation holds across the boundary.
+#
+# The main run uses PEC boundaries and 8 boxes. The same input is run again with the
+# other boundary conditions, and on a single box, which must give the same field.
+
+import glob
+import os
+import sys
+
+import numpy as np
+import yt
+from scipy.constants import epsilon_0
+
+yt.funcs.mylog.setLevel(50)
+
+tolerance = 1.e-9
+potential_lo = -2.
+potential_hi = 10.
+
+def get_fields(fn):
+    ds = yt.load(fn)
+    data = ds.covering_grid(
+        level=0,
+        left_edge=ds.domain_left_edge,
+        dims=ds.domain_dimensions)
+    dz = (ds.domain_right_edge[0] - ds.domain_left_edge[0]).v / ds.domain_dimensions[0]
+    return [data[('boxlib', field)].to_ndarray().squeeze() for field in ['Ez', 'phi', 'rho']] + [dz]
+
+def check(fn, field_lo, field_hi):
+    Ez, phi, rho, dz = get_fields(fn)
+    label = field_lo + "/" + field_hi
+
+    # Poisson equation
+    if field_lo == 'periodic':
+        lhs = (np.roll(Ez, -1) - np.roll(Ez, 1))/(2.*dz)
+        rhs = rho/epsilon_0
+    else:
+        lhs = (Ez[2:] - Ez[:-2])/(2.*dz)
+        rhs = rho[1:-1]/epsilon_0
+    error_rel = np.amax(np.abs(lhs - rhs))/np.amax(np.abs(rhs))
+    print("{}: error on the Poisson equation = {}, tolerance = {}".format(label, error_rel, tolerance))
+    assert(error_rel < tolerance)
+
+    # Boundary conditions
+    scale = np.amax(np.abs(Ez))
+    if field_lo == 'pec':
+        phi_0 = phi[0] + 0.5*dz*Ez[0]
+        print("{}: phi_lo = {}".format(label, phi_0))
+        assert(abs(phi_0 - potential_lo) < tolerance*abs(potential_lo))
+    elif field_lo == 'neumann':
+        print("{}: Ez_lo = {}".format(label, Ez[0]))
+        assert(abs(Ez[0]) < tolerance*scale)
+    if field_hi == 'pec':
+        phi_N = phi[-1] - 0.5*dz*Ez[-1]
+        print("{}: phi_hi = {}".format(label, phi_N))
+        assert(abs(phi_N - potential_hi) < tolerance*abs(potential_hi))
+    elif field_hi == 'neumann':
+        print("{}: Ez_hi = {}".format(label, Ez[-1]))
+        assert(abs(Ez[-1]) < tolerance*scale)
+    return Ez
+
+def run(executable, field_lo, field_hi, params=""):
+    particle_lo = 'periodic' if field_lo == 'periodic' else 'absorbing'
+    particle_hi = 'periodic' if field_hi == 'periodic' else 'absorbing'
+    prefix = "diags/{}_{}_{}_".format(field_lo, field_hi, params.replace('=', '').replace('.', '_'))
+    os.system("./" + executable + " inputs_1d" +
+              " boundary.field_lo=" + field_lo + " boundary.field_hi=" + field_hi +
+              " boundary.particle_lo=" + particle_lo + " boundary.particle_hi=" + particle_hi +
+              " " + params + " diag1.file_prefix=" + prefix)
+    return sorted(glob.glob(prefix + "??????"))[-1]
+
+# Plotfile data set of the main run
+fn = sys.argv[1]
+Ez_pec = check(fn, 'pec', 'pec')
+
+executables = glob.glob("*.ex")
+assert(len(executables) == 1)
+executable = executables[0]
+
+for field_lo, field_hi in [('periodic', 'periodic'), ('neumann', 'neumann'),
+                           ('pec', 'neumann'), ('neumann', 'pec')]:
+    Ez = check(run(executable, field_lo, field_hi), field_lo, field_hi)
+    Ez_single_box = check(run(executable, field_lo, field_hi, "amr.max_grid_size=64"), field_lo, field_hi)
+    error_rel = np.amax(np.abs(Ez - Ez_single_box))/np.amax(np.abs(Ez_single_box))
+    print("{}/{}: difference with a single box = {}".format(field_lo, field_hi, error_rel))
+    assert(error_rel < tolerance)
+
+Ez_single_box = check(run(executable, 'pec', 'pec', "amr.max_grid_size=64"), 'pec', 'pec')
+error_rel = np.amax(np.abs(Ez_pec - Ez_single_box))/np.amax(np.abs(Ez_single_box))
+print("pec/pec: difference with a single box = {}".format(error_rel))
+assert(error_rel < tolerance)
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This file is part of the WarpX automated test suite. It checks that the fused
+# gather, push and Esirkepov deposition (warpx.do_fused_push_deposit = 1) gives
+# the same results as the separate push and deposition up to round-off:
+#
+# - The main run uses the fused kernel with the Boris pusher.
+# - The same input is run again without the fused kernel, and with both paths
+#   for the Vay and Higuera-Cary pushers.
+# - The fields and the particle positions and momenta are compared at the last step.
+
+import glob
+import os
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(50)
+
+tolerance = 1.e-12
+fields = ['Ex', 'Ey', 'Ez', 'Bx', 'By', 'Bz', 'jx', 'jy', 'jz']
+particle_variables = ['particle_position_x', 'particle_position_y', 'particle_position_z',
+                      'particle_momentum_x', 'particle_momentum_y', 'particle_momentum_z']
+
+def get_data(fn):
+    ds = yt.load(fn)
+    grid = ds.covering_grid(
+        level=0,
+        left_edge=ds.domain_left_edge,
+        dims=ds.domain_dimensions)
+    ad = ds.all_data()
+    # Order the particles by id, since the two runs may store them in a different order
+    order = np.lexsort((ad[('electrons', 'particle_cpu')].to_ndarray(),
+                        ad[('electrons', 'particle_id')].to_ndarray()))
+    data = {field: grid[('boxlib', field)].to_ndarray() for field in fields}
+    for variable in particle_variables:
+        data[variable] = ad[('electrons', variable)].to_ndarray()[order]
+    return data
+
+def run(executable, prefix, params):
+    os.system("./" + executable + " inputs_3d " + params +
+              " diag1.file_prefix=diags/" + prefix)
+    return sorted(glob.glob("diags/" + prefix + "??????"))[-1]
+
+def compare(fn_test, fn_ref, label):
+    data_test = get_data(fn_test)
+    data_ref = get_data(fn_ref)
+    for name in fields + particle_variables:
+        scale = np.amax(np.abs(data_ref[name]))
+        error_rel = np.amax(np.abs(data_test[name] - data_ref[name])) / scale if scale > 0 else 0.
+        print("{}, {}: error_rel = {}, tolerance = {}".format(
+            label, name, error_rel, tolerance))
+        assert(error_rel < tolerance)
+
+# Plotfile data set of the main run
+fn = sys.argv[1]
+
+executables = glob.glob("*.ex")
+assert(len(executables) == 1)
+executable = executables[0]
+
+fn_unfused = run(executable, "unfused_boris_", "warpx.do_fused_push_deposit=0")
+compare(fn, fn_unfused, "boris")
+
+for pusher in ['vay', 'higuera']:
+    fn_unfused = run(executable, "unfused_{}_".format(pusher),
+                     "warpx.do_fused_push_deposit=0 algo.particle_pusher=" + pusher)
+    fn_fused = run(executable, "fused_{}_".format(pusher),
+                   "warpx.do_fused_push_deposit=1 algo.particle_pusher=" + pusher)
+    compare(fn_fused, fn_unfused, pusher)
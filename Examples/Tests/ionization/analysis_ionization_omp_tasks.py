@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+This script tests the current deposition of ionizable ions with
+particles.omp_task_chunk_size > 0, where the tiles are split in chunks of
+particles that are pushed and deposited in OpenMP tasks.
+
+The ions (initially neutral) are ionized by a uniform external field applied
+to the particles only. The Esirkepov deposition conserves the charge, so that
+Gauss's law eps0 div(E) = rho holds on the grid up to round-off errors, as long
+as each chunk deposits its current with the ionization levels of its own
+particles.
+"""
+
+import sys
+
+import numpy as np
+import yt
+from scipy.constants import epsilon_0
+
+yt.funcs.mylog.setLevel(0)
+
+filename = sys.argv[1]
+ds = yt.load(filename)
+grid = ds.covering_grid(level=0, left_edge=ds.domain_left_edge,
+                        dims=ds.domain_dimensions)
+divE = grid['boxlib', 'divE'].v.squeeze()
+rho = grid['boxlib', 'rho'].v.squeeze()
+
+ad = ds.all_data()
+ilev = ad['ions', 'particle_ionizationLevel'].v
+print(f"ionization levels: {np.bincount(ilev.astype(int))}")
+# Several ionization levels are present
+assert np.count_nonzero(np.bincount(ilev.astype(int))) > 1
+
+error_rel = np.amax(np.abs(epsilon_0*divE - rho))/np.amax(np.abs(rho))
+tolerance_rel = 1.e-9
+
+print("error_rel    : " + str(error_rel))
+print("tolerance_rel: " + str(tolerance_rel))
+
+assert error_rel < tolerance_rel
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This file is part of the WarpX automated test suite. It tests the openPMD particle
+# output with <diag>.<species>.sort_by_cell = 1, by comparing it with the output of the
+# same particles without sorting, written by another diagnostic at the same step:
+# - the same particles, with the same attributes, are written by both diagnostics;
+# - the chunks of the index cover the particle records, without gaps or overlaps;
+# - the positions of the particles of each chunk are within its bounds;
+# - the particles of each chunk are ordered by cell.
+
+import numpy as np
+import openpmd_api as io
+
+species_name = 'electrons'
+
+def read_particles(path):
+    series = io.Series(path, io.Access.read_only)
+    it = series.iterations[list(series.iterations)[-1]]
+    species = it.particles[species_name]
+    records = {}
+    for name, record in species.items():
+        for comp_name, comp in record.items():
+            records[name + '_' + comp_name] = comp[:]
+    series.flush()
+    records = {key: np.array(value) for key, value in records.items()}
+    attributes = {name: species.get_attribute(name) for name in species.attributes}
+    return records, attributes
+
+sorted_records, index = read_particles('diags/sorted/openpmd_%T.h5')
+unsorted_records, unsorted_attributes = read_particles('diags/unsorted/openpmd_%T.h5')
+
+# Same particles, with the same attributes
+id_key = 'id_' + io.Record_Component.SCALAR
+assert(sorted_records.keys() == unsorted_records.keys())
+n = len(sorted_records[id_key])
+assert(n > 0 and n == len(unsorted_records[id_key]))
+sorted_order = np.argsort(sorted_records[id_key])
+unsorted_order = np.argsort(unsorted_records[id_key])
+for key in sorted_records:
+    assert(np.array_equal(sorted_records[key][sorted_order],
+                          unsorted_records[key][unsorted_order])), key
+
+# The index is only written with sort_by_cell
+assert('chunkOffset' not in unsorted_attributes)
+offset = np.array(index['chunkOffset'], dtype=np.int64)
+size = np.array(index['chunkNumParticles'], dtype=np.int64)
+labels = list(index['chunkPositionAxisLabels'])
+assert(labels == ['x', 'y', 'z'])
+nd = len(labels)
+lo = np.array(index['chunkPositionLowerBound']).reshape(-1, nd)
+hi = np.array(index['chunkPositionUpperBound']).reshape(-1, nd)
+nchunks = len(offset)
+# 2 boxes of 16^3 cells per dimension and tiles of 8^3 cells
+assert(nchunks > 8)
+assert(len(size) == nchunks and lo.shape == (nchunks, nd) and hi.shape == (nchunks, nd))
+
+# The chunks cover the records without gaps or overlaps
+chunk_order = np.argsort(offset)
+starts = offset[chunk_order]
+ends = starts + size[chunk_order]
+assert(starts[0] == 0 and ends[-1] == n)
+assert(np.array_equal(starts[1:], ends[:-1]))
+
+# Positions and cell indices of the particles
+prob_lo = np.array([-20.e-6]*3)
+dx = np.array([40.e-6/32]*3)
+n_cell = np.array([32]*3)
+pos = np.stack([sorted_records['position_' + d] + sorted_records['positionOffset_' + d]
+                for d in labels], axis=1)
+cell = np.clip(np.floor((pos - prob_lo)/dx).astype(np.int64), 0, n_cell - 1)
+# Cells are ordered with x varying the fastest, as in amrex::Box::index
+cell_key = (cell[:, 2]*n_cell[1] + cell[:, 1])*n_cell[0] + cell[:, 0]
+
+for i in range(nchunks):
+    s = slice(offset[i], offset[i] + size[i])
+    if size[i] == 0:
+        continue
+    assert(np.all(pos[s] >= lo[i]) and np.all(pos[s] <= hi[i]))
+    assert(np.allclose(pos[s].min(axis=0), lo[i], rtol=0., atol=1.e-12*dx[0]))
+    assert(np.allclose(pos[s].max(axis=0), hi[i], rtol=0., atol=1.e-12*dx[0]))
+    assert(np.all(np.diff(cell_key[s]) >= 0)), f'chunk {i} is not sorted by cell'
+
+print('Passed')
@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script tests the splitting of particles entering a mesh refinement patch
+# (<species>.do_splitting = 1, <species>.split_type = 0). The particles drift without
+# fields into the patch, where each of them is split in 4 particles along the diagonals,
+# shifted by a quarter of a fine cell along x and z. It checks that:
+# - the particles were created on several MPI ranks (several cpu numbers in idcpu),
+#   so that the tag of the particles to split is matched whatever their cpu number;
+# - all the particles were split exactly once, with the split particles tagged with
+#   NoSplitParticleID and a quarter of the weight of the particle they come from;
+# - the split particles are at the positions of the particle they come from,
+#   shifted along the diagonals.
+
+import numpy as np
+import openpmd_api as io
+from scipy.constants import c
+
+# Parameters of the input file
+ux = 0.2
+dt = 1.e-15
+dx_fine = 0.5e-6
+dz_fine = 0.5e-6
+
+# See amrex::LongParticleIds
+NoSplitParticleID = 2**39 - 1 - 4
+
+series = io.Series('diags/diag1/openpmd_%T.h5', io.Access.read_only)
+iterations = sorted(series.iterations)
+assert(len(iterations) == 2 and iterations[0] == 0)
+
+def read_particles(step):
+    it = series.iterations[step]
+    electrons = it.particles['electrons']
+    x = electrons['position']['x'][:]
+    z = electrons['position']['z'][:]
+    x_offset = electrons['positionOffset']['x'][:]
+    z_offset = electrons['positionOffset']['z'][:]
+    w = electrons['weighting'][io.Record_Component.SCALAR][:]
+    idcpu = electrons['id'][io.Record_Component.SCALAR][:]
+    series.flush()
+    return (np.array(x) + np.array(x_offset), np.array(z) + np.array(z_offset),
+            np.array(w), np.array(idcpu, dtype=np.uint64))
+
+x0, z0, w0, idcpu0 = read_particles(iterations[0])
+x, z, w, idcpu = read_particles(iterations[-1])
+
+# The particles were created on several MPI ranks
+cpu0 = idcpu0 & np.uint64(0xFFFFFF)
+print(f"cpu numbers of the initial particles: {np.unique(cpu0)}")
+assert(len(np.unique(cpu0)) > 1)
+
+# All the particles were split, in 4 particles along the diagonals
+n0 = len(x0)
+print(f"number of particles: {n0} initially, {len(x)} at the end")
+assert(n0 > 0 and len(x) == 4*n0)
+ids = idcpu >> np.uint64(24)
+assert(np.all(ids == NoSplitParticleID))
+assert(np.allclose(w, w0[0]/4., rtol=1.e-12, atol=0.))
+assert(np.isclose(np.sum(w), np.sum(w0), rtol=1.e-12, atol=0.))
+
+# Positions of the split particles: the particles drift along x at constant velocity,
+# and are shifted by half of dx_fine/num_particles_per_cell_each_dim along the diagonals
+drift = ux/np.sqrt(1. + ux**2)*c*dt*iterations[-1]
+x_expected = np.concatenate([x0 + drift + sx*dx_fine/2. for sx in (-1, -1, 1, 1)])
+z_expected = np.concatenate([z0 + sz*dz_fine/2. for sz in (-1, 1, -1, 1)])
+
+def sort_positions(x, z):
+    # The particles are on a lattice with a step of dx_fine, so that the
+    # rounded positions order them without ambiguity
+    order = np.lexsort((np.round(x/dx_fine*1.e3), np.round(z/dz_fine*1.e3)))
+    return x[order], z[order]
+
+x, z = sort_positions(x, z)
+x_expected, z_expected = sort_positions(x_expected, z_expected)
+error = max(np.amax(np.abs(x - x_expected)), np.amax(np.abs(z - z_expected)))
+tolerance = 1.e-12
+print(f"error on the positions: {error}")
+print(f"tolerance: {tolerance}")
+assert(error < tolerance)
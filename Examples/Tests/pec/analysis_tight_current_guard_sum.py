@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script tests warpx.tight_current_guard_sum with PEC field boundaries and
+# reflecting particle boundaries, where the current deposited in the guard cells
+# outside the domain is folded back into the domain after the guard-cell sum.
+# The simulation is run again with warpx.tight_current_guard_sum = 0, and the
+# fields must be the same up to round-off errors.
+
+import glob
+import os
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(0)
+
+fields = ['Ex', 'Ey', 'Ez', 'Bx', 'By', 'Bz', 'jx', 'jy', 'jz']
+
+def read_fields(filename):
+    ds = yt.load(filename)
+    grid = ds.covering_grid(level=0, left_edge=ds.domain_left_edge,
+                            dims=ds.domain_dimensions)
+    return {field: grid['boxlib', field].v for field in fields}
+
+# Simulation with warpx.tight_current_guard_sum = 1
+filename = sys.argv[1]
+tight = read_fields(filename)
+
+# Same simulation with warpx.tight_current_guard_sum = 0
+executables = glob.glob("*.ex")
+assert len(executables) == 1
+prefix = "diags/full_sum"
+os.system("./" + executables[0] + " inputs_tight_current_guard_sum_3d "
+          "warpx.tight_current_guard_sum=0 diag1.file_prefix=" + prefix)
+full = read_fields(sorted(glob.glob(prefix + "??????"))[-1])
+
+tolerance_rel = 1.e-12
+for field in fields:
+    error_rel = np.amax(np.abs(tight[field] - full[field]))/np.amax(np.abs(full[field]))
+    print(f"{field}: error_rel = {error_rel}")
+    assert error_rel < tolerance_rel
@@ -0,0 +1,44 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script tests <species>.push_interval, with ions pushed every 4 steps in a
+# thermal plasma. The ions deposit at each push the current of their motion over
+# 4 steps, which is added to the current at every step until the next push. At the
+# steps that are multiples of 4, the fields and the particles are then at the same
+# time, and the Esirkepov deposition keeps Gauss's law up to round-off errors.
+# The ions must also have moved, with the charge density of the ions no longer uniform.
+
+import sys
+
+import numpy as np
+import yt
+from scipy.constants import epsilon_0, q_e
+
+yt.funcs.mylog.setLevel(0)
+
+filename = sys.argv[1]
+ds = yt.load(filename)
+assert ds.current_time > 0.
+grid = ds.covering_grid(level=0, left_edge=ds.domain_left_edge,
+                        dims=ds.domain_dimensions)
+divE = grid['boxlib', 'divE'].v.squeeze()
+rho = grid['boxlib', 'rho'].v.squeeze()
+rho_ions = grid['boxlib', 'rho_ions'].v.squeeze()
+
+# The ions moved
+n0 = 1.e25
+ions_variation = np.amax(np.abs(rho_ions - q_e*n0))/(q_e*n0)
+print(f"relative variation of the ion density: {ions_variation}")
+assert ions_variation > 1.e-3
+
+# Gauss's law
+error_rel = np.amax(np.abs(epsilon_0*divE - rho))/np.amax(np.abs(rho))
+tolerance_rel = 1.e-9
+print("error_rel    : " + str(error_rel))
+print("tolerance_rel: " + str(tolerance_rel))
+assert error_rel < tolerance_rel
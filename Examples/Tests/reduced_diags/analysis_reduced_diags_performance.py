@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script tests the performance reduced diagnostics.
+# The setup is a uniform thermal plasma on 8 boxes. The values of the reduced diagnostics
+# depend on the machine, so only their consistency is checked:
+# - PhaseTimings: the minimum, average and maximum times are ordered, the exclusive times of
+#   the phases add up to at most the time of the step, and the JSON timeline matches the text file.
+# - MemoryUsage: the memory of the fields and particles is bounded by the size of the data they
+#   hold, and the high-water marks are at least the current memory and never decrease.
+# - CommStats: the guard cell exchanges and the sum of the current send messages between the two
+#   ranks, and with two ranks, what one rank sends is what the other one receives.
+
+import json
+import sys
+
+import yt
+
+
+def load(name):
+    '''Read a reduced diagnostics file into a dictionary of columns, indexed by the column names'''
+    with open('./diags/reducedfiles/' + name + '.txt') as f:
+        header = f.readline()
+        rows = [[float(v) for v in line.split()] for line in f if line.strip()]
+    names = [h.split(']', 1)[1] for h in header[1:].split()]
+    assert(len(rows) > 0)
+    return {n: [row[i] for row in rows] for i, n in enumerate(names)}
+
+fn = sys.argv[1]
+ds = yt.load(fn)
+
+nprocs = 2
+ncells = 32**3
+nboxes = 8
+box_size = 16
+max_guard_cells = 4
+
+#--------------------------------------------------------------------------------------------------
+# PhaseTimings
+#--------------------------------------------------------------------------------------------------
+phases = ['particle_push', 'current_deposition', 'charge_deposition', 'field_solve',
+          'field_comm', 'source_comm', 'particle_comm', 'diagnostics']
+PT = load('PT')
+assert(PT['step()'] == [5., 10., 15., 20.])
+for name in phases + ['step']:
+    for tmin, tavg, tmax in zip(PT[name + '_min(s)'], PT[name + '_avg(s)'], PT[name + '_max(s)']):
+        assert(0. <= tmin <= tavg*(1.+1.e-12) and tavg <= tmax*(1.+1.e-12))
+for i, tstep in enumerate(PT['step_avg(s)']):
+    tphases = sum(PT[name + '_avg(s)'][i] for name in phases)
+    print(f"PhaseTimings, step {PT['step()'][i]}: sum of the phases {tphases} s, step {tstep} s")
+    assert(0. < tphases <= tstep*(1.+1.e-6))
+for name in ['particle_push', 'current_deposition', 'field_solve']:
+    assert(min(PT[name + '_max(s)']) > 0.)
+
+with open('./diags/reducedfiles/PT.jsonl') as f:
+    timeline = [json.loads(line) for line in f if line.strip()]
+assert(len(timeline) == len(PT['step()']))
+for i, entry in enumerate(timeline):
+    assert(entry['step'] == PT['step()'][i])
+    for name in phases + ['step']:
+        for stat in ['min', 'avg', 'max']:
+            value = PT[name + '_' + stat + '(s)'][i]
+            assert(abs(entry[name][stat] - value) <= 1.e-6*abs(value))
+
+#--------------------------------------------------------------------------------------------------
+# MemoryUsage
+#--------------------------------------------------------------------------------------------------
+MU = load('MU')
+assert(MU['step()'] == [5., 10., 15., 20.])
+
+# The memory is the maximum over the MPI ranks, so it is at least the average over the ranks.
+# Each field component has at least one point per cell, and at most the points of the grown boxes.
+bytes_per_point = 8
+for field in ['Efield_fp', 'Bfield_fp', 'current_fp']:
+    min_bytes = 3*ncells*bytes_per_point/nprocs
+    max_bytes = 3*nboxes*(box_size+1+2*max_guard_cells)**3*bytes_per_point
+    for b in MU['field_' + field + '_current(B)']:
+        print(f"MemoryUsage, {field}: {b} B, expected in [{min_bytes}, {max_bytes}]")
+        assert(min_bytes <= b <= max_bytes)
+
+# Each particle holds at least x, y, z, w, ux, uy, uz and its id and cpu
+ad = ds.all_data()
+nparticles = ad['electrons', 'particle_weight'].shape[0]
+min_bytes = nparticles*(7*bytes_per_point + 8)/nprocs
+for b in MU['species_electrons_current(B)']:
+    print(f"MemoryUsage, electrons: {b} B, expected at least {min_bytes}")
+    assert(b >= min_bytes)
+
+assert(all(b == 0. for b in MU['pml_current(B)']))
+assert(all(b == 0. for b in MU['boundary_buffer_current(B)']))
+
+categories = [n[:-len('_current(B)')] for n in MU if n.endswith('_current(B)')]
+for category in categories:
+    current = MU[category + '_current(B)']
+    high_water = MU[category + '_high_water(B)']
+    for i in range(len(current)):
+        assert(0. <= current[i] <= high_water[i])
+        if i > 0:
+            assert(high_water[i] >= high_water[i-1])
+
+#--------------------------------------------------------------------------------------------------
+# CommStats
+#--------------------------------------------------------------------------------------------------
+CS = load('CS')
+assert(CS['step()'] == [5., 10., 15., 20.])
+
+for site in ['FillBoundaryE', 'FillBoundaryB', 'SumBoundaryJ']:
+    for i in range(len(CS['step()'])):
+        calls = CS[site + '_calls_min()'][i]
+        print(f"CommStats, {site}, step {CS['step()'][i]}: {calls} calls, "
+              f"{CS[site + '_msgs_sent_min()'][i]} messages, {CS[site + '_bytes_sent_min(B)'][i]} B")
+        assert(calls > 0.)
+        assert(CS[site + '_msgs_sent_min()'][i] > 0.)
+        assert(CS[site + '_bytes_sent_min(B)'][i] > 0.)
+        # Each rank only exchanges with the other one
+        for quantity in ['msgs', 'bytes']:
+            unit = '()' if quantity == 'msgs' else '(B)'
+            for stat in ['min', 'max']:
+                assert(CS[site + '_' + quantity + '_sent_' + stat + unit][i] ==
+                       CS[site + '_' + quantity + '_recv_' + stat + unit][i])
+
+# The particles are redistributed at every step, and the numbers of messages and bytes are not counted
+assert(all(calls > 0. for calls in CS['Redistribute_calls_min()']))
+assert(all(b == 0. for b in CS['Redistribute_bytes_sent_max(B)']))
+
+# No PML and no moving window
+for site in ['PMLExchange', 'shiftMF']:
+    assert(all(calls == 0. for calls in CS[site + '_calls_max()']))
+
+for name in CS:
+    if name.endswith('_wait_min(s)') or name.endswith('_wait_max(s)'):
+        assert(all(t >= 0. for t in CS[name]))
@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script tests the TransferAudit reduced diagnostics, on GPU with CUPTI.
+# The setup is the one of the performance reduced diagnostics (`inputs_performance`),
+# with a TransferAudit diagnostic every 5 steps. The number of copies depends on the
+# implementation, so only their consistency is checked:
+# - the copies and bytes are non-negative, and each copy moves at least one byte,
+# - the full diagnostics copy the fields and particles from the device to the host,
+#   which must be attributed to Diagnostics::FilterComputePackFlush().
+
+import sys
+
+
+def load(name):
+    '''Read a reduced diagnostics file into a dictionary of columns, indexed by the column names'''
+    with open('./diags/reducedfiles/' + name + '.txt') as f:
+        header = f.readline()
+        rows = [[float(v) for v in line.split()] for line in f if line.strip()]
+    names = [h.split(']', 1)[1] for h in header[1:].split()]
+    assert(len(rows) > 0)
+    return {n: [row[i] for row in rows] for i, n in enumerate(names)}
+
+fn = sys.argv[1]
+
+TA = load('TA')
+assert(TA['step()'] == [5., 10., 15., 20.])
+
+regions = [n[:-len('_htod_copies()')] for n in TA if n.endswith('_htod_copies()')]
+assert(regions == ['WarpX::Evolve()', 'Diagnostics::FilterComputePackFlush()',
+                   'MultiReducedDiags::ComputeDiags()', 'Unattributed'])
+for region in regions:
+    for direction in ['htod', 'dtoh']:
+        copies = TA[region + '_' + direction + '_copies()']
+        nbytes = TA[region + '_' + direction + '(B)']
+        print(f"TransferAudit, {region}, {direction}: {copies} copies, {nbytes} B")
+        for c, b in zip(copies, nbytes):
+            assert(c >= 0. and b >= c)
+            assert((c == 0.) == (b == 0.))
+
+# The full diagnostics are written at the steps 10 and 20, and at least the first
+# output is counted before the end of the run
+assert(sum(TA['Diagnostics::FilterComputePackFlush()_dtoh_copies()']) > 0.)
+
+for name in ['managed_cpu_page_faults()', 'managed_gpu_page_faults()',
+             'managed_htod(B)', 'managed_dtoh(B)']:
+    assert(all(v >= 0. for v in TA[name]))
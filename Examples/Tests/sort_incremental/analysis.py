@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This file is part of the WarpX automated test suite. It checks that the
+# incremental particle sorting (warpx.sort_incremental = 1) neither loses nor
+# duplicates particles, and that it gives the same results as the full sort:
+#
+# - The main run sorts the particles incrementally at every step, in bins of 2 cells.
+# - The same input is run again with the full sort, and both ways with the Morton
+#   order of the bins and with the cell bins of sort_particles_for_deposition.
+# - The particle ids must be the same, and the fields and the particle positions
+#   and momenta must agree up to round-off at the last step.
+
+import glob
+import os
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(50)
+
+tolerance = 1.e-11
+fields = ['Ex', 'Ey', 'Ez', 'Bx', 'By', 'Bz', 'jx', 'jy', 'jz']
+particle_variables = ['particle_position_x', 'particle_position_y', 'particle_position_z',
+                      'particle_momentum_x', 'particle_momentum_y', 'particle_momentum_z']
+
+def get_data(fn):
+    ds = yt.load(fn)
+    grid = ds.covering_grid(
+        level=0,
+        left_edge=ds.domain_left_edge,
+        dims=ds.domain_dimensions)
+    ad = ds.all_data()
+    ids = ad[('electrons', 'particle_id')].to_ndarray()
+    cpus = ad[('electrons', 'particle_cpu')].to_ndarray()
+    # Order the particles by id, since the sorts store them in a different order
+    order = np.lexsort((cpus, ids))
+    data = {field: grid[('boxlib', field)].to_ndarray() for field in fields}
+    data['ids'] = np.stack((ids[order], cpus[order]))
+    for variable in particle_variables:
+        data[variable] = ad[('electrons', variable)].to_ndarray()[order]
+    return data
+
+def run(executable, prefix, params):
+    os.system("./" + executable + " inputs_3d " + params +
+              " diag1.file_prefix=diags/" + prefix)
+    return sorted(glob.glob("diags/" + prefix + "??????"))[-1]
+
+def compare(fn_test, fn_ref, label):
+    data_test = get_data(fn_test)
+    data_ref = get_data(fn_ref)
+    # Each particle must be present exactly once
+    assert(data_test['ids'].shape == data_ref['ids'].shape)
+    assert(np.all(data_test['ids'] == data_ref['ids']))
+    for name in fields + particle_variables:
+        error_rel = np.amax(np.abs(data_test[name] - data_ref[name])) / np.amax(np.abs(data_ref[name]))
+        print("{}, {}: error_rel = {}, tolerance = {}".format(
+            label, name, error_rel, tolerance))
+        assert(error_rel < tolerance)
+
+# Plotfile data set of the main run
+fn = sys.argv[1]
+
+executables = glob.glob("*.ex")
+assert(len(executables) == 1)
+executable = executables[0]
+
+fn_full = run(executable, "full_", "warpx.sort_incremental=0")
+compare(fn, fn_full, "bins")
+
+fn_morton = run(executable, "morton_", "warpx.sort_bin_order=morton")
+compare(fn_morton, fn_full, "bins, morton")
+
+fn_full_cells = run(executable, "full_cells_",
+                    "warpx.sort_incremental=0 warpx.sort_particles_for_deposition=1")
+fn_cells = run(executable, "cells_",
+               "warpx.sort_incremental=1 warpx.sort_particles_for_deposition=1")
+compare(fn_cells, fn_full_cells, "cells")
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 agent
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This file is part of the WarpX automated test suite. It checks that the
+# spectral Poisson solver (warpx.poisson_solver = spectral) gives the same
+# electrostatic field as the multigrid solver, which solves the same
+# finite-difference equation, up to the tolerance of the multigrid solver.
+#
+# The charge density of immobile electrons and ions is zero near the boundaries
+# and its integral is zero, so that the problem is well posed for all the boundaries.
+# - The main run uses PEC boundaries with applied potentials along x, periodic
+#   boundaries along y, and Neumann and PEC boundaries along z.
+# - The same input is run again with the multigrid solver, and both ways with
+#   periodic, PEC and Neumann boundaries in all the directions.
+# - E is compared, which does not depend on the constant of the potential that is
+#   left free by periodic and Neumann boundaries.
+
+import glob
+import os
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(50)
+
+tolerance = 1.e-7
+
+def get_field(fn):
+    ds = yt.load(fn)
+    data = ds.covering_grid(
+        level=0,
+        left_edge=ds.domain_left_edge,
+        dims=ds.domain_dimensions)
+    return [data[('boxlib', field)].to_ndarray() for field in ['Ex', 'Ey', 'Ez']]
+
+def run(executable, name, params):
+    prefix = "diags/" + name + "_"
+    os.system("./" + executable + " inputs_3d " + params + " diag1.file_prefix=" + prefix)
+    return sorted(glob.glob(prefix + "??????"))[-1]
+
+def compare(fn_test, fn_ref, label):
+    E_test = get_field(fn_test)
+    E_ref = get_field(fn_ref)
+    scale = max(np.amax(np.abs(E)) for E in E_ref)
+    for field, e_test, e_ref in zip(['Ex', 'Ey', 'Ez'], E_test, E_ref):
+        error_rel = np.amax(np.abs(e_test - e_ref))/scale
+        print("{}, {}: error_rel = {}, tolerance = {}".format(label, field, error_rel, tolerance))
+        assert(error_rel < tolerance)
+
+# Plotfile data set of the main run
+fn = sys.argv[1]
+
+executables = glob.glob("*.ex")
+assert(len(executables) == 1)
+executable = executables[0]
+
+fn_multigrid = run(executable, "multigrid_mixed", "warpx.poisson_solver=multigrid")
+compare(fn, fn_multigrid, "mixed")
+
+for bc, particle_bc in [('periodic', 'periodic'), ('pec', 'absorbing'), ('neumann', 'absorbing')]:
+    params = ("boundary.field_lo={0} {0} {0} boundary.field_hi={0} {0} {0}"
+              " boundary.particle_lo={1} {1} {1} boundary.particle_hi={1} {1} {1}").format(bc, particle_bc)
+    fn_spectral = run(executable, "spectral_" + bc, params)
+    fn_multigrid = run(executable, "multigrid_" + bc, params + " warpx.poisson_solver=multigrid")
+    compare(fn_spectral, fn_multigrid, bc)
@@ -74,9 +74,34 @@ The above example is quivalent to the following:
 
    # run simulation
    sim.step(nsteps=100)
+
+Functions that only need to run at some steps can be installed with an
+``intervals`` specification, with the same syntax as the ``intervals`` of the
+diagnostics (e.g. ``"100"`` or ``"0:1000:10,2000:"``). The step is the value
+of ``warpx.getistep(0)`` when the callback location is reached (for ``afterstep``,
+the number of the step that just finished). Outside of the intervals of all the
+functions installed at a location, the Python interpreter is not called at all:
+
+.. code-block:: python3
+
+   installcallback('afterstep', myplots, intervals="100")
+
+Compiled functions with the signature ``void f(int step)`` can also be installed
+with :py:func:`installnativecallback`, e.g. with ``ctypes``. They are called
+directly from C++, without going through the Python interpreter (and without
+acquiring the GIL), so they must not call back into Python:
+
+.. code-block:: python3
+
+   import ctypes
+   from pywarpx.callbacks import installnativecallback
+
+   lib = ctypes.CDLL("./libsteering.so")
+   installnativecallback('afterstep', lib.steer, intervals="10")
 """
 
 import copy
+import ctypes
 import sys
 import time
 import types
@@ -107,6 +132,9 @@ class CallbackFunctions(object):
         self.name = name
         self.lcallonce = lcallonce
         self.singlefunconly = singlefunconly
+        # --- Intervals of the functions which are not called at every step,
+        # --- as a dictionary of function key: (intervals string, IntervalsParser)
+        self.intervals = {}
 
     def __call__(self,*args,**kw):
         """Call all of the functions in the list"""
@@ -117,6 +145,7 @@ class CallbackFunctions(object):
     def clearlist(self):
         """Unregister/clear out all registered C callbacks"""
         self.funcs = []
+        self.intervals = {}
         libwarpx.libwarpx_so.remove_python_callback(self.name)
 
     def __bool__(self):
@@ -135,10 +164,35 @@ class CallbackFunctions(object):
         """For call backs that are methods, returns the method's instance"""
         return func[0]
 
+    def _funckey(self,func):
+        """Returns the key of a function (or method or name) in the intervals dictionary"""
+        if isinstance(func,types.MethodType):
+            return (id(func.__self__),func.__name__)
+        elif isinstance(func,list):
+            return (id(func[0]),func[1])
+        elif isinstance(func,str):
+            return func
+        else:
+            return func.__name__
+
+    def _installccallback(self):
+        """Set the callback in the C++ to call this class instance, only at the
+        steps of the union of the intervals of the functions (if all of them have intervals)"""
+        funckeys = [self._funckey(f) for f in self.funcs]
+        if all(key in self.intervals for key in funckeys):
+            cintervals = ','.join(self.intervals[key][0] for key in funckeys)
+        else:
+            cintervals = ''
+        libwarpx.libwarpx_so.add_python_callback(self.name, self, cintervals)
+
     def callbackfunclist(self):
         """Generator returning callable functions from the list"""
         funclistcopy = copy.copy(self.funcs)
+        step = libwarpx.warpx.getistep(0) if self.intervals else None
         for f in funclistcopy:
+            intervals = self.intervals.get(self._funckey(f))
+            if intervals is not None and not intervals[1].contains(step):
+                continue
             if isinstance(f,list):
                 object = self._getmethodobject(f)
                 if object is None:
@@ -171,17 +225,17 @@ class CallbackFunctions(object):
                 continue
             yield result
 
-    def installfuncinlist(self,f):
-        """Check if the specified function is installed"""
+    def installfuncinlist(self,f,intervals=None):
+        """Install the specified function, optionally only called at the steps
+        given by intervals (see utils::parser::IntervalsParser for the syntax)"""
         if self.singlefunconly and self.hasfuncsinstalled():
             raise RuntimeError(
                 f"Only one function can be installed for callback {self.name}."
             )
 
-        if len(self.funcs) == 0:
-            # If this is the first function installed, set the callback in the C++
-            # to call this class instance.
-            libwarpx.libwarpx_so.add_python_callback(self.name, self)
+        if intervals is not None:
+            self.intervals[self._funckey(f)] = (
+                intervals, libwarpx.libwarpx_so.IntervalsParser(intervals))
         if isinstance(f,types.MethodType):
             # --- If the function is a method of a class instance, then save a full
             # --- reference to that instance and the method name.
@@ -202,6 +256,9 @@ class CallbackFunctions(object):
         else:
             self.funcs.append(f)
 
+        # Set (or update the intervals of) the callback in the C++
+        self._installccallback()
+
     def uninstallfuncinlist(self,f):
         """Uninstall the specified function"""
         # --- An element by element search is needed
@@ -236,6 +293,11 @@ class CallbackFunctions(object):
         # if there are no functions left, remove the C callback
         if not self.hasfuncsinstalled():
             self.clearlist()
+        else:
+            funckeys = [self._funckey(func) for func in self.funcs]
+            self.intervals = {
+                key: val for key, val in self.intervals.items() if key in funckeys}
+            self._installccallback()
 
     def isinstalledfuncinlist(self,f):
         """Checks if the specified function is installed"""
@@ -298,12 +360,14 @@ callback_instances = {
 for key, val in callback_instances.items():
     callback_instances[key] = CallbackFunctions(name=key, **val)
 
-def installcallback(name, f):
+def installcallback(name, f, intervals=None):
     """Installs a function to be called at that specified time.
 
     Adds a function to the list of functions called by this callback.
+    If intervals is given (e.g. "100" or "0:1000:10"), the function is only
+    called at the steps contained in the intervals.
     """
-    callback_instances[name].installfuncinlist(f)
+    callback_instances[name].installfuncinlist(f, intervals)
 
 def uninstallcallback(name, f):
     """Uninstalls the function (so it won't be called anymore).
@@ -318,6 +382,33 @@ def isinstalled(name, f):
 def clear_all():
     for key, val in callback_instances.items():
         val.clearlist()
+    for name in list(native_callbacks):
+        uninstallnativecallbacks(name)
+
+#=============================================================================
+
+# --- References to the installed native functions, so that they are kept alive
+native_callbacks = {}
+
+def installnativecallback(name, f, intervals=None):
+    """Installs a compiled function ``void f(int step)`` to be called at the
+    specified time, without going through the Python interpreter.
+
+    f can be a ctypes function (e.g. ``ctypes.CDLL(...).func``, or a
+    ``ctypes.CFUNCTYPE(None, ctypes.c_int)`` instance wrapping compiled code)
+    or the address of the function as an integer. If intervals is given,
+    the function is only called at the steps contained in the intervals.
+    """
+    if name not in callback_instances:
+        raise KeyError(f"Unknown callback location '{name}'")
+    address = f if isinstance(f, int) else ctypes.cast(f, ctypes.c_void_p).value
+    libwarpx.libwarpx_so.add_native_callback(name, address, intervals or '')
+    native_callbacks.setdefault(name, []).append(f)
+
+def uninstallnativecallbacks(name):
+    """Uninstalls all the native functions of this callback."""
+    libwarpx.libwarpx_so.remove_native_callbacks(name)
+    native_callbacks.pop(name, None)
 
 #=============================================================================
 
@@ -40,6 +40,8 @@ ExCPPMLWrapper, EyCPPMLWrapper, EzCPPMLWrapper
 BxCPPMLWrapper, ByCPPMLWrapper, BzCPPMLWrapper
 JxCPPMLWrapper, JyCPPMLWrapper, JzCPPMLWrapper
 FCPPMLWrapper, GCPPMLWrapper
+
+FieldLocalViews: zero-copy views of the local boxes of a field on all the levels
 """
 import numpy as np
 
@@ -281,10 +283,9 @@ class _MultiFABWrapper(object):
         assert imin <= iistop <= imax, Exception(f'Dimension {d+1} upper index is out of bounds')
         return iistart, iistop
 
-    def _get_field(self, mfi):
-        """Return the field at the given mfi.
-        If include ghosts is true, return the whole array, otherwise
-        return the interior slice that does not include the ghosts.
+    def _get_array(self, mfi):
+        """Return the whole array at the given mfi, including the ghosts,
+        without copying the data.
         """
         # Note that the array will always have 4 dimensions.
         # even when self.dim < 3.
@@ -294,12 +295,19 @@ class _MultiFABWrapper(object):
         device_arr4 = self.mf.array(mfi)
         if libwarpx.libwarpx_so.Config.have_gpu:
             if cp is not None:
-                device_arr = device_arr4.to_cupy(copy=False)
+                return device_arr4.to_cupy(copy=False)
             else:
                 # Relies on managed memory
-                device_arr = device_arr4.to_numpy(copy=False)
+                return device_arr4.to_numpy(copy=False)
         else:
-            device_arr = device_arr4.to_numpy(copy=False)
+            return device_arr4.to_numpy(copy=False)
+
+    def _get_field(self, mfi):
+        """Return the field at the given mfi.
+        If include ghosts is true, return the whole array, otherwise
+        return the interior slice that does not include the ghosts.
+        """
+        device_arr = self._get_array(mfi)
         if not self.include_ghosts:
             nghosts = self._get_n_ghosts()
             device_arr = device_arr[tuple([slice(ng, -ng) for ng in nghosts[:self.dim]])]
@@ -556,6 +564,85 @@ class _MultiFABWrapper(object):
     def norm0(self, *args):
         return self.mf.norm0(*args)
 
+    def local_views(self):
+        """Returns the data of the boxes owned by this process, without any
+        copy or communication: on GPU, the arrays stay on the device.
+
+        Returns
+        -------
+        list of FieldBoxView
+            One entry per local box, with the global index range of the box
+            and the arrays with and without the ghost cells
+        """
+        nghosts = self._get_n_ghosts()[:self.dim]
+        views = []
+        for mfi in self.mf:
+            array = self._get_array(mfi)
+            box = mfi.validbox()
+            valid = array[tuple([slice(ng, array.shape[i] - ng) for i, ng in enumerate(nghosts)])]
+            views.append(FieldBoxView(index=mfi.index,
+                                      lo=list(box.small_end)[:self.dim],
+                                      hi=list(box.big_end)[:self.dim],
+                                      nghosts=nghosts,
+                                      array=array,
+                                      valid=valid))
+        return views
+
+
+class FieldBoxView(object):
+    """Zero-copy view of the data of one box of a MultiFab, as returned by
+    :py:meth:`_MultiFABWrapper.local_views`.
+
+    Parameters
+    ----------
+     index: int
+         The index of the box in the BoxArray of the level
+
+     lo, hi: list of int
+         The global indices of the lower and upper valid cells (or nodes) of the box,
+         with the index type of the MultiFab
+
+     nghosts: list of int
+         The number of ghost cells along each direction
+
+     array: numpy or cupy array
+         The data of the box including the ghost cells, with the shape (nx, ny, nz, ncomp)
+         (the global index lo[i] - nghosts[i] being at 0 along the axis i)
+
+     valid: numpy or cupy array
+         The data of the valid part of the box (a view of array)
+    """
+    def __init__(self, index, lo, hi, nghosts, array, valid):
+        self.index = index
+        self.lo = lo
+        self.hi = hi
+        self.nghosts = nghosts
+        self.array = array
+        self.valid = valid
+
+
+def FieldLocalViews(mf_name, levels=None):
+    """Returns the zero-copy views of the boxes owned by this process of a field,
+    on each level, without any global gather (see :py:meth:`_MultiFABWrapper.local_views`).
+
+    Parameters
+    ----------
+     mf_name: string
+         The name of the MultiFab without the level suffix, e.g.
+         ``Efield_fp[x]``, ``Bfield_fp[z]``, ``current_fp[y]`` or ``rho_fp``
+
+     levels: list of int, optional
+         The refinement levels (default: all the levels)
+
+    Returns
+    -------
+    dict
+        The list of FieldBoxView of each level
+    """
+    if levels is None:
+        levels = range(libwarpx.warpx.finest_level + 1)
+    return {level: _MultiFABWrapper(mf_name=mf_name, level=level).local_views() for level in levels}
+
 
 def ExWrapper(level=0, include_ghosts=False):
     return _MultiFABWrapper(mf_name='Efield_aux[x]', level=level, include_ghosts=include_ghosts)
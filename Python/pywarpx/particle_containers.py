@@ -154,6 +154,79 @@ class ParticleContainerWrapper(object):
         )
 
 
+    def add_particles_device(self, n, x=None, y=None, z=None, ux=None, uy=None,
+                             uz=None, w=None, unique_particles=True, **kwargs):
+        '''
+        A function for adding particles to the WarpX simulation from arrays
+        that reside on the device (CuPy arrays on GPU, NumPy arrays on CPU).
+        The arrays are read in place by the particle initialization kernel,
+        without staging through the host, before a single redistribution.
+
+        Parameters
+        ----------
+
+        n                : int
+            The number of particles
+
+        x, y, z          : arrays or scalars
+            The particle positions (m) (default = 0.)
+
+        ux, uy, uz       : arrays or scalars
+            The particle proper velocities (m/s) (default = 0.)
+
+        w                : array or scalars
+            Particle weights (default = 0.)
+
+        unique_particles : bool
+            True means the added particles are duplicated by each process;
+            False means the number of added particles is independent of
+            the number of processes (default = True)
+
+        kwargs           : dict
+            Containing an entry for all the extra particle attribute arrays. If
+            an attribute is not given it will be set to 0.
+        '''
+        xp, cupy_status = load_cupy()
+
+        if self.particle_container.particle_real_size == 4:
+            dtype = xp.float32
+        else:
+            dtype = xp.float64
+
+        def as_array(val):
+            # --- Scalars are broadcast into arrays of length n; arrays are only
+            # --- copied (on the device) if they are not contiguous or of another type
+            if val is None or np.size(val) == 1:
+                return xp.full(n, (val or 0.), dtype=dtype)
+            assert len(val) == n, "Length of the particle array doesn't match n"
+            return xp.ascontiguousarray(val, dtype=dtype)
+
+        def address(arr):
+            if hasattr(arr, '__cuda_array_interface__'):
+                return arr.__cuda_array_interface__['data'][0]
+            return arr.__array_interface__['data'][0]
+
+        arrays = [as_array(val) for val in (x, y, z, ux, uy, uz)]
+
+        # --- The number of built in attributes (see add_particles)
+        built_in_attrs = libwarpx.dim + 3
+        if libwarpx.geometry_dim == 'rz':
+            built_in_attrs += 1
+
+        # --- The extra attributes (including the weight), in the order of the components
+        nattr = self.particle_container.num_real_comps - built_in_attrs
+        attr = [None]*nattr
+        attr[0] = w
+        for key, vals in kwargs.items():
+            attr[self.particle_container.get_comp_index(key) - built_in_attrs] = vals
+        attr = [as_array(val) for val in attr]
+
+        self.particle_container.add_n_particles_device(
+            0, n, *[address(arr) for arr in arrays],
+            [address(arr) for arr in attr], [], unique_particles
+        )
+
+
     def get_particle_count(self, local=False):
         '''
         Get the number of particles of this species in the simulation.
@@ -323,6 +396,91 @@ class ParticleContainerWrapper(object):
         return data_array
 
 
+    def get_particle_tile_views(self, level=0, comp_names=None):
+        '''
+        This returns, for each tile of this process, a dictionary of the
+        particle component arrays of the tile, in a single pass over the tiles.
+
+        The arrays are numpy arrays (CPU) or cupy arrays (GPU) sharing the
+        underlying memory buffer with WarpX: no data is copied. They export
+        the ``__array_interface__`` (numpy) or ``__cuda_array_interface__``
+        (cupy) and the DLPack protocol (``__dlpack__``), so that they can be
+        consumed without copies by e.g. ``torch.from_dlpack`` or
+        ``jax.dlpack.from_dlpack``, on the device where the data lives.
+
+        Parameters
+        ----------
+
+        level          : int
+            The refinement level to reference (default=0)
+
+        comp_names     : list of str
+            The real and int components (or ``idcpu``) to return
+            (default: all the components)
+
+        Returns
+        -------
+
+        List of dictionaries
+            The component arrays of each tile
+        '''
+        real_comps = self.particle_container.real_comp_names
+        int_comps = self.particle_container.int_comp_names
+        if comp_names is None:
+            comp_names = list(real_comps) + list(int_comps) + ['idcpu']
+        for comp_name in comp_names:
+            if comp_name not in real_comps and comp_name not in int_comps and comp_name != 'idcpu':
+                raise KeyError(f"Unknown particle component '{comp_name}' of species '{self.name}'")
+
+        xp, cupy_status = load_cupy()
+        if cupy_status is not None:
+            libwarpx.amr.Print(cupy_status)
+
+        tile_views = []
+        for pti in libwarpx.libwarpx_so.WarpXParIter(self.particle_container, level):
+            soa = pti.soa()
+            tile_view = {}
+            for comp_name in comp_names:
+                if comp_name in real_comps:
+                    data = soa.get_real_data(real_comps[comp_name])
+                elif comp_name in int_comps:
+                    data = soa.get_int_data(int_comps[comp_name])
+                else:
+                    data = soa.get_idcpu_data()
+                tile_view[comp_name] = xp.array(data, copy=False)
+            tile_views.append(tile_view)
+
+        return tile_views
+
+
+    def get_particle_level_view(self, level=0, comp_names=None):
+        '''
+        This returns a view of the particle component arrays of all the tiles
+        of a level on this process, see :py:class:`ParticleLevelView`.
+
+        The tiles are separate allocations: the view holds one zero-copy array
+        per tile and component (see ``get_particle_tile_views()``), with the
+        offsets of the tiles in the concatenated particle list.
+
+        Parameters
+        ----------
+
+        level          : int
+            The refinement level to reference (default=0)
+
+        comp_names     : list of str
+            The real and int components (or ``idcpu``) to return
+            (default: all the components)
+
+        Returns
+        -------
+
+        ParticleLevelView
+            The component arrays of all the tiles of the level
+        '''
+        return ParticleLevelView(self.get_particle_tile_views(level, comp_names))
+
+
     def get_particle_idcpu(self, level=0, copy_to_host=False):
         '''
         Return a list of numpy or cupy arrays containing the particle 'idcpu'
@@ -719,6 +877,46 @@ class ParticleContainerWrapper(object):
             libwarpx.warpx.sync_rho()
 
 
+class ParticleLevelView(object):
+    """Zero-copy view of the particle component arrays of all the tiles of a
+    level on this process, as returned by
+    :py:meth:`ParticleContainerWrapper.get_particle_level_view`.
+
+    ``view[comp_name]`` is the list of the arrays of the component on each tile,
+    and the particles of tile ``i`` are ``offsets[i]:offsets[i+1]`` in the
+    concatenated particle list of the level.
+    """
+
+    def __init__(self, tile_views):
+        self.tile_views = tile_views
+        self.comp_names = list(tile_views[0]) if tile_views else []
+        self.offsets = np.zeros(len(tile_views) + 1, dtype=np.int64)
+        for i, tile_view in enumerate(tile_views):
+            num_particles = len(next(iter(tile_view.values()))) if tile_view else 0
+            self.offsets[i+1] = self.offsets[i] + num_particles
+
+    @property
+    def num_tiles(self):
+        return len(self.tile_views)
+
+    @property
+    def num_particles(self):
+        return int(self.offsets[-1])
+
+    def __getitem__(self, comp_name):
+        return [tile_view[comp_name] for tile_view in self.tile_views]
+
+    def concatenate(self, comp_name):
+        """Return the component of all the particles of the level as a single
+        array. Unlike the tile arrays, this copies the data (on the device for
+        GPU runs) and modifications are not seen by WarpX."""
+        arrays = self[comp_name]
+        if not arrays:
+            return np.empty(0)
+        xp, cupy_status = load_cupy()
+        return xp.concatenate(arrays)
+
+
 class ParticleBoundaryBufferWrapper(object):
     """Wrapper around particle boundary buffer containers.
     This provides a convenient way to query data in the particle boundary
@@ -11,6 +11,7 @@
 #include "LatticeElements/Drift.H"
 #include "LatticeElements/HardEdgedQuadrupole.H"
 #include "LatticeElements/HardEdgedPlasmaLens.H"
+#include "WarpX.H"
 
 #include <AMReX_REAL.H>
 
@@ -105,3 +106,10 @@ AcceleratorLattice::GetFinderDeviceInstance (WarpXParIter const& a_pti, int cons
     const LatticeElementFinder & finder = (*m_element_finder)[a_pti];
     return finder.GetFinderDeviceInstance(a_pti, a_offset, *this);
 }
+
+bool
+AcceleratorLattice::HasActiveElements (WarpXParIter const& a_pti) const
+{
+    const LatticeElementFinder & finder = (*m_element_finder)[a_pti];
+    return finder.HasActiveElements(WarpX::GetInstance().getdt(a_pti.GetLevel()));
+}
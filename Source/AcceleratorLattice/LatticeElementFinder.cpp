@@ -12,8 +12,26 @@
 #include <AMReX_ParmParse.H>
 #include <AMReX_REAL.H>
 
+#include <algorithm>
+#include <vector>
+
 using namespace amrex::literals;
 
+namespace
+{
+    /** Whether any of the elements [zs, ze] of a type overlaps the range [zlo, zhi].
+     *  The elements of the same type do not overlap, so that they are sorted along z. */
+    bool AnyElementOverlaps (std::vector<amrex::ParticleReal> const& zs,
+                             std::vector<amrex::ParticleReal> const& ze,
+                             amrex::ParticleReal zlo, amrex::ParticleReal zhi)
+    {
+        // First element that ends after zlo
+        auto const it = std::lower_bound(ze.begin(), ze.end(), zlo);
+        if (it == ze.end()) { return false; }
+        return zs[it - ze.begin()] <= zhi;
+    }
+}
+
 void
 LatticeElementFinder::InitElementFinder (int const lev, amrex::MFIter const& a_mfi,
                                          AcceleratorLattice const& accelerator_lattice)
@@ -48,6 +66,8 @@ LatticeElementFinder::AllocateIndices (AcceleratorLattice const& accelerator_lat
     if (accelerator_lattice.h_plasmalens.nelements > 0) {
         d_plasmalens_indices.resize(m_nz);
     }
+
+    m_indices_filled = false;
 }
 
 void
@@ -63,17 +83,48 @@ LatticeElementFinder::UpdateIndices (int const lev, amrex::MFIter const& a_mfi,
     m_zmin = WarpX::LowerCorner(box, lev, 0._rt)[2];
     m_time = warpx.gett_new(lev);
 
+    UpdateActiveElements(lev, accelerator_lattice);
+
+    // In the lab frame, the indices only change when the grid moves
+    if (m_indices_filled && m_gamma_boost <= 1._prt && m_zmin == m_indices_zmin) { return; }
+
     if (accelerator_lattice.h_quad.nelements > 0) {
         setup_lattice_indices(accelerator_lattice.h_quad.d_zs,
                               accelerator_lattice.h_quad.d_ze,
-                              d_quad_indices);
+                              d_quad_indices, m_indices_filled);
     }
 
     if (accelerator_lattice.h_plasmalens.nelements > 0) {
         setup_lattice_indices(accelerator_lattice.h_plasmalens.d_zs,
                               accelerator_lattice.h_plasmalens.d_ze,
-                              d_plasmalens_indices);
+                              d_plasmalens_indices, m_indices_filled);
     }
+
+    m_indices_filled = true;
+    m_indices_zmin = m_zmin;
+}
+
+void
+LatticeElementFinder::UpdateActiveElements (int const lev, AcceleratorLattice const& accelerator_lattice)
+{
+    auto& warpx = WarpX::GetInstance();
+
+    // The particles of the tile are within the guard cells of the grid,
+    // and the field is applied over the range from z to z + vz*dt
+    const amrex::Real dt = warpx.getdt(lev);
+    const int ng = warpx.getngEB()[WARPX_ZINDEX];
+    const amrex::Real zlo = m_zmin - ng*m_dz - PhysConst::c*dt;
+    const amrex::Real zhi = m_zmin + (m_nz + ng)*m_dz + PhysConst::c*dt;
+
+    // Corresponding range in the lab frame, from the time of the push to the end of the step
+    const auto zlo_lab = static_cast<amrex::ParticleReal>(m_gamma_boost*zlo + m_uz_boost*m_time);
+    const auto zhi_lab = static_cast<amrex::ParticleReal>(m_gamma_boost*zhi + m_uz_boost*(m_time + dt));
+
+    m_quad_active = accelerator_lattice.h_quad.nelements > 0 &&
+        AnyElementOverlaps(accelerator_lattice.h_quad.h_zs, accelerator_lattice.h_quad.h_ze, zlo_lab, zhi_lab);
+    m_plasmalens_active = accelerator_lattice.h_plasmalens.nelements > 0 &&
+        AnyElementOverlaps(accelerator_lattice.h_plasmalens.h_zs, accelerator_lattice.h_plasmalens.h_ze, zlo_lab, zhi_lab);
+    m_active_dt = dt;
 }
 
 LatticeElementFinderDevice
@@ -109,12 +160,13 @@ LatticeElementFinderDevice::InitLatticeElementFinderDevice (WarpXParIter const&
     m_dz = h_finder.m_dz;
     m_time = h_finder.m_time;
 
-    if (accelerator_lattice.h_quad.nelements > 0) {
+    // The element types without elements near the tile are left out (with nelements = 0)
+    if (h_finder.QuadActive(m_dt)) {
         d_quad = accelerator_lattice.h_quad.GetDeviceInstance();
         d_quad_indices_arr = h_finder.d_quad_indices.data();
     }
 
-    if (accelerator_lattice.h_plasmalens.nelements > 0) {
+    if (h_finder.PlasmaLensActive(m_dt)) {
         d_plasmalens = accelerator_lattice.h_plasmalens.GetDeviceInstance();
         d_plasmalens_indices_arr = h_finder.d_plasmalens_indices.data();
     }
@@ -124,7 +176,8 @@ LatticeElementFinderDevice::InitLatticeElementFinderDevice (WarpXParIter const&
 void
 LatticeElementFinder::setup_lattice_indices (amrex::Gpu::DeviceVector<amrex::ParticleReal> const & zs,
                        amrex::Gpu::DeviceVector<amrex::ParticleReal> const & ze,
-                       amrex::Gpu::DeviceVector<int> & indices) const
+                       amrex::Gpu::DeviceVector<int> & indices,
+                       bool const from_previous) const
 {
 
     using namespace amrex::literals;
@@ -152,18 +205,30 @@ LatticeElementFinder::setup_lattice_indices (amrex::Gpu::DeviceVector<amrex::Par
                 z_node = gamma_boost*z_node + uz_boost*time;
             }
 
-            // Find the index to the element that is closest to the grid cell.
-            // For now, this assumes that there is no overlap among elements of the same type.
-            for (int ie = 0 ; ie < nelements ; ie++) {
-                // Find the mid points between element ie and the ones before and after it.
-                // The first and last element need special handling.
-                const amrex::ParticleReal zcenter_left = (ie == 0)?
-                    (std::numeric_limits<amrex::ParticleReal>::lowest()) : (0.5_prt*(ze_arr[ie-1] + zs_arr[ie]));
-                const amrex::ParticleReal zcenter_right = (ie < nelements - 1)?
-                    (0.5_prt*(ze_arr[ie] + zs_arr[ie+1])) : (std::numeric_limits<amrex::ParticleReal>::max());
-                if (zcenter_left <= z_node && z_node < zcenter_right) {
-                    indices_arr[iz] = ie;
+            // Find the index to the element that is closest to the grid cell, i.e. the element ie
+            // such that z_node is between the mid points between element ie and the ones before
+            // and after it. This assumes that the elements of the same type do not overlap,
+            // so that they are sorted along z.
+            // The first and last element need special handling.
+            auto const zcenter_left = [=] (int ie) {
+                return (ie == 0)? (std::numeric_limits<amrex::ParticleReal>::lowest()) :
+                    (0.5_prt*(ze_arr[ie-1] + zs_arr[ie]));
+            };
+            int ie = 0;
+            if (from_previous) {
+                // Move the previous index to the element that now contains the grid node
+                ie = indices_arr[iz];
+                while (ie > 0 && z_node < zcenter_left(ie)) { --ie; }
+                while (ie < nelements - 1 && zcenter_left(ie+1) <= z_node) { ++ie; }
+            } else {
+                // Binary search for the last element whose left mid point is before the grid node
+                int ihi = nelements - 1;
+                while (ie < ihi) {
+                    const int imid = (ie + ihi + 1)/2;
+                    if (zcenter_left(imid) <= z_node) { ie = imid; }
+                    else { ihi = imid - 1; }
                 }
             }
+            indices_arr[iz] = ie;
         });
 }
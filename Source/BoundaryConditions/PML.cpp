@@ -21,6 +21,7 @@
 #include "Utils/Parser/ParserUtils.H"
 #include "WarpX.H"
 
+#include <ablastr/utils/CommStats.H>
 #include <ablastr/utils/Communication.H>
 
 #include <AMReX.H>
@@ -40,10 +41,13 @@
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_IndexType.H>
+#include <AMReX_LayoutData.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_Periodicity.H>
 #include <AMReX_RealVect.H>
 #include <AMReX_SPACE.H>
+#include <AMReX_Vector.H>
 #include <AMReX_VisMF.H>
 
 #include <algorithm>
@@ -116,6 +120,18 @@ namespace
         });
     }
 
+    /** Boxes where \p bx intersects the boxes of \p ba, or their periodic images */
+    amrex::Vector<Box> Overlaps (const BoxArray& ba, const Box& bx, const Periodicity& period)
+    {
+        amrex::Vector<Box> overlaps;
+        for (const auto& iv : period.shiftIntVect()) {
+            for (const auto& isect : ba.intersections(bx + iv)) {
+                overlaps.push_back(isect.second - iv);
+            }
+        }
+        return overlaps;
+    }
+
 #if (AMREX_SPACEDIM != 1)
     void FillZero (Sigma& sigma, Sigma& sigma_cumsum,
                           Sigma& sigma_star, Sigma& sigma_star_cumsum,
@@ -754,6 +770,7 @@ PML::PML (const int lev, const BoxArray& grid_ba,
         // Flags passed to the spectral solver constructor
         const bool in_pml = true;
         const bool periodic_single_box = false;
+        const bool distributed_fft = false;
         const bool update_with_rho = false;
         const bool fft_do_time_averaging = false;
         const RealVect dx{AMREX_D_DECL(geom->CellSize(0), geom->CellSize(1), geom->CellSize(2))};
@@ -764,7 +781,7 @@ PML::PML (const int lev, const BoxArray& grid_ba,
         realspace_ba.enclosedCells().grow(nge); // cell-centered + guard cells
         spectral_solver_fp = std::make_unique<SpectralSolver>(lev, realspace_ba, dm,
             nox_fft, noy_fft, noz_fft, grid_type, v_galilean,
-            v_comoving_zero, dx, dt, in_pml, periodic_single_box, update_with_rho,
+            v_comoving_zero, dx, dt, in_pml, periodic_single_box, distributed_fft, update_with_rho,
             fft_do_time_averaging, psatd_solution_type, J_in_time, rho_in_time, m_dive_cleaning, m_divb_cleaning);
 #endif
     }
@@ -866,6 +883,7 @@ PML::PML (const int lev, const BoxArray& grid_ba,
             // Flags passed to the spectral solver constructor
             const bool in_pml = true;
             const bool periodic_single_box = false;
+            const bool distributed_fft = false;
             const bool update_with_rho = false;
             const bool fft_do_time_averaging = false;
             const RealVect cdx{AMREX_D_DECL(cgeom->CellSize(0), cgeom->CellSize(1), cgeom->CellSize(2))};
@@ -876,7 +894,7 @@ PML::PML (const int lev, const BoxArray& grid_ba,
             realspace_cba.enclosedCells().grow(nge); // cell-centered + guard cells
             spectral_solver_cp = std::make_unique<SpectralSolver>(lev, realspace_cba, cdm,
                 nox_fft, noy_fft, noz_fft, grid_type, v_galilean,
-                v_comoving_zero, cdx, dt, in_pml, periodic_single_box, update_with_rho,
+                v_comoving_zero, cdx, dt, in_pml, periodic_single_box, distributed_fft, update_with_rho,
                 fft_do_time_averaging, psatd_solution_type, J_in_time, rho_in_time, m_dive_cleaning, m_divb_cleaning);
 #endif
         }
@@ -1170,81 +1188,121 @@ PML::Exchange (MultiFab& pml, MultiFab& reg, const Geometry& geom,
                 int do_pml_in_domain)
 {
     WARPX_PROFILE("PML::Exchange");
+    const ablastr::utils::communication::ScopedCommSite comm_site("PMLExchange");
 
     const IntVect& ngr = reg.nGrowVect();
     const IntVect& ngp = pml.nGrowVect();
     const int ncp = pml.nComp();
     const auto& period = geom.periodicity();
 
-    // Create temporary MultiFab to copy to and from the PML
-    MultiFab tmpregmf(reg.boxArray(), reg.DistributionMap(), ncp, ngr);
-    tmpregmf.setVal(0.0);
-
-    // Create the sum of the split fields, in the PML
+    // Create the sum of the split fields, in the PML, in a single pass
     MultiFab totpmlmf(pml.boxArray(), pml.DistributionMap(), 1, 0); // Allocate
-    MultiFab::LinComb(totpmlmf, 1.0, pml, 0, 1.0, pml, 1, 0, 1, 0); // Sum
-    if (ncp == 3) {
-        MultiFab::Add(totpmlmf,pml,2,0,1,0); // Sum the third split component
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(totpmlmf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        const auto tot = totpmlmf.array(mfi);
+        const auto src = pml.const_array(mfi);
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            Real sum = src(i,j,k,0) + src(i,j,k,1);
+            if (ncp == 3) { sum += src(i,j,k,2); } // Sum the third split component
+            tot(i,j,k) = sum;
+        });
     }
 
-    // Copy from the sum of PML split field to valid cells of regular grid
     if (do_pml_in_domain){
+        // Create temporary MultiFab to copy to and from the PML
+        MultiFab tmpregmf(reg.boxArray(), reg.DistributionMap(), ncp, ngr);
+        tmpregmf.setVal(0.0);
+
         // Valid cells of the PML and of the regular grid overlap
         // Copy from valid cells of the PML to valid cells of the regular grid
         ablastr::utils::communication::ParallelCopy(reg, totpmlmf, 0, 0, 1, IntVect(0), IntVect(0),
                                                     WarpX::do_single_precision_comms,
                                                     period);
-    } else {
-        // Valid cells of the PML only overlap with guard cells of regular grid
-        // (and outermost valid cell of the regular grid, for nodal direction)
-        // Copy from valid cells of PML to ghost cells of regular grid
-        // but avoid updating the outermost valid cell
-        if (ngr.max() > 0) {
-            MultiFab::Copy(tmpregmf, reg, 0, 0, 1, ngr);
-            ablastr::utils::communication::ParallelCopy(tmpregmf, totpmlmf, 0, 0, 1, IntVect(0), ngr,
-                                   WarpX::do_single_precision_comms,
-                                                        period);
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (Gpu::notInLaunchRegion())
-#endif
-            for (MFIter mfi(reg); mfi.isValid(); ++mfi)
-            {
-                const FArrayBox& src = tmpregmf[mfi];
-                FArrayBox& dst = reg[mfi];
-                const auto srcarr = src.array();
-                auto dstarr = dst.array();
-                const BoxList& bl = amrex::boxDiff(dst.box(), mfi.validbox());
-                // boxDiff avoids the outermost valid cell
-                for (const Box& bx : bl) {
-                    amrex::ParallelFor(bx,
-                                       [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-                                       {
-                                           dstarr(i,j,k,0) = srcarr(i,j,k,0);
-                                       });
-                }
-            }
-        }
-    }
 
-    // Copy from valid cells of the regular grid to guard cells of the PML
-    // (and outermost valid cell in the nodal direction)
-    // More specifically, copy from regular data to PML's first component
-    // Zero out the second (and third) component
-    MultiFab::Copy(tmpregmf,reg,0,0,1,0); // Fill first component of tmpregmf
-    tmpregmf.setVal(0.0, 1, ncp-1, 0); // Zero out the second (and third) component
-    if (do_pml_in_domain){
+        // Copy from valid cells of the regular grid to guard cells of the PML
+        // More specifically, copy from regular data to PML's first component
+        // Zero out the second (and third) component
+        MultiFab::Copy(tmpregmf,reg,0,0,1,0); // Fill first component of tmpregmf
+        tmpregmf.setVal(0.0, 1, ncp-1, 0); // Zero out the second (and third) component
         // Where valid cells of tmpregmf overlap with PML valid cells,
         // copy the PML (this is order to avoid overwriting PML valid cells,
         // in the next `ParallelCopy`)
         ablastr::utils::communication::ParallelCopy(tmpregmf, pml, 0, 0, ncp, IntVect(0), IntVect(0),
                                                     WarpX::do_single_precision_comms,
                                                     period);
+        ablastr::utils::communication::ParallelCopy(pml, tmpregmf, 0, 0, ncp, IntVect(0), ngp,
+                                                    WarpX::do_single_precision_comms, period);
+        return;
     }
-    ablastr::utils::communication::ParallelCopy(pml, tmpregmf, 0, 0, ncp, IntVect(0), ngp,
+
+    // Valid cells of the PML only overlap with guard cells of regular grid
+    // (and outermost valid cell of the regular grid, for nodal direction).
+    // The fields are copied directly between the PML and the regular grid, instead of
+    // through a temporary copy of the regular grid (with all split components), which
+    // would be as large as the whole domain.
+
+    // Copy from valid cells of PML to ghost cells of regular grid
+    // but avoid updating the outermost valid cell: save the valid cells of the
+    // regular grid that overlap with the PML, and restore them after the copy
+    if (ngr.max() > 0) {
+        LayoutData<amrex::Vector<FArrayBox>> saved(reg.boxArray(), reg.DistributionMap());
+        for (MFIter mfi(reg); mfi.isValid(); ++mfi)
+        {
+            const auto regarr = reg.const_array(mfi);
+            for (const Box& bx : Overlaps(pml.boxArray(), mfi.validbox(), period)) {
+                FArrayBox& fab = saved[mfi].emplace_back(bx, 1, The_Async_Arena());
+                const auto savedarr = fab.array();
+                amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    savedarr(i,j,k) = regarr(i,j,k,0);
+                });
+            }
+        }
+        ablastr::utils::communication::ParallelCopy(reg, totpmlmf, 0, 0, 1, IntVect(0), ngr,
+                                                    WarpX::do_single_precision_comms,
+                                                    period);
+        for (MFIter mfi(reg); mfi.isValid(); ++mfi)
+        {
+            const auto regarr = reg.array(mfi);
+            for (const FArrayBox& fab : saved[mfi]) {
+                const auto savedarr = fab.const_array();
+                amrex::ParallelFor(fab.box(), [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    regarr(i,j,k,0) = savedarr(i,j,k);
+                });
+            }
+        }
+        // Synchronize so that the saved cells can be safely deallocated
+        Gpu::streamSynchronize();
+    }
+
+    // Copy from valid cells of the regular grid to guard cells of the PML
+    // (and outermost valid cell in the nodal direction)
+    // More specifically, copy from regular data to PML's first component
+    // Zero out the second (and third) component
+    ablastr::utils::communication::ParallelCopy(pml, reg, 0, 0, 1, IntVect(0), ngp,
                                                 WarpX::do_single_precision_comms, period);
+    if (ncp == 1) { return; }
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(pml); mfi.isValid(); ++mfi)
+    {
+        const auto pmlarr = pml.array(mfi);
+        for (const Box& bx : Overlaps(reg.boxArray(), mfi.fabbox(), period)) {
+            amrex::ParallelFor(bx, ncp-1, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+            {
+                pmlarr(i,j,k,n+1) = 0.0_rt;
+            });
+        }
+    }
 }
 
-
 void
 PML::CopyToPML (MultiFab& pml, MultiFab& reg, const Geometry& geom)
 {
@@ -4,6 +4,7 @@
 
 #include <AMReX_Array4.H>
 #include <AMReX_Box.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
 #include <AMReX_Extension.H>
 #include <AMReX_Geometry.H>
@@ -16,6 +17,9 @@
 #include <AMReX_MultiFab.H>
 #include <AMReX_REAL.H>
 #include <AMReX_SPACE.H>
+#include <AMReX_Vector.H>
+
+#include <algorithm>
 
 using namespace amrex;
 using namespace amrex::literals;
@@ -48,6 +52,41 @@ namespace
     }
 
 
+    /**
+     * \brief Returns disjoint boxes covering the part of the box \p bx that is on or
+     *        beyond a PEC boundary, i.e. the only points that SetEfieldOnPEC and
+     *        SetBfieldOnPEC may modify. The returned list is empty for boxes that
+     *        are away from the PEC boundaries, so that no kernel is launched for them,
+     *        and otherwise only covers thin slabs along the boundaries instead of the
+     *        whole box.
+     *
+     * \param[in] bx              Box to loop over, with the staggering of the field
+     * \param[in] dom_lo, dom_hi  Domain boundaries (cell-centered)
+     * \param[in] is_nodal        Staggering of the field
+     * \param[in] fbndry_lo       Field boundary type at the lower boundaries
+     * \param[in] fbndry_hi       Field boundary type at the upper boundaries
+     */
+    amrex::Vector<amrex::Box> get_PEC_regions (const amrex::Box& bx,
+        const amrex::IntVect& dom_lo, const amrex::IntVect& dom_hi,
+        const amrex::IntVect& is_nodal,
+        amrex::GpuArray<FieldBoundaryType, 3> const& fbndry_lo,
+        amrex::GpuArray<FieldBoundaryType, 3> const& fbndry_hi)
+    {
+        // Points of bx strictly inside the domain with respect to all the PEC boundaries
+        amrex::Box interior = bx;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (fbndry_lo[idim] == FieldBoundaryType::PEC) {
+                interior.setSmall(idim, std::max(bx.smallEnd(idim), dom_lo[idim] + 1));
+            }
+            if (fbndry_hi[idim] == FieldBoundaryType::PEC) {
+                interior.setBig(idim, std::min(bx.bigEnd(idim), dom_hi[idim] + is_nodal[idim] - 1));
+            }
+        }
+        if (!interior.ok()) { return {bx}; }
+        return amrex::boxDiff(bx, interior).data();
+    }
+
+
     /**
      * \brief Sets the electric field value tangential to the PEC boundary to zero. The
      *        tangential Efield components in the guard cells outside the
@@ -506,48 +545,63 @@ PEC::ApplyPECtoEfield (
         amrex::Box const& tez = (split_pml_field) ? mfi.tilebox(Efield[2]->ixType().toIntVect())
                                                   : mfi.tilebox(Efield[2]->ixType().toIntVect(), ng_fieldgather);
 
+        // Only the points on or beyond the PEC boundaries are modified:
+        // loop over the boundary slabs of the tiles that touch them
+        const amrex::Vector<amrex::Box> rx = ::get_PEC_regions(
+            tex, domain_lo, domain_hi, Ex_nodal, fbndry_lo, fbndry_hi);
+        const amrex::Vector<amrex::Box> ry = ::get_PEC_regions(
+            tey, domain_lo, domain_hi, Ey_nodal, fbndry_lo, fbndry_hi);
+        const amrex::Vector<amrex::Box> rz = ::get_PEC_regions(
+            tez, domain_lo, domain_hi, Ez_nodal, fbndry_lo, fbndry_hi);
+        const int nregions = static_cast<int>(std::max({rx.size(), ry.size(), rz.size()}));
+        const auto region = [] (const amrex::Vector<amrex::Box>& r, int ir) {
+            return (ir < static_cast<int>(r.size())) ? r[ir] : amrex::Box();
+        };
+
         // loop over cells and update fields
-        amrex::ParallelFor(
-            tex, nComp_x,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
+        for (int ir = 0; ir < nregions; ++ir) {
+            amrex::ParallelFor(
+                region(rx, ir), nComp_x,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
 #if (defined WARPX_DIM_XZ) || (defined WARPX_DIM_RZ)
-                amrex::ignore_unused(k);
+                    amrex::ignore_unused(k);
 #endif
 #if (defined WARPX_DIM_1D_Z)
-                amrex::ignore_unused(j,k);
+                    amrex::ignore_unused(j,k);
 #endif
-                const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
-                const int icomp = 0;
-                ::SetEfieldOnPEC(icomp, domain_lo, domain_hi, iv, n,
-                                           Ex, Ex_nodal, fbndry_lo, fbndry_hi);
-            },
-            tey, nComp_y,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
+                    const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
+                    const int icomp = 0;
+                    ::SetEfieldOnPEC(icomp, domain_lo, domain_hi, iv, n,
+                                               Ex, Ex_nodal, fbndry_lo, fbndry_hi);
+                },
+                region(ry, ir), nComp_y,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
 #if (defined WARPX_DIM_XZ) || (defined WARPX_DIM_RZ)
-                amrex::ignore_unused(k);
+                    amrex::ignore_unused(k);
 #endif
 #if (defined WARPX_DIM_1D_Z)
-                amrex::ignore_unused(j,k);
+                    amrex::ignore_unused(j,k);
 #endif
-                const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
-                const int icomp = 1;
-                ::SetEfieldOnPEC(icomp, domain_lo, domain_hi, iv, n,
-                                           Ey, Ey_nodal, fbndry_lo, fbndry_hi);
-            },
-            tez, nComp_z,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
+                    const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
+                    const int icomp = 1;
+                    ::SetEfieldOnPEC(icomp, domain_lo, domain_hi, iv, n,
+                                               Ey, Ey_nodal, fbndry_lo, fbndry_hi);
+                },
+                region(rz, ir), nComp_z,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
 #if (defined WARPX_DIM_XZ) || (defined WARPX_DIM_RZ)
-                amrex::ignore_unused(k);
+                    amrex::ignore_unused(k);
 #endif
 #if (defined WARPX_DIM_1D_Z)
-                amrex::ignore_unused(j,k);
+                    amrex::ignore_unused(j,k);
 #endif
-                const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
-                const int icomp = 2;
-                ::SetEfieldOnPEC(icomp, domain_lo, domain_hi, iv, n,
-                                           Ez, Ez_nodal, fbndry_lo, fbndry_hi);
-            }
-        );
+                    const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
+                    const int icomp = 2;
+                    ::SetEfieldOnPEC(icomp, domain_lo, domain_hi, iv, n,
+                                               Ez, Ez_nodal, fbndry_lo, fbndry_hi);
+                }
+            );
+        }
     }
 }
 
@@ -598,48 +652,63 @@ PEC::ApplyPECtoBfield (
         amrex::Box const& tby = mfi.tilebox(Bfield[1]->ixType().toIntVect(), ng_fieldgather);
         amrex::Box const& tbz = mfi.tilebox(Bfield[2]->ixType().toIntVect(), ng_fieldgather);
 
+        // Only the points on or beyond the PEC boundaries are modified:
+        // loop over the boundary slabs of the tiles that touch them
+        const amrex::Vector<amrex::Box> rx = ::get_PEC_regions(
+            tbx, domain_lo, domain_hi, Bx_nodal, fbndry_lo, fbndry_hi);
+        const amrex::Vector<amrex::Box> ry = ::get_PEC_regions(
+            tby, domain_lo, domain_hi, By_nodal, fbndry_lo, fbndry_hi);
+        const amrex::Vector<amrex::Box> rz = ::get_PEC_regions(
+            tbz, domain_lo, domain_hi, Bz_nodal, fbndry_lo, fbndry_hi);
+        const int nregions = static_cast<int>(std::max({rx.size(), ry.size(), rz.size()}));
+        const auto region = [] (const amrex::Vector<amrex::Box>& r, int ir) {
+            return (ir < static_cast<int>(r.size())) ? r[ir] : amrex::Box();
+        };
+
         // loop over cells and update fields
-        amrex::ParallelFor(
-            tbx, nComp_x,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
+        for (int ir = 0; ir < nregions; ++ir) {
+            amrex::ParallelFor(
+                region(rx, ir), nComp_x,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
 #if (defined WARPX_DIM_XZ) || (defined WARPX_DIM_RZ)
-                amrex::ignore_unused(k);
+                    amrex::ignore_unused(k);
 #endif
 #if (defined WARPX_DIM_1D_Z)
-                amrex::ignore_unused(j,k);
+                    amrex::ignore_unused(j,k);
 #endif
-                const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
-                const int icomp = 0;
-                ::SetBfieldOnPEC(icomp, domain_lo, domain_hi, iv, n,
-                                     Bx, Bx_nodal, fbndry_lo, fbndry_hi);
-            },
-            tby, nComp_y,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
+                    const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
+                    const int icomp = 0;
+                    ::SetBfieldOnPEC(icomp, domain_lo, domain_hi, iv, n,
+                                         Bx, Bx_nodal, fbndry_lo, fbndry_hi);
+                },
+                region(ry, ir), nComp_y,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
 #if (defined WARPX_DIM_XZ) || (defined WARPX_DIM_RZ)
-                amrex::ignore_unused(k);
+                    amrex::ignore_unused(k);
 #endif
 #if (defined WARPX_DIM_1D_Z)
-                amrex::ignore_unused(j,k);
+                    amrex::ignore_unused(j,k);
 #endif
-                const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
-                const int icomp = 1;
-                ::SetBfieldOnPEC(icomp, domain_lo, domain_hi, iv, n,
-                                     By, By_nodal, fbndry_lo, fbndry_hi);
-            },
-            tbz, nComp_z,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
+                    const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
+                    const int icomp = 1;
+                    ::SetBfieldOnPEC(icomp, domain_lo, domain_hi, iv, n,
+                                         By, By_nodal, fbndry_lo, fbndry_hi);
+                },
+                region(rz, ir), nComp_z,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
 #if (defined WARPX_DIM_XZ) || (defined WARPX_DIM_RZ)
-                amrex::ignore_unused(k);
+                    amrex::ignore_unused(k);
 #endif
 #if (defined WARPX_DIM_1D_Z)
-                amrex::ignore_unused(j,k);
+                    amrex::ignore_unused(j,k);
 #endif
-                const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
-                const int icomp = 2;
-                ::SetBfieldOnPEC(icomp, domain_lo, domain_hi, iv, n,
-                                     Bz, Bz_nodal, fbndry_lo, fbndry_hi);
-            }
-        );
+                    const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
+                    const int icomp = 2;
+                    ::SetBfieldOnPEC(icomp, domain_lo, domain_hi, iv, n,
+                                         Bz, Bz_nodal, fbndry_lo, fbndry_hi);
+                }
+            );
+        }
     }
 }
 
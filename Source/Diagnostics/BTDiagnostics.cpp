@@ -28,6 +28,7 @@
 
 #include <AMReX.H>
 #include <AMReX_Algorithm.H>
+#include <AMReX_AsyncOut.H>
 #include <AMReX_BLassert.H>
 #include <AMReX_BoxArray.H>
 #include <AMReX_Config.H>
@@ -1101,6 +1102,12 @@ BTDiagnostics::Flush (int i_buffer, bool force_flush)
     // Reset the buffer counter to zero after flushing out data stored in the buffer.
     ResetBufferCounter(i_buffer);
     m_field_buffer_multifab_defined[i_buffer] = 0;
+    // Release the memory of the flushed field buffer. The next buffer of this snapshot,
+    // if any, is allocated only once the next lab-frame z-slice enters the snapshot, so that
+    // snapshots that are complete or not yet reached do not hold a full buffer.
+    for (int lev = 0; lev < nlev_output; ++lev) {
+        m_mf_output[i_buffer][lev] = amrex::MultiFab();
+    }
     IncrementBufferFlushCounter(i_buffer);
     NullifyFirstFlush(i_buffer);
     // if particles are selected for output then update and reset counters
@@ -1123,6 +1130,9 @@ void BTDiagnostics::RedistributeParticleBuffer (const int i_buffer)
 
 void BTDiagnostics::MergeBuffersForPlotfile (int i_snapshot)
 {
+    // With asynchronous output, wait until the buffer files were written
+    if (amrex::AsyncOut::UseAsyncOut()) { amrex::AsyncOut::Finish(); }
+
     // Make sure all MPI ranks wrote their files and closed it
     // Note: additionally, since a Barrier does not guarantee a FS sync
     //       on a parallel FS, we might need to add timeouts and retries
@@ -10,6 +10,7 @@
 #include "Diagnostics/Diagnostics.H"
 #include "Diagnostics/FlushFormats/FlushFormat.H"
 #include "Particles/ParticleBoundaryBuffer.H"
+#include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "WarpX.H"
 
@@ -64,6 +65,12 @@ BoundaryScrapingDiagnostics::ReadParameters ()
     pp_diag_name.queryarr("intervals", intervals_string_vec);
     m_intervals = utils::parser::IntervalsParser(intervals_string_vec);
 
+    // Check for the optional bound on the number of buffered particles
+    utils::parser::queryWithParser(pp_diag_name, "max_buffered_particles", m_max_buffered_particles);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_max_buffered_particles >= 0,
+        m_diag_name + ".max_buffered_particles must be non-negative.");
+
 }
 
 void
@@ -111,13 +118,25 @@ BoundaryScrapingDiagnostics::DoComputeAndPack (int /*step*/, bool /*force_flush*
 }
 
 bool
-BoundaryScrapingDiagnostics::DoDump (int step, int /*i_buffer*/, bool force_flush)
+BoundaryScrapingDiagnostics::DoDump (int step, int i_buffer, bool force_flush)
 {
-    if (force_flush) {
+    if (force_flush || m_intervals.contains(step+1)) {
         return true;
-    } else {
-        return (m_intervals.contains(step+1));
     }
+    if (m_max_buffered_particles == 0) {
+        return false;
+    }
+
+    // Write out the particles early if the buffer of this boundary has grown too large
+    auto & warpx = WarpX::GetInstance();
+    ParticleBoundaryBuffer& particle_buffer = warpx.GetParticleBoundaryBuffer();
+    if (!particle_buffer.isDefinedForAnySpecies(i_buffer)) { return false; }
+
+    int n_particles = 0;
+    for (auto const& species_name : m_output_species_names) {
+        n_particles += particle_buffer.getNumParticlesInContainer(species_name, i_buffer, false);
+    }
+    return (n_particles >= m_max_buffered_particles);
 }
 
 void
@@ -32,6 +32,35 @@
 
 using namespace amrex;
 
+namespace
+{
+    /** \brief Lab-frame value of the field icomp at (i,j,k), from the boosted-frame fields
+     *
+     * arr stores Ex Ey Ez Bx By Bz jx jy jz rho (Er Et Ez Br Bt Bz jr jt jz rho in RZ), the field f
+     * being in the component f*n_rz_comp + rz_comp. The transverse E and B and the pair jz, rho
+     * are mixed by the transform, the other components are unchanged.
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    amrex::Real LorentzTransformedComponent (amrex::Array4<amrex::Real const> const& arr,
+                                             int i, int j, int k, int icomp,
+                                             int n_rz_comp, int rz_comp,
+                                             amrex::Real gamma_boost, amrex::Real beta_boost)
+    {
+        constexpr amrex::Real clight = PhysConst::c;
+        constexpr amrex::Real inv_clight = 1.0_rt/PhysConst::c;
+        auto const f = [&] (int field) { return arr(i, j, k, field*n_rz_comp + rz_comp); };
+        switch (icomp) {
+            case 0: return gamma_boost * ( f(0) + beta_boost * clight * f(4) );
+            case 4: return gamma_boost * ( f(4) + beta_boost * inv_clight * f(0) );
+            case 1: return gamma_boost * ( f(1) - beta_boost * clight * f(3) );
+            case 3: return gamma_boost * ( f(3) - beta_boost * inv_clight * f(1) );
+            case 8: return gamma_boost * ( f(8) + beta_boost * clight * f(9) );
+            case 9: return gamma_boost * ( f(9) + beta_boost * inv_clight * f(8) );
+            default: return f(icomp);
+        }
+    }
+}
+
 BackTransformFunctor::BackTransformFunctor (amrex::MultiFab const * mf_src, int lev,
                                             const int ncomp, const int num_buffers,
                                             amrex::Vector< std::string > varnames,
@@ -75,9 +104,6 @@ BackTransformFunctor::operator ()(amrex::MultiFab& mf_dst, int /*dcomp*/, const
             interpolate);
 
 
-        // Perform in-place Lorentz-transform of all the fields stored in the slice.
-        LorentzTransformZ( *slice, gamma_boost, beta_boost);
-
         // Create a 2D box for the slice in the boosted frame
         const amrex::Real dx = geom.CellSize(moving_window_dir);
         // index corresponding to z_boost location in the boost-frame
@@ -96,7 +122,7 @@ BackTransformFunctor::operator ()(amrex::MultiFab& mf_dst, int /*dcomp*/, const
         tmp_slice_ptr = std::make_unique<MultiFab> ( slice_ba, mf_dst.DistributionMap(),
                                                      slice->nComp(), 0 );
         tmp_slice_ptr->setVal(0.0);
-        // Parallel copy the lab-frame data from "slice" MultiFab with
+        // Parallel copy the boosted-frame data from "slice" MultiFab with
         // ncomp=10 and boosted-frame dmap to "tmp_slice_ptr" MultiFab with
         // ncomp=10 and dmap of the destination Multifab, which will store the final data
         ablastr::utils::communication::ParallelCopy(*tmp_slice_ptr, *slice, 0, 0, slice->nComp(),
@@ -104,24 +130,16 @@ BackTransformFunctor::operator ()(amrex::MultiFab& mf_dst, int /*dcomp*/, const
                                                     IntVect(AMREX_D_DECL(0, 0, 0)),
                                                     WarpX::do_single_precision_comms);
         // Now we will cherry pick only the user-defined fields from
-        // tmp_slice_ptr to dst_mf
+        // tmp_slice_ptr to dst_mf, Lorentz-transforming them to the lab-frame
+        // in the same pass
         const int k_lab = m_k_index_zlab[i_buffer];
         const int ncomp_dst = mf_dst.nComp();
         amrex::MultiFab& tmp = *tmp_slice_ptr;
-#ifdef AMREX_USE_GPU
-        Gpu::DeviceVector<int> d_map_varnames(m_map_varnames.size());
-        Gpu::copyAsync(Gpu::hostToDevice,
-                       m_map_varnames.begin(), m_map_varnames.end(),
-                       d_map_varnames.begin());
-        Gpu::synchronize();
-        int const* field_map_ptr = d_map_varnames.dataPtr();
-#else
-        int const* field_map_ptr = m_map_varnames.dataPtr();
-#endif
+        int const* field_map_ptr = m_d_map_varnames.dataPtr();
         for (amrex::MFIter mfi(tmp, TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
             const Box& tbx = mfi.tilebox();
-            const amrex::Array4<amrex::Real> src_arr = tmp[mfi].array();
+            const amrex::Array4<amrex::Real const> src_arr = tmp.const_array(mfi);
             const amrex::Array4<amrex::Real> dst_arr = mf_dst[mfi].array();
 #ifdef WARPX_DIM_RZ
             const int n_rz_comp = WarpX::ncomps;
@@ -132,9 +150,11 @@ BackTransformFunctor::operator ()(amrex::MultiFab& mf_dst, int /*dcomp*/, const
                     // Field id that corresponds to the nth user-requested component
                     const int icomp = field_map_ptr[n];
 #if defined(WARPX_DIM_3D)
-                    dst_arr(i, j, k_lab, n) = src_arr(i, j, k, icomp);
+                    dst_arr(i, j, k_lab, n) = LorentzTransformedComponent(
+                        src_arr, i, j, k, icomp, 1, 0, gamma_boost, beta_boost);
 #elif defined(WARPX_DIM_XZ)
-                    dst_arr(i, k_lab, k, n) = src_arr(i, j, k, icomp);
+                    dst_arr(i, k_lab, k, n) = LorentzTransformedComponent(
+                        src_arr, i, j, k, icomp, 1, 0, gamma_boost, beta_boost);
 #elif defined(WARPX_DIM_RZ)
                     // rzcomp below gives the component id, 0 to (n_rz_comp-1) for a given field
                     const int rzcomp = n % n_rz_comp;
@@ -146,9 +166,11 @@ BackTransformFunctor::operator ()(amrex::MultiFab& mf_dst, int /*dcomp*/, const
                     // Thus we are accessing real component of mode 1 of Et (note that modes go from 0 to 1)
                     // Since the fields are stored contiguously in src_arr, icomp*n_rz_comp + rz_comp accesses
                     // real part of mode 1 for Et (1*3+1) = 4
-                    dst_arr(i, k_lab, k, n) = src_arr(i, j, k, icomp*n_rz_comp+rzcomp);
+                    dst_arr(i, k_lab, k, n) = LorentzTransformedComponent(
+                        src_arr, i, j, k, icomp, n_rz_comp, rzcomp, gamma_boost, beta_boost);
 #else
-                    dst_arr(k_lab, j, k, n) = src_arr(i, j, k, icomp);
+                    dst_arr(k_lab, j, k, n) = LorentzTransformedComponent(
+                        src_arr, i, j, k, icomp, 1, 0, gamma_boost, beta_boost);
 #endif
                 } );
         }
@@ -221,97 +243,10 @@ BackTransformFunctor::InitData ()
 #endif
     }
 
-}
-
-void
-BackTransformFunctor::LorentzTransformZ (amrex::MultiFab& data, amrex::Real gamma_boost,
-                                         amrex::Real beta_boost) const
-{
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
-#endif
-    for (amrex::MFIter mfi(data, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
-        const amrex::Box& tbx = mfi.tilebox();
-        const amrex::Array4< amrex::Real > arr = data[mfi].array();
-        const amrex::Real clight = PhysConst::c;
-        const amrex::Real inv_clight = 1.0_rt/clight;
-#ifdef WARPX_DIM_RZ
-        const int n_rcomps = WarpX::ncomps;
-        amrex::ParallelFor( tbx,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k)
-            {
-                for (int mode_comp = 0; mode_comp < n_rcomps; ++mode_comp) {
-                    // Back-transform the transverse electric and magnetic fields.
-                    // Note that the z-components, Ez, Bz, are not changed by the transform.
-
-                    // Transform Er_boost & Bt_boost to lab-frame for corresponding mode (mode_comp)
-                    const amrex::Real er_lab = gamma_boost * ( arr(i, j, k, n_rcomps*0 + mode_comp)
-                                            + beta_boost * clight * arr(i, j, k, n_rcomps*4+ mode_comp) );
-                    const amrex::Real bt_lab = gamma_boost * ( arr(i, j, k, n_rcomps*4 + mode_comp)
-                                            + beta_boost * inv_clight * arr(i, j, k, n_rcomps*0 + mode_comp) );
-                    // Store lab-frame data in-place
-                    arr(i, j, k, n_rcomps*0 + mode_comp) = er_lab;
-                    arr(i, j, k, n_rcomps*4 + mode_comp) = bt_lab;
-
-                    // Transform Et_boost & Br_boost to lab-frame for corresponding mode (mode_comp)
-                    const amrex::Real et_lab = gamma_boost * ( arr(i, j, k, n_rcomps*1 + mode_comp)
-                                            - beta_boost * clight * arr(i, j, k, n_rcomps*3 + mode_comp) );
-                    const amrex::Real br_lab = gamma_boost * ( arr(i, j, k, n_rcomps*3 + mode_comp)
-                                            - beta_boost * inv_clight * arr(i, j, k, n_rcomps*1 + mode_comp) );
-                    // Store lab-frame data in-place
-                    arr(i, j, k, n_rcomps*1 + mode_comp) = et_lab;
-                    arr(i, j, k, n_rcomps*3 + mode_comp) = br_lab;
-
-                    // Transform charge density z-component of current density
-                    const amrex::Real j_lab = gamma_boost * ( arr(i, j, k, n_rcomps*8 + mode_comp)
-                                            + beta_boost * clight * arr(i, j, k, n_rcomps*9 + mode_comp) );
-                    const amrex::Real rho_lab = gamma_boost * ( arr(i, j, k, n_rcomps*9 + mode_comp)
-                                              + beta_boost * inv_clight * arr(i, j, k, n_rcomps*8 + mode_comp) );
-                    // Store lab-frame jz and rho in-place
-                    arr(i, j, k, n_rcomps*8 + mode_comp) = j_lab;
-                    arr(i, j, k, n_rcomps*9 + mode_comp) = rho_lab;
-                }
-            }
-        );
-#else
-        // arr(x,y,z,comp) has ten-components namely,
-        // Ex Ey Ez Bx By Bz jx jy jz rho in that order.
-        amrex::ParallelFor( tbx,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k)
-            {
-                // Back-transform the transverse electric and magnetic fields.
-                // Note that the z-components, Ez, Bz, are not changed by the transform.
-
-                // Transform Ex_boost (ncomp=0) & By_boost (ncomp=4) to lab-frame
-                const amrex::Real ex_lab = gamma_boost * ( arr(i, j, k, 0)
-                                        + beta_boost * clight * arr(i, j, k, 4) );
-                const amrex::Real by_lab = gamma_boost * ( arr(i, j, k, 4)
-                                        + beta_boost * inv_clight * arr(i, j, k, 0) );
-                // Store lab-frame data in-place
-                arr(i, j, k, 0) = ex_lab;
-                arr(i, j, k, 4) = by_lab;
-
-                // Transform Ey_boost (ncomp=1) & Bx_boost (ncomp=3) to lab-frame
-                const amrex::Real ey_lab = gamma_boost * ( arr(i, j, k, 1)
-                                        - beta_boost * clight * arr(i, j, k, 3) );
-                const amrex::Real bx_lab = gamma_boost * ( arr(i, j, k, 3)
-                                        - beta_boost * inv_clight * arr(i, j, k, 1) );
-                // Store lab-frame data in-place
-                arr(i, j, k, 1) = ey_lab;
-                arr(i, j, k, 3) = bx_lab;
-
-                // Transform charge density (ncomp=9)
-                // and z-component of current density (ncomp=8)
-                const amrex::Real j_lab = gamma_boost * ( arr(i, j, k, 8)
-                                        + beta_boost * clight * arr(i, j, k, 9) );
-                const amrex::Real rho_lab = gamma_boost * ( arr(i, j, k, 9)
-                                          + beta_boost * inv_clight * arr(i, j, k, 8) );
-                // Store lab-frame jz and rho in-place
-                arr(i, j, k, 8) = j_lab;
-                arr(i, j, k, 9) = rho_lab;
-            }
-        );
-#endif
-    }
+    m_d_map_varnames.resize(m_map_varnames.size());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice,
+                          m_map_varnames.begin(), m_map_varnames.end(),
+                          m_d_map_varnames.begin());
+    amrex::Gpu::streamSynchronize();
 
 }
@@ -15,7 +15,7 @@
 #include <AMReX_Print.H>
 #include <AMReX_BaseFwd.H>
 
-SelectParticles::SelectParticles (const WarpXParIter& a_pti, TmpParticles& tmp_particle_data,
+SelectParticles::SelectParticles (const WarpXParIter& a_pti, TmpParticles const& tmp_particle_data,
                                   amrex::Real current_z_boost, amrex::Real old_z_boost,
                                   int a_offset)
     : m_current_z_boost(current_z_boost), m_old_z_boost(old_z_boost)
@@ -25,12 +25,15 @@ SelectParticles::SelectParticles (const WarpXParIter& a_pti, TmpParticles& tmp_p
     const auto lev = a_pti.GetLevel();
     const auto index = a_pti.GetPairIndex();
 
-    zpold = tmp_particle_data[lev][index][TmpIdx::zold].dataPtr();
+    auto const& tmp_tiles = tmp_particle_data[lev];
+    if (auto const tile = tmp_tiles.find(index); tile != tmp_tiles.end()) {
+        zpold = tile->second[TmpIdx::zold].dataPtr();
+    }
 }
 
 
 LorentzTransformParticles::LorentzTransformParticles ( const WarpXParIter& a_pti,
-                                TmpParticles& tmp_particle_data,
+                                TmpParticles const& tmp_particle_data,
                                 amrex::Real t_boost, amrex::Real dt,
                                 amrex::Real t_lab, int a_offset)
     : m_t_boost(t_boost), m_dt(dt), m_t_lab(t_lab)
@@ -49,12 +52,16 @@ LorentzTransformParticles::LorentzTransformParticles ( const WarpXParIter& a_pti
     const auto lev = a_pti.GetLevel();
     const auto index = a_pti.GetPairIndex();
 
-    m_xpold = tmp_particle_data[lev][index][TmpIdx::xold].dataPtr();
-    m_ypold = tmp_particle_data[lev][index][TmpIdx::yold].dataPtr();
-    m_zpold = tmp_particle_data[lev][index][TmpIdx::zold].dataPtr();
-    m_uxpold = tmp_particle_data[lev][index][TmpIdx::uxold].dataPtr();
-    m_uypold = tmp_particle_data[lev][index][TmpIdx::uyold].dataPtr();
-    m_uzpold = tmp_particle_data[lev][index][TmpIdx::uzold].dataPtr();
+    auto const& tmp_tiles = tmp_particle_data[lev];
+    if (auto const tile = tmp_tiles.find(index); tile != tmp_tiles.end()) {
+        auto const& tmp_tile = tile->second;
+        m_xpold = tmp_tile[TmpIdx::xold].dataPtr();
+        m_ypold = tmp_tile[TmpIdx::yold].dataPtr();
+        m_zpold = tmp_tile[TmpIdx::zold].dataPtr();
+        m_uxpold = tmp_tile[TmpIdx::uxold].dataPtr();
+        m_uypold = tmp_tile[TmpIdx::uyold].dataPtr();
+        m_uzpold = tmp_tile[TmpIdx::uzold].dataPtr();
+    }
 
     m_betaboost = WarpX::beta_boost;
     m_gammaboost = WarpX::gamma_boost;
@@ -84,7 +91,7 @@ BackTransformParticleFunctor::operator () (PinnedMemoryParticleContainer& pc_dst
     auto &warpx = WarpX::GetInstance();
     // get particle slice
     const int nlevs = std::max(0, m_pc_src->finestLevel()+1);
-    auto tmp_particle_data = m_pc_src->getTmpParticleData();
+    auto const& tmp_particle_data = m_pc_src->getTmpParticleData();
     for (int lev = 0; lev < nlevs; ++lev) {
         const amrex::Real t_boost = warpx.gett_new(0);
         const amrex::Real dt = warpx.getdt(0);
@@ -137,13 +144,16 @@ BackTransformParticleFunctor::operator () (PinnedMemoryParticleContainer& pc_dst
                 auto& ptile_dst = pc_dst.DefineAndReturnParticleTile(lev, pti.index(), pti.LocalTileIndex() );
                 auto old_size = ptile_dst.numParticles();
                 ptile_dst.resize(old_size + total_partdiag_size);
-                amrex::filterParticles(ptile_dst, ptile_src, GetParticleFilter, 0, old_size, np);
                 auto dst_data = ptile_dst.getParticleTileData();
+                // Copy and transform the selected particles in a single kernel, reusing
+                // the flags and the scan above instead of evaluating the filter again
                 amrex::ParallelFor(np,
                 [=] AMREX_GPU_DEVICE(int i)
                 {
-                   if (Flag[i] == 1) { GetParticleLorentzTransform(dst_data, src_data, i,
-                                                                 old_size + IndexLocation[i]);
+                   if (Flag[i] == 1) {
+                       const int i_dst = static_cast<int>(old_size) + IndexLocation[i];
+                       amrex::copyParticle(dst_data, src_data, i, i_dst);
+                       GetParticleLorentzTransform(dst_data, src_data, i, i_dst);
                    }
                 });
                 amrex::Gpu::synchronize();
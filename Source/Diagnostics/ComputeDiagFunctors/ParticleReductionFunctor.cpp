@@ -50,13 +50,17 @@ ParticleReductionFunctor::operator() (amrex::MultiFab& mf_dst, const int dcomp,
     // output Multifab, mf_dst, the guard-cell data is not needed especially considering
     // the operations performend in the CoarsenAndInterpolate function.
     constexpr int ng = 1;
-    // Temporary cell-centered, multi-component MultiFab for storing particles per cell.
-    amrex::MultiFab red_mf(warpx.boxArray(m_lev), warpx.DistributionMap(m_lev), 1, ng);
+    // Temporary cell-centered MultiFab for storing the sum of the reduced quantity per cell.
+    // When averaging, a second component stores the sum of the weights of the particles,
+    // so that both sums are computed in the same pass over the particles.
+    const int ncomp_red = m_do_average ? 2 : 1;
+    amrex::MultiFab red_mf(warpx.boxArray(m_lev), warpx.DistributionMap(m_lev), ncomp_red, ng);
     auto& pc = warpx.GetPartContainer().GetParticleContainer(m_ispec);
     // Copy over member variables so they can be captured in the lambda
     auto map_fn = m_map_fn;
     auto filter_fn = m_filter_fn;
     const bool do_filter = m_do_filter;
+    const bool do_average = m_do_average;
     ParticleToMesh(pc, red_mf, m_lev,
             [=] AMREX_GPU_DEVICE (const WarpXParticleContainer::SuperParticleType& p,
                 amrex::Array4<amrex::Real> const& out_array,
@@ -92,64 +96,28 @@ ParticleReductionFunctor::operator() (amrex::MultiFab& mf_dst, const int dcomp,
                 const amrex::ParticleReal uy = p.rdata(PIdx::uy) / PhysConst::c;
                 const amrex::ParticleReal uz = p.rdata(PIdx::uz) / PhysConst::c;
                 const bool filtered_out_flag = ((do_filter) && (filter_fn(xw, yw, zw, ux, uy, uz) == 0.0_prt));
-                const amrex::Real value = (filtered_out_flag) ? (0._rt):(map_fn(xw, yw, zw, ux, uy, uz));
+                if (filtered_out_flag) { return; }
+                const amrex::Real value = map_fn(xw, yw, zw, ux, uy, uz);
                 amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 0), (amrex::Real)(p.rdata(PIdx::w) * value));
+                // Add the weight for each particle -- total number of particles of this species
+                if (do_average) {
+                    amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 1), (amrex::Real)(p.rdata(PIdx::w)));
+                }
             });
     if (m_do_average) {
-        amrex::MultiFab ppc_mf(warpx.boxArray(m_lev), warpx.DistributionMap(m_lev), 1, ng);
-        // Add the weight for each particle -- total number of particles of this species
-        ParticleToMesh(pc, ppc_mf, m_lev,
-                [=] AMREX_GPU_DEVICE (const WarpXParticleContainer::SuperParticleType& p,
-                    amrex::Array4<amrex::Real> const& out_array,
-                    amrex::GpuArray<amrex::Real,AMREX_SPACEDIM> const& plo,
-                    amrex::GpuArray<amrex::Real,AMREX_SPACEDIM> const& dxi)
-                {
-                    // Get position in WarpX convention to use in parser. Will be different from
-                    // p.pos() for 1D and 2D simulations.
-                    amrex::ParticleReal xw = 0._rt, yw = 0._rt, zw = 0._rt;
-                    get_particle_position(p, xw, yw, zw);
-
-                    // Get position in AMReX convention to calculate corresponding index.
-                    // Ideally this will be replaced with the AMReX NGP interpolator
-                    // Always do x direction. No RZ case because it's not implemented, and code
-                    // will have aborted
-                    int ii = 0, jj = 0, kk = 0;
-                    const amrex::ParticleReal x = p.pos(0);
-                    const amrex::Real lx = (x - plo[0]) * dxi[0];
-                    ii = static_cast<int>(amrex::Math::floor(lx));
-#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_3D)
-                    const amrex::ParticleReal y = p.pos(1);
-                    const amrex::Real ly = (y - plo[1]) * dxi[1];
-                    jj = static_cast<int>(amrex::Math::floor(ly));
-#endif
-#if defined(WARPX_DIM_3D)
-                    const amrex::ParticleReal z = p.pos(2);
-                    const amrex::Real lz = (z - plo[2]) * dxi[2];
-                    kk = static_cast<int>(amrex::Math::floor(lz));
-#endif
-                    // Fix dimensions since parser assumes u = gamma * v / c
-                    const amrex::ParticleReal ux = p.rdata(PIdx::ux) / PhysConst::c;
-                    const amrex::ParticleReal uy = p.rdata(PIdx::uy) / PhysConst::c;
-                    const amrex::ParticleReal uz = p.rdata(PIdx::uz) / PhysConst::c;
-                    amrex::Real filter;
-                    if ((do_filter) && (filter_fn(xw, yw, zw, ux, uy, uz) == 0._rt)) { filter = 0._rt;
-                    } else { filter = 1._rt; }
-                    amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 0), (amrex::Real)(p.rdata(PIdx::w) * filter));
-                });
         // Divide value by number of particles for average. Set average to zero if there are no particles
         for (amrex::MFIter mfi(red_mf, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
             const amrex::Box& box = mfi.tilebox();
             amrex::Array4<amrex::Real> const& a_red = red_mf.array(mfi);
-            amrex::Array4<amrex::Real const> const& a_ppc = ppc_mf.const_array(mfi);
             amrex::ParallelFor(box,
                     [=] AMREX_GPU_DEVICE (int i, int j, int k) {
-                        if (a_ppc(i,j,k,0) == 0) { a_red(i,j,k,0) = 0;
-                        } else { a_red(i,j,k,0) = a_red(i,j,k,0) / a_ppc(i,j,k,0); }
+                        if (a_red(i,j,k,1) == 0) { a_red(i,j,k,0) = 0;
+                        } else { a_red(i,j,k,0) = a_red(i,j,k,0) / a_red(i,j,k,1); }
                     });
         }
     }
 
-    // Coarsen and interpolate from ppc_mf to the output diagnostic MultiFab, mf_dst.
+    // Coarsen and interpolate from red_mf to the output diagnostic MultiFab, mf_dst.
     ablastr::coarsen::sample::Coarsen(mf_dst, red_mf, dcomp, 0, nComp(), 0, m_crse_ratio);
 }
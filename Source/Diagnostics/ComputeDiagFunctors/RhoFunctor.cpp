@@ -17,6 +17,22 @@
 #include <AMReX_MultiFab.H>
 
 #include <memory>
+#include <vector>
+
+namespace
+{
+    /** Charge density deposited by a RhoFunctor, see RhoFunctor::SetCacheEnabled */
+    struct CachedRho
+    {
+        int lev;
+        int species_index;
+        bool apply_rz_psatd_filter;
+        std::shared_ptr<amrex::MultiFab> rho;
+    };
+
+    bool rho_cache_enabled = false;
+    std::vector<CachedRho> rho_cache;
+}
 
 RhoFunctor::RhoFunctor (const int lev,
                         const amrex::IntVect crse_ratio,
@@ -31,10 +47,30 @@ RhoFunctor::RhoFunctor (const int lev,
       m_convertRZmodes2cartesian(convertRZmodes2cartesian)
 {}
 
+void
+RhoFunctor::SetCacheEnabled (bool enable)
+{
+    rho_cache_enabled = enable;
+    if (!enable) { rho_cache.clear(); }
+}
+
 void
 RhoFunctor::operator() ( amrex::MultiFab& mf_dst, const int dcomp, const int /*i_buffer*/ ) const
 {
     auto& warpx = WarpX::GetInstance();
+
+    // Reuse the charge density of another RhoFunctor with the same parameters, if available
+    if (rho_cache_enabled) {
+        for (auto const& cached : rho_cache) {
+            if (cached.lev == m_lev && cached.species_index == m_species_index &&
+                cached.apply_rz_psatd_filter == m_apply_rz_psatd_filter) {
+                InterpolateMFForDiag(mf_dst, *cached.rho, dcomp, warpx.DistributionMap(m_lev),
+                                     m_convertRZmodes2cartesian);
+                return;
+            }
+        }
+    }
+
     std::unique_ptr<amrex::MultiFab> rho;
 
     // Deposit charge density
@@ -78,4 +114,8 @@ RhoFunctor::operator() ( amrex::MultiFab& mf_dst, const int dcomp, const int /*i
 
     InterpolateMFForDiag(mf_dst, *rho, dcomp, warpx.DistributionMap(m_lev),
                          m_convertRZmodes2cartesian);
+
+    if (rho_cache_enabled) {
+        rho_cache.push_back({m_lev, m_species_index, m_apply_rz_psatd_filter, std::move(rho)});
+    }
 }
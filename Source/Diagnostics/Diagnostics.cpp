@@ -14,9 +14,11 @@
 #include "Particles/MultiParticleContainer.H"
 #include "Utils/Algorithms/IsIn.H"
 #include "Utils/Parser/ParserUtils.H"
+#include "Utils/ParticleUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
+#include "Utils/WarpXUtil.H"
 #include "WarpX.H"
 
 #include <ablastr/utils/Communication.H>
@@ -499,7 +501,7 @@ Diagnostics::InitBaseData ()
     }
     // Construct Flush class.
     if        (m_format == "plotfile"){
-        m_flush_format = std::make_unique<FlushFormatPlotfile>() ;
+        m_flush_format = std::make_unique<FlushFormatPlotfile>(m_diag_name);
     } else if (m_format == "checkpoint"){
         // creating checkpoint format
         m_flush_format = std::make_unique<FlushFormatCheckpoint>() ;
@@ -542,6 +544,23 @@ Diagnostics::InitBaseData ()
     m_output_species.resize(m_num_buffers);
 }
 
+amrex::Long
+Diagnostics::MemoryUsage () const
+{
+    amrex::Long bytes = 0;
+    for (auto const& buffer : m_mf_output) {
+        for (auto const& mf : buffer) {
+            bytes += WarpXUtilMemory::MemoryUsage(mf);
+        }
+    }
+    for (auto const& buffer : m_particles_buffer) {
+        for (auto const& pc : buffer) {
+            if (pc && pc->isDefined()) { bytes += ParticleUtils::MemoryUsage(*pc); }
+        }
+    }
+    return bytes;
+}
+
 void
 Diagnostics::ComputeAndPack ()
 {
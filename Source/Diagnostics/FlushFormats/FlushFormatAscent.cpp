@@ -51,18 +51,23 @@ FlushFormatAscent::WriteToFile (
     // WriteBlueprintFiles(bp_mesh,"bp_export",step,"hdf5");
 
     WARPX_PROFILE_VAR("FlushFormatAscent::WriteToFile::publish", prof_ascent_publish);
-    ascent::Ascent ascent;
-    conduit::Node opts;
-    opts["exceptions"] = "catch";
-    opts["mpi_comm"] = MPI_Comm_c2f(ParallelDescriptor::Communicator());
-    ascent.open(opts);
-    ascent.publish(bp_mesh);
+    if (!m_ascent) {
+        m_ascent = std::shared_ptr<ascent::Ascent>(
+            new ascent::Ascent,
+            [](ascent::Ascent* a) { a->close(); delete a; });
+        conduit::Node opts;
+        opts["exceptions"] = "catch";
+        opts["mpi_comm"] = MPI_Comm_c2f(ParallelDescriptor::Communicator());
+        m_ascent->open(opts);
+    }
+    // The blueprint only refers to the data of the output MultiFabs and of the
+    // particle containers (Conduit external arrays), which is not copied here.
+    m_ascent->publish(bp_mesh);
     WARPX_PROFILE_VAR_STOP(prof_ascent_publish);
 
     WARPX_PROFILE_VAR("FlushFormatAscent::WriteToFile::execute", prof_ascent_execute);
     conduit::Node actions;
-    ascent.execute(actions);
-    ascent.close();
+    m_ascent->execute(actions);
     WARPX_PROFILE_VAR_STOP(prof_ascent_execute);
 
 #else
@@ -11,6 +11,7 @@
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
+#include <AMReX_AsyncOut.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_ParticleIO.H>
 #include <AMReX_PlotFileUtil.H>
@@ -19,6 +20,9 @@
 #include <AMReX_Utility.H>
 #include <AMReX_VisMF.H>
 
+#include <iomanip>
+#include <limits>
+
 using namespace amrex;
 using namespace warpx::fields;
 
@@ -52,8 +56,11 @@ FlushFormatCheckpoint::WriteToFile (
 
     const std::string& checkpointname = amrex::Concatenate(prefix, iteration[0], file_min_digits);
 
+    // With amrex.async_out = 1, the fields and particles are copied to host memory,
+    // and written by a background thread while the simulation proceeds
     amrex::Print() << Utils::TextMsg::Info(
-        "Writing checkpoint " + checkpointname);
+        "Writing checkpoint " + checkpointname +
+        (amrex::AsyncOut::UseAsyncOut() ? " (asynchronously)" : ""));
 
     // const int nlevels = finestLevel()+1;
     amrex::PreBuildDirectorHierarchy(checkpointname, default_level_prefix, nlev, true);
@@ -64,85 +71,85 @@ FlushFormatCheckpoint::WriteToFile (
 
     for (int lev = 0; lev < nlev; ++lev)
     {
-        VisMF::Write(warpx.getField(FieldType::Efield_fp, lev, 0),
+        VisMF::AsyncWrite(warpx.getField(FieldType::Efield_fp, lev, 0),
                      amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_fp"));
-        VisMF::Write(warpx.getField(FieldType::Efield_fp, lev, 1),
+        VisMF::AsyncWrite(warpx.getField(FieldType::Efield_fp, lev, 1),
                      amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_fp"));
-        VisMF::Write(warpx.getField(FieldType::Efield_fp, lev, 2),
+        VisMF::AsyncWrite(warpx.getField(FieldType::Efield_fp, lev, 2),
                      amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_fp"));
-        VisMF::Write(warpx.getField(FieldType::Bfield_fp, lev, 0),
+        VisMF::AsyncWrite(warpx.getField(FieldType::Bfield_fp, lev, 0),
                      amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_fp"));
-        VisMF::Write(warpx.getField(FieldType::Bfield_fp, lev, 1),
+        VisMF::AsyncWrite(warpx.getField(FieldType::Bfield_fp, lev, 1),
                      amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_fp"));
-        VisMF::Write(warpx.getField(FieldType::Bfield_fp, lev, 2),
+        VisMF::AsyncWrite(warpx.getField(FieldType::Bfield_fp, lev, 2),
                      amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_fp"));
 
         if (WarpX::fft_do_time_averaging)
         {
-            VisMF::Write(warpx.getField(FieldType::Efield_avg_fp, lev, 0),
+            VisMF::AsyncWrite(warpx.getField(FieldType::Efield_avg_fp, lev, 0),
                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_avg_fp"));
-            VisMF::Write(warpx.getField(FieldType::Efield_avg_fp, lev, 1),
+            VisMF::AsyncWrite(warpx.getField(FieldType::Efield_avg_fp, lev, 1),
                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_avg_fp"));
-            VisMF::Write(warpx.getField(FieldType::Efield_avg_fp, lev, 2),
+            VisMF::AsyncWrite(warpx.getField(FieldType::Efield_avg_fp, lev, 2),
                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_avg_fp"));
 
-            VisMF::Write(warpx.getField(FieldType::Bfield_avg_fp, lev, 0),
+            VisMF::AsyncWrite(warpx.getField(FieldType::Bfield_avg_fp, lev, 0),
                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_avg_fp"));
-            VisMF::Write(warpx.getField(FieldType::Bfield_avg_fp, lev, 1),
+            VisMF::AsyncWrite(warpx.getField(FieldType::Bfield_avg_fp, lev, 1),
                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_avg_fp"));
-            VisMF::Write(warpx.getField(FieldType::Bfield_avg_fp, lev, 2),
+            VisMF::AsyncWrite(warpx.getField(FieldType::Bfield_avg_fp, lev, 2),
                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_avg_fp"));
         }
 
         if (warpx.getis_synchronized()) {
             // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-            VisMF::Write(warpx.getField(FieldType::current_fp, lev, 0),
+            VisMF::AsyncWrite(warpx.getField(FieldType::current_fp, lev, 0),
                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_fp"));
-            VisMF::Write(warpx.getField(FieldType::current_fp, lev, 1),
+            VisMF::AsyncWrite(warpx.getField(FieldType::current_fp, lev, 1),
                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_fp"));
-            VisMF::Write(warpx.getField(FieldType::current_fp, lev, 2),
+            VisMF::AsyncWrite(warpx.getField(FieldType::current_fp, lev, 2),
                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_fp"));
         }
 
         if (lev > 0)
         {
-            VisMF::Write(warpx.getField(FieldType::Efield_cp, lev, 0),
+            VisMF::AsyncWrite(warpx.getField(FieldType::Efield_cp, lev, 0),
                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_cp"));
-            VisMF::Write(warpx.getField(FieldType::Efield_cp, lev, 1),
+            VisMF::AsyncWrite(warpx.getField(FieldType::Efield_cp, lev, 1),
                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_cp"));
-            VisMF::Write(warpx.getField(FieldType::Efield_cp, lev, 2),
+            VisMF::AsyncWrite(warpx.getField(FieldType::Efield_cp, lev, 2),
                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_cp"));
-            VisMF::Write(warpx.getField(FieldType::Bfield_cp, lev, 0),
+            VisMF::AsyncWrite(warpx.getField(FieldType::Bfield_cp, lev, 0),
                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_cp"));
-            VisMF::Write(warpx.getField(FieldType::Bfield_cp, lev, 1),
+            VisMF::AsyncWrite(warpx.getField(FieldType::Bfield_cp, lev, 1),
                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_cp"));
-            VisMF::Write(warpx.getField(FieldType::Bfield_cp, lev, 2),
+            VisMF::AsyncWrite(warpx.getField(FieldType::Bfield_cp, lev, 2),
                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_cp"));
 
             if (WarpX::fft_do_time_averaging)
             {
-                VisMF::Write(warpx.getField(FieldType::Efield_avg_cp, lev, 0),
+                VisMF::AsyncWrite(warpx.getField(FieldType::Efield_avg_cp, lev, 0),
                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_avg_cp"));
-                VisMF::Write(warpx.getField(FieldType::Efield_avg_cp, lev, 1),
+                VisMF::AsyncWrite(warpx.getField(FieldType::Efield_avg_cp, lev, 1),
                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_avg_cp"));
-                VisMF::Write(warpx.getField(FieldType::Efield_avg_cp, lev, 2),
+                VisMF::AsyncWrite(warpx.getField(FieldType::Efield_avg_cp, lev, 2),
                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_avg_cp"));
 
-                VisMF::Write(warpx.getField(FieldType::Bfield_avg_cp, lev, 0),
+                VisMF::AsyncWrite(warpx.getField(FieldType::Bfield_avg_cp, lev, 0),
                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_avg_cp"));
-                VisMF::Write(warpx.getField(FieldType::Bfield_avg_cp, lev, 1),
+                VisMF::AsyncWrite(warpx.getField(FieldType::Bfield_avg_cp, lev, 1),
                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_avg_cp"));
-                VisMF::Write(warpx.getField(FieldType::Bfield_avg_cp, lev, 2),
+                VisMF::AsyncWrite(warpx.getField(FieldType::Bfield_avg_cp, lev, 2),
                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_avg_cp"));
             }
 
             if (warpx.getis_synchronized()) {
                 // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-                VisMF::Write(warpx.getField(FieldType::current_cp, lev, 0),
+                VisMF::AsyncWrite(warpx.getField(FieldType::current_cp, lev, 0),
                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_cp"));
-                VisMF::Write(warpx.getField(FieldType::current_cp, lev, 1),
+                VisMF::AsyncWrite(warpx.getField(FieldType::current_cp, lev, 1),
                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_cp"));
-                VisMF::Write(warpx.getField(FieldType::current_cp, lev, 2),
+                VisMF::AsyncWrite(warpx.getField(FieldType::current_cp, lev, 2),
                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_cp"));
             }
         }
@@ -211,13 +218,25 @@ FlushFormatCheckpoint::CheckpointParticles (
 void
 FlushFormatCheckpoint::WriteDMaps (const std::string& dir, int nlev) const
 {
-    if (ParallelDescriptor::IOProcessor()) {
-        auto & warpx = WarpX::GetInstance();
-        for (int lev = 0; lev < nlev; ++lev) {
-            std::string DMFileName = dir;
-            if (!DMFileName.empty() && DMFileName[DMFileName.size()-1] != '/') {DMFileName += '/';}
-            DMFileName = amrex::Concatenate(DMFileName.append("Level_"), lev, 1);
-            DMFileName += "/DM";
+    auto & warpx = WarpX::GetInstance();
+    for (int lev = 0; lev < nlev; ++lev) {
+        std::string LevelDirName = dir;
+        if (!LevelDirName.empty() && LevelDirName[LevelDirName.size()-1] != '/') {LevelDirName += '/';}
+        LevelDirName = amrex::Concatenate(LevelDirName.append("Level_"), lev, 1);
+
+        // Costs of the boxes (when load balancing is used), so that the boxes can be
+        // distributed according to their costs on restart with a different number of ranks
+        amrex::Vector<amrex::Real> box_costs;
+        const amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+        if (cost) {
+            box_costs.resize(cost->size(), 0.0_rt);
+            for (const int i : cost->IndexArray()) { box_costs[i] = (*cost)[i]; }
+            ParallelDescriptor::ReduceRealSum(box_costs.data(), static_cast<int>(box_costs.size()),
+                                              ParallelDescriptor::IOProcessorNumber());
+        }
+
+        if (ParallelDescriptor::IOProcessor()) {
+            const std::string DMFileName = LevelDirName + "/DM";
 
             std::ofstream DMFile;
             DMFile.open(DMFileName.c_str(), std::ios::out|std::ios::trunc);
@@ -233,6 +252,26 @@ FlushFormatCheckpoint::WriteDMaps (const std::string& dir, int nlev) const
                 DMFile.good(),
                 "FlushFormatCheckpoint::WriteDMaps: problem writing DMFile"
             );
+
+            if (!box_costs.empty()) {
+                const std::string CostsFileName = LevelDirName + "/Costs";
+
+                std::ofstream CostsFile;
+                CostsFile.open(CostsFileName.c_str(), std::ios::out|std::ios::trunc);
+
+                if (!CostsFile.good()) { amrex::FileOpenFailed(CostsFileName); }
+
+                CostsFile << std::setprecision(std::numeric_limits<amrex::Real>::max_digits10);
+                CostsFile << box_costs.size() << "\n";
+                for (const amrex::Real box_cost : box_costs) { CostsFile << box_cost << "\n"; }
+
+                CostsFile.flush();
+                CostsFile.close();
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                    CostsFile.good(),
+                    "FlushFormatCheckpoint::WriteDMaps: problem writing CostsFile"
+                );
+            }
         }
     }
 }
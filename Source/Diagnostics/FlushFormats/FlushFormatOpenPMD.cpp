@@ -16,6 +16,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 
 using namespace amrex;
 
@@ -88,6 +89,32 @@ FlushFormatOpenPMD::FlushFormatOpenPMD (const std::string& diag_name)
         operator_parameters.insert({k, v});
     }
 
+    // ADIOS2 operators of individual mesh records, overriding the operator above:
+    // <diag_name>.adios2_operator.<record>.type and <diag_name>.adios2_operator.<record>.parameters.*
+    std::map< std::string, std::pair< std::string, std::map< std::string, std::string > > > mesh_operators;
+    std::string const op_prefix = diag_name + ".adios2_operator.";
+    for (auto const& k : amrex::ParmParse::getEntries(diag_name + ".adios2_operator")) {
+        if (k.rfind(op_prefix, 0) != 0) { continue; }
+        std::string const key = k.substr(op_prefix.size());
+        auto const dot = key.find('.');
+        if (dot == std::string::npos) { continue; }
+        std::string const record_name = key.substr(0, dot);
+        std::string const record_key = key.substr(dot+1);
+        if (record_name == "parameters") { continue; } // operator of the Series
+        std::string v;
+        pp.get(k.c_str(), v);
+        if (record_key == "type") {
+            mesh_operators[record_name].first = v;
+        } else if (record_key.rfind("parameters.", 0) == 0) {
+            mesh_operators[record_name].second.insert({record_key.substr(11), v});
+        }
+    }
+    for (auto const& [record_name, mesh_operator] : mesh_operators) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!mesh_operator.first.empty(),
+            diag_name + ".adios2_operator." + record_name + ".type must be specified "
+            "with the parameters of the operator of this record");
+    }
+
     // ADIOS2 engine type & parameters
     std::string engine_type;
     pp_diag_name.query("adios2_engine.type", engine_type);
@@ -104,13 +131,33 @@ FlushFormatOpenPMD::FlushFormatOpenPMD (const std::string& diag_name)
         engine_parameters.insert({k, v});
     }
 
+    // Asynchronous writes by the ADIOS2 BP5 engine, in a background thread
+    bool async_write = false;
+    pp_diag_name.query("adios2_async_write", async_write);
+    if (async_write && openpmd_backend != "bp" && openpmd_backend != "bp5") {
+        ablastr::warn_manager::WMRecordWarning("Diagnostics",
+            diag_name + ".adios2_async_write is only supported with the ADIOS2 backend "
+            "(openpmd_backend = bp or bp5), and is ignored.");
+        async_write = false;
+    }
+    if (async_write) {
+        // do not override a value set by the user
+        engine_parameters.emplace("AsyncWrite", "On");
+    }
+
+    bool fields_single_precision = false;
+    pp_diag_name.query("fields_single_precision", fields_single_precision);
+
     auto & warpx = WarpX::GetInstance();
     m_OpenPMDPlotWriter = std::make_unique<WarpXOpenPMDPlot>(
         encoding, openpmd_backend,
         operator_type, operator_parameters,
         engine_type, engine_parameters,
         warpx.getPMLdirections(),
-        warpx.GetAuthors()
+        warpx.GetAuthors(),
+        async_write,
+        fields_single_precision,
+        mesh_operators
     );
 }
 
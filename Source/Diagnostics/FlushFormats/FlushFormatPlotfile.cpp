@@ -14,9 +14,11 @@
 #include "WarpX.H"
 
 #include <AMReX.H>
+#include <AMReX_AsyncOut.H>
 #include <AMReX_Box.H>
 #include <AMReX_BoxArray.H>
 #include <AMReX_Config.H>
+#include <AMReX_FArrayBox.H>
 #include <AMReX_GpuAllocators.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_IntVect.H>
@@ -55,6 +57,12 @@ namespace
     const std::string default_level_prefix {"Level_"};
 }
 
+FlushFormatPlotfile::FlushFormatPlotfile (const std::string& diag_name)
+{
+    const ParmParse pp_diag_name(diag_name);
+    pp_diag_name.query("fields_single_precision", m_fields_single_precision);
+}
+
 void
 FlushFormatPlotfile::WriteToFile (
     const amrex::Vector<std::string>& varnames,
@@ -89,6 +97,9 @@ FlushFormatPlotfile::WriteToFile (
     const VisMF::Header::Version current_version = VisMF::GetHeaderVersion();
     VisMF::SetHeaderVersion(amrex::VisMF::Header::Version_v1);
     if (plot_raw_fields) { rfs.emplace_back("raw_fields"); }
+    // The fields are converted to single precision when they are written
+    const FABio::Format current_format = FArrayBox::getFormat();
+    if (m_fields_single_precision) { FArrayBox::setFormat(FABio::FAB_NATIVE_32); }
     amrex::WriteMultiLevelPlotfile(filename, nlev,
                                    amrex::GetVecOfConstPtrs(mf),
                                    varnames, geom,
@@ -100,6 +111,7 @@ FlushFormatPlotfile::WriteToFile (
                                    );
 
     WriteAllRawFields(plot_raw_fields, nlev, filename, plot_raw_fields_guards);
+    FArrayBox::setFormat(current_format);
 
     WriteParticles(filename, particle_diags, static_cast<amrex::Real>(time), isBTD);
 
@@ -407,15 +419,23 @@ FlushFormatPlotfile::WriteParticles(const std::string& dir,
         if (!isBTD) {
             particlesConvertUnits(ConvertDirection::WarpX_to_SI, pc, mass);
             using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
-            tmp.copyParticles(*pc,
-                              [random_filter,uniform_filter,parser_filter,geometry_filter]
-                              AMREX_GPU_HOST_DEVICE
-                              (const SrcData& src, int ip, const amrex::RandomEngine& engine)
+            auto const filter = [random_filter,uniform_filter,parser_filter,geometry_filter]
+                                AMREX_GPU_HOST_DEVICE
+                                (const SrcData& src, int ip, const amrex::RandomEngine& engine)
             {
                 const SuperParticleType& p = src.getSuperParticle(ip);
                 return random_filter(p, engine) * uniform_filter(p, engine)
                     * parser_filter(p, engine) * geometry_filter(p, engine);
-            }, true);
+            };
+            if (part_diag.doFilter()) {
+                // Select the particles in device memory first, so that the pinned memory
+                // and the copy to the host scale with the number of selected particles
+                auto selected = pc->make_alike();
+                selected.copyParticles(*pc, filter, true);
+                tmp.copyParticles(selected, true);
+            } else {
+                tmp.copyParticles(*pc, filter, true);
+            }
             particlesConvertUnits(ConvertDirection::SI_to_WarpX, pc, mass);
         } else {
             tmp.copyParticles(*pinned_pc, true);
@@ -445,12 +465,20 @@ WriteRawMF ( const MultiFab& F, const DistributionMapping& dm,
                             filename, level_prefix, field_name);
     if (plot_guards) {
         // Dump original MultiFab F
-        VisMF::Write(F, prefix);
+        if (AsyncOut::UseAsyncOut()) {
+            VisMF::AsyncWrite(F, prefix);
+        } else {
+            VisMF::Write(F, prefix);
+        }
     } else {
         // Copy original MultiFab into one that does not have guard cells
         MultiFab tmpF( F.boxArray(), dm, F.nComp(), 0);
         MultiFab::Copy(tmpF, F, 0, 0, F.nComp(), 0);
-        VisMF::Write(tmpF, prefix);
+        if (AsyncOut::UseAsyncOut()) {
+            VisMF::AsyncWrite(std::move(tmpF), prefix);
+        } else {
+            VisMF::Write(tmpF, prefix);
+        }
     }
 }
 
@@ -472,7 +500,11 @@ WriteZeroRawMF( const MultiFab& F, const DistributionMapping& dm,
 
     MultiFab tmpF(F.boxArray(), dm, F.nComp(), ng);
     tmpF.setVal(0.);
-    VisMF::Write(tmpF, prefix);
+    if (AsyncOut::UseAsyncOut()) {
+        VisMF::AsyncWrite(std::move(tmpF), prefix);
+    } else {
+        VisMF::Write(tmpF, prefix);
+    }
 }
 
 /** \brief Write the coarse vector multifab `F*_cp` to the file `filename`
@@ -3,6 +3,7 @@
 #include "Diagnostics/BTDiagnostics.H"
 #include "Diagnostics/FullDiagnostics.H"
 #include "Diagnostics/BoundaryScrapingDiagnostics.H"
+#include "Diagnostics/ComputeDiagFunctors/RhoFunctor.H"
 #include "Utils/TextMsg.H"
 #include <ablastr/warn_manager/WarnManager.H>
 #include <AMReX_ParmParse.H>
@@ -79,6 +80,8 @@ MultiDiagnostics::ReadParameters ()
 void
 MultiDiagnostics::FilterComputePackFlush (int step, bool force_flush, bool BackTransform)
 {
+    // The diagnostics of this step share the charge densities that they deposit
+    RhoFunctor::SetCacheEnabled(true);
     int i = 0;
     for (auto& diag : alldiags){
         if (BackTransform) {
@@ -92,17 +95,32 @@ MultiDiagnostics::FilterComputePackFlush (int step, bool force_flush, bool BackT
         }
         ++i;
     }
+    RhoFunctor::SetCacheEnabled(false);
 }
 
 void
 MultiDiagnostics::FilterComputePackFlushLastTimestep (int step)
 {
+    RhoFunctor::SetCacheEnabled(true);
     for (auto& diag : alldiags){
         if (diag->DoDumpLastTimestep()){
             constexpr bool force_flush = true;
             diag->FilterComputePackFlush (step, force_flush);
         }
     }
+    RhoFunctor::SetCacheEnabled(false);
+}
+
+bool
+MultiDiagnostics::DoComputeAndPack (int step) const
+{
+    for (int i = 0; i < ndiags; ++i) {
+        if (diags_types[i] == DiagTypes::BackTransformed ||
+            alldiags[i]->DoComputeAndPack(step)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void
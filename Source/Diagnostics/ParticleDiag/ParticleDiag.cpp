@@ -78,6 +78,8 @@ ParticleDiag::ParticleDiag (
     m_plot_flags[pc->getParticleComps().at("theta")] = 1;
 #endif
 
+    pp_diag_name_species_name.query("sort_by_cell", m_sort_by_cell);
+
     // build filter functors
     m_do_random_filter = utils::parser::queryWithParser(
         pp_diag_name_species_name, "random_fraction", m_random_fraction);
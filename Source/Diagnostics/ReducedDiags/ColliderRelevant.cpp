@@ -46,7 +46,7 @@
 #include <AMReX_Tuple.H>
 #include <AMReX_Vector.H>
 
-#include <ablastr/coarsen/sample.H>
+#include <ablastr/utils/Communication.H>
 #include <ablastr/warn_manager/WarnManager.H>
 
 #include <algorithm>
@@ -188,6 +188,114 @@ ColliderRelevant::ColliderRelevant (const std::string& rd_name)
     }
 }
 
+#if !defined(WARPX_DIM_RZ)
+namespace
+{
+    /** Number of sums and maxima of the quantities of a species, computed in one pass
+     *  over its particles (see BeamMoments) */
+    constexpr int n_sums = 10;
+    constexpr int n_maxs = 6;
+
+    using MomentsTuple = amrex::GpuTuple<amrex::Real, amrex::Real, amrex::Real, amrex::Real,
+                                         amrex::Real, amrex::Real, amrex::Real, amrex::Real,
+                                         amrex::Real, amrex::Real,
+                                         amrex::Real, amrex::Real, amrex::Real, amrex::Real,
+                                         amrex::Real, amrex::Real>;
+
+    /** Reference values of x, y, thetax and thetay about which the moments of a species
+     *  are accumulated (see BeamMoments) */
+    using MomentsRef = amrex::GpuArray<amrex::Real, 4>;
+
+    /**
+     * \brief Contribution of a particle to the sums
+     * w, w*dx, w*dx^2, w*dy, w*dy^2, w*dthetax, w*dthetax^2, w*dthetay, w*dthetay^2, w*chi
+     * and to the maxima
+     * thetax, thetay, -thetax, -thetay, chi, -chi
+     * from which all the moments of a species are obtained (the minima are the opposite of the
+     * maxima of the opposite values, so that all the extrema are reduced together).
+     * dx = x - x0, etc., are the offsets from the reference values ref = {x0, y0, thetax0, thetay0}:
+     * when ref is close to the averages, the variances obtained from the one-pass sums do not
+     * suffer from the cancellation between the mean of the squares and the square of the mean.
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    MomentsTuple BeamMoments (amrex::Real w, amrex::Real x, amrex::Real y,
+                              amrex::Real ux, amrex::Real uy, amrex::Real uz,
+                              amrex::Real chi, MomentsRef const& ref) noexcept
+    {
+        const amrex::Real thetax = std::atan2(ux, uz);
+        const amrex::Real thetay = std::atan2(uy, uz);
+        const amrex::Real dx = x - ref[0];
+        const amrex::Real dy = y - ref[1];
+        const amrex::Real dthetax = thetax - ref[2];
+        const amrex::Real dthetay = thetay - ref[3];
+        return {w, w*dx, w*dx*dx, w*dy, w*dy*dy,
+                w*dthetax, w*dthetax*dthetax, w*dthetay, w*dthetay*dthetay, w*chi,
+                thetax, thetay, -thetax, -thetay, chi, -chi};
+    }
+
+    /**
+     * \brief Weighted averages of x, y, thetax and thetay of a species, over the particles
+     * of all levels and all ranks. They are used as the first reference values of BeamMoments.
+     */
+    MomentsRef BeamAverages (WarpXParticleContainer& myspc)
+    {
+        using amrex::ReduceOpSum;
+        amrex::ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_op;
+        amrex::ReduceData<amrex::Real, amrex::Real, amrex::Real, amrex::Real, amrex::Real>
+            reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+
+        for (int lev = 0; lev <= myspc.finestLevel(); ++lev)
+        {
+            for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+            {
+                const auto GetPosition = GetParticlePosition<PIdx>(pti);
+                amrex::ParticleReal* const AMREX_RESTRICT ux = pti.GetAttribs()[PIdx::ux].dataPtr();
+                amrex::ParticleReal* const AMREX_RESTRICT uy = pti.GetAttribs()[PIdx::uy].dataPtr();
+                amrex::ParticleReal* const AMREX_RESTRICT uz = pti.GetAttribs()[PIdx::uz].dataPtr();
+                amrex::ParticleReal* const AMREX_RESTRICT w = pti.GetAttribs()[PIdx::w].dataPtr();
+                reduce_op.eval(pti.numParticles(), reduce_data,
+                [=] AMREX_GPU_DEVICE (int i) -> ReduceTuple
+                {
+                    amrex::ParticleReal xp, yp, zp;
+                    GetPosition(i, xp, yp, zp);
+                    return {w[i], w[i]*xp, w[i]*yp,
+                            w[i]*std::atan2(ux[i], uz[i]), w[i]*std::atan2(uy[i], uz[i])};
+                });
+            }
+        }
+
+        auto r = reduce_data.value();
+        std::array<amrex::Real, 5> sums = {amrex::get<0>(r), amrex::get<1>(r), amrex::get<2>(r),
+                                           amrex::get<3>(r), amrex::get<4>(r)};
+        amrex::ParallelDescriptor::ReduceRealSum(sums.data(), static_cast<int>(sums.size()));
+        const amrex::Real inv_w = (sums[0] > 0.0_rt) ? 1.0_rt/sums[0] : 0.0_rt;
+        return {sums[1]*inv_w, sums[2]*inv_w, sums[3]*inv_w, sums[4]*inv_w};
+    }
+
+    /** Copy the sums and the maxima of a MomentsTuple to the arrays sums and maxs */
+    void UnpackMoments (MomentsTuple const& t, amrex::Real* sums, amrex::Real* maxs)
+    {
+        sums[0] = amrex::get<0>(t);
+        sums[1] = amrex::get<1>(t);
+        sums[2] = amrex::get<2>(t);
+        sums[3] = amrex::get<3>(t);
+        sums[4] = amrex::get<4>(t);
+        sums[5] = amrex::get<5>(t);
+        sums[6] = amrex::get<6>(t);
+        sums[7] = amrex::get<7>(t);
+        sums[8] = amrex::get<8>(t);
+        sums[9] = amrex::get<9>(t);
+        maxs[0] = amrex::get<10>(t);
+        maxs[1] = amrex::get<11>(t);
+        maxs[2] = amrex::get<12>(t);
+        maxs[3] = amrex::get<13>(t);
+        maxs[4] = amrex::get<14>(t);
+        maxs[5] = amrex::get<15>(t);
+    }
+}
+#endif
+
 void ColliderRelevant::ComputeDiags (int step)
 {
 #if defined(WARPX_DIM_RZ)
@@ -211,251 +319,106 @@ void ColliderRelevant::ComputeDiags (int step)
         return m_headers_indices.at(name).idx;
     };
 
-    std::array<std::unique_ptr<amrex::MultiFab>, 2> num_dens;
+    // Charge densities of the two species, as the two components of the same nodal MultiFab,
+    // which is kept between the calls as long as the grids do not change
+    const amrex::BoxArray nba = amrex::convert(warpx.boxArray(0), amrex::IntVect::TheNodeVector());
+    const amrex::DistributionMapping& dmap = warpx.DistributionMap(0);
+    if (!m_rho || m_rho->boxArray() != nba || m_rho->DistributionMap() != dmap) {
+        m_rho = std::make_unique<amrex::MultiFab>(nba, dmap, 2, warpx.get_ng_depos_rho().max());
+    }
+    m_rho->setVal(0._rt);
 
-    // loop over species
+    std::array<amrex::ParticleReal, 2> q;
     for (int i_s = 0; i_s < 2; ++i_s)
     {
-        // get WarpXParticleContainer class object
         WarpXParticleContainer& myspc = mypc.GetParticleContainerFromName(m_beam_name[i_s]);
-        // get charge
-        amrex::ParticleReal const q = myspc.getCharge();
-
-        using PType = typename WarpXParticleContainer::SuperParticleType;
-
-        num_dens[i_s] = myspc.GetChargeDensity(0);
-        num_dens[i_s]->mult(1._prt/q);
-
-#if defined(WARPX_DIM_1D_Z)
-        // w_tot
-        amrex::Real w_tot = ReduceSum( myspc,
-            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+        q[i_s] = myspc.getCharge();
+        myspc.DepositCharge(m_rho, 0, true, false, false, i_s);
+    }
+    // Exchange the guard cells of both densities at once
+    ablastr::utils::communication::SumBoundary(
+        *m_rho, 0, m_rho->nComp(), m_rho->nGrowVect(), m_rho->nGrowVect(),
+        WarpX::do_single_precision_comms, geom.periodicity());
+    warpx.ApplyRhofieldBoundary(0, m_rho.get(), PatchType::fine);
+
+    // Local part of the overlap integral of the densities, averaged from the nodes to the cell
+    // centers on the fly (like ablastr::coarsen::sample::Coarsen without coarsening)
+    amrex::Real n1_dot_n2 = 0._rt;
+    {
+        constexpr int sy = AMREX_D_PICK(0, 1, 1);
+        constexpr int sz = AMREX_D_PICK(0, 0, 1);
+        constexpr amrex::Real weight = 1._rt / static_cast<amrex::Real>(1 << AMREX_SPACEDIM);
+
+        amrex::ReduceOps<amrex::ReduceOpSum> reduce_op;
+        amrex::ReduceData<amrex::Real> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        // No tiling, so that the cells of the boxes are counted exactly once
+        for (amrex::MFIter mfi(*m_rho, false); mfi.isValid(); ++mfi)
+        {
+            const amrex::Box cell_box = amrex::enclosedCells(mfi.validbox());
+            amrex::Array4<amrex::Real const> const& rho = m_rho->const_array(mfi);
+            reduce_op.eval(cell_box, reduce_data,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
             {
-                return p.rdata(PIdx::w);
+                amrex::Real n1 = 0._rt;
+                amrex::Real n2 = 0._rt;
+                for         (int kk = k; kk <= k + sz; ++kk) {
+                    for     (int jj = j; jj <= j + sy; ++jj) {
+                        for (int ii = i; ii <= i + 1; ++ii) {
+                            n1 += rho(ii, jj, kk, 0);
+                            n2 += rho(ii, jj, kk, 1);
+                        }
+                    }
+                }
+                return {weight*n1*weight*n2};
             });
-        amrex::ParallelDescriptor::ReduceRealSum(w_tot);
-#elif defined(WARPX_DIM_XZ)
-        // w_tot
-        // x_ave,
-        // thetax_min, thetax_ave, thetax_max
-        amrex::ReduceOps<ReduceOpSum,
-                         ReduceOpSum,
-                         ReduceOpMin, ReduceOpSum, ReduceOpMax> reduce_ops;
-        auto r = amrex::ParticleReduce<amrex::ReduceData<Real,
-                                                         Real,
-                                                         Real, Real, Real>>(
-            myspc,
-            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real,
-                                                                             Real,
-                                                                             Real, Real, Real>
-            {
-                const amrex::Real w  = p.rdata(PIdx::w);
-                const amrex::Real x = p.pos(0);
-                const amrex::Real ux = p.rdata(PIdx::ux);
-                const amrex::Real uz = p.rdata(PIdx::uz);
-                const amrex::Real thetax = std::atan2(ux, uz);
-                return {w, w*x, thetax, w*thetax, thetax};
-            },
-            reduce_ops);
-
-        amrex::Real w_tot  = amrex::get<0>(r);
-        amrex::Real x_ave  = amrex::get<1>(r);
-        amrex::Real thetax_min  = amrex::get<2>(r);
-        amrex::Real thetax_ave  = amrex::get<3>(r);
-        amrex::Real thetax_max  = amrex::get<4>(r);
-
-        amrex::ParallelDescriptor::ReduceRealSum({w_tot, x_ave, thetax_ave});
-        amrex::ParallelDescriptor::ReduceRealMin({thetax_min});
-        amrex::ParallelDescriptor::ReduceRealMax({thetax_max});
-
-        // x_std, thetax_std
-        amrex::Real x_std = 0.0_rt;
-        amrex::Real thetax_std = 0.0_rt;
-
-        if (w_tot > 0.0_rt)
-        {
-            x_ave = x_ave / w_tot;
-            thetax_ave = thetax_ave / w_tot;
-
-            amrex::ReduceOps<ReduceOpSum, ReduceOpSum> reduce_ops_std;
-            auto r_std = amrex::ParticleReduce<amrex::ReduceData<Real, Real>>(
-                myspc,
-                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real>
-                {
-                    const amrex::Real w  = p.rdata(PIdx::w);
-                    const amrex::Real x = p.pos(0);
-                    const amrex::Real ux = p.rdata(PIdx::ux);
-                    const amrex::Real uz = p.rdata(PIdx::uz);
-                    const amrex::Real thetax = std::atan2(ux, uz);
-                    const amrex::Real tmp1 = (x - x_ave)*(x - x_ave)*w;
-                    const amrex::Real tmp2 = (thetax - thetax_ave)*(thetax - thetax_ave)*w;
-                    return {tmp1, tmp2};
-                },
-                reduce_ops_std);
-
-            x_std = amrex::get<0>(r_std);
-            thetax_std = amrex::get<1>(r_std);
-
-            amrex::ParallelDescriptor::ReduceRealSum({x_std, thetax_std});
-
-            x_std = std::sqrt(x_std / w_tot);
-            thetax_std = std::sqrt(thetax_std / w_tot);
         }
+        n1_dot_n2 = amrex::get<0>(reduce_data.value());
+    }
 
-        m_data[get_idx("x_ave_"+m_beam_name[i_s])] = x_ave;
-        m_data[get_idx("x_std_"+m_beam_name[i_s])] = x_std;
-        m_data[get_idx("thetax_min_"+m_beam_name[i_s])] = thetax_min;
-        m_data[get_idx("thetax_ave_"+m_beam_name[i_s])] = thetax_ave;
-        m_data[get_idx("thetax_max_"+m_beam_name[i_s])] = thetax_max;
-        m_data[get_idx("thetax_std_"+m_beam_name[i_s])] = thetax_std;
-#elif defined(WARPX_DIM_3D)
-        // w_tot
-        // x_ave, y_ave,
-        // thetax_min, thetax_ave, thetax_max
-        // thetay_min, thetay_ave, thetay_max
-        amrex::ReduceOps<ReduceOpSum,
-                         ReduceOpSum, ReduceOpSum,
-                         ReduceOpMin, ReduceOpSum, ReduceOpMax,
-                         ReduceOpMin, ReduceOpSum, ReduceOpMax> reduce_ops;
-        auto r = amrex::ParticleReduce<amrex::ReduceData<Real,
-                                                         Real, Real,
-                                                         Real, Real, Real,
-                                                         Real, Real, Real>>(
-            myspc,
-            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real,
-                                                                             Real, Real,
-                                                                             Real, Real, Real,
-                                                                             Real, Real, Real>
-            {
-                const amrex::Real w  = p.rdata(PIdx::w);
-                const amrex::Real x = p.pos(0);
-                const amrex::Real y = p.pos(1);
-                const amrex::Real ux = p.rdata(PIdx::ux);
-                const amrex::Real uy = p.rdata(PIdx::uy);
-                const amrex::Real uz = p.rdata(PIdx::uz);
-                const amrex::Real thetax = std::atan2(ux, uz);
-                const amrex::Real thetay = std::atan2(uy, uz);
-                return {w, w*x, w*y,
-                        thetax, w*thetax, thetax,
-                        thetay, w*thetay, thetay};
-            },
-            reduce_ops);
-
-        amrex::Real w_tot  = amrex::get<0>(r);
-        amrex::Real x_ave  = amrex::get<1>(r);
-        amrex::Real y_ave  = amrex::get<2>(r);
-        amrex::Real thetax_min  = amrex::get<3>(r);
-        amrex::Real thetax_ave  = amrex::get<4>(r);
-        amrex::Real thetax_max  = amrex::get<5>(r);
-        amrex::Real thetay_min  = amrex::get<6>(r);
-        amrex::Real thetay_ave  = amrex::get<7>(r);
-        amrex::Real thetay_max  = amrex::get<8>(r);
-
-        amrex::ParallelDescriptor::ReduceRealSum({w_tot, x_ave, y_ave, thetax_ave, thetay_ave});
-        amrex::ParallelDescriptor::ReduceRealMin({thetax_min, thetay_min});
-        amrex::ParallelDescriptor::ReduceRealMax({thetax_max, thetay_max});
-
-        // x_std, y_std, thetax_std, thetay_std
-        amrex::Real x_std = 0.0_rt;
-        amrex::Real y_std = 0.0_rt;
-        amrex::Real thetax_std = 0.0_rt;
-        amrex::Real thetay_std = 0.0_rt;
-
-        if (w_tot > 0.0_rt)
-        {
-            x_ave = x_ave / w_tot;
-            y_ave = y_ave / w_tot;
-            thetax_ave = thetax_ave / w_tot;
-            thetay_ave = thetay_ave / w_tot;
-
-            amrex::ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_ops_std;
-            auto r_std = amrex::ParticleReduce<amrex::ReduceData<Real, Real, Real, Real>>(
-                myspc,
-                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real, Real, Real>
-                {
-                    const amrex::Real w  = p.rdata(PIdx::w);
-                    const amrex::Real x = p.pos(0);
-                    const amrex::Real ux = p.rdata(PIdx::ux);
-                    const amrex::Real y = p.pos(1);
-                    const amrex::Real uy = p.rdata(PIdx::uy);
-                    const amrex::Real uz = p.rdata(PIdx::uz);
-                    const amrex::Real thetax = std::atan2(ux, uz);
-                    const amrex::Real thetay = std::atan2(uy, uz);
-                    const amrex::Real tmp1 = (x - x_ave)*(x - x_ave)*w;
-                    const amrex::Real tmp2 = (y - y_ave)*(y - y_ave)*w;
-                    const amrex::Real tmp3 = (thetax - thetax_ave)*(thetax - thetax_ave)*w;
-                    const amrex::Real tmp4 = (thetay - thetay_ave)*(thetay - thetay_ave)*w;
-                    return {tmp1, tmp2, tmp3, tmp4};
-                },
-                reduce_ops_std);
-
-            x_std = amrex::get<0>(r_std);
-            y_std = amrex::get<1>(r_std);
-            thetax_std = amrex::get<2>(r_std);
-            thetay_std = amrex::get<3>(r_std);
-
-            amrex::ParallelDescriptor::ReduceRealSum({x_std, y_std, thetax_std, thetay_std});
-
-            x_std = std::sqrt(x_std / w_tot);
-            y_std = std::sqrt(y_std / w_tot);
-            thetax_std = std::sqrt(thetax_std / w_tot);
-            thetay_std = std::sqrt(thetay_std / w_tot);
+    // Sums and maxima of the quantities of the two species (see BeamMoments), and the overlap
+    // integral, so that all of them are reduced across the ranks together
+    std::array<amrex::Real, 2*n_sums + 1> sums;
+    std::array<amrex::Real, 2*n_maxs> maxs;
+    sums[2*n_sums] = n1_dot_n2;
+    std::array<bool, 2> do_qed = {false, false};
+
+    // loop over species
+    for (int i_s = 0; i_s < 2; ++i_s)
+    {
+        // get WarpXParticleContainer class object
+        WarpXParticleContainer& myspc = mypc.GetParticleContainerFromName(m_beam_name[i_s]);
+
+        // The moments are accumulated about the averages of the previous call, which are
+        // computed in a separate pass the first time
+        if (!m_has_moments_ref[i_s]) {
+            m_moments_ref[i_s] = BeamAverages(myspc);
+            m_has_moments_ref[i_s] = true;
         }
+        const MomentsRef ref = m_moments_ref[i_s];
 
-        m_data[get_idx("x_ave_"+m_beam_name[i_s])] = x_ave;
-        m_data[get_idx("x_std_"+m_beam_name[i_s])] = x_std;
-        m_data[get_idx("y_ave_"+m_beam_name[i_s])] = y_ave;
-        m_data[get_idx("y_std_"+m_beam_name[i_s])] = y_std;
-        m_data[get_idx("thetax_min_"+m_beam_name[i_s])] = thetax_min;
-        m_data[get_idx("thetax_ave_"+m_beam_name[i_s])] = thetax_ave;
-        m_data[get_idx("thetax_max_"+m_beam_name[i_s])] = thetax_max;
-        m_data[get_idx("thetax_std_"+m_beam_name[i_s])] = thetax_std;
-        m_data[get_idx("thetay_min_"+m_beam_name[i_s])] = thetay_min;
-        m_data[get_idx("thetay_ave_"+m_beam_name[i_s])] = thetay_ave;
-        m_data[get_idx("thetay_max_"+m_beam_name[i_s])] = thetay_max;
-        m_data[get_idx("thetay_std_"+m_beam_name[i_s])] = thetay_std;
-#endif
+        // Single pass over the particles of all levels, in which chi is also computed
+        // (on the coarsest level only) when QED is on
+        amrex::ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+                         ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+                         ReduceOpMax, ReduceOpMax, ReduceOpMax, ReduceOpMax,
+                         ReduceOpMax, ReduceOpMax> reduce_op;
+        amrex::ReduceData<Real, Real, Real, Real, Real, Real, Real, Real, Real, Real,
+                          Real, Real, Real, Real, Real, Real> reduce_data(reduce_op);
 
 #if (defined WARPX_QED)
+        do_qed[i_s] = myspc.DoQED();
+
         // get mass
         amrex::ParticleReal m = myspc.getMass();
         const bool is_photon = myspc.AmIA<PhysicalSpecies::photon>();
         if (is_photon) {
             m = PhysConst::m_e;
         }
+#endif
 
-        // compute chimin, chiave and chimax
-        amrex::Real chimin_f = 0.0_rt;
-        amrex::Real chimax_f = 0.0_rt;
-        amrex::Real chiave_f = 0.0_rt;
-
-        if (myspc.DoQED())
+        for (int lev = 0; lev <= myspc.finestLevel(); ++lev)
         {
-            // define variables in preparation for field gatheeduce_data.value()ring
-            const int n_rz_azimuthal_modes = WarpX::n_rz_azimuthal_modes;
-            const int nox = WarpX::nox;
-            const bool galerkin_interpolation = WarpX::galerkin_interpolation;
-            const amrex::IntVect ngEB = warpx.getngEB();
-
-            // TODO loop over refinement levels: for (int lev = 0; lev <= level_number; ++lev)
-            const int lev = 0;
-
-            // define variables in preparation for field gathering
-            const std::array<amrex::Real,3>& dx = WarpX::CellSize(std::max(lev, 0));
-            const amrex::GpuArray<amrex::Real, 3> dx_arr = {dx[0], dx[1], dx[2]};
-            const amrex::MultiFab & Ex = warpx.getField(FieldType::Efield_aux, lev,0);
-            const amrex::MultiFab & Ey = warpx.getField(FieldType::Efield_aux, lev,1);
-            const amrex::MultiFab & Ez = warpx.getField(FieldType::Efield_aux, lev,2);
-            const amrex::MultiFab & Bx = warpx.getField(FieldType::Bfield_aux, lev,0);
-            const amrex::MultiFab & By = warpx.getField(FieldType::Bfield_aux, lev,1);
-            const amrex::MultiFab & Bz = warpx.getField(FieldType::Bfield_aux, lev,2);
-
-            // declare reduce_op
-            ReduceOps<ReduceOpMin, ReduceOpMax, ReduceOpSum> reduce_op;
-            ReduceData<Real, Real, Real> reduce_data(reduce_op);
-            using ReduceTuple = typename decltype(reduce_data)::Type;
-
-            // Loop over boxes
             for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
             {
                 const auto GetPosition = GetParticlePosition<PIdx>(pti);
@@ -464,99 +427,156 @@ void ColliderRelevant::ComputeDiags (int step)
                 amrex::ParticleReal* const AMREX_RESTRICT uy = pti.GetAttribs()[PIdx::uy].dataPtr();
                 amrex::ParticleReal* const AMREX_RESTRICT uz = pti.GetAttribs()[PIdx::uz].dataPtr();
                 amrex::ParticleReal* const AMREX_RESTRICT w = pti.GetAttribs()[PIdx::w].dataPtr();
-                // declare external fields
-                const int offset = 0;
-                const auto getExternalEB = GetExternalEBField(pti, offset);
-                const amrex::ParticleReal Ex_external_particle = myspc.m_E_external_particle[0];
-                const amrex::ParticleReal Ey_external_particle = myspc.m_E_external_particle[1];
-                const amrex::ParticleReal Ez_external_particle = myspc.m_E_external_particle[2];
-                const amrex::ParticleReal Bx_external_particle = myspc.m_B_external_particle[0];
-                const amrex::ParticleReal By_external_particle = myspc.m_B_external_particle[1];
-                const amrex::ParticleReal Bz_external_particle = myspc.m_B_external_particle[2];
-
-                // define variables in preparation for field gathering
-                amrex::Box box = pti.tilebox();
-                box.grow(ngEB);
-                const amrex::Dim3 lo = amrex::lbound(box);
-                const std::array<amrex::Real, 3>& xyzmin = WarpX::LowerCorner(box, lev, 0._rt);
-                const amrex::GpuArray<amrex::Real, 3> xyzmin_arr = {xyzmin[0], xyzmin[1], xyzmin[2]};
-                const amrex::Array4<const amrex::Real> & ex_arr = Ex[pti].array();
-                const amrex::Array4<const amrex::Real> & ey_arr = Ey[pti].array();
-                const amrex::Array4<const amrex::Real> & ez_arr = Ez[pti].array();
-                const amrex::Array4<const amrex::Real> & bx_arr = Bx[pti].array();
-                const amrex::Array4<const amrex::Real> & by_arr = By[pti].array();
-                const amrex::Array4<const amrex::Real> & bz_arr = Bz[pti].array();
-                const amrex::IndexType ex_type = Ex[pti].box().ixType();
-                const amrex::IndexType ey_type = Ey[pti].box().ixType();
-                const amrex::IndexType ez_type = Ez[pti].box().ixType();
-                const amrex::IndexType bx_type = Bx[pti].box().ixType();
-                const amrex::IndexType by_type = By[pti].box().ixType();
-                const amrex::IndexType bz_type = Bz[pti].box().ixType();
-
-                // evaluate reduce_op
+
+#if (defined WARPX_QED)
+                // TODO loop over refinement levels for chi
+                if (do_qed[i_s] && lev == 0)
+                {
+                    // define variables in preparation for field gathering
+                    const int n_rz_azimuthal_modes = WarpX::n_rz_azimuthal_modes;
+                    const int nox = WarpX::nox;
+                    const bool galerkin_interpolation = WarpX::galerkin_interpolation;
+                    const amrex::IntVect ngEB = warpx.getngEB();
+                    const std::array<amrex::Real,3>& dx = WarpX::CellSize(std::max(lev, 0));
+                    const amrex::GpuArray<amrex::Real, 3> dx_arr = {dx[0], dx[1], dx[2]};
+                    const amrex::MultiFab & Ex = warpx.getField(FieldType::Efield_aux, lev,0);
+                    const amrex::MultiFab & Ey = warpx.getField(FieldType::Efield_aux, lev,1);
+                    const amrex::MultiFab & Ez = warpx.getField(FieldType::Efield_aux, lev,2);
+                    const amrex::MultiFab & Bx = warpx.getField(FieldType::Bfield_aux, lev,0);
+                    const amrex::MultiFab & By = warpx.getField(FieldType::Bfield_aux, lev,1);
+                    const amrex::MultiFab & Bz = warpx.getField(FieldType::Bfield_aux, lev,2);
+
+                    // declare external fields
+                    const int offset = 0;
+                    const auto getExternalEB = GetExternalEBField(pti, offset);
+                    const amrex::ParticleReal Ex_external_particle = myspc.m_E_external_particle[0];
+                    const amrex::ParticleReal Ey_external_particle = myspc.m_E_external_particle[1];
+                    const amrex::ParticleReal Ez_external_particle = myspc.m_E_external_particle[2];
+                    const amrex::ParticleReal Bx_external_particle = myspc.m_B_external_particle[0];
+                    const amrex::ParticleReal By_external_particle = myspc.m_B_external_particle[1];
+                    const amrex::ParticleReal Bz_external_particle = myspc.m_B_external_particle[2];
+
+                    amrex::Box box = pti.tilebox();
+                    box.grow(ngEB);
+                    const amrex::Dim3 lo = amrex::lbound(box);
+                    const std::array<amrex::Real, 3>& xyzmin = WarpX::LowerCorner(box, lev, 0._rt);
+                    const amrex::GpuArray<amrex::Real, 3> xyzmin_arr = {xyzmin[0], xyzmin[1], xyzmin[2]};
+                    const amrex::Array4<const amrex::Real> & ex_arr = Ex[pti].array();
+                    const amrex::Array4<const amrex::Real> & ey_arr = Ey[pti].array();
+                    const amrex::Array4<const amrex::Real> & ez_arr = Ez[pti].array();
+                    const amrex::Array4<const amrex::Real> & bx_arr = Bx[pti].array();
+                    const amrex::Array4<const amrex::Real> & by_arr = By[pti].array();
+                    const amrex::Array4<const amrex::Real> & bz_arr = Bz[pti].array();
+                    const amrex::IndexType ex_type = Ex[pti].box().ixType();
+                    const amrex::IndexType ey_type = Ey[pti].box().ixType();
+                    const amrex::IndexType ez_type = Ez[pti].box().ixType();
+                    const amrex::IndexType bx_type = Bx[pti].box().ixType();
+                    const amrex::IndexType by_type = By[pti].box().ixType();
+                    const amrex::IndexType bz_type = Bz[pti].box().ixType();
+
+                    reduce_op.eval(pti.numParticles(), reduce_data,
+                    [=] AMREX_GPU_DEVICE (int i) -> MomentsTuple
+                    {
+                        // get external fields
+                        amrex::ParticleReal xp, yp, zp;
+                        GetPosition(i, xp, yp, zp);
+                        amrex::ParticleReal ex = Ex_external_particle;
+                        amrex::ParticleReal ey = Ey_external_particle;
+                        amrex::ParticleReal ez = Ez_external_particle;
+                        amrex::ParticleReal bx = Bx_external_particle;
+                        amrex::ParticleReal by = By_external_particle;
+                        amrex::ParticleReal bz = Bz_external_particle;
+
+                        getExternalEB(i, ex, ey, ez, bx, by, bz);
+
+                        // gather E and B
+                        doGatherShapeN(xp, yp, zp,
+                            ex, ey, ez, bx, by, bz,
+                            ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                            ex_type, ey_type, ez_type,
+                            bx_type, by_type, bz_type,
+                            dx_arr, xyzmin_arr, lo,
+                            n_rz_azimuthal_modes, nox, galerkin_interpolation);
+                        // compute chi
+                        amrex::Real chi = 0.0_rt;
+                        if (is_photon) {
+                            chi = QedUtils::chi_photon(ux[i]*m, uy[i]*m, uz[i]*m,
+                                                ex, ey, ez, bx, by, bz);
+                        } else {
+                            chi = QedUtils::chi_ele_pos(ux[i]*m, uy[i]*m, uz[i]*m,
+                                                ex, ey, ez, bx, by, bz);
+                        }
+                        return BeamMoments(w[i], xp, yp, ux[i], uy[i], uz[i], chi, ref);
+                    });
+                    continue;
+                }
+#endif
                 reduce_op.eval(pti.numParticles(), reduce_data,
-                [=] AMREX_GPU_DEVICE (int i) -> ReduceTuple
+                [=] AMREX_GPU_DEVICE (int i) -> MomentsTuple
                 {
-                    // get external fields
                     amrex::ParticleReal xp, yp, zp;
                     GetPosition(i, xp, yp, zp);
-                    amrex::ParticleReal ex = Ex_external_particle;
-                    amrex::ParticleReal ey = Ey_external_particle;
-                    amrex::ParticleReal ez = Ez_external_particle;
-                    amrex::ParticleReal bx = Bx_external_particle;
-                    amrex::ParticleReal by = By_external_particle;
-                    amrex::ParticleReal bz = Bz_external_particle;
-
-                    getExternalEB(i, ex, ey, ez, bx, by, bz);
-
-                    // gather E and B
-                    doGatherShapeN(xp, yp, zp,
-                        ex, ey, ez, bx, by, bz,
-                        ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
-                        ex_type, ey_type, ez_type,
-                        bx_type, by_type, bz_type,
-                        dx_arr, xyzmin_arr, lo,
-                        n_rz_azimuthal_modes, nox, galerkin_interpolation);
-                    // compute chi
-                    amrex::Real chi = 0.0_rt;
-                    if (is_photon) {
-                        chi = QedUtils::chi_photon(ux[i]*m, uy[i]*m, uz[i]*m,
-                                            ex, ey, ez, bx, by, bz);
-                    } else {
-                        chi = QedUtils::chi_ele_pos(ux[i]*m, uy[i]*m, uz[i]*m,
-                                            ex, ey, ez, bx, by, bz);
-                    }
-                    return {chi, chi, chi*w[i]};
+                    // chi does not contribute when it is not computed
+                    MomentsTuple t = BeamMoments(w[i], xp, yp, ux[i], uy[i], uz[i], 0._rt, ref);
+                    amrex::get<14>(t) = std::numeric_limits<amrex::Real>::lowest();
+                    amrex::get<15>(t) = std::numeric_limits<amrex::Real>::lowest();
+                    return t;
                 });
             }
-            auto val = reduce_data.value();
-            chimin_f = get<0>(val);
-            chimax_f = get<1>(val);
-            chiave_f = get<2>(val);
-            amrex::ParallelDescriptor::ReduceRealMin(chimin_f);
-            amrex::ParallelDescriptor::ReduceRealMax(chimax_f);
-            amrex::ParallelDescriptor::ReduceRealSum(chiave_f);
-
-            m_data[get_idx("chimin_"+m_beam_name[i_s])] = chimin_f;
-            m_data[get_idx("chiave_"+m_beam_name[i_s])] = chiave_f/w_tot;
-            m_data[get_idx("chimax_"+m_beam_name[i_s])] = chimax_f;
         }
-#endif
+        UnpackMoments(reduce_data.value(), sums.data() + i_s*n_sums, maxs.data() + i_s*n_maxs);
     } // end loop over species
 
-    // make density MultiFabs from nodal to cell centered
-    amrex::BoxArray ba = warpx.boxArray(0);
-    const amrex::DistributionMapping dmap = warpx.DistributionMap(0);
-    constexpr int ncomp = 1;
-    constexpr int ngrow = 0;
-    amrex::MultiFab mf_dst1(ba.convert(amrex::IntVect::TheCellVector()), dmap, ncomp, ngrow);
-    amrex::MultiFab mf_dst2(ba.convert(amrex::IntVect::TheCellVector()), dmap, ncomp, ngrow);
-    ablastr::coarsen::sample::Coarsen(mf_dst1, *num_dens[0], 0, 0, ncomp, ngrow);
-    ablastr::coarsen::sample::Coarsen(mf_dst2, *num_dens[1], 0, 0, ncomp, ngrow);
-
-    // compute luminosity
-    amrex::Real const n1_dot_n2 = amrex::MultiFab::Dot(mf_dst1, 0, mf_dst2, 0, 1, 0);
-    amrex::Real const lumi = 2._rt * PhysConst::c * n1_dot_n2 * dV;
+    // Reduce everything across the ranks at once
+    amrex::ParallelDescriptor::ReduceRealSum(sums.data(), static_cast<int>(sums.size()));
+    amrex::ParallelDescriptor::ReduceRealMax(maxs.data(), static_cast<int>(maxs.size()));
+
+    for (int i_s = 0; i_s < 2; ++i_s)
+    {
+        amrex::Real const* s = sums.data() + i_s*n_sums;
+        amrex::Real const* mx = maxs.data() + i_s*n_maxs;
+        const amrex::Real w_tot = s[0];
+        const amrex::Real inv_w = (w_tot > 0.0_rt) ? 1.0_rt/w_tot : 0.0_rt;
+        MomentsRef& ref = m_moments_ref[i_s];
+        // The sums are offsets from the reference values: the average is the reference plus the
+        // mean offset, and the variance is the mean square offset minus the square of the mean
+        // offset (clamped, since it may still be slightly negative due to round-off)
+        const MomentsRef ave = {ref[0] + s[1]*inv_w, ref[1] + s[3]*inv_w,
+                                ref[2] + s[5]*inv_w, ref[3] + s[7]*inv_w};
+        const auto std_dev = [=] (amrex::Real d, amrex::Real sq) {
+            const amrex::Real d_ave = d*inv_w;
+            return std::sqrt(std::max(sq*inv_w - d_ave*d_ave, 0.0_rt));
+        };
+        amrex::ignore_unused(std_dev, mx);
+
+#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_3D)
+        m_data[get_idx("x_ave_"+m_beam_name[i_s])] = ave[0];
+        m_data[get_idx("x_std_"+m_beam_name[i_s])] = std_dev(s[1], s[2]);
+        m_data[get_idx("thetax_min_"+m_beam_name[i_s])] = -mx[2];
+        m_data[get_idx("thetax_ave_"+m_beam_name[i_s])] = ave[2];
+        m_data[get_idx("thetax_max_"+m_beam_name[i_s])] = mx[0];
+        m_data[get_idx("thetax_std_"+m_beam_name[i_s])] = std_dev(s[5], s[6]);
+#endif
+#if defined(WARPX_DIM_3D)
+        m_data[get_idx("y_ave_"+m_beam_name[i_s])] = ave[1];
+        m_data[get_idx("y_std_"+m_beam_name[i_s])] = std_dev(s[3], s[4]);
+        m_data[get_idx("thetay_min_"+m_beam_name[i_s])] = -mx[3];
+        m_data[get_idx("thetay_ave_"+m_beam_name[i_s])] = ave[3];
+        m_data[get_idx("thetay_max_"+m_beam_name[i_s])] = mx[1];
+        m_data[get_idx("thetay_std_"+m_beam_name[i_s])] = std_dev(s[7], s[8]);
+#endif
+        // the averages are the reference values of the next call
+        if (w_tot > 0.0_rt) { ref = ave; }
+        if (do_qed[i_s])
+        {
+            m_data[get_idx("chimin_"+m_beam_name[i_s])] = -mx[5];
+            m_data[get_idx("chiave_"+m_beam_name[i_s])] = s[9]*inv_w;
+            m_data[get_idx("chimax_"+m_beam_name[i_s])] = mx[4];
+        }
+    }
+
+    // compute luminosity from the overlap integral of the number densities
+    amrex::Real const lumi = 2._rt * PhysConst::c * sums[2*n_sums] / (q[0]*q[1]) * dV;
     m_data[get_idx("dL_dt")] = lumi;
 #endif // not RZ
 }
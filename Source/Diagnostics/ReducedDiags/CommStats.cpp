@@ -0,0 +1,134 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "CommStats.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "WarpX.H"
+
+#include <ablastr/utils/CommStats.H>
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <vector>
+
+using namespace amrex::literals;
+using ablastr::utils::communication::CommSiteStats;
+
+namespace
+{
+    /** Call sites in the order of m_data; the exchanges of any other site are
+     *  attributed to the last one */
+    const std::array<std::string, 7> site_names = {
+        "FillBoundaryE", "FillBoundaryB", "SumBoundaryJ", "PMLExchange",
+        "Redistribute", "shiftMF", "other"};
+
+    /** Names and units of the quantities of each site, in the order of m_data */
+    const std::array<std::string, 6> quantity_names = {
+        "calls()", "msgs_sent()", "msgs_recv()", "bytes_sent(B)", "bytes_recv(B)", "wait(s)"};
+
+    constexpr int nquantities = static_cast<int>(quantity_names.size());
+    constexpr int noutputs = 2; // minimum and maximum over the MPI ranks
+
+    void accumulate (amrex::Real* q, CommSiteStats const& stats)
+    {
+        q[0] += static_cast<amrex::Real>(stats.calls);
+        q[1] += static_cast<amrex::Real>(stats.messages_sent);
+        q[2] += static_cast<amrex::Real>(stats.messages_received);
+        q[3] += static_cast<amrex::Real>(stats.bytes_sent);
+        q[4] += static_cast<amrex::Real>(stats.bytes_received);
+        q[5] += static_cast<amrex::Real>(stats.wait_time);
+    }
+}
+
+// constructor
+CommStats::CommStats (const std::string& rd_name)
+: ReducedDiags{rd_name}
+{
+    // resize data array
+    m_data.resize(noutputs*nquantities*site_names.size(), 0.0_rt);
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        if ( m_write_header )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (const auto& site : site_names)
+            {
+                for (const auto& quantity : quantity_names)
+                {
+                    const auto unit = quantity.find('(');
+                    const std::string name = site + "_" + quantity.substr(0, unit);
+                    ofs << m_sep;
+                    ofs << "[" << c++ << "]" << name + "_min" + quantity.substr(unit);
+                    ofs << m_sep;
+                    ofs << "[" << c++ << "]" << name + "_max" + quantity.substr(unit);
+                }
+            }
+            ofs << std::endl;
+            // close file
+            ofs.close();
+        }
+    }
+}
+// end constructor
+
+void CommStats::InitData ()
+{
+    ablastr::utils::communication::CommStats::Enable(
+        m_intervals.contains(WarpX::GetInstance().getistep(0)+1));
+}
+
+// function that gathers the communication counters of each call site
+void CommStats::ComputeDiags (int step)
+{
+    if (m_intervals.contains(step+1))
+    {
+        const auto stats = ablastr::utils::communication::CommStats::GetAndReset();
+
+        const int nsites = static_cast<int>(site_names.size());
+        std::vector<amrex::Real> qmin(nquantities*nsites, 0.0_rt);
+        for (const auto& [site, site_stats] : stats)
+        {
+            const auto it = std::find(site_names.begin(), site_names.end(), site);
+            const auto isite = (it == site_names.end()) ? nsites-1
+                : static_cast<int>(std::distance(site_names.begin(), it));
+            accumulate(&qmin[nquantities*isite], site_stats);
+        }
+        std::vector<amrex::Real> qmax(qmin);
+        const int nq = static_cast<int>(qmin.size());
+        amrex::ParallelDescriptor::ReduceRealMin(qmin.data(), nq);
+        amrex::ParallelDescriptor::ReduceRealMax(qmax.data(), nq);
+
+        for (int i = 0; i < nq; ++i)
+        {
+            m_data[noutputs*i  ] = qmin[i];
+            m_data[noutputs*i+1] = qmax[i];
+        }
+    }
+
+    // Only count the exchanges during the steps that are written out
+    ablastr::utils::communication::CommStats::Enable(m_intervals.contains(step+2));
+
+    /* m_data now contains up-to-date values for:
+     *  [min, max number of calls of FillBoundaryE, min, max number of messages sent by
+     *   FillBoundaryE, ..., min, max wait time of the other exchanges] */
+}
+// end void CommStats::ComputeDiags
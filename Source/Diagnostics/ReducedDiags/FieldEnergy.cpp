@@ -19,13 +19,17 @@
 #include <AMReX_FabArray.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_iMultiFab.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_REAL.H>
 
 #include <algorithm>
+#include <array>
 #include <fstream>
+#include <memory>
 #include <vector>
 
 using namespace amrex;
@@ -87,6 +91,10 @@ void FieldEnergy::ComputeDiags (int step)
     // get number of level
     const auto nLevel = warpx.finestLevel() + 1;
 
+    // Sums of the squares of the E and B fields of each level held by the current
+    // MPI rank, reduced over the MPI ranks in a single call once all levels are done
+    std::vector<amrex::Real> sums(2*nLevel, 0.0_rt);
+
     // loop over refinement levels
     for (int lev = 0; lev < nLevel; ++lev)
     {
@@ -98,35 +106,81 @@ void FieldEnergy::ComputeDiags (int step)
         const MultiFab & By = warpx.getField(FieldType::Bfield_aux, lev,1);
         const MultiFab & Bz = warpx.getField(FieldType::Bfield_aux, lev,2);
 
-        // get cell volume
-        const std::array<Real, 3> &dx = WarpX::CellSize(lev);
-        const amrex::Real dV = dx[0]*dx[1]*dx[2];
-
 #if defined(WARPX_DIM_RZ)
         amrex::Real const tmpEx = ComputeNorm2RZ(Ex, lev);
         amrex::Real const tmpEy = ComputeNorm2RZ(Ey, lev);
         amrex::Real const tmpEz = ComputeNorm2RZ(Ez, lev);
-        amrex::Real const Es = tmpEx + tmpEy + tmpEz;
+        sums[2*lev+0] = tmpEx + tmpEy + tmpEz;
 
         amrex::Real const tmpBx = ComputeNorm2RZ(Bx, lev);
         amrex::Real const tmpBy = ComputeNorm2RZ(By, lev);
         amrex::Real const tmpBz = ComputeNorm2RZ(Bz, lev);
-        amrex::Real const Bs = tmpBx + tmpBy + tmpBz;
+        sums[2*lev+1] = tmpBx + tmpBy + tmpBz;
 #else
         Geometry const & geom = warpx.Geom(lev);
 
-        // compute E squared
-        Real const tmpEx = Ex.norm2(0,geom.periodicity());
-        Real const tmpEy = Ey.norm2(0,geom.periodicity());
-        Real const tmpEz = Ez.norm2(0,geom.periodicity());
-        Real const Es = tmpEx*tmpEx + tmpEy*tmpEy + tmpEz*tmpEz;
-
-        // compute B squared
-        Real const tmpBx = Bx.norm2(0,geom.periodicity());
-        Real const tmpBy = By.norm2(0,geom.periodicity());
-        Real const tmpBz = Bz.norm2(0,geom.periodicity());
-        Real const Bs = tmpBx*tmpBx + tmpBy*tmpBy + tmpBz*tmpBz;
+        // compute E squared and B squared, for all the components in the same loop
+        const std::array<const MultiFab*, 6> fields = {&Ex, &Ey, &Ez, &Bx, &By, &Bz};
+        // The points shared by several boxes (or periodic images) are only counted once
+        std::array<std::unique_ptr<amrex::iMultiFab>, 6> owner_masks;
+        for (int n = 0; n < 6; ++n) {
+            owner_masks[n] = amrex::OwnerMask(*fields[n], geom.periodicity());
+        }
+
+        amrex::ReduceOps<amrex::ReduceOpSum, amrex::ReduceOpSum> reduce_ops;
+        amrex::ReduceData<amrex::Real, amrex::Real> reduce_data(reduce_ops);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
+        for ( amrex::MFIter mfi(Ex, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi )
+        {
+            amrex::GpuArray<amrex::Array4<const amrex::Real>, 6> arr;
+            amrex::GpuArray<amrex::Array4<const int>, 6> mask;
+            amrex::GpuArray<amrex::Box, 6> tb;
+            for (int n = 0; n < 6; ++n) {
+                arr[n] = fields[n]->const_array(mfi);
+                mask[n] = owner_masks[n]->const_array(mfi);
+                tb[n] = mfi.tilebox(fields[n]->ixType().toIntVect());
+            }
+
+            // The nodal tile box contains the tile boxes of all the components
+            reduce_ops.eval(mfi.tilebox(amrex::IntVect::TheNodeVector()), reduce_data,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+                {
+                    const amrex::IntVect iv(AMREX_D_DECL(i, j, k));
+                    amrex::Real E2 = 0._rt, B2 = 0._rt;
+                    for (int n = 0; n < 3; ++n) {
+                        if (tb[n].contains(iv) && mask[n](i,j,k)) {
+                            E2 += arr[n](i,j,k)*arr[n](i,j,k);
+                        }
+                        if (tb[n+3].contains(iv) && mask[n+3](i,j,k)) {
+                            B2 += arr[n+3](i,j,k)*arr[n+3](i,j,k);
+                        }
+                    }
+                    return {E2, B2};
+                });
+        }
+
+        auto const r = reduce_data.value();
+        sums[2*lev+0] = amrex::get<0>(r);
+        sums[2*lev+1] = amrex::get<1>(r);
+#endif
+    }
+    // end loop over refinement levels
+
+    // MPI reduce
+    ParallelDescriptor::ReduceRealSum(sums.data(), static_cast<int>(sums.size()));
+
+    for (int lev = 0; lev < nLevel; ++lev)
+    {
+        // get cell volume
+        const std::array<Real, 3> &dx = WarpX::CellSize(lev);
+        const amrex::Real dV = dx[0]*dx[1]*dx[2];
+
+        amrex::Real const Es = sums[2*lev+0];
+        amrex::Real const Bs = sums[2*lev+1];
 
         constexpr int noutputs = 3; // total energy, E-field energy and B-field energy
         constexpr int index_total = 0;
@@ -139,7 +193,6 @@ void FieldEnergy::ComputeDiags (int step)
         m_data[lev*noutputs+index_total] = m_data[lev*noutputs+index_E] +
                                            m_data[lev*noutputs+index_B];
     }
-    // end loop over refinement levels
 
     /* m_data now contains up-to-date values for:
      *  [total field energy at level 0,
@@ -32,6 +32,7 @@
 #include <AMReX_RealVect.H>
 #include <AMReX_Reduce.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_GpuContainers.H>
 #include <AMReX_StructOfArrays.H>
 #include <AMReX_Vector.H>
 
@@ -40,6 +41,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -426,12 +428,13 @@ void FieldProbe::ComputeDiags (int step)
             numparticles += pti.numParticles();
         }
 
+        // Output data of all the probe particles of this MPI rank, filled tile by tile
+        // and copied to m_data once all the tiles are done
+        amrex::Gpu::DeviceVector<amrex::Real> dv;
+        long dv_offset = 0;
         if (m_intervals.contains(step+1))
         {
-            // reset m_data vector to clear pushed values. Reserves data
-            m_data.clear();
-            m_data.shrink_to_fit();
-            m_data.reserve(numparticles * noutputs);
+            dv.resize(numparticles * noutputs);
         }
 
         for (MyParIter pti(m_probe, lev); pti.isValid(); ++pti)
@@ -555,9 +558,8 @@ void FieldProbe::ComputeDiags (int step)
                 // but we only write when we truly are in an output interval step
                 if (m_intervals.contains(step+1) && np > 0)
                 {
-                    // This could be optimized by using shared memory.
-                    amrex::Gpu::DeviceVector<amrex::Real> dv(np*noutputs);
-                    amrex::Real* dvp = dv.data();
+                    amrex::Real* dvp = dv.data() + dv_offset;
+                    dv_offset += np*noutputs;
                     amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long ip)
                     {
                         amrex::ParticleReal xp, yp, zp;
@@ -575,19 +577,20 @@ void FieldProbe::ComputeDiags (int step)
                         dvp[idx++] = part_Bz[ip];
                         dvp[idx++] = part_S[ip];
                     });
-                    auto oldsize = m_data.size();
-                    m_data.resize(oldsize + dv.size());
-                    amrex::Gpu::copyAsync(amrex::Gpu::deviceToHost,
-                                          dv.begin(), dv.end(), &m_data[oldsize]);
-                    Gpu::streamSynchronize();
-                /* m_data now contains up-to-date values for:
-                 *  [x, y, z, Ex, Ey, Ez, Bx, By, Bz, and S] */
                 }
             }
         } // end particle iterator loop
 
         if (m_intervals.contains(step+1))
         {
+            // copy the data of all the tiles at once
+            m_data.resize(static_cast<std::size_t>(dv_offset));
+            amrex::Gpu::copyAsync(amrex::Gpu::deviceToHost,
+                                  dv.begin(), dv.begin() + dv_offset, m_data.data());
+            Gpu::streamSynchronize();
+            /* m_data now contains up-to-date values for:
+             *  [x, y, z, Ex, Ey, Ez, Bx, By, Bz, and S] */
+
             // returns total number of mpi notes into mpisize
             const int mpisize = ParallelDescriptor::NProcs();
 
@@ -661,9 +664,7 @@ void FieldProbe::WriteToFile (int step) const
         }
     }
 
-    // open file
-    std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
-                        std::ofstream::out | std::ofstream::app};
+    std::ostringstream ofs;
 
     // loop over num valid particles and write
     for (long int i = 0; i < m_valid_particles; i++)
@@ -681,8 +682,8 @@ void FieldProbe::WriteToFile (int step) const
             ofs << m_sep;
             ofs << sorted_data[i * noutputs + k];
         }
-        ofs << std::endl;
+        ofs << '\n';
     } // end loop over data size
-    // close file
-    ofs.close();
+
+    WriteRows(ofs.str());
 }
@@ -0,0 +1,106 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "HardwareCounters.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Utils/HardwareCounters.H"
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_REAL.H>
+
+#include <fstream>
+#include <ostream>
+
+using namespace amrex::literals;
+
+// constructor
+HardwareCounters::HardwareCounters (const std::string& rd_name)
+: ReducedDiags{rd_name}
+{
+    const amrex::ParmParse pp_rd_name(rd_name);
+
+    m_events = {"PAPI_TOT_CYC", "PAPI_TOT_INS", "PAPI_L1_DCM", "PAPI_L2_DCM"};
+    pp_rd_name.queryarr("events", m_events);
+    m_regions = {"PhysicalParticleContainer::Evolve::GatherAndPush",
+                 "WarpXParticleContainer::DepositCurrent::CurrentDeposition",
+                 "WarpX::EvolveE()", "WarpX::EvolveB()"};
+    pp_rd_name.queryarr("regions", m_regions);
+
+    utils::hwcounters::HardwareCounters::Initialize(m_events);
+
+    // resize data array: number of calls and count of each event, for each region
+    m_data.resize(m_regions.size()*(1 + m_events.size()), 0.0_rt);
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        if ( m_write_header )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (const auto& region : m_regions)
+            {
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << region + "_calls()";
+                for (const auto& event : m_events)
+                {
+                    ofs << m_sep;
+                    ofs << "[" << c++ << "]" << region + "_" + event + "()";
+                }
+            }
+            ofs << std::endl;
+            // close file
+            ofs.close();
+        }
+    }
+}
+// end constructor
+
+// function that gathers the hardware event counts of the selected regions
+void HardwareCounters::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    const auto counts = utils::hwcounters::HardwareCounters::GetAndReset();
+
+    const int nevents = static_cast<int>(m_events.size());
+    const int nregions = static_cast<int>(m_regions.size());
+    std::vector<amrex::Real> calls(nregions, 0.0_rt);
+    std::vector<amrex::Real> events(nregions*nevents, 0.0_rt);
+    for (int ir = 0; ir < nregions; ++ir)
+    {
+        const auto it = counts.find(m_regions[ir]);
+        if (it == counts.end()) { continue; }
+        calls[ir] = static_cast<amrex::Real>(it->second.calls);
+        for (int ie = 0; ie < nevents; ++ie) {
+            events[ir*nevents+ie] = static_cast<amrex::Real>(it->second.counts[ie]);
+        }
+    }
+    amrex::ParallelDescriptor::ReduceRealMax(calls.data(), nregions);
+    amrex::ParallelDescriptor::ReduceRealSum(events.data(), nregions*nevents);
+
+    for (int ir = 0; ir < nregions; ++ir)
+    {
+        m_data[ir*(1+nevents)] = calls[ir];
+        for (int ie = 0; ie < nevents; ++ie) {
+            m_data[ir*(1+nevents)+1+ie] = events[ir*nevents+ie];
+        }
+    }
+
+    /* m_data now contains up-to-date values for:
+     *  [number of calls of the first region, count of each event in the first region,
+     *   ..., number of calls of the last region, count of each event in the last region] */
+}
+// end void HardwareCounters::ComputeDiags
@@ -0,0 +1,127 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "ImplicitParticleIterations.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "WarpX.H"
+
+#include <AMReX_INT.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+
+#include <fstream>
+#include <ostream>
+#include <vector>
+
+using namespace amrex::literals;
+
+// constructor
+ImplicitParticleIterations::ImplicitParticleIterations (const std::string& rd_name)
+: ReducedDiags{rd_name}
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        WarpX::evolve_scheme == EvolveScheme::ThetaImplicitEM ||
+        WarpX::evolve_scheme == EvolveScheme::SemiImplicitEM,
+        "ImplicitParticleIterations reduced diagnostics require an implicit evolve scheme");
+
+    // get MultiParticleContainer class object
+    const auto & mypc = WarpX::GetInstance().GetPartContainer();
+
+    // get number of species (int)
+    const auto nSpecies = mypc.nSpecies();
+
+    // resize data array to 4*nSpecies (number of pushes, mean and max number
+    // of iterations and number of unconverged pushes of each species)
+    m_data.resize(4*nSpecies, 0.0_rt);
+
+    // get species names (std::vector<std::string>)
+    const auto species_names = mypc.GetSpeciesNames();
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        if ( m_write_header )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (int i = 0; i < nSpecies; ++i)
+            {
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << species_names[i] + "_pushes()";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << species_names[i] + "_mean_iterations()";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << species_names[i] + "_max_iterations()";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << species_names[i] + "_unconverged()";
+            }
+            ofs << std::endl;
+            // close file
+            ofs.close();
+        }
+    }
+}
+// end constructor
+
+// function that computes the statistics of the Picard iterations of the particles
+void ImplicitParticleIterations::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    // get MultiParticleContainer class object
+    auto & mypc = WarpX::GetInstance().GetPartContainer();
+
+    // get number of species (int)
+    const auto nSpecies = mypc.nSpecies();
+
+    // local statistics of all species, reset once gathered so that each output
+    // covers the steps since the previous output
+    std::vector<amrex::Long> sums(3*nSpecies);
+    std::vector<int> max_iterations(nSpecies);
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
+        auto & myspc = mypc.GetParticleContainer(i_s);
+        const auto & stats = myspc.getImplicitIterationStats();
+        sums[3*i_s  ] = stats.num_pushes;
+        sums[3*i_s+1] = stats.total_iterations;
+        sums[3*i_s+2] = stats.num_unconverged;
+        max_iterations[i_s] = stats.max_iterations;
+        myspc.resetImplicitIterationStats();
+    }
+
+    amrex::ParallelDescriptor::ReduceLongSum(sums.data(), static_cast<int>(sums.size()));
+    amrex::ParallelDescriptor::ReduceIntMax(max_iterations.data(),
+                                            static_cast<int>(max_iterations.size()));
+
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
+        const auto num_pushes = sums[3*i_s];
+        m_data[4*i_s  ] = static_cast<amrex::Real>(num_pushes);
+        m_data[4*i_s+1] = (num_pushes > 0) ?
+            static_cast<amrex::Real>(sums[3*i_s+1])/static_cast<amrex::Real>(num_pushes) : 0.0_rt;
+        m_data[4*i_s+2] = static_cast<amrex::Real>(max_iterations[i_s]);
+        m_data[4*i_s+3] = static_cast<amrex::Real>(sums[3*i_s+2]);
+    }
+
+    /* m_data now contains up-to-date values for:
+     *  [number of pushes (species 1), mean iterations (species 1),
+     *   max iterations (species 1), unconverged pushes (species 1),
+     *   ...,
+     *   unconverged pushes (species n)] */
+}
+// end void ImplicitParticleIterations::ComputeDiags
@@ -105,7 +105,7 @@ void LoadBalanceCosts::ComputeDiags (int step)
     m_data.resize(dataSize, 0.0_rt);
     m_data.assign(dataSize, 0.0_rt);
 
-    // read in WarpX costs to local copy; compute if using `Heuristic` update
+    // read in WarpX costs to local copy; compute if using `Heuristic` or `Adaptive` update
     amrex::Vector<std::unique_ptr<amrex::LayoutData<amrex::Real> > > costs;
 
     costs.resize(nLevels);
@@ -118,6 +118,10 @@ void LoadBalanceCosts::ComputeDiags (int step)
     {
         warpx.ComputeCostsHeuristic(costs);
     }
+    else if (WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Adaptive)
+    {
+        warpx.ComputeCostsAdaptive(costs);
+    }
 
     // keep track of correct index in array over all boxes on all levels
     // shift index for m_data
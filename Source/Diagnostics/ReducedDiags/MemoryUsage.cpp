@@ -0,0 +1,222 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "MemoryUsage.H"
+
+#include "BoundaryConditions/PML.H"
+#include "Diagnostics/Diagnostics.H"
+#include "Diagnostics/MultiDiagnostics.H"
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "FieldSolver/Fields.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/ParticleBoundaryBuffer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/ParticleUtils.H"
+#include "Utils/WarpXUtil.H"
+#include "WarpX.H"
+
+#include <AMReX_GpuDevice.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+
+#include <algorithm>
+#include <fstream>
+#include <ostream>
+#include <utility>
+
+using namespace amrex::literals;
+using warpx::fields::FieldType;
+
+namespace
+{
+    /** Fields accounted for, with their name and number of directions */
+    struct FieldCategory
+    {
+        FieldType type;
+        const char* name;
+        int ndirs;
+    };
+
+    const std::vector<FieldCategory> field_categories = {
+        {FieldType::Efield_aux, "Efield_aux", 3},
+        {FieldType::Bfield_aux, "Bfield_aux", 3},
+        {FieldType::Efield_fp, "Efield_fp", 3},
+        {FieldType::Bfield_fp, "Bfield_fp", 3},
+        {FieldType::current_fp, "current_fp", 3},
+        {FieldType::current_fp_nodal, "current_fp_nodal", 3},
+        {FieldType::rho_fp, "rho_fp", 1},
+        {FieldType::F_fp, "F_fp", 1},
+        {FieldType::G_fp, "G_fp", 1},
+        {FieldType::phi_fp, "phi_fp", 1},
+        {FieldType::vector_potential_fp, "vector_potential_fp", 3},
+        {FieldType::Efield_cp, "Efield_cp", 3},
+        {FieldType::Bfield_cp, "Bfield_cp", 3},
+        {FieldType::current_cp, "current_cp", 3},
+        {FieldType::rho_cp, "rho_cp", 1},
+        {FieldType::F_cp, "F_cp", 1},
+        {FieldType::G_cp, "G_cp", 1},
+        {FieldType::edge_lengths, "edge_lengths", 3},
+        {FieldType::face_areas, "face_areas", 3},
+        {FieldType::Efield_avg_fp, "Efield_avg_fp", 3},
+        {FieldType::Bfield_avg_fp, "Bfield_avg_fp", 3},
+        {FieldType::Efield_avg_cp, "Efield_avg_cp", 3},
+        {FieldType::Bfield_avg_cp, "Bfield_avg_cp", 3}
+    };
+
+    amrex::Long memoryUsage (const amrex::MultiFab* mf)
+    {
+        return (mf) ? WarpXUtilMemory::MemoryUsage(*mf) : 0;
+    }
+}
+
+// constructor
+MemoryUsage::MemoryUsage (const std::string& rd_name)
+: ReducedDiags{rd_name}
+{
+    auto & warpx = WarpX::GetInstance();
+
+    for (const auto& field : field_categories) {
+        m_categories.emplace_back(std::string("field_") + field.name);
+    }
+    for (const auto& species_name : warpx.GetPartContainer().GetSpeciesNames()) {
+        m_categories.push_back("species_" + species_name);
+    }
+    m_categories.emplace_back("pml");
+    for (const auto& diag_name : warpx.GetMultiDiags().GetDiagNames()) {
+        m_categories.push_back("diag_" + diag_name);
+    }
+    m_categories.emplace_back("boundary_buffer");
+    m_categories.emplace_back("device_used");
+
+    const auto ncategories = static_cast<int>(m_categories.size());
+    m_high_water.resize(ncategories, 0);
+
+    // resize data array: current and high-water memory of each category
+    m_data.resize(2*ncategories, 0.0_rt);
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        if ( m_write_header )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (const auto& category : m_categories)
+            {
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << category + "_current(B)";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << category + "_high_water(B)";
+            }
+            ofs << std::endl;
+            // close file
+            ofs.close();
+        }
+    }
+}
+// end constructor
+
+std::vector<amrex::Long> MemoryUsage::Sample () const
+{
+    auto & warpx = WarpX::GetInstance();
+    const int nLevel = warpx.finestLevel() + 1;
+
+    std::vector<amrex::Long> bytes;
+    bytes.reserve(m_categories.size());
+
+    // fields
+    for (const auto& field : field_categories) {
+        amrex::Long b = 0;
+        for (int lev = 0; lev < nLevel; ++lev) {
+            for (int dir = 0; dir < field.ndirs; ++dir) {
+                if (warpx.isFieldInitialized(field.type, lev, dir)) {
+                    b += memoryUsage(warpx.getFieldPointer(field.type, lev, dir));
+                }
+            }
+        }
+        bytes.push_back(b);
+    }
+
+    // species
+    auto & mypc = warpx.GetPartContainer();
+    for (int i_s = 0; i_s < mypc.nSpecies(); ++i_s) {
+        bytes.push_back(ParticleUtils::MemoryUsage(mypc.GetParticleContainer(i_s)));
+    }
+
+    // PML
+    amrex::Long b_pml = 0;
+    for (int lev = 0; lev < nLevel; ++lev) {
+        PML* pml = warpx.GetPML(lev);
+        if (!pml) { continue; }
+        for (auto const& fields : {pml->GetE_fp(), pml->GetB_fp(), pml->Getj_fp(),
+                                   pml->GetE_cp(), pml->GetB_cp(), pml->Getj_cp()}) {
+            for (const auto* mf : fields) { b_pml += memoryUsage(mf); }
+        }
+        for (const auto* mf : {pml->GetF_fp(), pml->GetF_cp(), pml->GetG_fp(), pml->GetG_cp()}) {
+            b_pml += memoryUsage(mf);
+        }
+    }
+    bytes.push_back(b_pml);
+
+    // diagnostics
+    auto & multi_diags = warpx.GetMultiDiags();
+    for (int i_diag = 0; i_diag < multi_diags.GetTotalDiags(); ++i_diag) {
+        bytes.push_back(multi_diags.GetDiag(i_diag).MemoryUsage());
+    }
+
+    // boundary scraping
+    bytes.push_back(warpx.GetParticleBoundaryBuffer().MemoryUsage());
+
+    // all the device memory in use, including the memory that is not accounted for above
+    // (e.g. spectral solvers, temporary buffers, memory pools of the arenas)
+#ifdef AMREX_USE_GPU
+    bytes.push_back(static_cast<amrex::Long>(amrex::Gpu::Device::totalGlobalMem()) -
+                    static_cast<amrex::Long>(amrex::Gpu::Device::freeMemAvailable()));
+#else
+    bytes.push_back(0);
+#endif
+
+    return bytes;
+}
+
+// function that computes the memory used by each category
+void MemoryUsage::ComputeDiags (int step)
+{
+    // Sample the memory at every step, to track the high-water marks
+    const auto bytes = Sample();
+    const auto ncategories = static_cast<int>(bytes.size());
+    for (int i = 0; i < ncategories; ++i) {
+        m_high_water[i] = std::max(m_high_water[i], bytes[i]);
+    }
+
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    // maximum over the MPI ranks, in a single reduction
+    std::vector<amrex::Long> values(2*ncategories);
+    for (int i = 0; i < ncategories; ++i) {
+        values[2*i  ] = bytes[i];
+        values[2*i+1] = m_high_water[i];
+    }
+    amrex::ParallelDescriptor::ReduceLongMax(values.data(), static_cast<int>(values.size()));
+
+    std::transform(values.begin(), values.end(), m_data.begin(),
+        [] (amrex::Long v) { return static_cast<amrex::Real>(v); });
+
+    /* m_data now contains up-to-date values for:
+     *  [current memory (category 1), high-water memory (category 1),
+     *   ...,
+     *   high-water memory (category n)]
+     * where each value is the maximum over the MPI ranks */
+}
+// end void MemoryUsage::ComputeDiags
@@ -9,20 +9,27 @@
 #include "BeamRelevant.H"
 #include "ChargeOnEB.H"
 #include "ColliderRelevant.H"
+#include "CommStats.H"
 #include "FieldEnergy.H"
 #include "FieldMaximum.H"
 #include "FieldProbe.H"
 #include "FieldMomentum.H"
 #include "FieldReduction.H"
+#include "HardwareCounters.H"
+#include "ImplicitParticleIterations.H"
 #include "LoadBalanceCosts.H"
 #include "LoadBalanceEfficiency.H"
+#include "MemoryUsage.H"
 #include "ParticleEnergy.H"
 #include "ParticleExtrema.H"
 #include "ParticleHistogram.H"
 #include "ParticleHistogram2D.H"
 #include "ParticleMomentum.H"
 #include "ParticleNumber.H"
+#include "PhaseTimings.H"
+#include "QuantumSyncPhotons.H"
 #include "RhoMaximum.H"
+#include "TransferAudit.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
 
@@ -67,6 +74,13 @@ MultiReducedDiags::MultiReducedDiags ()
             {"ParticleHistogram2D",   [](CS s){return std::make_unique<ParticleHistogram2D>(s);}},
             {"ParticleNumber",        [](CS s){return std::make_unique<ParticleNumber>(s);}},
             {"ParticleExtrema",       [](CS s){return std::make_unique<ParticleExtrema>(s);}},
+            {"ImplicitParticleIterations", [](CS s){return std::make_unique<ImplicitParticleIterations>(s);}},
+            {"QuantumSyncPhotons",    [](CS s){return std::make_unique<QuantumSyncPhotons>(s);}},
+            {"PhaseTimings",          [](CS s){return std::make_unique<PhaseTimings>(s);}},
+            {"MemoryUsage",           [](CS s){return std::make_unique<MemoryUsage>(s);}},
+            {"CommStats",             [](CS s){return std::make_unique<CommStats>(s);}},
+            {"HardwareCounters",      [](CS s){return std::make_unique<HardwareCounters>(s);}},
+            {"TransferAudit",         [](CS s){return std::make_unique<TransferAudit>(s);}},
             {"ChargeOnEB",  [](CS s){return std::make_unique<ChargeOnEB>(s);}}
     };
     // loop over all reduced diags and fill m_multi_rd with requested reduced diags
@@ -138,3 +152,11 @@ void MultiReducedDiags::WriteToFile (int step)
     // end loop over all reduced diags
 }
 // end void MultiReducedDiags::WriteToFile
+
+void MultiReducedDiags::FlushWriteBuffers ()
+{
+    // Only the I/O rank does
+    if ( !ParallelDescriptor::IOProcessor() ) { return; }
+
+    for (const auto& rd : m_multi_rd) { rd->FlushWriteBuffer(); }
+}
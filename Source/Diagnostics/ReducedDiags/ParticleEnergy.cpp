@@ -98,6 +98,10 @@ void ParticleEnergy::ComputeDiags (int step)
 
     amrex::Real Wtot = 0.0_rt;
 
+    // Sums of the energies and weights of each species held by the current MPI rank,
+    // reduced over the MPI ranks in a single call once all the species are done
+    std::vector<amrex::Real> sums(2*nSpecies, 0.0_rt);
+
     // Loop over species
     for (int i_s = 0; i_s < nSpecies; ++i_s)
     {
@@ -152,8 +156,19 @@ void ParticleEnergy::ComputeDiags (int step)
             Ws   = amrex::get<1>(r);
         }
 
-        // Reduced sum over MPI ranks
-        ParallelDescriptor::ReduceRealSum({Etot,Ws}, ParallelDescriptor::IOProcessorNumber());
+        sums[2*i_s+0] = Etot;
+        sums[2*i_s+1] = Ws;
+    }
+
+    // Reduced sum over MPI ranks
+    ParallelDescriptor::ReduceRealSum(sums.data(), static_cast<int>(sums.size()),
+                                      ParallelDescriptor::IOProcessorNumber());
+
+    // Loop over species
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
+        const amrex::Real Etot = sums[2*i_s+0];
+        const amrex::Real Ws   = sums[2*i_s+1];
 
         // Accumulate sum of weights over all species (must come after MPI reduction of Ws)
         Wtot += Ws;
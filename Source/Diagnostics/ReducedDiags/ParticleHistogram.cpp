@@ -22,6 +22,7 @@
 #include <AMReX_GpuAtomic.H>
 #include <AMReX_GpuContainers.H>
 #include <AMReX_GpuControl.H>
+#include <AMReX_GpuDevice.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_Math.H>
@@ -33,6 +34,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <limits>
 #include <memory>
 #include <ostream>
@@ -193,12 +195,29 @@ void ParticleHistogram::ComputeDiags (int step)
     amrex::Gpu::DeviceVector< amrex::Real > d_data( m_data.size(), 0.0 );
     amrex::Real* const AMREX_RESTRICT dptr_data = d_data.dataPtr();
 
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+    // Each block of threads accumulates its own histogram in shared memory, which is
+    // then added to the global histogram, so that the particles of a peaked distribution
+    // do not all compete for the atomic additions to the same few bins in global memory.
+    // The global histogram is used directly if the bins do not fit in shared memory.
+    const int threads_per_block = 256;
+    const std::size_t bins_bytes = static_cast<std::size_t>(num_bins)*sizeof(amrex::Real);
+    const bool use_shared_mem = bins_bytes <= amrex::Gpu::Device::sharedMemPerBlock();
+    const std::size_t shared_mem_bytes = use_shared_mem ? bins_bytes : 0;
+#endif
+
     int const nlevs = std::max(0, myspc.finestLevel()+1);
     for (int lev = 0; lev < nlevs; ++lev) {
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
         {
+#ifndef AMREX_USE_GPU
+            // On CPU, each thread accumulates its own histogram, added to the global one
+            // after the loop over the particles
+            std::vector<amrex::Real> local_data(num_bins, 0.0_rt);
+            amrex::Real* const AMREX_RESTRICT dptr_local = local_data.data();
+#endif
             for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
             {
                 auto const GetPosition = GetParticlePosition<PIdx>(pti);
@@ -210,41 +229,79 @@ void ParticleHistogram::ComputeDiags (int step)
                 ParticleReal* const AMREX_RESTRICT d_uz = attribs[PIdx::uz].dataPtr();
 
                 long const np = pti.numParticles();
-
-                //Flag particles that need to be copied if they cross the z_slice
+                if (np == 0) { continue; }
+
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+                const auto nblocks = static_cast<int>(std::min<long>(
+                    (np + threads_per_block - 1) / threads_per_block,
+                    8 * amrex::Gpu::Device::numMultiProcessors()));
+                amrex::launch(
+                    nblocks, threads_per_block, shared_mem_bytes, amrex::Gpu::gpuStream(),
+                    [=] AMREX_GPU_DEVICE () noexcept
+#else
                 amrex::ParallelFor(np,
-                   [=] AMREX_GPU_DEVICE(int i)
+                   [=] AMREX_GPU_DEVICE(long i) noexcept
+#endif
                 {
-                    amrex::ParticleReal x, y, z;
-                    GetPosition(i, x, y, z);
-                    auto const w  = (amrex::Real)d_w[i];
-                    auto const ux = d_ux[i] / PhysConst::c;
-                    auto const uy = d_uy[i] / PhysConst::c;
-                    auto const uz = d_uz[i] / PhysConst::c;
-
-                    // don't count a particle if it is filtered out
-                    if (do_parser_filter) {
-                        if (fun_filterparser(t, x, y, z, ux, uy, uz) == 0._rt) {
-                            return;
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+                    amrex::Gpu::SharedMemory<amrex::Real> gsm;
+                    amrex::Real* const bins = use_shared_mem ? gsm.dataPtr() : dptr_data;
+                    if (use_shared_mem) {
+                        for (int ib = threadIdx.x; ib < num_bins; ib += blockDim.x) { bins[ib] = 0.0_rt; }
+                        __syncthreads();
+                    }
+                    // Each thread loops over the particles with a stride of the total number of threads
+                    for (long i = static_cast<long>(blockIdx.x)*blockDim.x + threadIdx.x; i < np;
+                         i += static_cast<long>(blockDim.x)*gridDim.x)
+#elif defined(AMREX_USE_GPU)
+                    amrex::Real* const bins = dptr_data;
+#else
+                    amrex::Real* const bins = dptr_local;
+#endif
+                    {
+                        amrex::ParticleReal x, y, z;
+                        GetPosition(i, x, y, z);
+                        auto const w  = (amrex::Real)d_w[i];
+                        auto const ux = d_ux[i] / PhysConst::c;
+                        auto const uy = d_uy[i] / PhysConst::c;
+                        auto const uz = d_uz[i] / PhysConst::c;
+
+                        // don't count a particle if it is filtered out
+                        const bool keep = !do_parser_filter ||
+                            fun_filterparser(t, x, y, z, ux, uy, uz) != 0._rt;
+                        if (keep) {
+                            auto const f = fun_partparser(t, x, y, z, ux, uy, uz);
+                            // determine particle bin
+                            int const bin = int(Math::floor((f-bin_min)/bin_size));
+                            // discard if out-of-range
+                            if ( bin>=0 && bin<num_bins ) {
+                                // add particle to histogram bin
+                                const amrex::Real value = is_unity_particle_weight ? 1.0_rt : w;
+#ifdef AMREX_USE_GPU
+                                amrex::Gpu::Atomic::AddNoRet(&bins[bin], value);
+#else
+                                bins[bin] += value;
+#endif
+                            }
                         }
                     }
-                    // continue function if particle is not filtered out
-                    auto const f = fun_partparser(t, x, y, z, ux, uy, uz);
-                    // determine particle bin
-                    int const bin = int(Math::floor((f-bin_min)/bin_size));
-                    if ( bin<0 || bin>=num_bins ) { return; } // discard if out-of-range
-
-                    // add particle to histogram bin
-                    //! @todo performance: on CPU, we are probably faster by
-                    //        letting each thread compute its own histogram and
-                    //        then we reduce the histograms after the loop
-                    if ( is_unity_particle_weight ) {
-                        amrex::HostDevice::Atomic::Add(&dptr_data[bin], 1.0_rt);
-                    } else {
-                        amrex::HostDevice::Atomic::Add(&dptr_data[bin], w);
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+                    // add the histogram of the block to the global histogram
+                    if (use_shared_mem) {
+                        __syncthreads();
+                        for (int ib = threadIdx.x; ib < num_bins; ib += blockDim.x) {
+                            if (bins[ib] != 0.0_rt) { amrex::Gpu::Atomic::AddNoRet(&dptr_data[ib], bins[ib]); }
+                        }
                     }
+#endif
                 });
             }
+#ifndef AMREX_USE_GPU
+#ifdef AMREX_USE_OMP
+#pragma omp critical (particle_histogram_reduce)
+#endif
+            for (int ib = 0; ib < num_bins; ++ib) { dptr_data[ib] += dptr_local[ib]; }
+#endif
         }
     }
 
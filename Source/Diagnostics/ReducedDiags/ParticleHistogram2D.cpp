@@ -23,6 +23,7 @@
 #include <AMReX_GpuAtomic.H>
 #include <AMReX_GpuContainers.H>
 #include <AMReX_GpuControl.H>
+#include <AMReX_GpuDevice.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_Math.H>
@@ -40,6 +41,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <limits>
 #include <memory>
 #include <ostream>
@@ -187,12 +189,32 @@ void ParticleHistogram2D::ComputeDiags (int step)
 
     bool const do_parser_filter = m_do_parser_filter;
 
+    // The partial histograms below store bin (bin_abs, bin_ord) at bin_abs + bin_ord*num_bins_abs
+    const int num_bins = num_bins_abs*num_bins_ord;
+
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+    // Each block of threads accumulates its own histogram in shared memory, which is
+    // then added to the global histogram, so that the particles of a peaked distribution
+    // do not all compete for the atomic additions to the same few bins in global memory.
+    // The global histogram is used directly if the bins do not fit in shared memory.
+    const int threads_per_block = 256;
+    const std::size_t bins_bytes = static_cast<std::size_t>(num_bins)*sizeof(amrex::Real);
+    const bool use_shared_mem = bins_bytes <= amrex::Gpu::Device::sharedMemPerBlock();
+    const std::size_t shared_mem_bytes = use_shared_mem ? bins_bytes : 0;
+#endif
+
     int const nlevs = std::max(0, myspc.finestLevel()+1);
     for (int lev = 0; lev < nlevs; ++lev) {
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
         {
+#ifndef AMREX_USE_GPU
+            // On CPU, each thread accumulates its own histogram, added to the global one
+            // after the loop over the particles
+            std::vector<amrex::Real> local_data(num_bins, 0.0_rt);
+            amrex::Real* const AMREX_RESTRICT dptr_local = local_data.data();
+#endif
             for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
             {
                 auto const GetPosition = GetParticlePosition<PIdx>(pti);
@@ -204,41 +226,90 @@ void ParticleHistogram2D::ComputeDiags (int step)
                 ParticleReal* const AMREX_RESTRICT d_uz = attribs[PIdx::uz].dataPtr();
 
                 long const np = pti.numParticles();
-
-                //Flag particles that need to be copied if they cross the z_slice
+                if (np == 0) { continue; }
+
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+                const auto nblocks = static_cast<int>(std::min<long>(
+                    (np + threads_per_block - 1) / threads_per_block,
+                    8 * amrex::Gpu::Device::numMultiProcessors()));
+                amrex::launch(
+                    nblocks, threads_per_block, shared_mem_bytes, amrex::Gpu::gpuStream(),
+                    [=] AMREX_GPU_DEVICE () noexcept
+#else
                 amrex::ParallelFor(np,
-                                   [=] AMREX_GPU_DEVICE(int i)
-                                   {
-                                       amrex::ParticleReal x, y, z;
-                                       GetPosition(i, x, y, z);
-                                       auto const w  = (amrex::Real)d_w[i];
-                                       auto const ux = d_ux[i] / PhysConst::c;
-                                       auto const uy = d_uy[i] / PhysConst::c;
-                                       auto const uz = d_uz[i] / PhysConst::c;
-
-                                       // don't count a particle if it is filtered out
-                                       if (do_parser_filter) {
-                                           if(!static_cast<bool>(fun_filterparser(t, x, y, z, ux, uy, uz, w))) {
-                                               return;
-                                           }
-                                       }
-
-                                       // continue function if particle is not filtered out
-                                       auto const f_abs = fun_partparser_abs(t, x, y, z, ux, uy, uz, w);
-                                       auto const f_ord = fun_partparser_ord(t, x, y, z, ux, uy, uz, w);
-                                       auto const weight = fun_valueparser(t, x, y, z, ux, uy, uz, w);
-
-                                       // determine particle bin
-                                       int const bin_abs = int(Math::floor((f_abs-bin_min_abs)/bin_size_abs));
-                                       if ( bin_abs<0 || bin_abs>=num_bins_abs ) { return; } // discard if out-of-range
-
-                                       int const bin_ord = int(Math::floor((f_ord-bin_min_ord)/bin_size_ord));
-                                       if ( bin_ord<0 || bin_ord>=num_bins_ord ) { return; } // discard if out-of-range
-
-                                       amrex::Real &data = d_table(bin_abs, bin_ord);
-                                       amrex::HostDevice::Atomic::Add(&data, weight);
-                                   });
+                   [=] AMREX_GPU_DEVICE(long i) noexcept
+#endif
+                {
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+                    amrex::Gpu::SharedMemory<amrex::Real> gsm;
+                    amrex::Real* const bins = gsm.dataPtr();
+                    if (use_shared_mem) {
+                        for (int ib = threadIdx.x; ib < num_bins; ib += blockDim.x) { bins[ib] = 0.0_rt; }
+                        __syncthreads();
+                    }
+                    // Each thread loops over the particles with a stride of the total number of threads
+                    for (long i = static_cast<long>(blockIdx.x)*blockDim.x + threadIdx.x; i < np;
+                         i += static_cast<long>(blockDim.x)*gridDim.x)
+#endif
+                    {
+                        amrex::ParticleReal x, y, z;
+                        GetPosition(i, x, y, z);
+                        auto const w  = (amrex::Real)d_w[i];
+                        auto const ux = d_ux[i] / PhysConst::c;
+                        auto const uy = d_uy[i] / PhysConst::c;
+                        auto const uz = d_uz[i] / PhysConst::c;
+
+                        // don't count a particle if it is filtered out
+                        const bool keep = !do_parser_filter ||
+                            static_cast<bool>(fun_filterparser(t, x, y, z, ux, uy, uz, w));
+
+                        // continue function if particle is not filtered out
+                        if (keep) {
+                            auto const f_abs = fun_partparser_abs(t, x, y, z, ux, uy, uz, w);
+                            auto const f_ord = fun_partparser_ord(t, x, y, z, ux, uy, uz, w);
+                            auto const weight = fun_valueparser(t, x, y, z, ux, uy, uz, w);
+
+                            // determine particle bin
+                            int const bin_abs = int(Math::floor((f_abs-bin_min_abs)/bin_size_abs));
+                            int const bin_ord = int(Math::floor((f_ord-bin_min_ord)/bin_size_ord));
+
+                            // discard if out-of-range
+                            if ( bin_abs>=0 && bin_abs<num_bins_abs &&
+                                 bin_ord>=0 && bin_ord<num_bins_ord ) {
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+                                amrex::Real* const data = use_shared_mem ?
+                                    &bins[bin_abs + bin_ord*num_bins_abs] : &d_table(bin_abs, bin_ord);
+                                amrex::Gpu::Atomic::AddNoRet(data, weight);
+#elif defined(AMREX_USE_GPU)
+                                amrex::Gpu::Atomic::AddNoRet(&d_table(bin_abs, bin_ord), weight);
+#else
+                                dptr_local[bin_abs + bin_ord*num_bins_abs] += weight;
+#endif
+                            }
+                        }
+                    }
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+                    // add the histogram of the block to the global histogram
+                    if (use_shared_mem) {
+                        __syncthreads();
+                        for (int ib = threadIdx.x; ib < num_bins; ib += blockDim.x) {
+                            if (bins[ib] != 0.0_rt) {
+                                amrex::Gpu::Atomic::AddNoRet(
+                                    &d_table(ib % num_bins_abs, ib / num_bins_abs), bins[ib]);
+                            }
+                        }
+                    }
+#endif
+                });
             }
+#ifndef AMREX_USE_GPU
+#ifdef AMREX_USE_OMP
+#pragma omp critical (particle_histogram_2d_reduce)
+#endif
+            for (int ib = 0; ib < num_bins; ++ib) {
+                d_table(ib % num_bins_abs, ib / num_bins_abs) += dptr_local[ib];
+            }
+#endif
         }
     }
 
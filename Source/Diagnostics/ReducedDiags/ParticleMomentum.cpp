@@ -126,6 +126,10 @@ void ParticleMomentum::ComputeDiags (int step)
 
     amrex::Real Wtot = 0.0_rt;
 
+    // Sums of the momenta and weights of each species held by the current MPI rank,
+    // reduced over the MPI ranks in a single call once all the species are done
+    std::vector<amrex::Real> sums(4*nSpecies, 0.0_rt);
+
     // Loop over species
     for (int i_s = 0; i_s < nSpecies; ++i_s)
     {
@@ -155,13 +159,23 @@ void ParticleMomentum::ComputeDiags (int step)
             },
             reduce_ops);
 
-        amrex::Real Px = amrex::get<0>(r);
-        amrex::Real Py = amrex::get<1>(r);
-        amrex::Real Pz = amrex::get<2>(r);
-        amrex::Real Ws = amrex::get<3>(r);
+        sums[4*i_s+0] = amrex::get<0>(r);
+        sums[4*i_s+1] = amrex::get<1>(r);
+        sums[4*i_s+2] = amrex::get<2>(r);
+        sums[4*i_s+3] = amrex::get<3>(r);
+    }
+
+    // Reduced sum over MPI ranks
+    ParallelDescriptor::ReduceRealSum(sums.data(), static_cast<int>(sums.size()),
+                                      ParallelDescriptor::IOProcessorNumber());
 
-        // Reduced sum over MPI ranks
-        ParallelDescriptor::ReduceRealSum({Px,Py,Pz,Ws}, ParallelDescriptor::IOProcessorNumber());
+    // Loop over species
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
+        const amrex::Real Px = sums[4*i_s+0];
+        const amrex::Real Py = sums[4*i_s+1];
+        const amrex::Real Pz = sums[4*i_s+2];
+        const amrex::Real Ws = sums[4*i_s+3];
 
         // Accumulate sum of weights over all species (must come after MPI reduction of Ws)
         Wtot += Ws;
@@ -108,17 +108,32 @@ void ParticleNumber::ComputeDiags (int step)
     m_data[idx_total_macroparticles] = 0.0_rt;
     m_data[idx_total_sum_weight] = 0.0_rt;
 
+    // Numbers of macroparticles and sums of the weights of each species held by the
+    // current MPI rank, reduced over the MPI ranks once all the species are done
+    std::vector<amrex::Long> np_species(nSpecies, 0);
+    std::vector<amrex::Real> w_species(nSpecies, 0.0_rt);
+
     // loop over species
     for (int i_s = 0; i_s < nSpecies; ++i_s)
     {
         // get WarpXParticleContainer class object
         auto & myspc = mypc.GetParticleContainer(i_s);
 
+        np_species[i_s] = myspc.TotalNumberOfParticles(true, true);
+        w_species[i_s] = myspc.sumParticleWeight(true);
+    }
+
+    amrex::ParallelDescriptor::ReduceLongSum(np_species.data(), static_cast<int>(nSpecies));
+    amrex::ParallelDescriptor::ReduceRealSum(w_species.data(), static_cast<int>(nSpecies));
+
+    // loop over species
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
         // Save total number of macroparticles for this species
-        m_data[idx_first_species_macroparticles + i_s] = myspc.TotalNumberOfParticles();
+        m_data[idx_first_species_macroparticles + i_s] = static_cast<amrex::Real>(np_species[i_s]);
 
         // Save sum of particles weight for this species
-        m_data[idx_first_species_sum_weight + i_s] = myspc.sumParticleWeight(false);
+        m_data[idx_first_species_sum_weight + i_s] = w_species[i_s];
 
         // Increase total number of macroparticles and total weight (all species)
         m_data[idx_total_macroparticles] += m_data[idx_first_species_macroparticles + i_s];
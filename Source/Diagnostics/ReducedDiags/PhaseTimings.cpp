@@ -0,0 +1,152 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "PhaseTimings.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Utils/PhaseTimers.H"
+#include "WarpX.H"
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_REAL.H>
+
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <vector>
+
+using namespace amrex::literals;
+using utils::timers::PhaseTimers;
+using utils::timers::num_phases;
+
+namespace
+{
+    /** Names of the phases and of the total time, in the order of m_data */
+    std::vector<std::string> timingNames ()
+    {
+        std::vector<std::string> names;
+        for (int i = 0; i < num_phases; ++i) {
+            names.push_back(utils::timers::PhaseName(static_cast<utils::timers::Phase>(i)));
+        }
+        names.emplace_back("step");
+        return names;
+    }
+
+    constexpr int noutputs = 3; // minimum, average and maximum over the MPI ranks
+}
+
+// constructor
+PhaseTimings::PhaseTimings (const std::string& rd_name)
+: ReducedDiags{rd_name}
+{
+    const amrex::ParmParse pp_rd_name(rd_name);
+    pp_rd_name.query("json_timeline", m_json_timeline);
+
+    const auto names = timingNames();
+
+    // resize data array
+    m_data.resize(noutputs*names.size(), 0.0_rt);
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        if ( m_write_header )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (const auto& name : names)
+            {
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << name + "_min(s)";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << name + "_avg(s)";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << name + "_max(s)";
+            }
+            ofs << std::endl;
+            // close file
+            ofs.close();
+        }
+
+        if ( m_write_header && m_json_timeline )
+        {
+            // start a new timeline
+            std::ofstream ofs{m_path + m_rd_name + ".jsonl", std::ofstream::out};
+        }
+    }
+}
+// end constructor
+
+void PhaseTimings::InitData ()
+{
+    PhaseTimers::Enable(m_intervals.contains(WarpX::GetInstance().getistep(0)+1));
+}
+
+// function that gathers the time spent in each phase
+void PhaseTimings::ComputeDiags (int step)
+{
+    if (m_intervals.contains(step+1))
+    {
+        const auto times = PhaseTimers::GetAndReset();
+
+        const int ntimes = static_cast<int>(times.size());
+        std::vector<amrex::Real> tmin(times.begin(), times.end());
+        std::vector<amrex::Real> tmax(tmin);
+        std::vector<amrex::Real> tsum(tmin);
+        amrex::ParallelDescriptor::ReduceRealMin(tmin.data(), ntimes);
+        amrex::ParallelDescriptor::ReduceRealMax(tmax.data(), ntimes);
+        amrex::ParallelDescriptor::ReduceRealSum(tsum.data(), ntimes);
+
+        const auto nprocs = static_cast<amrex::Real>(amrex::ParallelDescriptor::NProcs());
+        for (int i = 0; i < ntimes; ++i)
+        {
+            m_data[noutputs*i  ] = tmin[i];
+            m_data[noutputs*i+1] = tsum[i]/nprocs;
+            m_data[noutputs*i+2] = tmax[i];
+        }
+    }
+
+    // Only read the clocks during the steps that are written out
+    PhaseTimers::Enable(m_intervals.contains(step+2));
+
+    /* m_data now contains up-to-date values for:
+     *  [min, avg, max time of the particle push, ..., min, avg, max time of the diagnostics,
+     *   min, avg, max total time of the step] */
+}
+// end void PhaseTimings::ComputeDiags
+
+void PhaseTimings::WriteToFile (int step) const
+{
+    ReducedDiags::WriteToFile(step);
+
+    if (!m_json_timeline) { return; }
+
+    const auto names = timingNames();
+
+    std::ostringstream ofs;
+    ofs << std::setprecision(m_precision) << std::scientific;
+    ofs << "{\"step\": " << step+1 << ", \"time\": " << WarpX::GetInstance().gett_new(0);
+    for (int i = 0; i < static_cast<int>(names.size()); ++i)
+    {
+        ofs << ", \"" << names[i] << "\": {"
+            << "\"min\": " << m_data[noutputs*i] << ", "
+            << "\"avg\": " << m_data[noutputs*i+1] << ", "
+            << "\"max\": " << m_data[noutputs*i+2] << "}";
+    }
+    ofs << "}\n";
+
+    std::ofstream ofs_json{m_path + m_rd_name + ".jsonl", std::ofstream::out | std::ofstream::app};
+    ofs_json << ofs.str();
+}
+// end void PhaseTimings::WriteToFile
@@ -0,0 +1,124 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "QuantumSyncPhotons.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/TextMsg.H"
+#include "WarpX.H"
+
+#include <AMReX_INT.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+
+#include <fstream>
+#include <ostream>
+#include <vector>
+
+using namespace amrex::literals;
+
+// constructor
+QuantumSyncPhotons::QuantumSyncPhotons (const std::string& rd_name)
+: ReducedDiags{rd_name}
+{
+#ifndef WARPX_QED
+    WARPX_ABORT_WITH_MESSAGE(
+        "QuantumSyncPhotons reduced diagnostics require to compile with QED=TRUE");
+#else
+    // get MultiParticleContainer class object
+    const auto & mypc = WarpX::GetInstance().GetPartContainer();
+
+    // find the species with Quantum Synchrotron emission
+    for (int i = 0; i < mypc.nSpecies(); ++i) {
+        if (mypc.GetParticleContainer(i).has_quantum_sync()) { m_species_indices.push_back(i); }
+    }
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_species_indices.empty(),
+        "QuantumSyncPhotons reduced diagnostics require a species with do_qed_quantum_sync = 1");
+
+    const auto nSpecies = static_cast<int>(m_species_indices.size());
+
+    // resize data array to 3*nSpecies (discarded weight and energy and
+    // merged photons of each species)
+    m_data.resize(3*nSpecies, 0.0_rt);
+
+    // get species names (std::vector<std::string>)
+    const auto species_names = mypc.GetSpeciesNames();
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        if ( m_write_header )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (const int i : m_species_indices)
+            {
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << species_names[i] + "_discarded_weight()";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << species_names[i] + "_discarded_energy(J)";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << species_names[i] + "_merged_photons()";
+            }
+            ofs << std::endl;
+            // close file
+            ofs.close();
+        }
+    }
+#endif
+}
+// end constructor
+
+// function that computes the statistics of the discarded and merged photons
+void QuantumSyncPhotons::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+#ifdef WARPX_QED
+    // get MultiParticleContainer class object
+    const auto & mypc = WarpX::GetInstance().GetPartContainer();
+
+    const auto nSpecies = static_cast<int>(m_species_indices.size());
+
+    // local statistics of the species
+    std::vector<amrex::Real> sums(2*nSpecies);
+    std::vector<amrex::Long> merged(nSpecies);
+    for (int k = 0; k < nSpecies; ++k)
+    {
+        const auto & stats =
+            mypc.GetParticleContainer(m_species_indices[k]).getQuantumSyncPhotonStats();
+        sums[2*k  ] = static_cast<amrex::Real>(stats.discarded_weight);
+        sums[2*k+1] = static_cast<amrex::Real>(stats.discarded_energy);
+        merged[k] = stats.merged;
+    }
+
+    amrex::ParallelDescriptor::ReduceRealSum(sums.data(), static_cast<int>(sums.size()));
+    amrex::ParallelDescriptor::ReduceLongSum(merged.data(), static_cast<int>(merged.size()));
+
+    for (int k = 0; k < nSpecies; ++k)
+    {
+        m_data[3*k  ] = sums[2*k];
+        m_data[3*k+1] = sums[2*k+1];
+        m_data[3*k+2] = static_cast<amrex::Real>(merged[k]);
+    }
+
+    /* m_data now contains up-to-date values for:
+     *  [discarded weight (species 1), discarded energy (species 1),
+     *   merged photons (species 1),
+     *   ...,
+     *   merged photons (species n)] */
+#endif
+}
+// end void QuantumSyncPhotons::ComputeDiags
@@ -19,6 +19,7 @@
 
 #include <fstream>
 #include <iomanip>
+#include <sstream>
 
 using namespace amrex;
 
@@ -69,9 +70,19 @@ m_rd_name{rd_name}
 
     // precision of data in the output file
     utils::parser::queryWithParser(pp_rd_name, "precision", m_precision);
+
+    // number of outputs buffered in memory before writing to file
+    utils::parser::queryWithParser(pp_rd_name, "write_buffer_size", m_write_buffer_size);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_write_buffer_size >= 1,
+        m_rd_name + ".write_buffer_size must be at least 1");
 }
 // end constructor
 
+ReducedDiags::~ReducedDiags ()
+{
+    FlushWriteBuffer();
+}
+
 void ReducedDiags::InitData ()
 {
     // Defines an empty function InitData() to be overwritten if needed.
@@ -97,12 +108,31 @@ void ReducedDiags::BackwardCompatibility () const
     );
 }
 
-// write to file function
-void ReducedDiags::WriteToFile (int step) const
+void ReducedDiags::WriteRows (const std::string& rows) const
+{
+    m_write_buffer += rows;
+    ++m_n_buffered_outputs;
+    if (m_n_buffered_outputs >= m_write_buffer_size) { FlushWriteBuffer(); }
+}
+
+void ReducedDiags::FlushWriteBuffer () const
 {
+    if (m_write_buffer.empty()) { return; }
+
     // open file
     std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
         std::ofstream::out | std::ofstream::app};
+    ofs << m_write_buffer;
+    ofs.close();
+
+    m_write_buffer.clear();
+    m_n_buffered_outputs = 0;
+}
+
+// write to file function
+void ReducedDiags::WriteToFile (int step) const
+{
+    std::ostringstream ofs;
 
     // write step
     ofs << step+1;
@@ -121,9 +151,8 @@ void ReducedDiags::WriteToFile (int step) const
     // end loop over data size
 
     // end line
-    ofs << std::endl;
+    ofs << '\n';
 
-    // close file
-    ofs.close();
+    WriteRows(ofs.str());
 }
 // end ReducedDiags::WriteToFile
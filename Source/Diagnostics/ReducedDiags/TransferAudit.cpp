@@ -0,0 +1,123 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "TransferAudit.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Utils/TransferAudit.H"
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_REAL.H>
+
+#include <array>
+#include <fstream>
+#include <ostream>
+
+using namespace amrex::literals;
+
+namespace
+{
+    /** Number of quantities written out for each region */
+    constexpr int n_region_quantities = 4;
+    /** Number of managed-memory quantities */
+    constexpr int n_managed_quantities = 4;
+}
+
+// constructor
+TransferAudit::TransferAudit (const std::string& rd_name)
+: ReducedDiags{rd_name}
+{
+    const amrex::ParmParse pp_rd_name(rd_name);
+
+    m_regions = {"WarpX::Evolve()", "Diagnostics::FilterComputePackFlush()",
+                 "MultiReducedDiags::ComputeDiags()"};
+    pp_rd_name.queryarr("regions", m_regions);
+    // the copies made outside of the profiled regions are always written out
+    m_regions.push_back(utils::transfer_audit::unattributed_region);
+
+    utils::transfer_audit::TransferAudit::Initialize();
+
+    // resize data array: copies of each region, then the managed-memory events
+    m_data.resize(m_regions.size()*n_region_quantities + n_managed_quantities, 0.0_rt);
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        if ( m_write_header )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (const auto& region : m_regions)
+            {
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << region + "_htod_copies()";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << region + "_htod(B)";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << region + "_dtoh_copies()";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << region + "_dtoh(B)";
+            }
+            ofs << m_sep;
+            ofs << "[" << c++ << "]managed_cpu_page_faults()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]managed_gpu_page_faults()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]managed_htod(B)";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]managed_dtoh(B)";
+            ofs << std::endl;
+            // close file
+            ofs.close();
+        }
+    }
+}
+// end constructor
+
+// function that gathers the host-device transfers of the selected regions
+void TransferAudit::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    const auto transfers = utils::transfer_audit::TransferAudit::GetAndReset();
+    const auto managed = utils::transfer_audit::TransferAudit::GetAndResetManagedMemory();
+
+    const int nregions = static_cast<int>(m_regions.size());
+    for (int ir = 0; ir < nregions; ++ir)
+    {
+        auto* const data = m_data.data() + ir*n_region_quantities;
+        const auto it = transfers.find(m_regions[ir]);
+        if (it == transfers.end()) {
+            for (int iq = 0; iq < n_region_quantities; ++iq) { data[iq] = 0.0_rt; }
+            continue;
+        }
+        data[0] = static_cast<amrex::Real>(it->second.htod_copies);
+        data[1] = static_cast<amrex::Real>(it->second.htod_bytes);
+        data[2] = static_cast<amrex::Real>(it->second.dtoh_copies);
+        data[3] = static_cast<amrex::Real>(it->second.dtoh_bytes);
+    }
+    const std::array<long long, n_managed_quantities> managed_values = {
+        managed.cpu_page_faults, managed.gpu_page_faults, managed.htod_bytes, managed.dtoh_bytes};
+    for (int iq = 0; iq < n_managed_quantities; ++iq) {
+        m_data[nregions*n_region_quantities + iq] = static_cast<amrex::Real>(managed_values[iq]);
+    }
+
+    amrex::ParallelDescriptor::ReduceRealSum(m_data.data(), static_cast<int>(m_data.size()));
+
+    /* m_data now contains up-to-date values for:
+     *  [number and bytes of the host-to-device and device-to-host copies of each region,
+     *   CPU and GPU page faults and host-to-device and device-to-host migrated bytes
+     *   of the managed memory] */
+}
+// end void TransferAudit::ComputeDiags
@@ -53,6 +53,7 @@ using namespace warpx::fields;
  *  If interpolation is required, then on the smf, using data points stored in the ghost cells, the data in interpolated.
  *  If coarsening is required, then a coarse slice multifab is generated (cs_mf) and the
  *  values of the refined slice (smf) is averaged down to obtain the coarse slice.
+ *  For repeated extractions of the same slice, a SlicePlan should be kept instead.
  *  \param mf is the source multifab containing the field data
  *  \param dom_geom is the geometry of the domain and used in the function to obtain the
  *  CellSize of the underlying grid.
@@ -64,60 +65,60 @@ std::unique_ptr<MultiFab>
 CreateSlice( const MultiFab& mf, const Vector<Geometry> &dom_geom,
              RealBox &slice_realbox, IntVect &slice_cr_ratio )
 {
-    std::unique_ptr<MultiFab> smf;
-    std::unique_ptr<MultiFab> cs_mf;
+    SlicePlan plan(mf, dom_geom, slice_realbox, slice_cr_ratio);
+    plan.Extract(mf);
+    return plan.releaseSlice();
+}
 
+SlicePlan::SlicePlan ( const MultiFab& mf, const Vector<Geometry> &dom_geom,
+                       RealBox &slice_realbox, IntVect &slice_cr_ratio )
+    : m_src_ba{mf.boxArray()}, m_src_dm{mf.DistributionMap()},
+      m_src_ixtype{mf.ixType()}, m_ncomp{mf.nComp()}, m_dom_geom{dom_geom},
+      m_slice_type(AMREX_D_DECL(0,0,0)),
+      m_slice_lo(AMREX_D_DECL(0,0,0)), m_slice_hi(AMREX_D_DECL(1,1,1)),
+      m_interp_lo(AMREX_D_DECL(0,0,0))
+{
     Vector<int> slice_ncells(AMREX_SPACEDIM);
     const int nghost = 1;
     auto nlevels = static_cast<int>(dom_geom.size());
-    const int ncomp = (mf).nComp();
 
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE( nlevels==1,
        "Slice diagnostics does not work with mesh refinement yet (TO DO).");
 
-    const auto conversionType = (mf).ixType();
-    IntVect SliceType(AMREX_D_DECL(0,0,0));
     for (int idim = 0; idim < AMREX_SPACEDIM; ++idim )
     {
-        SliceType[idim] = conversionType.nodeCentered(idim);
+        m_slice_type[idim] = m_src_ixtype.nodeCentered(idim);
     }
 
     const RealBox& real_box = dom_geom[0].ProbDomain();
-    RealBox slice_cc_nd_box;
     const int default_grid_size = 32;
     int slice_grid_size = default_grid_size;
 
-    bool interpolate = false;
-    bool coarsen = false;
-
     // same index space as domain //
-    IntVect slice_lo(AMREX_D_DECL(0,0,0));
-    IntVect slice_hi(AMREX_D_DECL(1,1,1));
-    IntVect interp_lo(AMREX_D_DECL(0,0,0));
-
-    CheckSliceInput(real_box, slice_cc_nd_box, slice_realbox, slice_cr_ratio,
-                    dom_geom, SliceType, slice_lo,
-                    slice_hi, interp_lo);
+    CheckSliceInput(real_box, m_slice_cc_nd_box, slice_realbox, slice_cr_ratio,
+                    dom_geom, m_slice_type, m_slice_lo,
+                    m_slice_hi, m_interp_lo);
+    m_slice_cr_ratio = slice_cr_ratio;
     int configuration_dim = 0;
     // Determine if interpolation is required and number of cells in slice //
     for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
 
         // Flag for interpolation if required //
-        if ( interp_lo[idim] == 1) {
-            interpolate = true;
+        if ( m_interp_lo[idim] == 1) {
+            m_interpolate = true;
         }
 
         // For the case when a dimension is reduced //
-        if ( ( slice_hi[idim] - slice_lo[idim]) == 1) {
+        if ( ( m_slice_hi[idim] - m_slice_lo[idim]) == 1) {
             slice_ncells[idim] = 1;
         }
         else {
-            slice_ncells[idim] = ( slice_hi[idim] - slice_lo[idim] + 1 )
-                                    / slice_cr_ratio[idim];
+            slice_ncells[idim] = ( m_slice_hi[idim] - m_slice_lo[idim] + 1 )
+                                    / m_slice_cr_ratio[idim];
 
-            const int refined_ncells = slice_hi[idim] - slice_lo[idim] + 1 ;
-            if ( slice_cr_ratio[idim] > 1) {
-                coarsen = true;
+            const int refined_ncells = m_slice_hi[idim] - m_slice_lo[idim] + 1 ;
+            if ( m_slice_cr_ratio[idim] > 1) {
+                m_coarsen = true;
 
                 // modify slice_grid_size if >= refines_cells //
                 if ( slice_grid_size >= refined_ncells ) {
@@ -134,47 +135,74 @@ CreateSlice( const MultiFab& mf, const Vector<Geometry> &dom_geom,
     }
 
     // Slice generation with index type inheritance //
-    const Box slice(slice_lo, slice_hi);
+    const Box slice(m_slice_lo, m_slice_hi);
 
-    Vector<BoxArray> sba(1);
-    sba[0].define(slice);
-    sba[0].maxSize(slice_grid_size);
+    BoxArray sba(slice);
+    sba.maxSize(slice_grid_size);
 
     // Distribution mapping for slice can be different from that of domain //
-    Vector<DistributionMapping> sdmap(1);
-    sdmap[0] = DistributionMapping{sba[0]};
+    const DistributionMapping sdmap{sba};
+
+    m_smf = std::make_unique<MultiFab>(amrex::convert(sba,m_slice_type), sdmap,
+                                       m_ncomp, nghost);
+
+    if (m_coarsen) {
+        BoxArray crse_ba = sba;
+        crse_ba.coarsen(m_slice_cr_ratio);
 
-    smf = std::make_unique<MultiFab>(amrex::convert(sba[0],SliceType), sdmap[0],
-                           ncomp, nghost);
+        AMREX_ALWAYS_ASSERT(crse_ba.size() == sba.size());
+
+        m_cs_mf = std::make_unique<MultiFab>(amrex::convert(crse_ba,m_slice_type),
+                                             sdmap, m_ncomp, nghost);
+    }
+}
+
+bool
+SlicePlan::isValidFor ( const MultiFab& mf ) const
+{
+    return m_smf && mf.boxArray() == m_src_ba && mf.DistributionMap() == m_src_dm &&
+        mf.ixType() == m_src_ixtype && mf.nComp() == m_ncomp;
+}
+
+std::unique_ptr<MultiFab>
+SlicePlan::releaseSlice ()
+{
+    std::unique_ptr<MultiFab> slice = m_coarsen ? std::move(m_cs_mf) : std::move(m_smf);
+    m_smf.reset();
+    m_cs_mf.reset();
+    return slice;
+}
+
+const MultiFab&
+SlicePlan::Extract ( const MultiFab& mf )
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE( isValidFor(mf),
+       "The slice plan was built for a MultiFab with a different layout.");
+
+    const int nghost = m_smf->nGrow();
+    const int ncomp = m_ncomp;
+    const RealBox& real_box = m_dom_geom[0].ProbDomain();
 
     // Copy data from domain to slice that has same cell size as that of //
     // the domain mf. src and dst have the same number of ghost cells    //
     const amrex::IntVect nghost_vect(AMREX_D_DECL(nghost, nghost, nghost));
-    ablastr::utils::communication::ParallelCopy(*smf, mf, 0, 0, ncomp, nghost_vect, nghost_vect, WarpX::do_single_precision_comms);
+    ablastr::utils::communication::ParallelCopy(*m_smf, mf, 0, 0, ncomp, nghost_vect, nghost_vect, WarpX::do_single_precision_comms);
 
     // interpolate if required on refined slice //
-    if (interpolate == 1 ) {
-       InterpolateSliceValues( *smf, interp_lo, slice_cc_nd_box, dom_geom,
-                               ncomp, nghost, slice_lo, slice_hi, SliceType, real_box);
+    if (m_interpolate) {
+       InterpolateSliceValues( *m_smf, m_interp_lo, m_slice_cc_nd_box, m_dom_geom,
+                               ncomp, nghost, m_slice_lo, m_slice_hi, m_slice_type, real_box);
     }
 
 
-    if (!coarsen) {
-       return smf;
+    if (!m_coarsen) {
+       return *m_smf;
     }
     else {
-        Vector<BoxArray> crse_ba(1);
-        crse_ba[0] = sba[0];
-        crse_ba[0].coarsen(slice_cr_ratio);
-
-        AMREX_ALWAYS_ASSERT(crse_ba[0].size() == sba[0].size());
-
-        cs_mf = std::make_unique<MultiFab>(amrex::convert(crse_ba[0],SliceType),
-                                           sdmap[0], ncomp,nghost);
-
-        const MultiFab& mfSrc = *smf;
-        MultiFab& mfDst = *cs_mf;
-
+        const IntVect SliceType = m_slice_type;
+        const IntVect slice_cr_ratio = m_slice_cr_ratio;
+        const MultiFab& mfSrc = *m_smf;
+        MultiFab& mfDst = *m_cs_mf;
         MFIter mfi_dst(mfDst);
         for (MFIter mfi(mfSrc); mfi.isValid(); ++mfi) {
 
@@ -226,7 +254,7 @@ CreateSlice( const MultiFab& mf, const Vector<Geometry> &dom_geom,
             }
 
         }
-        return cs_mf;
+        return *m_cs_mf;
     }
 }
 
@@ -38,7 +38,9 @@
 #include <AMReX_Vector.H>
 #include <AMReX_VisMF.H>
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <istream>
 #include <memory>
 #include <string>
@@ -53,13 +55,51 @@ namespace
 
 amrex::DistributionMapping
 WarpX::GetRestartDMap (const std::string& chkfile, const amrex::BoxArray& ba, int lev) const {
-    std::string DMFileName = chkfile;
-    if (!DMFileName.empty() && DMFileName[DMFileName.size()-1] != '/') {DMFileName += '/';}
-    DMFileName = amrex::Concatenate(DMFileName + "Level_", lev, 1);
-    DMFileName += "/DM";
+    std::string LevelDirName = chkfile;
+    if (!LevelDirName.empty() && LevelDirName[LevelDirName.size()-1] != '/') {LevelDirName += '/';}
+    LevelDirName = amrex::Concatenate(LevelDirName + "Level_", lev, 1);
+    const std::string DMFileName = LevelDirName + "/DM";
+
+    // When the distribution mapping of the checkpoint cannot be used (e.g. restart with a
+    // different number of ranks), distribute the boxes according to their costs (if they
+    // were saved in the checkpoint), so that each rank reads the data of the boxes it owns
+    const auto new_dmap = [&] () {
+        const std::string CostsFileName = LevelDirName + "/Costs";
+        if (!amrex::FileExists(CostsFileName)) {
+            return amrex::DistributionMapping{ba, ParallelDescriptor::NProcs()};
+        }
+
+        Vector<char> fileCharPtr;
+        ParallelDescriptor::ReadAndBcastFile(CostsFileName, fileCharPtr);
+        const std::string fileCharPtrString(fileCharPtr.dataPtr());
+        std::istringstream CostsFile(fileCharPtrString, std::istringstream::in);
+        if ( ! CostsFile.good()) { amrex::FileOpenFailed(CostsFileName); }
+        CostsFile.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+
+        int nboxes;
+        CostsFile >> nboxes;
+        if (nboxes != static_cast<int>(ba.size())) {
+            return amrex::DistributionMapping{ba, ParallelDescriptor::NProcs()};
+        }
+        amrex::Vector<amrex::Real> box_costs(nboxes);
+        for (auto& box_cost : box_costs) { CostsFile >> box_cost; }
+        if (std::all_of(box_costs.begin(), box_costs.end(),
+                        [] (amrex::Real box_cost) { return box_cost <= 0._rt; })) {
+            return amrex::DistributionMapping{ba, ParallelDescriptor::NProcs()};
+        }
+
+        amrex::Print() << Utils::TextMsg::Info(
+            "Distributing the boxes of level " + std::to_string(lev)
+            + " according to the costs saved in the checkpoint");
+        const int nmax = static_cast<int>(std::ceil(
+            nboxes/amrex::Real(ParallelDescriptor::NProcs())*load_balance_knapsack_factor));
+        return (load_balance_with_sfc)
+            ? amrex::DistributionMapping::makeSFC(box_costs, ba)
+            : amrex::DistributionMapping::makeKnapSack(box_costs, nmax);
+    };
 
     if (!amrex::FileExists(DMFileName)) {
-        return amrex::DistributionMapping{ba, ParallelDescriptor::NProcs()};
+        return new_dmap();
     }
 
     Vector<char> fileCharPtr;
@@ -72,13 +112,13 @@ WarpX::GetRestartDMap (const std::string& chkfile, const amrex::BoxArray& ba, in
     int nprocs_in_checkpoint;
     DMFile >> nprocs_in_checkpoint;
     if (nprocs_in_checkpoint != ParallelDescriptor::NProcs()) {
-        return amrex::DistributionMapping{ba, ParallelDescriptor::NProcs()};
+        return new_dmap();
     }
 
     amrex::DistributionMapping dm;
     dm.readFrom(DMFile);
     if (dm.size() != ba.size()) {
-        return amrex::DistributionMapping{ba, ParallelDescriptor::NProcs()};
+        return new_dmap();
     }
 
     return dm;
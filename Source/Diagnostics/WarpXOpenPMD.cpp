@@ -11,6 +11,7 @@
 #include "FieldIO.H"
 #include "Particles/Filter/FilterFunctors.H"
 #include "Particles/NamedComponentParticleContainer.H"
+#include "Particles/Pusher/GetAndSetPosition.H"
 #include "Utils/TextMsg.H"
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/RelativeCellPosition.H"
@@ -41,15 +42,19 @@
 #include <AMReX_StructOfArrays.H>
 
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <regex>
 #include <set>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace detail
@@ -368,6 +373,104 @@ namespace detail
                                   });
         }
     }
+
+    /** Append the lower and the upper bounds of the particle positions of a tile along each
+     *  written position component (see getParticlePositionComponentLabels) to lo and hi
+     */
+    template <typename PIter>
+    void
+    appendChunkBounds (PIter& pti, std::vector<double>& lo, std::vector<double>& hi)
+    {
+        constexpr auto max = std::numeric_limits<double>::max();
+        std::array<double, 3> plo = {max, max, max};
+        std::array<double, 3> phi = {-max, -max, -max};
+
+        const auto& ptd = pti.GetParticleTile().getConstParticleTileData();
+        for (int i = 0; i < pti.numParticles(); ++i) {
+            amrex::ParticleReal xp, yp, zp;
+            get_particle_position(ptd.getSuperParticle(i), xp, yp, zp);
+            const std::array<double, 3> pos = {xp, yp, zp};
+            for (int d = 0; d < 3; ++d) {
+                plo[d] = std::min(plo[d], pos[d]);
+                phi[d] = std::max(phi[d], pos[d]);
+            }
+        }
+#if defined(WARPX_DIM_1D_Z)
+        const std::vector<int> dims = {2};
+#elif defined(WARPX_DIM_XZ)
+        const std::vector<int> dims = {0, 2};
+#else
+        const std::vector<int> dims = {0, 1, 2};
+#endif
+        for (int const d : dims) {
+            lo.push_back(plo[d]);
+            hi.push_back(phi[d]);
+        }
+    }
+
+    /** Gather on all the ranks the index of the chunks of particles written by each rank,
+     *  and store it as attributes of the species
+     *
+     * @param[in,out] currSpecies species written to
+     * @param[in] chunk_offset,chunk_size offset in the records and number of particles of each local chunk
+     * @param[in] chunk_lo,chunk_hi bounds of the positions of each local chunk (see appendChunkBounds)
+     */
+    inline void
+    setChunkIndexAttributes (openPMD::ParticleSpecies& currSpecies,
+                             std::vector<unsigned long long> const& chunk_offset,
+                             std::vector<unsigned long long> const& chunk_size,
+                             std::vector<double> const& chunk_lo,
+                             std::vector<double> const& chunk_hi)
+    {
+        namespace pd = amrex::ParallelDescriptor;
+        const int root = pd::IOProcessorNumber();
+        const int nprocs = pd::NProcs();
+        const auto nlocal = static_cast<int>(chunk_offset.size());
+        const int ndims = nlocal > 0 ? static_cast<int>(chunk_lo.size())/nlocal : 0;
+#if defined(WARPX_DIM_1D_Z)
+        const std::vector<std::string> axis_labels = {"z"};
+#elif defined(WARPX_DIM_XZ)
+        const std::vector<std::string> axis_labels = {"x", "z"};
+#else
+        const std::vector<std::string> axis_labels = {"x", "y", "z"};
+#endif
+        const auto nd = static_cast<int>(axis_labels.size());
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(nlocal == 0 || ndims == nd,
+            "openPMD: inconsistent particle chunk index");
+
+        // Number of chunks of each rank
+        std::vector<int> counts(nprocs, 0);
+        pd::Gather(&nlocal, 1, counts.data(), 1, root);
+        pd::Bcast(counts.data(), counts.size(), root);
+        std::vector<int> disp(nprocs, 0);
+        for (int r = 1; r < nprocs; ++r) { disp[r] = disp[r-1] + counts[r-1]; }
+        const int ntotal = disp[nprocs-1] + counts[nprocs-1];
+        std::vector<int> counts_nd(nprocs), disp_nd(nprocs);
+        for (int r = 0; r < nprocs; ++r) {
+            counts_nd[r] = counts[r]*nd;
+            disp_nd[r] = disp[r]*nd;
+        }
+
+        std::vector<unsigned long long> all_offset(ntotal), all_size(ntotal);
+        std::vector<double> all_lo(ntotal*nd), all_hi(ntotal*nd);
+        pd::Gatherv(chunk_offset.data(), nlocal, all_offset.data(), counts, disp, root);
+        pd::Gatherv(chunk_size.data(), nlocal, all_size.data(), counts, disp, root);
+        pd::Gatherv(chunk_lo.data(), nlocal*nd, all_lo.data(), counts_nd, disp_nd, root);
+        pd::Gatherv(chunk_hi.data(), nlocal*nd, all_hi.data(), counts_nd, disp_nd, root);
+        pd::Bcast(all_offset.data(), all_offset.size(), root);
+        pd::Bcast(all_size.data(), all_size.size(), root);
+        pd::Bcast(all_lo.data(), all_lo.size(), root);
+        pd::Bcast(all_hi.data(), all_hi.size(), root);
+
+        if (ntotal == 0) { return; }
+
+        // The bounds of the chunk i along the axis d are at index i*nd + d
+        currSpecies.setAttribute("chunkOffset", all_offset);
+        currSpecies.setAttribute("chunkNumParticles", all_size);
+        currSpecies.setAttribute("chunkPositionLowerBound", all_lo);
+        currSpecies.setAttribute("chunkPositionUpperBound", all_hi);
+        currSpecies.setAttribute("chunkPositionAxisLabels", axis_labels);
+    }
 #endif // WARPX_USE_OPENPMD
 } // namespace detail
 
@@ -380,17 +483,27 @@ WarpXOpenPMDPlot::WarpXOpenPMDPlot (
     const std::string& engine_type,
     const std::map< std::string, std::string >& engine_parameters,
     const std::vector<bool>& fieldPMLdirections,
-    const std::string& authors)
+    const std::string& authors,
+    bool async_write,
+    bool fields_single_precision,
+    const std::map< std::string, std::pair< std::string, std::map< std::string, std::string > > >&
+        mesh_operators)
     : m_Series(nullptr),
       m_MPIRank{amrex::ParallelDescriptor::MyProc()},
       m_MPISize{amrex::ParallelDescriptor::NProcs()},
       m_Encoding(ie),
       m_OpenPMDFileType{openPMDFileType},
       m_fieldPMLdirections{fieldPMLdirections},
-      m_authors{authors}
+      m_authors{authors},
+      m_async_write{async_write},
+      m_fields_single_precision{fields_single_precision}
 {
     m_OpenPMDoptions = detail::getSeriesOptions(operator_type, operator_parameters,
                                                 engine_type, engine_parameters);
+    for (auto const& [record_name, mesh_operator] : mesh_operators) {
+        m_mesh_dataset_options[record_name] = detail::getSeriesOptions(
+            mesh_operator.first, mesh_operator.second, "", {});
+    }
 }
 
 WarpXOpenPMDPlot::~WarpXOpenPMDPlot ()
@@ -402,6 +515,16 @@ WarpXOpenPMDPlot::~WarpXOpenPMDPlot ()
   }
 }
 
+void
+WarpXOpenPMDPlot::FlushChunks ()
+{
+    if (m_async_write) {
+        m_Series->flush(R"({"adios2": {"engine": {"preferred_flush_target": "buffer"}}})");
+    } else {
+        m_Series->flush();
+    }
+}
+
 std::string
 WarpXOpenPMDPlot::GetFileName (std::string& filepath)
 {
@@ -574,15 +697,23 @@ for (unsigned i = 0, n = particle_diags.size(); i < n; ++i) {
     } else {
         particlesConvertUnits(ConvertDirection::WarpX_to_SI, pc, mass);
         using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
-        tmp.copyParticles(*pc,
-            [random_filter,uniform_filter,parser_filter,geometry_filter]
+        auto const filter = [random_filter,uniform_filter,parser_filter,geometry_filter]
             AMREX_GPU_HOST_DEVICE
             (const SrcData& src, int ip, const amrex::RandomEngine& engine)
             {
                 const SuperParticleType& p = src.getSuperParticle(ip);
                 return random_filter(p, engine) * uniform_filter(p, engine)
                         * parser_filter(p, engine) * geometry_filter(p, engine);
-            }, true);
+            };
+        if (particle_diags[i].doFilter()) {
+            // Select the particles in device memory first, so that the pinned memory
+            // and the copy to the host scale with the number of selected particles
+            auto selected = pc->make_alike();
+            selected.copyParticles(*pc, filter, true);
+            tmp.copyParticles(selected, true);
+        } else {
+            tmp.copyParticles(*pc, filter, true);
+        }
         particlesConvertUnits(ConvertDirection::SI_to_WarpX, pc, mass);
     }
 
@@ -591,6 +722,13 @@ for (unsigned i = 0, n = particle_diags.size(); i < n; ++i) {
         storePhiOnParticles( tmp, WarpX::electrostatic_solver_id, !use_pinned_pc );
     }
 
+    // Sort the particles of each tile by cell, so that the particles of a region are
+    // contiguous in the file (the BTD buffers are flushed in several parts and are not sorted)
+    const bool sort_by_cell = particle_diags[i].m_sort_by_cell && !isBTD;
+    if (sort_by_cell) {
+        tmp.SortParticlesByCell();
+    }
+
     // names of amrex::Real and int particle attributes in SoA data
     amrex::Vector<std::string> real_names;
     amrex::Vector<std::string> int_names;
@@ -640,7 +778,7 @@ for (unsigned i = 0, n = particle_diags.size(); i < n; ++i) {
         int_flags,
         real_names, int_names,
         pc->getCharge(), pc->getMass(),
-        isBTD, isLastBTDFlush);
+        isBTD, isLastBTDFlush, sort_by_cell);
     }
 }
 
@@ -655,7 +793,8 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
                     amrex::ParticleReal const charge,
                     amrex::ParticleReal const mass,
                     const bool isBTD,
-                    const bool isLastBTDFlush
+                    const bool isLastBTDFlush,
+                    const bool writeChunkIndex
 )
 {
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_Series != nullptr, "openPMD: series must be initialized");
@@ -717,10 +856,13 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
     }
 
     // open files from all processors, in case some will not contribute below
-    m_Series->flush();
+    FlushChunks();
 
     // dump individual particles
     bool contributed_particles = false;  // did the local MPI rank contribute particles?
+    // index of the chunks written by this rank: offset, size and bounds of the positions
+    std::vector<unsigned long long> chunk_offset, chunk_size;
+    std::vector<double> chunk_lo, chunk_hi;
     for (auto currentLevel = 0; currentLevel <= pc->finestLevel(); currentLevel++) {
         auto offset = static_cast<uint64_t>( counter.m_ParticleOffsetAtRank[currentLevel] );
         // For BTD, the offset include the number of particles already flushed
@@ -743,10 +885,20 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
                              write_real_comp, real_comp_names,
                              write_int_comp, int_comp_names);
 
+            if (writeChunkIndex) {
+                chunk_offset.push_back(offset);
+                chunk_size.push_back(numParticleOnTile64);
+                detail::appendChunkBounds(pti, chunk_lo, chunk_hi);
+            }
+
             offset += numParticleOnTile64;
         } // pti
     } // currentLevel
 
+    if (writeChunkIndex) {
+        detail::setChunkIndexAttributes(currSpecies, chunk_offset, chunk_size, chunk_lo, chunk_hi);
+    }
+
     // work-around for BTD particle resize in ADIOS2
     //
     // This issues an empty ADIOS2 Put to make sure the new global shape
@@ -797,7 +949,7 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
         }
     }
 
-    m_Series->flush();
+    FlushChunks();
 }
 
 void
@@ -1228,8 +1380,12 @@ WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
     const std::vector<std::string> axis_labels = detail::getFieldAxisLabels(var_in_theta_mode);
 
     // Prepare the type of dataset that will be written
-    openPMD::Datatype const datatype = openPMD::determineDatatype<amrex::Real>();
-    auto const dataset = openPMD::Dataset(datatype, global_size);
+    openPMD::Datatype const datatype = m_fields_single_precision ?
+        openPMD::determineDatatype<float>() : openPMD::determineDatatype<amrex::Real>();
+    auto const record_options = m_mesh_dataset_options.find(field_name);
+    auto const dataset = (record_options == m_mesh_dataset_options.end()) ?
+        openPMD::Dataset(datatype, global_size) :
+        openPMD::Dataset(datatype, global_size, record_options->second);
     mesh.setDataOrder(openPMD::Mesh::DataOrder::C);
     if (var_in_theta_mode) {
         mesh.setGeometry("thetaMode");
@@ -1443,6 +1599,28 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                     chunk_size.emplace(chunk_size.begin(), 1);
                 }
 
+                if (m_fields_single_precision && !std::is_same_v<amrex::Real, float>) {
+                    // Convert to single precision on the device (or on the host, on CPU),
+                    // directly into a pinned host buffer of the size of the converted chunk
+                    auto const npts = static_cast<std::size_t>(local_box.numPts());
+                    std::shared_ptr<float> data_float(
+                        static_cast<float*>(amrex::The_Pinned_Arena()->alloc(npts*sizeof(float))),
+                        [] (float* p) { amrex::The_Pinned_Arena()->free(p); });
+                    float* const AMREX_RESTRICT dst = data_float.get();
+                    amrex::Array4<amrex::Real const> const src = fab.const_array(icomp);
+                    amrex::Dim3 const lo = amrex::lbound(local_box);
+                    amrex::Dim3 const len = amrex::length(local_box);
+                    amrex::ParallelFor(local_box,
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                        {
+                            dst[(i-lo.x) + len.x*((j-lo.y) + len.y*(k-lo.z))] =
+                                static_cast<float>(src(i,j,k));
+                        });
+                    // intentionally delayed until before we .flush(): amrex::Gpu::streamSynchronize();
+                    mesh_comp.storeChunk(data_float, chunk_offset, chunk_size);
+                    continue;
+                }
+
                 // we avoid relying on managed memory by copying explicitly to host
                 //   remove the copies and "streamSynchronize" if you like to pass
                 //   GPU pointers to the I/O library
@@ -1466,8 +1644,8 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
 #ifdef AMREX_USE_GPU
         amrex::Gpu::streamSynchronize();
 #endif
-        // Flush data to disk after looping over all components
-        m_Series->flush();
+        // Flush data after looping over all components
+        FlushChunks();
     } // levels loop (i)
 }
 #endif // WARPX_USE_OPENPMD
@@ -11,6 +11,9 @@
 
 #include <ablastr/warn_manager/WarnManager.H>
 
+#include <AMReX_BaseFab.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_Reduce.H>
 #include <AMReX_Scan.H>
 #include <AMReX_iMultiFab.H>
 #include <AMReX_MultiFab.H>
@@ -224,7 +227,6 @@ WarpX::ComputeFaceExtensions(){
     );
 
     ComputeEightWaysExtensions();
-    ShrinkBorrowing();
 
     amrex::Array1D<int, 0, 2> N_ext_faces_after_eight_ways = CountExtFaces();
     ablastr::warn_manager::WMRecordWarning("Embedded Boundary",
@@ -275,46 +277,34 @@ WarpX::ComputeFaceExtensions(){
 
 void
 WarpX::InitBorrowing() {
-    int idim = 0;
-    for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
-        amrex::Box const &box = mfi.validbox();
-        auto &borrowing_x = (*m_borrowing[maxLevel()][idim])[mfi];
-        borrowing_x.inds_pointer.resize(box);
-        borrowing_x.size.resize(box);
-        borrowing_x.size.setVal<amrex::RunOn::Device>(0);
-        const amrex::Long ncells = box.numPts();
-        // inds, neigh_faces and area are extended to their largest possible size here, but they are
-        // resized to a much smaller size later on, based on the actual number of neighboring
-        // intruded faces for each unstable face.
-        borrowing_x.inds.resize(8*ncells);
-        borrowing_x.neigh_faces.resize(8*ncells);
-        borrowing_x.area.resize(8*ncells);
-    }
-
-    idim = 1;
-    for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
-        amrex::Box const &box = mfi.validbox();
-        auto &borrowing_y = (*m_borrowing[maxLevel()][idim])[mfi];
-        borrowing_y.inds_pointer.resize(box);
-        borrowing_y.size.resize(box);
-        borrowing_y.size.setVal<amrex::RunOn::Device>(0);
-        const amrex::Long ncells = box.numPts();
-        borrowing_y.inds.resize(8*ncells);
-        borrowing_y.neigh_faces.resize(8*ncells);
-        borrowing_y.area.resize(8*ncells);
-    }
-
-    idim = 2;
-    for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
-        amrex::Box const &box = mfi.validbox();
-        auto &borrowing_z = (*m_borrowing[maxLevel()][idim])[mfi];
-        borrowing_z.inds_pointer.resize(box);
-        borrowing_z.size.resize(box);
-        borrowing_z.size.setVal<amrex::RunOn::Device>(0);
-        const amrex::Long ncells = box.numPts();
-        borrowing_z.inds.resize(8*ncells);
-        borrowing_z.neigh_faces.resize(8*ncells);
-        borrowing_z.area.resize(8*ncells);
+    for (int idim = 0; idim < 3; ++idim) {
+        for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
+            amrex::Box const &box = mfi.validbox();
+            auto &borrowing = (*m_borrowing[maxLevel()][idim])[mfi];
+            borrowing.inds_pointer.resize(box);
+            borrowing.size.resize(box);
+            borrowing.size.setVal<amrex::RunOn::Device>(0);
+            borrowing.vecs_size = 0;
+
+            // A face that needs to be extended borrows area from at most 8 neighbors, either
+            // in the one-way or in the eight-ways extension. The memory is reserved here, so
+            // that the vectors can be resized to their exact size during the extensions
+            // without reallocation, which would invalidate inds_pointer.
+            auto const &flag_ext_face = m_flag_ext_face[maxLevel()][idim]->const_array(mfi);
+            amrex::ReduceOps<amrex::ReduceOpSum> reduce_ops;
+            amrex::ReduceData<int> reduce_data(reduce_ops);
+            reduce_ops.eval(box, reduce_data,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k) -> amrex::GpuTuple<int> {
+                    return flag_ext_face(i, j, k);
+                });
+            const int max_borrow = 8*amrex::get<0>(reduce_data.value());
+            borrowing.inds.clear();
+            borrowing.inds.reserve(max_borrow);
+            borrowing.neigh_faces.clear();
+            borrowing.neigh_faces.reserve(max_borrow);
+            borrowing.area.clear();
+            borrowing.area.reserve(max_borrow);
+        }
     }
 }
 
@@ -453,10 +443,6 @@ WarpX::ComputeOneWayExtensions() {
             auto const &borrowing_inds_pointer = borrowing.inds_pointer.array();
             auto const &borrowing_size = borrowing.size.array();
             amrex::Long ncells = box.numPts();
-            int* borrowing_inds = borrowing.inds.data();
-            FaceInfoBox::Neighbours* borrowing_neigh_faces = borrowing.neigh_faces.data();
-            amrex::Real* borrowing_area = borrowing.area.data();
-            int& vecs_size = borrowing.vecs_size;
 
             auto const &S_mod = m_area_mod[maxLevel()][idim]->array(mfi);
 
@@ -464,7 +450,11 @@ WarpX::ComputeOneWayExtensions() {
             const auto &ly = m_edge_lengths[maxLevel()][1]->array(mfi);
             const auto &lz = m_edge_lengths[maxLevel()][2]->array(mfi);
 
-            vecs_size = amrex::Scan::PrefixSum<int>(ncells,
+            // First pass: count the faces from which each face borrows area, and compute
+            // the offsets of the corresponding entries in the vectors of the FaceInfoBox
+            amrex::BaseFab<int> offsets(box, 1, amrex::The_Async_Arena());
+            auto const &borrowing_offsets = offsets.array();
+            const int n_borrow_box = amrex::Scan::PrefixSum<int>(ncells,
                                                     [=] AMREX_GPU_DEVICE (int icell) {
                 const amrex::Dim3 cell = box.atOffset(icell).dim3();
                 const int i = cell.x;
@@ -483,14 +473,25 @@ WarpX::ComputeOneWayExtensions() {
                                                    flag_ext_face, idim);
 
 
-              borrowing_size(i, j, k) = n_borrow;
+                borrowing_size(i, j, k) = n_borrow;
                 return n_borrow;
             },
                                                 [=] AMREX_GPU_DEVICE (int icell, int ps){
                 const amrex::Dim3 cell = box.atOffset(icell).dim3();
-                const int i = cell.x;
-                const int j = cell.y;
-                const int k = cell.z;
+                borrowing_offsets(cell.x, cell.y, cell.z) = ps;
+            }, amrex::Scan::Type::exclusive);
+
+            // Second pass: fill the entries, in vectors of the exact size
+            borrowing.vecs_size = n_borrow_box;
+            borrowing.inds.resize(borrowing.vecs_size);
+            borrowing.neigh_faces.resize(borrowing.vecs_size);
+            borrowing.area.resize(borrowing.vecs_size);
+            int* borrowing_inds = borrowing.inds.data();
+            FaceInfoBox::Neighbours* borrowing_neigh_faces = borrowing.neigh_faces.data();
+            amrex::Real* borrowing_area = borrowing.area.data();
+
+            amrex::ParallelFor(box, [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                const int ps = borrowing_offsets(i, j, k);
                 const int nborrow = borrowing_size(i, j, k);
                 if (nborrow == 0) {
                     borrowing_inds_pointer(i, j, k) = nullptr;
@@ -535,7 +536,7 @@ WarpX::ComputeOneWayExtensions() {
                         }
                     }
                 }
-            }, amrex::Scan::Type::exclusive);
+            });
         }
     }
 
@@ -575,17 +576,17 @@ WarpX::ComputeEightWaysExtensions() {
             auto const &borrowing_inds_pointer = borrowing.inds_pointer.array();
             auto const &borrowing_size = borrowing.size.array();
             amrex::Long ncells = box.numPts();
-            int* borrowing_inds = borrowing.inds.data();
-            FaceInfoBox::Neighbours* borrowing_neigh_faces = borrowing.neigh_faces.data();
-            amrex::Real* borrowing_area = borrowing.area.data();
-            int& vecs_size = borrowing.vecs_size;
 
             auto const &S_mod = m_area_mod[maxLevel()][idim]->array(mfi);
             const auto &lx = m_edge_lengths[maxLevel()][0]->array(mfi);
             const auto &ly = m_edge_lengths[maxLevel()][1]->array(mfi);
             const auto &lz = m_edge_lengths[maxLevel()][2]->array(mfi);
 
-            vecs_size += amrex::Scan::PrefixSum<int>(ncells,
+            // First pass: count the faces from which each face borrows area, and compute
+            // the offsets of the corresponding entries, after those of the one-way extensions
+            amrex::BaseFab<int> offsets(box, 1, amrex::The_Async_Arena());
+            auto const &borrowing_offsets = offsets.array();
+            const int n_borrow_box = amrex::Scan::PrefixSum<int>(ncells,
                                                      [=] AMREX_GPU_DEVICE (int icell){
                 const amrex::Dim3 cell = box.atOffset(icell).dim3();
                 const int i = cell.x;
@@ -601,17 +602,26 @@ WarpX::ComputeEightWaysExtensions() {
                 const int n_borrow = ComputeNBorrowEightFacesExtension(cell, S_ext, S_mod, S,
                                                                        flag_info_face, idim);
 
-              borrowing_size(i, j, k) = n_borrow;
+                borrowing_size(i, j, k) = n_borrow;
                 return n_borrow;
             },
             [=] AMREX_GPU_DEVICE (int icell, int ps) {
+                const amrex::Dim3 cell = box.atOffset(icell).dim3();
+                borrowing_offsets(cell.x, cell.y, cell.z) = ps;
+            }, amrex::Scan::Type::exclusive);
 
-                ps += vecs_size;
+            // Second pass: fill the entries, in vectors of the exact size
+            const int ps_start = borrowing.vecs_size;
+            borrowing.vecs_size += n_borrow_box;
+            borrowing.inds.resize(borrowing.vecs_size);
+            borrowing.neigh_faces.resize(borrowing.vecs_size);
+            borrowing.area.resize(borrowing.vecs_size);
+            int* borrowing_inds = borrowing.inds.data();
+            FaceInfoBox::Neighbours* borrowing_neigh_faces = borrowing.neigh_faces.data();
+            amrex::Real* borrowing_area = borrowing.area.data();
 
-                const amrex::Dim3 cell = box.atOffset(icell).dim3();
-                const int i = cell.x;
-                const int j = cell.y;
-                const int k = cell.z;
+            amrex::ParallelFor(box, [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                const int ps = ps_start + borrowing_offsets(i, j, k);
 
                 if (!flag_ext_face(i, j, k)) {
                     return;
@@ -695,7 +705,7 @@ WarpX::ComputeEightWaysExtensions() {
                         flag_ext_face(i, j, k) = false;
                     }
                 }
-            }, amrex::Scan::Type::exclusive);
+            });
         }
     }
 #endif
@@ -734,15 +744,3 @@ WarpX::ApplyBCKCorrection(const int idim) {
     amrex::ignore_unused(idim);
 #endif
 }
-
-void
-WarpX::ShrinkBorrowing() {
-    for(int idim = 0; idim < AMREX_SPACEDIM; idim++) {
-        for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
-            auto &borrowing = (*m_borrowing[maxLevel()][idim])[mfi];
-            borrowing.inds.resize(borrowing.vecs_size);
-            borrowing.neigh_faces.resize(borrowing.vecs_size);
-            borrowing.area.resize(borrowing.vecs_size);
-        }
-    }
-}
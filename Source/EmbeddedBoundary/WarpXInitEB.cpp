@@ -8,6 +8,7 @@
 #include "WarpX.H"
 
 #ifdef AMREX_USE_EB
+#  include "Utils/CounterBasedRandom.H"
 #  include "Utils/Parser/ParserUtils.H"
 #  include "Utils/TextMsg.H"
 
@@ -27,18 +28,29 @@
 #  include <AMReX_GpuDevice.H>
 #  include <AMReX_GpuQualifiers.H>
 #  include <AMReX_IntVect.H>
+#  include <AMReX_LayoutData.H>
 #  include <AMReX_Loop.H>
 #  include <AMReX_MFIter.H>
 #  include <AMReX_MultiFab.H>
 #  include <AMReX_iMultiFab.H>
+#  include <AMReX_ParallelDescriptor.H>
 #  include <AMReX_ParmParse.H>
 #  include <AMReX_Parser.H>
 #  include <AMReX_REAL.H>
 #  include <AMReX_SPACE.H>
+#  include <AMReX_Utility.H>
 #  include <AMReX_Vector.H>
+#  include <AMReX_VisMF.H>
 
+#  include <array>
 #  include <cstdlib>
+#  include <fstream>
+#  include <ios>
+#  include <memory>
+#  include <sstream>
 #  include <string>
+#  include <utility>
+#  include <vector>
 
 #endif
 
@@ -74,6 +86,70 @@ namespace {
     private:
         amrex::ParserExecutor<3> m_parser; //! function parser with three arguments (x,y,z)
     };
+
+    /** MultiFabs of the EB grid data stored in the EB cache, with their paths in an entry */
+    using EBCacheFields = amrex::Vector<std::pair<std::string, amrex::MultiFab*>>;
+
+    EBCacheFields EBGridDataCacheFields (
+        const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& distance_to_eb,
+        const amrex::Vector<std::array< std::unique_ptr<amrex::MultiFab>, 3 > >& edge_lengths,
+        const amrex::Vector<std::array< std::unique_ptr<amrex::MultiFab>, 3 > >& face_areas)
+    {
+        const std::string dims = "xyz";
+        EBCacheFields fields;
+        for (int lev = 0; lev < static_cast<int>(distance_to_eb.size()); ++lev) {
+            const std::string level_dir = "Level_" + std::to_string(lev) + "/";
+            fields.emplace_back(level_dir + "distance_to_eb", distance_to_eb[lev].get());
+            for (int idim = 0; idim < 3; ++idim) {
+                if (edge_lengths[lev][idim]) {
+                    fields.emplace_back(level_dir + "edge_lengths_" + dims[idim], edge_lengths[lev][idim].get());
+                }
+                if (face_areas[lev][idim]) {
+                    fields.emplace_back(level_dir + "face_areas_" + dims[idim], face_areas[lev][idim].get());
+                }
+            }
+        }
+        return fields;
+    }
+
+    /** Text that identifies the EB geometry (all the parameters that define it), the
+     *  grids and the layout of the EB grid data, used as the key of the EB cache */
+    std::string EBGridDataCacheKey (const WarpX& warpx, const EBCacheFields& fields)
+    {
+        std::ostringstream key;
+        key.precision(17);
+
+        const amrex::ParmParse pp_warpx("warpx");
+        std::string impf;
+        pp_warpx.query("eb_implicit_function", impf);
+        key << "warpx.eb_implicit_function = " << impf << "\n";
+        const amrex::ParmParse pp;
+        for (const auto& entry : amrex::ParmParse::getEntries("eb2")) {
+            std::vector<std::string> values;
+            pp.queryarr(entry.c_str(), values);
+            key << entry << " =";
+            for (const auto& value : values) { key << " " << value; }
+            key << "\n";
+        }
+        key << "electromagnetic_solver_id = " << WarpX::electromagnetic_solver_id << "\n";
+        for (int lev = 0; lev <= warpx.maxLevel(); ++lev) {
+            key << "Level " << lev << "\n"
+                << warpx.Geom(lev) << "\n"
+                << warpx.boxArray(lev) << "\n";
+        }
+        for (const auto& [name, mf] : fields) {
+            key << name << " " << mf->ixType() << " " << mf->nGrowVect() << "\n";
+        }
+        return key.str();
+    }
+
+    /** Directory of the entry of the EB cache with the given key */
+    std::string EBGridDataCacheEntry (const std::string& cache_dir, const std::string& key)
+    {
+        std::ostringstream entry;
+        entry << cache_dir << "/eb_" << std::hex << utils::random::hashString(key);
+        return entry.str();
+    }
 }
 #endif
 
@@ -86,6 +162,7 @@ WarpX::InitEB ()
     const amrex::ParmParse pp_warpx("warpx");
     std::string impf;
     pp_warpx.query("eb_implicit_function", impf);
+    pp_warpx.query("eb_cache_dir", m_eb_cache_dir);
     if (! impf.empty()) {
         auto eb_if_parser = utils::parser::makeParser(impf, {"x", "y", "z"});
         ParserIF pif(eb_if_parser.compile<3>());
@@ -408,3 +485,84 @@ WarpX::ComputeDistanceToEB () {
     }
 #endif
 }
+
+void
+WarpX::ComputeNearEBBoxes () {
+#ifdef AMREX_USE_EB
+    BL_PROFILE("ComputeNearEBBoxes");
+    for (int lev=0; lev<=maxLevel(); lev++) {
+        // The particles are scraped where the distance interpolated from the nodes is negative,
+        // which is impossible in a box where it is positive at all the nodes the particles read
+        for (amrex::MFIter mfi(*m_distance_to_eb[lev]); mfi.isValid(); ++mfi) {
+            const amrex::FArrayBox& phi = (*m_distance_to_eb[lev])[mfi];
+            (*m_near_eb_box[lev])[mfi] = phi.min<amrex::RunOn::Device>(phi.box(), 0) <= amrex::Real(0.0);
+        }
+    }
+#endif
+}
+
+#ifdef AMREX_USE_EB
+amrex::Vector<const amrex::LayoutData<int>*>
+WarpX::GetNearEBBoxes () const
+{
+    amrex::Vector<const amrex::LayoutData<int>*> near_eb_box;
+    for (const auto& flags : m_near_eb_box) { near_eb_box.push_back(flags.get()); }
+    return near_eb_box;
+}
+#endif
+
+bool
+WarpX::ReadEBGridDataCache ()
+{
+#ifdef AMREX_USE_EB
+    if (m_eb_cache_dir.empty()) { return false; }
+    BL_PROFILE("ReadEBGridDataCache");
+
+    // The key file is written last, so that an incomplete entry is never read.
+    // The whole key is compared, so that collisions of the hash are harmless.
+    const auto fields = EBGridDataCacheFields(m_distance_to_eb, m_edge_lengths, m_face_areas);
+    const std::string key = EBGridDataCacheKey(*this, fields);
+    const std::string entry = EBGridDataCacheEntry(m_eb_cache_dir, key);
+    if (!amrex::FileExists(entry + "/Key")) { return false; }
+    amrex::Vector<char> stored_key;
+    amrex::ParallelDescriptor::ReadAndBcastFile(entry + "/Key", stored_key);
+    if (std::string(stored_key.dataPtr()) != key) { return false; }
+
+    for (const auto& [name, mf] : fields) {
+        amrex::VisMF::Read(*mf, entry + "/" + name);
+    }
+    amrex::Print() << Utils::TextMsg::Info("Read the EB grid data from " + entry);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void
+WarpX::WriteEBGridDataCache () const
+{
+#ifdef AMREX_USE_EB
+    if (m_eb_cache_dir.empty()) { return; }
+    BL_PROFILE("WriteEBGridDataCache");
+
+    const auto fields = EBGridDataCacheFields(m_distance_to_eb, m_edge_lengths, m_face_areas);
+    const std::string key = EBGridDataCacheKey(*this, fields);
+    const std::string entry = EBGridDataCacheEntry(m_eb_cache_dir, key);
+    amrex::PreBuildDirectorHierarchy(entry, "Level_", maxLevel()+1, true);
+
+    for (const auto& [name, mf] : fields) {
+        amrex::VisMF::Write(*mf, entry + "/" + name);
+    }
+
+    // Write the key once all the data is on disk
+    amrex::ParallelDescriptor::Barrier();
+    if (amrex::ParallelDescriptor::IOProcessor()) {
+        std::ofstream key_file(entry + "/Key", std::ios::out | std::ios::trunc);
+        key_file << key;
+        key_file.flush();
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(key_file.good(),
+            "Could not write the key of the EB cache in " + entry);
+    }
+    amrex::ParallelDescriptor::Barrier();
+#endif
+}
@@ -22,12 +22,16 @@
 #       include "FieldSolver/SpectralSolver/SpectralSolver.H"
 #   endif
 #endif
+#include "Filter/NCIGodfreyFilter.H"
+#include "Parallelization/GridSizeAutotuner.H"
 #include "Parallelization/GuardCellManager.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Fluids/MultiFluidContainer.H"
 #include "Fluids/WarpXFluidContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
+#include "Particles/TileSizeAutotuner.H"
 #include "Python/callbacks.H"
+#include "Utils/PhaseTimers.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXUtil.H"
@@ -94,6 +98,15 @@ WarpX::Evolve (int numsteps)
 
         CheckLoadBalance(step);
 
+        // The best particle tile size depends on the grids
+        if (m_grid_size_autotuner->beginStep(*this, verbose)) {
+            m_tile_size_autotuner->restart();
+        }
+        const auto grid_time_beg_step = static_cast<Real>(amrex::second());
+
+        m_tile_size_autotuner->beginStep(*mypc, verbose);
+        const auto particle_time_beg_step = static_cast<Real>(amrex::second());
+
         if (evolve_scheme == EvolveScheme::Explicit)
         {
             ExplicitFillBoundaryEBUpdateAux();
@@ -150,10 +163,15 @@ WarpX::Evolve (int numsteps)
             // F: guard cells are NOT up-to-date
         }
         // Electromagnetic case: subcycling with one level of mesh refinement
-        else if (do_subcycling == 1 && finest_level == 1)
+        else if (do_subcycling == 1 && finest_level == 1 && refRatio(0) == IntVect(2))
         {
             OneStep_sub1(cur_time);
         }
+        // Electromagnetic case: subcycling with any number of levels and refinement ratios
+        else if (do_subcycling == 1)
+        {
+            OneStep_sub(cur_time);
+        }
         else
         {
             WARPX_ABORT_WITH_MESSAGE(
@@ -166,6 +184,8 @@ WarpX::Evolve (int numsteps)
         // value of step in code (first step is 0)
         mypc->doResampling(istep[0]+1, verbose);
 
+        m_tile_size_autotuner->endStep(static_cast<Real>(amrex::second()) - particle_time_beg_step);
+
         if (evolve_scheme == EvolveScheme::Explicit) {
             applyMirrors(cur_time);
             // E : guard cells are NOT up-to-date
@@ -208,7 +228,10 @@ WarpX::Evolve (int numsteps)
         for (int i = 0; i <= max_level; ++i) {
             t_new[i] = cur_time;
         }
-        multi_diags->FilterComputePackFlush( step, false, true );
+        {
+            const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::Diagnostics);
+            multi_diags->FilterComputePackFlush( step, false, true );
+        }
 
         const bool move_j = is_synchronized;
         // If is_synchronized we need to shift j too so that next step we can evolve E by dt/2.
@@ -261,14 +284,17 @@ WarpX::Evolve (int numsteps)
         // in the evolve timing.
         ExecutePythonCallback("afterstep");
 
-        /// reduced diags
-        if (reduced_diags->m_plot_rd != 0)
         {
-            reduced_diags->LoadBalance();
-            reduced_diags->ComputeDiags(step);
-            reduced_diags->WriteToFile(step);
+            const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::Diagnostics);
+            /// reduced diags
+            if (reduced_diags->m_plot_rd != 0)
+            {
+                reduced_diags->LoadBalance();
+                reduced_diags->ComputeDiags(step);
+                reduced_diags->WriteToFile(step);
+            }
+            multi_diags->FilterComputePackFlush( step );
         }
-        multi_diags->FilterComputePackFlush( step );
 
         // execute afterdiagnostic callbacks
         ExecutePythonCallback("afterdiagnostics");
@@ -282,6 +308,7 @@ WarpX::Evolve (int numsteps)
         // create ending time stamp for calculating elapsed time each iteration
         const auto evolve_time_end_step = static_cast<Real>(amrex::second());
         evolve_time += evolve_time_end_step - evolve_time_beg_step;
+        m_grid_size_autotuner->endStep(evolve_time_end_step - grid_time_beg_step);
 
         HandleSignals();
 
@@ -298,6 +325,8 @@ WarpX::Evolve (int numsteps)
         }
     } // End loop on time steps
 
+    reduced_diags->FlushWriteBuffers();
+
     // This if statement is needed for PICMI, which allows the Evolve routine to be
     // called multiple times, otherwise diagnostics will be done at every call,
     // regardless of the diagnostic period parameter provided in the inputs.
@@ -368,6 +397,8 @@ WarpX::OneStep_nosub (Real cur_time)
             FillBoundaryE(guard_cells.ng_afterPushPSATD, WarpX::sync_nodal_points);
         }
         else {
+            // With overlap_comm_compute, the exchanges of all fields are in flight together
+            m_defer_fill_boundary_finish = overlap_comm_compute;
             FillBoundaryE(guard_cells.ng_afterPushPSATD, WarpX::sync_nodal_points);
             FillBoundaryB(guard_cells.ng_afterPushPSATD, WarpX::sync_nodal_points);
             if (WarpX::do_dive_cleaning || WarpX::do_pml_dive_cleaning) {
@@ -376,37 +407,81 @@ WarpX::OneStep_nosub (Real cur_time)
             if (WarpX::do_divb_cleaning || WarpX::do_pml_divb_cleaning) {
                 FillBoundaryG(guard_cells.ng_alloc_G, WarpX::sync_nodal_points);
             }
+            m_defer_fill_boundary_finish = false;
+            FinishFillBoundary();
         }
     } else {
-        EvolveF(0.5_rt * dt[0], DtType::FirstHalf);
-        EvolveG(0.5_rt * dt[0], DtType::FirstHalf);
-        FillBoundaryF(guard_cells.ng_FieldSolverF);
-        FillBoundaryG(guard_cells.ng_FieldSolverG);
+        // Skip the boxes in and around which E, B and J vanish (the Python callbacks
+        // called between the pushes may modify the fields)
+        const bool skip_quiescent = skip_quiescent_boxes &&
+            !IsPythonCallbackInstalled("afterBpush") && !IsPythonCallbackInstalled("afterEpush");
+        if (skip_quiescent) {
+            UpdateQuiescentBoxes();
+            m_fdtd_solver_fp[0]->SetQuiescentBoxes(&m_quiescent_boxes);
+        }
 
-        EvolveB(0.5_rt * dt[0], DtType::FirstHalf); // We now have B^{n+1/2}
-        FillBoundaryB(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+        // With warpx.fdtd_fuse_divergence_cleaning, F is updated in the loops of the B pushes
+        // (both read E, which they do not modify) and G^{n+1} in the loop of the E push (both
+        // read B^{n+1/2}); the guard cells of F^{n+1/2} are then exchanged together with those of B
+        const bool fuse_cleaning = fdtd_fuse_divergence_cleaning &&
+            (do_dive_cleaning || do_divb_cleaning) && !fdtd_fused_leapfrog;
 
-        if (WarpX::em_solver_medium == MediumForEM::Vacuum) {
-            // vacuum medium
-            EvolveE(dt[0]); // We now have E^{n+1}
-        } else if (WarpX::em_solver_medium == MediumForEM::Macroscopic) {
-            // macroscopic medium
-            MacroscopicEvolveE(dt[0]); // We now have E^{n+1}
+        if (!fuse_cleaning) { EvolveF(0.5_rt * dt[0], DtType::FirstHalf); }
+        EvolveG(0.5_rt * dt[0], DtType::FirstHalf);
+        m_defer_fill_boundary_finish = overlap_comm_compute;
+        if (!fuse_cleaning) { FillBoundaryF(guard_cells.ng_FieldSolverF); }
+        FillBoundaryG(guard_cells.ng_FieldSolverG);
+        m_defer_fill_boundary_finish = false;
+        FinishFillBoundary();
+
+        if (fdtd_fused_leapfrog) {
+            // B^{n+1/2}, E^{n+1} and B^{n+1} in a single sweep
+            EvolveEBFused(dt[0]);
+        } else if (fuse_cleaning) {
+            m_fuse_divergence_cleaning = true;
+            EvolveB(0.5_rt * dt[0], DtType::FirstHalf); // We now have B^{n+1/2} and F^{n+1/2}
+            m_defer_fill_boundary_finish = overlap_comm_compute;
+            FillBoundaryB(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+            FillBoundaryF(guard_cells.ng_FieldSolverF);
+            m_defer_fill_boundary_finish = false;
+            FinishFillBoundary();
+
+            EvolveE(dt[0]); // We now have E^{n+1} and G^{n+1}
+            FillBoundaryE(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+
+            EvolveB(0.5_rt * dt[0], DtType::SecondHalf); // We now have B^{n+1} and F^{n+1}
+            m_fuse_divergence_cleaning = false;
         } else {
-            WARPX_ABORT_WITH_MESSAGE("Medium for EM is unknown");
+            EvolveB(0.5_rt * dt[0], DtType::FirstHalf); // We now have B^{n+1/2}
+            FillBoundaryB(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+
+            if (WarpX::em_solver_medium == MediumForEM::Vacuum) {
+                // vacuum medium
+                EvolveE(dt[0]); // We now have E^{n+1}
+            } else if (WarpX::em_solver_medium == MediumForEM::Macroscopic) {
+                // macroscopic medium
+                MacroscopicEvolveE(dt[0]); // We now have E^{n+1}
+            } else {
+                WARPX_ABORT_WITH_MESSAGE("Medium for EM is unknown");
+            }
+            FillBoundaryE(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+
+            EvolveF(0.5_rt * dt[0], DtType::SecondHalf);
+            EvolveG(0.5_rt * dt[0], DtType::SecondHalf);
+            EvolveB(0.5_rt * dt[0], DtType::SecondHalf); // We now have B^{n+1}
         }
-        FillBoundaryE(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
 
-        EvolveF(0.5_rt * dt[0], DtType::SecondHalf);
-        EvolveG(0.5_rt * dt[0], DtType::SecondHalf);
-        EvolveB(0.5_rt * dt[0], DtType::SecondHalf); // We now have B^{n+1}
+        if (skip_quiescent) { m_fdtd_solver_fp[0]->SetQuiescentBoxes(nullptr); }
 
         if (do_pml) {
             DampPML();
+            m_defer_fill_boundary_finish = overlap_comm_compute;
             FillBoundaryE(guard_cells.ng_MovingWindow, WarpX::sync_nodal_points);
             FillBoundaryB(guard_cells.ng_MovingWindow, WarpX::sync_nodal_points);
             FillBoundaryF(guard_cells.ng_MovingWindow, WarpX::sync_nodal_points);
             FillBoundaryG(guard_cells.ng_MovingWindow, WarpX::sync_nodal_points);
+            m_defer_fill_boundary_finish = false;
+            FinishFillBoundary();
         }
 
         // E and B are up-to-date in the domain, but all guard cells are
@@ -466,8 +541,15 @@ void WarpX::ExplicitFillBoundaryEBUpdateAux ()
         // E and B: enough guard cells to update Aux or call Field Gather in fp and cp
         // Need to update Aux on lower levels, to interpolate to higher levels.
 
-        // E and B are up-to-date inside the domain only
-        FillBoundaryE(guard_cells.ng_FieldGather);
+        // E and B are up-to-date inside the domain only.
+        // With gather_E_from_phi, the push gathers E from phi, and the guard cells of E
+        // are only needed by the field ionization and the QED processes.
+        bool gather_grid_E = !gather_E_from_phi;
+        for (int isp = 0; isp < mypc->nSpecies() && !gather_grid_E; ++isp) {
+            auto const& pc = mypc->GetParticleContainer(isp);
+            gather_grid_E = pc.DoFieldIonization() || pc.DoQED();
+        }
+        if (gather_grid_E) { FillBoundaryE(guard_cells.ng_FieldGather); }
         FillBoundaryB(guard_cells.ng_FieldGather);
         if (electrostatic_solver_id == ElectrostaticSolverAlgo::None) {
             if (fft_do_time_averaging)
@@ -520,7 +602,7 @@ void WarpX::HandleParticlesAtBoundaries (int step, amrex::Real cur_time, int num
 
     // interact the particles with EB walls (if present)
 #ifdef AMREX_USE_EB
-    mypc->ScrapeParticlesAtEB(amrex::GetVecOfConstPtrs(m_distance_to_eb));
+    mypc->ScrapeParticlesAtEB(amrex::GetVecOfConstPtrs(m_distance_to_eb), GetNearEBBoxes());
     m_particle_boundary_buffer->gatherParticlesFromEmbeddedBoundaries(*mypc, amrex::GetVecOfConstPtrs(m_distance_to_eb));
     mypc->deleteInvalidParticles();
 #endif
@@ -688,8 +770,6 @@ WarpX::OneStep_multiJ (const amrex::Real cur_time)
         // into 'current_fp' and then performs both filtering, if used, and exchange
         // of guard cells.
         SyncCurrent(current_fp, current_cp, current_buf);
-        // Forward FFT of J
-        PSATDForwardTransformJ(current_fp, current_cp);
 
         // Deposit new rho
         // (after checking that pointer to rho_fp on MR level 0 is not null)
@@ -702,11 +782,15 @@ WarpX::OneStep_multiJ (const amrex::Real cur_time)
             mypc->DepositCharge(rho_fp, t_deposit_charge);
             // Filter, exchange boundary, and interpolate across levels
             SyncRho(rho_fp, rho_cp, charge_buf);
-            // Forward FFT of rho
-            const int rho_idx = (rho_in_time == RhoInTime::Linear) ? rho_new : rho_mid;
-            PSATDForwardTransformRho(rho_fp, rho_cp, 0, rho_idx);
         }
 
+        // Forward FFT of J and rho, together when the batched FFTs are used
+        // (each push below uses the current of its own sub-interval, with the spectral
+        // coefficients of the solver computed for sub_dt: the depositions of the
+        // different sub-intervals cannot be summed and transformed only once)
+        const int rho_idx = (rho_in_time == RhoInTime::Linear) ? rho_new : rho_mid;
+        PSATDForwardTransformJRho(current_fp, current_cp, rho_fp, rho_cp, rho_idx);
+
         if (WarpX::current_correction)
         {
             WARPX_ABORT_WITH_MESSAGE(
@@ -944,6 +1028,203 @@ WarpX::OneStep_sub1 (Real cur_time)
     }
 }
 
+/* /brief Perform one PIC iteration, with subcycling
+*  for an arbitrary number of levels and refinement ratios
+*
+* Each level is advanced with its own time step (dt[lev] = dt[lev+1]*refRatio(lev)),
+* by the recursive function SubcyclingStep. This generalizes OneStep_sub1:
+* the particles of a level are pushed once per step of this level, while the
+* fields of its fine patch, and of the coarse patch of the next finer level, are
+* pushed in as many portions as there are steps of the next finer level, with the
+* current of the finer level at each of its steps.
+*/
+void
+WarpX::OneStep_sub (Real cur_time)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        electrostatic_solver_id == ElectrostaticSolverAlgo::None,
+        "Electrostatic solver cannot be used with sub-cycling."
+    );
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        !do_dive_cleaning,
+        "warpx.do_dive_cleaning with sub-cycling is only supported for two levels"
+        " with a refinement ratio of 2."
+    );
+    for (int lev = 0; lev < finest_level; ++lev) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            refRatio(lev) == IntVect(refRatio(lev)[0]),
+            "Sub-cycling requires the same refinement ratio in all directions."
+        );
+    }
+
+    SubcyclingStep(0, cur_time, DtType::Full);
+}
+
+/* /brief Advance the particles and fields of level lev and of all the finer
+*  levels by dt[lev]
+*
+* On the finest level, this is a regular PIC step. On a level with
+* refinement ratio r to the next finer level, the finer level is advanced
+* r times (recursively), and after each of its steps, the fields of the
+* fine patch of lev and of the coarse patch of lev+1 are advanced by dt[lev]/r,
+* with the current of lev (deposited once) plus the current of lev+1 at this step.
+* The auxiliary fields of the finer levels are then updated, with B interpolated
+* in time when the end of the portion is not the middle of the step of lev.
+*/
+void
+WarpX::SubcyclingStep (int lev, Real cur_time, DtType a_dt_type)
+{
+    if (lev == finest_level)
+    {
+        PushParticlesandDeposit(lev, cur_time, a_dt_type);
+        RestrictCurrentFromFineToCoarsePatch(current_fp, current_cp, lev);
+        if (use_filter) { ApplyFilterJ(current_fp, lev); }
+        SumBoundaryJ(current_fp, lev, Geom(lev).periodicity());
+
+        EvolveB(lev, PatchType::fine, 0.5_rt*dt[lev], DtType::FirstHalf);
+        FillBoundaryB(lev, PatchType::fine, guard_cells.ng_FieldSolver,
+                      WarpX::sync_nodal_points);
+
+        EvolveE(lev, PatchType::fine, dt[lev]);
+        FillBoundaryE(lev, PatchType::fine, guard_cells.ng_FieldGather);
+
+        EvolveB(lev, PatchType::fine, 0.5_rt*dt[lev], DtType::SecondHalf);
+
+        if (do_pml) {
+            DampPML(lev, PatchType::fine);
+            FillBoundaryE(lev, PatchType::fine, guard_cells.ng_FieldGather);
+        }
+
+        FillBoundaryB(lev, PatchType::fine, guard_cells.ng_FieldGather);
+        return;
+    }
+
+    const int fine_lev = lev + 1;
+    const int ratio = refRatio(lev)[0];
+
+    // B on the fine patch of lev and on the coarse patch of fine_lev:
+    // [0,3) fine patch of lev, [3,6) coarse patch of fine_lev
+    std::array<MultiFab*, 6> const Bfields = {
+        Bfield_fp[lev][0].get(), Bfield_fp[lev][1].get(), Bfield_fp[lev][2].get(),
+        Bfield_cp[fine_lev][0].get(), Bfield_cp[fine_lev][1].get(), Bfield_cp[fine_lev][2].get()};
+    // B at the beginning of the step, for the time interpolation (only needed when ratio > 2)
+    std::array<std::unique_ptr<MultiFab>, 6> B_start;
+    if (ratio > 2) {
+        for (int i = 0; i < 6; ++i) {
+            const MultiFab& B = *Bfields[i];
+            B_start[i] = std::make_unique<MultiFab>(B.boxArray(), B.DistributionMap(),
+                                                    B.nComp(), B.nGrowVect());
+            MultiFab::Copy(*B_start[i], B, 0, 0, B.nComp(), B.nGrowVect());
+        }
+    }
+
+    for (int k = 0; k < ratio; ++k)
+    {
+        // i) Advance the finer levels by dt[fine_lev]
+        SubcyclingStep(fine_lev, cur_time + k*dt[fine_lev],
+                       (k == ratio-1) ? DtType::SecondHalf : DtType::FirstHalf);
+
+        // ii) Current of lev: the particles of lev are pushed once, after the
+        // first step of fine_lev (as in OneStep_sub1), and their current is reused
+        if (k == 0) {
+            PushParticlesandDeposit(lev, cur_time, a_dt_type);
+            if (lev > 0) { RestrictCurrentFromFineToCoarsePatch(current_fp, current_cp, lev); }
+            StoreCurrent(lev);
+        } else {
+            for (int idim = 0; idim < 3; ++idim) {
+                MultiFab::Copy(*current_fp[lev][idim], *current_store[lev][idim], 0, 0,
+                               current_store[lev][idim]->nComp(),
+                               current_store[lev][idim]->nGrowVect());
+            }
+        }
+        // The coarse patch of lev is pushed once per step of lev, with the current of
+        // fine_lev averaged over its steps (this has to be done before
+        // AddCurrentFromFineLevelandSumBoundary, which modifies current_buf)
+        if (lev > 0) { AddRestrictedFineCurrentToCoarsePatch(lev, 1._rt/ratio); }
+        AddCurrentFromFineLevelandSumBoundary(current_fp, current_cp, current_buf, lev);
+
+        // iii) Advance the fields of the coarse patch of fine_lev and of the
+        // fine patch of lev by dt[lev]/ratio
+        if (k == 0) {
+            EvolveB(fine_lev, PatchType::coarse, 0.5_rt*dt[lev], DtType::FirstHalf);
+            FillBoundaryB(fine_lev, PatchType::coarse, guard_cells.ng_FieldGather);
+            EvolveB(lev, PatchType::fine, 0.5_rt*dt[lev], DtType::FirstHalf);
+            FillBoundaryB(lev, PatchType::fine, guard_cells.ng_FieldGather,
+                          WarpX::sync_nodal_points);
+        }
+
+        EvolveE(fine_lev, PatchType::coarse, dt[fine_lev]);
+        FillBoundaryE(fine_lev, PatchType::coarse, guard_cells.ng_FieldGather);
+        EvolveE(lev, PatchType::fine, dt[fine_lev]);
+        FillBoundaryE(lev, PatchType::fine, guard_cells.ng_FieldGather);
+
+        if (k == ratio-1) { break; }
+
+        // iv) Get the auxiliary fields of the finer levels at the beginning of
+        // the next step of fine_lev. B is known at the middle of the step of lev:
+        // it is interpolated linearly in time from the beginning of the step.
+        const Real theta = static_cast<Real>(k+1)/static_cast<Real>(ratio);
+        const bool interpolate_B = (2*(k+1) != ratio);
+        std::array<std::unique_ptr<MultiFab>, 6> B_mid;
+        if (interpolate_B) {
+            for (int i = 0; i < 6; ++i) {
+                MultiFab& B = *Bfields[i];
+                B_mid[i] = std::make_unique<MultiFab>(B.boxArray(), B.DistributionMap(),
+                                                      B.nComp(), B.nGrowVect());
+                MultiFab::Copy(*B_mid[i], B, 0, 0, B.nComp(), B.nGrowVect());
+                MultiFab::LinComb(B, 1._rt - 2._rt*theta, *B_start[i], 0,
+                                  2._rt*theta, *B_mid[i], 0, 0, B.nComp(), B.nGrowVect());
+            }
+        }
+
+        FillBoundaryAux(guard_cells.ng_UpdateAux);
+        UpdateAuxilaryData();
+        FillBoundaryAux(guard_cells.ng_UpdateAux);
+
+        if (interpolate_B) {
+            for (int i = 0; i < 6; ++i) {
+                MultiFab::Copy(*Bfields[i], *B_mid[i], 0, 0, B_mid[i]->nComp(),
+                               B_mid[i]->nGrowVect());
+            }
+        }
+    }
+
+    // v) Second half of the B push on the coarse patch of fine_lev and on the fine patch of lev
+    EvolveB(fine_lev, PatchType::coarse, 0.5_rt*dt[lev], DtType::SecondHalf);
+
+    if (do_pml) {
+        // The PML of the coarse patch is damped once per step of fine_lev
+        for (int k = 0; k < ratio; ++k) {
+            DampPML(fine_lev, PatchType::coarse);
+        }
+        FillBoundaryE(fine_lev, PatchType::coarse, guard_cells.ng_alloc_EB);
+    }
+
+    FillBoundaryB(fine_lev, PatchType::coarse, guard_cells.ng_FieldSolver,
+                  WarpX::sync_nodal_points);
+
+    EvolveB(lev, PatchType::fine, 0.5_rt*dt[lev], DtType::SecondHalf);
+
+    if (do_pml) {
+        if (lev == 0 && moving_window_active(istep[0]+1)){
+            // Exchange guard cells of PMLs only (0 cells are exchanged for the
+            // regular B field MultiFab). This is required as B has just been evolved.
+            FillBoundaryB(lev, PatchType::fine, IntVect::TheZeroVector(),
+                          WarpX::sync_nodal_points);
+        }
+        DampPML(lev, PatchType::fine);
+        if (lev > 0 || safe_guard_cells) {
+            FillBoundaryE(lev, PatchType::fine, guard_cells.ng_FieldGather,
+                          WarpX::sync_nodal_points);
+        }
+    }
+    // The guard cells of the finer levels are needed by the next step of the coarser level
+    if (lev > 0 || safe_guard_cells) {
+        FillBoundaryB(lev, PatchType::fine, guard_cells.ng_FieldGather,
+                      WarpX::sync_nodal_points);
+    }
+}
+
 void
 WarpX::doFieldIonization ()
 {
@@ -992,6 +1273,7 @@ void
 WarpX::PushParticlesandDeposit (int lev, amrex::Real cur_time, DtType a_dt_type, bool skip_current,
                                PushType push_type)
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::ParticlePush);
     amrex::MultiFab* current_x = nullptr;
     amrex::MultiFab* current_y = nullptr;
     amrex::MultiFab* current_z = nullptr;
@@ -1016,27 +1298,71 @@ WarpX::PushParticlesandDeposit (int lev, amrex::Real cur_time, DtType a_dt_type,
         current_z = current_fp[lev][2].get();
     }
 
+    // The last species deposits its current in a separate MultiFab, while the guard cells
+    // of the current of the other species are summed (see warpx.overlap_sum_boundary_J)
+    const int nspecies = mypc->nContainers();
+    const bool overlap_sum_boundary_J = m_overlap_sum_boundary_J && !skip_current &&
+        nspecies > 1 && !do_fluid_species && push_type == PushType::Explicit &&
+        a_dt_type == DtType::Full && !IsPythonCallbackInstalled("afterdeposition");
+
+    // Fields gathered by the particles, filtered once for all the species with the NCI corrector
+    std::array<const amrex::MultiFab*, 3> E_gather, B_gather, E_gather_cax, B_gather_cax;
+    for (int idim = 0; idim < 3; ++idim) {
+        E_gather[idim] = Efield_aux[lev][idim].get();
+        B_gather[idim] = Bfield_aux[lev][idim].get();
+        E_gather_cax[idim] = Efield_cax[lev][idim].get();
+        B_gather_cax[idim] = Bfield_cax[lev][idim].get();
+    }
+    if (WarpX::use_fdtd_nci_corr) {
+        ApplyNCIFilterToGatherFields(lev, E_gather, B_gather, E_gather_cax, B_gather_cax);
+    }
+
     mypc->Evolve(lev,
-                 *Efield_aux[lev][0], *Efield_aux[lev][1], *Efield_aux[lev][2],
-                 *Bfield_aux[lev][0], *Bfield_aux[lev][1], *Bfield_aux[lev][2],
+                 *E_gather[0], *E_gather[1], *E_gather[2],
+                 *B_gather[0], *B_gather[1], *B_gather[2],
                  *current_x, *current_y, *current_z,
                  current_buf[lev][0].get(), current_buf[lev][1].get(), current_buf[lev][2].get(),
                  rho_fp[lev].get(), charge_buf[lev].get(),
-                 Efield_cax[lev][0].get(), Efield_cax[lev][1].get(), Efield_cax[lev][2].get(),
-                 Bfield_cax[lev][0].get(), Bfield_cax[lev][1].get(), Bfield_cax[lev][2].get(),
-                 cur_time, dt[lev], a_dt_type, skip_current, push_type);
+                 E_gather_cax[0], E_gather_cax[1], E_gather_cax[2],
+                 B_gather_cax[0], B_gather_cax[1], B_gather_cax[2],
+                 cur_time, dt[lev], a_dt_type, skip_current, push_type,
+                 0, overlap_sum_boundary_J ? nspecies-1 : nspecies);
+
+    if (overlap_sum_boundary_J) {
+        StartSumBoundaryJ(lev);
+        for (int idim = 0; idim < 3; ++idim) {
+            const amrex::MultiFab& J = *current_fp[lev][idim];
+            auto& J_last = m_current_fp_last_species[idim];
+            if (!J_last || J_last->boxArray() != J.boxArray() ||
+                J_last->DistributionMap() != J.DistributionMap()) {
+                J_last = std::make_unique<amrex::MultiFab>(
+                    J.boxArray(), J.DistributionMap(), J.nComp(), J.nGrowVect());
+            }
+            J_last->setVal(0.0);
+        }
+        mypc->Evolve(lev,
+                     *E_gather[0], *E_gather[1], *E_gather[2],
+                     *B_gather[0], *B_gather[1], *B_gather[2],
+                     *m_current_fp_last_species[0], *m_current_fp_last_species[1],
+                     *m_current_fp_last_species[2],
+                     current_buf[lev][0].get(), current_buf[lev][1].get(), current_buf[lev][2].get(),
+                     rho_fp[lev].get(), charge_buf[lev].get(),
+                     E_gather_cax[0], E_gather_cax[1], E_gather_cax[2],
+                     B_gather_cax[0], B_gather_cax[1], B_gather_cax[2],
+                     cur_time, dt[lev], a_dt_type, skip_current, push_type, nspecies-1, nspecies);
+    }
     if (! skip_current) {
 #ifdef WARPX_DIM_RZ
         // This is called after all particles have deposited their current and charge.
-        ApplyInverseVolumeScalingToCurrentDensity(current_fp[lev][0].get(), current_fp[lev][1].get(), current_fp[lev][2].get(), lev);
-        if (current_buf[lev][0].get()) {
-            ApplyInverseVolumeScalingToCurrentDensity(current_buf[lev][0].get(), current_buf[lev][1].get(), current_buf[lev][2].get(), lev-1);
-        }
-        if (rho_fp[lev]) {
-            ApplyInverseVolumeScalingToChargeDensity(rho_fp[lev].get(), lev);
-            if (charge_buf[lev]) {
-                ApplyInverseVolumeScalingToChargeDensity(charge_buf[lev].get(), lev-1);
-            }
+        // The current and charge densities of the same grids are scaled together.
+        ApplyInverseVolumeScalingToCurrentAndChargeDensity(
+            current_fp[lev][0].get(), current_fp[lev][1].get(), current_fp[lev][2].get(),
+            rho_fp[lev].get(), lev);
+        amrex::MultiFab* const rho_buf = rho_fp[lev] ? charge_buf[lev].get() : nullptr;
+        if (current_buf[lev][0] || rho_buf) {
+            ApplyInverseVolumeScalingToCurrentAndChargeDensity(
+                current_buf[lev][0].get(), current_buf[lev][1].get(), current_buf[lev][2].get(),
+                rho_buf, lev-1);
         }
 // #else
         // I left this comment here as a reminder that currently the
@@ -1060,6 +1386,55 @@ WarpX::PushParticlesandDeposit (int lev, amrex::Real cur_time, DtType a_dt_type,
  * (as for a perfect conductor with a given thickness).
  * The mirror normal direction has to be parallel to the z axis.
  */
+
+void
+WarpX::ApplyNCIFilterToGatherFields (int lev,
+    std::array<const amrex::MultiFab*, 3>& E, std::array<const amrex::MultiFab*, 3>& B,
+    std::array<const amrex::MultiFab*, 3>& cE, std::array<const amrex::MultiFab*, 3>& cB)
+{
+    WARPX_PROFILE("WarpX::ApplyNCIFilterToGatherFields()");
+
+    // Ex, Ey and Bz are filtered with the stencil of Ex, Ey and Bz, and Bx, By and Ez
+    // with the stencil of Bx, By and Ez. In 1D and 2D, Ey, Bx and Bz are not filtered.
+#if defined(WARPX_DIM_3D)
+    const std::array<bool, 3> filter_E = {true, true, true};
+    const std::array<bool, 3> filter_B = {true, true, true};
+#else
+    const std::array<bool, 3> filter_E = {true, false, true};
+    const std::array<bool, 3> filter_B = {false, true, false};
+#endif
+
+    const auto apply_filter = [lev] (NCIGodfreyFilter& filter, const amrex::MultiFab& src,
+                                     std::unique_ptr<amrex::MultiFab>& dst)
+    {
+        if (!dst || dst->boxArray() != src.boxArray() ||
+            dst->DistributionMap() != src.DistributionMap()) {
+            dst = std::make_unique<amrex::MultiFab>(
+                src.boxArray(), src.DistributionMap(), src.nComp(), src.nGrowVect());
+        }
+        filter.ApplyStencil(*dst, src, lev);
+        return static_cast<const amrex::MultiFab*>(dst.get());
+    };
+
+    for (int idim = 0; idim < 3; ++idim) {
+        auto& filter_E_lev = (idim == 2) ? nci_godfrey_filter_bxbyez : nci_godfrey_filter_exeybz;
+        auto& filter_B_lev = (idim == 2) ? nci_godfrey_filter_exeybz : nci_godfrey_filter_bxbyez;
+        if (filter_E[idim]) {
+            E[idim] = apply_filter(*filter_E_lev[lev], *E[idim], Efield_aux_nci[lev][idim]);
+        }
+        if (filter_B[idim]) {
+            B[idim] = apply_filter(*filter_B_lev[lev], *B[idim], Bfield_aux_nci[lev][idim]);
+        }
+        // The gather buffers contain fields of the coarser level
+        if (lev > 0 && cE[idim] && filter_E[idim]) {
+            cE[idim] = apply_filter(*filter_E_lev[lev-1], *cE[idim], Efield_cax_nci[lev][idim]);
+        }
+        if (lev > 0 && cB[idim] && filter_B[idim]) {
+            cB[idim] = apply_filter(*filter_B_lev[lev-1], *cB[idim], Bfield_cax_nci[lev][idim]);
+        }
+    }
+}
+
 void
 WarpX::applyMirrors (Real time)
 {
@@ -1143,6 +1518,7 @@ WarpX::HandleSignals()
     // SIGNAL_REQUESTS_BREAK is handled directly in WarpX::Evolve
 
     if (SignalHandling::TestAndResetActionRequestFlag(SignalHandling::SIGNAL_REQUESTS_CHECKPOINT)) {
+        reduced_diags->FlushWriteBuffers();
         multi_diags->FilterComputePackFlushLastTimestep( istep[0] );
         ExecutePythonCallback("oncheckpointsignal");
     }
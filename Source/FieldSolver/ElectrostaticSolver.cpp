@@ -46,12 +46,18 @@
 #include <AMReX_SPACE.H>
 #include <AMReX_Vector.H>
 #include <AMReX_MFInterp_C.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Scan.H>
 #ifdef AMREX_USE_EB
 #   include <AMReX_EBFabFactory.H>
 #endif
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <iterator>
 #include <memory>
+#include <numeric>
 #include <string>
 
 using namespace amrex;
@@ -77,17 +83,45 @@ WarpX::ComputeSpaceChargeField (bool const reset_fields)
         AddSpaceChargeFieldLabFrame();
     }
     else {
-        // Loop over the species and add their space-charge contribution to E and B.
+        // Group the species by mean velocity: since the Poisson equation is linear,
+        // the charge of all the species of a group can be deposited together and
+        // their space-charge fields obtained with a single solve.
         // Note that the fields calculated here does not include the E field
         // due to simulation boundary potentials
+        amrex::Vector<amrex::Vector<WarpXParticleContainer*>> groups;
+        amrex::Vector<std::array<Real, 3>> group_beta;
         for (int ispecies=0; ispecies<mypc->nSpecies(); ispecies++){
             WarpXParticleContainer& species = mypc->GetParticleContainer(ispecies);
-            if (species.initialize_self_fields ||
-                (electrostatic_solver_id == ElectrostaticSolverAlgo::Relativistic)) {
-                AddSpaceChargeField(species);
+            if ((species.initialize_self_fields ||
+                 (electrostatic_solver_id == ElectrostaticSolverAlgo::Relativistic)) &&
+                species.getCharge() != 0) {
+                // Get the particle beta vector
+                bool const local_average = false; // Average across all MPI ranks
+                std::array<ParticleReal, 3> const beta_pr = species.meanParticleVelocity(local_average);
+                std::array<Real, 3> beta;
+                for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
+                    beta[i] = beta_pr[i]/PhysConst::c; // Normalize
+                }
+                auto const same_beta = [&] (std::array<Real, 3> const& b) {
+                    return std::abs(b[0]-beta[0]) <= self_fields_beta_tolerance &&
+                           std::abs(b[1]-beta[1]) <= self_fields_beta_tolerance &&
+                           std::abs(b[2]-beta[2]) <= self_fields_beta_tolerance;
+                };
+                auto const it = std::find_if(group_beta.begin(), group_beta.end(), same_beta);
+                if (it == group_beta.end()) {
+                    groups.push_back({&species});
+                    group_beta.push_back(beta);
+                } else {
+                    groups[std::distance(group_beta.begin(), it)].push_back(&species);
+                }
             }
         }
 
+        // Add the space-charge contribution of each group to E and B
+        for (int igroup=0; igroup<static_cast<int>(groups.size()); igroup++){
+            AddSpaceChargeField(groups[igroup], group_beta[igroup]);
+        }
+
         // Add the field due to the boundary potentials
         if (m_boundary_potential_specified ||
                 (electrostatic_solver_id == ElectrostaticSolverAlgo::Relativistic)){
@@ -143,14 +177,11 @@ WarpX::AddBoundaryField ()
 }
 
 void
-WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
+WarpX::AddSpaceChargeField (const amrex::Vector<WarpXParticleContainer*>& species,
+                            std::array<amrex::Real, 3> const& beta)
 {
     WARPX_PROFILE("WarpX::AddSpaceChargeField");
 
-    if (pc.getCharge() == 0) {
-        return;
-    }
-
     // Store the boundary conditions for the field solver if they haven't been
     // stored yet
     if (!m_poisson_boundary_handler.bcs_set) {
@@ -191,9 +222,11 @@ WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
     bool const reset = false;
     bool const apply_boundary_and_scale_volume = true;
     bool const interpolate_across_levels = false;
-    if ( !pc.do_not_deposit) {
-        pc.DepositCharge(rho, local, reset, apply_boundary_and_scale_volume,
+    for (auto* pc : species) {
+        if ( !pc->do_not_deposit) {
+            pc->DepositCharge(rho, local, reset, apply_boundary_and_scale_volume,
                               interpolate_across_levels);
+        }
     }
     for (int lev = 0; lev <= max_level; lev++) {
         if (lev > 0) {
@@ -204,18 +237,21 @@ WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
     }
     SyncRho(rho, rho_coarse, charge_buf); // Apply filter, perform MPI exchange, interpolate across levels
 
-    // Get the particle beta vector
-    bool const local_average = false; // Average across all MPI ranks
-    std::array<ParticleReal, 3> beta_pr = pc.meanParticleVelocity(local_average);
-    std::array<Real, 3> beta;
-    for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
-        beta[i] = beta_pr[i]/PhysConst::c; // Normalize
+    // The solve uses the most stringent solver parameters of the species of the group
+    Real required_precision = species[0]->self_fields_required_precision;
+    Real absolute_tolerance = species[0]->self_fields_absolute_tolerance;
+    int max_iters = species[0]->self_fields_max_iters;
+    int verbosity = species[0]->self_fields_verbosity;
+    for (auto const* pc : species) {
+        required_precision = std::min(required_precision, pc->self_fields_required_precision);
+        absolute_tolerance = std::min(absolute_tolerance, pc->self_fields_absolute_tolerance);
+        max_iters = std::max(max_iters, pc->self_fields_max_iters);
+        verbosity = std::max(verbosity, pc->self_fields_verbosity);
     }
 
     // Compute the potential phi, by solving the Poisson equation
-    computePhi( rho, phi, beta, pc.self_fields_required_precision,
-                pc.self_fields_absolute_tolerance, pc.self_fields_max_iters,
-                pc.self_fields_verbosity );
+    computePhi( rho, phi, beta, required_precision, absolute_tolerance,
+                max_iters, verbosity );
 
     // Compute the corresponding electric and magnetic field, from the potential phi
     computeE( Efield_fp, phi, beta );
@@ -264,6 +300,14 @@ WarpX::AddSpaceChargeFieldLabFrame ()
     // Todo: use simpler finite difference form with beta=0
     const std::array<Real, 3> beta = {0._rt};
 
+    // phi_fp still holds the solution of the previous step, which is the
+    // initial guess of the MLMG solver; optionally extrapolate it in time
+    if (self_fields_extrapolate_guess &&
+        poisson_solver_id == PoissonSolverAlgo::Multigrid &&
+        !IsPythonCallbackInstalled("poissonsolver")) {
+        ExtrapolatePhiInitialGuess();
+    }
+
     // set the boundary potentials appropriately
     setPhiBC(phi_fp);
 
@@ -295,6 +339,13 @@ WarpX::AddSpaceChargeFieldLabFrame ()
     if ( IsPythonCallbackInstalled("poissonsolver") ) computeE( Efield_fp, phi_fp, beta );
 #endif
 
+    // The particles gather the gradient of phi, in the guard cells too
+    if (gather_E_from_phi) {
+        for (int lev = 0; lev <= max_level; lev++) {
+            phi_fp[lev]->FillBoundary(Geom(lev).periodicity());
+        }
+    }
+
     // Compute the magnetic field
     computeB( Bfield_fp, phi_fp, beta );
 }
@@ -323,7 +374,7 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
                    Real const required_precision,
                    Real absolute_tolerance,
                    int const max_iters,
-                   int const verbosity) const
+                   int const verbosity)
 {
     // create a vector to our fields, sorted by level
     amrex::Vector<amrex::MultiFab*> sorted_rho;
@@ -384,6 +435,8 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
 
     bool const is_solver_igf_on_lev0 =
         WarpX::poisson_solver_id == PoissonSolverAlgo::IntegratedGreenFunction;
+    bool const is_solver_spectral_on_lev0 =
+        WarpX::poisson_solver_id == PoissonSolverAlgo::Spectral;
 
     ablastr::fields::computePhi(
         sorted_rho,
@@ -402,11 +455,37 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
         this->ref_ratio,
         post_phi_calculation,
         gett_new(0),
-        eb_farray_box_factory
+        eb_farray_box_factory,
+        m_poisson_solver_cache.get(),
+        WarpX::igf_distributed_fft,
+        is_solver_spectral_on_lev0
     );
 
 }
 
+void
+WarpX::ExtrapolatePhiInitialGuess ()
+{
+    WARPX_PROFILE("WarpX::ExtrapolatePhiInitialGuess");
+
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        amrex::MultiFab& phi = *phi_fp[lev];
+        if (!m_phi_fp_previous[lev]) {
+            // No history yet (first solve or after a regrid): keep phi^n as the guess
+            m_phi_fp_previous[lev] = std::make_unique<amrex::MultiFab>(
+                phi.boxArray(), phi.DistributionMap(), phi.nComp(), phi.nGrowVect());
+            amrex::MultiFab::Copy(*m_phi_fp_previous[lev], phi, 0, 0, phi.nComp(), phi.nGrowVect());
+            continue;
+        }
+        amrex::MultiFab& phi_previous = *m_phi_fp_previous[lev];
+        // phi_previous <- 2 phi^n - phi^{n-1}, then swap so that phi_fp holds the
+        // extrapolated guess and phi_previous holds phi^n
+        amrex::MultiFab::LinComb(phi_previous, 2._rt, phi, 0, -1._rt, phi_previous, 0,
+                                 0, phi.nComp(), phi.nGrowVect());
+        amrex::MultiFab::Swap(phi, phi_previous, 0, 0, phi.nComp(), phi.nGrowVect());
+    }
+}
+
 
 /* \brief Set Dirichlet boundary conditions for the electrostatic solver.
 
@@ -838,9 +917,102 @@ WarpX::computeB (amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>, 3> >
     }
 }
 
+namespace
+{
+    /* \brief Box of the nodes of the box ibox of the 1D nodal BoxArray ba that are owned by it:
+     * a node shared by two boxes is owned by the box on its right, except at the
+     * upper end of the domain.
+     */
+    amrex::Box OwnedNodes1D (amrex::BoxArray const& ba, int ibox, amrex::Box const& domain)
+    {
+        amrex::Box b = ba[ibox];
+        if (b.bigEnd(0) < domain.bigEnd(0)) { b.growHi(0, -1); }
+        return b;
+    }
+
+    /* \brief Values of the MultiFabs mfs[n] at the nodes inodes[n], on all processes */
+    amrex::Vector<amrex::Real> GetNodeValues1D (amrex::Vector<amrex::MultiFab const*> const& mfs,
+                                                amrex::Vector<int> const& inodes,
+                                                amrex::Box const& domain)
+    {
+        amrex::Vector<amrex::Real> values(mfs.size(), 0._rt);
+        for (int n = 0; n < static_cast<int>(mfs.size()); ++n) {
+            for (amrex::MFIter mfi(*mfs[n]); mfi.isValid(); ++mfi) {
+                const amrex::IntVect iv(AMREX_D_DECL(inodes[n],0,0));
+                if (OwnedNodes1D(mfs[n]->boxArray(), mfi.index(), domain).contains(iv)) {
+                    amrex::Gpu::dtoh_memcpy(&values[n], (*mfs[n])[mfi].dataPtr() +
+                        (*mfs[n])[mfi].box().index(iv), sizeof(amrex::Real));
+                }
+            }
+        }
+        amrex::ParallelDescriptor::ReduceRealSum(values.data(), static_cast<int>(values.size()));
+        return values;
+    }
+
+    /* \brief In-place prefix sum along x of a 1D nodal MultiFab, over the whole domain.
+     * Each box scans the nodes it owns (see OwnedNodes1D), and the sums of the boxes on
+     * its left are then added, so that the data is never gathered on one process.
+     */
+    void PrefixSum1D (amrex::MultiFab& mf, amrex::Box const& domain, amrex::Scan::Type type)
+    {
+        amrex::BoxArray const& ba = mf.boxArray();
+        const int nboxes = static_cast<int>(ba.size());
+        const bool inclusive = (type == amrex::Scan::Type::inclusive);
+
+        // Local scans, saving the sum of each box
+        amrex::Vector<amrex::Real> totals(nboxes, 0._rt);
+        for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            const amrex::Box owned = OwnedNodes1D(ba, mfi.index(), domain);
+            const int lo = owned.smallEnd(0);
+            amrex::Array4<amrex::Real> const& arr = mf.array(mfi);
+            totals[mfi.index()] = amrex::Scan::PrefixSum<amrex::Real>(
+                static_cast<int>(owned.numPts()),
+                [=] AMREX_GPU_DEVICE (int m) -> amrex::Real { return arr(lo+m,0,0); },
+                [=] AMREX_GPU_DEVICE (int m, amrex::Real const& sum) { arr(lo+m,0,0) = sum; },
+                type, amrex::Scan::retSum);
+        }
+        amrex::ParallelDescriptor::ReduceRealSum(totals.data(), nboxes);
+
+        // Offset of each box, i.e. sum of the boxes on its left
+        amrex::Vector<int> order(nboxes);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+            [&] (int a, int b) { return ba[a].smallEnd(0) < ba[b].smallEnd(0); });
+        amrex::Vector<amrex::Real> offsets(nboxes);
+        amrex::Real sum = 0._rt;
+        for (const int ibox : order) {
+            offsets[ibox] = sum;
+            sum += totals[ibox];
+        }
+
+        // Add the offsets, and set the node shared with the box on the right
+        for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            const int hi_owned = OwnedNodes1D(ba, mfi.index(), domain).bigEnd(0);
+            const amrex::Real offset = offsets[mfi.index()];
+            const amrex::Real total = totals[mfi.index()];
+            amrex::Array4<amrex::Real> const& arr = mf.array(mfi);
+            amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                if (i <= hi_owned) {
+                    arr(i,j,k) += offset;
+                } else {
+                    arr(i,j,k) = offset + total + (inclusive ? arr(i,j,k) : 0._rt);
+                }
+            });
+        }
+    }
+}
+
 /* \brief Compute the potential by solving Poisson's equation with
           a 1D tridiagonal solve.
 
+   The matrix of the discretized equation, -phi_{i-1} + 2 phi_i - phi_{i+1} = r_i
+   with r = rho dx^2/ep0, has constant coefficients, so that its solutions are
+   phi_i = p_i + alpha + beta*i (counting i from the lower end of the domain),
+   where p is the particular solution with p_0 = p_1 = 0. p is obtained with two
+   prefix sums, d_i = p_{i+1} - p_i = -sum_{0<m<=i} r_m and p_i = sum_{m<i} d_m,
+   which are distributed over the boxes of phi and run on the GPU. alpha and beta
+   are then set by the equations at both ends of the domain.
+
    \param[in] rho The charge density a given species
    \param[out] phi The potential to be computed by this function
 */
@@ -855,155 +1027,95 @@ WarpX::computePhiTriDiagonal (const amrex::Vector<std::unique_ptr<amrex::MultiFa
     const int lev = 0;
 
     const amrex::Real* dx = Geom(lev).CellSize();
-    const amrex::Real xmin = Geom(lev).ProbLo(0);
-    const amrex::Real xmax = Geom(lev).ProbHi(0);
-    const int nx_full_domain = static_cast<int>( (xmax - xmin)/dx[0] + 0.5_rt );
-
-    int nx_solve_min = 1;
-    int nx_solve_max = nx_full_domain - 1;
+    const amrex::Box domain = amrex::surroundingNodes(Geom(lev).Domain());
+    const int i0 = domain.smallEnd(0);
+    const int iN = domain.bigEnd(0);
+    const int nx_full_domain = iN - i0;
 
     auto field_boundary_lo0 = WarpX::field_boundary_lo[0];
     auto field_boundary_hi0 = WarpX::field_boundary_hi[0];
-    if (field_boundary_lo0 == FieldBoundaryType::Neumann || field_boundary_lo0 == FieldBoundaryType::Periodic) {
-        // Neumann or periodic boundary condition
-        // Solve for the point on the lower boundary
-        nx_solve_min = 0;
-    }
-    if (field_boundary_hi0 == FieldBoundaryType::Neumann || field_boundary_hi0 == FieldBoundaryType::Periodic) {
-        // Neumann or periodic boundary condition
-        // Solve for the point on the upper boundary
-        nx_solve_max = nx_full_domain;
-    }
+    const bool neumann_lo = (field_boundary_lo0 == FieldBoundaryType::Neumann);
+    const bool neumann_hi = (field_boundary_hi0 == FieldBoundaryType::Neumann);
+    const bool periodic = (field_boundary_lo0 == FieldBoundaryType::Periodic);
 
-    // Create a 1-D MultiFab that covers all of x.
-    // The tridiag solve will be done in this MultiFab and then copied out afterwards.
-    const amrex::IntVect lo_full_domain(AMREX_D_DECL(0,0,0));
-    const amrex::IntVect hi_full_domain(AMREX_D_DECL(nx_full_domain,0,0));
-    const amrex::Box box_full_domain_node(lo_full_domain, hi_full_domain, amrex::IntVect::TheNodeVector());
-    const BoxArray ba_full_domain_node(box_full_domain_node);
-    const amrex::Vector<int> pmap = {0}; // The data will only be on processor 0
-    const amrex::DistributionMapping dm_full_domain(pmap);
-
-    // Put the data in the pinned arena since the tridiag solver will be done on the CPU, but have
-    // the data readily accessible from the GPU.
-    auto phi1d_mf = MultiFab(ba_full_domain_node, dm_full_domain, 1, 0, MFInfo().SetArena(The_Pinned_Arena()));
-    auto zwork1d_mf = MultiFab(ba_full_domain_node, dm_full_domain, 1, 0, MFInfo().SetArena(The_Pinned_Arena()));
-    auto rho1d_mf = MultiFab(ba_full_domain_node, dm_full_domain, 1, 0, MFInfo().SetArena(The_Pinned_Arena()));
-
-    if (field_boundary_lo0 == FieldBoundaryType::PEC || field_boundary_hi0 == FieldBoundaryType::PEC) {
-        // Copy from phi to get the boundary values
-        phi1d_mf.ParallelCopy(*phi[lev], 0, 0, 1);
-    }
-    rho1d_mf.ParallelCopy(*rho[lev], 0, 0, 1);
+    // Range of the nodes that are solved for: the others hold the Dirichlet
+    // boundary values set by setPhiBC
+    const int nx_solve_min = (neumann_lo || periodic) ? i0 : i0 + 1;
+    const int nx_solve_max = (neumann_hi || periodic) ? iN : iN - 1;
+
+    // Right hand side, on the grids of phi
+    amrex::MultiFab work(phi[lev]->boxArray(), phi[lev]->DistributionMap(), 1, 0);
+    work.ParallelCopy(*rho[lev], 0, 0, 1);
 
     // Multiplier on the charge density
     const amrex::Real norm = dx[0]*dx[0]/PhysConst::ep0;
-    rho1d_mf.mult(norm);
-
-    // Use the MFIter loop since when parallel, only process zero has a FAB.
-    // This skips the loop on all other processors.
-    for (MFIter mfi(phi1d_mf); mfi.isValid(); ++mfi) {
-
-        const auto& phi1d_arr = phi1d_mf[mfi].array();
-        const auto& zwork1d_arr = zwork1d_mf[mfi].array();
-        const auto& rho1d_arr = rho1d_mf[mfi].array();
-
-        // The loops are always performed on the CPU
-
-        amrex::Real diag = 2._rt;
-
-        // The initial values depend on the boundary condition
-        if (field_boundary_lo0 == FieldBoundaryType::PEC) {
-
-            phi1d_arr(1,0,0) = (phi1d_arr(0,0,0) + rho1d_arr(1,0,0))/diag;
-
-        } else if (field_boundary_lo0 == FieldBoundaryType::Neumann) {
-
-            // Neumann boundary condition
-            phi1d_arr(0,0,0) = rho1d_arr(0,0,0)/diag;
-
-            zwork1d_arr(1,0,0) = 2._rt/diag;
-            diag = 2._rt - zwork1d_arr(1,0,0);
-            phi1d_arr(1,0,0) = (rho1d_arr(1,0,0) - (-1._rt)*phi1d_arr(1-1,0,0))/diag;
-
-        } else if (field_boundary_lo0 == FieldBoundaryType::Periodic) {
-
-            phi1d_arr(0,0,0) = rho1d_arr(0,0,0)/diag;
-
-            zwork1d_arr(1,0,0) = 1._rt/diag;
-            diag = 2._rt - zwork1d_arr(1,0,0);
-            phi1d_arr(1,0,0) = (rho1d_arr(1,0,0) - (-1._rt)*phi1d_arr(1-1,0,0))/diag;
-
-        }
-
-        // Loop upward, calculating the Gaussian elimination multipliers and right hand sides
-        for (int i_up = 2 ; i_up < nx_solve_max ; i_up++) {
-
-            zwork1d_arr(i_up,0,0) = 1._rt/diag;
-            diag = 2._rt - zwork1d_arr(i_up,0,0);
-            phi1d_arr(i_up,0,0) = (rho1d_arr(i_up,0,0) - (-1._rt)*phi1d_arr(i_up-1,0,0))/diag;
-
-        }
-
-        // The last value depend on the boundary condition
-        amrex::Real zwork_product = 1.; // Needed for parallel boundaries
-        if (field_boundary_hi0 == FieldBoundaryType::PEC) {
-
-            int const nxm1 = nx_full_domain - 1;
-            zwork1d_arr(nxm1,0,0) = 1._rt/diag;
-            diag = 2._rt - zwork1d_arr(nxm1,0,0);
-            phi1d_arr(nxm1,0,0) = (phi1d_arr(nxm1+1,0,0) + rho1d_arr(nxm1,0,0) - (-1._rt)*phi1d_arr(nxm1-1,0,0))/diag;
-
-        } else if (field_boundary_hi0 == FieldBoundaryType::Neumann) {
-
-            // Neumann boundary condition
-            zwork1d_arr(nx_full_domain,0,0) = 1._rt/diag;
-            diag = 2._rt - 2._rt*zwork1d_arr(nx_full_domain,0,0);
-            if (diag == 0._rt) {
-                // This happens if the lower boundary is also Neumann.
-                // It this case, the potential is relative to an arbitrary constant,
-                // so set the upper boundary to zero to force a value.
-                phi1d_arr(nx_full_domain,0,0) = 0.;
-            } else {
-                phi1d_arr(nx_full_domain,0,0) = (rho1d_arr(nx_full_domain,0,0) - (-1._rt)*phi1d_arr(nx_full_domain-1,0,0))/diag;
-            }
-
-        } else if (field_boundary_hi0 == FieldBoundaryType::Periodic) {
-
-            zwork1d_arr(nx_full_domain,0,0) = 1._rt/diag;
-
-            for (int i = 1 ; i <= nx_full_domain ; i++) {
-                zwork_product *= zwork1d_arr(i,0,0);
-            }
-
-            diag = 2._rt - zwork1d_arr(nx_full_domain,0,0) - zwork_product;
-            // Note that rho1d_arr(0,0,0) is used to ensure that the same value is used
-            // on both boundaries.
-            phi1d_arr(nx_full_domain,0,0) = (rho1d_arr(0,0,0) - (-1._rt)*phi1d_arr(nx_full_domain-1,0,0))/diag;
-
+    work.mult(norm);
+
+    // Values at both ends, needed for the boundary conditions
+    const amrex::Vector<amrex::Real> end_values = GetNodeValues1D(
+        {&work, &work, phi[lev].get(), phi[lev].get()}, {i0, iN, i0, iN}, domain);
+    const amrex::Real r_lo = end_values[0];
+    const amrex::Real r_hi = end_values[1];
+    const amrex::Real phi_lo = end_values[2];
+    const amrex::Real phi_hi = end_values[3];
+
+    // Particular solution p, with r_0 excluded from the first sum
+    for (MFIter mfi(work); mfi.isValid(); ++mfi) {
+        amrex::Array4<amrex::Real> const& work_arr = work.array(mfi);
+        amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+            if (i == i0) { work_arr(i,j,k) = 0._rt; }
+        });
+    }
+    PrefixSum1D(work, domain, amrex::Scan::Type::inclusive);
+    work.mult(-1._rt);
+    PrefixSum1D(work, domain, amrex::Scan::Type::exclusive);
+
+    const amrex::Vector<amrex::Real> p_values = GetNodeValues1D(
+        {&work, &work}, {iN-1, iN}, domain);
+    const amrex::Real p_hi = p_values[1];
+    const amrex::Real d_hi = p_values[1] - p_values[0];
+
+    // Linear part of the solution, from the equations at both ends
+    const auto nx = static_cast<amrex::Real>(nx_full_domain);
+    amrex::Real alpha = 0._rt, beta = 0._rt;
+    if (periodic) {
+        // phi_N = phi_0, and the potential is relative to an arbitrary constant,
+        // so set the boundary value to zero to force a value.
+        beta = -p_hi/nx;
+        alpha = 0._rt;
+    } else {
+        if (neumann_lo) {
+            // 2 phi_0 - 2 phi_1 = r_0
+            beta = -0.5_rt*r_lo;
+        } else {
+            // phi_0 given
+            alpha = phi_lo;
         }
-
-        // Loop downward to calculate the phi
-        if (field_boundary_lo0 == FieldBoundaryType::Periodic) {
-
-            // With periodic, the right hand column adds an extra term for all rows
-            for (int i_down = nx_full_domain-1 ; i_down >= 0 ; i_down--) {
-                zwork_product /= zwork1d_arr(i_down+1,0,0);
-                phi1d_arr(i_down,0,0) = phi1d_arr(i_down,0,0) + zwork1d_arr(i_down+1,0,0)*phi1d_arr(i_down+1,0,0) + zwork_product*phi1d_arr(nx_full_domain,0,0);
-            }
-
+        if (neumann_hi && neumann_lo) {
+            // The potential is relative to an arbitrary constant,
+            // so set the upper boundary to zero to force a value.
+            alpha = -p_hi - beta*nx;
+        } else if (neumann_hi) {
+            // 2 phi_N - 2 phi_{N-1} = r_N
+            beta = 0.5_rt*r_hi - d_hi;
+        } else if (neumann_lo) {
+            // phi_N given
+            alpha = phi_hi - p_hi - beta*nx;
         } else {
-
-            for (int i_down = nx_solve_max-1 ; i_down >= nx_solve_min ; i_down--) {
-                phi1d_arr(i_down,0,0) = phi1d_arr(i_down,0,0) + zwork1d_arr(i_down+1,0,0)*phi1d_arr(i_down+1,0,0);
-            }
-
+            beta = (phi_hi - p_hi - alpha)/nx;
         }
-
     }
 
-    // Copy phi1d to phi
-    phi[lev]->ParallelCopy(phi1d_mf, 0, 0, 1);
+    // Copy the solution to phi
+    for (MFIter mfi(*phi[lev]); mfi.isValid(); ++mfi) {
+        amrex::Array4<amrex::Real const> const& p_arr = work.const_array(mfi);
+        amrex::Array4<amrex::Real> const& phi_arr = phi[lev]->array(mfi);
+        amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+            if (i >= nx_solve_min && i <= nx_solve_max) {
+                phi_arr(i,j,k) = p_arr(i,j,k) + alpha + beta*static_cast<amrex::Real>(i - i0);
+            }
+        });
+    }
 }
 
 void ElectrostaticSolver::PoissonBoundaryHandler::definePhiBCs (const amrex::Geometry& geom)
@@ -1035,7 +1147,8 @@ void ElectrostaticSolver::PoissonBoundaryHandler::definePhiBCs (const amrex::Geo
     amrex::ignore_unused(geom);
 #endif
     for (int idim=dim_start; idim<AMREX_SPACEDIM; idim++){
-    if (WarpX::poisson_solver_id == PoissonSolverAlgo::Multigrid){
+    if (WarpX::poisson_solver_id == PoissonSolverAlgo::Multigrid ||
+        WarpX::poisson_solver_id == PoissonSolverAlgo::Spectral){
         if ( WarpX::field_boundary_lo[idim] == FieldBoundaryType::Periodic
              && WarpX::field_boundary_hi[idim] == FieldBoundaryType::Periodic ) {
             lobc[idim] = LinOpBCType::Periodic;
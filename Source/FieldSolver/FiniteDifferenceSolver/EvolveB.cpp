@@ -116,6 +116,9 @@ void FiniteDifferenceSolver::EvolveBCartesian (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Bfield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
+        // Nothing to update where the fields and the current vanish
+        if (IsQuiescent(mfi)) { continue; }
+
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
             amrex::Gpu::synchronize();
@@ -139,9 +142,9 @@ void FiniteDifferenceSolver::EvolveBCartesian (
         auto const n_coefs_z = static_cast<int>(m_stencil_coefs_z.size());
 
         // Extract tileboxes for which to loop
-        Box const& tbx  = mfi.tilebox(Bfield[0]->ixType().toIntVect());
-        Box const& tby  = mfi.tilebox(Bfield[1]->ixType().toIntVect());
-        Box const& tbz  = mfi.tilebox(Bfield[2]->ixType().toIntVect());
+        Box const tbx  = UpdateBox(mfi, Bfield[0]->ixType());
+        Box const tby  = UpdateBox(mfi, Bfield[1]->ixType());
+        Box const tbz  = UpdateBox(mfi, Bfield[2]->ixType());
 
         // Loop over the cells and update the fields
         amrex::ParallelFor(tbx, tby, tbz,
@@ -192,6 +195,13 @@ void FiniteDifferenceSolver::EvolveBCartesian (
             );
         }
 
+        // div(E) cleaning update fused in this loop (see SetFusedFUpdate),
+        // while the E of this tile, also read by the B update, is in cache
+        if (m_fused_F)
+        {
+            EvolveFTile(mfi, *m_fused_F, Efield, *m_fused_rho, m_fused_rhocomp, m_fused_F_dt);
+        }
+
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
             amrex::Gpu::synchronize();
@@ -381,6 +391,9 @@ void FiniteDifferenceSolver::EvolveBCylindrical (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Bfield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
+        // Nothing to update where the fields and the current vanish
+        if (IsQuiescent(mfi)) { continue; }
+
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
             amrex::Gpu::synchronize();
@@ -112,6 +112,9 @@ void FiniteDifferenceSolver::EvolveECartesian (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Efield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
+        // Nothing to update where the fields and the current vanish
+        if (IsQuiescent(mfi)) { continue; }
+
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
             amrex::Gpu::synchronize();
@@ -144,9 +147,9 @@ void FiniteDifferenceSolver::EvolveECartesian (
         auto const n_coefs_z = static_cast<int>(m_stencil_coefs_z.size());
 
         // Extract tileboxes for which to loop
-        Box const& tex  = mfi.tilebox(Efield[0]->ixType().toIntVect());
-        Box const& tey  = mfi.tilebox(Efield[1]->ixType().toIntVect());
-        Box const& tez  = mfi.tilebox(Efield[2]->ixType().toIntVect());
+        Box const tex  = UpdateBox(mfi, Efield[0]->ixType());
+        Box const tey  = UpdateBox(mfi, Efield[1]->ixType());
+        Box const tez  = UpdateBox(mfi, Efield[2]->ixType());
 
         // Loop over the cells and update the fields
         amrex::ParallelFor(tex, tey, tez,
@@ -216,6 +219,13 @@ void FiniteDifferenceSolver::EvolveECartesian (
 
         }
 
+        // div(B) cleaning update fused in this loop (see SetFusedGUpdate),
+        // while the B of this tile, also read by the E update, is in cache
+        if (m_fused_G)
+        {
+            EvolveGTile(mfi, *m_fused_G, Bfield, m_fused_G_dt);
+        }
+
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
             amrex::Gpu::synchronize();
@@ -248,6 +258,9 @@ void FiniteDifferenceSolver::EvolveECylindrical (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Efield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
+        // Nothing to update where the fields and the current vanish
+        if (IsQuiescent(mfi)) { continue; }
+
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
             amrex::Gpu::synchronize();
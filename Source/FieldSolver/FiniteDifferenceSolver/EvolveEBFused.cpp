@@ -0,0 +1,215 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "FiniteDifferenceSolver.H"
+
+#ifndef WARPX_DIM_RZ
+#   include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
+#   include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceAlgorithms/CartesianCKCAlgorithm.H"
+#endif
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXConst.H"
+#include "WarpX.H"
+
+#include <AMReX.H>
+#include <AMReX_Array4.H>
+#include <AMReX_Box.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_IndexType.H>
+#include <AMReX_LayoutData.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_REAL.H>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+
+using namespace amrex;
+
+/**
+ * \brief Update B over half a timestep, E over one timestep and B over half a
+ * timestep, in a single sweep over the fields of each box
+ */
+void FiniteDifferenceSolver::EvolveEBFused (
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Efield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
+    std::array< amrex::IntVect, 3 > const& ng_update,
+    amrex::Geometry const& geom,
+    int block_size, int lev, amrex::Real const dt ) {
+
+#ifdef WARPX_DIM_RZ
+    amrex::ignore_unused(Efield, Bfield, Jfield, ng_update, geom, block_size, lev, dt);
+    WARPX_ABORT_WITH_MESSAGE("EvolveEBFused: not implemented in RZ geometry");
+#else
+    if (m_grid_type != GridType::Collocated && m_fdtd_algo == ElectromagneticSolverAlgo::Yee) {
+
+        EvolveEBFusedCartesian <CartesianYeeAlgorithm> (
+            Efield, Bfield, Jfield, ng_update, geom, block_size, lev, dt );
+
+    } else if (m_grid_type != GridType::Collocated && m_fdtd_algo == ElectromagneticSolverAlgo::CKC) {
+
+        EvolveEBFusedCartesian <CartesianCKCAlgorithm> (
+            Efield, Bfield, Jfield, ng_update, geom, block_size, lev, dt );
+
+    } else {
+        WARPX_ABORT_WITH_MESSAGE("EvolveEBFused: only implemented for the Yee and CKC algorithms");
+    }
+#endif
+}
+
+
+#ifndef WARPX_DIM_RZ
+
+template<typename T_Algo>
+void FiniteDifferenceSolver::EvolveEBFusedCartesian (
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Efield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
+    std::array< amrex::IntVect, 3 > const& ng_update,
+    amrex::Geometry const& geom,
+    int block_size, int lev, amrex::Real const dt ) {
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    Real constexpr c2 = PhysConst::c * PhysConst::c;
+    Real const half_dt = 0.5_rt*dt;
+
+    // The blocks are slabs that are thin along the last dimension. The E (resp. second B)
+    // update of a slab lags behind the first B (resp. E) update by the width of the stencil,
+    // so that each update only reads values that are already (or still) at the right time level.
+    int constexpr dir = AMREX_SPACEDIM-1;
+    int const skew = T_Algo::GetMaxGuardCell()[dir];
+
+    // The guard cells beyond non-periodic boundaries are set by the field boundary conditions
+    Box domain = geom.Domain();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (geom.isPeriodic(idim)) { domain.grow(idim, ng_update[0][idim]); }
+    }
+
+    // Loop through the grids: all the slabs of a grid are updated by the same thread,
+    // since neighboring slabs depend on each other
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for ( MFIter mfi(*Bfield[0]); mfi.isValid(); ++mfi ) {
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+        }
+        auto wt = static_cast<amrex::Real>(amrex::second());
+
+        // Extract field data for this grid
+        Array4<Real> const& Ex = Efield[0]->array(mfi);
+        Array4<Real> const& Ey = Efield[1]->array(mfi);
+        Array4<Real> const& Ez = Efield[2]->array(mfi);
+        Array4<Real> const& Bx = Bfield[0]->array(mfi);
+        Array4<Real> const& By = Bfield[1]->array(mfi);
+        Array4<Real> const& Bz = Bfield[2]->array(mfi);
+        Array4<Real const> const& jx = Jfield[0]->const_array(mfi);
+        Array4<Real const> const& jy = Jfield[1]->const_array(mfi);
+        Array4<Real const> const& jz = Jfield[2]->const_array(mfi);
+
+        // Extract stencil coefficients
+        Real const * const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
+        auto const n_coefs_x = static_cast<int>(m_stencil_coefs_x.size());
+        Real const * const AMREX_RESTRICT coefs_y = m_stencil_coefs_y.dataPtr();
+        auto const n_coefs_y = static_cast<int>(m_stencil_coefs_y.size());
+        Real const * const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
+        auto const n_coefs_z = static_cast<int>(m_stencil_coefs_z.size());
+
+        // Regions updated by each of the three pushes
+        auto const region = [&] (amrex::MultiFab const& mf, amrex::IntVect const& ng) {
+            return mfi.tilebox(mf.ixType().toIntVect(), ng) & amrex::convert(domain, mf.ixType());
+        };
+        std::array<std::array<Box,3>,3> regions;
+        for (int i = 0; i < 3; ++i) {
+            regions[0][i] = region(*Bfield[i], ng_update[0]);
+            regions[1][i] = region(*Efield[i], ng_update[1]);
+            regions[2][i] = region(*Bfield[i], ng_update[2]);
+        }
+        int zlo = regions[0][0].smallEnd(dir);
+        int zhi = regions[0][0].bigEnd(dir);
+        for (auto const& boxes : regions) {
+            for (auto const& b : boxes) {
+                zlo = std::min(zlo, b.smallEnd(dir));
+                zhi = std::max(zhi, b.bigEnd(dir));
+            }
+        }
+
+        auto const pushBx = [=] AMREX_GPU_DEVICE (int i, int j, int k){
+            Bx(i, j, k) += half_dt * T_Algo::UpwardDz(Ey, coefs_z, n_coefs_z, i, j, k)
+                         - half_dt * T_Algo::UpwardDy(Ez, coefs_y, n_coefs_y, i, j, k);
+        };
+        auto const pushBy = [=] AMREX_GPU_DEVICE (int i, int j, int k){
+            By(i, j, k) += half_dt * T_Algo::UpwardDx(Ez, coefs_x, n_coefs_x, i, j, k)
+                         - half_dt * T_Algo::UpwardDz(Ex, coefs_z, n_coefs_z, i, j, k);
+        };
+        auto const pushBz = [=] AMREX_GPU_DEVICE (int i, int j, int k){
+            Bz(i, j, k) += half_dt * T_Algo::UpwardDy(Ex, coefs_y, n_coefs_y, i, j, k)
+                         - half_dt * T_Algo::UpwardDx(Ey, coefs_x, n_coefs_x, i, j, k);
+        };
+
+        // Loop over the slabs, with the updates of the E field and of the
+        // second half of the B field lagging behind
+        for (int z0 = zlo; z0 - 2*skew <= zhi; z0 += block_size) {
+
+            auto const slab = [&] (Box const& b, int lag) {
+                Box s = b;
+                s.setSmall(dir, std::max(b.smallEnd(dir), z0 - lag));
+                s.setBig(dir, std::min(b.bigEnd(dir), z0 + block_size - 1 - lag));
+                return s;
+            };
+
+            // First half of the B push
+            amrex::ParallelFor(slab(regions[0][0], 0), slab(regions[0][1], 0), slab(regions[0][2], 0),
+                               pushBx, pushBy, pushBz);
+
+            // E push
+            amrex::ParallelFor(
+                slab(regions[1][0], skew), slab(regions[1][1], skew), slab(regions[1][2], skew),
+
+                [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                    Ex(i, j, k) += c2 * dt * (
+                        - T_Algo::DownwardDz(By, coefs_z, n_coefs_z, i, j, k)
+                        + T_Algo::DownwardDy(Bz, coefs_y, n_coefs_y, i, j, k)
+                        - PhysConst::mu0 * jx(i, j, k) );
+                },
+
+                [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                    Ey(i, j, k) += c2 * dt * (
+                        - T_Algo::DownwardDx(Bz, coefs_x, n_coefs_x, i, j, k)
+                        + T_Algo::DownwardDz(Bx, coefs_z, n_coefs_z, i, j, k)
+                        - PhysConst::mu0 * jy(i, j, k) );
+                },
+
+                [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                    Ez(i, j, k) += c2 * dt * (
+                        - T_Algo::DownwardDy(Bx, coefs_y, n_coefs_y, i, j, k)
+                        + T_Algo::DownwardDx(By, coefs_x, n_coefs_x, i, j, k)
+                        - PhysConst::mu0 * jz(i, j, k) );
+                }
+            );
+
+            // Second half of the B push
+            amrex::ParallelFor(slab(regions[2][0], 2*skew), slab(regions[2][1], 2*skew),
+                               slab(regions[2][2], 2*skew), pushBx, pushBy, pushBz);
+        }
+
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+            wt = static_cast<amrex::Real>(amrex::second()) - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
+    }
+}
+
+#endif // corresponds to ifndef WARPX_DIM_RZ
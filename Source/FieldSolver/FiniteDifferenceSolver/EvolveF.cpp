@@ -77,6 +77,27 @@ void FiniteDifferenceSolver::EvolveF (
 
 }
 
+void FiniteDifferenceSolver::EvolveFTile (
+    amrex::MFIter const& mfi, amrex::MultiFab& Ffield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Efield,
+    amrex::MultiFab const& rhofield, int const rhocomp, amrex::Real const dt ) {
+
+#ifdef WARPX_DIM_RZ
+    amrex::ignore_unused(mfi, Ffield, Efield, rhofield, rhocomp, dt);
+    WARPX_ABORT_WITH_MESSAGE("EvolveFTile: not implemented in RZ geometry");
+#else
+    if (m_grid_type == GridType::Collocated) {
+        EvolveFCartesianTile <CartesianNodalAlgorithm> ( mfi, Ffield, Efield, rhofield, rhocomp, dt );
+    } else if (m_fdtd_algo == ElectromagneticSolverAlgo::Yee) {
+        EvolveFCartesianTile <CartesianYeeAlgorithm> ( mfi, Ffield, Efield, rhofield, rhocomp, dt );
+    } else if (m_fdtd_algo == ElectromagneticSolverAlgo::CKC) {
+        EvolveFCartesianTile <CartesianCKCAlgorithm> ( mfi, Ffield, Efield, rhofield, rhocomp, dt );
+    } else {
+        WARPX_ABORT_WITH_MESSAGE("EvolveFTile: Unknown algorithm");
+    }
+#endif
+}
+
 
 #ifndef WARPX_DIM_RZ
 
@@ -93,42 +114,49 @@ void FiniteDifferenceSolver::EvolveFCartesian (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Ffield, TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
+        EvolveFCartesianTile<T_Algo>( mfi, *Ffield, Efield, *rhofield, rhocomp, dt );
+    }
 
-        // Extract field data for this grid/tile
-        Array4<Real> const& F = Ffield->array(mfi);
-        Array4<Real> const& Ex = Efield[0]->array(mfi);
-        Array4<Real> const& Ey = Efield[1]->array(mfi);
-        Array4<Real> const& Ez = Efield[2]->array(mfi);
-        Array4<Real> const& rho = rhofield->array(mfi);
-
-        // Extract stencil coefficients
-        Real const * const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
-        auto const n_coefs_x = static_cast<int>(m_stencil_coefs_x.size());
-        Real const * const AMREX_RESTRICT coefs_y = m_stencil_coefs_y.dataPtr();
-        auto const n_coefs_y = static_cast<int>(m_stencil_coefs_y.size());
-        Real const * const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
-        auto const n_coefs_z =static_cast<int>(m_stencil_coefs_z.size());
-
-        // Extract tileboxes for which to loop
-        Box const& tf  = mfi.tilebox(Ffield->ixType().toIntVect());
-
-        Real constexpr inv_epsilon0 = 1._rt/PhysConst::ep0;
-
-        // Loop over the cells and update the fields
-        amrex::ParallelFor(tf,
-
-            [=] AMREX_GPU_DEVICE (int i, int j, int k){
-                F(i, j, k) += dt * (
-                    - rho(i, j, k, rhocomp) * inv_epsilon0
-                    + T_Algo::DownwardDx(Ex, coefs_x, n_coefs_x, i, j, k)
-                    + T_Algo::DownwardDy(Ey, coefs_y, n_coefs_y, i, j, k)
-                    + T_Algo::DownwardDz(Ez, coefs_z, n_coefs_z, i, j, k) );
-            }
-
-        );
+}
 
-    }
+template<typename T_Algo>
+void FiniteDifferenceSolver::EvolveFCartesianTile (
+    amrex::MFIter const& mfi, amrex::MultiFab& Ffield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Efield,
+    amrex::MultiFab const& rhofield, int const rhocomp, amrex::Real const dt ) {
+
+    // Extract field data for this grid/tile
+    Array4<Real> const& F = Ffield.array(mfi);
+    Array4<Real> const& Ex = Efield[0]->array(mfi);
+    Array4<Real> const& Ey = Efield[1]->array(mfi);
+    Array4<Real> const& Ez = Efield[2]->array(mfi);
+    Array4<Real const> const& rho = rhofield.const_array(mfi);
+
+    // Extract stencil coefficients
+    Real const * const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
+    auto const n_coefs_x = static_cast<int>(m_stencil_coefs_x.size());
+    Real const * const AMREX_RESTRICT coefs_y = m_stencil_coefs_y.dataPtr();
+    auto const n_coefs_y = static_cast<int>(m_stencil_coefs_y.size());
+    Real const * const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
+    auto const n_coefs_z =static_cast<int>(m_stencil_coefs_z.size());
+
+    // Extract tileboxes for which to loop
+    Box const& tf  = mfi.tilebox(Ffield.ixType().toIntVect());
+
+    Real constexpr inv_epsilon0 = 1._rt/PhysConst::ep0;
+
+    // Loop over the cells and update the fields
+    amrex::ParallelFor(tf,
+
+        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+            F(i, j, k) += dt * (
+                - rho(i, j, k, rhocomp) * inv_epsilon0
+                + T_Algo::DownwardDx(Ex, coefs_x, n_coefs_x, i, j, k)
+                + T_Algo::DownwardDy(Ey, coefs_y, n_coefs_y, i, j, k)
+                + T_Algo::DownwardDz(Ez, coefs_z, n_coefs_z, i, j, k) );
+        }
 
+    );
 }
 
 #else // corresponds to ifndef WARPX_DIM_RZ
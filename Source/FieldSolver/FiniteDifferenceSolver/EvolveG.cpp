@@ -66,6 +66,34 @@ void FiniteDifferenceSolver::EvolveG (
 #endif
 }
 
+void FiniteDifferenceSolver::EvolveGTile (
+    amrex::MFIter const& mfi, amrex::MultiFab& Gfield,
+    std::array<std::unique_ptr<amrex::MultiFab>,3> const& Bfield,
+    amrex::Real const dt)
+{
+#ifdef WARPX_DIM_RZ
+    amrex::ignore_unused(mfi, Gfield, Bfield, dt);
+    WARPX_ABORT_WITH_MESSAGE("EvolveGTile: not implemented in RZ geometry");
+#else
+    if (m_grid_type == GridType::Collocated)
+    {
+        EvolveGCartesianTile<CartesianNodalAlgorithm>(mfi, Gfield, Bfield, dt);
+    }
+    else if (m_fdtd_algo == ElectromagneticSolverAlgo::Yee)
+    {
+        EvolveGCartesianTile<CartesianYeeAlgorithm>(mfi, Gfield, Bfield, dt);
+    }
+    else if (m_fdtd_algo == ElectromagneticSolverAlgo::CKC)
+    {
+        EvolveGCartesianTile<CartesianCKCAlgorithm>(mfi, Gfield, Bfield, dt);
+    }
+    else
+    {
+        WARPX_ABORT_WITH_MESSAGE("EvolveGTile: unknown FDTD algorithm");
+    }
+#endif
+}
+
 #ifndef WARPX_DIM_RZ
 
 template<typename T_Algo>
@@ -74,9 +102,6 @@ void FiniteDifferenceSolver::EvolveGCartesian (
     std::array<std::unique_ptr<amrex::MultiFab>,3> const& Bfield,
     amrex::Real const dt)
 {
-
-    amrex::Real constexpr c2 = PhysConst::c * PhysConst::c;
-
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
@@ -84,32 +109,43 @@ void FiniteDifferenceSolver::EvolveGCartesian (
     // Loop over grids and over tiles within each grid
     for (amrex::MFIter mfi(*Gfield, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
-        // Extract field data for this grid/tile
-        amrex::Array4<amrex::Real> const& G = Gfield->array(mfi);
-        amrex::Array4<amrex::Real> const& Bx = Bfield[0]->array(mfi);
-        amrex::Array4<amrex::Real> const& By = Bfield[1]->array(mfi);
-        amrex::Array4<amrex::Real> const& Bz = Bfield[2]->array(mfi);
-
-        // Extract stencil coefficients
-        amrex::Real const* const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
-        amrex::Real const* const AMREX_RESTRICT coefs_y = m_stencil_coefs_y.dataPtr();
-        amrex::Real const* const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
-
-        const auto n_coefs_x = static_cast<int>(m_stencil_coefs_x.size());
-        const auto n_coefs_y = static_cast<int>(m_stencil_coefs_y.size());
-        const auto n_coefs_z = static_cast<int>(m_stencil_coefs_z.size());
-
-        // Extract tilebox to loop over
-        amrex::Box const& tf = mfi.tilebox(Gfield->ixType().toIntVect());
-
-        // Loop over cells and update G
-        amrex::ParallelFor(tf, [=] AMREX_GPU_DEVICE (int i, int j, int k)
-        {
-            G(i,j,k) += c2 * dt * (T_Algo::UpwardDx(Bx, coefs_x, n_coefs_x, i, j, k)
-                                 + T_Algo::UpwardDy(By, coefs_y, n_coefs_y, i, j, k)
-                                 + T_Algo::UpwardDz(Bz, coefs_z, n_coefs_z, i, j, k));
-        });
+        EvolveGCartesianTile<T_Algo>(mfi, *Gfield, Bfield, dt);
     }
 }
 
+template<typename T_Algo>
+void FiniteDifferenceSolver::EvolveGCartesianTile (
+    amrex::MFIter const& mfi, amrex::MultiFab& Gfield,
+    std::array<std::unique_ptr<amrex::MultiFab>,3> const& Bfield,
+    amrex::Real const dt)
+{
+    amrex::Real constexpr c2 = PhysConst::c * PhysConst::c;
+
+    // Extract field data for this grid/tile
+    amrex::Array4<amrex::Real> const& G = Gfield.array(mfi);
+    amrex::Array4<amrex::Real> const& Bx = Bfield[0]->array(mfi);
+    amrex::Array4<amrex::Real> const& By = Bfield[1]->array(mfi);
+    amrex::Array4<amrex::Real> const& Bz = Bfield[2]->array(mfi);
+
+    // Extract stencil coefficients
+    amrex::Real const* const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
+    amrex::Real const* const AMREX_RESTRICT coefs_y = m_stencil_coefs_y.dataPtr();
+    amrex::Real const* const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
+
+    const auto n_coefs_x = static_cast<int>(m_stencil_coefs_x.size());
+    const auto n_coefs_y = static_cast<int>(m_stencil_coefs_y.size());
+    const auto n_coefs_z = static_cast<int>(m_stencil_coefs_z.size());
+
+    // Extract tilebox to loop over
+    amrex::Box const& tf = mfi.tilebox(Gfield.ixType().toIntVect());
+
+    // Loop over cells and update G
+    amrex::ParallelFor(tf, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+    {
+        G(i,j,k) += c2 * dt * (T_Algo::UpwardDx(Bx, coefs_x, n_coefs_x, i, j, k)
+                             + T_Algo::UpwardDy(By, coefs_y, n_coefs_y, i, j, k)
+                             + T_Algo::UpwardDz(Bz, coefs_z, n_coefs_z, i, j, k));
+    });
+}
+
 #endif
@@ -20,7 +20,9 @@
 #endif
 
 #include <AMReX.H>
+#include <AMReX_Geometry.H>
 #include <AMReX_GpuDevice.H>
+#include <AMReX_MFIter.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_Vector.H>
 
@@ -101,3 +103,30 @@ FiniteDifferenceSolver::FiniteDifferenceSolver (
     amrex::Gpu::synchronize();
 #endif
 }
+
+void
+FiniteDifferenceSolver::SetUpdateGuardCells (
+    amrex::IntVect const& ng, amrex::Geometry const& geom )
+{
+    m_ng_update = ng;
+    // The guard cells beyond non-periodic boundaries are set by the field boundary conditions
+    m_update_domain = geom.Domain();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        m_update_periodic[idim] = geom.isPeriodic(idim) ? 1 : 0;
+        if (geom.isPeriodic(idim)) { m_update_domain.grow(idim, ng[idim]); }
+    }
+}
+
+amrex::Box
+FiniteDifferenceSolver::UpdateBox ( amrex::MFIter const& mfi, amrex::IndexType ixtype,
+                                    amrex::IntVect const& extra ) const
+{
+    if (m_ng_update == amrex::IntVect::TheZeroVector()) {
+        return mfi.tilebox(ixtype.toIntVect());
+    }
+    amrex::Box domain = m_update_domain;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (m_update_periodic[idim]) { domain.grow(idim, extra[idim]); }
+    }
+    return mfi.tilebox(ixtype.toIntVect(), m_ng_update + extra) & amrex::convert(domain, ixtype);
+}
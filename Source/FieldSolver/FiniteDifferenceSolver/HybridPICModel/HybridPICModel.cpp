@@ -29,6 +29,16 @@ void HybridPICModel::ReadParameters ()
     // of sub steps can be specified by the user (defaults to 50).
     utils::parser::queryWithParser(pp_hybrid, "substeps", m_substeps);
 
+    // Several substeps can be done in between two exchanges of the guard cells
+    // of B, at the cost of wider guard cells in which J, E and B are also computed.
+    utils::parser::queryWithParser(pp_hybrid, "substeps_per_exchange", m_substeps_per_exchange);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_substeps_per_exchange >= 0,
+        "hybrid_pic_model.substeps_per_exchange must be non-negative");
+#if defined(WARPX_DIM_RZ) || defined(AMREX_USE_EB)
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_substeps_per_exchange == 0,
+        "hybrid_pic_model.substeps_per_exchange is not supported in RZ geometry or with embedded boundaries");
+#endif
+
     // The hybrid model requires an electron temperature, reference density
     // and exponent to be given. These values will be used to calculate the
     // electron pressure according to p = n0 * Te * (n/n0)^gamma
@@ -72,7 +82,8 @@ void HybridPICModel::AllocateLevelMFs (int lev, const BoxArray& ba, const Distri
                                        const IntVect& rho_nodal_flag)
 {
     // The "electron_pressure_fp" multifab stores the electron pressure calculated
-    // from the specified equation of state.
+    // from the specified equation of state, when requested with
+    // CalculateElectronPressure (the Ohm's law solver does not use it).
     // The "rho_fp_temp" multifab is used to store the ion charge density
     // interpolated or extrapolated to appropriate timesteps.
     // The "current_fp_temp" multifab is used to store the ion current density
@@ -102,12 +113,14 @@ void HybridPICModel::AllocateLevelMFs (int lev, const BoxArray& ba, const Distri
     // the external current density multifab is made nodal to avoid needing to interpolate
     // to a nodal grid as has to be done for the ion and total current density multifabs
     // this also allows the external current multifab to not have any ghost cells
+    // (unless E is also computed in the guard cells, with substeps_per_exchange)
+    const IntVect ngJext = (m_substeps_per_exchange > 0) ? ngJ : IntVect(AMREX_D_DECL(0,0,0));
     WarpX::AllocInitMultiFab(current_fp_external[lev][0], amrex::convert(ba, IntVect(AMREX_D_DECL(1,1,1))),
-        dm, ncomps, IntVect(AMREX_D_DECL(0,0,0)), lev, "current_fp_external[x]", 0.0_rt);
+        dm, ncomps, ngJext, lev, "current_fp_external[x]", 0.0_rt);
     WarpX::AllocInitMultiFab(current_fp_external[lev][1], amrex::convert(ba, IntVect(AMREX_D_DECL(1,1,1))),
-        dm, ncomps, IntVect(AMREX_D_DECL(0,0,0)), lev, "current_fp_external[y]", 0.0_rt);
+        dm, ncomps, ngJext, lev, "current_fp_external[y]", 0.0_rt);
     WarpX::AllocInitMultiFab(current_fp_external[lev][2], amrex::convert(ba, IntVect(AMREX_D_DECL(1,1,1))),
-        dm, ncomps, IntVect(AMREX_D_DECL(0,0,0)), lev, "current_fp_external[z]", 0.0_rt);
+        dm, ncomps, ngJext, lev, "current_fp_external[z]", 0.0_rt);
 
 #ifdef WARPX_DIM_RZ
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
@@ -153,6 +166,18 @@ void HybridPICModel::InitData ()
 
     auto & warpx = WarpX::GetInstance();
 
+    // With wide guard cells, the fields are computed in the guard cells inside the
+    // domain and in periodic images, and set by the boundary conditions elsewhere
+    if (m_substeps_per_exchange > 0) {
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            for (const auto& bc : {WarpX::field_boundary_lo[idim], WarpX::field_boundary_hi[idim]}) {
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                    bc == FieldBoundaryType::Periodic || bc == FieldBoundaryType::PEC,
+                    "hybrid_pic_model.substeps_per_exchange requires periodic or PEC field boundaries");
+            }
+        }
+    }
+
     // Get the grid staggering of the fields involved in calculating E
     amrex::IntVect Jx_stag = warpx.getField(FieldType::current_fp, 0,0).ixType().toIntVect();
     amrex::IntVect Jy_stag = warpx.getField(FieldType::current_fp, 0,1).ixType().toIntVect();
@@ -479,9 +504,7 @@ void HybridPICModel::HybridPICSolveE (
     // Solve E field in regular cells
     warpx.get_pointer_fdtd_solver_fp(lev)->HybridPICSolveE(
         Efield, current_fp_ampere[lev], Jfield, current_fp_external[lev],
-        Bfield, rhofield,
-        electron_pressure_fp[lev],
-        edge_lengths, lev, this, include_resistivity_term
+        Bfield, rhofield, edge_lengths, lev, this, include_resistivity_term
     );
     warpx.ApplyEfieldBoundary(lev, patch_type);
 }
@@ -572,6 +595,20 @@ void HybridPICModel::BfieldEvolveRK (
     amrex::Real dt, int lev, DtType dt_type,
     IntVect ng, std::optional<bool> nodal_sync )
 {
+    // With wide guard cells, B is only exchanged once all its up-to-date guard
+    // cells are consumed: each of the 4 stages of the substep consumes 4 stencils
+    // (for J, the nodal E, E and B). The Runge-Kutta sums are then done in all the
+    // guard cells, since they are pointwise.
+    if (m_substeps_per_exchange > 0)
+    {
+        if (!(16*ng).allLE(m_valid_guards_B)) {
+            auto& warpx = WarpX::GetInstance();
+            m_valid_guards_B = Bfield[lev][0]->nGrowVect();
+            warpx.FillBoundaryB(m_valid_guards_B, nodal_sync);
+        }
+    }
+    const IntVect ng_sum = (m_substeps_per_exchange > 0) ? Bfield[lev][0]->nGrowVect() : ng;
+
     // Make copies of the B-field multifabs at t = n and create multifabs for
     // each direction to store the Runge-Kutta intermediate terms. Each
     // multifab has 2 components for the different terms that need to be stored.
@@ -583,7 +620,7 @@ void HybridPICModel::BfieldEvolveRK (
             Bfield[lev][ii]->boxArray(), Bfield[lev][ii]->DistributionMap(), 1,
             Bfield[lev][ii]->nGrowVect()
         );
-        MultiFab::Copy(B_old[ii], *Bfield[lev][ii], 0, 0, 1, ng);
+        MultiFab::Copy(B_old[ii], *Bfield[lev][ii], 0, 0, 1, ng_sum);
 
         K[ii] = MultiFab(
             Bfield[lev][ii]->boxArray(), Bfield[lev][ii]->DistributionMap(), 2,
@@ -605,7 +642,7 @@ void HybridPICModel::BfieldEvolveRK (
     {
         // Extract 0.5 * dt * K0 for each direction into index 0 of K.
         MultiFab::LinComb(
-            K[ii], 1._rt, *Bfield[lev][ii], 0, -1._rt, B_old[ii], 0, 0, 1, ng
+            K[ii], 1._rt, *Bfield[lev][ii], 0, -1._rt, B_old[ii], 0, 0, 1, ng_sum
         );
     }
 
@@ -622,10 +659,10 @@ void HybridPICModel::BfieldEvolveRK (
     {
         // Subtract 0.5 * dt * K0 from the Bfield for each direction, to get
         // B_new = B_old + 0.5 * dt * K1.
-        MultiFab::Subtract(*Bfield[lev][ii], K[ii], 0, 0, 1, ng);
+        MultiFab::Subtract(*Bfield[lev][ii], K[ii], 0, 0, 1, ng_sum);
         // Extract 0.5 * dt * K1 for each direction into index 1 of K.
         MultiFab::LinComb(
-            K[ii], 1._rt, *Bfield[lev][ii], 0, -1._rt, B_old[ii], 0, 1, 1, ng
+            K[ii], 1._rt, *Bfield[lev][ii], 0, -1._rt, B_old[ii], 0, 1, 1, ng_sum
         );
     }
 
@@ -642,7 +679,7 @@ void HybridPICModel::BfieldEvolveRK (
     {
         // Subtract 0.5 * dt * K1 from the Bfield for each direction to get
         // B_new = B_old + dt * K2.
-        MultiFab::Subtract(*Bfield[lev][ii], K[ii], 1, 0, 1, ng);
+        MultiFab::Subtract(*Bfield[lev][ii], K[ii], 1, 0, 1, ng_sum);
     }
 
     // Step 4:
@@ -658,20 +695,20 @@ void HybridPICModel::BfieldEvolveRK (
     {
         // Subtract B_old from the Bfield for each direction, to get
         // B = dt * K2 + 0.5 * dt * K3.
-        MultiFab::Subtract(*Bfield[lev][ii], B_old[ii], 0, 0, 1, ng);
+        MultiFab::Subtract(*Bfield[lev][ii], B_old[ii], 0, 0, 1, ng_sum);
 
         // Add dt * K2 + 0.5 * dt * K3 to index 0 of K (= 0.5 * dt * K0).
-        MultiFab::Add(K[ii], *Bfield[lev][ii], 0, 0, 1, ng);
+        MultiFab::Add(K[ii], *Bfield[lev][ii], 0, 0, 1, ng_sum);
 
         // Add 2 * 0.5 * dt * K1 to index 0 of K.
         MultiFab::LinComb(
-            K[ii], 1.0, K[ii], 0, 2.0, K[ii], 1, 0, 1, ng
+            K[ii], 1.0, K[ii], 0, 2.0, K[ii], 1, 0, 1, ng_sum
         );
 
         // Overwrite the Bfield with the Runge-Kutta sum:
         // B_new = B_old + 1/3 * dt * (0.5 * K0 + K1 + K2 + 0.5 * K3).
         MultiFab::LinComb(
-            *Bfield[lev][ii], 1.0, B_old[ii], 0, 1.0/3.0, K[ii], 0, 0, 1, ng
+            *Bfield[lev][ii], 1.0, B_old[ii], 0, 1.0/3.0, K[ii], 0, 0, 1, ng_sum
         );
     }
 }
@@ -687,6 +724,31 @@ void HybridPICModel::FieldPush (
 {
     auto& warpx = WarpX::GetInstance();
 
+    if (m_substeps_per_exchange > 0)
+    {
+        // J, E and B are computed in the guard cells in which their inputs are up-to-date,
+        // rather than exchanged: one stencil is consumed by each of the 4 computations below
+        // (the nodal E being computed in one more guard cell than E)
+        const int lev = 0;
+        auto* solver = warpx.get_pointer_fdtd_solver_fp(lev);
+        amrex::Geometry const& geom = warpx.Geom(lev);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE((4*ng).allLE(m_valid_guards_B),
+            "HybridPICModel::FieldPush: not enough up-to-date guard cells of B");
+
+        solver->SetUpdateGuardCells(m_valid_guards_B - ng, geom);
+        solver->CalculateCurrentAmpere(current_fp_ampere[lev], Bfield[lev], edge_lengths[lev], lev);
+
+        solver->SetUpdateGuardCells(m_valid_guards_B - 3*ng, geom);
+        HybridPICSolveE(Efield, Jfield, Bfield, rhofield, edge_lengths, true);
+
+        solver->SetUpdateGuardCells(m_valid_guards_B - 4*ng, geom);
+        warpx.EvolveB(dt, dt_type);
+
+        solver->SetUpdateGuardCells(amrex::IntVect::TheZeroVector(), geom);
+        m_valid_guards_B -= 4*ng;
+        return;
+    }
+
     // Calculate J = curl x B / mu0
     CalculateCurrentAmpere(Bfield, edge_lengths);
     // Calculate the E-field from Ohm's law
@@ -301,9 +301,9 @@ void FiniteDifferenceSolver::CalculateCurrentAmpereCartesian (
         auto const n_coefs_z = static_cast<int>(m_stencil_coefs_z.size());
 
         // Extract tileboxes for which to loop
-        Box const& tjx  = mfi.tilebox(Jfield[0]->ixType().toIntVect());
-        Box const& tjy  = mfi.tilebox(Jfield[1]->ixType().toIntVect());
-        Box const& tjz  = mfi.tilebox(Jfield[2]->ixType().toIntVect());
+        Box const tjx  = UpdateBox(mfi, Jfield[0]->ixType());
+        Box const tjy  = UpdateBox(mfi, Jfield[1]->ixType());
+        Box const tjz  = UpdateBox(mfi, Jfield[2]->ixType());
 
         Real const one_over_mu0 = 1._rt / PhysConst::mu0;
 
@@ -372,7 +372,6 @@ void FiniteDifferenceSolver::HybridPICSolveE (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jextfield,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Bfield,
     std::unique_ptr<amrex::MultiFab> const& rhofield,
-    std::unique_ptr<amrex::MultiFab> const& Pefield,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& edge_lengths,
     int lev, HybridPICModel const* hybrid_model,
     const bool include_resistivity_term)
@@ -383,14 +382,14 @@ void FiniteDifferenceSolver::HybridPICSolveE (
 #ifdef WARPX_DIM_RZ
 
         HybridPICSolveECylindrical <CylindricalYeeAlgorithm> (
-            Efield, Jfield, Jifield, Jextfield, Bfield, rhofield, Pefield,
+            Efield, Jfield, Jifield, Jextfield, Bfield, rhofield,
             edge_lengths, lev, hybrid_model, include_resistivity_term
         );
 
 #else
 
         HybridPICSolveECartesian <CartesianYeeAlgorithm> (
-            Efield, Jfield, Jifield, Jextfield, Bfield, rhofield, Pefield,
+            Efield, Jfield, Jifield, Jextfield, Bfield, rhofield,
             edge_lengths, lev, hybrid_model, include_resistivity_term
         );
 
@@ -410,7 +409,6 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jextfield,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Bfield,
     std::unique_ptr<amrex::MultiFab> const& rhofield,
-    std::unique_ptr<amrex::MultiFab> const& Pefield,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& edge_lengths,
     int lev, HybridPICModel const* hybrid_model,
     const bool include_resistivity_term )
@@ -435,6 +433,9 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
     const auto eta_h = hybrid_model->m_eta_h;
     const auto rho_floor = hybrid_model->m_n_floor * PhysConst::q_e;
     const auto resistivity_has_J_dependence = hybrid_model->m_resistivity_has_J_dependence;
+    const auto n0_ref = hybrid_model->m_n0_ref;
+    const auto elec_temp = hybrid_model->m_elec_temp;
+    const auto gamma = hybrid_model->m_gamma;
 
     const bool include_hyper_resistivity_term = (eta_h > 0.0) && include_resistivity_term;
 
@@ -559,7 +560,7 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
         Array4<Real const> const& Jz = Jfield[2]->const_array(mfi);
         Array4<Real const> const& enE = enE_nodal_mf.const_array(mfi);
         Array4<Real const> const& rho = rhofield->const_array(mfi);
-        Array4<Real> const& Pe = Pefield->array(mfi);
+        ElectronPressureAccessor const Pe{rho, n0_ref, elec_temp, gamma};
 
 #ifdef AMREX_USE_EB
         amrex::Array4<amrex::Real> const& lr = edge_lengths[0]->array(mfi);
@@ -720,6 +721,86 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
 
 #else
 
+namespace
+{
+    /**
+     * \brief Electron momentum term (J - Ji - Jext) x B of the generalized Ohm's law,
+     * evaluated at the nodes of the mesh from the staggered fields.
+     */
+    struct NodalElectronMomentum {
+
+        amrex::Array4<amrex::Real const> Jx, Jy, Jz;
+        amrex::Array4<amrex::Real const> Jix, Jiy, Jiz;
+        amrex::Array4<amrex::Real const> Jextx, Jexty, Jextz;
+        amrex::Array4<amrex::Real const> Bx, By, Bz;
+        amrex::GpuArray<int, 3> Jx_stag, Jy_stag, Jz_stag;
+        amrex::GpuArray<int, 3> Bx_stag, By_stag, Bz_stag;
+
+        AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+        amrex::Real operator() (int const i, int const j, int const k, int const comp) const
+        {
+            using namespace ablastr::coarsen::sample;
+            amrex::GpuArray<int, 3> const nodal = {1, 1, 1};
+            amrex::GpuArray<int, 3> const coarsen = {1, 1, 1};
+
+            // electron current (J - Ji - Jext) and B field on the nodal grid,
+            // only for the components entering the requested one
+            auto const je = [&] (amrex::Array4<amrex::Real const> const& J,
+                                 amrex::Array4<amrex::Real const> const& Ji,
+                                 amrex::Array4<amrex::Real const> const& Jext,
+                                 amrex::GpuArray<int, 3> const& J_stag) {
+                return Interp(J, J_stag, nodal, coarsen, i, j, k, 0)
+                    - Interp(Ji, J_stag, nodal, coarsen, i, j, k, 0) - Jext(i, j, k);
+            };
+            auto const B = [&] (amrex::Array4<amrex::Real const> const& Bc,
+                                amrex::GpuArray<int, 3> const& B_stag) {
+                return Interp(Bc, B_stag, nodal, coarsen, i, j, k, 0);
+            };
+
+            if (comp == 0) {
+                return je(Jy, Jiy, Jexty, Jy_stag) * B(Bz, Bz_stag)
+                    - je(Jz, Jiz, Jextz, Jz_stag) * B(By, By_stag);
+            } else if (comp == 1) {
+                return je(Jz, Jiz, Jextz, Jz_stag) * B(Bx, Bx_stag)
+                    - je(Jx, Jix, Jextx, Jx_stag) * B(Bz, Bz_stag);
+            } else {
+                return je(Jx, Jix, Jextx, Jx_stag) * B(By, By_stag)
+                    - je(Jy, Jiy, Jexty, Jy_stag) * B(Bx, Bx_stag);
+            }
+        }
+    };
+
+    /**
+     * \brief Average of the nodal values f(ii, jj, kk, comp) surrounding the point
+     * (i, j, k) of a grid with staggering sc, with the same weights and order as
+     * ablastr::coarsen::sample::Interp from a nodal grid without coarsening.
+     */
+    template<typename T_Field>
+    AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+    amrex::Real InterpFromNodal (T_Field const& f, amrex::GpuArray<int, 3> const& sc,
+                                 int const i, int const j, int const k, int const comp)
+    {
+        using namespace amrex::literals;
+
+        int const numx = 2 - sc[0];
+        int const numy = 2 - sc[1];
+        int const numz = 2 - sc[2];
+        amrex::Real const wx = 1.0_rt / static_cast<amrex::Real>(numx);
+        amrex::Real const wy = 1.0_rt / static_cast<amrex::Real>(numy);
+        amrex::Real const wz = 1.0_rt / static_cast<amrex::Real>(numz);
+
+        amrex::Real c = 0.0_rt;
+        for         (int kref = 0; kref < numz; ++kref) {
+            for     (int jref = 0; jref < numy; ++jref) {
+                for (int iref = 0; iref < numx; ++iref) {
+                    c += wx*wy*wz*f(i+iref, j+jref, k+kref, comp);
+                }
+            }
+        }
+        return c;
+    }
+}
+
 template<typename T_Algo>
 void FiniteDifferenceSolver::HybridPICSolveECartesian (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Efield,
@@ -728,7 +809,6 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jextfield,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Bfield,
     std::unique_ptr<amrex::MultiFab> const& rhofield,
-    std::unique_ptr<amrex::MultiFab> const& Pefield,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& edge_lengths,
     int lev, HybridPICModel const* hybrid_model,
     const bool include_resistivity_term )
@@ -767,91 +847,17 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
     // The "coarsening is just 1 i.e. no coarsening"
     amrex::GpuArray<int, 3> const& coarsen = {1, 1, 1};
 
-    // The E-field calculation is done in 2 steps:
-    // 1) The J x B term is calculated on a nodal mesh in order to ensure
-    //    energy conservation.
-    // 2) The nodal E-field values are averaged onto the Yee grid and the
-    //    electron pressure & resistivity terms are added (these terms are
-    //    naturally located on the Yee grid).
-
-    // Create a temporary multifab to hold the nodal E-field values
-    // Note the multifab has 3 values for Ex, Ey and Ez which we can do here
-    // since all three components will be calculated on the same grid.
-    // Also note that enE_nodal_mf does not need to have any guard cells since
-    // these values will be interpolated to the Yee mesh which is contained
-    // by the nodal mesh.
-    auto const& ba = convert(rhofield->boxArray(), IntVect::TheNodeVector());
-    MultiFab enE_nodal_mf(ba, rhofield->DistributionMap(), 3, IntVect::TheZeroVector());
-
-    // Loop through the grids, and over the tiles within each grid for the
-    // initial, nodal calculation of E
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
-#endif
-    for ( MFIter mfi(enE_nodal_mf, TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-        }
-        auto wt = static_cast<amrex::Real>(amrex::second());
+    // The J x B term is calculated on a nodal mesh in order to ensure
+    // energy conservation, and the nodal values are averaged onto the Yee
+    // grid, where the electron pressure & resistivity terms are added (these
+    // terms are naturally located on the Yee grid). Both the nodal values and
+    // the electron pressure are evaluated on the fly in the E-field kernel, so
+    // that no intermediate MultiFab is needed.
+    const auto n0_ref = hybrid_model->m_n0_ref;
+    const auto elec_temp = hybrid_model->m_elec_temp;
+    const auto gamma = hybrid_model->m_gamma;
 
-        Array4<Real> const& enE_nodal = enE_nodal_mf.array(mfi);
-        Array4<Real const> const& Jx = Jfield[0]->const_array(mfi);
-        Array4<Real const> const& Jy = Jfield[1]->const_array(mfi);
-        Array4<Real const> const& Jz = Jfield[2]->const_array(mfi);
-        Array4<Real const> const& Jix = Jifield[0]->const_array(mfi);
-        Array4<Real const> const& Jiy = Jifield[1]->const_array(mfi);
-        Array4<Real const> const& Jiz = Jifield[2]->const_array(mfi);
-        Array4<Real const> const& Jextx = Jextfield[0]->const_array(mfi);
-        Array4<Real const> const& Jexty = Jextfield[1]->const_array(mfi);
-        Array4<Real const> const& Jextz = Jextfield[2]->const_array(mfi);
-        Array4<Real const> const& Bx = Bfield[0]->const_array(mfi);
-        Array4<Real const> const& By = Bfield[1]->const_array(mfi);
-        Array4<Real const> const& Bz = Bfield[2]->const_array(mfi);
-
-        // Loop over the cells and update the nodal E field
-        amrex::ParallelFor(mfi.tilebox(), [=] AMREX_GPU_DEVICE (int i, int j, int k){
-
-            // interpolate the total current to a nodal grid
-            auto const jx_interp = Interp(Jx, Jx_stag, nodal, coarsen, i, j, k, 0);
-            auto const jy_interp = Interp(Jy, Jy_stag, nodal, coarsen, i, j, k, 0);
-            auto const jz_interp = Interp(Jz, Jz_stag, nodal, coarsen, i, j, k, 0);
-
-            // interpolate the ion current to a nodal grid
-            auto const jix_interp = Interp(Jix, Jx_stag, nodal, coarsen, i, j, k, 0);
-            auto const jiy_interp = Interp(Jiy, Jy_stag, nodal, coarsen, i, j, k, 0);
-            auto const jiz_interp = Interp(Jiz, Jz_stag, nodal, coarsen, i, j, k, 0);
-
-            // interpolate the B field to a nodal grid
-            auto const Bx_interp = Interp(Bx, Bx_stag, nodal, coarsen, i, j, k, 0);
-            auto const By_interp = Interp(By, By_stag, nodal, coarsen, i, j, k, 0);
-            auto const Bz_interp = Interp(Bz, Bz_stag, nodal, coarsen, i, j, k, 0);
-
-            // calculate enE = (J - Ji) x B
-            enE_nodal(i, j, k, 0) = (
-                (jy_interp - jiy_interp - Jexty(i, j, k)) * Bz_interp
-                - (jz_interp - jiz_interp - Jextz(i, j, k)) * By_interp
-            );
-            enE_nodal(i, j, k, 1) = (
-                (jz_interp - jiz_interp - Jextz(i, j, k)) * Bx_interp
-                - (jx_interp - jix_interp - Jextx(i, j, k)) * Bz_interp
-            );
-            enE_nodal(i, j, k, 2) = (
-                (jx_interp - jix_interp - Jextx(i, j, k)) * By_interp
-                - (jy_interp - jiy_interp - Jexty(i, j, k)) * Bx_interp
-            );
-        });
-
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-            wt = static_cast<amrex::Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-        }
-    }
-
-    // Loop through the grids, and over the tiles within each grid again
-    // for the Yee grid calculation of the E field
+    // Loop through the grids, and over the tiles within each grid
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
@@ -869,9 +875,14 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
         Array4<Real const> const& Jx = Jfield[0]->const_array(mfi);
         Array4<Real const> const& Jy = Jfield[1]->const_array(mfi);
         Array4<Real const> const& Jz = Jfield[2]->const_array(mfi);
-        Array4<Real const> const& enE = enE_nodal_mf.const_array(mfi);
         Array4<Real const> const& rho = rhofield->const_array(mfi);
-        Array4<Real> const& Pe = Pefield->array(mfi);
+        ElectronPressureAccessor const Pe{rho, n0_ref, elec_temp, gamma};
+        NodalElectronMomentum const enE{
+            Jx, Jy, Jz,
+            Jifield[0]->const_array(mfi), Jifield[1]->const_array(mfi), Jifield[2]->const_array(mfi),
+            Jextfield[0]->const_array(mfi), Jextfield[1]->const_array(mfi), Jextfield[2]->const_array(mfi),
+            Bfield[0]->const_array(mfi), Bfield[1]->const_array(mfi), Bfield[2]->const_array(mfi),
+            Jx_stag, Jy_stag, Jz_stag, Bx_stag, By_stag, Bz_stag};
 
 #ifdef AMREX_USE_EB
         amrex::Array4<amrex::Real> const& lx = edge_lengths[0]->array(mfi);
@@ -887,9 +898,9 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
         Real const * const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
         auto const n_coefs_z = static_cast<int>(m_stencil_coefs_z.size());
 
-        Box const& tex  = mfi.tilebox(Efield[0]->ixType().toIntVect());
-        Box const& tey  = mfi.tilebox(Efield[1]->ixType().toIntVect());
-        Box const& tez  = mfi.tilebox(Efield[2]->ixType().toIntVect());
+        Box const tex  = UpdateBox(mfi, Efield[0]->ixType());
+        Box const tey  = UpdateBox(mfi, Efield[1]->ixType());
+        Box const tez  = UpdateBox(mfi, Efield[2]->ixType());
 
         // Loop over the cells and update the E field
         amrex::ParallelFor(tex, tey, tez,
@@ -919,7 +930,7 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
                 auto grad_Pe = T_Algo::UpwardDx(Pe, coefs_x, n_coefs_x, i, j, k);
 
                 // interpolate the nodal neE values to the Yee grid
-                auto enE_x = Interp(enE, nodal, Ex_stag, coarsen, i, j, k, 0);
+                auto enE_x = InterpFromNodal(enE, Ex_stag, i, j, k, 0);
 
                 Ex(i, j, k) = (enE_x - grad_Pe) / rho_val;
 
@@ -963,7 +974,7 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
                 auto grad_Pe = T_Algo::UpwardDy(Pe, coefs_y, n_coefs_y, i, j, k);
 
                 // interpolate the nodal neE values to the Yee grid
-                auto enE_y = Interp(enE, nodal, Ey_stag, coarsen, i, j, k, 1);
+                auto enE_y = InterpFromNodal(enE, Ey_stag, i, j, k, 1);
 
                 Ey(i, j, k) = (enE_y - grad_Pe) / rho_val;
 
@@ -1001,7 +1012,7 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
                 auto grad_Pe = T_Algo::UpwardDz(Pe, coefs_z, n_coefs_z, i, j, k);
 
                 // interpolate the nodal neE values to the Yee grid
-                auto enE_z = Interp(enE, nodal, Ez_stag, coarsen, i, j, k, 2);
+                auto enE_z = InterpFromNodal(enE, Ez_stag, i, j, k, 2);
 
                 Ez(i, j, k) = (enE_z - grad_Pe) / rho_val;
 
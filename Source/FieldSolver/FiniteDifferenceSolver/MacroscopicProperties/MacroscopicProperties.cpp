@@ -6,6 +6,7 @@
 
 #include <ablastr/warn_manager/WarnManager.H>
 
+#include <AMReX_Algorithm.H>
 #include <AMReX_Array4.H>
 #include <AMReX_Config.H>
 #include <AMReX_Geometry.H>
@@ -13,12 +14,15 @@
 #include <AMReX_IndexType.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_Print.H>
 #include <AMReX_RealBox.H>
+#include <AMReX_Reduce.H>
 #include <AMReX_Parser.H>
 
 #include <AMReX_BaseFwd.H>
 
+#include <cmath>
 #include <memory>
 #include <sstream>
 
@@ -34,6 +38,36 @@ void
 MacroscopicProperties::ReadParameters ()
 {
     const ParmParse pp_macroscopic("macroscopic");
+
+    // The medium can alternatively be described by a small number of materials:
+    // a material id is stored in each cell, and the properties of each material
+    // (and the resulting coefficients of the E-update) are stored in small tables.
+    pp_macroscopic.queryarr("materials", m_material_names);
+    if (!m_material_names.empty()) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_material_names.size() <= 256,
+            "macroscopic.materials: at most 256 materials are supported");
+        for (auto const& name : m_material_names) {
+            const ParmParse pp_material("macroscopic." + name);
+            amrex::Real sigma = 0.0;
+            amrex::Real epsilon = PhysConst::ep0;
+            amrex::Real mu = PhysConst::mu0;
+            utils::parser::queryWithParser(pp_material, "sigma", sigma);
+            utils::parser::queryWithParser(pp_material, "epsilon", epsilon);
+            utils::parser::queryWithParser(pp_material, "mu", mu);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(epsilon > 0 && mu > 0,
+                "macroscopic." + name + ": epsilon and mu must be strictly positive");
+            m_material_sigma.push_back(sigma);
+            m_material_epsilon.push_back(epsilon);
+            m_material_mu.push_back(mu);
+        }
+        std::string str_material_id_function;
+        utils::parser::Store_parserString(
+            pp_macroscopic, "material_id_function(x,y,z)", str_material_id_function);
+        m_material_id_parser = std::make_unique<amrex::Parser>(
+            utils::parser::makeParser(str_material_id_function,{"x","y","z"}));
+        return;
+    }
+
     // Since macroscopic maxwell solve is turned on,
     // user-defined sigma, mu, and epsilon are queried.
     // The vacuum values are used as default for the macroscopic parameters
@@ -130,6 +164,31 @@ MacroscopicProperties::InitData (
 {
     amrex::Print() << Utils::TextMsg::Info("we are in init data of macro");
 
+    for ( int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        Ex_IndexType[idim]      = Ex_stag[idim];
+        Ey_IndexType[idim]      = Ey_stag[idim];
+        Ez_IndexType[idim]      = Ez_stag[idim];
+        macro_cr_ratio[idim]    = 1;
+    }
+#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        Ex_IndexType[2]      = 0;
+        Ey_IndexType[2]      = 0;
+        Ez_IndexType[2]      = 0;
+        macro_cr_ratio[2]    = 1;
+#elif defined(WARPX_DIM_1D_Z)
+    for ( int idim = 1; idim < 3; ++idim) {
+        Ex_IndexType[idim]      = 0;
+        Ey_IndexType[idim]      = 0;
+        Ez_IndexType[idim]      = 0;
+        macro_cr_ratio[idim]    = 1;
+    }
+#endif
+
+    if (useMaterialIds()) {
+        InitializeMaterialIds(ba, dmap, ng_EB_alloc, geom);
+        return;
+    }
+
     // Define material property multifabs using ba and dmap from WarpX instance
     // sigma is cell-centered MultiFab
     m_sigma_mf = std::make_unique<amrex::MultiFab>(ba, dmap, 1, ng_EB_alloc);
@@ -185,22 +244,94 @@ MacroscopicProperties::InitData (
         sigma_IndexType[idim]   = sigma_stag[idim];
         epsilon_IndexType[idim] = epsilon_stag[idim];
         mu_IndexType[idim]      = mu_stag[idim];
-        Ex_IndexType[idim]      = Ex_stag[idim];
-        Ey_IndexType[idim]      = Ey_stag[idim];
-        Ez_IndexType[idim]      = Ez_stag[idim];
-        macro_cr_ratio[idim]    = 1;
     }
 #if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
         sigma_IndexType[2]   = 0;
         epsilon_IndexType[2] = 0;
         mu_IndexType[2]      = 0;
-        Ex_IndexType[2]      = 0;
-        Ey_IndexType[2]      = 0;
-        Ez_IndexType[2]      = 0;
-        macro_cr_ratio[2]    = 1;
 #endif
 }
 
+void
+MacroscopicProperties::InitializeMaterialIds (
+    const amrex::BoxArray& ba,
+    const amrex::DistributionMapping& dmap,
+    const amrex::IntVect& ng_EB_alloc,
+    const amrex::Geometry& geom)
+{
+    // The material ids are cell-centered, as the MultiFabs of sigma, epsilon and mu
+    m_material_id_mf = std::make_unique<MaterialIdMultiFab>(ba, dmap, 1, ng_EB_alloc);
+
+    const auto n_materials = static_cast<int>(m_material_names.size());
+    amrex::ParserExecutor<3> const& id_parser = m_material_id_parser->compile<3>();
+    const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> dx_lev = geom.CellSizeArray();
+    const amrex::RealBox& prob_domain_lev = geom.ProbDomain();
+
+    amrex::ReduceOps<amrex::ReduceOpMin, amrex::ReduceOpMax> reduce_op;
+    amrex::ReduceData<int, int> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+    for ( amrex::MFIter mfi(*m_material_id_mf, TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
+        // Initialize ghost cells in addition to valid cells
+        const amrex::Box& tb = mfi.growntilebox();
+        amrex::Array4<std::uint8_t> const& id_arr = m_material_id_mf->array(mfi);
+        reduce_op.eval(tb, reduce_data,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple {
+#if defined(WARPX_DIM_1D_Z)
+                const amrex::Real x = 0._rt;
+                const amrex::Real y = 0._rt;
+                const amrex::Real z = (i + 0.5_rt) * dx_lev[0] + prob_domain_lev.lo(0);
+                amrex::ignore_unused(j, k);
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                const amrex::Real x = (i + 0.5_rt) * dx_lev[0] + prob_domain_lev.lo(0);
+                const amrex::Real y = 0._rt;
+                const amrex::Real z = (j + 0.5_rt) * dx_lev[1] + prob_domain_lev.lo(1);
+                amrex::ignore_unused(k);
+#else
+                const amrex::Real x = (i + 0.5_rt) * dx_lev[0] + prob_domain_lev.lo(0);
+                const amrex::Real y = (j + 0.5_rt) * dx_lev[1] + prob_domain_lev.lo(1);
+                const amrex::Real z = (k + 0.5_rt) * dx_lev[2] + prob_domain_lev.lo(2);
+#endif
+                const auto id = static_cast<int>(std::round(id_parser(x,y,z)));
+                id_arr(i,j,k) = static_cast<std::uint8_t>(amrex::Clamp(id, 0, n_materials-1));
+                return {id, id};
+        });
+    }
+    auto id_range = reduce_data.value(reduce_op);
+    amrex::ParallelDescriptor::ReduceIntMin(amrex::get<0>(id_range));
+    amrex::ParallelDescriptor::ReduceIntMax(amrex::get<1>(id_range));
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        amrex::get<0>(id_range) >= 0 && amrex::get<1>(id_range) < n_materials,
+        "macroscopic.material_id_function(x,y,z) must return the index of one of the macroscopic.materials");
+
+    // Tables of the material properties
+    amrex::Vector<amrex::Real> inv_mu(n_materials);
+    for (int m = 0; m < n_materials; ++m) { inv_mu[m] = 1._rt/m_material_mu[m]; }
+    m_material_sigma_d.resize(n_materials);
+    m_material_epsilon_d.resize(n_materials);
+    m_material_inv_mu_d.resize(n_materials);
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, m_material_sigma.begin(), m_material_sigma.end(),
+                          m_material_sigma_d.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, m_material_epsilon.begin(), m_material_epsilon.end(),
+                          m_material_epsilon_d.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, inv_mu.begin(), inv_mu.end(),
+                          m_material_inv_mu_d.begin());
+    amrex::Gpu::streamSynchronize();
+    // The tables of coefficients are computed at the first E-update
+    m_material_coefficients_dt = 0._rt;
+}
+
+MaterialTable
+MacroscopicProperties::getMaterialTable (amrex::MFIter const& mfi) const
+{
+    return MaterialTable{
+        m_material_id_mf->const_array(mfi),
+        m_material_sigma_d.dataPtr(),
+        m_material_epsilon_d.dataPtr(),
+        m_material_inv_mu_d.dataPtr(),
+        m_material_alpha_d.dataPtr(),
+        m_material_beta_d.dataPtr()};
+}
+
 void
 MacroscopicProperties::InitializeMacroMultiFabUsingParser (
                        amrex::MultiFab *macro_mf,
@@ -0,0 +1,86 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ImplicitSolver.H"
+
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXConst.H"
+#include "WarpX.H"
+
+#include <AMReX_RealBox.H>
+
+#include <string>
+
+using namespace amrex::literals;
+
+namespace
+{
+    amrex::LinOpBCType convertFieldBCToLinOpBC ( FieldBoundaryType a_fbc )
+    {
+        switch (a_fbc) {
+            case FieldBoundaryType::Periodic: return amrex::LinOpBCType::Periodic;
+            case FieldBoundaryType::PEC:      return amrex::LinOpBCType::Dirichlet;
+            case FieldBoundaryType::PMC:      return amrex::LinOpBCType::symmetry;
+            default:
+                WARPX_ABORT_WITH_MESSAGE(
+                    "The field boundary conditions of the implicit solver preconditioner must be "
+                    "periodic, pec or pmc");
+        }
+        return amrex::LinOpBCType::bogus;
+    }
+}
+
+const amrex::Geometry& ImplicitSolver::GetGeometry ( const int a_lev ) const
+{
+    return m_WarpX->Geom(a_lev);
+}
+
+amrex::Array<amrex::LinOpBCType,AMREX_SPACEDIM> ImplicitSolver::GetLinOpBCLo () const
+{
+    amrex::Array<amrex::LinOpBCType,AMREX_SPACEDIM> lbc;
+    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
+        lbc[i] = convertFieldBCToLinOpBC(WarpX::field_boundary_lo[i]);
+    }
+    return lbc;
+}
+
+amrex::Array<amrex::LinOpBCType,AMREX_SPACEDIM> ImplicitSolver::GetLinOpBCHi () const
+{
+    amrex::Array<amrex::LinOpBCType,AMREX_SPACEDIM> hbc;
+    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
+        hbc[i] = convertFieldBCToLinOpBC(WarpX::field_boundary_hi[i]);
+    }
+    return hbc;
+}
+
+amrex::Real ImplicitSolver::MeanPlasmaFrequencySquared () const
+{
+    auto& mypc = m_WarpX->GetPartContainer();
+
+    // sum over the species of q^2/m times the number of physical particles
+    amrex::Real sum = 0.0_rt;
+    for (int i_s = 0; i_s < mypc.nSpecies(); ++i_s) {
+        auto& pc = mypc.GetParticleContainer(i_s);
+        const amrex::Real mass = pc.getMass();
+        if (mass <= 0.0_rt) { continue; }
+        const amrex::Real charge = pc.getCharge();
+        sum += charge*charge/mass*static_cast<amrex::Real>(pc.sumParticleWeight(false));
+    }
+
+    const amrex::RealBox& prob_domain = GetGeometry(0).ProbDomain();
+#if defined(WARPX_DIM_RZ)
+    const amrex::Real volume = MathConst::pi*(prob_domain.hi(0)*prob_domain.hi(0) -
+                                              prob_domain.lo(0)*prob_domain.lo(0))*
+                               (prob_domain.hi(1) - prob_domain.lo(1));
+#else
+    const amrex::Real volume = prob_domain.volume();
+#endif
+
+    return sum/(PhysConst::ep0*volume);
+}
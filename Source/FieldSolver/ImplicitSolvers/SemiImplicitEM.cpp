@@ -115,3 +115,14 @@ void SemiImplicitEM::ComputeRHS ( WarpXSolverVec&  a_RHS,
     // RHS = cvac^2*0.5*dt*( curl(B^{n+1/2}) - mu0*J^{n+1/2} )
     m_WarpX->ImplicitComputeRHSE(0.5_rt*a_dt, a_RHS);
 }
+
+void SemiImplicitEM::GetPreconditionerTimeFactors ( const amrex::Real   a_dt,
+                                                          amrex::Real&  a_curl_curl_dt2,
+                                                          amrex::Real&  a_mass_dt2 ) const
+{
+    // B^{n+1/2} does not depend on E^{n+1/2}, and
+    // RHS = cvac^2*0.5*dt*( curl(B^{n+1/2}) - mu0*J^{n+1/2} ),
+    // where J^{n+1/2} responds to E^{n+1/2} through the velocity push over dt/2
+    a_curl_curl_dt2 = 0._rt;
+    a_mass_dt2 = 0.25_rt*a_dt*a_dt;
+}
@@ -141,6 +141,18 @@ void ThetaImplicitEM::ComputeRHS ( WarpXSolverVec&  a_RHS,
     m_WarpX->ImplicitComputeRHSE(m_theta*a_dt, a_RHS);
 }
 
+void ThetaImplicitEM::GetPreconditionerTimeFactors ( const amrex::Real   a_dt,
+                                                           amrex::Real&  a_curl_curl_dt2,
+                                                           amrex::Real&  a_mass_dt2 ) const
+{
+    // B^{n+theta} = B^n - theta*dt*curl(E^{n+theta}), and
+    // RHS = cvac^2*theta*dt*( curl(B^{n+theta}) - mu0*J^{n+1/2} ),
+    // where J^{n+1/2} responds to E^{n+theta} through the velocity push over dt/2
+    const amrex::Real theta_dt = m_theta*a_dt;
+    a_curl_curl_dt2 = theta_dt*theta_dt;
+    a_mass_dt2 = theta_dt*0.5_rt*a_dt;
+}
+
 void ThetaImplicitEM::UpdateWarpXFields ( const WarpXSolverVec&  a_E,
                                           amrex::Real            a_time,
                                           amrex::Real            a_dt )
@@ -115,64 +115,11 @@ WarpX::SaveParticlesAtImplicitStepStart ( )
     // The implicit advance routines require the particle velocity
     // and position values at the beginning of the step to compute the
     // time-centered position and velocity needed for the implicit stencil.
-    // Thus, we need to save this information.
+    // Thus, we need to save this information. It is saved as the difference
+    // with the current values, which is zero at this point.
 
     for (auto const& pc : *mypc) {
-
-        for (int lev = 0; lev <= finest_level; ++lev) {
-#ifdef AMREX_USE_OMP
-#pragma omp parallel
-#endif
-            {
-
-            auto particle_comps = pc->getParticleComps();
-
-            for (WarpXParIter pti(*pc, lev); pti.isValid(); ++pti) {
-
-                const auto getPosition = GetParticlePosition(pti);
-
-                auto& attribs = pti.GetAttribs();
-                amrex::ParticleReal* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr();
-                amrex::ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr();
-                amrex::ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr();
-
-#if (AMREX_SPACEDIM >= 2)
-                amrex::ParticleReal* x_n = pti.GetAttribs(particle_comps["x_n"]).dataPtr();
-#endif
-#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-                amrex::ParticleReal* y_n = pti.GetAttribs(particle_comps["y_n"]).dataPtr();
-#endif
-                amrex::ParticleReal* z_n = pti.GetAttribs(particle_comps["z_n"]).dataPtr();
-                amrex::ParticleReal* ux_n = pti.GetAttribs(particle_comps["ux_n"]).dataPtr();
-                amrex::ParticleReal* uy_n = pti.GetAttribs(particle_comps["uy_n"]).dataPtr();
-                amrex::ParticleReal* uz_n = pti.GetAttribs(particle_comps["uz_n"]).dataPtr();
-
-                const long np = pti.numParticles();
-
-                amrex::ParallelFor( np, [=] AMREX_GPU_DEVICE (long ip)
-                {
-                    amrex::ParticleReal xp, yp, zp;
-                    getPosition(ip, xp, yp, zp);
-
-#if (AMREX_SPACEDIM >= 2)
-                    x_n[ip] = xp;
-#endif
-#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-                    y_n[ip] = yp;
-#endif
-                    z_n[ip] = zp;
-
-                    ux_n[ip] = ux[ip];
-                    uy_n[ip] = uy[ip];
-                    uz_n[ip] = uz[ip];
-
-                });
-
-            }
-            }
-
-        }
-
+        pc->AllocateImplicitState();
     }
 
 }
@@ -180,8 +127,6 @@ WarpX::SaveParticlesAtImplicitStepStart ( )
 void
 WarpX::FinishImplicitParticleUpdate ()
 {
-    using namespace amrex::literals;
-
     // The implicit advance routines use the time-centered position and
     // momentum to advance the system in time. Thus, at the end of the
     // step we need to transform the particle postion and momentum from
@@ -193,10 +138,6 @@ WarpX::FinishImplicitParticleUpdate ()
 #ifdef AMREX_USE_OMP
 #pragma omp parallel
 #endif
-            {
-
-            auto particle_comps = pc->getParticleComps();
-
             for (WarpXParIter pti(*pc, lev); pti.isValid(); ++pti) {
 
                 const auto getPosition = GetParticlePosition(pti);
@@ -207,16 +148,18 @@ WarpX::FinishImplicitParticleUpdate ()
                 amrex::ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr();
                 amrex::ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr();
 
+                // Differences between the values at the start of the step and at n+1/2
+                auto& state = pc->getImplicitState(lev, pti.GetPairIndex());
 #if (AMREX_SPACEDIM >= 2)
-                amrex::ParticleReal* x_n = pti.GetAttribs(particle_comps["x_n"]).dataPtr();
+                const float* const AMREX_RESTRICT dx_n = state[ImplicitIdx::dx_n].dataPtr();
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-                amrex::ParticleReal* y_n = pti.GetAttribs(particle_comps["y_n"]).dataPtr();
+                const float* const AMREX_RESTRICT dy_n = state[ImplicitIdx::dy_n].dataPtr();
 #endif
-                amrex::ParticleReal* z_n = pti.GetAttribs(particle_comps["z_n"]).dataPtr();
-                amrex::ParticleReal* ux_n = pti.GetAttribs(particle_comps["ux_n"]).dataPtr();
-                amrex::ParticleReal* uy_n = pti.GetAttribs(particle_comps["uy_n"]).dataPtr();
-                amrex::ParticleReal* uz_n = pti.GetAttribs(particle_comps["uz_n"]).dataPtr();
+                const float* const AMREX_RESTRICT dz_n = state[ImplicitIdx::dz_n].dataPtr();
+                const float* const AMREX_RESTRICT dux_n = state[ImplicitIdx::dux_n].dataPtr();
+                const float* const AMREX_RESTRICT duy_n = state[ImplicitIdx::duy_n].dataPtr();
+                const float* const AMREX_RESTRICT duz_n = state[ImplicitIdx::duz_n].dataPtr();
 
                 const long np = pti.numParticles();
 
@@ -225,26 +168,27 @@ WarpX::FinishImplicitParticleUpdate ()
                     amrex::ParticleReal xp, yp, zp;
                     getPosition(ip, xp, yp, zp);
 
+                    // x^{n+1} = 2 x^{n+1/2} - x^{n}, with x^{n} = x^{n+1/2} + dx_n
 #if (AMREX_SPACEDIM >= 2)
-                    xp = 2._rt*xp - x_n[ip];
+                    xp = xp - dx_n[ip];
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-                    yp = 2._rt*yp - y_n[ip];
+                    yp = yp - dy_n[ip];
 #endif
-                    zp = 2._rt*zp - z_n[ip];
+                    zp = zp - dz_n[ip];
 
-                    ux[ip] = 2._rt*ux[ip] - ux_n[ip];
-                    uy[ip] = 2._rt*uy[ip] - uy_n[ip];
-                    uz[ip] = 2._rt*uz[ip] - uz_n[ip];
+                    ux[ip] = ux[ip] - dux_n[ip];
+                    uy[ip] = uy[ip] - duy_n[ip];
+                    uz[ip] = uz[ip] - duz_n[ip];
 
                     setPosition(ip, xp, yp, zp);
                 });
 
             }
-            }
 
         }
 
+        pc->FreeImplicitState();
     }
 
 }
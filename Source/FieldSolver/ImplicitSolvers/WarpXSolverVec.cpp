@@ -6,6 +6,14 @@
  */
 #include "FieldSolver/ImplicitSolvers/WarpXSolverVec.H"
 
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Tuple.H>
+
+#include <algorithm>
+
 void WarpXSolverVec::SetDotMask( const amrex::Vector<amrex::Geometry>&  a_Geom )
 {
     if (m_dot_mask_defined) { return; }
@@ -30,22 +38,126 @@ void WarpXSolverVec::SetDotMask( const amrex::Vector<amrex::Geometry>&  a_Geom )
 }
 
 [[nodiscard]] amrex::Real WarpXSolverVec::dotProduct ( const WarpXSolverVec&  a_X ) const
+{
+    amrex::Vector<RT> result;
+    multiDotProduct({&a_X}, result);
+    return result[0];
+}
+
+void WarpXSolverVec::multiDotProduct ( const amrex::Vector<const WarpXSolverVec*>&  a_X,
+                                       amrex::Vector<RT>&                           a_result ) const
 {
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         m_dot_mask_defined,
-        "WarpXSolverVec::dotProduct called with m_dotMask not yet defined");
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-        a_X.IsDefined(),
-        "WarpXSolverVec::dotProduct(a_X) called with undefined a_X");
-    amrex::Real result = 0.0;
+        "WarpXSolverVec::multiDotProduct called with m_dotMask not yet defined");
+    const int nvec = static_cast<int>(a_X.size());
+    for (const auto* X : a_X) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            X->IsDefined(),
+            "WarpXSolverVec::multiDotProduct(a_X) called with undefined a_X");
+    }
+    a_result.assign(nvec, 0.0);
+    if (nvec == 0) { return; }
+
+    const int lev = 0;
+    for (int ivec0 = 0; ivec0 < nvec; ivec0 += m_batch_size) {
+        const int nbatch = std::min(m_batch_size, nvec - ivec0);
+
+        // local dot products of a batch of vectors, in one sweep over this vector
+        amrex::ReduceOps<amrex::ReduceOpSum, amrex::ReduceOpSum,
+                         amrex::ReduceOpSum, amrex::ReduceOpSum> reduce_ops;
+        amrex::ReduceData<RT, RT, RT, RT> reduce_data(reduce_ops);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+
+        for (int n = 0; n < 3; ++n) {
+            const amrex::MultiFab& Y = *m_field_vec[lev][n];
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+            for (amrex::MFIter mfi(Y, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                const amrex::Box& bx = mfi.tilebox();
+                auto const& mask = m_dotMask[lev][n]->const_array(mfi);
+                auto const& y = Y.const_array(mfi);
+                // unused slots of the batch repeat the last vector, and are discarded
+                amrex::GpuArray<amrex::Array4<RT const>, m_batch_size> x;
+                for (int ib = 0; ib < m_batch_size; ++ib) {
+                    x[ib] = a_X[ivec0 + std::min(ib, nbatch-1)]->getVec()[lev][n]->const_array(mfi);
+                }
+                reduce_ops.eval(bx, reduce_data,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+                {
+                    const RT ym = mask(i,j,k) ? y(i,j,k) : RT(0.0);
+                    return {ym*x[0](i,j,k), ym*x[1](i,j,k), ym*x[2](i,j,k), ym*x[3](i,j,k)};
+                });
+            }
+        }
+
+        auto hv = reduce_data.value(reduce_ops);
+        const amrex::GpuArray<RT, m_batch_size> local_result =
+            {amrex::get<0>(hv), amrex::get<1>(hv), amrex::get<2>(hv), amrex::get<3>(hv)};
+        for (int ib = 0; ib < nbatch; ++ib) {
+            a_result[ivec0 + ib] = local_result[ib];
+        }
+    }
+
+    amrex::ParallelAllReduce::Sum(a_result.data(), nvec, amrex::ParallelContext::CommunicatorSub());
+}
+
+void WarpXSolverVec::linComb ( const RT a, const WarpXSolverVec& X,
+                               const RT b, const WarpXSolverVec& Y,
+                               const RT c, const WarpXSolverVec& Z )
+{
     const int lev = 0;
-    const bool local = true;
     for (int n = 0; n < 3; ++n) {
-        auto rtmp = amrex::MultiFab::Dot( *m_dotMask[lev][n],
-                                          *m_field_vec[lev][n], 0,
-                                          *a_X.getVec()[lev][n], 0, 1, 0, local);
-        result += rtmp;
+        amrex::MultiFab& W = *m_field_vec[lev][n];
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (amrex::MFIter mfi(W, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+            const amrex::Box& bx = mfi.tilebox();
+            auto const& w = W.array(mfi);
+            auto const& x = X.getVec()[lev][n]->const_array(mfi);
+            auto const& y = Y.getVec()[lev][n]->const_array(mfi);
+            auto const& z = Z.getVec()[lev][n]->const_array(mfi);
+            amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                w(i,j,k) = a*x(i,j,k) + b*y(i,j,k) + c*z(i,j,k);
+            });
+        }
+    }
+}
+
+void WarpXSolverVec::multiIncrement ( const amrex::Vector<const WarpXSolverVec*>& X,
+                                      const amrex::Vector<RT>& a )
+{
+    AMREX_ASSERT(X.size() == a.size());
+    const int nvec = static_cast<int>(X.size());
+    const int lev = 0;
+    for (int ivec0 = 0; ivec0 < nvec; ivec0 += m_batch_size) {
+        const int nbatch = std::min(m_batch_size, nvec - ivec0);
+        // unused slots of the batch have a zero coefficient
+        amrex::GpuArray<RT, m_batch_size> coef;
+        for (int ib = 0; ib < m_batch_size; ++ib) {
+            coef[ib] = (ib < nbatch) ? a[ivec0 + ib] : RT(0.0);
+        }
+        for (int n = 0; n < 3; ++n) {
+            amrex::MultiFab& Y = *m_field_vec[lev][n];
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+            for (amrex::MFIter mfi(Y, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                const amrex::Box& bx = mfi.tilebox();
+                auto const& y = Y.array(mfi);
+                amrex::GpuArray<amrex::Array4<RT const>, m_batch_size> x;
+                for (int ib = 0; ib < m_batch_size; ++ib) {
+                    x[ib] = X[ivec0 + std::min(ib, nbatch-1)]->getVec()[lev][n]->const_array(mfi);
+                }
+                amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+                {
+                    y(i,j,k) += coef[0]*x[0](i,j,k) + coef[1]*x[1](i,j,k)
+                              + coef[2]*x[2](i,j,k) + coef[3]*x[3](i,j,k);
+                });
+            }
+        }
     }
-    amrex::ParallelAllReduce::Sum(result, amrex::ParallelContext::CommunicatorSub());
-    return result;
 }
@@ -50,15 +50,15 @@ PsatdAlgorithmComoving::PsatdAlgorithmComoving (const SpectralKSpace& spectral_k
     const BoxArray& ba = spectral_kspace.spectralspace_ba;
 
     // Allocate arrays of real spectral coefficients
-    C_coef    = SpectralRealCoefficients(ba, dm, 1, 0);
-    S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0);
+    C_coef    = SpectralRealCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+    S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
 
     // Allocate arrays of complex spectral coefficients
-    X1_coef     = SpectralComplexCoefficients(ba, dm, 1, 0);
-    X2_coef     = SpectralComplexCoefficients(ba, dm, 1, 0);
-    X3_coef     = SpectralComplexCoefficients(ba, dm, 1, 0);
-    X4_coef     = SpectralComplexCoefficients(ba, dm, 1, 0);
-    Theta2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+    X1_coef     = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+    X2_coef     = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+    X3_coef     = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+    X4_coef     = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+    Theta2_coef = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
 
     // Initialize real and complex spectral coefficients
     InitializeSpectralCoefficients(spectral_kspace, dm, dt);
@@ -67,17 +67,17 @@ PsatdAlgorithmJConstantInTime::PsatdAlgorithmJConstantInTime(
     const amrex::BoxArray& ba = spectral_kspace.spectralspace_ba;
 
     // Always allocate these coefficients
-    C_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    X1_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-    X2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-    X3_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+    C_coef = SpectralRealCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+    S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+    X1_coef = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+    X2_coef = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+    X3_coef = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
 
     // Allocate these coefficients only with Galilean PSATD
     if (m_is_galilean)
     {
-        X4_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-        T2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+        X4_coef = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+        T2_coef = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
     }
 
     InitializeSpectralCoefficients(spectral_kspace, dm, dt);
@@ -85,12 +85,12 @@ PsatdAlgorithmJConstantInTime::PsatdAlgorithmJConstantInTime(
     // Allocate these coefficients only with time averaging
     if (time_averaging)
     {
-        Psi1_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-        Psi2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-        Y1_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-        Y3_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-        Y2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-        Y4_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+        Psi1_coef = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+        Psi2_coef = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+        Y1_coef = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+        Y3_coef = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+        Y2_coef = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+        Y4_coef = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
         InitializeSpectralCoefficientsAveraging(spectral_kspace, dm, dt);
     }
 
@@ -50,19 +50,19 @@ PsatdAlgorithmJLinearInTime::PsatdAlgorithmJLinearInTime(
     const amrex::BoxArray& ba = spectral_kspace.spectralspace_ba;
 
     // Always allocate these coefficients
-    C_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    X1_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    X2_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    X3_coef = SpectralRealCoefficients(ba, dm, 1, 0);
+    C_coef = SpectralRealCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+    S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+    X1_coef = SpectralRealCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+    X2_coef = SpectralRealCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+    X3_coef = SpectralRealCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
 
     InitializeSpectralCoefficients(spectral_kspace, dm, dt);
 
     // Allocate these coefficients only with time averaging
     if (time_averaging)
     {
-        X5_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-        X6_coef = SpectralRealCoefficients(ba, dm, 1, 0);
+        X5_coef = SpectralRealCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+        X6_coef = SpectralRealCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
         InitializeSpectralCoefficientsAveraging(spectral_kspace, dm, dt);
     }
 }
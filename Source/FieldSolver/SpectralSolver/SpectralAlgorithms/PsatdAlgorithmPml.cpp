@@ -62,14 +62,14 @@ PsatdAlgorithmPml::PsatdAlgorithmPml(
     const BoxArray& ba = spectral_kspace.spectralspace_ba;
 
     // Allocate arrays of coefficients
-    C_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    inv_k2_coef = SpectralRealCoefficients(ba, dm, 1, 0);
+    C_coef = SpectralRealCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+    S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
+    inv_k2_coef = SpectralRealCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
 
     // Allocate this coefficient only with Galilean PSATD
     if (m_is_galilean)
     {
-        T2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+        T2_coef = SpectralComplexCoefficients(ba, dm, 1, 0, m_equivalent_boxes);
     }
 
     InitializeSpectralCoefficients(spectral_kspace, dm);
@@ -33,6 +33,7 @@ SpectralBaseAlgorithm::SpectralBaseAlgorithm(const SpectralKSpace& spectral_kspa
     const int norder_x, const int norder_y,
     const int norder_z, const short grid_type):
         m_spectral_index(spectral_index),
+        m_equivalent_boxes(spectral_kspace.equivalentBoxes()),
     // Compute and assign the modified k vectors
         modified_kx_vec(spectral_kspace.getModifiedKComponent(dm,0,norder_x,grid_type)),
 #if defined(WARPX_DIM_3D)
@@ -7,6 +7,7 @@
  */
 #include "SpectralFieldData.H"
 
+#include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXUtil.H"
 #include "WarpX.H"
@@ -25,10 +26,15 @@
 #include <AMReX_IntVect.H>
 #include <AMReX_LayoutData.H>
 #include <AMReX_MFIter.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Utility.H>
 
+#include <array>
+#include <complex>
+#include <memory>
+
 #if WARPX_USE_FFT
 
 using namespace amrex;
@@ -122,12 +128,30 @@ SpectralFieldData::SpectralFieldData( const int lev,
                                       const SpectralKSpace& k_space,
                                       const amrex::DistributionMapping& dm,
                                       const int n_field_required,
-                                      const bool periodic_single_box):
-    m_periodic_single_box{periodic_single_box}
+                                      const bool periodic_single_box,
+                                      const bool batch_current_and_rho):
+    m_periodic_single_box{periodic_single_box},
+    m_batched_fft{WarpX::fft_do_batched && !k_space.isDistributed()},
+    m_distributed{k_space.isDistributed()}
 {
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
     const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, realspace_ba, dm);
 
+    if (m_distributed)
+    {
+#ifndef WARPX_USE_HEFFTE
+        WARPX_ABORT_WITH_MESSAGE(
+            "psatd.distributed_fft requires WarpX to be built with heFFTe (WarpX_HEFFTE=ON)");
+#endif
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_periodic_single_box,
+            "The distributed FFT is only implemented for FFTs without guard cells");
+        int n_local_boxes = 0;
+        for ( MFIter mfi(realspace_ba, dm); mfi.isValid(); ++mfi ){ ++n_local_boxes; }
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(n_local_boxes == 1,
+            "psatd.distributed_fft requires exactly one box per MPI rank");
+        m_global_npts = k_space.globalDomain().numPts();
+    }
+
     const BoxArray& spectralspace_ba = k_space.spectralspace_ba;
 
     // Allocate the arrays that contain the fields in spectral space
@@ -136,8 +160,14 @@ SpectralFieldData::SpectralFieldData( const int lev,
 
     // Allocate temporary arrays - in real space and spectral space
     // These arrays will store the data just before/after the FFT
-    tmpRealField = MultiFab(realspace_ba, dm, 1, 0);
-    tmpSpectralField = SpectralField(spectralspace_ba, dm, 1, 0);
+    // (three components when the FFTs of vector fields are batched, four when the
+    // current and the charge density are also transformed together,
+    // the plans of fewer fields then only use the first components)
+    if (m_batched_fft) {
+        m_n_tmp_comps = batch_current_and_rho ? 4 : 3;
+    }
+    tmpRealField = MultiFab(realspace_ba, dm, m_n_tmp_comps, 0);
+    tmpSpectralField = SpectralField(spectralspace_ba, dm, m_n_tmp_comps, 0);
 
     // By default, we assume the FFT is done from/to a nodal grid in real space
     // If the FFT is performed from/to a cell-centered grid in real space,
@@ -163,8 +193,16 @@ SpectralFieldData::SpectralFieldData( const int lev,
 #endif
 
     // Allocate and initialize the FFT plans
+    // (for the distributed FFT, one plan shared by all MPI ranks)
     forward_plan = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
     backward_plan = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
+    if (m_batched_fft) {
+        forward_plan_batched = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
+        backward_plan_batched = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
+        if (m_n_tmp_comps == 4) {
+            forward_plan_batched4 = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
+        }
+    }
     // Loop over boxes and allocate the corresponding plan
     // for each box owned by the local MPI proc
     for ( MFIter mfi(spectralspace_ba, dm); mfi.isValid(); ++mfi ){
@@ -179,6 +217,38 @@ SpectralFieldData::SpectralFieldData( const int lev,
         // the FFT plan, the valid dimensions are those of the real-space box.
         const IntVect fft_size = realspace_ba[mfi].length();
 
+        if (m_distributed) {
+#ifdef WARPX_USE_HEFFTE
+            // heFFTe boxes are always three-dimensional, with the first index
+            // running fastest (as for AMReX arrays) and global indices starting at 0
+            const Box& domain = k_space.globalDomain();
+            const Box spectral_bx = k_space.globalSpectralBox(mfi.index());
+            std::array<int,3> in_lo{0,0,0}, in_hi{0,0,0}, out_lo{0,0,0}, out_hi{0,0,0};
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                in_lo[idim] = realspace_ba[mfi].smallEnd(idim) - domain.smallEnd(idim);
+                in_hi[idim] = realspace_ba[mfi].bigEnd(idim) - domain.smallEnd(idim);
+                out_lo[idim] = spectral_bx.smallEnd(idim);
+                out_hi[idim] = spectral_bx.bigEnd(idim);
+            }
+            const heffte::box3d<> inbox(in_lo, in_hi);
+            const heffte::box3d<> outbox(out_lo, out_hi);
+            // The real-to-complex FFT halves the first direction
+            const int r2c_direction = 0;
+            m_distributed_plan = std::make_unique<heffte::fft3d_r2c<heffte_backend>>(
+#   ifdef AMREX_USE_GPU
+                amrex::Gpu::gpuStream(),
+#   endif
+                inbox, outbox, r2c_direction, amrex::ParallelDescriptor::Communicator());
+#endif
+            if (do_costs)
+            {
+                amrex::Gpu::synchronize();
+                wt = static_cast<amrex::Real>(amrex::second()) - wt;
+                amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            }
+            continue;
+        }
+
         forward_plan[mfi] = ablastr::math::anyfft::CreatePlan(
             fft_size, tmpRealField[mfi].dataPtr(),
             reinterpret_cast<ablastr::math::anyfft::Complex*>( tmpSpectralField[mfi].dataPtr()),
@@ -189,6 +259,25 @@ SpectralFieldData::SpectralFieldData( const int lev,
             reinterpret_cast<ablastr::math::anyfft::Complex*>( tmpSpectralField[mfi].dataPtr()),
             ablastr::math::anyfft::direction::C2R, AMREX_SPACEDIM);
 
+        if (m_batched_fft) {
+            forward_plan_batched[mfi] = ablastr::math::anyfft::CreatePlan(
+                fft_size, tmpRealField[mfi].dataPtr(),
+                reinterpret_cast<ablastr::math::anyfft::Complex*>( tmpSpectralField[mfi].dataPtr()),
+                ablastr::math::anyfft::direction::R2C, AMREX_SPACEDIM, 3);
+
+            backward_plan_batched[mfi] = ablastr::math::anyfft::CreatePlan(
+                fft_size, tmpRealField[mfi].dataPtr(),
+                reinterpret_cast<ablastr::math::anyfft::Complex*>( tmpSpectralField[mfi].dataPtr()),
+                ablastr::math::anyfft::direction::C2R, AMREX_SPACEDIM, 3);
+
+            if (m_n_tmp_comps == 4) {
+                forward_plan_batched4[mfi] = ablastr::math::anyfft::CreatePlan(
+                    fft_size, tmpRealField[mfi].dataPtr(),
+                    reinterpret_cast<ablastr::math::anyfft::Complex*>( tmpSpectralField[mfi].dataPtr()),
+                    ablastr::math::anyfft::direction::R2C, AMREX_SPACEDIM, 4);
+            }
+        }
+
         if (do_costs)
         {
             amrex::Gpu::synchronize();
@@ -201,10 +290,17 @@ SpectralFieldData::SpectralFieldData( const int lev,
 
 SpectralFieldData::~SpectralFieldData()
 {
-    if (!tmpRealField.empty()){
+    if (!tmpRealField.empty() && !m_distributed){
         for ( MFIter mfi(tmpRealField); mfi.isValid(); ++mfi ){
             ablastr::math::anyfft::DestroyPlan(forward_plan[mfi]);
             ablastr::math::anyfft::DestroyPlan(backward_plan[mfi]);
+            if (m_batched_fft) {
+                ablastr::math::anyfft::DestroyPlan(forward_plan_batched[mfi]);
+                ablastr::math::anyfft::DestroyPlan(backward_plan_batched[mfi]);
+                if (m_n_tmp_comps == 4) {
+                    ablastr::math::anyfft::DestroyPlan(forward_plan_batched4[mfi]);
+                }
+            }
         }
     }
 }
@@ -220,19 +316,6 @@ SpectralFieldData::ForwardTransform (const int lev,
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
     const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf.boxArray(), mf.DistributionMap());
 
-    // Check field index type, in order to apply proper shift in spectral space
-#if (AMREX_SPACEDIM >= 2)
-    const bool is_nodal_x = mf.is_nodal(0);
-#endif
-#if defined(WARPX_DIM_3D)
-    const bool is_nodal_y = mf.is_nodal(1);
-    const bool is_nodal_z = mf.is_nodal(2);
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-    const bool is_nodal_z = mf.is_nodal(1);
-#elif defined(WARPX_DIM_1D_Z)
-    const bool is_nodal_z = mf.is_nodal(0);
-#endif
-
     // Loop over boxes
     // Note: we do NOT OpenMP parallelize here, since we use OpenMP threads for
     //       the FFTs on each box!
@@ -243,66 +326,80 @@ SpectralFieldData::ForwardTransform (const int lev,
         }
         auto wt = static_cast<amrex::Real>(amrex::second());
 
-        // Copy the real-space field `mf` to the temporary field `tmpRealField`
-        // This ensures that all fields have the same number of points
-        // before the Fourier transform.
-        // As a consequence, the copy discards the *last* point of `mf`
-        // in any direction that has *nodal* index type.
+        CopyRealToTmp(mfi, mf, i_comp, 0);
+
+        // Perform Fourier transform from `tmpRealField` to `tmpSpectralField`
+        ExecuteForward(mfi);
+
+        CopyTmpToSpectral(mfi, mf, field_index, 0);
+
+        if (do_costs)
         {
-            Box realspace_bx;
-            if (m_periodic_single_box) {
-                realspace_bx = mfi.validbox(); // Discard guard cells
-            } else {
-                realspace_bx = mf[mfi].box(); // Keep guard cells
-            }
-            realspace_bx.enclosedCells(); // Discard last point in nodal direction
-            AMREX_ALWAYS_ASSERT( realspace_bx.contains(tmpRealField[mfi].box()) );
-            const Array4<const Real> mf_arr = mf[mfi].array();
-            const Array4<Real> tmp_arr = tmpRealField[mfi].array();
-            ParallelFor( tmpRealField[mfi].box(),
-            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                tmp_arr(i,j,k) = mf_arr(i,j,k,i_comp);
-            });
+            amrex::Gpu::synchronize();
+            wt = static_cast<amrex::Real>(amrex::second()) - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
         }
+    }
+}
 
-        // Perform Fourier transform from `tmpRealField` to `tmpSpectralField`
-        ablastr::math::anyfft::Execute(forward_plan[mfi]);
+/* \brief Transform the components `i_comp` of the three MultiFabs `mf`
+ *  to spectral space with one batched FFT per box, and store the results
+ *  internally (in the spectral fields specified by `field_index`) */
+void
+SpectralFieldData::ForwardTransform (const int lev,
+                                     const std::array<const amrex::MultiFab*,3>& mf,
+                                     const std::array<int,3>& field_index,
+                                     const std::array<int,3>& i_comp)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_batched_fft,
+        "SpectralFieldData: batched FFT plans were not allocated");
+    ForwardTransformBatched(lev, 3, mf.data(), field_index.data(), i_comp.data(),
+                            forward_plan_batched);
+}
+
+/* \brief Transform the components `i_comp` of the four MultiFabs `mf`
+ *  to spectral space with one batched FFT per box, and store the results
+ *  internally (in the spectral fields specified by `field_index`) */
+void
+SpectralFieldData::ForwardTransform (const int lev,
+                                     const std::array<const amrex::MultiFab*,4>& mf,
+                                     const std::array<int,4>& field_index,
+                                     const std::array<int,4>& i_comp)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(hasBatchedFFT4(),
+        "SpectralFieldData: batched FFT plans of four fields were not allocated");
+    ForwardTransformBatched(lev, 4, mf.data(), field_index.data(), i_comp.data(),
+                            forward_plan_batched4);
+}
 
-        // Copy the spectral-space field `tmpSpectralField` to the appropriate
-        // index of the FabArray `fields` (specified by `field_index`)
-        // and apply correcting shift factor if the real space data comes
-        // from a cell-centered grid in real space instead of a nodal grid.
+void
+SpectralFieldData::ForwardTransformBatched (const int lev, const int n,
+                                            const amrex::MultiFab* const* mf,
+                                            const int* field_index, const int* i_comp,
+                                            ablastr::math::anyfft::FFTplans& fft_plans)
+{
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf[0]->boxArray(), mf[0]->DistributionMap());
+
+    // Loop over boxes
+    // Note: we do NOT OpenMP parallelize here, since we use OpenMP threads for
+    //       the FFTs on each box!
+    for ( MFIter mfi(*mf[0]); mfi.isValid(); ++mfi ){
+        if (do_costs)
         {
-            const Array4<Complex> fields_arr = SpectralFieldData::fields[mfi].array();
-            const Array4<const Complex> tmp_arr = tmpSpectralField[mfi].array();
-#if (AMREX_SPACEDIM >= 2)
-            const Complex* xshift_arr = xshift_FFTfromCell[mfi].dataPtr();
-#endif
-#if defined(WARPX_DIM_3D)
-            const Complex* yshift_arr = yshift_FFTfromCell[mfi].dataPtr();
-#endif
-            const Complex* zshift_arr = zshift_FFTfromCell[mfi].dataPtr();
-            // Loop over indices within one box
-            const Box spectralspace_bx = tmpSpectralField[mfi].box();
-
-            ParallelFor( spectralspace_bx,
-            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                Complex spectral_field_value = tmp_arr(i,j,k);
-                // Apply proper shift in each dimension
-#if (AMREX_SPACEDIM >= 2)
-                if (!is_nodal_x) { spectral_field_value *= xshift_arr[i]; }
-#endif
-#if defined(WARPX_DIM_3D)
-                if (!is_nodal_y) { spectral_field_value *= yshift_arr[j]; }
-                if (!is_nodal_z) { spectral_field_value *= zshift_arr[k]; }
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-                if (!is_nodal_z) { spectral_field_value *= zshift_arr[j]; }
-#elif defined(WARPX_DIM_1D_Z)
-                if (!is_nodal_z) { spectral_field_value *= zshift_arr[i]; }
-#endif
-                // Copy field into the right index
-                fields_arr(i,j,k,field_index) = spectral_field_value;
-            });
+            amrex::Gpu::synchronize();
+        }
+        auto wt = static_cast<amrex::Real>(amrex::second());
+
+        for (int c = 0; c < n; ++c) {
+            CopyRealToTmp(mfi, *mf[c], i_comp[c], c);
+        }
+
+        // Perform the n Fourier transforms from `tmpRealField` to `tmpSpectralField`
+        ablastr::math::anyfft::Execute(fft_plans[mfi]);
+
+        for (int c = 0; c < n; ++c) {
+            CopyTmpToSpectral(mfi, *mf[c], field_index[c], c);
         }
 
         if (do_costs)
@@ -327,6 +424,137 @@ SpectralFieldData::BackwardTransform (const int lev,
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
     const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf.boxArray(), mf.DistributionMap());
 
+    // Loop over boxes
+    // Note: we do NOT OpenMP parallelize here, since we use OpenMP threads for
+    //       the iFFTs on each box!
+    for ( MFIter mfi(mf); mfi.isValid(); ++mfi ){
+        if (do_costs)
+        {
+            amrex::Gpu::synchronize();
+        }
+        auto wt = static_cast<amrex::Real>(amrex::second());
+
+        CopySpectralToTmp(mfi, mf, field_index, 0);
+
+        // Perform Fourier transform from `tmpSpectralField` to `tmpRealField`
+        ExecuteBackward(mfi);
+
+        CopyTmpToReal(mfi, mf, fill_guards, i_comp, 0);
+
+        if (do_costs)
+        {
+            amrex::Gpu::synchronize();
+            wt = static_cast<amrex::Real>(amrex::second()) - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
+    }
+}
+
+/* \brief Transform the three spectral fields specified by `field_index` back
+ * to real space with one batched FFT per box, and store them in the
+ * components `i_comp` of the three MultiFabs `mf` */
+void
+SpectralFieldData::BackwardTransform (const int lev,
+                                      const std::array<amrex::MultiFab*,3>& mf,
+                                      const std::array<int,3>& field_index,
+                                      const amrex::IntVect& fill_guards,
+                                      const std::array<int,3>& i_comp)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_batched_fft,
+        "SpectralFieldData: batched FFT plans were not allocated");
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf[0]->boxArray(), mf[0]->DistributionMap());
+
+    // Loop over boxes
+    // Note: we do NOT OpenMP parallelize here, since we use OpenMP threads for
+    //       the iFFTs on each box!
+    for ( MFIter mfi(*mf[0]); mfi.isValid(); ++mfi ){
+        if (do_costs)
+        {
+            amrex::Gpu::synchronize();
+        }
+        auto wt = static_cast<amrex::Real>(amrex::second());
+
+        for (int c = 0; c < 3; ++c) {
+            CopySpectralToTmp(mfi, *mf[c], field_index[c], c);
+        }
+
+        // Perform the three Fourier transforms from `tmpSpectralField` to `tmpRealField`
+        ablastr::math::anyfft::Execute(backward_plan_batched[mfi]);
+
+        for (int c = 0; c < 3; ++c) {
+            CopyTmpToReal(mfi, *mf[c], fill_guards, i_comp[c], c);
+        }
+
+        if (do_costs)
+        {
+            amrex::Gpu::synchronize();
+            wt = static_cast<amrex::Real>(amrex::second()) - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
+    }
+}
+
+void
+SpectralFieldData::ExecuteForward (const amrex::MFIter& mfi)
+{
+#ifdef WARPX_USE_HEFFTE
+    if (m_distributed) {
+        // Collective over all MPI ranks, which own exactly one box each
+        m_distributed_plan->forward(tmpRealField[mfi].dataPtr(),
+            reinterpret_cast<std::complex<amrex::Real>*>(tmpSpectralField[mfi].dataPtr()));
+        return;
+    }
+#endif
+    ablastr::math::anyfft::Execute(forward_plan[mfi]);
+}
+
+void
+SpectralFieldData::ExecuteBackward (const amrex::MFIter& mfi)
+{
+#ifdef WARPX_USE_HEFFTE
+    if (m_distributed) {
+        // Collective over all MPI ranks, which own exactly one box each;
+        // the normalization is applied in CopyTmpToReal
+        m_distributed_plan->backward(
+            reinterpret_cast<std::complex<amrex::Real>*>(tmpSpectralField[mfi].dataPtr()),
+            tmpRealField[mfi].dataPtr());
+        return;
+    }
+#endif
+    ablastr::math::anyfft::Execute(backward_plan[mfi]);
+}
+
+void
+SpectralFieldData::CopyRealToTmp (const amrex::MFIter& mfi, const amrex::MultiFab& mf,
+                                  const int i_comp, const int tmp_comp)
+{
+    // Copy the real-space field `mf` to the temporary field `tmpRealField`
+    // This ensures that all fields have the same number of points
+    // before the Fourier transform.
+    // As a consequence, the copy discards the *last* point of `mf`
+    // in any direction that has *nodal* index type.
+    Box realspace_bx;
+    if (m_periodic_single_box) {
+        realspace_bx = mf.box(mfi.index()); // Discard guard cells
+    } else {
+        realspace_bx = mf[mfi].box(); // Keep guard cells
+    }
+    realspace_bx.enclosedCells(); // Discard last point in nodal direction
+    AMREX_ALWAYS_ASSERT( realspace_bx.contains(tmpRealField[mfi].box()) );
+    const Array4<const Real> mf_arr = mf[mfi].array();
+    const Array4<Real> tmp_arr = tmpRealField[mfi].array();
+    ParallelFor( tmpRealField[mfi].box(),
+    [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+        tmp_arr(i,j,k,tmp_comp) = mf_arr(i,j,k,i_comp);
+    });
+}
+
+void
+SpectralFieldData::CopyTmpToSpectral (const amrex::MFIter& mfi, const amrex::MultiFab& mf,
+                                      const int field_index, const int tmp_comp)
+{
     // Check field index type, in order to apply proper shift in spectral space
 #if (AMREX_SPACEDIM >= 2)
     const bool is_nodal_x = mf.is_nodal(0);
@@ -340,139 +568,189 @@ SpectralFieldData::BackwardTransform (const int lev,
     const bool is_nodal_z = mf.is_nodal(0);
 #endif
 
+    // Copy the spectral-space field `tmpSpectralField` to the appropriate
+    // index of the FabArray `fields` (specified by `field_index`)
+    // and apply correcting shift factor if the real space data comes
+    // from a cell-centered grid in real space instead of a nodal grid.
+    const Array4<Complex> fields_arr = SpectralFieldData::fields[mfi].array();
+    const Array4<const Complex> tmp_arr = tmpSpectralField[mfi].array();
 #if (AMREX_SPACEDIM >= 2)
-    const int si = (is_nodal_x) ? 1 : 0;
+    const Complex* xshift_arr = xshift_FFTfromCell[mfi].dataPtr();
 #endif
-#if   defined(WARPX_DIM_1D_Z)
-    const int si = (is_nodal_z) ? 1 : 0;
-    const int sj = 0;
-    const int sk = 0;
+#if defined(WARPX_DIM_3D)
+    const Complex* yshift_arr = yshift_FFTfromCell[mfi].dataPtr();
+#endif
+    const Complex* zshift_arr = zshift_FFTfromCell[mfi].dataPtr();
+    // Loop over indices within one box
+    const Box spectralspace_bx = tmpSpectralField[mfi].box();
+
+    ParallelFor( spectralspace_bx,
+    [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+        Complex spectral_field_value = tmp_arr(i,j,k,tmp_comp);
+        // Apply proper shift in each dimension
+#if (AMREX_SPACEDIM >= 2)
+        if (!is_nodal_x) { spectral_field_value *= xshift_arr[i]; }
+#endif
+#if defined(WARPX_DIM_3D)
+        if (!is_nodal_y) { spectral_field_value *= yshift_arr[j]; }
+        if (!is_nodal_z) { spectral_field_value *= zshift_arr[k]; }
 #elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-    const int sj = (is_nodal_z) ? 1 : 0;
-    const int sk = 0;
-#elif defined(WARPX_DIM_3D)
-    const int sj = (is_nodal_y) ? 1 : 0;
-    const int sk = (is_nodal_z) ? 1 : 0;
+        if (!is_nodal_z) { spectral_field_value *= zshift_arr[j]; }
+#elif defined(WARPX_DIM_1D_Z)
+        if (!is_nodal_z) { spectral_field_value *= zshift_arr[i]; }
 #endif
+        // Copy field into the right index
+        fields_arr(i,j,k,field_index) = spectral_field_value;
+    });
+}
 
-    // Numbers of guard cells
-    const amrex::IntVect& mf_ng = mf.nGrowVect();
-
-    // Loop over boxes
-    // Note: we do NOT OpenMP parallelize here, since we use OpenMP threads for
-    //       the iFFTs on each box!
-    for ( MFIter mfi(mf); mfi.isValid(); ++mfi ){
-        if (do_costs)
-        {
-            amrex::Gpu::synchronize();
-        }
-        auto wt = static_cast<amrex::Real>(amrex::second());
+void
+SpectralFieldData::CopySpectralToTmp (const amrex::MFIter& mfi, const amrex::MultiFab& mf,
+                                      const int field_index, const int tmp_comp)
+{
+    // Check field index type, in order to apply proper shift in spectral space
+#if (AMREX_SPACEDIM >= 2)
+    const bool is_nodal_x = mf.is_nodal(0);
+#endif
+#if defined(WARPX_DIM_3D)
+    const bool is_nodal_y = mf.is_nodal(1);
+    const bool is_nodal_z = mf.is_nodal(2);
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    const bool is_nodal_z = mf.is_nodal(1);
+#elif defined(WARPX_DIM_1D_Z)
+    const bool is_nodal_z = mf.is_nodal(0);
+#endif
 
-        // Copy the spectral-space field `tmpSpectralField` to the appropriate
-        // field (specified by the input argument field_index)
-        // and apply correcting shift factor if the field is to be transformed
-        // to a cell-centered grid in real space instead of a nodal grid.
-        {
-            const Array4<const Complex> field_arr = SpectralFieldData::fields[mfi].array();
-            const Array4<Complex> tmp_arr = tmpSpectralField[mfi].array();
+    // Copy the spectral-space field `tmpSpectralField` to the appropriate
+    // field (specified by the input argument field_index)
+    // and apply correcting shift factor if the field is to be transformed
+    // to a cell-centered grid in real space instead of a nodal grid.
+    const Array4<const Complex> field_arr = SpectralFieldData::fields[mfi].array();
+    const Array4<Complex> tmp_arr = tmpSpectralField[mfi].array();
 #if (AMREX_SPACEDIM >= 2)
-            const Complex* xshift_arr = xshift_FFTtoCell[mfi].dataPtr();
+    const Complex* xshift_arr = xshift_FFTtoCell[mfi].dataPtr();
 #endif
 #if defined(WARPX_DIM_3D)
-            const Complex* yshift_arr = yshift_FFTtoCell[mfi].dataPtr();
+    const Complex* yshift_arr = yshift_FFTtoCell[mfi].dataPtr();
 #endif
-            const Complex* zshift_arr = zshift_FFTtoCell[mfi].dataPtr();
-            // Loop over indices within one box
-            const Box spectralspace_bx = tmpSpectralField[mfi].box();
-
-            ParallelFor( spectralspace_bx,
-            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                Complex spectral_field_value = field_arr(i,j,k,field_index);
-                // Apply proper shift in each dimension
+    const Complex* zshift_arr = zshift_FFTtoCell[mfi].dataPtr();
+    // Loop over indices within one box
+    const Box spectralspace_bx = tmpSpectralField[mfi].box();
+
+    ParallelFor( spectralspace_bx,
+    [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+        Complex spectral_field_value = field_arr(i,j,k,field_index);
+        // Apply proper shift in each dimension
 #if (AMREX_SPACEDIM >= 2)
-                if (!is_nodal_x) { spectral_field_value *= xshift_arr[i]; }
+        if (!is_nodal_x) { spectral_field_value *= xshift_arr[i]; }
 #endif
 #if defined(WARPX_DIM_3D)
-                if (!is_nodal_y) { spectral_field_value *= yshift_arr[j]; }
-                if (!is_nodal_z) { spectral_field_value *= zshift_arr[k]; }
+        if (!is_nodal_y) { spectral_field_value *= yshift_arr[j]; }
+        if (!is_nodal_z) { spectral_field_value *= zshift_arr[k]; }
 #elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-                if (!is_nodal_z) { spectral_field_value *= zshift_arr[j]; }
+        if (!is_nodal_z) { spectral_field_value *= zshift_arr[j]; }
 #elif defined(WARPX_DIM_1D_Z)
-                if (!is_nodal_z) { spectral_field_value *= zshift_arr[i]; }
+        if (!is_nodal_z) { spectral_field_value *= zshift_arr[i]; }
 #endif
-                // Copy field into temporary array
-                tmp_arr(i,j,k) = spectral_field_value;
-            });
-        }
+        // Copy field into temporary array
+        tmp_arr(i,j,k,tmp_comp) = spectral_field_value;
+    });
+}
 
-        // Perform Fourier transform from `tmpSpectralField` to `tmpRealField`
-        ablastr::math::anyfft::Execute(backward_plan[mfi]);
+void
+SpectralFieldData::CopyTmpToReal (const amrex::MFIter& mfi, amrex::MultiFab& mf,
+                                  const amrex::IntVect& fill_guards,
+                                  const int i_comp, const int tmp_comp)
+{
+    // Check field index type, in order to wrap the last nodal point
+#if (AMREX_SPACEDIM >= 2)
+    const bool is_nodal_x = mf.is_nodal(0);
+#endif
+#if defined(WARPX_DIM_3D)
+    const bool is_nodal_y = mf.is_nodal(1);
+    const bool is_nodal_z = mf.is_nodal(2);
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    const bool is_nodal_z = mf.is_nodal(1);
+#elif defined(WARPX_DIM_1D_Z)
+    const bool is_nodal_z = mf.is_nodal(0);
+#endif
 
-        // Copy the temporary field tmpRealField to the real-space field mf and
-        // normalize, dividing by N, since (FFT + inverse FFT) results in a factor N
-        {
-            amrex::Box mf_box = (m_periodic_single_box) ? mfi.validbox() : mfi.fabbox();
-            const amrex::Array4<amrex::Real> mf_arr = mf[mfi].array();
-            const amrex::Array4<const amrex::Real> tmp_arr = tmpRealField[mfi].array();
+#if (AMREX_SPACEDIM >= 2)
+    const int si = (is_nodal_x) ? 1 : 0;
+#endif
+#if   defined(WARPX_DIM_1D_Z)
+    const int si = (is_nodal_z) ? 1 : 0;
+    const int sj = 0;
+    const int sk = 0;
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    const int sj = (is_nodal_z) ? 1 : 0;
+    const int sk = 0;
+#elif defined(WARPX_DIM_3D)
+    const int sj = (is_nodal_y) ? 1 : 0;
+    const int sk = (is_nodal_z) ? 1 : 0;
+#endif
+
+    // Numbers of guard cells
+    const amrex::IntVect& mf_ng = mf.nGrowVect();
 
-            const amrex::Real inv_N = 1._rt / tmpRealField[mfi].box().numPts();
+    // Copy the temporary field tmpRealField to the real-space field mf and
+    // normalize, dividing by N, since (FFT + inverse FFT) results in a factor N
+    amrex::Box mf_box = (m_periodic_single_box) ? mf.box(mfi.index()) : mf[mfi].box();
+    const amrex::Array4<amrex::Real> mf_arr = mf[mfi].array();
+    const amrex::Array4<const amrex::Real> tmp_arr = tmpRealField[mfi].array();
 
-            // Total number of cells, including ghost cells (nj represents ny in 3D and nz in 2D)
-            const int ni = mf_box.length(0);
+    // (for the distributed FFT, N is the number of points of the whole domain)
+    const amrex::Real inv_N = (m_distributed) ?
+        1._rt / static_cast<amrex::Real>(m_global_npts) :
+        1._rt / tmpRealField[mfi].box().numPts();
+
+    // Total number of cells, including ghost cells (nj represents ny in 3D and nz in 2D)
+    const int ni = mf_box.length(0);
 #if   defined(WARPX_DIM_1D_Z)
-            constexpr int nj = 1;
-            constexpr int nk = 1;
+    constexpr int nj = 1;
+    constexpr int nk = 1;
 #elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-            const int nj = mf_box.length(1);
-            constexpr int nk = 1;
+    const int nj = mf_box.length(1);
+    constexpr int nk = 1;
 #elif defined(WARPX_DIM_3D)
-            const int nj = mf_box.length(1);
-            const int nk = mf_box.length(2);
+    const int nj = mf_box.length(1);
+    const int nk = mf_box.length(2);
 #endif
-            // Lower bound of the box (lo_j represents lo_y in 3D and lo_z in 2D)
-            const int lo_i = amrex::lbound(mf_box).x;
+    // Lower bound of the box (lo_j represents lo_y in 3D and lo_z in 2D)
+    const int lo_i = amrex::lbound(mf_box).x;
 #if   defined(WARPX_DIM_1D_Z)
-            constexpr int lo_j = 0;
-            constexpr int lo_k = 0;
+    constexpr int lo_j = 0;
+    constexpr int lo_k = 0;
 #elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-            const int lo_j = amrex::lbound(mf_box).y;
-            constexpr int lo_k = 0;
+    const int lo_j = amrex::lbound(mf_box).y;
+    constexpr int lo_k = 0;
 #elif defined(WARPX_DIM_3D)
-            const int lo_j = amrex::lbound(mf_box).y;
-            const int lo_k = amrex::lbound(mf_box).z;
+    const int lo_j = amrex::lbound(mf_box).y;
+    const int lo_k = amrex::lbound(mf_box).z;
 #endif
-            // If necessary, do not fill the guard cells
-            // (shrink box by passing negative number of cells)
-            if (!m_periodic_single_box)
-            {
-                for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
-                {
-                    if ((fill_guards[dir]) == 0) { mf_box.grow(dir, -mf_ng[dir]); }
-                }
-            }
-
-            // Loop over cells within full box, including ghost cells
-            ParallelFor(mf_box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
-            {
-                // Assume periodicity and set the last outer guard cell equal to the first one:
-                // this is necessary in order to get the correct value along a nodal direction,
-                // because the last point along a nodal direction is always discarded when FFTs
-                // are computed, as the real-space box is always cell-centered.
-                const int ii = (i == lo_i + ni - si) ? lo_i : i;
-                const int jj = (j == lo_j + nj - sj) ? lo_j : j;
-                const int kk = (k == lo_k + nk - sk) ? lo_k : k;
-                // Copy and normalize field
-                mf_arr(i,j,k,i_comp) = inv_N * tmp_arr(ii,jj,kk);
-            });
-        }
-
-        if (do_costs)
+    // If necessary, do not fill the guard cells
+    // (shrink box by passing negative number of cells)
+    if (!m_periodic_single_box)
+    {
+        for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
         {
-            amrex::Gpu::synchronize();
-            wt = static_cast<amrex::Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            if ((fill_guards[dir]) == 0) { mf_box.grow(dir, -mf_ng[dir]); }
         }
     }
+
+    // Loop over cells within full box, including ghost cells
+    ParallelFor(mf_box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+    {
+        // Assume periodicity and set the last outer guard cell equal to the first one:
+        // this is necessary in order to get the correct value along a nodal direction,
+        // because the last point along a nodal direction is always discarded when FFTs
+        // are computed, as the real-space box is always cell-centered.
+        const int ii = (i == lo_i + ni - si) ? lo_i : i;
+        const int jj = (j == lo_j + nj - sj) ? lo_j : j;
+        const int kk = (k == lo_k + nk - sk) ? lo_k : k;
+        // Copy and normalize field
+        mf_arr(i,j,k,i_comp) = inv_N * tmp_arr(ii,jj,kk,tmp_comp);
+    });
 }
 
 #endif // WARPX_USE_FFT
@@ -192,7 +192,8 @@ HankelTransform::HankelTransform (int const hankel_order,
 
 void
 HankelTransform::HankelForwardTransform (amrex::FArrayBox const& F, int const F_icomp,
-                                         amrex::FArrayBox      & G, int const G_icomp)
+                                         amrex::FArrayBox      & G, int const G_icomp,
+                                         int const ncomp)
 {
     WARPX_PROFILE("HankelTransform::HankelForwardTransform");
 
@@ -207,6 +208,11 @@ HankelTransform::HankelForwardTransform (amrex::FArrayBox const& F, int const F_
     AMREX_ALWAYS_ASSERT(nz == G_box.length(1));
     AMREX_ALWAYS_ASSERT(ngr >= 0);
     AMREX_ALWAYS_ASSERT(F_box.bigEnd(0)+1 >= m_nr);
+    AMREX_ALWAYS_ASSERT(F_icomp+ncomp <= F.nComp() && G_icomp+ncomp <= G.nComp());
+
+    // The components of a FArrayBox are contiguous, with (for the 2D boxes
+    // of RZ) nz columns of length nr each, so that ncomp consecutive
+    // components form a single matrix with ncomp*nz columns
 
     // We perform stream synchronization since `gemm` may be running
     // on a different stream.
@@ -214,7 +220,7 @@ HankelTransform::HankelForwardTransform (amrex::FArrayBox const& F, int const F_
 
     // Note that M is flagged to be transposed since it has dimensions (m_nr, m_nk)
     blas::gemm(blas::Layout::ColMajor, blas::Op::Trans, blas::Op::NoTrans,
-               m_nk, nz, m_nr, 1._rt,
+               m_nk, nz*ncomp, m_nr, 1._rt,
                m_M.dataPtr(), m_nk,
                F.dataPtr(F_icomp)+ngr, nrF, 0._rt,
                G.dataPtr(G_icomp), m_nk
@@ -231,7 +237,8 @@ HankelTransform::HankelForwardTransform (amrex::FArrayBox const& F, int const F_
 
 void
 HankelTransform::HankelInverseTransform (amrex::FArrayBox const& G, int const G_icomp,
-                                         amrex::FArrayBox      & F, int const F_icomp)
+                                         amrex::FArrayBox      & F, int const F_icomp,
+                                         int const ncomp)
 {
     WARPX_PROFILE("HankelTransform::HankelInverseTransform");
 
@@ -246,6 +253,11 @@ HankelTransform::HankelInverseTransform (amrex::FArrayBox const& G, int const G_
     AMREX_ALWAYS_ASSERT(nz == G_box.length(1));
     AMREX_ALWAYS_ASSERT(ngr >= 0);
     AMREX_ALWAYS_ASSERT(F_box.bigEnd(0)+1 >= m_nr);
+    AMREX_ALWAYS_ASSERT(F_icomp+ncomp <= F.nComp() && G_icomp+ncomp <= G.nComp());
+
+    // The components of a FArrayBox are contiguous, with (for the 2D boxes
+    // of RZ) nz columns of length nr each, so that ncomp consecutive
+    // components form a single matrix with ncomp*nz columns
 
     // We perform stream synchronization since `gemm` may be running
     // on a different stream.
@@ -253,7 +265,7 @@ HankelTransform::HankelInverseTransform (amrex::FArrayBox const& G, int const G_
 
     // Note that m_invM is flagged to be transposed since it has dimensions (m_nk, m_nr)
     blas::gemm(blas::Layout::ColMajor, blas::Op::Trans, blas::Op::NoTrans,
-               m_nr, nz, m_nk, 1._rt,
+               m_nr, nz*ncomp, m_nk, 1._rt,
                m_invM.dataPtr(), m_nr,
                G.dataPtr(G_icomp), m_nk, 0._rt,
                F.dataPtr(F_icomp)+ngr, nrF
@@ -24,6 +24,7 @@
 
 #include <array>
 #include <cmath>
+#include <map>
 #include <vector>
 
 using namespace amrex;
@@ -34,20 +35,53 @@ using namespace amrex;
  * of the fields in real space (cell-centered ; includes guard cells)
  * \param dm Indicates which MPI proc owns which box, in realspace_ba.
  * \param realspace_dx Cell size of the grid in real space
+ * \param distributed_fft Whether one FFT is performed over the union of all boxes
+ * (which must then cover a periodic domain without guard cells), instead of one
+ * local FFT per box
  */
 SpectralKSpace::SpectralKSpace( const BoxArray& realspace_ba,
                                 const DistributionMapping& dm,
-                                const RealVect realspace_dx )
-    : dx(realspace_dx)  // Store the cell size as member `dx`
+                                const RealVect realspace_dx,
+                                const bool distributed_fft )
+    : dx(realspace_dx),  // Store the cell size as member `dx`
+      m_distributed(distributed_fft)
 {
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         realspace_ba.ixType()==IndexType::TheCellType(),
         "SpectralKSpace expects a cell-centered box.");
 
+    if (m_distributed) {
+        m_global_domain = realspace_ba.minimalBox();
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            realspace_ba.numPts() == m_global_domain.numPts(),
+            "The distributed FFT requires the boxes to cover a rectangular domain.");
+    }
+
     // Create the box array that corresponds to spectral space
     BoxList spectral_bl; // Create empty box list
     // Loop over boxes and fill the box list
     for (int i=0; i < realspace_ba.size(); i++ ) {
+        if (m_distributed) {
+            // For the distributed FFT, each box in spectral space holds the
+            // piece of the global spectral space that has the same position
+            // along y and z as the real-space box; along x (the direction
+            // halved by the real-to-complex FFT) the real-space extent is
+            // rescaled, so that the spectral boxes still partition the spectral
+            // space. Boxes in spectral space start at 0 and the position within
+            // the global spectral space is stored in m_spectral_lo.
+            const Box realspace_bx = realspace_ba[i];
+            IntVect lo = realspace_bx.smallEnd() - m_global_domain.smallEnd();
+            IntVect hi = realspace_bx.bigEnd() - m_global_domain.smallEnd();
+            const auto n0 = static_cast<amrex::Long>(m_global_domain.length(0));
+            const amrex::Long c0 = n0/2 + 1;
+            lo[0] = static_cast<int>((lo[0]*c0)/n0);
+            hi[0] = static_cast<int>(((hi[0]+1)*c0)/n0) - 1;
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(hi[0] >= lo[0],
+                "The boxes are too small along x for the distributed FFT.");
+            m_spectral_lo.push_back(lo);
+            spectral_bl.push_back( Box( IntVect::TheZeroVector(), hi - lo ) );
+            continue;
+        }
         // For local FFTs, boxes in spectral space start at 0 in
         // each direction and have the same number of points as the
         // (cell-centered) real space box
@@ -67,6 +101,20 @@ SpectralKSpace::SpectralKSpace( const BoxArray& realspace_ba,
     }
     spectralspace_ba.define( spectral_bl );
 
+    // With local FFTs, the k vectors of a box only depend on its size:
+    // boxes of the same size can share the coefficients of the spectral solver
+    m_equivalent_boxes.resize(realspace_ba.size());
+    std::map<std::vector<int>, int> first_box_of_size;
+    for (int i=0; i < realspace_ba.size(); i++ ) {
+        if (m_distributed) {
+            m_equivalent_boxes[i] = i;
+            continue;
+        }
+        const IntVect fft_size = realspace_ba[i].length();
+        const std::vector<int> key(fft_size.begin(), fft_size.end());
+        m_equivalent_boxes[i] = first_box_of_size.emplace(key, i).first->second;
+    }
+
     // Allocate the components of the k vector: kx, ky (only in 3D), kz
     for (int i_dim=0; i_dim<AMREX_SPACEDIM; i_dim++) {
         // Real-to-complex FFTs: first axis contains only the positive k
@@ -99,7 +147,14 @@ SpectralKSpace::getKComponent( const DistributionMapping& dm,
         Real* pk = k.data();
 
         // Fill the k vector
+        // (for the distributed FFT, the box covers the indices
+        // [k_lo, k_lo+N-1] of the global spectral space)
         IntVect fft_size = realspace_ba[mfi].length();
+        int k_lo = 0;
+        if (m_distributed) {
+            fft_size = m_global_domain.length();
+            k_lo = m_spectral_lo[mfi.index()][i_dim];
+        }
         const Real dk = 2*MathConst::pi/(fft_size[i_dim]*dx[i_dim]);
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE( bx.smallEnd(i_dim) == 0,
             "Expected box to start at 0, in spectral space.");
@@ -110,20 +165,22 @@ SpectralKSpace::getKComponent( const DistributionMapping& dm,
             // (typically: first axis, in a real-to-complex FFT)
             amrex::ParallelFor(N, [=] AMREX_GPU_DEVICE (int i) noexcept
             {
-                pk[i] = i*dk;
+                pk[i] = (i+k_lo)*dk;
             });
         } else {
-            const int mid_point = (N+1)/2;
+            const int N_fft = fft_size[i_dim];
+            const int mid_point = (N_fft+1)/2;
             amrex::ParallelFor(N, [=] AMREX_GPU_DEVICE (int i) noexcept
             {
-                if (i < mid_point) {
+                const int ik = i + k_lo;
+                if (ik < mid_point) {
                     // Fill positive values of k
                     // (FFT conventions: first half is positive)
-                    pk[i] = i*dk;
+                    pk[i] = ik*dk;
                 } else {
                     // Fill negative values of k
                     // (FFT conventions: second half is negative)
-                    pk[i] = (i-N)*dk;
+                    pk[i] = (ik-N_fft)*dk;
                 }
             });
         }
@@ -230,6 +287,17 @@ SpectralKSpace::getModifiedKComponent( const DistributionMapping& dm,
             const auto N = static_cast<int>(k.size());;
             modified_k.resize(N);
             Real const* p_k = k.data();
+
+            // Position of the box along i_dim within the spectral space, and
+            // number of points of the spectral space along i_dim
+            // (these differ from 0 and N only for the distributed FFT)
+            int k_lo = 0;
+            int N_k = N;
+            if (m_distributed) {
+                k_lo = m_spectral_lo[mfi.index()][i_dim];
+                N_k = m_global_domain.length(i_dim);
+                if (i_dim == 0) { N_k = N_k/2 + 1; }
+            }
             Real * p_modified_k = modified_k.data();
 
             // Fill the modified k vector
@@ -256,13 +324,13 @@ SpectralKSpace::getModifiedKComponent( const DistributionMapping& dm,
                         // Because of the real-to-complex FFTs, the first axis (idim=0)
                         // contains only the positive k, and the Nyquist frequency is
                         // the last element of the array.
-                        if (i == N-1) {
+                        if (i+k_lo == N_k-1) {
                             p_modified_k[i] = 0.0_rt;
                         }
                     } else {
                         // The other axes contains both positive and negative k ;
                         // the Nyquist frequency is in the middle of the array.
-                        if ( (N%2==0) && (i == N/2) ){
+                        if ( (N_k%2==0) && (i+k_lo == N_k/2) ){
                             p_modified_k[i] = 0.0_rt;
                         }
                     }
@@ -16,6 +16,7 @@
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
 
 #include <memory>
 
@@ -31,6 +32,7 @@ SpectralSolver::SpectralSolver(
                 const amrex::Vector<amrex::Real>& v_comoving,
                 const amrex::RealVect dx, const amrex::Real dt,
                 const bool pml, const bool periodic_single_box,
+                const bool distributed_fft,
                 const bool update_with_rho,
                 const bool fft_do_time_averaging,
                 const int psatd_solution_type,
@@ -44,7 +46,7 @@ SpectralSolver::SpectralSolver(
     // - Initialize k space object (Contains info about the size of
     // the spectral space corresponding to each box in `realspace_ba`,
     // as well as the value of the corresponding k coordinates)
-    const SpectralKSpace k_space= SpectralKSpace(realspace_ba, dm, dx);
+    const SpectralKSpace k_space= SpectralKSpace(realspace_ba, dm, dx, distributed_fft);
 
     m_spectral_index = SpectralFieldIndex(
         update_with_rho, fft_do_time_averaging, J_in_time, rho_in_time,
@@ -111,8 +113,12 @@ SpectralSolver::SpectralSolver(
     }
 
     // - Initialize arrays for fields in spectral space + FFT plans
+    //   (with the multi-J algorithm, the current and the charge density deposited at
+    //   each sub-step can be transformed together)
+    const bool batch_current_and_rho = WarpX::do_multi_J && update_with_rho && !pml;
     field_data = SpectralFieldData(lev, realspace_ba, k_space, dm,
-                                   m_spectral_index.n_fields, periodic_single_box);
+                                   m_spectral_index.n_fields, periodic_single_box,
+                                   batch_current_and_rho);
 }
 
 void
@@ -136,6 +142,55 @@ SpectralSolver::BackwardTransform( const int lev,
     field_data.BackwardTransform(lev, mf, field_index, fill_guards, i_comp);
 }
 
+void
+SpectralSolver::ForwardTransform (const int lev,
+                                  const std::array<const amrex::MultiFab*,3>& mf,
+                                  const std::array<int,3>& field_index,
+                                  const std::array<int,3>& i_comp)
+{
+    WARPX_PROFILE("SpectralSolver::ForwardTransform");
+    if (field_data.hasBatchedFFT()) {
+        field_data.ForwardTransform(lev, mf, field_index, i_comp);
+    } else {
+        for (int c = 0; c < 3; ++c) {
+            field_data.ForwardTransform(lev, *mf[c], field_index[c], i_comp[c]);
+        }
+    }
+}
+
+void
+SpectralSolver::ForwardTransform (const int lev,
+                                  const std::array<const amrex::MultiFab*,4>& mf,
+                                  const std::array<int,4>& field_index,
+                                  const std::array<int,4>& i_comp)
+{
+    WARPX_PROFILE("SpectralSolver::ForwardTransform");
+    if (field_data.hasBatchedFFT4()) {
+        field_data.ForwardTransform(lev, mf, field_index, i_comp);
+    } else {
+        ForwardTransform(lev, {mf[0], mf[1], mf[2]}, {field_index[0], field_index[1], field_index[2]},
+                         {i_comp[0], i_comp[1], i_comp[2]});
+        field_data.ForwardTransform(lev, *mf[3], field_index[3], i_comp[3]);
+    }
+}
+
+void
+SpectralSolver::BackwardTransform( const int lev,
+                                   const std::array<amrex::MultiFab*,3>& mf,
+                                   const std::array<int,3>& field_index,
+                                   const amrex::IntVect& fill_guards,
+                                   const std::array<int,3>& i_comp )
+{
+    WARPX_PROFILE("SpectralSolver::BackwardTransform");
+    if (field_data.hasBatchedFFT()) {
+        field_data.BackwardTransform(lev, mf, field_index, fill_guards, i_comp);
+    } else {
+        for (int c = 0; c < 3; ++c) {
+            field_data.BackwardTransform(lev, *mf[c], field_index[c], fill_guards, i_comp[c]);
+        }
+    }
+}
+
 void
 SpectralSolver::pushSpectralFields(){
     WARPX_PROFILE("SpectralSolver::pushSpectralFields");
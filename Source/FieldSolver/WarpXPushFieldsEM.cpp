@@ -9,6 +9,8 @@
 #include "WarpX.H"
 
 #include "BoundaryConditions/PML.H"
+#include "Diagnostics/MultiDiagnostics.H"
+#include "Diagnostics/ReducedDiags/MultiReducedDiags.H"
 #include "Evolve/WarpXDtType.H"
 #include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceSolver.H"
 #if defined(WARPX_USE_FFT)
@@ -21,6 +23,8 @@
 #   endif
 #endif
 #include "Python/callbacks.H"
+#include "Utils/GpuGraph.H"
+#include "Utils/PhaseTimers.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
@@ -39,18 +43,26 @@
 #include <AMReX_FArrayBox.H>
 #include <AMReX_FabArray.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_GpuControl.H>
+#include <AMReX_GpuDevice.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_IndexType.H>
 #include <AMReX_MFIter.H>
+#include <AMReX_LayoutData.H>
 #include <AMReX_Math.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelReduce.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Vector.H>
 
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <optional>
 
 using namespace amrex;
 
@@ -71,9 +83,9 @@ namespace {
         solver.ForwardTransform(lev, *vector_field[0], compx, *vector_field[1], compy);
         solver.ForwardTransform(lev, *vector_field[2], compz);
 #else
-        solver.ForwardTransform(lev, *vector_field[0], compx);
-        solver.ForwardTransform(lev, *vector_field[1], compy);
-        solver.ForwardTransform(lev, *vector_field[2], compz);
+        solver.ForwardTransform(lev,
+            {vector_field[0].get(), vector_field[1].get(), vector_field[2].get()},
+            {compx, compy, compz}, {0, 0, 0});
 #endif
     }
 
@@ -93,9 +105,9 @@ namespace {
         solver.BackwardTransform(lev, *vector_field[0], compx, *vector_field[1], compy);
         solver.BackwardTransform(lev, *vector_field[2], compz);
 #else
-        solver.BackwardTransform(lev, *vector_field[0], compx, fill_guards);
-        solver.BackwardTransform(lev, *vector_field[1], compy, fill_guards);
-        solver.BackwardTransform(lev, *vector_field[2], compz, fill_guards);
+        solver.BackwardTransform(lev,
+            {vector_field[0].get(), vector_field[1].get(), vector_field[2].get()},
+            {compx, compy, compz}, fill_guards, {0, 0, 0});
 #endif
     }
 }
@@ -402,6 +414,50 @@ void WarpX::PSATDForwardTransformRho (
 #endif
 }
 
+void WarpX::PSATDForwardTransformJRho (
+    const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& J_fp,
+    const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& J_cp,
+    const amrex::Vector<std::unique_ptr<amrex::MultiFab>>& charge_fp,
+    const amrex::Vector<std::unique_ptr<amrex::MultiFab>>& charge_cp,
+    const int dcomp)
+{
+#ifdef WARPX_DIM_RZ
+    PSATDForwardTransformJ(J_fp, J_cp);
+    PSATDForwardTransformRho(charge_fp, charge_cp, 0, dcomp);
+#else
+    if (charge_fp[0] == nullptr) {
+        PSATDForwardTransformJ(J_fp, J_cp);
+        return;
+    }
+
+    const auto transform = [&] (int lev, SpectralSolver& solver,
+        const std::array<std::unique_ptr<amrex::MultiFab>,3>& J, const amrex::MultiFab* rho)
+    {
+        const SpectralFieldIndex& Idx = solver.m_spectral_index;
+        const bool linear = (J_in_time == JInTime::Linear);
+        const int idx_jx = linear ? static_cast<int>(Idx.Jx_new) : static_cast<int>(Idx.Jx_mid);
+        const int idx_jy = linear ? static_cast<int>(Idx.Jy_new) : static_cast<int>(Idx.Jy_mid);
+        const int idx_jz = linear ? static_cast<int>(Idx.Jz_new) : static_cast<int>(Idx.Jz_mid);
+        if (rho) {
+            solver.ForwardTransform(lev, {J[0].get(), J[1].get(), J[2].get(), rho},
+                                    {idx_jx, idx_jy, idx_jz, dcomp}, {0, 0, 0, 0});
+        } else {
+            ForwardTransformVect(lev, solver, J, idx_jx, idx_jy, idx_jz);
+        }
+    };
+
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        transform(lev, *spectral_solver_fp[lev], J_fp[lev], charge_fp[lev].get());
+
+        if (spectral_solver_cp[lev])
+        {
+            transform(lev, *spectral_solver_cp[lev], J_cp[lev], charge_cp[lev].get());
+        }
+    }
+#endif
+}
+
 void WarpX::PSATDCurrentCorrection ()
 {
     for (int lev = 0; lev <= finest_level; ++lev)
@@ -415,6 +471,17 @@ void WarpX::PSATDCurrentCorrection ()
     }
 }
 
+bool WarpX::RealSpaceCurrentNeeded () const
+{
+    const int step = istep[0];
+    const bool last_step = (step+1 >= max_step) || (t_new[0] + dt[0] >= stop_time - 1.e-3_rt*dt[0]);
+    return last_step || use_hybrid_QED || reduced_diags->m_plot_rd != 0 ||
+        multi_diags->DoComputeAndPack(step) ||
+        IsPythonCallbackInstalled("afterEsolve") ||
+        IsPythonCallbackInstalled("afterstep") ||
+        IsPythonCallbackInstalled("afterdiagnostics");
+}
+
 void WarpX::PSATDVayDeposition ()
 {
     for (int lev = 0; lev <= finest_level; ++lev)
@@ -650,6 +717,7 @@ WarpX::PSATDScaleAverageFields (const amrex::Real scale_factor)
 void
 WarpX::PushPSATD ()
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::FieldSolve);
 #ifndef WARPX_USE_FFT
     WARPX_ABORT_WITH_MESSAGE(
         "PushFieldsEM: PSATD solver selected but not built");
@@ -670,8 +738,9 @@ WarpX::PushPSATD ()
             // Correct J in k-space
             PSATDCurrentCorrection();
 
-            // Inverse FFT of J
-            PSATDBackwardTransformJ(current_fp, current_cp);
+            // Inverse FFT of J, only if J is read in real space in this step:
+            // the field push uses the corrected J in k-space
+            if (RealSpaceCurrentNeeded()) { PSATDBackwardTransformJ(current_fp, current_cp); }
         }
         else if (current_deposition_algo == CurrentDepositionAlgo::Vay)
         {
@@ -793,11 +862,146 @@ WarpX::PushPSATD ()
 #endif
 }
 
+bool
+WarpX::UseFieldSolveGraphs () const
+{
+    // The timers of the load balance costs synchronize the GPU and read the host clock
+    const bool costs_timers = (getCosts(0) != nullptr) &&
+        (load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers);
+    return use_gpu_graphs && !costs_timers;
+}
+
+std::size_t
+WarpX::FieldSolveGraphKey (amrex::Real a_dt) const
+{
+    std::size_t key = std::hash<amrex::Real>{}(a_dt);
+    const auto combine = [&key] (std::size_t value) {
+        key ^= value + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+    };
+    const auto add_multifab = [&] (const amrex::MultiFab* mf) {
+        if (mf == nullptr) { return; }
+        for (int li = 0; li < mf->local_size(); ++li) {
+            const auto& fab = mf->atLocalIdx(li);
+            combine(std::hash<const void*>{}(fab.dataPtr()));
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                combine(std::hash<int>{}(fab.box().smallEnd(idim)));
+                combine(std::hash<int>{}(fab.box().bigEnd(idim)));
+            }
+        }
+    };
+
+    combine(std::hash<int>{}(finest_level));
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        for (int idim = 0; idim < 3; ++idim)
+        {
+            add_multifab(Efield_fp[lev][idim].get());
+            add_multifab(Bfield_fp[lev][idim].get());
+            add_multifab(current_fp[lev][idim].get());
+            add_multifab(Efield_cp[lev][idim].get());
+            add_multifab(Bfield_cp[lev][idim].get());
+            add_multifab(current_cp[lev][idim].get());
+            if (do_pml && pml[lev]->ok()) {
+                add_multifab(pml[lev]->GetE_fp()[idim]);
+                add_multifab(pml[lev]->GetB_fp()[idim]);
+                add_multifab(pml[lev]->Getj_fp()[idim]);
+                if (lev > 0) {
+                    add_multifab(pml[lev]->GetE_cp()[idim]);
+                    add_multifab(pml[lev]->GetB_cp()[idim]);
+                    add_multifab(pml[lev]->Getj_cp()[idim]);
+                }
+            }
+        }
+        add_multifab(F_fp[lev].get());
+        add_multifab(G_fp[lev].get());
+        add_multifab(F_cp[lev].get());
+        add_multifab(G_cp[lev].get());
+    }
+    return key;
+}
+
+void
+WarpX::UpdateQuiescentBoxes ()
+{
+    WARPX_PROFILE("WarpX::UpdateQuiescentBoxes()");
+
+    const amrex::BoxArray& ba = boxArray(0);
+    const amrex::DistributionMapping& dm = DistributionMap(0);
+    if (m_quiescent_boxes.boxArray() != ba || m_quiescent_boxes.DistributionMap() != dm) {
+        m_quiescent_boxes.define(ba, dm);
+    }
+
+    // Boxes in which a component of E, B or J does not vanish
+    const int nboxes = static_cast<int>(ba.size());
+    amrex::Vector<int> active(nboxes, 0);
+    for (amrex::MFIter mfi(m_quiescent_boxes); mfi.isValid(); ++mfi)
+    {
+        const int ibox = mfi.index();
+        for (int idim = 0; idim < 3 && active[ibox] == 0; ++idim)
+        {
+            for (const amrex::MultiFab* mf : {Efield_fp[0][idim].get(), Bfield_fp[0][idim].get(),
+                                              current_fp[0][idim].get()})
+            {
+                const amrex::Box bx = mf->box(ibox);
+                for (int comp = 0; comp < mf->nComp(); ++comp) {
+                    if ((*mf)[mfi].maxabs<amrex::RunOn::Device>(bx, comp) > 0._rt) {
+                        active[ibox] = 1;
+                    }
+                }
+            }
+        }
+    }
+    amrex::ParallelAllReduce::Max(active.data(), nboxes, amrex::ParallelDescriptor::Communicator());
+
+    // Over one step (B over dt/2, E over dt, B over dt/2), the fields of a box only depend
+    // on the fields and the current within three stencil widths of the box. The boxes
+    // close to the edges of the domain are always updated, since the boundary conditions
+    // and the PML may change the fields in their guard cells.
+    const amrex::IntVect ngrow = 3*guard_cells.ng_FieldSolver + amrex::IntVect(1);
+    const amrex::Box& domain = Geom(0).Domain();
+    for (amrex::MFIter mfi(m_quiescent_boxes); mfi.isValid(); ++mfi)
+    {
+        const amrex::Box grown_box = amrex::grow(ba[mfi.index()], ngrow);
+        int quiescent = domain.contains(grown_box) ? 1 : 0;
+        if (quiescent) {
+            for (const auto& isect : ba.intersections(grown_box)) {
+                if (active[isect.first] != 0) {
+                    quiescent = 0;
+                    break;
+                }
+            }
+        }
+        m_quiescent_boxes[mfi] = quiescent;
+    }
+}
+
 void
 WarpX::EvolveB (amrex::Real a_dt, DtType a_dt_type)
 {
-    for (int lev = 0; lev <= finest_level; ++lev) {
-        EvolveB(lev, a_dt, a_dt_type);
+    const auto push = [&] () {
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            EvolveB(lev, a_dt, a_dt_type);
+        }
+    };
+
+    if (UseFieldSolveGraphs())
+    {
+        auto& graph = m_field_solve_graphs[static_cast<int>(a_dt_type)];
+        if (!graph) { graph = std::make_unique<utils::GpuGraph>(); }
+        graph->run(FieldSolveGraphKey(a_dt), push);
+    }
+    else
+    {
+        {
+            // With warpx.overlap_level_field_solves, the MFIter loops do not synchronize the GPU
+            // at their end, so that the kernels of the fine and coarse patches of all the levels
+            // are queued without waiting and run concurrently on the GPU streams: they update
+            // different MultiFabs, and the kernels of a given box are queued on the same stream
+            std::optional<amrex::Gpu::NoSyncRegion> no_sync;
+            if (overlap_level_field_solves) { no_sync.emplace(); }
+            push();
+        }
+        if (overlap_level_field_solves) { amrex::Gpu::streamSynchronizeAll(); }
     }
 
     // Allow execution of Python callback after B-field push
@@ -818,18 +1022,49 @@ WarpX::EvolveB (int lev, amrex::Real a_dt, DtType a_dt_type)
 void
 WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_type)
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::FieldSolve);
+
+    // With m_fuse_divergence_cleaning, F is updated in the same loop as B (see OneStep_nosub)
+    const bool fuse_F = m_fuse_divergence_cleaning && do_dive_cleaning;
+    if (fuse_F) {
+        const int rhocomp = (a_dt_type == DtType::FirstHalf) ? 0 : 1;
+        if (patch_type == PatchType::fine) {
+            m_fdtd_solver_fp[lev]->SetFusedFUpdate(F_fp[lev].get(), rho_fp[lev].get(), rhocomp, a_dt);
+        } else {
+            m_fdtd_solver_cp[lev]->SetFusedFUpdate(F_cp[lev].get(), rho_cp[lev].get(), rhocomp, a_dt);
+        }
+    }
 
     // Evolve B field in regular cells
     if (patch_type == PatchType::fine) {
+        // With FDTD temporal blocking, B is also pushed in the guard cells
+        // in which E is up-to-date, minus the stencil of the solver
+        if (fdtd_temporal_blocking > 1) {
+            FillBoundaryE(lev, patch_type, guard_cells.ng_FieldSolver);
+            m_fdtd_valid_guards_B.min(m_fdtd_valid_guards_E - guard_cells.ng_FieldSolver);
+            m_fdtd_solver_fp[lev]->SetUpdateGuardCells(m_fdtd_valid_guards_B, Geom(lev));
+        }
         m_fdtd_solver_fp[lev]->EvolveB(Bfield_fp[lev], Efield_fp[lev], G_fp[lev],
                                        m_face_areas[lev], m_area_mod[lev], ECTRhofield[lev], Venl[lev],
                                        m_flag_info_face[lev], m_borrowing[lev], lev, a_dt);
+        if (fdtd_temporal_blocking > 1) {
+            m_fdtd_solver_fp[lev]->SetUpdateGuardCells(amrex::IntVect(0), Geom(lev));
+        }
     } else {
         m_fdtd_solver_cp[lev]->EvolveB(Bfield_cp[lev], Efield_cp[lev], G_cp[lev],
                                        m_face_areas[lev], m_area_mod[lev], ECTRhofield[lev], Venl[lev],
                                        m_flag_info_face[lev], m_borrowing[lev], lev, a_dt);
     }
 
+    if (fuse_F) {
+        if (patch_type == PatchType::fine) {
+            m_fdtd_solver_fp[lev]->SetFusedFUpdate(nullptr, nullptr, 0, 0._rt);
+        } else {
+            m_fdtd_solver_cp[lev]->SetFusedFUpdate(nullptr, nullptr, 0, 0._rt);
+        }
+        EvolveFPML(lev, patch_type, a_dt);
+    }
+
     // Evolve B field in PML cells
     if (do_pml && pml[lev]->ok()) {
         if (patch_type == PatchType::fine) {
@@ -848,9 +1083,28 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_typ
 void
 WarpX::EvolveE (amrex::Real a_dt)
 {
-    for (int lev = 0; lev <= finest_level; ++lev)
+    const auto push = [&] () {
+        for (int lev = 0; lev <= finest_level; ++lev)
+        {
+            EvolveE(lev, a_dt);
+        }
+    };
+
+    if (UseFieldSolveGraphs())
     {
-        EvolveE(lev, a_dt);
+        // The graphs of the B pushes are indexed by the DtType
+        auto& graph = m_field_solve_graphs[-1];
+        if (!graph) { graph = std::make_unique<utils::GpuGraph>(); }
+        graph->run(FieldSolveGraphKey(a_dt), push);
+    }
+    else
+    {
+        {
+            std::optional<amrex::Gpu::NoSyncRegion> no_sync;
+            if (overlap_level_field_solves) { no_sync.emplace(); }
+            push();
+        }
+        if (overlap_level_field_solves) { amrex::Gpu::streamSynchronizeAll(); }
     }
 
     // Allow execution of Python callback after E-field push
@@ -871,12 +1125,36 @@ WarpX::EvolveE (int lev, amrex::Real a_dt)
 void
 WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::FieldSolve);
+
+    // With m_fuse_divergence_cleaning, G is updated over the second half of the
+    // step in the same loop as E (see OneStep_nosub)
+    const bool fuse_G = m_fuse_divergence_cleaning && do_divb_cleaning;
+    if (fuse_G) {
+        if (patch_type == PatchType::fine) {
+            m_fdtd_solver_fp[lev]->SetFusedGUpdate(G_fp[lev].get(), 0.5_rt*a_dt);
+        } else {
+            m_fdtd_solver_cp[lev]->SetFusedGUpdate(G_cp[lev].get(), 0.5_rt*a_dt);
+        }
+    }
+
     // Evolve E field in regular cells
     if (patch_type == PatchType::fine) {
+        // With FDTD temporal blocking, E is also pushed in the guard cells
+        // in which B is up-to-date, minus the stencil of the solver
+        // (J is summed in all its guard cells, which are at least as many as those of E)
+        if (fdtd_temporal_blocking > 1) {
+            FillBoundaryB(lev, patch_type, guard_cells.ng_FieldSolver);
+            m_fdtd_valid_guards_E.min(m_fdtd_valid_guards_B - guard_cells.ng_FieldSolver);
+            m_fdtd_solver_fp[lev]->SetUpdateGuardCells(m_fdtd_valid_guards_E, Geom(lev));
+        }
         m_fdtd_solver_fp[lev]->EvolveE(Efield_fp[lev], Bfield_fp[lev],
                                        current_fp[lev], m_edge_lengths[lev],
                                        m_face_areas[lev], ECTRhofield[lev],
                                        F_fp[lev], lev, a_dt );
+        if (fdtd_temporal_blocking > 1) {
+            m_fdtd_solver_fp[lev]->SetUpdateGuardCells(amrex::IntVect(0), Geom(lev));
+        }
     } else {
         m_fdtd_solver_cp[lev]->EvolveE(Efield_cp[lev], Bfield_cp[lev],
                                        current_cp[lev], m_edge_lengths[lev],
@@ -884,6 +1162,14 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
                                        F_cp[lev], lev, a_dt );
     }
 
+    if (fuse_G) {
+        if (patch_type == PatchType::fine) {
+            m_fdtd_solver_fp[lev]->SetFusedGUpdate(nullptr, 0._rt);
+        } else {
+            m_fdtd_solver_cp[lev]->SetFusedGUpdate(nullptr, 0._rt);
+        }
+    }
+
     // Evolve E field in PML cells
     if (do_pml && pml[lev]->ok()) {
         if (patch_type == PatchType::fine) {
@@ -920,16 +1206,49 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
 #endif
 }
 
+void
+WarpX::EvolveEBFused (amrex::Real a_dt)
+{
+    WARPX_PROFILE("WarpX::EvolveEBFused()");
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::FieldSolve);
+
+    // Guard cells updated by the first push of B, the push of E and the second push of B:
+    // just enough for the valid cells to be up-to-date at the end, unless the guard
+    // cells are also tracked for the temporal blocking
+    const amrex::IntVect& s = guard_cells.ng_FieldSolver;
+    std::array<amrex::IntVect,3> ng_update = {2*s, s, amrex::IntVect(0)};
+    if (fdtd_temporal_blocking > 1) {
+        FillBoundaryE(0, PatchType::fine, 3*s);
+        FillBoundaryB(0, PatchType::fine, 2*s);
+        // (the numbers of up-to-date guard cells are updated along the way)
+        ng_update[0] = m_fdtd_valid_guards_B.min(m_fdtd_valid_guards_E - s);
+        ng_update[1] = m_fdtd_valid_guards_E.min(ng_update[0] - s);
+        ng_update[2] = m_fdtd_valid_guards_B.min(ng_update[1] - s);
+    }
+
+    m_fdtd_solver_fp[0]->EvolveEBFused(Efield_fp[0], Bfield_fp[0], current_fp[0],
+                                       ng_update, Geom(0), fdtd_fused_block_size, 0, a_dt);
+
+    // Allow execution of Python callbacks after the field pushes
+    ExecutePythonCallback("afterBpush");
+    ExecutePythonCallback("afterEpush");
+}
+
 
 void
 WarpX::EvolveF (amrex::Real a_dt, DtType a_dt_type)
 {
     if (!do_dive_cleaning) { return; }
 
-    for (int lev = 0; lev <= finest_level; ++lev)
     {
-        EvolveF(lev, a_dt, a_dt_type);
+        std::optional<amrex::Gpu::NoSyncRegion> no_sync;
+        if (overlap_level_field_solves) { no_sync.emplace(); }
+        for (int lev = 0; lev <= finest_level; ++lev)
+        {
+            EvolveF(lev, a_dt, a_dt_type);
+        }
     }
+    if (overlap_level_field_solves) { amrex::Gpu::streamSynchronizeAll(); }
 }
 
 void
@@ -944,6 +1263,7 @@ WarpX::EvolveF (int lev, amrex::Real a_dt, DtType a_dt_type)
 void
 WarpX::EvolveF (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_type)
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::FieldSolve);
     if (!do_dive_cleaning) { return; }
 
     WARPX_PROFILE("WarpX::EvolveF()");
@@ -959,6 +1279,12 @@ WarpX::EvolveF (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_typ
                                         rho_cp[lev], rhocomp, a_dt );
     }
 
+    EvolveFPML(lev, patch_type, a_dt);
+}
+
+void
+WarpX::EvolveFPML (int lev, PatchType patch_type, amrex::Real a_dt)
+{
     // Evolve F field in PML cells
     if (do_pml && pml[lev]->ok()) {
         if (patch_type == PatchType::fine) {
@@ -998,6 +1324,7 @@ WarpX::EvolveG (int lev, amrex::Real a_dt, DtType a_dt_type)
 void
 WarpX::EvolveG (int lev, PatchType patch_type, amrex::Real a_dt, DtType /*a_dt_type*/)
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::FieldSolve);
     if (!do_divb_cleaning) { return; }
 
     WARPX_PROFILE("WarpX::EvolveG()");
@@ -1038,6 +1365,7 @@ WarpX::MacroscopicEvolveE (int lev, amrex::Real a_dt) {
 
 void
 WarpX::MacroscopicEvolveE (int lev, PatchType patch_type, amrex::Real a_dt) {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::FieldSolve);
 
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         patch_type == PatchType::fine,
@@ -1215,13 +1543,26 @@ void WarpX::DampFieldsInGuards(const int lev, std::unique_ptr<amrex::MultiFab>&
 }
 
 #ifdef WARPX_DIM_RZ
-// This scales the current by the inverse volume and wraps around the deposition at negative radius.
-// It is faster to apply this on the grid than to do it particle by particle.
+// This scales the current and charge densities by the inverse volume and wraps around the
+// deposition at negative radius. It is faster to apply this on the grid than to do it
+// particle by particle, and the densities of a tile are processed in a single kernel.
 // It is put here since there isn't another nice place for it.
 void
-WarpX::ApplyInverseVolumeScalingToCurrentDensity (MultiFab* Jx, MultiFab* Jy, MultiFab* Jz, int lev)
+WarpX::ApplyInverseVolumeScalingToCurrentAndChargeDensity (
+    MultiFab* Jx, MultiFab* Jy, MultiFab* Jz, MultiFab* Rho, int lev)
 {
-    const amrex::IntVect ngJ = Jx->nGrowVect();
+    const bool has_J = (Jx != nullptr);
+    const bool has_rho = (Rho != nullptr);
+    if (!has_J && !has_rho) { return; }
+
+    // The densities can only be processed together if they are defined on the same grids
+    if (has_J && has_rho &&
+        (!Rho->boxArray().CellEqual(Jx->boxArray()) || Rho->DistributionMap() != Jx->DistributionMap())) {
+        ApplyInverseVolumeScalingToCurrentAndChargeDensity(Jx, Jy, Jz, nullptr, lev);
+        ApplyInverseVolumeScalingToCurrentAndChargeDensity(nullptr, nullptr, nullptr, Rho, lev);
+        return;
+    }
+
     const std::array<Real,3>& dx = WarpX::CellSize(lev);
     const Real dr = dx[0];
 
@@ -1229,241 +1570,101 @@ WarpX::ApplyInverseVolumeScalingToCurrentDensity (MultiFab* Jx, MultiFab* Jy, Mu
 
     // See Verboncoeur JCP 174, 421-427 (2001) for the modified volume factor
     const amrex::Real axis_volume_factor = (verboncoeur_axis_correction ? 1._rt/3._rt : 1._rt/4._rt);
+    const amrex::Real axis_inv_volume = 1._rt/(MathConst::pi*dr*axis_volume_factor);
 
-    for ( MFIter mfi(*Jx, TilingIfNotGPU()); mfi.isValid(); ++mfi )
-    {
-
-        Array4<Real> const& Jr_arr = Jx->array(mfi);
-        Array4<Real> const& Jt_arr = Jy->array(mfi);
-        Array4<Real> const& Jz_arr = Jz->array(mfi);
-
-        Box const & tilebox = mfi.tilebox();
-        Box tbr = convert( tilebox, Jx->ixType().toIntVect() );
-        Box tbt = convert( tilebox, Jy->ixType().toIntVect() );
-        Box tbz = convert( tilebox, Jz->ixType().toIntVect() );
+    const int ncomp_J = 2*n_rz_azimuthal_modes - 1;
 
-        // Lower corner of tile box physical domain
-        // Note that this is done before the tilebox.grow so that
-        // these do not include the guard cells.
+    // Describe the scaling of the field mf on the tile of mfi, given with the index type of mf.
+    // The lower corner of the tile box is computed before the tilebox is grown so that
+    // it does not include the guard cells.
+    const auto make_scaling = [&] (MultiFab& mf, MFIter const& mfi, Box const& tilebox,
+                                   int ncomp, bool is_rho, int wrap_hi_shift,
+                                   amrex::Real wrap_sign, amrex::Real axis_inv_vol)
+    {
+        const amrex::IntVect ng = mf.nGrowVect();
+        RZInverseVolumeScaling s;
+        s.arr = mf.array(mfi);
+        s.ncomp = ncomp;
+        s.is_rho = is_rho;
+        s.dr = dr;
+
+        Box tb = convert( tilebox, mf.ixType().toIntVect() );
         const std::array<amrex::Real, 3>& xyzmin = WarpX::LowerCorner(tilebox, lev, 0._rt);
-        const Real rmin  = xyzmin[0];
-        const Real rminr = xyzmin[0] + (tbr.type(0) == NODE ? 0._rt : 0.5_rt*dx[0]);
-        const Real rmint = xyzmin[0] + (tbt.type(0) == NODE ? 0._rt : 0.5_rt*dx[0]);
-        const Real rminz = xyzmin[0] + (tbz.type(0) == NODE ? 0._rt : 0.5_rt*dx[0]);
-        const Dim3 lo = lbound(tilebox);
-        const int irmin = lo.x;
-
+        const Real rmin = xyzmin[0];
+        s.rmin = xyzmin[0] + (tb.type(0) == NODE ? 0._rt : 0.5_rt*dx[0]);
+        s.irmin = lbound(tilebox).x;
         // For ishift, 1 means cell centered, 0 means node centered
-        int const ishift_r = (rminr > rmin ? 1 : 0);
-        int const ishift_t = (rmint > rmin ? 1 : 0);
-        int const ishift_z = (rminz > rmin ? 1 : 0);
+        s.ishift = (s.rmin > rmin ? 1 : 0);
 
-        const int nmodes = n_rz_azimuthal_modes;
+        // The deposition in the guard cells at negative radius is wrapped around
+        // to the points above the axis.
+        s.wrap = (rmin == 0._rt);
+        s.wrap_hi = ng[0] - s.ishift - wrap_hi_shift;
+        s.wrap_sign = wrap_sign;
+        s.axis_inv_volume = axis_inv_vol;
 
-        // Grow the tileboxes to include the guard cells, except for the
+        // Grow the tilebox to include the guard cells, except for the
         // guard cells at negative radius.
         if (rmin > 0._rt) {
-           tbr.growLo(0, ngJ[0]);
-           tbt.growLo(0, ngJ[0]);
-           tbz.growLo(0, ngJ[0]);
+            tb.growLo(0, ng[0]);
+        }
+        tb.growHi(0, ng[0]);
+        tb.grow(1, ng[1]);
+        s.box = tb;
+        return s;
+    };
+
+    MultiFab& mf_iter = has_J ? *Jx : *Rho;
+    for ( MFIter mfi(mf_iter, TilingIfNotGPU()); mfi.isValid(); ++mfi )
+    {
+        amrex::GpuArray<RZInverseVolumeScaling, 4> scalings;
+        int nscalings = 0;
+
+        if (has_J) {
+            Box const & tilebox = mfi.tilebox();
+            // Jr and Jt are forced to zero on axis.
+            // If a component is node centered, its point 0 is located on the boundary.
+            // If it is cell centered, its point 0 is at 1/2 dr.
+            scalings[nscalings++] = make_scaling(*Jx, mfi, tilebox, ncomp_J, false, 1, -1._rt, 0._rt);
+            scalings[nscalings++] = make_scaling(*Jy, mfi, tilebox, ncomp_J, false, 0, -1._rt, 0._rt);
+            scalings[nscalings++] = make_scaling(*Jz, mfi, tilebox, ncomp_J, false, 0, 1._rt, axis_inv_volume);
+        }
+        if (has_rho) {
+            // Note that the loop is also over ncomps, which takes care of the RZ modes,
+            // as well as the old and new rho.
+            Box const tilebox = mfi.tilebox(Rho->ixType().toIntVect());
+            scalings[nscalings++] = make_scaling(*Rho, mfi, tilebox, Rho->nComp(), true, 0, 1._rt, axis_inv_volume);
+        }
+        Box bx;
+        // The kernel runs over the union of the boxes of the densities, which have different
+        // staggerings
+        for (int n = 0; n < nscalings; ++n) {
+            Box const& b = scalings[n].box;
+            bx = (n == 0) ? Box(b.smallEnd(), b.bigEnd())
+                          : Box(amrex::min(bx.smallEnd(), b.smallEnd()), amrex::max(bx.bigEnd(), b.bigEnd()));
         }
-        tbr.growHi(0, ngJ[0]);
-        tbt.growHi(0, ngJ[0]);
-        tbz.growHi(0, ngJ[0]);
-        tbr.grow(1, ngJ[1]);
-        tbt.grow(1, ngJ[1]);
-        tbz.grow(1, ngJ[1]);
-
-        // Rescale current in r-z mode since the inverse volume factor was not
-        // included in the current deposition.
-        amrex::ParallelFor(tbr, tbt, tbz,
-        [=] AMREX_GPU_DEVICE (int i, int j, int /*k*/)
-        {
-            // Wrap the current density deposited in the guard cells around
-            // to the cells above the axis.
-            // If Jr is node centered, Jr[0] is located on the boundary.
-            // If Jr is cell centered, Jr[0] is at 1/2 dr.
-            if (rmin == 0. && 1-ishift_r <= i && i < ngJ[0]-ishift_r) {
-                Jr_arr(i,j,0,0) -= Jr_arr(-ishift_r-i,j,0,0);
-            }
-            // Apply the inverse volume scaling
-            // Jr is forced to zero on axis
-            const amrex::Real r = amrex::Math::abs(rminr + (i - irmin)*dr);
-            if (r == 0._rt) {
-                Jr_arr(i,j,0,0) = 0._rt;
-            } else {
-                Jr_arr(i,j,0,0) /= (2._rt*MathConst::pi*r);
-            }
-
-            for (int imode=1 ; imode < nmodes ; imode++) {
-                // Wrap the current density deposited in the guard cells around
-                // to the cells above the axis.
-                if (rmin == 0._rt && 1-ishift_r <= i && i < ngJ[0]-ishift_r) {
-                    Jr_arr(i,j,0,2*imode-1) += static_cast<amrex::Real>(std::pow(-1, imode+1)*Jr_arr(-ishift_r-i,j,0,2*imode-1));
-                    Jr_arr(i,j,0,2*imode) += static_cast<amrex::Real>(std::pow(-1, imode+1)*Jr_arr(-ishift_r-i,j,0,2*imode));
-                }
-                // Apply the inverse volume scaling
-                // Jr is forced to zero on axis.
-                if (r == 0._rt) {
-                    Jr_arr(i,j,0,2*imode-1) = 0._rt;
-                    Jr_arr(i,j,0,2*imode) = 0._rt;
-                } else {
-                    Jr_arr(i,j,0,2*imode-1) /= (2._rt*MathConst::pi*r);
-                    Jr_arr(i,j,0,2*imode) /= (2._rt*MathConst::pi*r);
-                }
-            }
-        },
-        [=] AMREX_GPU_DEVICE (int i, int j, int /*k*/)
-        {
-            // Wrap the current density deposited in the guard cells around
-            // to the cells above the axis.
-            // If Jt is node centered, Jt[0] is located on the boundary.
-            // If Jt is cell centered, Jt[0] is at 1/2 dr.
-            if (rmin == 0._rt && 1-ishift_t <= i && i <= ngJ[0]-ishift_t) {
-                Jt_arr(i,j,0,0) -= Jt_arr(-ishift_t-i,j,0,0);
-            }
-
-            // Apply the inverse volume scaling
-            // Jt is forced to zero on axis.
-            const amrex::Real r = amrex::Math::abs(rmint + (i - irmin)*dr);
-            if (r == 0._rt) {
-                Jt_arr(i,j,0,0) = 0._rt;
-            } else {
-                Jt_arr(i,j,0,0) /= (2._rt*MathConst::pi*r);
-            }
-
-            for (int imode=1 ; imode < nmodes ; imode++) {
-                // Wrap the current density deposited in the guard cells around
-                // to the cells above the axis.
-                if (rmin == 0._rt && 1-ishift_t <= i && i <= ngJ[0]-ishift_t) {
-                    Jt_arr(i,j,0,2*imode-1) += static_cast<amrex::Real>(std::pow(-1, imode+1)*Jt_arr(-ishift_t-i,j,0,2*imode-1));
-                    Jt_arr(i,j,0,2*imode) += static_cast<amrex::Real>(std::pow(-1, imode+1)*Jt_arr(-ishift_t-i,j,0,2*imode));
-                }
 
-                // Apply the inverse volume scaling
-                // Jt is forced to zero on axis.
-                if (r == 0._rt) {
-                    Jt_arr(i,j,0,2*imode-1) = 0._rt;
-                    Jt_arr(i,j,0,2*imode) = 0._rt;
-                } else {
-                    Jt_arr(i,j,0,2*imode-1) /= (2._rt*MathConst::pi*r);
-                    Jt_arr(i,j,0,2*imode) /= (2._rt*MathConst::pi*r);
-                }
-            }
-        },
+        // Rescale the densities in r-z mode since the inverse volume factor was not
+        // included in the deposition.
+        amrex::ParallelFor(bx,
         [=] AMREX_GPU_DEVICE (int i, int j, int /*k*/)
         {
-            // Wrap the current density deposited in the guard cells around
-            // to the cells above the axis.
-            // If Jz is node centered, Jz[0] is located on the boundary.
-            // If Jz is cell centered, Jz[0] is at 1/2 dr.
-            if (rmin == 0._rt && 1-ishift_z <= i && i <= ngJ[0]-ishift_z) {
-                Jz_arr(i,j,0,0) += Jz_arr(-ishift_z-i,j,0,0);
-            }
-
-            // Apply the inverse volume scaling
-            const amrex::Real r = amrex::Math::abs(rminz + (i - irmin)*dr);
-            if (r == 0._rt) {
-                Jz_arr(i,j,0,0) /= (MathConst::pi*dr*axis_volume_factor);
-            } else {
-                Jz_arr(i,j,0,0) /= (2._rt*MathConst::pi*r);
-            }
-
-            for (int imode=1 ; imode < nmodes ; imode++) {
-                // Wrap the current density deposited in the guard cells around
-                // to the cells above the axis.
-                if (rmin == 0._rt && 1-ishift_z <= i && i <= ngJ[0]-ishift_z) {
-                    Jz_arr(i,j,0,2*imode-1) -= static_cast<amrex::Real>(std::pow(-1, imode+1)*Jz_arr(-ishift_z-i,j,0,2*imode-1));
-                    Jz_arr(i,j,0,2*imode) -= static_cast<amrex::Real>(std::pow(-1, imode+1)*Jz_arr(-ishift_z-i,j,0,2*imode));
-                }
-
-                // Apply the inverse volume scaling
-                if (r == 0.) {
-                    Jz_arr(i,j,0,2*imode-1) /= (MathConst::pi*dr*axis_volume_factor);
-                    Jz_arr(i,j,0,2*imode) /= (MathConst::pi*dr*axis_volume_factor);
-                } else {
-                    Jz_arr(i,j,0,2*imode-1) /= (2._rt*MathConst::pi*r);
-                    Jz_arr(i,j,0,2*imode) /= (2._rt*MathConst::pi*r);
-                }
+            for (int n = 0; n < nscalings; ++n) {
+                scalings[n](i, j);
             }
-
         });
     }
 }
 
 void
-WarpX::ApplyInverseVolumeScalingToChargeDensity (MultiFab* Rho, int lev)
+WarpX::ApplyInverseVolumeScalingToCurrentDensity (MultiFab* Jx, MultiFab* Jy, MultiFab* Jz, int lev)
 {
-    const amrex::IntVect ngRho = Rho->nGrowVect();
-    const std::array<Real,3>& dx = WarpX::CellSize(lev);
-    const Real dr = dx[0];
-
-    constexpr int NODE = amrex::IndexType::NODE;
-
-    // See Verboncoeur JCP 174, 421-427 (2001) for the modified volume factor
-    const amrex::Real axis_volume_factor = (verboncoeur_axis_correction ? 1._rt/3._rt : 1._rt/4._rt);
-
-    Box tilebox;
-
-    for ( MFIter mfi(*Rho, TilingIfNotGPU()); mfi.isValid(); ++mfi )
-    {
-
-        Array4<Real> const& Rho_arr = Rho->array(mfi);
-
-        tilebox = mfi.tilebox();
-        Box tb = convert( tilebox, Rho->ixType().toIntVect() );
-
-        // Lower corner of tile box physical domain
-        // Note that this is done before the tilebox.grow so that
-        // these do not include the guard cells.
-        const std::array<amrex::Real, 3>& xyzmin = WarpX::LowerCorner(tilebox, lev, 0._rt);
-        const Dim3 lo = lbound(tilebox);
-        const Real rmin = xyzmin[0];
-        const Real rminr = xyzmin[0] + (tb.type(0) == NODE ? 0._rt : 0.5_rt*dx[0]);
-        const int irmin = lo.x;
-        const int ishift = (rminr > rmin ? 1 : 0);
-
-        // Grow the tilebox to include the guard cells, except for the
-        // guard cells at negative radius.
-        if (rmin > 0.) {
-           tb.growLo(0, ngRho[0]);
-        }
-        tb.growHi(0, ngRho[0]);
-        tb.grow(1, ngRho[1]);
-
-        // Rescale charge in r-z mode since the inverse volume factor was not
-        // included in the charge deposition.
-        // Note that the loop is also over ncomps, which takes care of the RZ modes,
-        // as well as the old and new rho.
-        int const ncomp = Rho->nComp();
-        amrex::ParallelFor(tb, ncomp,
-        [=] AMREX_GPU_DEVICE (int i, int j, int /*k*/, int icomp)
-        {
-            // Wrap the charge density deposited in the guard cells around
-            // to the cells above the axis.
-            // Rho is located on the boundary
-            if (rmin == 0. && 1-ishift <= i && i <= ngRho[0]-ishift) {
-                int imode;
-                if (icomp == 0 || icomp == ncomp/2) {
-                    imode = 0;
-                }
-                else if (icomp < ncomp/2) {
-                    imode = (icomp+1)/2;
-                }
-                else {
-                    imode = (icomp - ncomp/2 + 1)/2;
-                }
-                Rho_arr(i,j,0,icomp) -= static_cast<amrex::Real>(std::pow(-1, imode+1)*Rho_arr(-ishift-i,j,0,icomp));
-            }
+    ApplyInverseVolumeScalingToCurrentAndChargeDensity(Jx, Jy, Jz, nullptr, lev);
+}
 
-            // Apply the inverse volume scaling
-            const amrex::Real r = amrex::Math::abs(rminr + (i - irmin)*dr);
-            if (r == 0.) {
-                Rho_arr(i,j,0,icomp) /= (MathConst::pi*dr*axis_volume_factor);
-            } else {
-                Rho_arr(i,j,0,icomp) /= (2._rt*MathConst::pi*r);
-            }
-        });
-    }
+void
+WarpX::ApplyInverseVolumeScalingToChargeDensity (MultiFab* Rho, int lev)
+{
+    ApplyInverseVolumeScalingToCurrentAndChargeDensity(nullptr, nullptr, nullptr, Rho, lev);
 }
 #endif
@@ -88,12 +88,10 @@ void WarpX::HybridPICEvolveFields ()
         }
     }
 
-    // Calculate the electron pressure at t=n using rho^n
-    m_hybrid_pic_model->CalculateElectronPressure(DtType::FirstHalf);
-
     // Push the B field from t=n to t=n+1/2 using the current and density
     // at t=n, while updating the E field along with B using the electron
     // momentum equation
+    m_hybrid_pic_model->m_valid_guards_B = amrex::IntVect::TheZeroVector();
     for (int sub_step = 0; sub_step < sub_steps; sub_step++)
     {
         m_hybrid_pic_model->BfieldEvolveRK(
@@ -103,6 +101,10 @@ void WarpX::HybridPICEvolveFields ()
             WarpX::sync_nodal_points
         );
     }
+    // With wide guard cells, B is not exchanged after each substep
+    if (m_hybrid_pic_model->m_substeps_per_exchange > 0) {
+        FillBoundaryB(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+    }
 
     // Average rho^{n} and rho^{n+1} to get rho^{n+1/2} in rho_fp_temp
     for (int lev = 0; lev <= finest_level; ++lev)
@@ -116,10 +118,8 @@ void WarpX::HybridPICEvolveFields ()
         );
     }
 
-    // Calculate the electron pressure at t=n+1/2
-    m_hybrid_pic_model->CalculateElectronPressure(DtType::SecondHalf);
-
     // Now push the B field from t=n+1/2 to t=n+1 using the n+1/2 quantities
+    m_hybrid_pic_model->m_valid_guards_B = amrex::IntVect::TheZeroVector();
     for (int sub_step = 0; sub_step < sub_steps; sub_step++)
     {
         m_hybrid_pic_model->BfieldEvolveRK(
@@ -129,6 +129,9 @@ void WarpX::HybridPICEvolveFields ()
             WarpX::sync_nodal_points
         );
     }
+    if (m_hybrid_pic_model->m_substeps_per_exchange > 0) {
+        FillBoundaryB(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+    }
 
     // Extrapolate the ion current density to t=n+1 using
     // J_i^{n+1} = 1/2 * J_i^{n-1/2} + 3/2 * J_i^{n+1/2}, and recalling that
@@ -148,9 +151,6 @@ void WarpX::HybridPICEvolveFields ()
         }
     }
 
-    // Calculate the electron pressure at t=n+1
-    m_hybrid_pic_model->CalculateElectronPressure(DtType::Full);
-
     // Update the E field to t=n+1 using the extrapolated J_i^n+1 value
     m_hybrid_pic_model->CalculateCurrentAmpere(Bfield_fp, m_edge_lengths);
     m_hybrid_pic_model->HybridPICSolveE(
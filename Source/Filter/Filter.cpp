@@ -17,15 +17,141 @@
 #include <AMReX_Extension.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_FabArray.H>
+#include <AMReX_GpuLaunch.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
 
 #include <algorithm>
+#include <array>
 
 using namespace amrex;
 
 #ifdef AMREX_USE_GPU
 
+namespace
+{
+    /* \brief Apply the 1D stencil s of length len along direction idir at (i,j,k),
+     * with src padded with zeros beyond its box.
+     */
+    AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+    Real filter_along (Array4<Real const> const& src, int i, int j, int k, int n,
+                       int idir, Real const* AMREX_RESTRICT s, int len) noexcept
+    {
+        const int di = (idir == 0);
+        const int dj = (idir == 1);
+        const int dk = (idir == 2);
+        const auto src_zeropad = [src] (const int jj, const int kk, const int ll, const int nn) noexcept
+        {
+            return src.contains(jj,kk,ll) ? src(jj,kk,ll,nn) : 0.0_rt;
+        };
+        Real d = 0.0_rt;
+        for (int is = 0; is < len; ++is) {
+            d += s[is]*( src_zeropad(i-is*di, j-is*dj, k-is*dk, n)
+                        +src_zeropad(i+is*di, j+is*dj, k+is*dk, n));
+        }
+        return d;
+    }
+}
+
+/* \brief Apply stencil in place on up to three MultiFabs (GPU version).
+ * The stencil is separable, so it is applied as one 1D pass per direction
+ * rather than as a full tensor-product stencil. Each pass handles the three
+ * MultiFabs in a single launch, and the intermediate results are stored in
+ * temporary fabs of the size of one box instead of a full MultiFab.
+ * \param mfs MultiFabs to filter, null pointers are skipped
+ * \param[in] lev mesh refinement level
+ */
+void
+Filter::ApplyStencil (const std::array<amrex::MultiFab*, 3>& mfs, const int lev)
+{
+    WARPX_PROFILE("Filter::ApplyStencil(MultiFab, in place)");
+
+    const auto ref = std::find_if(mfs.begin(), mfs.end(), [] (MultiFab* mf) { return mf != nullptr; });
+    if (ref == mfs.end()) { return; }
+
+    // 1D stencil and its length in each direction
+#if defined(WARPX_DIM_3D)
+    const std::array<Real const*, AMREX_SPACEDIM> stencils = {stencil_x.data(), stencil_y.data(), stencil_z.data()};
+    const std::array<int, AMREX_SPACEDIM> lengths = {slen.x, slen.y, slen.z};
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    const std::array<Real const*, AMREX_SPACEDIM> stencils = {stencil_x.data(), stencil_z.data()};
+    const std::array<int, AMREX_SPACEDIM> lengths = {slen.x, slen.y};
+#else
+    const std::array<Real const*, AMREX_SPACEDIM> stencils = {stencil_z.data()};
+    const std::array<int, AMREX_SPACEDIM> lengths = {slen.x};
+#endif
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+
+    for (MFIter mfi(**ref); mfi.isValid(); ++mfi)
+    {
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+        }
+        auto wt = static_cast<amrex::Real>(amrex::second());
+
+        // Full box of each fab, guard cells included, and temporaries for the
+        // intermediate passes (the last pass writes back into the MultiFab)
+        std::array<Array4<Real>, 3> arr;
+        std::array<Box, 3> bx;
+        std::array<int, 3> ncomp = {0, 0, 0};
+        std::array<std::array<FArrayBox, 2>, 3> tmp;
+        for (int c = 0; c < 3; ++c) {
+            if (mfs[c] == nullptr) { continue; }
+            arr[c] = mfs[c]->array(mfi);
+            bx[c] = (*mfs[c])[mfi].box();
+            ncomp[c] = mfs[c]->nComp();
+            for (int it = 0; it < std::max(AMREX_SPACEDIM-1, 1); ++it) {
+                tmp[c][it].resize(bx[c], ncomp[c], The_Async_Arena());
+            }
+        }
+
+        for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+            // In 1D, the only pass writes into a temporary, which is then copied back
+            const bool last = (idir == AMREX_SPACEDIM-1) && (idir > 0);
+            const auto in = [&] (int c) -> Array4<Real const> {
+                return (idir == 0) ? Array4<Real const>(arr[c]) : tmp[c][(idir-1)%2].const_array();
+            };
+            const auto out = [&] (int c) -> Array4<Real> {
+                return last ? arr[c] : tmp[c][idir%2].array();
+            };
+            Array4<Real const> const in0 = in(0), in1 = in(1), in2 = in(2);
+            Array4<Real> const out0 = out(0), out1 = out(1), out2 = out(2);
+            Real const* AMREX_RESTRICT s = stencils[idir];
+            const int len = lengths[idir];
+
+            amrex::ParallelFor(
+                bx[0], ncomp[0], [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
+                    out0(i,j,k,n) = ::filter_along(in0, i, j, k, n, idir, s, len);
+                },
+                bx[1], ncomp[1], [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
+                    out1(i,j,k,n) = ::filter_along(in1, i, j, k, n, idir, s, len);
+                },
+                bx[2], ncomp[2], [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
+                    out2(i,j,k,n) = ::filter_along(in2, i, j, k, n, idir, s, len);
+                });
+        }
+#if defined(WARPX_DIM_1D_Z)
+        {
+            Array4<Real const> const t0 = tmp[0][0].const_array(), t1 = tmp[1][0].const_array(), t2 = tmp[2][0].const_array();
+            Array4<Real> const a0 = arr[0], a1 = arr[1], a2 = arr[2];
+            amrex::ParallelFor(
+                bx[0], ncomp[0], [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) { a0(i,j,k,n) = t0(i,j,k,n); },
+                bx[1], ncomp[1], [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) { a1(i,j,k,n) = t1(i,j,k,n); },
+                bx[2], ncomp[2], [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) { a2(i,j,k,n) = t2(i,j,k,n); });
+        }
+#endif
+
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+            wt = static_cast<amrex::Real>(amrex::second()) - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
+    }
+}
+
 /* \brief Apply stencil on MultiFab (GPU version, 2D/3D).
  * \param dstmf Destination MultiFab
  * \param srcmf source MultiFab
@@ -244,6 +370,23 @@ Filter::ApplyStencil (amrex::MultiFab& dstmf, const amrex::MultiFab& srcmf, cons
     }
 }
 
+/* \brief Apply stencil in place on up to three MultiFabs (CPU version).
+ * \param mfs MultiFabs to filter, null pointers are skipped
+ * \param[in] lev mesh refinement level
+ */
+void
+Filter::ApplyStencil (const std::array<amrex::MultiFab*, 3>& mfs, const int lev)
+{
+    for (MultiFab* mf : mfs) {
+        if (mf == nullptr) { continue; }
+        const int ncomp = mf->nComp();
+        const amrex::IntVect ngrow = mf->nGrowVect();
+        MultiFab src(mf->boxArray(), mf->DistributionMap(), ncomp, ngrow);
+        MultiFab::Copy(src, *mf, 0, 0, ncomp, ngrow);
+        ApplyStencil(*mf, src, lev);
+    }
+}
+
 /* \brief Apply stencil on FArrayBox (CPU version, 2D/3D).
  * \param dstfab Destination FArrayBox
  * \param srcmf source FArrayBox
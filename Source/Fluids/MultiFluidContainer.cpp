@@ -8,6 +8,13 @@
 #include "MultiFluidContainer.H"
 #include "Fluids/WarpXFluidContainer.H"
 #include "Utils/Parser/ParserUtils.H"
+#include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
+
+#include <ablastr/coarsen/sample.H>
+
+#include <AMReX_GpuContainers.H>
+#include <AMReX_iMultiFab.H>
 
 #include <string>
 
@@ -44,20 +51,16 @@ MultiFluidContainer::InitData (int lev, amrex::Box init_box, amrex::Real cur_tim
 
 
 void
-MultiFluidContainer::DepositCharge (int lev, amrex::MultiFab &rho)
+MultiFluidContainer::DepositCharge (int lev, amrex::MultiFab &rho, int icomp)
 {
-    for (auto& fl : allcontainers) {
-        fl->DepositCharge(lev,rho);
-    }
+    DepositCharge(lev, SelectSpecies(), rho, icomp);
 }
 
 void
 MultiFluidContainer::DepositCurrent (int lev,
     amrex::MultiFab& jx, amrex::MultiFab& jy, amrex::MultiFab& jz)
 {
-    for (auto& fl : allcontainers) {
-        fl->DepositCurrent(lev,jx,jy,jz);
-    }
+    DepositCurrent(lev, SelectSpecies(), jx, jy, jz);
 }
 
 void
@@ -67,7 +70,304 @@ MultiFluidContainer::Evolve (int lev,
                             MultiFab* rho, MultiFab& jx, MultiFab& jy, MultiFab& jz,
                             amrex::Real cur_time, bool skip_deposition)
 {
+    WARPX_PROFILE("MultiFluidContainer::Evolve");
+
+    // Same steps as WarpXFluidContainer::Evolve: the species are independent
+    // during a step, so each step is done for all the species at once
+    const amrex::Vector<int> deposited = SelectSpecies(&WarpXFluidContainer::do_not_deposit);
+
+    if (rho && ! skip_deposition) {
+        // Deposit charge before particle push, in component 0 of MultiFab rho.
+        DepositCharge(lev, deposited, *rho, 0);
+    }
+
+    // Step the Lorentz Term
+    GatherAndPush(lev, SelectSpecies(&WarpXFluidContainer::do_not_gather),
+                  Ex, Ey, Ez, Bx, By, Bz, cur_time);
+
+    // The advective push needs the neighbor values, after the communication of the guard
+    // cells, and is done species by species
     for (auto& fl : allcontainers) {
-        fl->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, rho, jx, jy, jz, cur_time, skip_deposition);
+        if (fl->do_not_push) { continue; }
+#if defined(WARPX_DIM_RZ)
+        // Cylindrical centrifugal term
+        fl->centrifugal_source_rz(lev);
+#endif
+        fl->ApplyBcFluidsAndComms(lev);
+        fl->AdvectivePush_Muscl(lev);
+    }
+
+    // Deposit charge (end of the step)
+    if (rho && ! skip_deposition) {
+        DepositCharge(lev, deposited, *rho, 1);
+    }
+
+    // Deposit J to the simulation mesh
+    if (!skip_deposition) {
+        DepositCurrent(lev, deposited, jx, jy, jz);
+    }
+}
+
+amrex::Vector<int>
+MultiFluidContainer::SelectSpecies (int WarpXFluidContainer::* skip_flag) const
+{
+    amrex::Vector<int> species;
+    for (int i = 0; i < nSpecies(); ++i) {
+        if (skip_flag && (*allcontainers[i]).*skip_flag) { continue; }
+        species.push_back(i);
+    }
+    return species;
+}
+
+amrex::Gpu::DeviceVector<FluidSpeciesTileData>
+MultiFluidContainer::GetSpeciesTable (int lev, amrex::Vector<int> const& species) const
+{
+    const auto nsp = static_cast<int>(species.size());
+    amrex::MultiFab const& N0 = *allcontainers[species[0]]->N[lev];
+
+    amrex::Vector<FluidSpeciesTileData> h_table(N0.local_size()*nsp);
+    for (MFIter mfi(N0); mfi.isValid(); ++mfi) {
+        for (int is = 0; is < nsp; ++is) {
+            h_table[mfi.LocalIndex()*nsp + is] = allcontainers[species[is]]->getTileData(lev, mfi);
+        }
+    }
+
+    amrex::Gpu::DeviceVector<FluidSpeciesTileData> d_table(h_table.size());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_table.begin(), h_table.end(), d_table.begin());
+    // h_table is destroyed on return, so the copy must be complete
+    amrex::Gpu::streamSynchronize();
+    return d_table;
+}
+
+void
+MultiFluidContainer::GatherAndPush (int lev, amrex::Vector<int> const& species,
+    const amrex::MultiFab& Ex, const amrex::MultiFab& Ey, const amrex::MultiFab& Ez,
+    const amrex::MultiFab& Bx, const amrex::MultiFab& By, const amrex::MultiFab& Bz,
+    amrex::Real t)
+{
+    if (species.empty()) { return; }
+
+    WARPX_PROFILE("MultiFluidContainer::GatherAndPush");
+
+    WarpX &warpx = WarpX::GetInstance();
+    const Real dt = warpx.getdt(lev);
+    const amrex::Geometry &geom = warpx.Geom(lev);
+    const auto dx = geom.CellSizeArray();
+    const auto problo = geom.ProbLoArray();
+    const amrex::Real gamma_boost = WarpX::gamma_boost;
+    const amrex::Real beta_boost = WarpX::beta_boost;
+
+    amrex::MultiFab const& N0 = *allcontainers[species[0]]->N[lev];
+
+    auto Nodal_type = amrex::GpuArray<int, 3>{0, 0, 0};
+    auto Ex_type = amrex::GpuArray<int, 3>{0, 0, 0};
+    auto Ey_type = amrex::GpuArray<int, 3>{0, 0, 0};
+    auto Ez_type = amrex::GpuArray<int, 3>{0, 0, 0};
+    auto Bx_type = amrex::GpuArray<int, 3>{0, 0, 0};
+    auto By_type = amrex::GpuArray<int, 3>{0, 0, 0};
+    auto Bz_type = amrex::GpuArray<int, 3>{0, 0, 0};
+    for (int i = 0; i < AMREX_SPACEDIM; ++i)
+    {
+        Nodal_type[i] = N0.ixType()[i];
+        Ex_type[i] = Ex.ixType()[i];
+        Ey_type[i] = Ey.ixType()[i];
+        Ez_type[i] = Ez.ixType()[i];
+        Bx_type[i] = Bx.ixType()[i];
+        By_type[i] = By.ixType()[i];
+        Bz_type[i] = Bz.ixType()[i];
+    }
+
+    const auto nsp = static_cast<int>(species.size());
+    auto const table = GetSpeciesTable(lev, species);
+    FluidSpeciesTileData const* table_ptr = table.dataPtr();
+
+    // H&C push the momentum
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(N0, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        amrex::Box const &tile_box = mfi.tilebox(N0.ixType().toIntVect());
+        FluidSpeciesTileData const* box_species = table_ptr + mfi.LocalIndex()*nsp;
+
+        amrex::Array4<const amrex::Real> const& Ex_arr = Ex.array(mfi);
+        amrex::Array4<const amrex::Real> const& Ey_arr = Ey.array(mfi);
+        amrex::Array4<const amrex::Real> const& Ez_arr = Ez.array(mfi);
+        amrex::Array4<const amrex::Real> const& Bx_arr = Bx.array(mfi);
+        amrex::Array4<const amrex::Real> const& By_arr = By.array(mfi);
+        amrex::Array4<const amrex::Real> const& Bz_arr = Bz.array(mfi);
+
+        // Here, we do not perform any coarsening.
+        const amrex::GpuArray<int, 3U> coarsening_ratio = {1, 1, 1};
+
+        amrex::ParallelFor(tile_box,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+            {
+                // Skip the nodes without fluid
+                bool has_fluid = false;
+                for (int is = 0; is < nsp; ++is) {
+                    if (box_species[is].N(i,j,k) > 0.0) { has_fluid = true; }
+                }
+                if (!has_fluid) { return; }
+
+                // Interpolate fields to the Nodal points, once for all the species
+                const amrex::Real Ex_Nodal = ablastr::coarsen::sample::Interp(Ex_arr,
+                    Ex_type, Nodal_type, coarsening_ratio, i, j, k, 0);
+                const amrex::Real Ey_Nodal = ablastr::coarsen::sample::Interp(Ey_arr,
+                    Ey_type, Nodal_type, coarsening_ratio, i, j, k, 0);
+                const amrex::Real Ez_Nodal = ablastr::coarsen::sample::Interp(Ez_arr,
+                    Ez_type, Nodal_type, coarsening_ratio, i, j, k, 0);
+                const amrex::Real Bx_Nodal = ablastr::coarsen::sample::Interp(Bx_arr,
+                    Bx_type, Nodal_type, coarsening_ratio, i, j, k, 0);
+                const amrex::Real By_Nodal = ablastr::coarsen::sample::Interp(By_arr,
+                    By_type, Nodal_type, coarsening_ratio, i, j, k, 0);
+                const amrex::Real Bz_Nodal = ablastr::coarsen::sample::Interp(Bz_arr,
+                    Bz_type, Nodal_type, coarsening_ratio, i, j, k, 0);
+
+                for (int is = 0; is < nsp; ++is) {
+                    fluids::PushMomentumAtNode(box_species[is], i, j, k,
+                        Ex_Nodal, Ey_Nodal, Ez_Nodal, Bx_Nodal, By_Nodal, Bz_Nodal,
+                        t, dt, gamma_boost, beta_boost, problo, dx);
+                }
+            }
+        );
+    }
+    // the table must stay allocated until the kernels are done
+    amrex::Gpu::streamSynchronize();
+}
+
+void
+MultiFluidContainer::DepositCharge (int lev, amrex::Vector<int> const& species,
+                                    amrex::MultiFab &rho, int icomp)
+{
+    if (species.empty()) { return; }
+
+    WARPX_PROFILE("MultiFluidContainer::DepositCharge");
+
+    WarpX &warpx = WarpX::GetInstance();
+    const amrex::Geometry &geom = warpx.Geom(lev);
+    const amrex::Periodicity &period = geom.periodicity();
+    auto const &owner_mask_rho = amrex::OwnerMask(rho, period);
+
+    // Assertion, make sure rho is at the same location as N
+    AMREX_ALWAYS_ASSERT(rho.ixType().nodeCentered());
+
+    amrex::MultiFab const& N0 = *allcontainers[species[0]]->N[lev];
+    const auto nsp = static_cast<int>(species.size());
+    auto const table = GetSpeciesTable(lev, species);
+    FluidSpeciesTileData const* table_ptr = table.dataPtr();
+
+    // Loop over and deposit charge density
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(N0, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        amrex::Box const &tile_box = mfi.tilebox(N0.ixType().toIntVect());
+        FluidSpeciesTileData const* box_species = table_ptr + mfi.LocalIndex()*nsp;
+        const amrex::Array4<amrex::Real> rho_arr = rho.array(mfi);
+        const amrex::Array4<int> owner_mask_rho_arr = owner_mask_rho->array(mfi);
+
+        amrex::ParallelFor(tile_box,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+            {
+                if ( !owner_mask_rho_arr(i,j,k) ) { return; }
+                for (int is = 0; is < nsp; ++is) {
+                    rho_arr(i,j,k,icomp) += box_species[is].q*box_species[is].N(i,j,k);
+                }
+            }
+        );
+    }
+    amrex::Gpu::streamSynchronize();
+}
+
+void
+MultiFluidContainer::DepositCurrent (int lev, amrex::Vector<int> const& species,
+    amrex::MultiFab& jx, amrex::MultiFab& jy, amrex::MultiFab& jz)
+{
+    if (species.empty()) { return; }
+
+    WARPX_PROFILE("MultiFluidContainer::DepositCurrent");
+
+    amrex::MultiFab const& N0 = *allcontainers[species[0]]->N[lev];
+
+    // Prepare interpolation of current components from the nodes
+    auto j_nodal_type = amrex::GpuArray<int, 3>{0, 0, 0};
+    auto jx_type = amrex::GpuArray<int, 3>{0, 0, 0};
+    auto jy_type = amrex::GpuArray<int, 3>{0, 0, 0};
+    auto jz_type = amrex::GpuArray<int, 3>{0, 0, 0};
+    for (int i = 0; i < AMREX_SPACEDIM; ++i)
+    {
+        j_nodal_type[i] = N0.ixType()[i];
+        jx_type[i] = jx.ixType()[i];
+        jy_type[i] = jy.ixType()[i];
+        jz_type[i] = jz.ixType()[i];
+    }
+
+    // Mask to fix the double counting
+    WarpX &warpx = WarpX::GetInstance();
+    const amrex::Geometry &geom = warpx.Geom(lev);
+    const amrex::Periodicity &period = geom.periodicity();
+    auto const &owner_mask_x = amrex::OwnerMask(jx, period);
+    auto const &owner_mask_y = amrex::OwnerMask(jy, period);
+    auto const &owner_mask_z = amrex::OwnerMask(jz, period);
+
+    const auto nsp = static_cast<int>(species.size());
+    auto const table = GetSpeciesTable(lev, species);
+    FluidSpeciesTileData const* table_ptr = table.dataPtr();
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(N0, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        amrex::Box const &tile_box_x = mfi.tilebox(jx.ixType().toIntVect());
+        amrex::Box const &tile_box_y = mfi.tilebox(jy.ixType().toIntVect());
+        amrex::Box const &tile_box_z = mfi.tilebox(jz.ixType().toIntVect());
+        FluidSpeciesTileData const* box_species = table_ptr + mfi.LocalIndex()*nsp;
+
+        const amrex::Array4<amrex::Real> jx_arr = jx.array(mfi);
+        const amrex::Array4<amrex::Real> jy_arr = jy.array(mfi);
+        const amrex::Array4<amrex::Real> jz_arr = jz.array(mfi);
+
+        const amrex::Array4<int> owner_mask_x_arr = owner_mask_x->array(mfi);
+        const amrex::Array4<int> owner_mask_y_arr = owner_mask_y->array(mfi);
+        const amrex::Array4<int> owner_mask_z_arr = owner_mask_z->array(mfi);
+
+        // Interpolate the fluid current of all the species and deposit it
+        // ( mask double counting )
+        amrex::ParallelFor( tile_box_x, tile_box_y, tile_box_z,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+            {
+                if ( !owner_mask_x_arr(i,j,k) ) { return; }
+                for (int is = 0; is < nsp; ++is) {
+                    FluidSpeciesTileData const& s = box_species[is];
+                    jx_arr(i, j, k) += fluids::InterpFromNodes(
+                        [&] (int ii, int jj, int kk) { return fluids::CurrentAtNode(s, 0, ii, jj, kk); },
+                        j_nodal_type, jx_type, i, j, k);
+                }
+            },
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+            {
+                if ( !owner_mask_y_arr(i,j,k) ) { return; }
+                for (int is = 0; is < nsp; ++is) {
+                    FluidSpeciesTileData const& s = box_species[is];
+                    jy_arr(i, j, k) += fluids::InterpFromNodes(
+                        [&] (int ii, int jj, int kk) { return fluids::CurrentAtNode(s, 1, ii, jj, kk); },
+                        j_nodal_type, jy_type, i, j, k);
+                }
+            },
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+            {
+                if ( !owner_mask_z_arr(i,j,k) ) { return; }
+                for (int is = 0; is < nsp; ++is) {
+                    FluidSpeciesTileData const& s = box_species[is];
+                    jz_arr(i, j, k) += fluids::InterpFromNodes(
+                        [&] (int ii, int jj, int kk) { return fluids::CurrentAtNode(s, 2, ii, jj, kk); },
+                        j_nodal_type, jz_type, i, j, k);
+                }
+            }
+        );
     }
+    amrex::Gpu::streamSynchronize();
 }
@@ -434,31 +434,14 @@ void WarpXFluidContainer::AdvectivePush_Muscl (int lev)
     const amrex::Real dt_over_dz_half = 0.5_rt*(dt/dx[0]);
 #endif
 
-    const amrex::BoxArray ba = N[lev]->boxArray();
-
-    // Temporary Half-step values
-#if defined(WARPX_DIM_3D)
-    amrex::MultiFab tmp_U_minus_x( amrex::convert(ba, IntVect(0,1,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_x( amrex::convert(ba, IntVect(0,1,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_minus_y( amrex::convert(ba, IntVect(1,0,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_y( amrex::convert(ba, IntVect(1,0,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_minus_z( amrex::convert(ba, IntVect(1,1,0)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_z( amrex::convert(ba, IntVect(1,1,0)), N[lev]->DistributionMap(), 4, 1);
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-    amrex::MultiFab tmp_U_minus_x( amrex::convert(ba, IntVect(0,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_x( amrex::convert(ba, IntVect(0,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_minus_z( amrex::convert(ba, IntVect(1,0)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_z( amrex::convert(ba, IntVect(1,0)), N[lev]->DistributionMap(), 4, 1);
-#else
-    amrex::MultiFab tmp_U_minus_z( amrex::convert(ba, IntVect(0)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_z( amrex::convert(ba, IntVect(0)), N[lev]->DistributionMap(), 4, 1);
-#endif
-
-    // Fill edge values of N and U at the half timestep for MUSCL
+    // For each box, fill the edge values of N and U at the half timestep for
+    // MUSCL in box-local temporaries, then compute the fluxes and update N, NU.
+    // The boxes are not tiled, since the edge values of a tile read N and NU
+    // in the neighboring tiles, which would already be updated.
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
-    for (MFIter mfi(*N[lev], TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    for (MFIter mfi(*N[lev]); mfi.isValid(); ++mfi)
     {
 
         // Loop over a box with one extra gridpoint in the ghost region to avoid
@@ -486,36 +469,48 @@ void WarpXFluidContainer::AdvectivePush_Muscl (int lev)
         amrex::Box box = mfi.validbox();
         box.grow(1);
 #if defined(WARPX_DIM_3D)
-        amrex::Box const box_x = amrex::convert( box, tmp_U_minus_x.ixType() );
-        amrex::Box const box_y = amrex::convert( box, tmp_U_minus_y.ixType() );
-        amrex::Box const box_z = amrex::convert( box, tmp_U_minus_z.ixType() );
+        amrex::Box const box_x = amrex::convert( box, IntVect(0,1,1) );
+        amrex::Box const box_y = amrex::convert( box, IntVect(1,0,1) );
+        amrex::Box const box_z = amrex::convert( box, IntVect(1,1,0) );
 #elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-        amrex::Box const box_x = amrex::convert( box, tmp_U_minus_x.ixType() );
-        amrex::Box const box_z = amrex::convert( box, tmp_U_minus_z.ixType() );
+        amrex::Box const box_x = amrex::convert( box, IntVect(0,1) );
+        amrex::Box const box_z = amrex::convert( box, IntVect(1,0) );
 #else
-        amrex::Box const box_z = amrex::convert( box, tmp_U_minus_z.ixType() );
+        amrex::Box const box_z = amrex::convert( box, IntVect(0) );
 #endif
 
         //N and NU are always defined at the nodes, the tmp_Q_* are defined
         //in between the nodes (i.e. on the staggered Yee grid) and store the
         //values of N and U at these points.
         //(i.e. the 4 components correspond to N + the 3 components of U)
-        // Extract the temporary arrays for edge values
+        // Temporary arrays for edge values
 #if defined(WARPX_DIM_3D)
-        const amrex::Array4<amrex::Real> U_minus_x = tmp_U_minus_x.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_x = tmp_U_plus_x.array(mfi);
-        const amrex::Array4<amrex::Real> U_minus_y = tmp_U_minus_y.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_y = tmp_U_plus_y.array(mfi);
-        const amrex::Array4<amrex::Real> U_minus_z = tmp_U_minus_z.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_z = tmp_U_plus_z.array(mfi);
+        amrex::FArrayBox tmp_U_minus_x(box_x, 4, amrex::The_Async_Arena());
+        amrex::FArrayBox tmp_U_plus_x(box_x, 4, amrex::The_Async_Arena());
+        amrex::FArrayBox tmp_U_minus_y(box_y, 4, amrex::The_Async_Arena());
+        amrex::FArrayBox tmp_U_plus_y(box_y, 4, amrex::The_Async_Arena());
+        amrex::FArrayBox tmp_U_minus_z(box_z, 4, amrex::The_Async_Arena());
+        amrex::FArrayBox tmp_U_plus_z(box_z, 4, amrex::The_Async_Arena());
+        const amrex::Array4<amrex::Real> U_minus_x = tmp_U_minus_x.array();
+        const amrex::Array4<amrex::Real> U_plus_x = tmp_U_plus_x.array();
+        const amrex::Array4<amrex::Real> U_minus_y = tmp_U_minus_y.array();
+        const amrex::Array4<amrex::Real> U_plus_y = tmp_U_plus_y.array();
+        const amrex::Array4<amrex::Real> U_minus_z = tmp_U_minus_z.array();
+        const amrex::Array4<amrex::Real> U_plus_z = tmp_U_plus_z.array();
 #elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-        const amrex::Array4<amrex::Real> U_minus_x = tmp_U_minus_x.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_x = tmp_U_plus_x.array(mfi);
-        const amrex::Array4<amrex::Real> U_minus_z = tmp_U_minus_z.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_z = tmp_U_plus_z.array(mfi);
+        amrex::FArrayBox tmp_U_minus_x(box_x, 4, amrex::The_Async_Arena());
+        amrex::FArrayBox tmp_U_plus_x(box_x, 4, amrex::The_Async_Arena());
+        amrex::FArrayBox tmp_U_minus_z(box_z, 4, amrex::The_Async_Arena());
+        amrex::FArrayBox tmp_U_plus_z(box_z, 4, amrex::The_Async_Arena());
+        const amrex::Array4<amrex::Real> U_minus_x = tmp_U_minus_x.array();
+        const amrex::Array4<amrex::Real> U_plus_x = tmp_U_plus_x.array();
+        const amrex::Array4<amrex::Real> U_minus_z = tmp_U_minus_z.array();
+        const amrex::Array4<amrex::Real> U_plus_z = tmp_U_plus_z.array();
 #else
-        const amrex::Array4<amrex::Real> U_minus_z = tmp_U_minus_z.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_z = tmp_U_plus_z.array(mfi);
+        amrex::FArrayBox tmp_U_minus_z(box_z, 4, amrex::The_Async_Arena());
+        amrex::FArrayBox tmp_U_plus_z(box_z, 4, amrex::The_Async_Arena());
+        const amrex::Array4<amrex::Real> U_minus_z = tmp_U_minus_z.array();
+        const amrex::Array4<amrex::Real> U_plus_z = tmp_U_plus_z.array();
 #endif
 
         amrex::ParallelFor(tile_box,
@@ -735,38 +730,9 @@ void WarpXFluidContainer::AdvectivePush_Muscl (int lev)
                 }
             }
         );
-    }
-
-    // Given the values of `U_minus` and `U_plus`, compute fluxes in between nodes, and update N, NU accordingly
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
-#endif
-    for (MFIter mfi(*N[lev], TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
-        const amrex::Box tile_box = mfi.tilebox(N[lev]->ixType().toIntVect());
-        const amrex::Array4<Real> N_arr = N[lev]->array(mfi);
-        const amrex::Array4<Real> NUx_arr = NU[lev][0]->array(mfi);
-        const amrex::Array4<Real> NUy_arr = NU[lev][1]->array(mfi);
-        const amrex::Array4<Real> NUz_arr = NU[lev][2]->array(mfi);
 
-#if defined(WARPX_DIM_3D)
-        amrex::Array4<amrex::Real> const &U_minus_x = tmp_U_minus_x.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_x = tmp_U_plus_x.array(mfi);
-        amrex::Array4<amrex::Real> const &U_minus_y = tmp_U_minus_y.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_y = tmp_U_plus_y.array(mfi);
-        amrex::Array4<amrex::Real> const &U_minus_z = tmp_U_minus_z.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_z = tmp_U_plus_z.array(mfi);
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-        amrex::Array4<amrex::Real> const &U_minus_x = tmp_U_minus_x.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_x = tmp_U_plus_x.array(mfi);
-        amrex::Array4<amrex::Real> const &U_minus_z = tmp_U_minus_z.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_z = tmp_U_plus_z.array(mfi);
-#else
-        amrex::Array4<amrex::Real> const &U_minus_z = tmp_U_minus_z.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_z = tmp_U_plus_z.array(mfi);
-#endif
-
-        amrex::ParallelFor(tile_box,
+        // Given the values of `U_minus` and `U_plus`, compute fluxes in between nodes, and update N, NU accordingly
+        amrex::ParallelFor(mfi.validbox(),
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
             {
 
@@ -955,18 +921,12 @@ void WarpXFluidContainer::GatherAndPush (
     WARPX_PROFILE("WarpXFluidContainer::GatherAndPush");
 
     WarpX &warpx = WarpX::GetInstance();
-    const amrex::Real q = getCharge();
-    const amrex::Real m = getMass();
     const Real dt = warpx.getdt(lev);
     const amrex::Geometry &geom = warpx.Geom(lev);
     const auto dx = geom.CellSizeArray();
     const auto problo = geom.ProbLoArray();
     const amrex::Real gamma_boost = WarpX::gamma_boost;
     const amrex::Real beta_boost = WarpX::beta_boost;
-    //Check whether m_E_ext_s is "none"
-    bool external_e_fields; // Needs intializing
-    bool external_b_fields; // Needs intializing
-
 
     // Prepare interpolation of current components to cell center
     auto Nodal_type = amrex::GpuArray<int, 3>{0, 0, 0};
@@ -987,30 +947,6 @@ void WarpXFluidContainer::GatherAndPush (
         Bz_type[i] = Bz.ixType()[i];
     }
 
-    // External field parsers
-    external_e_fields = (m_E_ext_s == "parse_e_ext_function");
-    external_b_fields = (m_B_ext_s == "parse_b_ext_function");
-    amrex::ParserExecutor<4> Exfield_parser;
-    amrex::ParserExecutor<4> Eyfield_parser;
-    amrex::ParserExecutor<4> Ezfield_parser;
-    amrex::ParserExecutor<4> Bxfield_parser;
-    amrex::ParserExecutor<4> Byfield_parser;
-    amrex::ParserExecutor<4> Bzfield_parser;
-    if (external_e_fields){
-        constexpr int num_arguments = 4; //x,y,z,t
-        Exfield_parser = m_Ex_parser->compile<num_arguments>();
-        Eyfield_parser = m_Ey_parser->compile<num_arguments>();
-        Ezfield_parser = m_Ez_parser->compile<num_arguments>();
-    }
-
-    if (external_b_fields){
-        constexpr int num_arguments = 4; //x,y,z,t
-        Bxfield_parser = m_Bx_parser->compile<num_arguments>();
-        Byfield_parser = m_By_parser->compile<num_arguments>();
-        Bzfield_parser = m_Bz_parser->compile<num_arguments>();
-    }
-
-
     // H&C push the momentum
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
@@ -1020,10 +956,7 @@ void WarpXFluidContainer::GatherAndPush (
 
         amrex::Box const &tile_box = mfi.tilebox(N[lev]->ixType().toIntVect());
 
-        amrex::Array4<Real> const &N_arr = N[lev]->array(mfi);
-        const amrex::Array4<Real> NUx_arr = NU[lev][0]->array(mfi);
-        const amrex::Array4<Real> NUy_arr = NU[lev][1]->array(mfi);
-        const amrex::Array4<Real> NUz_arr = NU[lev][2]->array(mfi);
+        const FluidSpeciesTileData species = getTileData(lev, mfi);
 
         amrex::Array4<const amrex::Real> const& Ex_arr = Ex.array(mfi);
         amrex::Array4<const amrex::Real> const& Ey_arr = Ey.array(mfi);
@@ -1038,9 +971,8 @@ void WarpXFluidContainer::GatherAndPush (
         amrex::ParallelFor(tile_box,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
             {
-
                 // Only run if density is positive
-                if (N_arr(i,j,k)>0.0) {
+                if (species.N(i,j,k)>0.0) {
 
                     // Interpolate fields from tmp to Nodal points
                     amrex::Real Ex_Nodal = ablastr::coarsen::sample::Interp(Ex_arr,
@@ -1056,142 +988,9 @@ void WarpXFluidContainer::GatherAndPush (
                     amrex::Real Bz_Nodal = ablastr::coarsen::sample::Interp(Bz_arr,
                         Bz_type, Nodal_type, coarsening_ratio, i, j, k, 0);
 
-                    if (gamma_boost > 1._rt) { // Lorentz transform fields due to moving frame
-                        if ( ( external_b_fields ) || ( external_e_fields ) ){
-
-                            // Lorentz transform z (from boosted to lab frame)
-                            amrex::Real Ex_ext_boost, Ey_ext_boost, Ez_ext_boost;
-                            amrex::Real Bx_ext_boost, By_ext_boost, Bz_ext_boost;
-                            amrex::Real Ex_ext_lab, Ey_ext_lab, Ez_ext_lab;
-                            amrex::Real Bx_ext_lab, By_ext_lab, Bz_ext_lab;
-
-                            // Grab the location
-#if defined(WARPX_DIM_3D)
-                            const amrex::Real x = problo[0] + i * dx[0];
-                            const amrex::Real y = problo[1] + j * dx[1];
-                            const amrex::Real z = problo[2] + k * dx[2];
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-                            const amrex::Real x = problo[0] + i * dx[0];
-                            const amrex::Real y = 0.0_rt;
-                            const amrex::Real z = problo[1] + j * dx[1];
-#else
-                            const amrex::Real x = 0.0_rt;
-                            const amrex::Real y = 0.0_rt;
-                            const amrex::Real z = problo[0] + i * dx[0];
-#endif
-
-                            // Get the lab frame E and B
-                            // Transform (boosted to lab)
-                            const amrex::Real t_lab = gamma_boost*(t + beta_boost*z/PhysConst::c);
-                            const amrex::Real z_lab = gamma_boost*(z + beta_boost*PhysConst::c*t);
-
-                            // Grab the external fields in the lab frame:
-                            if ( external_e_fields ) {
-                                Ex_ext_lab = Exfield_parser(x, y, z_lab, t_lab);
-                                Ey_ext_lab = Eyfield_parser(x, y, z_lab, t_lab);
-                                Ez_ext_lab = Ezfield_parser(x, y, z_lab, t_lab);
-                            }else{
-                                Ex_ext_lab = 0.0;
-                                Ey_ext_lab = 0.0;
-                                Ez_ext_lab = 0.0;
-                            }
-                            if ( external_b_fields ) {
-                                Bx_ext_lab = Bxfield_parser(x, y, z_lab, t_lab);
-                                By_ext_lab = Byfield_parser(x, y, z_lab, t_lab);
-                                Bz_ext_lab = Bzfield_parser(x, y, z_lab, t_lab);
-                            }else{
-                                Bx_ext_lab = 0.0;
-                                By_ext_lab = 0.0;
-                                Bz_ext_lab = 0.0;
-                            }
-
-                            // Transform E & B (lab to boosted frame)
-                            // (Require both to for the lorentz transform)
-                            // RHS m_parser
-                            Ez_ext_boost = Ez_ext_lab;
-                            Bz_ext_boost = Bz_ext_lab;
-                            Ex_ext_boost = gamma_boost*(Ex_ext_lab - beta_boost*PhysConst::c*By_ext_lab);
-                            Ey_ext_boost = gamma_boost*(Ey_ext_lab + beta_boost*PhysConst::c*Bx_ext_lab);
-                            Bx_ext_boost = gamma_boost*(Bx_ext_lab + beta_boost*Ey_ext_lab/PhysConst::c);
-                            By_ext_boost = gamma_boost*(By_ext_lab - beta_boost*Ex_ext_lab/PhysConst::c);
-
-                            // Then add to Nodal quantities in the boosted frame:
-                            Ex_Nodal += Ex_ext_boost;
-                            Ey_Nodal += Ey_ext_boost;
-                            Ez_Nodal += Ez_ext_boost;
-                            Bx_Nodal += Bx_ext_boost;
-                            By_Nodal += By_ext_boost;
-                            Bz_Nodal += Bz_ext_boost;
-                        }
-                    } else {
-
-                        // Added external e fields:
-                        if ( external_e_fields ){
-#if defined(WARPX_DIM_3D)
-                            const amrex::Real x = problo[0] + i * dx[0];
-                            const amrex::Real y = problo[1] + j * dx[1];
-                            const amrex::Real z = problo[2] + k * dx[2];
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-                            const amrex::Real x = problo[0] + i * dx[0];
-                            const amrex::Real y = 0.0_rt;
-                            const amrex::Real z = problo[1] + j * dx[1];
-#else
-                            const amrex::Real x = 0.0_rt;
-                            const amrex::Real y = 0.0_rt;
-                            const amrex::Real z = problo[0] + i * dx[0];
-#endif
-
-                            Ex_Nodal += Exfield_parser(x, y, z, t);
-                            Ey_Nodal += Eyfield_parser(x, y, z, t);
-                            Ez_Nodal += Ezfield_parser(x, y, z, t);
-                        }
-
-                        // Added external b fields:
-                        if ( external_b_fields ){
-#if defined(WARPX_DIM_3D)
-                            const amrex::Real x = problo[0] + i * dx[0];
-                            const amrex::Real y = problo[1] + j * dx[1];
-                            const amrex::Real z = problo[2] + k * dx[2];
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-                            const amrex::Real x = problo[0] + i * dx[0];
-                            const amrex::Real y = 0.0_rt;
-                            const amrex::Real z = problo[1] + j * dx[1];
-#else
-                            const amrex::Real x = 0.0_rt;
-                            const amrex::Real y = 0.0_rt;
-                            const amrex::Real z = problo[0] + i * dx[0];
-#endif
-
-                            Bx_Nodal += Bxfield_parser(x, y, z, t);
-                            By_Nodal += Byfield_parser(x, y, z, t);
-                            Bz_Nodal += Bzfield_parser(x, y, z, t);
-                        }
-                    }
-
-                    // Isolate U from NU
-                    amrex::Real tmp_Ux = (NUx_arr(i, j, k) / N_arr(i,j,k));
-                    amrex::Real tmp_Uy = (NUy_arr(i, j, k) / N_arr(i,j,k));
-                    amrex::Real tmp_Uz = (NUz_arr(i, j, k) / N_arr(i,j,k));
-
-                    // Enforce RZ boundary conditions
-#if defined(WARPX_DIM_RZ)
-                    if  ( i == 0 ){
-                        Ex_Nodal = 0.0;
-                        Ey_Nodal = 0.0;
-                        By_Nodal = 0.0;
-                        Bx_Nodal = 0.0;
-                    }
-#endif
-
-                    // Push the fluid momentum
-                    UpdateMomentumHigueraCary(tmp_Ux, tmp_Uy, tmp_Uz,
-                        Ex_Nodal, Ey_Nodal, Ez_Nodal,
-                        Bx_Nodal, By_Nodal, Bz_Nodal, q, m, dt );
-
-                    // Calculate NU
-                    NUx_arr(i,j,k) = N_arr(i,j,k)*tmp_Ux;
-                    NUy_arr(i,j,k) = N_arr(i,j,k)*tmp_Uy;
-                    NUz_arr(i,j,k) = N_arr(i,j,k)*tmp_Uz;
+                    fluids::PushMomentumAtNode(species, i, j, k,
+                        Ex_Nodal, Ey_Nodal, Ez_Nodal, Bx_Nodal, By_Nodal, Bz_Nodal,
+                        t, dt, gamma_boost, beta_boost, problo, dx);
                 }
             }
         );
@@ -1240,22 +1039,14 @@ void WarpXFluidContainer::DepositCurrent(
 {
     WARPX_PROFILE("WarpXFluidContainer::DepositCurrent");
 
-    // Temporary nodal currents
-    amrex::MultiFab tmp_jx_fluid(N[lev]->boxArray(), N[lev]->DistributionMap(), 1, 0);
-    amrex::MultiFab tmp_jy_fluid(N[lev]->boxArray(), N[lev]->DistributionMap(), 1, 0);
-    amrex::MultiFab tmp_jz_fluid(N[lev]->boxArray(), N[lev]->DistributionMap(), 1, 0);
-
-    const amrex::Real inv_clight_sq = 1.0_prt / PhysConst::c / PhysConst::c;
-    const amrex::Real q = getCharge();
-
-    // Prepare interpolation of current components to cell center
+    // Prepare interpolation of current components from the nodes
     auto j_nodal_type = amrex::GpuArray<int, 3>{0, 0, 0};
     auto jx_type = amrex::GpuArray<int, 3>{0, 0, 0};
     auto jy_type = amrex::GpuArray<int, 3>{0, 0, 0};
     auto jz_type = amrex::GpuArray<int, 3>{0, 0, 0};
     for (int i = 0; i < AMREX_SPACEDIM; ++i)
     {
-        j_nodal_type[i] = tmp_jx_fluid.ixType()[i];
+        j_nodal_type[i] = N[lev]->ixType()[i];
         jx_type[i] = jx.ixType()[i];
         jy_type[i] = jy.ixType()[i];
         jz_type[i] = jz.ixType()[i];
@@ -1269,42 +1060,8 @@ void WarpXFluidContainer::DepositCurrent(
     auto const &owner_mask_y = amrex::OwnerMask(jy, period);
     auto const &owner_mask_z = amrex::OwnerMask(jz, period);
 
-    // Calculate j at the nodes
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
-#endif
-    for (MFIter mfi(*N[lev], TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
-        amrex::Box const &tile_box = mfi.tilebox(N[lev]->ixType().toIntVect());
-
-        amrex::Array4<Real> const &N_arr = N[lev]->array(mfi);
-        amrex::Array4<Real> const &NUx_arr = NU[lev][0]->array(mfi);
-        amrex::Array4<Real> const &NUy_arr = NU[lev][1]->array(mfi);
-        amrex::Array4<Real> const &NUz_arr = NU[lev][2]->array(mfi);
-
-        const amrex::Array4<amrex::Real> tmp_jx_fluid_arr = tmp_jx_fluid.array(mfi);
-        const amrex::Array4<amrex::Real> tmp_jy_fluid_arr = tmp_jy_fluid.array(mfi);
-        const amrex::Array4<amrex::Real> tmp_jz_fluid_arr = tmp_jz_fluid.array(mfi);
-
-        amrex::ParallelFor(tile_box,
-            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
-            {
-                // Calculate J from fluid quantities
-                amrex::Real gamma = 1.0_rt, Ux = 0.0_rt, Uy = 0.0_rt, Uz = 0.0_rt;
-                if (N_arr(i, j, k)>0.0_rt){
-                    Ux = NUx_arr(i, j, k)/N_arr(i, j, k);
-                    Uy = NUy_arr(i, j, k)/N_arr(i, j, k);
-                    Uz = NUz_arr(i, j, k)/N_arr(i, j, k);
-                    gamma = std::sqrt(1.0_rt + ( Ux*Ux + Uy*Uy + Uz*Uz) * inv_clight_sq ) ;
-                }
-                tmp_jx_fluid_arr(i, j, k) = q * (NUx_arr(i, j, k) / gamma);
-                tmp_jy_fluid_arr(i, j, k) = q * (NUy_arr(i, j, k) / gamma);
-                tmp_jz_fluid_arr(i, j, k) = q * (NUz_arr(i, j, k) / gamma);
-            }
-        );
-    }
-
-    // Interpolate j from the nodes to the simulation mesh (typically Yee mesh)
+    // Interpolate j from the nodes to the simulation mesh (typically Yee mesh),
+    // computing the nodal current on the fly
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
@@ -1318,40 +1075,64 @@ void WarpXFluidContainer::DepositCurrent(
         const amrex::Array4<amrex::Real> jy_arr = jy.array(mfi);
         const amrex::Array4<amrex::Real> jz_arr = jz.array(mfi);
 
-        const amrex::Array4<amrex::Real> tmp_jx_fluid_arr = tmp_jx_fluid.array(mfi);
-        const amrex::Array4<amrex::Real> tmp_jy_fluid_arr = tmp_jy_fluid.array(mfi);
-        const amrex::Array4<amrex::Real> tmp_jz_fluid_arr = tmp_jz_fluid.array(mfi);
-
         const amrex::Array4<int> owner_mask_x_arr = owner_mask_x->array(mfi);
         const amrex::Array4<int> owner_mask_y_arr = owner_mask_y->array(mfi);
         const amrex::Array4<int> owner_mask_z_arr = owner_mask_z->array(mfi);
 
-        // When using the `Interp` function, one needs to specify whether coarsening is desired.
-        // Here, we do not perform any coarsening.
-        const amrex::GpuArray<int, 3U> coarsening_ratio = {1, 1, 1};
-
+        const FluidSpeciesTileData species = getTileData(lev, mfi);
 
         // Interpolate fluid current and deposit it
         // ( mask double counting )
         amrex::ParallelFor( tile_box_x, tile_box_y, tile_box_z,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
             {
-                const amrex::Real jx_tmp = ablastr::coarsen::sample::Interp(tmp_jx_fluid_arr,
-                    j_nodal_type, jx_type, coarsening_ratio, i, j, k, 0);
-                if ( owner_mask_x_arr(i,j,k) ) { jx_arr(i, j, k) += jx_tmp; }
+                if ( !owner_mask_x_arr(i,j,k) ) { return; }
+                jx_arr(i, j, k) += fluids::InterpFromNodes(
+                    [=] (int ii, int jj, int kk) { return fluids::CurrentAtNode(species, 0, ii, jj, kk); },
+                    j_nodal_type, jx_type, i, j, k);
             },
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
             {
-                const amrex::Real jy_tmp = ablastr::coarsen::sample::Interp(tmp_jy_fluid_arr,
-                    j_nodal_type, jy_type, coarsening_ratio, i, j, k, 0);
-                if ( owner_mask_y_arr(i,j,k) ) { jy_arr(i, j, k) += jy_tmp; }
+                if ( !owner_mask_y_arr(i,j,k) ) { return; }
+                jy_arr(i, j, k) += fluids::InterpFromNodes(
+                    [=] (int ii, int jj, int kk) { return fluids::CurrentAtNode(species, 1, ii, jj, kk); },
+                    j_nodal_type, jy_type, i, j, k);
             },
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
             {
-                const amrex::Real jz_tmp = ablastr::coarsen::sample::Interp(tmp_jz_fluid_arr,
-                    j_nodal_type, jz_type, coarsening_ratio, i, j, k, 0);
-                if ( owner_mask_z_arr(i,j,k) ) { jz_arr(i, j, k) += jz_tmp; }
+                if ( !owner_mask_z_arr(i,j,k) ) { return; }
+                jz_arr(i, j, k) += fluids::InterpFromNodes(
+                    [=] (int ii, int jj, int kk) { return fluids::CurrentAtNode(species, 2, ii, jj, kk); },
+                    j_nodal_type, jz_type, i, j, k);
             }
         );
     }
 }
+
+FluidSpeciesTileData WarpXFluidContainer::getTileData (int lev, amrex::MFIter const& mfi) const
+{
+    constexpr int num_arguments = 4; //x,y,z,t
+
+    FluidSpeciesTileData species;
+    species.N = N[lev]->array(mfi);
+    species.NUx = NU[lev][0]->array(mfi);
+    species.NUy = NU[lev][1]->array(mfi);
+    species.NUz = NU[lev][2]->array(mfi);
+    species.q = getCharge();
+    species.m = getMass();
+
+    // External field parsers
+    species.external_e_fields = (m_E_ext_s == "parse_e_ext_function");
+    species.external_b_fields = (m_B_ext_s == "parse_b_ext_function");
+    if (species.external_e_fields){
+        species.Ex_ext = m_Ex_parser->compile<num_arguments>();
+        species.Ey_ext = m_Ey_parser->compile<num_arguments>();
+        species.Ez_ext = m_Ez_parser->compile<num_arguments>();
+    }
+    if (species.external_b_fields){
+        species.Bx_ext = m_Bx_parser->compile<num_arguments>();
+        species.By_ext = m_By_parser->compile<num_arguments>();
+        species.Bz_ext = m_Bz_parser->compile<num_arguments>();
+    }
+    return species;
+}
@@ -177,6 +177,7 @@ ExternalFieldParams::ExternalFieldParams(const amrex::ParmParse& pp_warpx)
         B_ext_grid_type == ExternalFieldType::read_from_file){
             const std::string read_fields_from_path="./";
             pp_warpx.query("read_fields_from_path", external_fields_path);
+            pp_warpx.query("read_fields_cache_dir", external_fields_cache_dir);
     }
     //___________________________________________________________________________
 }
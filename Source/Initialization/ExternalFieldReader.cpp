@@ -0,0 +1,280 @@
+/* Copyright 2019-2026 Andrew Myers, Ann Almgren, Aurore Blelly
+ * Axel Huebl, Burlen Loring, Maxence Thevenet
+ * Michael Rowan, Remi Lehe, Revathi Jambunathan
+ * Weiqun Zhang, agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "ExternalFieldReader.H"
+
+#include "Utils/Algorithms/LinearInterpolation.H"
+#include "Utils/TextMsg.H"
+
+#include <AMReX_Array4.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_IndexType.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_RealBox.H>
+
+#ifdef WARPX_USE_OPENPMD
+#   include <openPMD/openPMD.hpp>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace amrex::literals;
+
+std::vector<amrex::Box>
+warpx::initialization::LocalFabBoxes (amrex::MultiFab const& mf)
+{
+    std::vector<amrex::Box> boxes;
+    for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        boxes.push_back(mfi.fabbox());
+    }
+    return boxes;
+}
+
+#if defined(WARPX_USE_OPENPMD) && !defined(WARPX_DIM_1D_Z) && !defined(WARPX_DIM_XZ)
+warpx::initialization::ExternalFieldChunk
+warpx::initialization::ReadExternalFieldChunk (
+    const std::string& path, std::optional<std::uint64_t> iteration,
+    const std::string& F_name, const std::string& F_component,
+    std::vector<amrex::Box> const& boxes, amrex::Geometry const& geom)
+{
+    const amrex::RealBox& real_box = geom.ProbDomain();
+    const auto dx = geom.CellSizeArray();
+
+    // Read external field openPMD data
+    auto series = openPMD::Series(path, openPMD::Access::READ_ONLY);
+    auto iseries = iteration ? series.iterations[*iteration] : series.iterations.begin()->second;
+    auto F = iseries.meshes[F_name];
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(F.getAttribute("dataOrder").get<std::string>() == "C",
+                                     "Reading from files with non-C dataOrder is not implemented");
+
+    auto axisLabels = F.getAttribute("axisLabels").get<std::vector<std::string>>();
+    auto fileGeom = F.getAttribute("geometry").get<std::string>();
+
+#if defined(WARPX_DIM_3D)
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fileGeom == "cartesian", "3D can only read from files with cartesian geometry");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(axisLabels[0] == "x" && axisLabels[1] == "y" && axisLabels[2] == "z",
+                                     "3D expects axisLabels {x, y, z}");
+#elif defined(WARPX_DIM_RZ)
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fileGeom == "thetaMode", "RZ can only read from files with 'thetaMode'  geometry");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(axisLabels[0] == "r" && axisLabels[1] == "z",
+                                     "RZ expects axisLabels {r, z}");
+#endif
+
+    ExternalFieldChunk chunk;
+
+    const auto offset = F.gridGlobalOffset();
+    const auto d = F.gridSpacing<long double>();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        chunk.offset[idim] = static_cast<amrex::Real>(offset[idim]);
+        chunk.spacing[idim] = static_cast<amrex::Real>(d[idim]);
+    }
+
+    auto FC = F[F_component];
+    const auto extent = FC.getExtent();
+
+    // Determine the chunk of the file that is needed by the boxes of this rank, including
+    // their guard cells: lower and upper indices of the file points, along each axis of the file
+    constexpr int nfile_dims = AMREX_SPACEDIM;
+    std::array<long,nfile_dims> ilo, ihi;
+    ilo.fill(std::numeric_limits<long>::max());
+    ihi.fill(std::numeric_limits<long>::lowest());
+    for (amrex::Box const& box : boxes) {
+        for (int idim = 0; idim < nfile_dims; ++idim) {
+            const amrex::Real shift = (box.type(idim) == amrex::IndexType::CellIndex::NODE) ? 0._rt : 0.5_rt;
+            amrex::Real xlo = real_box.lo(idim) + (box.smallEnd(idim) + shift)*dx[idim];
+            amrex::Real xhi = real_box.lo(idim) + (box.bigEnd(idim) + shift)*dx[idim];
+#if defined(WARPX_DIM_RZ)
+            // Negative radii are mirrored
+            if (idim == 0) {
+                const amrex::Real rmax = std::max(std::abs(xlo), std::abs(xhi));
+                xlo = (xlo < 0._rt && xhi > 0._rt) ? 0._rt : std::min(std::abs(xlo), std::abs(xhi));
+                xhi = rmax;
+            }
+#endif
+            // One more point on each side, for the interpolation and to be safe from round-off
+            ilo[idim] = std::min(ilo[idim],
+                static_cast<long>(std::floor((xlo - chunk.offset[idim])/chunk.spacing[idim])) - 1);
+            ihi[idim] = std::max(ihi[idim],
+                static_cast<long>(std::floor((xhi - chunk.offset[idim])/chunk.spacing[idim])) + 2);
+        }
+    }
+    // Nothing to read on this rank
+    if (ilo[0] > ihi[0]) { return chunk; }
+
+    // The record has the shape (modes, r, z) in RZ, and (x, y, z) in 3D
+#if defined(WARPX_DIM_RZ)
+    constexpr int first_file_axis = 1;
+    openPMD::Offset chunk_offset = {0,0,0};
+    openPMD::Extent chunk_extent = {1,0,0};
+#elif defined(WARPX_DIM_3D)
+    constexpr int first_file_axis = 0;
+    openPMD::Offset chunk_offset = {0,0,0};
+    openPMD::Extent chunk_extent = {0,0,0};
+#endif
+    for (int idim = 0; idim < nfile_dims; ++idim) {
+        const auto n = static_cast<long>(extent[first_file_axis+idim]);
+        const long lo = std::clamp(ilo[idim], 0L, n-1);
+        const long hi = std::clamp(ihi[idim], 0L, n-1);
+        chunk_offset[first_file_axis+idim] = static_cast<std::uint64_t>(lo);
+        chunk_extent[first_file_axis+idim] = static_cast<std::uint64_t>(hi - lo + 1);
+        ilo[idim] = lo;
+        ihi[idim] = hi;
+    }
+
+    auto FC_chunk_data = FC.loadChunk<double>(chunk_offset,chunk_extent);
+    series.flush();
+    auto *FC_data_host = FC_chunk_data.get();
+
+    const size_t total_extent = size_t(chunk_extent[0]) * chunk_extent[1] * chunk_extent[2];
+    chunk.data.assign(FC_data_host, FC_data_host + total_extent);
+
+    // The array of the chunk is indexed with the indices of the points in the whole file
+    // (the fastest varying index comes first)
+#if defined(WARPX_DIM_RZ)
+    chunk.lo = {0, static_cast<int>(ilo[1]), static_cast<int>(ilo[0])};
+    chunk.hi = {1, static_cast<int>(ihi[1])+1, static_cast<int>(ihi[0])+1};
+#elif defined(WARPX_DIM_3D)
+    chunk.lo = {static_cast<int>(ilo[2]), static_cast<int>(ilo[1]), static_cast<int>(ilo[0])};
+    chunk.hi = {static_cast<int>(ihi[2])+1, static_cast<int>(ihi[1])+1, static_cast<int>(ihi[0])+1};
+#endif
+    return chunk;
+}
+
+void
+warpx::initialization::InterpolateExternalFieldChunk (
+    ExternalFieldChunk const& chunk, amrex::MultiFab& mf, int const dcomp, amrex::Geometry const& geom)
+{
+    if (chunk.empty()) { return; }
+
+    const amrex::RealBox& real_box = geom.ProbDomain();
+    const auto dx = geom.CellSizeArray();
+    const amrex::IntVect nodal_flag = mf.ixType().toIntVect();
+
+    const auto offset0 = chunk.offset[0];
+    const auto offset1 = chunk.offset[1];
+#if defined(WARPX_DIM_RZ)
+    const auto file_dr = chunk.spacing[0];
+    const auto file_dz = chunk.spacing[1];
+#elif defined(WARPX_DIM_3D)
+    const auto offset2 = chunk.offset[2];
+    const auto file_dx = chunk.spacing[0];
+    const auto file_dy = chunk.spacing[1];
+    const auto file_dz = chunk.spacing[2];
+#endif
+
+    // Load data to GPU
+    amrex::Gpu::DeviceVector<double> FC_data_gpu(chunk.data.size());
+    auto *FC_data = FC_data_gpu.data();
+    amrex::Gpu::copy(amrex::Gpu::hostToDevice, chunk.data.begin(), chunk.data.end(), FC_data);
+
+    const amrex::Array4<double> fc_array(FC_data,
+        {chunk.lo[0], chunk.lo[1], chunk.lo[2]}, {chunk.hi[0], chunk.hi[1], chunk.hi[2]}, 1);
+
+    // Loop over boxes
+    for (amrex::MFIter mfi(mf, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const amrex::Box box = mfi.growntilebox();
+        const amrex::Box tb = mfi.tilebox(nodal_flag, mf.nGrowVect());
+        auto const& mffab = mf.array(mfi);
+
+        // Start ParallelFor
+        amrex::ParallelFor (tb,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                // i,j,k denote x,y,z indices in 3D xyz.
+                // i,j denote r,z indices in 2D rz; k is just 0
+
+                // ii is used for 2D RZ mode
+#if defined(WARPX_DIM_RZ)
+                // In 2D RZ, i denoting r can be < 0
+                // but mirrored values should be assigned.
+                // Namely, mffab(i) = FC_data[-i] when i<0.
+                const int ii = (i<0)?(-i):(i);
+#else
+                const int ii = i;
+#endif
+
+                // Physical coordinates of the grid point
+                // 0,1,2 denote x,y,z in 3D xyz.
+                // 0,1 denote r,z in 2D rz.
+                amrex::Real x0, x1;
+                if ( box.type(0)==amrex::IndexType::CellIndex::NODE )
+                     { x0 = static_cast<amrex::Real>(real_box.lo(0)) + ii*dx[0]; }
+                else { x0 = static_cast<amrex::Real>(real_box.lo(0)) + ii*dx[0] + 0.5_rt*dx[0]; }
+                if ( box.type(1)==amrex::IndexType::CellIndex::NODE )
+                     { x1 = real_box.lo(1) + j*dx[1]; }
+                else { x1 = real_box.lo(1) + j*dx[1] + 0.5_rt*dx[1]; }
+
+#if defined(WARPX_DIM_RZ)
+                // Get index of the external field array
+                int const ir = std::floor( (x0-offset0)/file_dr );
+                int const iz = std::floor( (x1-offset1)/file_dz );
+
+                // Get coordinates of external grid point
+                amrex::Real const xx0 = offset0 + ir * file_dr;
+                amrex::Real const xx1 = offset1 + iz * file_dz;
+
+#elif defined(WARPX_DIM_3D)
+                amrex::Real x2;
+                if ( box.type(2)==amrex::IndexType::CellIndex::NODE )
+                     { x2 = real_box.lo(2) + k*dx[2]; }
+                else { x2 = real_box.lo(2) + k*dx[2] + 0.5_rt*dx[2]; }
+
+                // Get index of the external field array
+                int const ix = std::floor( (x0-offset0)/file_dx );
+                int const iy = std::floor( (x1-offset1)/file_dy );
+                int const iz = std::floor( (x2-offset2)/file_dz );
+
+                // Get coordinates of external grid point
+                amrex::Real const xx0 = offset0 + ix * file_dx;
+                amrex::Real const xx1 = offset1 + iy * file_dy;
+                amrex::Real const xx2 = offset2 + iz * file_dz;
+#endif
+
+#if defined(WARPX_DIM_RZ)
+                const double
+                    f00 = fc_array(0, iz  , ir  ),
+                    f01 = fc_array(0, iz  , ir+1),
+                    f10 = fc_array(0, iz+1, ir  ),
+                    f11 = fc_array(0, iz+1, ir+1);
+                mffab(i,j,k,dcomp) = static_cast<amrex::Real>(utils::algorithms::bilinear_interp<double>
+                    (xx0, xx0+file_dr, xx1, xx1+file_dz,
+                     f00, f01, f10, f11,
+                     x0, x1));
+#elif defined(WARPX_DIM_3D)
+                const double
+                    f000 = fc_array(iz  , iy  , ix  ),
+                    f001 = fc_array(iz+1, iy  , ix  ),
+                    f010 = fc_array(iz  , iy+1, ix  ),
+                    f011 = fc_array(iz+1, iy+1, ix  ),
+                    f100 = fc_array(iz  , iy  , ix+1),
+                    f101 = fc_array(iz+1, iy  , ix+1),
+                    f110 = fc_array(iz  , iy+1, ix+1),
+                    f111 = fc_array(iz+1, iy+1, ix+1);
+                mffab(i,j,k,dcomp) = static_cast<amrex::Real>(utils::algorithms::trilinear_interp<double>
+                    (xx0, xx0+file_dx, xx1, xx1+file_dy, xx2, xx2+file_dz,
+                     f000, f001, f010, f011, f100, f101, f110, f111,
+                     x0, x1, x2));
+#endif
+
+            }
+
+        ); // End ParallelFor
+
+    } // End loop over boxes.
+
+    // The chunk must stay allocated until the kernels are done
+    amrex::Gpu::streamSynchronize();
+}
+#endif
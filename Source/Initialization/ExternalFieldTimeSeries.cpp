@@ -0,0 +1,206 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "ExternalFieldTimeSeries.H"
+
+#include "FieldSolver/Fields.H"
+#include "Utils/TextMsg.H"
+#include "WarpX.H"
+
+#include <AMReX_BoxArray.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#ifdef WARPX_USE_OPENPMD
+#   include <openPMD/openPMD.hpp>
+#endif
+
+using namespace amrex::literals;
+
+ExternalFieldTimeSeries::ExternalFieldTimeSeries (
+    std::string path, bool read_E, bool read_B, bool prefetch)
+    : m_path{std::move(path)}, m_read_E{read_E}, m_read_B{read_B}, m_prefetch{prefetch}
+{
+#if defined(WARPX_USE_OPENPMD) && defined(WARPX_DIM_3D)
+    auto series = openPMD::Series(m_path, openPMD::Access::READ_ONLY);
+    std::vector<std::pair<amrex::Real, std::uint64_t>> times;
+    for (auto& [index, iteration] : series.iterations) {
+        times.emplace_back(
+            static_cast<amrex::Real>(iteration.time<double>()*iteration.timeUnitSI()), index);
+    }
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!times.empty(),
+        "particles.read_fields_from_path: no iteration found in " + m_path);
+    std::sort(times.begin(), times.end());
+    for (auto const& [time, index] : times) {
+        m_times.push_back(time);
+        m_iterations.push_back(index);
+    }
+#else
+    WARPX_ABORT_WITH_MESSAGE(
+        "Reading the external fields of the particles from openPMD files requires "
+        "openPMD support and is only implemented in 3D");
+#endif
+}
+
+void
+ExternalFieldTimeSeries::Update (amrex::Real t)
+{
+    using warpx::fields::FieldType;
+
+    auto& warpx = WarpX::GetInstance();
+    const int nlevs = warpx.finestLevel() + 1;
+
+    // (Re)allocate the fields of the levels whose grids changed, which requires to read
+    // both iterations again
+    m_fields.resize(nlevs);
+    for (int lev = 0; lev < nlevs; ++lev) {
+        if (getFields(lev)) { continue; }
+        // Use as many guard cells as the fields gathered by the particles
+        const amrex::IntVect ng = warpx.getField(FieldType::Efield_aux, lev, 0).nGrowVect();
+        m_fields[lev] = std::make_unique<amrex::MultiFab>(
+            amrex::convert(warpx.boxArray(lev), amrex::IntVect::TheNodeVector()),
+            warpx.DistributionMap(lev), 2*ncomps, ng);
+        m_fields[lev]->setVal(0._rt);
+        m_loaded = {-1, -1};
+    }
+
+    // The first iteration after t and the one before it
+    const auto n = static_cast<int>(m_times.size());
+    int i1 = static_cast<int>(std::upper_bound(m_times.begin(), m_times.end(), t) - m_times.begin());
+    int i0 = i1 - 1;
+    if (i1 == 0) { i0 = 0; }
+    if (i1 == n) { i1 = n - 1; }
+    if (m_loaded[0] == i0 && m_loaded[1] == i1) { return; }
+
+    // The second iteration in memory becomes the first one when the time passes it
+    const std::array<int,2> previous = m_loaded;
+    if (previous[0] != i0) {
+        if (previous[1] == i0) {
+            for (auto& mf : m_fields) {
+                amrex::MultiFab::Copy(*mf, *mf, ncomps, 0, ncomps, mf->nGrowVect());
+            }
+        } else {
+            LoadIteration(0, i0);
+        }
+    }
+    if (previous[1] != i1) {
+        if (i1 == i0) {
+            for (auto& mf : m_fields) {
+                amrex::MultiFab::Copy(*mf, *mf, 0, ncomps, ncomps, mf->nGrowVect());
+            }
+        } else {
+            LoadIteration(1, i1);
+        }
+    }
+    m_loaded = {i0, i1};
+
+    if (m_prefetch && i1 + 1 < n) { Prefetch(i1 + 1); }
+}
+
+amrex::MultiFab const*
+ExternalFieldTimeSeries::getFields (int lev) const
+{
+    auto& warpx = WarpX::GetInstance();
+    if (lev >= static_cast<int>(m_fields.size()) || !m_fields[lev]) { return nullptr; }
+    auto const& mf = *m_fields[lev];
+    if (!mf.boxArray().CellEqual(warpx.boxArray(lev)) ||
+        mf.DistributionMap() != warpx.DistributionMap(lev)) { return nullptr; }
+    return &mf;
+}
+
+amrex::Real
+ExternalFieldTimeSeries::getWeight (amrex::Real t) const
+{
+    if (m_loaded[0] < 0 || m_loaded[0] == m_loaded[1]) { return 0._rt; }
+    const amrex::Real t0 = m_times[m_loaded[0]];
+    const amrex::Real t1 = m_times[m_loaded[1]];
+    return std::clamp((t - t0)/(t1 - t0), 0._rt, 1._rt);
+}
+
+ExternalFieldTimeSeries::IterationChunks
+ExternalFieldTimeSeries::ReadIteration (
+    int index, std::vector<std::vector<amrex::Box>> const& boxes,
+    amrex::Vector<amrex::Geometry> const& geoms) const
+{
+    IterationChunks chunks(boxes.size()*ncomps);
+#if defined(WARPX_USE_OPENPMD) && defined(WARPX_DIM_3D)
+    const std::array<std::string,3> components = {"x", "y", "z"};
+    for (int lev = 0; lev < static_cast<int>(boxes.size()); ++lev) {
+        for (int comp = 0; comp < ncomps; ++comp) {
+            const bool is_E = comp < 3;
+            if ((is_E && !m_read_E) || (!is_E && !m_read_B)) { continue; }
+            chunks[lev*ncomps + comp] = warpx::initialization::ReadExternalFieldChunk(
+                m_path, m_iterations[index], is_E ? "E" : "B", components[comp%3], boxes[lev], geoms[lev]);
+        }
+    }
+#else
+    amrex::ignore_unused(index, geoms);
+#endif
+    return chunks;
+}
+
+void
+ExternalFieldTimeSeries::LoadIteration (int slot, int index)
+{
+    auto& warpx = WarpX::GetInstance();
+    const auto boxes = LocalBoxes();
+
+    // A prefetch that is not the needed iteration on the current grids is discarded
+    const bool use_prefetch = (m_prefetch_index == index) && (m_prefetch_boxes == boxes);
+    IterationChunks chunks;
+    if (m_prefetched.valid()) {
+        auto prefetched = m_prefetched.get();
+        if (use_prefetch) { chunks = std::move(prefetched); }
+    }
+    m_prefetch_index = -1;
+    if (!use_prefetch) { chunks = ReadIteration(index, boxes, warpx.Geom()); }
+
+    amrex::Print() << Utils::TextMsg::Info(
+        "Reading the external fields of the particles at t = " + std::to_string(m_times[index]) +
+        " from " + m_path + (use_prefetch ? " (prefetched)" : ""));
+
+#if defined(WARPX_USE_OPENPMD) && defined(WARPX_DIM_3D)
+    for (int lev = 0; lev < static_cast<int>(m_fields.size()); ++lev) {
+        for (int comp = 0; comp < ncomps; ++comp) {
+            warpx::initialization::InterpolateExternalFieldChunk(
+                chunks[lev*ncomps + comp], *m_fields[lev], slot*ncomps + comp, warpx.Geom(lev));
+        }
+    }
+#else
+    amrex::ignore_unused(slot);
+#endif
+}
+
+void
+ExternalFieldTimeSeries::Prefetch (int index)
+{
+    if (m_prefetch_index == index) { return; }
+    // Only one iteration is read at a time
+    if (m_prefetched.valid()) { m_prefetched.wait(); }
+
+    m_prefetch_index = index;
+    m_prefetch_boxes = LocalBoxes();
+    m_prefetched = std::async(std::launch::async,
+        [this, index, boxes = m_prefetch_boxes, geoms = WarpX::GetInstance().Geom()] () {
+            return ReadIteration(index, boxes, geoms);
+        });
+}
+
+std::vector<std::vector<amrex::Box>>
+ExternalFieldTimeSeries::LocalBoxes () const
+{
+    std::vector<std::vector<amrex::Box>> boxes;
+    for (auto const& mf : m_fields) {
+        boxes.push_back(warpx::initialization::LocalFabBoxes(*mf));
+    }
+    return boxes;
+}
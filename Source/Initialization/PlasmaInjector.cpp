@@ -361,6 +361,14 @@ void PlasmaInjector::setupNFluxPerCell (amrex::ParmParse const& pp_species)
 #endif
 
     parseFlux(pp_species);
+    utils::parser::queryWithParser(pp_species, source_name, "cache_flux_profile", cache_flux_profile);
+    if (cache_flux_profile) {
+#ifdef WARPX_DIM_RZ
+        WARPX_ABORT_WITH_MESSAGE(species_name + ".cache_flux_profile is not supported in RZ geometry");
+#endif
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!flux_parser || flux_parser->symbols().count("t") == 0,
+            species_name + ".cache_flux_profile requires a flux_function that does not depend on t");
+    }
     SpeciesUtils::parseMomentum(species_name, source_name, "nfluxpercell", h_inj_mom,
                                 ux_parser, uy_parser, uz_parser,
                                 ux_th_parser, uy_th_parser, uz_th_parser,
@@ -441,10 +449,12 @@ void PlasmaInjector::setupExternalFile (amrex::ParmParse const& pp_species)
     const bool mass_is_specified = pp_species.contains("mass");
     const bool species_is_specified = pp_species.contains("species_type");
 
-    if (amrex::ParallelDescriptor::IOProcessor()) {
-        m_openpmd_input_series = std::make_unique<openPMD::Series>(
-            str_injection_file, openPMD::Access::READ_ONLY);
+    // The file is opened (serially) on every MPI rank, since each rank then reads
+    // a slice of the particles in PhysicalParticleContainer::AddPlasmaFromFile
+    m_openpmd_input_series = std::make_unique<openPMD::Series>(
+        str_injection_file, openPMD::Access::READ_ONLY);
 
+    if (amrex::ParallelDescriptor::IOProcessor()) {
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
             m_openpmd_input_series->iterations.size() == 1u,
             "External file should contain only 1 iteration\n");
@@ -606,6 +616,12 @@ PlasmaInjector::getInjectorPosition () const
     return d_inj_pos;
 }
 
+bool
+PlasmaInjector::hasRandomPositions () const
+{
+    return h_inj_pos && h_inj_pos->isRandom();
+}
+
 InjectorPosition*
 PlasmaInjector::getInjectorFluxPosition () const
 {
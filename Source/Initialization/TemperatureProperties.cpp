@@ -12,6 +12,12 @@
 
 #include <ablastr/warn_manager/WarnManager.H>
 
+#include <AMReX_GpuDevice.H>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 /*
  * Construct TemperatureProperties based on the passed parameters.
  * If temperature is a constant, store value. If a parser, make and
@@ -55,6 +61,14 @@ TemperatureProperties::TemperatureProperties (const amrex::ParmParse& pp, std::s
 
         m_type = TempConstantValue;
         m_temperature = theta;
+
+        if (mom_dist_s == "maxwell_juttner") {
+            int table_size = 0;
+            utils::parser::queryWithParser(pp, source_name, "maxwell_juttner_table_size", table_size);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(table_size == 0 || table_size >= 2,
+                "maxwell_juttner_table_size must be 0 or at least 2");
+            if (table_size > 0) { ComputeJuttnerInverseCDF(table_size); }
+        }
     }
     else if (temp_dist_s == "parser") {
         std::string str_theta_function;
@@ -72,3 +86,38 @@ TemperatureProperties::TemperatureProperties (const amrex::ParmParse& pp, std::s
         WARPX_ABORT_WITH_MESSAGE(string);
     }
 }
+
+void
+TemperatureProperties::ComputeJuttnerInverseCDF (int table_size)
+{
+    // The distribution of the speed is proportional to u^2 exp(-(gamma-1)/theta). It is
+    // integrated on a fine grid up to the speed where exp(-(gamma-1)/theta) = exp(-40).
+    const double theta = m_temperature;
+    const double gamma_max = 1. + 40.*theta;
+    const double u_max = std::sqrt(gamma_max*gamma_max - 1.);
+    const int nfine = 16*table_size;
+    const double du = u_max/nfine;
+    std::vector<double> cdf(nfine+1, 0.);
+    const auto pdf = [theta] (double u) {
+        return u*u*std::exp(-(std::sqrt(1. + u*u) - 1.)/theta);
+    };
+    for (int i = 0; i < nfine; ++i) {
+        cdf[i+1] = cdf[i] + 0.5*du*(pdf(i*du) + pdf((i+1)*du));
+    }
+
+    // Invert the cumulative distribution at equally spaced probabilities
+    std::vector<amrex::Real> h_inverse_cdf(table_size);
+    int ifine = 0;
+    for (int i = 0; i < table_size; ++i) {
+        const double target = cdf[nfine]*i/(table_size - 1);
+        while (ifine < nfine-1 && cdf[ifine+1] < target) { ++ifine; }
+        const double dcdf = cdf[ifine+1] - cdf[ifine];
+        const double frac = (dcdf > 0.) ? std::min(std::max((target - cdf[ifine])/dcdf, 0.), 1.) : 0.;
+        h_inverse_cdf[i] = static_cast<amrex::Real>((ifine + frac)*du);
+    }
+
+    m_juttner_inverse_cdf.resize(table_size);
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_inverse_cdf.begin(), h_inverse_cdf.end(),
+                          m_juttner_inverse_cdf.begin());
+    amrex::Gpu::streamSynchronize();
+}
@@ -14,6 +14,7 @@
 #include <AMReX_ParmParse.H>
 #include <AMReX_TinyProfiler.H>
 
+#include <limits>
 #include <string>
 
 namespace {
@@ -33,6 +34,14 @@ namespace {
         bool the_arena_is_managed = false; // AMReX' default: true
         pp_amrex.queryAdd("the_arena_is_managed", the_arena_is_managed);
 
+#ifdef AMREX_USE_GPU
+        // Keep the pinned host memory that is freed (e.g. the particle staging buffers of
+        // the diagnostics) in the pinned arena, to reuse it at the next flush instead of
+        // allocating and page-locking it again
+        amrex::Long the_pinned_arena_release_threshold = std::numeric_limits<amrex::Long>::max();
+        pp_amrex.queryAdd("the_pinned_arena_release_threshold", the_pinned_arena_release_threshold);
+#endif
+
         // https://amrex-codes.github.io/amrex/docs_html/InputsComputeBackends.html
         std::string omp_threads = "nosmt"; // AMReX' default: system
         pp_amrex.queryAdd("omp_threads", omp_threads);
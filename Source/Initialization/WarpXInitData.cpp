@@ -22,8 +22,9 @@
 #include "Filter/BilinearFilter.H"
 #include "Filter/NCIGodfreyFilter.H"
 #include "Initialization/ExternalField.H"
+#include "Initialization/ExternalFieldReader.H"
 #include "Particles/MultiParticleContainer.H"
-#include "Utils/Algorithms/LinearInterpolation.H"
+#include "Utils/CounterBasedRandom.H"
 #include "Utils/Logo/GetLogo.H"
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
@@ -51,6 +52,7 @@
 #include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_GpuDevice.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_INT.H>
@@ -66,20 +68,27 @@
 #include <AMReX_REAL.H>
 #include <AMReX_RealBox.H>
 #include <AMReX_SPACE.H>
+#include <AMReX_Utility.H>
 #include <AMReX_Vector.H>
 
+#if defined(AMREX_USE_MPI)
+#   include <mpi.h>
+#endif
+
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <sstream>
 #include <string>
 #include <utility>
 
-#ifdef WARPX_USE_OPENPMD
-#   include <openPMD/openPMD.hpp>
-#endif
-
 #include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceSolver.H"
 
 using namespace amrex;
@@ -106,6 +115,63 @@ namespace
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(vc.allGT(gc), ss_msg.str());
         }
     }
+
+    /**
+     * \brief Copy the file of the external fields to a node-local cache directory, once per
+     * node and for all the jobs that use the same cache, and return the path to read from.
+     * The original path is returned if there is no cache directory, or if it is not a file.
+     */
+    std::string CacheExternalFieldsFile (const std::string& path, const std::string& cache_dir)
+    {
+        if (cache_dir.empty()) { return path; }
+
+        std::ifstream src(path, std::ios::binary | std::ios::ate);
+        const long long size = src ? static_cast<long long>(src.tellg()) : -1;
+        if (size < 0) {
+            ablastr::warn_manager::WMRecordWarning("ExternalFields",
+                "warpx.read_fields_cache_dir is ignored, since " + path + " is not a single file",
+                ablastr::warn_manager::WarnPriority::low);
+            return path;
+        }
+
+        // The name of the copy identifies the original file and its size
+        std::stringstream ss_key;
+        ss_key << std::hex << utils::random::hashString(path + "@" + std::to_string(size));
+        const std::string basename = path.substr(path.find_last_of('/') + 1);
+        const std::string cached_path = cache_dir + "/" + ss_key.str() + "_" + basename;
+
+        // One rank per node copies the file, unless an earlier job already did it
+        bool is_node_leader = true;
+#if defined(AMREX_USE_MPI)
+        MPI_Comm node_comm = MPI_COMM_NULL;
+        MPI_Comm_split_type(amrex::ParallelDescriptor::Communicator(), MPI_COMM_TYPE_SHARED,
+            amrex::ParallelDescriptor::MyProc(), MPI_INFO_NULL, &node_comm);
+        int node_rank = 0;
+        MPI_Comm_rank(node_comm, &node_rank);
+        is_node_leader = (node_rank == 0);
+#endif
+        if (is_node_leader) {
+            std::ifstream cached(cached_path, std::ios::binary | std::ios::ate);
+            if (!cached || static_cast<long long>(cached.tellg()) != size) {
+                amrex::UtilCreateDirectory(cache_dir, 0755);
+                // Write to a temporary file first, so that concurrent jobs never read a partial copy
+                const std::string tmp_path = cached_path + "." + amrex::UniqueString();
+                src.seekg(0);
+                {
+                    std::ofstream dst(tmp_path, std::ios::binary | std::ios::trunc);
+                    dst << src.rdbuf();
+                    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(dst.good(),
+                        "Could not copy the external fields file to " + tmp_path);
+                }
+                std::rename(tmp_path.c_str(), cached_path.c_str());
+            }
+        }
+#if defined(AMREX_USE_MPI)
+        MPI_Barrier(node_comm);
+        MPI_Comm_free(&node_comm);
+#endif
+        return cached_path;
+    }
 }
 
 void
@@ -226,6 +292,9 @@ WarpX::PrintMainPICparameters ()
         else if(poisson_solver_id == PoissonSolverAlgo::Multigrid){
             amrex::Print() << "Poisson solver:       | multigrid" << "\n";
         }
+        else if(poisson_solver_id == PoissonSolverAlgo::Spectral){
+            amrex::Print() << "Poisson solver:       | spectral" << "\n";
+        }
     }
 
     amrex::Print() << "-------------------------------------------------------------------------------\n";
@@ -233,6 +302,9 @@ WarpX::PrintMainPICparameters ()
     if (current_deposition_algo == CurrentDepositionAlgo::Direct){
       amrex::Print() << "Current Deposition:   | direct \n";
     }
+    else if (current_deposition_algo == CurrentDepositionAlgo::DirectBlocked){
+      amrex::Print() << "Current Deposition:   | direct (blocked) \n";
+    }
     else if (current_deposition_algo == CurrentDepositionAlgo::Vay){
       amrex::Print() << "Current Deposition:   | Vay \n";
     }
@@ -414,13 +486,13 @@ WarpX::PrintMainPICparameters ()
 }
 
 void
-WarpX::WriteUsedInputsFile () const
+WarpX::WriteUsedInputsFile (const std::vector<std::string>& comments) const
 {
     std::string filename = "warpx_used_inputs";
     ParmParse pp_warpx("warpx");
     pp_warpx.queryAdd("used_inputs_file", filename);
 
-    ablastr::utils::write_used_inputs_file(filename);
+    ablastr::utils::write_used_inputs_file(filename, comments);
 }
 
 void
@@ -437,6 +509,18 @@ WarpX::InitData ()
 
     Print() << utils::logo::get_logo();
 
+    // Duration of the phases of the initialization, printed at the end in verbose mode
+    amrex::Vector<std::pair<std::string, amrex::Real>> init_phases;
+    auto phase_start = amrex::second();
+    const auto end_phase = [&] (std::string const& name) {
+        if (verbose) {
+            amrex::Gpu::streamSynchronize();
+            const auto now = amrex::second();
+            init_phases.emplace_back(name, static_cast<amrex::Real>(now - phase_start));
+            phase_start = now;
+        }
+    };
+
     // Diagnostics
     multi_diags = std::make_unique<MultiDiagnostics>();
 
@@ -453,15 +537,26 @@ WarpX::InitData ()
     {
         ComputeDt();
         WarpX::PrintDtDxDyDz();
+        end_phase("diagnostics parsing");
         InitFromScratch();
+        end_phase("fields, solvers and particles");
+        if (m_dry_run_performance) {
+            // Only report the predicted performance: the simulation does not run
+            PredictPerformance();
+            return;
+        }
         InitDiagnostics();
+        end_phase("diagnostics");
     }
     else
     {
+        end_phase("diagnostics parsing");
         InitFromCheckpoint();
         WarpX::PrintDtDxDyDz();
         PostRestart();
+        end_phase("restart from checkpoint");
         reduced_diags->InitData();
+        end_phase("diagnostics");
     }
 
     ComputeMaxStep();
@@ -473,6 +568,7 @@ WarpX::InitData ()
     }
 
     BuildBufferMasks();
+    end_phase("PML factors, NCI corrector and buffer masks");
 
     if (WarpX::em_solver_medium==1) {
         const int lev_zero = 0;
@@ -490,6 +586,7 @@ WarpX::InitData ()
     if (WarpX::electromagnetic_solver_id == ElectromagneticSolverAlgo::HybridPIC) {
         m_hybrid_pic_model->InitData();
     }
+    end_phase("macroscopic and hybrid-PIC models");
 
     if (ParallelDescriptor::IOProcessor()) {
         std::cout << "\nGrids Summary:\n";
@@ -523,6 +620,7 @@ WarpX::InitData ()
         // solution and any external field
         AddExternalFields();
     }
+    end_phase("initial space-charge and external fields");
 
     if (restart_chkfile.empty() || write_diagnostics_on_restart) {
         // Write full diagnostics before the first iteration.
@@ -535,6 +633,19 @@ WarpX::InitData ()
             reduced_diags->WriteToFile(istep[0] - 1);
         }
     }
+    end_phase("initial diagnostics output");
+
+    if (verbose) {
+        // Maximum over the ranks of the duration of each phase
+        amrex::Vector<amrex::Real> durations;
+        for (auto const& phase : init_phases) { durations.push_back(phase.second); }
+        ParallelDescriptor::ReduceRealMax(durations.data(), static_cast<int>(durations.size()),
+                                          ParallelDescriptor::IOProcessorNumber());
+        amrex::Print() << "\nInitialization time breakdown (max over MPI ranks):\n";
+        for (int i = 0; i < static_cast<int>(durations.size()); ++i) {
+            amrex::Print() << "    " << init_phases[i].first << ": " << durations[i] << " s\n";
+        }
+    }
 
     PerformanceHints();
 
@@ -577,24 +688,14 @@ WarpX::InitFromScratch ()
         m_implicit_solver->GetParticleSolverParams( max_particle_its_in_implicit_scheme,
                                                     particle_tol_in_implicit_scheme );
 
-        // Add space to save the positions and velocities at the start of the time steps
-        for (auto const& pc : *mypc) {
-#if (AMREX_SPACEDIM >= 2)
-            pc->AddRealComp("x_n");
-#endif
-#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-            pc->AddRealComp("y_n");
-#endif
-            pc->AddRealComp("z_n");
-            pc->AddRealComp("ux_n");
-            pc->AddRealComp("uy_n");
-            pc->AddRealComp("uz_n");
-        }
+        // The positions and velocities at the start of the time steps are saved
+        // in buffers that only live during the steps, see SaveParticlesAtImplicitStepStart.
 
     }
 
     mypc->AllocData();
-    mypc->InitData();
+    // with warpx.dry_run_performance, the number of particles is only estimated
+    if (!m_dry_run_performance) { mypc->InitData(); }
 
     InitPML();
 
@@ -1287,14 +1388,20 @@ void WarpX::InitializeEBGridData (int lev)
               "particles are close to embedded boundaries");
         }
 
+        // Read the edge lengths, face areas and distance to the EB from the cache,
+        // if they were computed by a previous run with the same geometry and grids
+        const bool read_from_cache = ReadEBGridDataCache();
+
         if (WarpX::electromagnetic_solver_id != ElectromagneticSolverAlgo::PSATD ) {
 
-            auto const eb_fact = fieldEBFactory(lev);
+            if (!read_from_cache) {
+                auto const eb_fact = fieldEBFactory(lev);
 
-            ComputeEdgeLengths(m_edge_lengths[lev], eb_fact);
-            ScaleEdges(m_edge_lengths[lev], CellSize(lev));
-            ComputeFaceAreas(m_face_areas[lev], eb_fact);
-            ScaleAreas(m_face_areas[lev], CellSize(lev));
+                ComputeEdgeLengths(m_edge_lengths[lev], eb_fact);
+                ScaleEdges(m_edge_lengths[lev], CellSize(lev));
+                ComputeFaceAreas(m_face_areas[lev], eb_fact);
+                ScaleAreas(m_face_areas[lev], CellSize(lev));
+            }
 
             if (WarpX::electromagnetic_solver_id == ElectromagneticSolverAlgo::ECT) {
                 MarkCells();
@@ -1302,7 +1409,11 @@ void WarpX::InitializeEBGridData (int lev)
             }
         }
 
-        ComputeDistanceToEB();
+        if (!read_from_cache) {
+            ComputeDistanceToEB();
+            WriteEBGridDataCache();
+        }
+        ComputeNearEBBoxes();
 
     }
 #else
@@ -1359,30 +1470,36 @@ void WarpX::CheckKnownIssues()
 void
 WarpX::LoadExternalFieldsFromFile (int const lev)
 {
+    if (m_p_ext_field_params->B_ext_grid_type != ExternalFieldType::read_from_file &&
+        m_p_ext_field_params->E_ext_grid_type != ExternalFieldType::read_from_file) { return; }
+
+    const std::string external_fields_path = CacheExternalFieldsFile(
+        m_p_ext_field_params->external_fields_path, m_p_ext_field_params->external_fields_cache_dir);
+
     if (m_p_ext_field_params->B_ext_grid_type == ExternalFieldType::read_from_file) {
 #if defined(WARPX_DIM_RZ)
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(n_rz_azimuthal_modes == 1,
                                          "External field reading is not implemented for more than one RZ mode (see #3829)");
-        ReadExternalFieldFromFile(m_p_ext_field_params->external_fields_path, Bfield_fp_external[lev][0].get(), "B", "r");
-        ReadExternalFieldFromFile(m_p_ext_field_params->external_fields_path, Bfield_fp_external[lev][1].get(), "B", "t");
-        ReadExternalFieldFromFile(m_p_ext_field_params->external_fields_path, Bfield_fp_external[lev][2].get(), "B", "z");
+        ReadExternalFieldFromFile(external_fields_path, Bfield_fp_external[lev][0].get(), "B", "r");
+        ReadExternalFieldFromFile(external_fields_path, Bfield_fp_external[lev][1].get(), "B", "t");
+        ReadExternalFieldFromFile(external_fields_path, Bfield_fp_external[lev][2].get(), "B", "z");
 #else
-        ReadExternalFieldFromFile(m_p_ext_field_params->external_fields_path, Bfield_fp_external[lev][0].get(), "B", "x");
-        ReadExternalFieldFromFile(m_p_ext_field_params->external_fields_path, Bfield_fp_external[lev][1].get(), "B", "y");
-        ReadExternalFieldFromFile(m_p_ext_field_params->external_fields_path, Bfield_fp_external[lev][2].get(), "B", "z");
+        ReadExternalFieldFromFile(external_fields_path, Bfield_fp_external[lev][0].get(), "B", "x");
+        ReadExternalFieldFromFile(external_fields_path, Bfield_fp_external[lev][1].get(), "B", "y");
+        ReadExternalFieldFromFile(external_fields_path, Bfield_fp_external[lev][2].get(), "B", "z");
 #endif
     }
     if (m_p_ext_field_params->E_ext_grid_type == ExternalFieldType::read_from_file) {
 #if defined(WARPX_DIM_RZ)
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(n_rz_azimuthal_modes == 1,
                                          "External field reading is not implemented for more than one RZ mode (see #3829)");
-        ReadExternalFieldFromFile(m_p_ext_field_params->external_fields_path, Efield_fp_external[lev][0].get(), "E", "r");
-        ReadExternalFieldFromFile(m_p_ext_field_params->external_fields_path, Efield_fp_external[lev][1].get(), "E", "t");
-        ReadExternalFieldFromFile(m_p_ext_field_params->external_fields_path, Efield_fp_external[lev][2].get(), "E", "z");
+        ReadExternalFieldFromFile(external_fields_path, Efield_fp_external[lev][0].get(), "E", "r");
+        ReadExternalFieldFromFile(external_fields_path, Efield_fp_external[lev][1].get(), "E", "t");
+        ReadExternalFieldFromFile(external_fields_path, Efield_fp_external[lev][2].get(), "E", "z");
 #else
-        ReadExternalFieldFromFile(m_p_ext_field_params->external_fields_path, Efield_fp_external[lev][0].get(), "E", "x");
-        ReadExternalFieldFromFile(m_p_ext_field_params->external_fields_path, Efield_fp_external[lev][1].get(), "E", "y");
-        ReadExternalFieldFromFile(m_p_ext_field_params->external_fields_path, Efield_fp_external[lev][2].get(), "E", "z");
+        ReadExternalFieldFromFile(external_fields_path, Efield_fp_external[lev][0].get(), "E", "x");
+        ReadExternalFieldFromFile(external_fields_path, Efield_fp_external[lev][1].get(), "E", "y");
+        ReadExternalFieldFromFile(external_fields_path, Efield_fp_external[lev][2].get(), "E", "z");
 #endif
     }
 }
@@ -1396,173 +1513,11 @@ WarpX::ReadExternalFieldFromFile (
     // Get WarpX domain info
     auto& warpx = WarpX::GetInstance();
     amrex::Geometry const& geom0 = warpx.Geom(0);
-    const amrex::RealBox& real_box = geom0.ProbDomain();
-    const auto dx = geom0.CellSizeArray();
-    const amrex::IntVect nodal_flag = mf->ixType().toIntVect();
-
-    // Read external field openPMD data
-    auto series = openPMD::Series(read_fields_from_path, openPMD::Access::READ_ONLY);
-    auto iseries = series.iterations.begin()->second;
-    auto F = iseries.meshes[F_name];
-
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(F.getAttribute("dataOrder").get<std::string>() == "C",
-                                     "Reading from files with non-C dataOrder is not implemented");
-
-    auto axisLabels = F.getAttribute("axisLabels").get<std::vector<std::string>>();
-    auto fileGeom = F.getAttribute("geometry").get<std::string>();
-
-#if defined(WARPX_DIM_3D)
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fileGeom == "cartesian", "3D can only read from files with cartesian geometry");
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(axisLabels[0] == "x" && axisLabels[1] == "y" && axisLabels[2] == "z",
-                                     "3D expects axisLabels {x, y, z}");
-#elif defined(WARPX_DIM_XZ)
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fileGeom == "cartesian", "XZ can only read from files with cartesian geometry");
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(axisLabels[0] == "x" && axisLabels[1] == "z",
-                                     "XZ expects axisLabels {x, z}");
-#elif defined(WARPX_DIM_1D_Z)
-    WARPX_ABORT_WITH_MESSAGE(
-        "Reading from openPMD for external fields is not known to work with 1D3V (see #3830)");
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fileGeom == "cartesian", "1D3V can only read from files with cartesian geometry");
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(axisLabels[0] == "z");
-#elif defined(WARPX_DIM_RZ)
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fileGeom == "thetaMode", "RZ can only read from files with 'thetaMode'  geometry");
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(axisLabels[0] == "r" && axisLabels[1] == "z",
-                                     "RZ expects axisLabels {r, z}");
-#endif
-
-    const auto offset = F.gridGlobalOffset();
-    const auto offset0 = static_cast<amrex::Real>(offset[0]);
-    const auto offset1 = static_cast<amrex::Real>(offset[1]);
-#if defined(WARPX_DIM_3D)
-    const auto offset2 = static_cast<amrex::Real>(offset[2]);
-#endif
-    const auto d = F.gridSpacing<long double>();
-
-#if defined(WARPX_DIM_RZ)
-    const auto file_dr = static_cast<amrex::Real>(d[0]);
-    const auto file_dz = static_cast<amrex::Real>(d[1]);
-#elif defined(WARPX_DIM_3D)
-    const auto file_dx = static_cast<amrex::Real>(d[0]);
-    const auto file_dy = static_cast<amrex::Real>(d[1]);
-    const auto file_dz = static_cast<amrex::Real>(d[2]);
-#endif
-
-    auto FC = F[F_component];
-    const auto extent = FC.getExtent();
-    const auto extent0 = static_cast<int>(extent[0]);
-    const auto extent1 = static_cast<int>(extent[1]);
-    const auto extent2 = static_cast<int>(extent[2]);
-
-    // Determine the chunk data that will be loaded.
-    // Now, the full range of data is loaded.
-    // Loading chunk data can speed up the process.
-    // Thus, `chunk_offset` and `chunk_extent` should be modified accordingly in another PR.
-    const openPMD::Offset chunk_offset = {0,0,0};
-    const openPMD::Extent chunk_extent = {extent[0], extent[1], extent[2]};
-
-    auto FC_chunk_data = FC.loadChunk<double>(chunk_offset,chunk_extent);
-    series.flush();
-    auto *FC_data_host = FC_chunk_data.get();
-
-    // Load data to GPU
-    const size_t total_extent = size_t(extent[0]) * extent[1] * extent[2];
-    amrex::Gpu::DeviceVector<double> FC_data_gpu(total_extent);
-    auto *FC_data = FC_data_gpu.data();
-    amrex::Gpu::copy(amrex::Gpu::hostToDevice, FC_data_host, FC_data_host + total_extent, FC_data);
-
-    // Loop over boxes
-    for (MFIter mfi(*mf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
-        const amrex::Box box = mfi.growntilebox();
-        const amrex::Box tb = mfi.tilebox(nodal_flag, mf->nGrowVect());
-        auto const& mffab = mf->array(mfi);
-
-        // Start ParallelFor
-        amrex::ParallelFor (tb,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) {
-                // i,j,k denote x,y,z indices in 3D xyz.
-                // i,j denote r,z indices in 2D rz; k is just 0
-
-                // ii is used for 2D RZ mode
-#if defined(WARPX_DIM_RZ)
-                // In 2D RZ, i denoting r can be < 0
-                // but mirrored values should be assigned.
-                // Namely, mffab(i) = FC_data[-i] when i<0.
-                const int ii = (i<0)?(-i):(i);
-#else
-                const int ii = i;
-#endif
-
-                // Physical coordinates of the grid point
-                // 0,1,2 denote x,y,z in 3D xyz.
-                // 0,1 denote r,z in 2D rz.
-                amrex::Real x0, x1;
-                if ( box.type(0)==amrex::IndexType::CellIndex::NODE )
-                     { x0 = static_cast<amrex::Real>(real_box.lo(0)) + ii*dx[0]; }
-                else { x0 = static_cast<amrex::Real>(real_box.lo(0)) + ii*dx[0] + 0.5_rt*dx[0]; }
-                if ( box.type(1)==amrex::IndexType::CellIndex::NODE )
-                     { x1 = real_box.lo(1) + j*dx[1]; }
-                else { x1 = real_box.lo(1) + j*dx[1] + 0.5_rt*dx[1]; }
-
-#if defined(WARPX_DIM_RZ)
-                // Get index of the external field array
-                int const ir = std::floor( (x0-offset0)/file_dr );
-                int const iz = std::floor( (x1-offset1)/file_dz );
-
-                // Get coordinates of external grid point
-                amrex::Real const xx0 = offset0 + ir * file_dr;
-                amrex::Real const xx1 = offset1 + iz * file_dz;
-
-#elif defined(WARPX_DIM_3D)
-                amrex::Real x2;
-                if ( box.type(2)==amrex::IndexType::CellIndex::NODE )
-                     { x2 = real_box.lo(2) + k*dx[2]; }
-                else { x2 = real_box.lo(2) + k*dx[2] + 0.5_rt*dx[2]; }
-
-                // Get index of the external field array
-                int const ix = std::floor( (x0-offset0)/file_dx );
-                int const iy = std::floor( (x1-offset1)/file_dy );
-                int const iz = std::floor( (x2-offset2)/file_dz );
-
-                // Get coordinates of external grid point
-                amrex::Real const xx0 = offset0 + ix * file_dx;
-                amrex::Real const xx1 = offset1 + iy * file_dy;
-                amrex::Real const xx2 = offset2 + iz * file_dz;
-#endif
-
-#if defined(WARPX_DIM_RZ)
-                const amrex::Array4<double> fc_array(FC_data, {0,0,0}, {extent0, extent2, extent1}, 1);
-                const double
-                    f00 = fc_array(0, iz  , ir  ),
-                    f01 = fc_array(0, iz  , ir+1),
-                    f10 = fc_array(0, iz+1, ir  ),
-                    f11 = fc_array(0, iz+1, ir+1);
-                mffab(i,j,k) = static_cast<amrex::Real>(utils::algorithms::bilinear_interp<double>
-                    (xx0, xx0+file_dr, xx1, xx1+file_dz,
-                     f00, f01, f10, f11,
-                     x0, x1));
-#elif defined(WARPX_DIM_3D)
-                const amrex::Array4<double> fc_array(FC_data, {0,0,0}, {extent2, extent1, extent0}, 1);
-                const double
-                    f000 = fc_array(iz  , iy  , ix  ),
-                    f001 = fc_array(iz+1, iy  , ix  ),
-                    f010 = fc_array(iz  , iy+1, ix  ),
-                    f011 = fc_array(iz+1, iy+1, ix  ),
-                    f100 = fc_array(iz  , iy  , ix+1),
-                    f101 = fc_array(iz+1, iy  , ix+1),
-                    f110 = fc_array(iz  , iy+1, ix+1),
-                    f111 = fc_array(iz+1, iy+1, ix+1);
-                mffab(i,j,k) = static_cast<amrex::Real>(utils::algorithms::trilinear_interp<double>
-                    (xx0, xx0+file_dx, xx1, xx1+file_dy, xx2, xx2+file_dz,
-                     f000, f001, f010, f011, f100, f101, f110, f111,
-                     x0, x1, x2));
-#endif
-
-            }
-
-        ); // End ParallelFor
 
-    } // End loop over boxes.
+    const auto chunk = warpx::initialization::ReadExternalFieldChunk(
+        read_fields_from_path, std::nullopt, F_name, F_component,
+        warpx::initialization::LocalFabBoxes(*mf), geom0);
+    warpx::initialization::InterpolateExternalFieldChunk(chunk, *mf, 0, geom0);
 
 } // End function WarpX::ReadExternalFieldFromFile
 #else // WARPX_USE_OPENPMD && !WARPX_DIM_1D_Z && !defined(WARPX_DIM_XZ)
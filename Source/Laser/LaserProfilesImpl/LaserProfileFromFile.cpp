@@ -33,6 +33,7 @@
 #include <cmath>
 #include <cstdint>
 #include <fstream>
+#include <future>
 #include <iterator>
 #include <limits>
 #include <string>
@@ -99,6 +100,10 @@ WarpXLaserProfiles::FromFileLaserProfile::init (
     }
     //Reads the (optional) delay
     utils::parser::queryWithParser(ppl, "delay", m_params.t_delay);
+    //Whether the next time chunk is read in the background. The lasy files are read with
+    //openPMD, which is only safe if it can run concurrently with the openPMD diagnostics.
+    m_params.prefetch_time_chunks = !m_params.file_in_lasy_format;
+    ppl.query("prefetch_time_chunks", m_params.prefetch_time_chunks);
 
     //Read first time chunk
     if (m_params.file_in_lasy_format){
@@ -314,55 +319,45 @@ WarpXLaserProfiles::FromFileLaserProfile::read_data_t_chunk (int t_begin, int t_
 {
 #ifdef WARPX_USE_OPENPMD
     //Indices of the first and last timestep to read
-    auto const i_first = static_cast<long unsigned int>(max(0, t_begin));
-    auto const i_last = static_cast<long unsigned int>(min(t_end-1, m_params.nt-1));
+    auto i_first = max(0, t_begin);
+    auto i_last = min(t_end-1, m_params.nt-1);
+    //Use the prefetched chunk if it contains the two timesteps needed now
+    const bool use_prefetch = (m_params.prefetch_first_time_index >= 0) &&
+        (m_params.prefetch_first_time_index <= i_first) &&
+        (i_first+1 <= m_params.prefetch_last_time_index);
+    if (use_prefetch) {
+        i_first = m_params.prefetch_first_time_index;
+        i_last = m_params.prefetch_last_time_index;
+    }
     amrex::Print() << Utils::TextMsg::Info(
         "Reading [" + std::to_string(i_first) + ", " + std::to_string(i_last) +
-            "] data chunk from " + m_params.lasy_file_name);
+            "] data chunk from " + m_params.lasy_file_name + (use_prefetch ? " (prefetched)" : ""));
     const auto data_size =
         (m_params.file_in_cartesian_geom==0)?
         (m_params.n_rz_azimuthal_components*(i_last-i_first+1)*m_params.nr) :
         (i_last-i_first+1)*m_params.nx*m_params.ny;
-    m_params.E_lasy_data.resize(data_size);
-    Vector<Complex> h_E_lasy_data(m_params.E_lasy_data.size());
+    Vector<Complex> h_E_lasy_data(data_size);
     if(ParallelDescriptor::IOProcessor()){
-        auto series = io::Series(m_params.lasy_file_name, io::Access::READ_ONLY);
-        auto i = series.iterations[0];
-        auto E = i.meshes["laserEnvelope"];
-        auto E_laser = E[io::RecordComponent::SCALAR];
-        openPMD:: Extent full_extent = E_laser.getExtent();
-        if (m_params.file_in_cartesian_geom==0) {
-            const openPMD::Extent read_extent = { full_extent[0], (i_last - i_first + 1), full_extent[2]};
-            auto r_data = E_laser.loadChunk< std::complex<double> >(io::Offset{ 0, i_first,  0}, read_extent);
-            const auto read_size = (i_last - i_first + 1)*m_params.nr;
-            series.flush();
-            for (int m=0; m<m_params.n_rz_azimuthal_components; m++){
-                for (auto j=0u; j<read_size; j++) {
-                    h_E_lasy_data[j+m*read_size] = Complex{
-                        static_cast<amrex::Real>(r_data.get()[j+m*read_size].real()),
-                        static_cast<amrex::Real>(r_data.get()[j+m*read_size].imag())};
-                }
-            }
-        } else{
-            const openPMD::Extent read_extent = {(i_last - i_first + 1), full_extent[1], full_extent[2]};
-            auto x_data = E_laser.loadChunk< std::complex<double> >(io::Offset{i_first, 0, 0}, read_extent);
-            const auto read_size = (i_last - i_first + 1)*m_params.nx*m_params.ny;
-            series.flush();
-            for (auto j=0u; j<read_size; j++) {
-                h_E_lasy_data[j] = Complex{
-                    static_cast<amrex::Real>(x_data.get()[j].real()),
-                    static_cast<amrex::Real>(x_data.get()[j].imag())};
-            }
+        if (m_params.E_lasy_prefetch.valid()) {
+            // A prefetch that does not contain the needed timesteps is discarded
+            auto prefetched_data = m_params.E_lasy_prefetch.get();
+            if (use_prefetch) { h_E_lasy_data = std::move(prefetched_data); }
         }
+        if (!use_prefetch) { h_E_lasy_data = read_lasy_chunk_from_file(i_first, i_last); }
     }
+    m_params.prefetch_first_time_index = -1;
+    m_params.prefetch_last_time_index = -1;
     //Broadcast E_lasy_data
     ParallelDescriptor::Bcast(h_E_lasy_data.dataPtr(),
         h_E_lasy_data.size(), ParallelDescriptor::IOProcessorNumber());
+    m_params.E_lasy_data.resize(data_size);
     Gpu::copyAsync(Gpu::hostToDevice,h_E_lasy_data.begin(),h_E_lasy_data.end(),m_params.E_lasy_data.begin());
     Gpu::synchronize();
     //Update first and last indices
-    m_params.first_time_index = static_cast<int>(i_first);
-    m_params.last_time_index = static_cast<int>(i_last);
+    m_params.first_time_index = i_first;
+    m_params.last_time_index = i_last;
+    //Start reading the next chunk
+    prefetch_next_t_chunk();
 #else
     amrex::ignore_unused(t_begin, t_end);
 #endif
@@ -371,57 +366,150 @@ WarpXLaserProfiles::FromFileLaserProfile::read_data_t_chunk (int t_begin, int t_
 void
 WarpXLaserProfiles::FromFileLaserProfile::read_binary_data_t_chunk (int t_begin, int t_end)
 {
-    amrex::Print() << Utils::TextMsg::Info(
-        "Reading [" + std::to_string(t_begin) + ", " + std::to_string(t_end) +
-            "] data chunk from " + m_params.binary_file_name);
-
     //Indices of the first and last timestep to read
     auto i_first = max(0, t_begin);
     auto i_last = min(t_end-1, m_params.nt-1);
+    //Use the prefetched chunk if it contains the two timesteps needed now
+    const bool use_prefetch = (m_params.prefetch_first_time_index >= 0) &&
+        (m_params.prefetch_first_time_index <= i_first) &&
+        (i_first+1 <= m_params.prefetch_last_time_index);
+    if (use_prefetch) {
+        i_first = m_params.prefetch_first_time_index;
+        i_last = m_params.prefetch_last_time_index;
+    }
+    amrex::Print() << Utils::TextMsg::Info(
+        "Reading [" + std::to_string(i_first) + ", " + std::to_string(i_last) +
+            "] data chunk from " + m_params.binary_file_name + (use_prefetch ? " (prefetched)" : ""));
     const int data_size = (i_last-i_first+1)*m_params.nx*m_params.ny;
-    m_params.E_binary_data.resize(data_size);
-    Vector<Real> h_E_binary_data(m_params.E_binary_data.size());
+    Vector<Real> h_E_binary_data(data_size);
     if(ParallelDescriptor::IOProcessor()){
-        //Read data chunk
-        std::ifstream inp(m_params.binary_file_name, std::ios::binary);
-        if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to open binary file"); }
-        inp.exceptions(std::ios_base::failbit | std::ios_base::badbit);
-#if (defined(WARPX_DIM_3D))
-        auto skip_amount = 1 +
-        3*sizeof(uint32_t) +
-        2*sizeof(double) +
-        2*sizeof(double) +
-        2*sizeof(double) +
-        sizeof(double)*t_begin*m_params.nx*m_params.ny;
-#else
-        auto skip_amount = 1 +
-        3*sizeof(uint32_t) +
-        2*sizeof(double) +
-        2*sizeof(double) +
-        1*sizeof(double) +
-        sizeof(double)*t_begin*m_params.nx*m_params.ny;
-#endif
-        inp.seekg(static_cast<std::streamoff>(skip_amount));
-        if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to read field data from binary file"); }
-        const int read_size = (i_last - i_first + 1)*
-            m_params.nx*m_params.ny;
-        Vector<double> buf_e(read_size);
-        inp.read(reinterpret_cast<char*>(buf_e.dataPtr()), static_cast<std::streamsize>(read_size*sizeof(double)));
-        if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to read field data from binary file"); }
-        std::transform(buf_e.begin(), buf_e.end(), h_E_binary_data.begin(),
-            [](auto x) {return static_cast<amrex::Real>(x);} );
+        if (m_params.E_binary_prefetch.valid()) {
+            // A prefetch that does not contain the needed timesteps is discarded
+            auto prefetched_data = m_params.E_binary_prefetch.get();
+            if (use_prefetch) { h_E_binary_data = std::move(prefetched_data); }
+        }
+        if (!use_prefetch) { h_E_binary_data = read_binary_chunk_from_file(i_first, i_last); }
     }
+    m_params.prefetch_first_time_index = -1;
+    m_params.prefetch_last_time_index = -1;
 
     //Broadcast E_binary_data
     ParallelDescriptor::Bcast(h_E_binary_data.dataPtr(),
         h_E_binary_data.size(), ParallelDescriptor::IOProcessorNumber());
 
+    m_params.E_binary_data.resize(data_size);
     Gpu::copyAsync(Gpu::hostToDevice,h_E_binary_data.begin(),h_E_binary_data.end(),m_params.E_binary_data.begin());
     Gpu::synchronize();
 
     //Update first and last indices
-    m_params.first_time_index = static_cast<int>(i_first);
-    m_params.last_time_index = static_cast<int>(i_last);
+    m_params.first_time_index = i_first;
+    m_params.last_time_index = i_last;
+    //Start reading the next chunk
+    prefetch_next_t_chunk();
+}
+
+amrex::Vector<Complex>
+WarpXLaserProfiles::FromFileLaserProfile::read_lasy_chunk_from_file (int i_first, int i_last) const
+{
+#ifdef WARPX_USE_OPENPMD
+    auto const t_first = static_cast<long unsigned int>(i_first);
+    auto const t_last = static_cast<long unsigned int>(i_last);
+    const auto data_size =
+        (m_params.file_in_cartesian_geom==0)?
+        (m_params.n_rz_azimuthal_components*(t_last-t_first+1)*m_params.nr) :
+        (t_last-t_first+1)*m_params.nx*m_params.ny;
+    Vector<Complex> h_E_lasy_data(data_size);
+    auto series = io::Series(m_params.lasy_file_name, io::Access::READ_ONLY);
+    auto i = series.iterations[0];
+    auto E = i.meshes["laserEnvelope"];
+    auto E_laser = E[io::RecordComponent::SCALAR];
+    openPMD:: Extent full_extent = E_laser.getExtent();
+    if (m_params.file_in_cartesian_geom==0) {
+        const openPMD::Extent read_extent = { full_extent[0], (t_last - t_first + 1), full_extent[2]};
+        auto r_data = E_laser.loadChunk< std::complex<double> >(io::Offset{ 0, t_first,  0}, read_extent);
+        const auto read_size = (t_last - t_first + 1)*m_params.nr;
+        series.flush();
+        for (int m=0; m<m_params.n_rz_azimuthal_components; m++){
+            for (auto j=0u; j<read_size; j++) {
+                h_E_lasy_data[j+m*read_size] = Complex{
+                    static_cast<amrex::Real>(r_data.get()[j+m*read_size].real()),
+                    static_cast<amrex::Real>(r_data.get()[j+m*read_size].imag())};
+            }
+        }
+    } else{
+        const openPMD::Extent read_extent = {(t_last - t_first + 1), full_extent[1], full_extent[2]};
+        auto x_data = E_laser.loadChunk< std::complex<double> >(io::Offset{t_first, 0, 0}, read_extent);
+        const auto read_size = (t_last - t_first + 1)*m_params.nx*m_params.ny;
+        series.flush();
+        for (auto j=0u; j<read_size; j++) {
+            h_E_lasy_data[j] = Complex{
+                static_cast<amrex::Real>(x_data.get()[j].real()),
+                static_cast<amrex::Real>(x_data.get()[j].imag())};
+        }
+    }
+    return h_E_lasy_data;
+#else
+    amrex::ignore_unused(i_first, i_last);
+    return Vector<Complex>{};
+#endif
+}
+
+amrex::Vector<amrex::Real>
+WarpXLaserProfiles::FromFileLaserProfile::read_binary_chunk_from_file (int i_first, int i_last) const
+{
+    //Read data chunk
+    std::ifstream inp(m_params.binary_file_name, std::ios::binary);
+    if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to open binary file"); }
+    inp.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+#if (defined(WARPX_DIM_3D))
+    auto skip_amount = 1 +
+    3*sizeof(uint32_t) +
+    2*sizeof(double) +
+    2*sizeof(double) +
+    2*sizeof(double) +
+    sizeof(double)*i_first*m_params.nx*m_params.ny;
+#else
+    auto skip_amount = 1 +
+    3*sizeof(uint32_t) +
+    2*sizeof(double) +
+    2*sizeof(double) +
+    1*sizeof(double) +
+    sizeof(double)*i_first*m_params.nx*m_params.ny;
+#endif
+    inp.seekg(static_cast<std::streamoff>(skip_amount));
+    if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to read field data from binary file"); }
+    const int read_size = (i_last - i_first + 1)*
+        m_params.nx*m_params.ny;
+    Vector<double> buf_e(read_size);
+    inp.read(reinterpret_cast<char*>(buf_e.dataPtr()), static_cast<std::streamsize>(read_size*sizeof(double)));
+    if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to read field data from binary file"); }
+    Vector<Real> h_E_binary_data(read_size);
+    std::transform(buf_e.begin(), buf_e.end(), h_E_binary_data.begin(),
+        [](auto x) {return static_cast<amrex::Real>(x);} );
+    return h_E_binary_data;
+}
+
+void
+WarpXLaserProfiles::FromFileLaserProfile::prefetch_next_t_chunk ()
+{
+    if (!m_params.prefetch_time_chunks || m_params.last_time_index >= m_params.nt-1) {
+        return;
+    }
+    // The next chunk starts with the last timestep in memory, which is the left
+    // timestep when the next chunk is needed
+    const int i_first = m_params.last_time_index;
+    const int i_last = min(i_first + m_params.time_chunk_size - 1, m_params.nt-1);
+    m_params.prefetch_first_time_index = i_first;
+    m_params.prefetch_last_time_index = i_last;
+    if (ParallelDescriptor::IOProcessor()) {
+        if (m_params.file_in_lasy_format) {
+            m_params.E_lasy_prefetch = std::async(std::launch::async,
+                [this, i_first, i_last] () { return read_lasy_chunk_from_file(i_first, i_last); });
+        } else {
+            m_params.E_binary_prefetch = std::async(std::launch::async,
+                [this, i_first, i_last] () { return read_binary_chunk_from_file(i_first, i_last); });
+        }
+    }
 }
 
 void
@@ -0,0 +1,161 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "GridSizeAutotuner.H"
+
+#include "Utils/Parser/ParserUtils.H"
+#include "Utils/TextMsg.H"
+#include "WarpX.H"
+
+#include <AMReX_Box.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /** Replace the parameters amr.<name> and amr.<name>_x, _y, _z by the values of iv */
+    void SetAmrParameter (const std::string& name, const amrex::IntVect& iv)
+    {
+        amrex::ParmParse pp_amr("amr");
+        const std::vector<std::string> suffixes = {"_x", "_y", "_z"};
+        pp_amr.remove(name);
+        for (const auto& suffix : suffixes) { pp_amr.remove(name + suffix); }
+        if (iv == amrex::IntVect(iv[0])) {
+            pp_amr.add(name.c_str(), iv[0]);
+        } else {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                pp_amr.add((name + suffixes[idim]).c_str(), iv[idim]);
+            }
+        }
+    }
+}
+
+GridSizeAutotuner::GridSizeAutotuner ()
+{
+    const amrex::ParmParse pp_warpx("warpx");
+    pp_warpx.query("grid_size_autotune", m_enabled);
+    if (!m_enabled) { return; }
+
+    utils::parser::queryWithParser(
+        pp_warpx, "grid_size_autotune_steps", m_steps_per_candidate);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_steps_per_candidate >= 1,
+        "warpx.grid_size_autotune_steps must be at least 1");
+    utils::parser::queryArrWithParser(
+        pp_warpx, "grid_size_autotune_factors", m_factors);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_factors.empty() &&
+        std::all_of(m_factors.begin(), m_factors.end(), [](amrex::Real f){ return f > 0; }),
+        "warpx.grid_size_autotune_factors must be positive");
+    utils::parser::queryArrWithParser(
+        pp_warpx, "grid_size_autotune_blocking_factors", m_blocking_factors);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        std::all_of(m_blocking_factors.begin(), m_blocking_factors.end(), [](int b){ return b > 0; }),
+        "warpx.grid_size_autotune_blocking_factors must be positive");
+    m_start = true;
+}
+
+bool GridSizeAutotuner::beginStep (WarpX& warpx, const int verbose)
+{
+    if (m_start) {
+        // Candidates around the current maximum grid size, for each blocking factor
+        // that divides the domain
+        const amrex::IntVect base = warpx.maxGridSize(0);
+        const amrex::IntVect domain_size = warpx.Geom(0).Domain().size();
+        amrex::Vector<amrex::IntVect> blocking_factors;
+        if (m_blocking_factors.empty()) {
+            blocking_factors.push_back(warpx.blockingFactor(0));
+        }
+        for (const int b : m_blocking_factors) {
+            blocking_factors.emplace_back(b);
+        }
+        m_max_grid_sizes.clear();
+        m_blocking_factor_candidates.clear();
+        for (const auto& bf : blocking_factors) {
+            if (domain_size != (domain_size/bf)*bf) { continue; }
+            for (const auto factor : m_factors) {
+                amrex::IntVect candidate;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    const auto nblocks = static_cast<int>(std::lround(base[idim]*factor/bf[idim]));
+                    candidate[idim] = std::max(1, nblocks)*bf[idim];
+                }
+                bool is_new = true;
+                for (int i = 0; i < static_cast<int>(m_max_grid_sizes.size()); ++i) {
+                    is_new = is_new && !(m_max_grid_sizes[i] == candidate &&
+                                         m_blocking_factor_candidates[i] == bf);
+                }
+                if (is_new) {
+                    m_max_grid_sizes.push_back(candidate);
+                    m_blocking_factor_candidates.push_back(bf);
+                }
+            }
+        }
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_max_grid_sizes.empty(),
+            "warpx.grid_size_autotune: no blocking factor divides the domain");
+        m_times.assign(m_max_grid_sizes.size(), amrex::Real(0));
+        m_candidate = 0;
+        m_step_count = -1;
+        m_start = false;
+        m_is_tuning = m_max_grid_sizes.size() > 1;
+        if (m_is_tuning) { warpx.RemakeBaseGrids(m_max_grid_sizes[0], m_blocking_factor_candidates[0]); }
+        return false;
+    }
+
+    if (!m_is_tuning || m_step_count < m_steps_per_candidate) { return false; }
+
+    // All the steps of the candidate are done
+    amrex::ParallelDescriptor::ReduceRealMax(m_times[m_candidate]);
+    m_step_count = -1;
+    ++m_candidate;
+    if (m_candidate < static_cast<int>(m_max_grid_sizes.size())) {
+        warpx.RemakeBaseGrids(m_max_grid_sizes[m_candidate], m_blocking_factor_candidates[m_candidate]);
+        return false;
+    }
+
+    // End of the tuning: keep the fastest grid size
+    m_is_tuning = false;
+    const auto best = static_cast<int>(
+        std::min_element(m_times.begin(), m_times.end()) - m_times.begin());
+    warpx.RemakeBaseGrids(m_max_grid_sizes[best], m_blocking_factor_candidates[best]);
+
+    // Record the selection in the used inputs file, for the next runs
+    SetAmrParameter("max_grid_size", m_max_grid_sizes[best]);
+    SetAmrParameter("blocking_factor", m_blocking_factor_candidates[best]);
+    amrex::ParmParse pp_warpx("warpx");
+    pp_warpx.remove("grid_size_autotune");
+    pp_warpx.add("grid_size_autotune", 0);
+    std::vector<std::string> comments = {"Grid size autotuning (time per step on the slowest rank):"};
+    for (int i = 0; i < static_cast<int>(m_max_grid_sizes.size()); ++i) {
+        std::stringstream ss;
+        ss << "  max_grid_size " << m_max_grid_sizes[i]
+           << ", blocking_factor " << m_blocking_factor_candidates[i]
+           << ": " << m_times[i]/m_steps_per_candidate << " s" << ((i == best) ? " (selected)" : "");
+        comments.push_back(ss.str());
+    }
+    warpx.WriteUsedInputsFile(comments);
+
+    if (verbose) {
+        std::stringstream ss;
+        ss << "Grid size autotuning selected max_grid_size " << m_max_grid_sizes[best]
+           << " and blocking_factor " << m_blocking_factor_candidates[best]
+           << " (" << m_times[best]/m_steps_per_candidate << " s per step)";
+        amrex::Print() << Utils::TextMsg::Info(ss.str());
+    }
+    return true;
+}
+
+void GridSizeAutotuner::endStep (const amrex::Real step_time)
+{
+    if (!m_is_tuning) { return; }
+    // The first step of each candidate is a warm-up
+    if (m_step_count >= 0) { m_times[m_candidate] += step_time; }
+    ++m_step_count;
+}
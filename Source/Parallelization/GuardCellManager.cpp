@@ -54,7 +54,10 @@ guardCellManager::Init (
     const int pml_ncell,
     const amrex::Vector<amrex::IntVect>& ref_ratios,
     const bool use_filter,
-    const amrex::IntVect& bilinear_filter_stencil_length)
+    const amrex::IntVect& bilinear_filter_stencil_length,
+    const int fdtd_temporal_blocking,
+    const bool fdtd_fused_leapfrog,
+    const int hybrid_substeps_per_exchange)
 {
     // When using subcycling, the particles on the fine level perform two pushes
     // before being redistributed ; therefore, we need one extra guard cell
@@ -340,4 +343,40 @@ guardCellManager::Init (
             ng_MovingWindow[moving_window_dir] = 1;
         }
     }
+
+    // The fused FDTD push does not exchange guard cells in between the pushes of B, E and B:
+    // at the beginning of the step, E must be up-to-date in three stencils of guard cells
+    // (and B in two), which are filled along with those of the field gather
+    if (fdtd_fused_leapfrog)
+    {
+        ng_alloc_EB.max(3*ng_FieldSolver);
+        ng_FieldGather.max(3*ng_FieldSolver);
+    }
+
+    // FDTD temporal blocking: each step consumes the stencil of the field solver twice
+    // (B is pushed from the guard cells of E, E from those of B), and the field gather
+    // needs ng_FieldGather up-to-date guard cells at the beginning of each step. Thus,
+    // fdtd_temporal_blocking steps fit in between two exchanges of all the guard cells
+    // if these are allocated as below. J must be filled as far as E is pushed.
+    if (fdtd_temporal_blocking > 1)
+    {
+        ng_alloc_EB.max(ng_FieldGather + (2*fdtd_temporal_blocking-1)*ng_FieldSolver);
+        ng_alloc_J.max(ng_alloc_EB);
+    }
+
+    // Hybrid-PIC substeps in between two exchanges of B: each of the 4 Runge-Kutta stages
+    // of a substep consumes 4 stencils (for the total current, the nodal E, E and B).
+    // The total current, the ion current, the charge density and the electron pressure
+    // are then needed in as many guard cells as E.
+    if (hybrid_substeps_per_exchange > 0)
+    {
+        ng_alloc_EB.max(16*hybrid_substeps_per_exchange*ng_FieldSolver);
+        ng_alloc_J.max(ng_alloc_EB);
+        ng_alloc_Rho.max(ng_alloc_EB);
+    }
+
+    // The nodal auxiliary grid is recomputed from the fine patch at each step, and then only
+    // read by the field gather: it needs neither the guard cells of the field solver stencil
+    // nor those of the current deposition
+    ng_alloc_aux = amrex::min(amrex::max(ng_FieldGather, ng_UpdateAux), ng_alloc_EB);
 }
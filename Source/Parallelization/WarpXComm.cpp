@@ -13,6 +13,7 @@
 #   include "BoundaryConditions/PML_RZ.H"
 #endif
 #include "Filter/BilinearFilter.H"
+#include "Utils/PhaseTimers.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -20,6 +21,7 @@
 #include "WarpXSumGuardCells.H"
 
 #include <ablastr/coarsen/average.H>
+#include <ablastr/utils/CommStats.H>
 #include <ablastr/utils/Communication.H>
 
 #include <AMReX.H>
@@ -88,6 +90,8 @@ WarpX::UpdateAuxilaryDataStagToNodal ()
     // Destination MultiFab (aux) always has nodal index type when this function is called
     const amrex::IntVect& dst_stag = amrex::IntVect::TheNodeVector();
 
+    const amrex::IntVect ng_aux_gather = amrex::min(guard_cells.ng_FieldGather, Bfield_aux[0][0]->nGrowVect());
+
     // For level 0, we only need to do the average.
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
@@ -110,8 +114,11 @@ WarpX::UpdateAuxilaryDataStagToNodal ()
 
         // Loop includes ghost cells (`growntilebox`)
         // (input arrays will be padded with zeros beyond ghost cells
-        // for out-of-bound accesses due to large-stencil operations)
-        const Box bx = mfi.growntilebox();
+        // for out-of-bound accesses due to large-stencil operations).
+        // Without mesh refinement, the aux guard cells are only read by the field gather,
+        // so that the ones beyond the guard cells needed by the gather are not computed.
+        const Box bx = (finest_level == 0) ?
+            mfi.growntilebox(ng_aux_gather) : mfi.growntilebox();
 
         // Order of finite-order centering of fields
         const int fg_nox = WarpX::field_centering_nox;
@@ -301,37 +308,33 @@ WarpX::UpdateAuxilaryDataSameType ()
 
         // B field
         {
-            MultiFab dBx(Bfield_cp[lev][0]->boxArray(), dm, Bfield_cp[lev][0]->nComp(), ng);
-            MultiFab dBy(Bfield_cp[lev][1]->boxArray(), dm, Bfield_cp[lev][1]->nComp(), ng);
-            MultiFab dBz(Bfield_cp[lev][2]->boxArray(), dm, Bfield_cp[lev][2]->nComp(), ng);
-            dBx.setVal(0.0);
-            dBy.setVal(0.0);
-            dBz.setVal(0.0);
+            // Values of Bfield_aux of the coarser level on the coarse patch, stored in
+            // Bfield_cax if it is allocated. Their difference with Bfield_cp is computed
+            // in the interpolation kernel below, instead of in a separate pass.
+            std::array<std::unique_ptr<MultiFab>,3> dB_tmp;
+            std::array<MultiFab*,3> dB;
+            for (int i = 0; i < 3; ++i) {
+                if (Bfield_cax[lev][i]) {
+                    dB[i] = Bfield_cax[lev][i].get();
+                } else {
+                    dB_tmp[i] = std::make_unique<MultiFab>(Bfield_cp[lev][i]->boxArray(), dm,
+                                                         Bfield_cp[lev][i]->nComp(), ng);
+                    dB[i] = dB_tmp[i].get();
+                }
+                dB[i]->setVal(0.0);
+            }
 
             // Guard cells may not be up to date beyond ng_FieldGather
             const amrex::IntVect& ng_src = guard_cells.ng_FieldGather;
             // Copy Bfield_aux to the dB MultiFabs, using up to ng_src (=ng_FieldGather) guard
             // cells from Bfield_aux and filling up to ng (=nGrow) guard cells in the dB MultiFabs
-
-            ablastr::utils::communication::ParallelCopy(dBx, *Bfield_aux[lev - 1][0], 0, 0,
-                                                        Bfield_aux[lev - 1][0]->nComp(), ng_src, ng, WarpX::do_single_precision_comms,
-                                                        crse_period);
-            ablastr::utils::communication::ParallelCopy(dBy, *Bfield_aux[lev - 1][1], 0, 0,
-                                                        Bfield_aux[lev - 1][1]->nComp(), ng_src, ng, WarpX::do_single_precision_comms,
-                                                        crse_period);
-            ablastr::utils::communication::ParallelCopy(dBz, *Bfield_aux[lev - 1][2], 0, 0,
-                                                        Bfield_aux[lev - 1][2]->nComp(), ng_src, ng, WarpX::do_single_precision_comms,
-                                                        crse_period);
-
-            if (Bfield_cax[lev][0])
-            {
-                MultiFab::Copy(*Bfield_cax[lev][0], dBx, 0, 0, Bfield_cax[lev][0]->nComp(), ng);
-                MultiFab::Copy(*Bfield_cax[lev][1], dBy, 0, 0, Bfield_cax[lev][1]->nComp(), ng);
-                MultiFab::Copy(*Bfield_cax[lev][2], dBz, 0, 0, Bfield_cax[lev][2]->nComp(), ng);
+            // (the communication plans of ParallelCopy are cached by AMReX between steps)
+            for (int i = 0; i < 3; ++i) {
+                ablastr::utils::communication::ParallelCopy(*dB[i], *Bfield_aux[lev - 1][i], 0, 0,
+                                                            Bfield_aux[lev - 1][i]->nComp(), ng_src, ng,
+                                                            WarpX::do_single_precision_comms,
+                                                            crse_period);
             }
-            MultiFab::Subtract(dBx, *Bfield_cp[lev][0], 0, 0, Bfield_cp[lev][0]->nComp(), ng);
-            MultiFab::Subtract(dBy, *Bfield_cp[lev][1], 0, 0, Bfield_cp[lev][1]->nComp(), ng);
-            MultiFab::Subtract(dBz, *Bfield_cp[lev][2], 0, 0, Bfield_cp[lev][2]->nComp(), ng);
 
             const amrex::IntVect& refinement_ratio = refRatio(lev-1);
 
@@ -350,61 +353,58 @@ WarpX::UpdateAuxilaryDataSameType ()
                 Array4<Real const> const& bx_fp = Bfield_fp[lev][0]->const_array(mfi);
                 Array4<Real const> const& by_fp = Bfield_fp[lev][1]->const_array(mfi);
                 Array4<Real const> const& bz_fp = Bfield_fp[lev][2]->const_array(mfi);
-                Array4<Real const> const& bx_c = dBx.const_array(mfi);
-                Array4<Real const> const& by_c = dBy.const_array(mfi);
-                Array4<Real const> const& bz_c = dBz.const_array(mfi);
+                Array4<Real const> const& bx_c = dB[0]->const_array(mfi);
+                Array4<Real const> const& by_c = dB[1]->const_array(mfi);
+                Array4<Real const> const& bz_c = dB[2]->const_array(mfi);
+                Array4<Real const> const& bx_cp = Bfield_cp[lev][0]->const_array(mfi);
+                Array4<Real const> const& by_cp = Bfield_cp[lev][1]->const_array(mfi);
+                Array4<Real const> const& bz_cp = Bfield_cp[lev][2]->const_array(mfi);
 
                 amrex::ParallelFor(Box(bx_aux), Box(by_aux), Box(bz_aux),
                 [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
                 {
-                    warpx_interp(j, k, l, bx_aux, bx_fp, bx_c, Bx_stag, refinement_ratio);
+                    warpx_interp(j, k, l, bx_aux, bx_fp, bx_c, bx_cp, Bx_stag, refinement_ratio);
                 },
                 [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
                 {
-                    warpx_interp(j, k, l, by_aux, by_fp, by_c, By_stag, refinement_ratio);
+                    warpx_interp(j, k, l, by_aux, by_fp, by_c, by_cp, By_stag, refinement_ratio);
                 },
                 [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
                 {
-                    warpx_interp(j, k, l, bz_aux, bz_fp, bz_c, Bz_stag, refinement_ratio);
+                    warpx_interp(j, k, l, bz_aux, bz_fp, bz_c, bz_cp, Bz_stag, refinement_ratio);
                 });
             }
         }
 
         // E field
         {
-            MultiFab dEx(Efield_cp[lev][0]->boxArray(), dm, Efield_cp[lev][0]->nComp(), ng);
-            MultiFab dEy(Efield_cp[lev][1]->boxArray(), dm, Efield_cp[lev][1]->nComp(), ng);
-            MultiFab dEz(Efield_cp[lev][2]->boxArray(), dm, Efield_cp[lev][2]->nComp(), ng);
-            dEx.setVal(0.0);
-            dEy.setVal(0.0);
-            dEz.setVal(0.0);
+            // Values of Efield_aux of the coarser level on the coarse patch, stored in
+            // Efield_cax if it is allocated. Their difference with Efield_cp is computed
+            // in the interpolation kernel below, instead of in a separate pass.
+            std::array<std::unique_ptr<MultiFab>,3> dE_tmp;
+            std::array<MultiFab*,3> dE;
+            for (int i = 0; i < 3; ++i) {
+                if (Efield_cax[lev][i]) {
+                    dE[i] = Efield_cax[lev][i].get();
+                } else {
+                    dE_tmp[i] = std::make_unique<MultiFab>(Efield_cp[lev][i]->boxArray(), dm,
+                                                         Efield_cp[lev][i]->nComp(), ng);
+                    dE[i] = dE_tmp[i].get();
+                }
+                dE[i]->setVal(0.0);
+            }
 
             // Guard cells may not be up to date beyond ng_FieldGather
             const amrex::IntVect& ng_src = guard_cells.ng_FieldGather;
             // Copy Efield_aux to the dE MultiFabs, using up to ng_src (=ng_FieldGather) guard
             // cells from Efield_aux and filling up to ng (=nGrow) guard cells in the dE MultiFabs
-            ablastr::utils::communication::ParallelCopy(dEx, *Efield_aux[lev - 1][0], 0, 0,
-                                                        Efield_aux[lev - 1][0]->nComp(), ng_src, ng,
-                                                        WarpX::do_single_precision_comms,
-                                                        crse_period);
-            ablastr::utils::communication::ParallelCopy(dEy, *Efield_aux[lev - 1][1], 0, 0,
-                                                        Efield_aux[lev - 1][1]->nComp(), ng_src, ng,
-                                                        WarpX::do_single_precision_comms,
-                                                        crse_period);
-            ablastr::utils::communication::ParallelCopy(dEz, *Efield_aux[lev - 1][2], 0, 0,
-                                                        Efield_aux[lev - 1][2]->nComp(), ng_src, ng,
-                                                        WarpX::do_single_precision_comms,
-                                                        crse_period);
-
-            if (Efield_cax[lev][0])
-            {
-                MultiFab::Copy(*Efield_cax[lev][0], dEx, 0, 0, Efield_cax[lev][0]->nComp(), ng);
-                MultiFab::Copy(*Efield_cax[lev][1], dEy, 0, 0, Efield_cax[lev][1]->nComp(), ng);
-                MultiFab::Copy(*Efield_cax[lev][2], dEz, 0, 0, Efield_cax[lev][2]->nComp(), ng);
+            // (the communication plans of ParallelCopy are cached by AMReX between steps)
+            for (int i = 0; i < 3; ++i) {
+                ablastr::utils::communication::ParallelCopy(*dE[i], *Efield_aux[lev - 1][i], 0, 0,
+                                                            Efield_aux[lev - 1][i]->nComp(), ng_src, ng,
+                                                            WarpX::do_single_precision_comms,
+                                                            crse_period);
             }
-            MultiFab::Subtract(dEx, *Efield_cp[lev][0], 0, 0, Efield_cp[lev][0]->nComp(), ng);
-            MultiFab::Subtract(dEy, *Efield_cp[lev][1], 0, 0, Efield_cp[lev][1]->nComp(), ng);
-            MultiFab::Subtract(dEz, *Efield_cp[lev][2], 0, 0, Efield_cp[lev][2]->nComp(), ng);
 
             const amrex::IntVect& refinement_ratio = refRatio(lev-1);
 
@@ -423,22 +423,25 @@ WarpX::UpdateAuxilaryDataSameType ()
                 Array4<Real const> const& ex_fp = Efield_fp[lev][0]->const_array(mfi);
                 Array4<Real const> const& ey_fp = Efield_fp[lev][1]->const_array(mfi);
                 Array4<Real const> const& ez_fp = Efield_fp[lev][2]->const_array(mfi);
-                Array4<Real const> const& ex_c = dEx.const_array(mfi);
-                Array4<Real const> const& ey_c = dEy.const_array(mfi);
-                Array4<Real const> const& ez_c = dEz.const_array(mfi);
+                Array4<Real const> const& ex_c = dE[0]->const_array(mfi);
+                Array4<Real const> const& ey_c = dE[1]->const_array(mfi);
+                Array4<Real const> const& ez_c = dE[2]->const_array(mfi);
+                Array4<Real const> const& ex_cp = Efield_cp[lev][0]->const_array(mfi);
+                Array4<Real const> const& ey_cp = Efield_cp[lev][1]->const_array(mfi);
+                Array4<Real const> const& ez_cp = Efield_cp[lev][2]->const_array(mfi);
 
                 amrex::ParallelFor(Box(ex_aux), Box(ey_aux), Box(ez_aux),
                 [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
                 {
-                    warpx_interp(j, k, l, ex_aux, ex_fp, ex_c, Ex_stag, refinement_ratio);
+                    warpx_interp(j, k, l, ex_aux, ex_fp, ex_c, ex_cp, Ex_stag, refinement_ratio);
                 },
                 [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
                 {
-                    warpx_interp(j, k, l, ey_aux, ey_fp, ey_c, Ey_stag, refinement_ratio);
+                    warpx_interp(j, k, l, ey_aux, ey_fp, ey_c, ey_cp, Ey_stag, refinement_ratio);
                 },
                 [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
                 {
-                    warpx_interp(j, k, l, ez_aux, ez_fp, ez_c, Ez_stag, refinement_ratio);
+                    warpx_interp(j, k, l, ez_aux, ez_fp, ez_c, ez_cp, Ez_stag, refinement_ratio);
                 });
             }
         }
@@ -492,6 +495,27 @@ void WarpX::UpdateCurrentNodalToStag (amrex::MultiFab& dst, amrex::MultiFab cons
     }
 }
 
+void
+WarpX::StartFillBoundary (amrex::MultiFab& mf, const amrex::IntVect ng,
+                          const amrex::Periodicity& period, std::optional<bool> nodal_sync)
+{
+    if (overlap_comm_compute) {
+        ablastr::utils::communication::FillBoundary_nowait(mf, ng, WarpX::do_single_precision_comms, period, nodal_sync);
+        m_fill_boundary_in_flight.emplace_back(&mf, nodal_sync);
+    } else {
+        ablastr::utils::communication::FillBoundary(mf, ng, WarpX::do_single_precision_comms, period, nodal_sync);
+    }
+}
+
+void
+WarpX::FinishFillBoundary ()
+{
+    for (auto& [mf, nodal_sync] : m_fill_boundary_in_flight) {
+        ablastr::utils::communication::FillBoundary_finish(*mf, WarpX::do_single_precision_comms, nodal_sync);
+    }
+    m_fill_boundary_in_flight.clear();
+}
+
 void
 WarpX::FillBoundaryB (IntVect ng, std::optional<bool> nodal_sync)
 {
@@ -557,6 +581,8 @@ WarpX::FillBoundaryE (int lev, IntVect ng, std::optional<bool> nodal_sync)
 void
 WarpX::FillBoundaryE (const int lev, const PatchType patch_type, const amrex::IntVect ng, std::optional<bool> nodal_sync)
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::FieldCommunication);
+    const ablastr::utils::communication::ScopedCommSite comm_site("FillBoundaryE");
     std::array<amrex::MultiFab*,3> mf;
     amrex::Periodicity period;
 
@@ -571,16 +597,42 @@ WarpX::FillBoundaryE (const int lev, const PatchType patch_type, const amrex::In
         period = Geom(lev-1).periodicity();
     }
 
+    // With FDTD temporal blocking, skip the exchange while enough guard cells are up-to-date,
+    // and otherwise exchange all of them at once
+    amrex::IntVect ng_fill = ng;
+    if (fdtd_temporal_blocking > 1 && patch_type == PatchType::fine)
+    {
+        if (ng.allLE(m_fdtd_valid_guards_E)) { return; }
+        ng_fill = guard_cells.ng_alloc_EB;
+        m_fdtd_valid_guards_E = ng_fill;
+    }
+
     // Exchange data between valid domain and PML
+    if (do_pml && pml[lev] && pml[lev]->ok())
+    {
+        const std::array<amrex::MultiFab*,3> mf_pml =
+            (patch_type == PatchType::fine) ? pml[lev]->GetE_fp() : pml[lev]->GetE_cp();
+
+        pml[lev]->Exchange(mf_pml, mf, patch_type, do_pml_in_domain);
+    }
+
+    // Fill guard cells in valid domain
+    // (with overlap_comm_compute, the communication is in flight while the PML is filled)
+    for (int i = 0; i < 3; ++i)
+    {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            ng_fill.allLE(mf[i]->nGrowVect()),
+            "Error: in FillBoundaryE, requested more guard cells than allocated");
+
+        const amrex::IntVect nghost = (safe_guard_cells) ? mf[i]->nGrowVect() : ng_fill;
+        StartFillBoundary(*mf[i], nghost, period, nodal_sync);
+    }
+
     // Fill guard cells in PML
     if (do_pml)
     {
         if (pml[lev] && pml[lev]->ok())
         {
-            const std::array<amrex::MultiFab*,3> mf_pml =
-                (patch_type == PatchType::fine) ? pml[lev]->GetE_fp() : pml[lev]->GetE_cp();
-
-            pml[lev]->Exchange(mf_pml, mf, patch_type, do_pml_in_domain);
             pml[lev]->FillBoundaryE(patch_type, nodal_sync);
         }
 
@@ -592,16 +644,7 @@ WarpX::FillBoundaryE (const int lev, const PatchType patch_type, const amrex::In
 #endif
     }
 
-    // Fill guard cells in valid domain
-    for (int i = 0; i < 3; ++i)
-    {
-        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-            ng.allLE(mf[i]->nGrowVect()),
-            "Error: in FillBoundaryE, requested more guard cells than allocated");
-
-        const amrex::IntVect nghost = (safe_guard_cells) ? mf[i]->nGrowVect() : ng;
-        ablastr::utils::communication::FillBoundary(*mf[i], nghost, WarpX::do_single_precision_comms, period, nodal_sync);
-    }
+    if (!m_defer_fill_boundary_finish) { FinishFillBoundary(); }
 }
 
 void
@@ -614,6 +657,8 @@ WarpX::FillBoundaryB (int lev, IntVect ng, std::optional<bool> nodal_sync)
 void
 WarpX::FillBoundaryB (const int lev, const PatchType patch_type, const amrex::IntVect ng, std::optional<bool> nodal_sync)
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::FieldCommunication);
+    const ablastr::utils::communication::ScopedCommSite comm_site("FillBoundaryB");
     std::array<amrex::MultiFab*,3> mf;
     amrex::Periodicity period;
 
@@ -628,16 +673,42 @@ WarpX::FillBoundaryB (const int lev, const PatchType patch_type, const amrex::In
         period = Geom(lev-1).periodicity();
     }
 
+    // With FDTD temporal blocking, skip the exchange while enough guard cells are up-to-date,
+    // and otherwise exchange all of them at once
+    amrex::IntVect ng_fill = ng;
+    if (fdtd_temporal_blocking > 1 && patch_type == PatchType::fine)
+    {
+        if (ng.allLE(m_fdtd_valid_guards_B)) { return; }
+        ng_fill = guard_cells.ng_alloc_EB;
+        m_fdtd_valid_guards_B = ng_fill;
+    }
+
     // Exchange data between valid domain and PML
+    if (do_pml && pml[lev] && pml[lev]->ok())
+    {
+        const std::array<amrex::MultiFab*,3> mf_pml =
+            (patch_type == PatchType::fine) ? pml[lev]->GetB_fp() : pml[lev]->GetB_cp();
+
+        pml[lev]->Exchange(mf_pml, mf, patch_type, do_pml_in_domain);
+    }
+
+    // Fill guard cells in valid domain
+    // (with overlap_comm_compute, the communication is in flight while the PML is filled)
+    for (int i = 0; i < 3; ++i)
+    {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            ng_fill.allLE(mf[i]->nGrowVect()),
+            "Error: in FillBoundaryB, requested more guard cells than allocated");
+
+        const amrex::IntVect nghost = (safe_guard_cells) ? mf[i]->nGrowVect() : ng_fill;
+        StartFillBoundary(*mf[i], nghost, period, nodal_sync);
+    }
+
     // Fill guard cells in PML
     if (do_pml)
     {
         if (pml[lev] && pml[lev]->ok())
         {
-            const std::array<amrex::MultiFab*,3> mf_pml =
-                (patch_type == PatchType::fine) ? pml[lev]->GetB_fp() : pml[lev]->GetB_cp();
-
-            pml[lev]->Exchange(mf_pml, mf, patch_type, do_pml_in_domain);
             pml[lev]->FillBoundaryB(patch_type, nodal_sync);
         }
 
@@ -649,16 +720,7 @@ WarpX::FillBoundaryB (const int lev, const PatchType patch_type, const amrex::In
 #endif
     }
 
-    // Fill guard cells in valid domain
-    for (int i = 0; i < 3; ++i)
-    {
-        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-            ng.allLE(mf[i]->nGrowVect()),
-            "Error: in FillBoundaryB, requested more guard cells than allocated");
-
-        const amrex::IntVect nghost = (safe_guard_cells) ? mf[i]->nGrowVect() : ng;
-        ablastr::utils::communication::FillBoundary(*mf[i], nghost, WarpX::do_single_precision_comms, period, nodal_sync);
-    }
+    if (!m_defer_fill_boundary_finish) { FinishFillBoundary(); }
 }
 
 void
@@ -671,6 +733,7 @@ WarpX::FillBoundaryE_avg(int lev, IntVect ng)
 void
 WarpX::FillBoundaryE_avg (int lev, PatchType patch_type, IntVect ng)
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::FieldCommunication);
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev]->ok())
@@ -725,6 +788,7 @@ WarpX::FillBoundaryB_avg (int lev, IntVect ng)
 void
 WarpX::FillBoundaryB_avg (int lev, PatchType patch_type, IntVect ng)
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::FieldCommunication);
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev]->ok())
@@ -776,35 +840,38 @@ WarpX::FillBoundaryF (int lev, IntVect ng, std::optional<bool> nodal_sync)
 void
 WarpX::FillBoundaryF (int lev, PatchType patch_type, IntVect ng, std::optional<bool> nodal_sync)
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::FieldCommunication);
     if (patch_type == PatchType::fine)
     {
-        if (do_pml && pml[lev] && pml[lev]->ok())
-        {
-            if (F_fp[lev]) { pml[lev]->ExchangeF(patch_type, F_fp[lev].get(), do_pml_in_domain); }
-            pml[lev]->FillBoundaryF(patch_type, nodal_sync);
-        }
+        const bool has_pml = do_pml && pml[lev] && pml[lev]->ok();
+        if (has_pml && F_fp[lev]) { pml[lev]->ExchangeF(patch_type, F_fp[lev].get(), do_pml_in_domain); }
 
         if (F_fp[lev])
         {
             const amrex::Periodicity& period = Geom(lev).periodicity();
             const amrex::IntVect& nghost = (safe_guard_cells) ? F_fp[lev]->nGrowVect() : ng;
-            ablastr::utils::communication::FillBoundary(*F_fp[lev], nghost, WarpX::do_single_precision_comms, period, nodal_sync);
+            StartFillBoundary(*F_fp[lev], nghost, period, nodal_sync);
         }
+
+        if (has_pml) { pml[lev]->FillBoundaryF(patch_type, nodal_sync); }
+
+        if (!m_defer_fill_boundary_finish) { FinishFillBoundary(); }
     }
     else if (patch_type == PatchType::coarse)
     {
-        if (do_pml && pml[lev] && pml[lev]->ok())
-        {
-            if (F_cp[lev]) { pml[lev]->ExchangeF(patch_type, F_cp[lev].get(), do_pml_in_domain); }
-            pml[lev]->FillBoundaryF(patch_type, nodal_sync);
-        }
+        const bool has_pml = do_pml && pml[lev] && pml[lev]->ok();
+        if (has_pml && F_cp[lev]) { pml[lev]->ExchangeF(patch_type, F_cp[lev].get(), do_pml_in_domain); }
 
         if (F_cp[lev])
         {
             const amrex::Periodicity& period = Geom(lev-1).periodicity();
             const amrex::IntVect& nghost = (safe_guard_cells) ? F_cp[lev]->nGrowVect() : ng;
-            ablastr::utils::communication::FillBoundary(*F_cp[lev], nghost, WarpX::do_single_precision_comms, period, nodal_sync);
+            StartFillBoundary(*F_cp[lev], nghost, period, nodal_sync);
         }
+
+        if (has_pml) { pml[lev]->FillBoundaryF(patch_type, nodal_sync); }
+
+        if (!m_defer_fill_boundary_finish) { FinishFillBoundary(); }
     }
 }
 
@@ -820,35 +887,38 @@ void WarpX::FillBoundaryG (int lev, IntVect ng, std::optional<bool> nodal_sync)
 
 void WarpX::FillBoundaryG (int lev, PatchType patch_type, IntVect ng, std::optional<bool> nodal_sync)
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::FieldCommunication);
     if (patch_type == PatchType::fine)
     {
-        if (do_pml && pml[lev] && pml[lev]->ok())
-        {
-            if (G_fp[lev]) { pml[lev]->ExchangeG(patch_type, G_fp[lev].get(), do_pml_in_domain); }
-            pml[lev]->FillBoundaryG(patch_type, nodal_sync);
-        }
+        const bool has_pml = do_pml && pml[lev] && pml[lev]->ok();
+        if (has_pml && G_fp[lev]) { pml[lev]->ExchangeG(patch_type, G_fp[lev].get(), do_pml_in_domain); }
 
         if (G_fp[lev])
         {
             const amrex::Periodicity& period = Geom(lev).periodicity();
             const amrex::IntVect& nghost = (safe_guard_cells) ? G_fp[lev]->nGrowVect() : ng;
-            ablastr::utils::communication::FillBoundary(*G_fp[lev], nghost, WarpX::do_single_precision_comms, period, nodal_sync);
+            StartFillBoundary(*G_fp[lev], nghost, period, nodal_sync);
         }
+
+        if (has_pml) { pml[lev]->FillBoundaryG(patch_type, nodal_sync); }
+
+        if (!m_defer_fill_boundary_finish) { FinishFillBoundary(); }
     }
     else if (patch_type == PatchType::coarse)
     {
-        if (do_pml && pml[lev] && pml[lev]->ok())
-        {
-            if (G_cp[lev]) { pml[lev]->ExchangeG(patch_type, G_cp[lev].get(), do_pml_in_domain); }
-            pml[lev]->FillBoundaryG(patch_type, nodal_sync);
-        }
+        const bool has_pml = do_pml && pml[lev] && pml[lev]->ok();
+        if (has_pml && G_cp[lev]) { pml[lev]->ExchangeG(patch_type, G_cp[lev].get(), do_pml_in_domain); }
 
         if (G_cp[lev])
         {
             const amrex::Periodicity& period = Geom(lev-1).periodicity();
             const amrex::IntVect& nghost = (safe_guard_cells) ? G_cp[lev]->nGrowVect() : ng;
-            ablastr::utils::communication::FillBoundary(*G_cp[lev], nghost, WarpX::do_single_precision_comms, period, nodal_sync);
+            StartFillBoundary(*G_cp[lev], nghost, period, nodal_sync);
         }
+
+        if (has_pml) { pml[lev]->FillBoundaryG(patch_type, nodal_sync); }
+
+        if (!m_defer_fill_boundary_finish) { FinishFillBoundary(); }
     }
 }
 
@@ -864,6 +934,7 @@ WarpX::FillBoundaryAux (IntVect ng)
 void
 WarpX::FillBoundaryAux (int lev, IntVect ng)
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::FieldCommunication);
     const amrex::Periodicity& period = Geom(lev).periodicity();
     ablastr::utils::communication::FillBoundary(*Efield_aux[lev][0], ng, WarpX::do_single_precision_comms, period);
     ablastr::utils::communication::FillBoundary(*Efield_aux[lev][1], ng, WarpX::do_single_precision_comms, period);
@@ -880,6 +951,14 @@ WarpX::SyncCurrent (
     const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& J_buffer)
 {
     WARPX_PROFILE("WarpX::SyncCurrent()");
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::SourceCommunication);
+
+    // With warpx.overlap_sum_boundary_J, the filter and the sum of the guard cells
+    // were started during the deposition (there is a single level in this case)
+    if (m_sum_boundary_J_in_flight && &J_fp == &current_fp) {
+        FinishSumBoundaryJ(0);
+        return;
+    }
 
     // If warpx.do_current_centering = 1, center currents from nodal grid to staggered grid
     if (do_current_centering)
@@ -1047,6 +1126,7 @@ WarpX::SyncRho (
     const amrex::Vector<std::unique_ptr<amrex::MultiFab>>& charge_buffer)
 {
     WARPX_PROFILE("WarpX::SyncRho()");
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::SourceCommunication);
 
     if (!charge_fp[0]) { return; }
     const int ncomp = charge_fp[0]->nComp();
@@ -1123,10 +1203,6 @@ void WarpX::RestrictCurrentFromFineToCoarsePatch (
     const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& J_cp,
     const int lev)
 {
-    J_cp[lev][0]->setVal(0.0);
-    J_cp[lev][1]->setVal(0.0);
-    J_cp[lev][2]->setVal(0.0);
-
     const IntVect& refinement_ratio = refRatio(lev-1);
 
     std::array<const MultiFab*,3> fine { J_fp[lev][0].get(),
@@ -1135,9 +1211,48 @@ void WarpX::RestrictCurrentFromFineToCoarsePatch (
     std::array<      MultiFab*,3> crse { J_cp[lev][0].get(),
                                          J_cp[lev][1].get(),
                                          J_cp[lev][2].get() };
-    ablastr::coarsen::average::Coarsen(*crse[0], *fine[0], refinement_ratio );
-    ablastr::coarsen::average::Coarsen(*crse[1], *fine[1], refinement_ratio );
-    ablastr::coarsen::average::Coarsen(*crse[2], *fine[2], refinement_ratio );
+    // The three components are coarsened in one kernel, which also zeroes
+    // the guard cells of J_cp that are not covered by the fine patch
+    ablastr::coarsen::average::Coarsen(crse, fine, refinement_ratio);
+}
+
+void WarpX::AddRestrictedFineCurrentToCoarsePatch (const int lev, const amrex::Real weight)
+{
+    const amrex::Periodicity& period = Geom(lev).periodicity();
+    const IntVect& refinement_ratio = refRatio(lev-1);
+
+    for (int idim = 0; idim < 3; ++idim)
+    {
+        const MultiFab& J_fp = *current_fp[lev][idim];
+        MultiFab& J_cp = *current_cp[lev][idim];
+        const int ncomp = J_fp.nComp();
+
+        // Current deposited on the coarse patch and buffers of lev+1 (unfiltered
+        // and uncommunicated), on the fine patch of lev
+        MultiFab fine_lev_cp(J_fp.boxArray(), J_fp.DistributionMap(), ncomp, J_fp.nGrowVect());
+        fine_lev_cp.setVal(0.0);
+        fine_lev_cp.ParallelAdd(*current_cp[lev+1][idim], 0, 0, ncomp,
+                                current_cp[lev+1][idim]->nGrowVect(), IntVect(0), period);
+        if (current_buf[lev+1][idim]) {
+            fine_lev_cp.ParallelAdd(*current_buf[lev+1][idim], 0, 0, ncomp,
+                                    current_buf[lev+1][idim]->nGrowVect(), IntVect(0), period);
+        }
+        // Keep a single copy of the points shared by several boxes, so that
+        // the coarse patch of lev is summed over the boxes as a deposited current
+        auto owner_mask = amrex::OwnerMask(fine_lev_cp, period);
+        auto const& mma = owner_mask->const_arrays();
+        auto const& fma = fine_lev_cp.arrays();
+        amrex::ParallelFor(fine_lev_cp, IntVect(0), ncomp,
+        [=] AMREX_GPU_DEVICE (int bno, int i, int j, int k, int n)
+        {
+            if (!mma[bno](i,j,k)) { fma[bno](i,j,k,n) = 0.0_rt; }
+        });
+
+        MultiFab crse(J_cp.boxArray(), J_cp.DistributionMap(), ncomp, J_cp.nGrowVect());
+        crse.setVal(0.0);
+        ablastr::coarsen::average::Coarsen(crse, fine_lev_cp, refinement_ratio);
+        MultiFab::Saxpy(J_cp, weight, crse, 0, 0, ncomp, J_cp.nGrowVect());
+    }
 }
 
 void WarpX::ApplyFilterJ (
@@ -1145,36 +1260,21 @@ void WarpX::ApplyFilterJ (
     const int lev,
     const int idim)
 {
-    amrex::MultiFab& J = *current[lev][idim];
-
-    const int ncomp = J.nComp();
-    const amrex::IntVect ngrow = J.nGrowVect();
-    amrex::MultiFab Jf(J.boxArray(), J.DistributionMap(), ncomp, ngrow);
-    bilinear_filter.ApplyStencil(Jf, J, lev);
-
-    const int srccomp = 0;
-    const int dstcomp = 0;
-    amrex::MultiFab::Copy(J, Jf, srccomp, dstcomp, ncomp, ngrow);
+    std::array<amrex::MultiFab*, 3> J = {nullptr, nullptr, nullptr};
+    J[idim] = current[lev][idim].get();
+    bilinear_filter.ApplyStencil(J, lev);
 }
 
 void WarpX::ApplyFilterJ (
     const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& current,
     const int lev)
 {
-    for (int idim=0; idim<3; ++idim)
-    {
-        ApplyFilterJ(current, lev, idim);
-    }
+    // All the components are filtered together
+    bilinear_filter.ApplyStencil({current[lev][0].get(), current[lev][1].get(), current[lev][2].get()}, lev);
 }
 
-void WarpX::SumBoundaryJ (
-    const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& current,
-    const int lev,
-    const int idim,
-    const amrex::Periodicity& period)
+amrex::IntVect WarpX::SumBoundaryJGuardCells (const amrex::MultiFab& J) const
 {
-    amrex::MultiFab& J = *current[lev][idim];
-
     const amrex::IntVect ng = J.nGrowVect();
     amrex::IntVect ng_depos_J = get_ng_depos_J();
 
@@ -1199,10 +1299,104 @@ void WarpX::SumBoundaryJ (
 
     ng_depos_J.min(ng);
 
-    const amrex::IntVect src_ngrow = ng_depos_J;
+    return ng_depos_J;
+}
+
+amrex::IntVect WarpX::SumBoundaryJUpdatedGuardCells (const amrex::MultiFab& J) const
+{
+    const amrex::IntVect ng = J.nGrowVect();
+
+    // The spectral solvers (local FFTs over the grown boxes), the PMLs, the mesh refinement
+    // (restriction to the coarse patch), the implicit and hybrid solvers, the temporal
+    // blocking of the FDTD push (E pushed in the guard cells) and the PEC and reflecting
+    // boundaries (guard cells outside the domain folded back in) read J in the guard cells
+    // after the sum
+    if (!tight_current_guard_sum ||
+        electromagnetic_solver_id == ElectromagneticSolverAlgo::None ||
+        electromagnetic_solver_id == ElectromagneticSolverAlgo::PSATD ||
+        electromagnetic_solver_id == ElectromagneticSolverAlgo::HybridPIC ||
+        evolve_scheme != EvolveScheme::Explicit ||
+        fdtd_temporal_blocking > 1 || isAnyJfieldBoundary() ||
+        do_pml || finestLevel() > 0)
+    {
+        return ng;
+    }
+
+    // The finite-difference push only reads J in the valid cells, and the centering of
+    // the nodal current reads current_centering_no<x,y,z>/2 guard cells
+    amrex::IntVect ng_updated = amrex::IntVect::TheZeroVector();
+    if (do_current_centering)
+    {
+#if   defined(WARPX_DIM_1D_Z)
+        ng_updated[0] = WarpX::current_centering_noz / 2;
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        ng_updated[0] = WarpX::current_centering_nox / 2;
+        ng_updated[1] = WarpX::current_centering_noz / 2;
+#elif defined(WARPX_DIM_3D)
+        ng_updated[0] = WarpX::current_centering_nox / 2;
+        ng_updated[1] = WarpX::current_centering_noy / 2;
+        ng_updated[2] = WarpX::current_centering_noz / 2;
+#endif
+    }
+
+    ng_updated.min(ng);
+
+    return ng_updated;
+}
+
+void WarpX::SumBoundaryJ (
+    const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& current,
+    const int lev,
+    const int idim,
+    const amrex::Periodicity& period)
+{
+    const ablastr::utils::communication::ScopedCommSite comm_site("SumBoundaryJ");
+    amrex::MultiFab& J = *current[lev][idim];
+
+    const amrex::IntVect src_ngrow = SumBoundaryJGuardCells(J);
+    const amrex::IntVect dst_ngrow = SumBoundaryJUpdatedGuardCells(J);
     const int icomp = 0;
     const int ncomp = J.nComp();
-    WarpXSumGuardCells(J, period, src_ngrow, icomp, ncomp);
+    WarpXSumGuardCells(J, period, src_ngrow, dst_ngrow, icomp, ncomp);
+}
+
+void WarpX::StartSumBoundaryJ (const int lev)
+{
+    WARPX_PROFILE("WarpX::StartSumBoundaryJ()");
+    const ablastr::utils::communication::ScopedCommSite comm_site("SumBoundaryJ");
+
+    // Since the filter and the sum of the guard cells are linear, they can be applied
+    // separately to the current of the last species and to that of the other species
+    if (use_filter) { ApplyFilterJ(current_fp, lev); }
+    for (int idim = 0; idim < 3; ++idim) {
+        amrex::MultiFab& J = *current_fp[lev][idim];
+        ablastr::utils::communication::SumBoundary_nowait(J, 0, J.nComp(),
+            SumBoundaryJGuardCells(J), SumBoundaryJUpdatedGuardCells(J), WarpX::do_single_precision_comms,
+            Geom(lev).periodicity());
+    }
+    m_sum_boundary_J_in_flight = true;
+}
+
+void WarpX::FinishSumBoundaryJ (const int lev)
+{
+    WARPX_PROFILE("WarpX::FinishSumBoundaryJ()");
+    const ablastr::utils::communication::ScopedCommSite comm_site("SumBoundaryJ");
+
+    if (use_filter) {
+        bilinear_filter.ApplyStencil({m_current_fp_last_species[0].get(),
+            m_current_fp_last_species[1].get(), m_current_fp_last_species[2].get()}, lev);
+    }
+    for (int idim = 0; idim < 3; ++idim) {
+        amrex::MultiFab& J_last = *m_current_fp_last_species[idim];
+        WarpXSumGuardCells(J_last, Geom(lev).periodicity(), SumBoundaryJGuardCells(J_last),
+                           SumBoundaryJUpdatedGuardCells(J_last), 0, J_last.nComp());
+    }
+    for (int idim = 0; idim < 3; ++idim) {
+        amrex::MultiFab& J = *current_fp[lev][idim];
+        ablastr::utils::communication::SumBoundary_finish(J, WarpX::do_single_precision_comms);
+        amrex::MultiFab::Add(J, *m_current_fp_last_species[idim], 0, 0, J.nComp(), J.nGrowVect());
+    }
+    m_sum_boundary_J_in_flight = false;
 }
 
 void WarpX::SumBoundaryJ (
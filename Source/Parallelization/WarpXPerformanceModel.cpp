@@ -0,0 +1,190 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "WarpX.H"
+
+#include "Initialization/InjectorDensity.H"
+#include "Initialization/InjectorPosition.H"
+#include "Initialization/PlasmaInjector.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/Parser/ParserUtils.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXProfilerWrapper.H"
+
+#include <ablastr/warn_manager/WarnManager.H>
+
+#include <AMReX_BaseFab.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Reduce.H>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace amrex::literals;
+
+namespace
+{
+    /** Number of macroparticles that a plasma injector would create in a box of level 0,
+     *  i.e. the number of particles per cell times the number of cells whose center is
+     *  inside the plasma region, where the density is above the minimum density */
+    amrex::Long EstimateNumParticles (PlasmaInjector const& plasma_injector,
+                                      amrex::Box const& box, amrex::Geometry const& geom)
+    {
+        InjectorPosition const* inj_pos = plasma_injector.getInjectorPosition();
+        InjectorDensity const* inj_rho = plasma_injector.getInjectorDensity();
+        const amrex::Real density_min = plasma_injector.density_min;
+        const auto num_ppc = static_cast<amrex::Long>(plasma_injector.num_particles_per_cell);
+        const auto problo = geom.ProbLoArray();
+        const auto dx = geom.CellSizeArray();
+
+        amrex::ReduceOps<amrex::ReduceOpSum> reduce_op;
+        amrex::ReduceData<amrex::Long> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        reduce_op.eval(box, reduce_data,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+            {
+                const amrex::IntVect iv(AMREX_D_DECL(i, j, k));
+                amrex::Real c[AMREX_SPACEDIM];
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    c[idim] = problo[idim] + (iv[idim] + 0.5_rt)*dx[idim];
+                }
+#if defined(WARPX_DIM_3D)
+                const amrex::Real x = c[0], y = c[1], z = c[2];
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                const amrex::Real x = c[0], y = 0._rt, z = c[1];
+                amrex::ignore_unused(k);
+#else
+                const amrex::Real x = 0._rt, y = 0._rt, z = c[0];
+                amrex::ignore_unused(j, k);
+#endif
+                const bool inside = inj_pos->insideBounds(x, y, z) &&
+                    inj_rho->getDensity(x, y, z) > density_min;
+                return {inside ? num_ppc : amrex::Long(0)};
+            });
+        return amrex::get<0>(reduce_data.value(reduce_op));
+    }
+}
+
+void
+WarpX::PredictPerformance ()
+{
+    WARPX_PROFILE("WarpX::PredictPerformance()");
+
+    // Times per macroparticle and per cell of a step. By default, the time per cell is
+    // deduced from the time per particle with the weights of the heuristic costs.
+    const amrex::ParmParse pp_warpx("warpx");
+#ifdef AMREX_USE_GPU
+    amrex::Real particle_time = 2.e-9_rt;
+#else
+    amrex::Real particle_time = 1.e-7_rt;
+#endif
+    utils::parser::queryWithParser(pp_warpx, "dry_run_particle_time", particle_time);
+    amrex::Real cell_time = particle_time * ((costs_heuristic_particles_wt > 0) ?
+        costs_heuristic_cells_wt/costs_heuristic_particles_wt : 0.1_rt/0.9_rt);
+    utils::parser::queryWithParser(pp_warpx, "dry_run_cell_time", cell_time);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(particle_time >= 0 && cell_time >= 0,
+        "warpx.dry_run_particle_time and warpx.dry_run_cell_time must be >= 0");
+
+    // Cells of all the levels owned by this rank
+    amrex::Long ncells = 0;
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        for (amrex::MFIter mfi(boxArray(lev), DistributionMap(lev)); mfi.isValid(); ++mfi) {
+            ncells += mfi.validbox().numPts();
+        }
+    }
+
+    // Macroparticles created on level 0 by the plasma injectors of each species
+    amrex::Long nparticles = 0;
+    amrex::Long particle_bytes = 0;
+    bool not_estimated = false;
+    for (int i_s = 0; i_s < mypc->nSpecies(); ++i_s) {
+        auto& pc = mypc->GetParticleContainer(i_s);
+        const auto bytes_per_particle = static_cast<amrex::Long>(
+            pc.NumRealComps()*sizeof(amrex::ParticleReal) + pc.NumIntComps()*sizeof(int) +
+            sizeof(std::uint64_t));
+        for (int i_inj = 0; PlasmaInjector* plasma_injector = pc.GetPlasmaInjector(i_inj); ++i_inj) {
+            if (plasma_injector->external_file || plasma_injector->add_single_particle ||
+                plasma_injector->add_multiple_particles || plasma_injector->gaussian_beam) {
+                not_estimated = true;
+                continue;
+            }
+            if (!plasma_injector->doInjection()) { continue; }
+            amrex::Long n = 0;
+            for (amrex::MFIter mfi(boxArray(0), DistributionMap(0)); mfi.isValid(); ++mfi) {
+                n += EstimateNumParticles(*plasma_injector, mfi.validbox(), Geom(0));
+            }
+            nparticles += n;
+            particle_bytes += n*bytes_per_particle;
+        }
+    }
+    if (not_estimated) {
+        ablastr::warn_manager::WMRecordWarning("Performance",
+            "warpx.dry_run_performance: only the particles injected in the volume with "
+            "NUniformPerCell or NRandomPerCell are accounted for", ablastr::warn_manager::WarnPriority::low);
+    }
+
+    // Memory of the fields and (on GPU) of all the device memory in use on this rank
+    const amrex::Long field_bytes = amrex::TotalBytesAllocatedInFabs();
+#ifdef AMREX_USE_GPU
+    const auto device_bytes = static_cast<amrex::Long>(amrex::Gpu::Device::totalGlobalMem()) -
+                              static_cast<amrex::Long>(amrex::Gpu::Device::freeMemAvailable());
+#else
+    const amrex::Long device_bytes = 0;
+#endif
+
+    const amrex::Real step_time = static_cast<amrex::Real>(nparticles)*particle_time +
+                                  static_cast<amrex::Real>(ncells)*cell_time;
+
+    // Statistics over the MPI ranks
+    std::vector<amrex::Real> sums = {static_cast<amrex::Real>(ncells),
+                                     static_cast<amrex::Real>(nparticles), step_time};
+    std::vector<amrex::Real> maxs = {static_cast<amrex::Real>(ncells),
+                                     static_cast<amrex::Real>(nparticles), step_time,
+                                     static_cast<amrex::Real>(field_bytes),
+                                     static_cast<amrex::Real>(particle_bytes),
+                                     static_cast<amrex::Real>(field_bytes + particle_bytes),
+                                     static_cast<amrex::Real>(device_bytes + particle_bytes)};
+    amrex::ParallelDescriptor::ReduceRealSum(sums.data(), static_cast<int>(sums.size()));
+    amrex::ParallelDescriptor::ReduceRealMax(maxs.data(), static_cast<int>(maxs.size()));
+
+    const auto nprocs = static_cast<amrex::Real>(amrex::ParallelDescriptor::NProcs());
+    const amrex::Real avg_step_time = sums[2]/nprocs;
+    const amrex::Real efficiency = (maxs[2] > 0) ? avg_step_time/maxs[2] : 1._rt;
+
+    amrex::Print() << "\nPerformance estimate (warpx.dry_run_performance), on "
+                   << amrex::ParallelDescriptor::NProcs() << " MPI ranks:\n"
+                   << "  Time per macroparticle and step : " << particle_time << " s\n"
+                   << "  Time per cell and step          : " << cell_time << " s\n"
+                   << "  Cells                           : " << sums[0]
+                   << " (max per rank: " << maxs[0] << ")\n"
+                   << "  Macroparticles (estimated)      : " << sums[1]
+                   << " (max per rank: " << maxs[1] << ")\n"
+                   << "  Step time                       : " << maxs[2]
+                   << " s (average over the ranks: " << avg_step_time << " s)\n"
+                   << "  Load balance efficiency         : " << efficiency << "\n"
+                   << "  Field memory per rank (max)     : " << maxs[3] << " B\n"
+                   << "  Particle memory per rank (max)  : " << maxs[4] << " B\n"
+                   << "  Total memory per rank (max)     : " << maxs[5] << " B\n";
+#ifdef AMREX_USE_GPU
+    amrex::Print() << "  Device memory per GPU (max)     : " << maxs[6]
+                   << " B (of " << amrex::Gpu::Device::totalGlobalMem() << " B)\n";
+#endif
+    if (max_step < std::numeric_limits<int>::max()) {
+        amrex::Print() << "  Time of the " << max_step << " steps : "
+                       << maxs[2]*static_cast<amrex::Real>(max_step) << " s\n";
+    }
+    amrex::Print() << "The communications, diagnostics and particle sorting are not modeled.\n\n";
+}
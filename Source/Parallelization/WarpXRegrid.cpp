@@ -15,11 +15,17 @@
 #include "Initialization/ExternalField.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
+#include "Particles/TileSizeAutotuner.H"
 #include "Particles/WarpXParticleContainer.H"
+#include "Utils/GpuGraph.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
 
+#include <ablastr/fields/PoissonSolver.H>
+#include <ablastr/parallelization/MPIInitHelpers.H>
+#include <ablastr/utils/Communication.H>
+
 #include <AMReX.H>
 #include <AMReX_BLassert.H>
 #include <AMReX_Box.H>
@@ -44,23 +50,382 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 using namespace amrex;
 
+namespace
+{
+    /** Costs of all the boxes, on all ranks */
+    std::vector<Real>
+    AllBoxCosts (const LayoutData<Real>& a_costs)
+    {
+        const auto nboxes = static_cast<int>(a_costs.size());
+        std::vector<Real> box_costs(nboxes, 0.0_rt);
+        for (const auto& i : a_costs.IndexArray()) {
+            box_costs[i] = a_costs[i];
+        }
+        ParallelDescriptor::ReduceRealSum(box_costs.data(), nboxes);
+        return box_costs;
+    }
+
+    /** Efficiency (mean cost per rank over maximum cost per rank) of a distribution mapping */
+    Real
+    MappingEfficiency (const std::vector<Real>& box_costs, const Vector<int>& pmap, int nprocs)
+    {
+        std::vector<Real> rank_costs(nprocs, 0.0_rt);
+        for (int i = 0; i < static_cast<int>(box_costs.size()); ++i) {
+            rank_costs[pmap[i]] += box_costs[i];
+        }
+        const Real max_cost = *std::max_element(rank_costs.begin(), rank_costs.end());
+        const Real mean_cost = std::accumulate(rank_costs.begin(), rank_costs.end(), 0.0_rt)/nprocs;
+        return (max_cost > 0.0_rt) ? mean_cost/max_cost : 1.0_rt;
+    }
+
+    /** Indices of the boxes, sorted along a Morton (Z-order) space-filling curve */
+    std::vector<int>
+    MortonOrder (const BoxArray& ba)
+    {
+        const auto nboxes = static_cast<int>(ba.size());
+        const IntVect lo = ba.minimalBox().smallEnd();
+        IntVect min_size = ba[0].size();
+        for (int i = 1; i < nboxes; ++i) {
+            min_size.min(ba[i].size());
+        }
+
+        std::vector<std::uint64_t> keys(nboxes, 0);
+        for (int i = 0; i < nboxes; ++i) {
+            const IntVect iv = (ba[i].smallEnd() - lo) / min_size;
+            for (int b = 0; b < std::min(31, 64/AMREX_SPACEDIM); ++b) {
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    keys[i] |= static_cast<std::uint64_t>((iv[d] >> b) & 1) << (b*AMREX_SPACEDIM + d);
+                }
+            }
+        }
+
+        std::vector<int> order(nboxes);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&keys] (int a, int b) { return keys[a] < keys[b]; });
+        return order;
+    }
+
+    /** \brief Split a sequence of boxes into contiguous chunks, whose costs are
+     * proportional to the given weights
+     *
+     * @param[in] order indices of the boxes of the sequence
+     * @param[in] box_costs costs of all the boxes
+     * @param[in] weights weight of each chunk
+     * @return the chunk of each box of the sequence
+     */
+    std::vector<int>
+    SplitSequence (const std::vector<int>& order, const std::vector<Real>& box_costs,
+                   const std::vector<Real>& weights)
+    {
+        Real total_cost = 0.0_rt;
+        for (const int i : order) { total_cost += box_costs[i]; }
+        // Without costs, balance the number of boxes
+        const bool use_costs = total_cost > 0.0_rt;
+        if (!use_costs) { total_cost = static_cast<Real>(order.size()); }
+        const Real total_weight = std::accumulate(weights.begin(), weights.end(), 0.0_rt);
+        const auto nchunks = static_cast<int>(weights.size());
+
+        std::vector<int> chunk_of(order.size(), 0);
+        int chunk = 0;
+        Real cost = 0.0_rt;
+        Real bound = total_cost*weights[0]/total_weight;
+        for (std::size_t n = 0; n < order.size(); ++n)
+        {
+            const Real c = use_costs ? box_costs[order[n]] : 1.0_rt;
+            // Go to the next chunk when most of the box is beyond the current one
+            while (chunk < nchunks-1 && cost + 0.5_rt*c > bound) {
+                ++chunk;
+                bound += total_cost*weights[chunk]/total_weight;
+            }
+            chunk_of[n] = chunk;
+            cost += c;
+        }
+        return chunk_of;
+    }
+
+    /** \brief Distribution mapping that keeps neighbor boxes on the same node
+     *
+     * The boxes, sorted along a space-filling curve, are first split in contiguous
+     * chunks across the nodes, with costs proportional to the number of ranks of
+     * each node, and then the chunk of each node is split across its ranks.
+     * The result is the same on all ranks.
+     *
+     * @param[in] a_costs costs of the boxes
+     * @param[in] dm current distribution mapping
+     * @param[in] node_of_rank node of each rank
+     * @param[out] currentEfficiency efficiency of the current distribution mapping
+     * @param[out] proposedEfficiency efficiency of the returned distribution mapping
+     */
+    DistributionMapping
+    MakeTopologyAwareDistributionMapping (const LayoutData<Real>& a_costs,
+                                          const DistributionMapping& dm,
+                                          const std::vector<int>& node_of_rank,
+                                          Real& currentEfficiency, Real& proposedEfficiency)
+    {
+        const std::vector<Real> box_costs = AllBoxCosts(a_costs);
+        const auto nprocs = static_cast<int>(node_of_rank.size());
+        const int nnodes = *std::max_element(node_of_rank.begin(), node_of_rank.end()) + 1;
+
+        std::vector<std::vector<int>> ranks_of_node(nnodes);
+        for (int r = 0; r < nprocs; ++r) {
+            ranks_of_node[node_of_rank[r]].push_back(r);
+        }
+        std::vector<Real> node_weights(nnodes);
+        for (int n = 0; n < nnodes; ++n) {
+            node_weights[n] = static_cast<Real>(ranks_of_node[n].size());
+        }
+
+        // Balance across the nodes
+        const std::vector<int> order = MortonOrder(a_costs.boxArray());
+        const std::vector<int> node_chunk = SplitSequence(order, box_costs, node_weights);
+
+        // Balance across the ranks of each node
+        Vector<int> pmap(box_costs.size(), 0);
+        for (int n = 0; n < nnodes; ++n)
+        {
+            std::vector<int> node_order;
+            for (std::size_t k = 0; k < order.size(); ++k) {
+                if (node_chunk[k] == n) { node_order.push_back(order[k]); }
+            }
+            const std::vector<int> rank_chunk = SplitSequence(
+                node_order, box_costs, std::vector<Real>(ranks_of_node[n].size(), 1.0_rt));
+            for (std::size_t k = 0; k < node_order.size(); ++k) {
+                pmap[node_order[k]] = ranks_of_node[n][rank_chunk[k]];
+            }
+        }
+
+        currentEfficiency = MappingEfficiency(box_costs, dm.ProcessorMap(), nprocs);
+        proposedEfficiency = MappingEfficiency(box_costs, pmap, nprocs);
+
+        return DistributionMapping(pmap);
+    }
+
+    /** \brief Move a MultiFab (or iMultiFab) to a new distribution mapping of its boxes
+     *
+     * The boxes that stay on this rank keep their memory, which is handed over to the
+     * new FabArray. Only the boxes that change owner are allocated (and, if redistribute
+     * is true, copied from their previous owner, including the guard cells), so that the
+     * memory only grows by the moved boxes of one field during the load balance, instead
+     * of by the full field.
+     *
+     * @param[in,out] mf FabArray to move; its memory is released
+     * @param[in] dm new distribution mapping
+     * @param[in] redistribute whether the data is copied
+     * @return the FabArray on the new distribution mapping
+     */
+    template <typename MF>
+    std::unique_ptr<MF>
+    RemakeFabArrayInPlace (MF& mf, const DistributionMapping& dm, bool redistribute)
+    {
+        using FAB = typename MF::fab_type;
+        const BoxArray& ba = mf.boxArray();
+        const DistributionMapping& old_dm = mf.DistributionMap();
+        const int ncomp = mf.nComp();
+        const IntVect ng = mf.nGrowVect();
+        const auto nboxes = static_cast<int>(ba.size());
+
+        // Boxes that change owner
+        BoxList moved_bl(ba.ixType());
+        Vector<int> old_owners;
+        Vector<int> new_owners;
+        std::vector<int> moved_position(nboxes, -1);
+        std::vector<int> moved_index;
+        for (int i = 0; i < nboxes; ++i) {
+            if (old_dm[i] != dm[i]) {
+                moved_position[i] = static_cast<int>(moved_index.size());
+                moved_index.push_back(i);
+                moved_bl.push_back(ba[i]);
+                old_owners.push_back(old_dm[i]);
+                new_owners.push_back(dm[i]);
+            }
+        }
+
+        std::unique_ptr<MF> moved;
+        if (!moved_index.empty())
+        {
+            const BoxArray moved_ba(std::move(moved_bl));
+            moved = std::make_unique<MF>(moved_ba, DistributionMapping(std::move(new_owners)), ncomp, ng);
+            // First touch by the threads that process the tiles
+            if (WarpX::numa_aware) { moved->setVal(0); }
+            if (redistribute)
+            {
+                // Alias of the moved boxes on their previous owners
+                MF src(moved_ba, DistributionMapping(std::move(old_owners)), ncomp, ng,
+                       MFInfo().SetAlloc(false));
+                for (MFIter mfi(src); mfi.isValid(); ++mfi) {
+                    src.setFab(mfi, FAB(mf[moved_index[mfi.index()]], amrex::make_alias, 0, ncomp));
+                }
+                moved->Redistribute(src, 0, 0, ncomp, ng);
+            }
+        }
+
+        auto pmf = std::make_unique<MF>(ba, dm, ncomp, ng,
+                                        MFInfo().SetTag(mf.tags()[0]).SetAlloc(false));
+        for (MFIter mfi(*pmf); mfi.isValid(); ++mfi)
+        {
+            const int i = mfi.index();
+            FAB* fab = (moved_position[i] >= 0) ? moved->release(moved_position[i]) : mf.release(i);
+            pmf->setFab(mfi, std::unique_ptr<FAB>(fab));
+        }
+        return pmf;
+    }
+
+    /** \brief Copy a MultiFab (or iMultiFab) to new grids
+     *
+     * If copy is true, the data of the valid cells is copied to the valid and guard cells
+     * of the new boxes that it overlaps (also across the periodic boundaries); the other
+     * cells are set to zero.
+     *
+     * @param[in,out] mf FabArray to copy; its memory is released
+     * @param[in] ba new cell-centered box array
+     * @param[in] dm new distribution mapping
+     * @param[in] copy whether the data is copied
+     * @param[in] period periodicity of the domain
+     * @return the FabArray on the new grids
+     */
+    template <typename MF>
+    std::unique_ptr<MF>
+    RemakeFabArrayOnGrids (MF& mf, const BoxArray& ba, const DistributionMapping& dm, bool copy,
+                           const Periodicity& period)
+    {
+        const int ncomp = mf.nComp();
+        const IntVect ng = mf.nGrowVect();
+        auto pmf = std::make_unique<MF>(amrex::convert(ba, mf.ixType()), dm, ncomp, ng,
+                                        MFInfo().SetTag(mf.tags()[0]));
+        pmf->setVal(0);
+        if (copy) {
+            pmf->ParallelCopy(mf, 0, 0, ncomp, IntVect(0), ng, period);
+        }
+        mf.clear();
+        return pmf;
+    }
+
+    /** \brief Distribution mapping obtained by moving as few boxes as possible from
+     * the most loaded ranks to the least loaded ranks, starting from the current one
+     *
+     * Boxes are moved one at a time from the most loaded rank to the least loaded rank,
+     * choosing the box whose cost is the closest to half of the difference of their costs,
+     * until all the ranks are within the tolerance of the mean cost, or until no move
+     * reduces the maximum cost, or until max_moved_boxes (fraction of the number of
+     * boxes) boxes have been moved. The result is the same on all ranks.
+     *
+     * @param[in] a_costs costs of the boxes
+     * @param[in] dm current distribution mapping
+     * @param[in] tolerance relative tolerance on the cost of each rank above the mean
+     * @param[in] max_moved_boxes maximum fraction of the boxes that are moved
+     * @param[out] currentEfficiency efficiency of the current distribution mapping
+     * @param[out] proposedEfficiency efficiency of the returned distribution mapping
+     */
+    DistributionMapping
+    MakeIncrementalDistributionMapping (const LayoutData<Real>& a_costs,
+                                        const DistributionMapping& dm,
+                                        Real tolerance, Real max_moved_boxes,
+                                        Real& currentEfficiency, Real& proposedEfficiency)
+    {
+        const auto nboxes = static_cast<int>(a_costs.size());
+        const int nprocs = ParallelContext::NProcsSub();
+
+        const std::vector<Real> box_costs = AllBoxCosts(a_costs);
+
+        Vector<int> pmap = dm.ProcessorMap();
+        std::vector<Real> rank_costs(nprocs, 0.0_rt);
+        std::vector<std::vector<int>> rank_boxes(nprocs);
+        for (int i = 0; i < nboxes; ++i) {
+            rank_costs[pmap[i]] += box_costs[i];
+            rank_boxes[pmap[i]].push_back(i);
+        }
+
+        const Real mean_cost = std::accumulate(rank_costs.begin(), rank_costs.end(), 0.0_rt)/nprocs;
+        const auto efficiency = [&] () {
+            const Real max_cost = *std::max_element(rank_costs.begin(), rank_costs.end());
+            return (max_cost > 0.0_rt) ? mean_cost/max_cost : 1.0_rt;
+        };
+        currentEfficiency = efficiency();
+
+        const Real target_cost = (1.0_rt + tolerance)*mean_cost;
+        const int max_moves = static_cast<int>(max_moved_boxes*static_cast<Real>(nboxes));
+        std::vector<bool> moved(nboxes, false);
+        for (int n_moves = 0; n_moves < max_moves; ++n_moves)
+        {
+            const auto p = static_cast<int>(
+                std::max_element(rank_costs.begin(), rank_costs.end()) - rank_costs.begin());
+            const auto q = static_cast<int>(
+                std::min_element(rank_costs.begin(), rank_costs.end()) - rank_costs.begin());
+            const Real gap = rank_costs[p] - rank_costs[q];
+            if (rank_costs[p] <= target_cost || gap <= 0.0_rt) { break; }
+
+            // Box of rank p that best equalizes the costs of ranks p and q;
+            // a box is moved at most once, to avoid back-and-forth migrations
+            int best = -1;
+            for (const int i : rank_boxes[p]) {
+                if (moved[i] || box_costs[i] <= 0.0_rt || box_costs[i] >= gap) { continue; }
+                if (best < 0 || std::abs(box_costs[i] - 0.5_rt*gap) < std::abs(box_costs[best] - 0.5_rt*gap)) {
+                    best = i;
+                }
+            }
+            if (best < 0) { break; }
+
+            pmap[best] = q;
+            moved[best] = true;
+            rank_costs[p] -= box_costs[best];
+            rank_costs[q] += box_costs[best];
+            rank_boxes[p].erase(std::find(rank_boxes[p].begin(), rank_boxes[p].end(), best));
+            rank_boxes[q].push_back(best);
+        }
+        proposedEfficiency = efficiency();
+
+        return DistributionMapping(pmap);
+    }
+}
+
 void
 WarpX::CheckLoadBalance (int step)
 {
+    if (m_costs_calibrating)
+    {
+        // The costs of the previous step were measured with the timers:
+        // update the fit of the adaptive costs model and go back to it
+        CalibrateCostsAdaptive();
+        load_balance_costs_update_algo = LoadBalanceCostsUpdateAlgo::Adaptive;
+        m_costs_calibrating = false;
+    }
+
     if (step > 0 && load_balance_intervals.contains(step+1))
     {
         LoadBalance();
 
         // Reset the costs to 0
         ResetCosts();
+
+        // The best particle tile size may have changed
+        m_tile_size_autotuner->restart();
     }
-    if (!costs.empty())
+
+    if (load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Adaptive)
+    {
+        // By default, calibrate the adaptive costs model on the step before each load balancing
+        const bool calibrate = costs_calibration_intervals.isActivated() ?
+            costs_calibration_intervals.contains(step+1) :
+            load_balance_intervals.contains(step+2);
+        if (calibrate)
+        {
+            ResetCosts();
+            load_balance_costs_update_algo = LoadBalanceCostsUpdateAlgo::Timers;
+            m_costs_calibrating = true;
+        }
+    }
+    else if (!costs.empty())
     {
         RescaleCosts(step);
     }
@@ -81,6 +446,10 @@ WarpX::LoadBalance ()
         // compute the costs on a per-rank basis
         ComputeCostsHeuristic(costs);
     }
+    else if (load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Adaptive)
+    {
+        ComputeCostsAdaptive(costs);
+    }
 
     // By default, do not do a redistribute; this toggles to true if RemakeLevel
     // is called for any level
@@ -101,45 +470,73 @@ WarpX::LoadBalance ()
         amrex::Real currentEfficiency = 0.0;
         amrex::Real proposedEfficiency = 0.0;
 
-        newdm = (load_balance_with_sfc)
-            ? DistributionMapping::makeSFC(*costs[lev],
-                                           currentEfficiency, proposedEfficiency,
-                                           false,
-                                           ParallelDescriptor::IOProcessorNumber())
-            : DistributionMapping::makeKnapSack(*costs[lev],
-                                                currentEfficiency, proposedEfficiency,
-                                                nmax,
-                                                false,
-                                                ParallelDescriptor::IOProcessorNumber());
-        // As specified in the above calls to makeSFC and makeKnapSack, the new
-        // distribution mapping is NOT communicated to all ranks; the loadbalanced
-        // dm is up-to-date only on root, and we can decide whether to broadcast
-        if ((load_balance_efficiency_ratio_threshold > 0.0)
-            && (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber()))
+        if (load_balance_incremental)
         {
-            doLoadBalance = (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency);
+            // The new distribution mapping is computed identically on all ranks
+            newdm = MakeIncrementalDistributionMapping(*costs[lev], DistributionMap(lev),
+                                                      load_balance_incremental_tolerance,
+                                                      load_balance_incremental_max_moved_boxes,
+                                                      currentEfficiency, proposedEfficiency);
+            doLoadBalance = (load_balance_efficiency_ratio_threshold > 0.0)
+                && (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency);
         }
-
-        ParallelDescriptor::Bcast(&doLoadBalance, 1,
-                                  ParallelDescriptor::IOProcessorNumber());
-
-        if (doLoadBalance)
+        else if (load_balance_topology_aware)
         {
-            Vector<int> pmap;
-            if (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber())
-            {
-                pmap = newdm.ProcessorMap();
-            } else
+            if (m_node_of_rank.empty()) {
+                m_node_of_rank = ablastr::parallelization::node_of_ranks();
+            }
+            // The new distribution mapping is computed identically on all ranks
+            newdm = MakeTopologyAwareDistributionMapping(*costs[lev], DistributionMap(lev),
+                                                        m_node_of_rank,
+                                                        currentEfficiency, proposedEfficiency);
+            doLoadBalance = (load_balance_efficiency_ratio_threshold > 0.0)
+                && (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency);
+        }
+        else
+        {
+            newdm = (load_balance_with_sfc)
+                ? DistributionMapping::makeSFC(*costs[lev],
+                                               currentEfficiency, proposedEfficiency,
+                                               false,
+                                               ParallelDescriptor::IOProcessorNumber())
+                : DistributionMapping::makeKnapSack(*costs[lev],
+                                                    currentEfficiency, proposedEfficiency,
+                                                    nmax,
+                                                    false,
+                                                    ParallelDescriptor::IOProcessorNumber());
+            // As specified in the above calls to makeSFC and makeKnapSack, the new
+            // distribution mapping is NOT communicated to all ranks; the loadbalanced
+            // dm is up-to-date only on root, and we can decide whether to broadcast
+            if ((load_balance_efficiency_ratio_threshold > 0.0)
+                && (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber()))
             {
-                pmap.resize(static_cast<std::size_t>(nboxes));
+                doLoadBalance = (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency);
             }
-            ParallelDescriptor::Bcast(pmap.data(), pmap.size(), ParallelDescriptor::IOProcessorNumber());
 
-            if (ParallelDescriptor::MyProc() != ParallelDescriptor::IOProcessorNumber())
+            ParallelDescriptor::Bcast(&doLoadBalance, 1,
+                                      ParallelDescriptor::IOProcessorNumber());
+
+            if (doLoadBalance)
             {
-                newdm = DistributionMapping(pmap);
+                Vector<int> pmap;
+                if (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber())
+                {
+                    pmap = newdm.ProcessorMap();
+                } else
+                {
+                    pmap.resize(static_cast<std::size_t>(nboxes));
+                }
+                ParallelDescriptor::Bcast(pmap.data(), pmap.size(), ParallelDescriptor::IOProcessorNumber());
+
+                if (ParallelDescriptor::MyProc() != ParallelDescriptor::IOProcessorNumber())
+                {
+                    newdm = DistributionMapping(pmap);
+                }
             }
+        }
 
+        if (doLoadBalance)
+        {
             RemakeLevel(lev, t_new[lev], boxArray(lev), newdm);
 
             // Record the load balance efficiency
@@ -164,22 +561,57 @@ WarpX::LoadBalance ()
 #endif
 }
 
+void
+WarpX::RemakeBaseGrids (const IntVect& a_max_grid_size, const IntVect& a_blocking_factor)
+{
+    WARPX_PROFILE("WarpX::RemakeBaseGrids()");
+
+    SetMaxGridSize(a_max_grid_size);
+    SetBlockingFactor(a_blocking_factor);
+    const BoxArray ba = MakeBaseGrids();
+    if (ba == boxArray(0)) { return; }
+
+    RemakeLevel(0, t_new[0], ba, MakeDistributionMap(0, ba));
+
+    mypc->Redistribute();
+    mypc->defineAllParticleTiles();
+    m_particle_boundary_buffer->redistribute();
+    reduced_diags->LoadBalance();
+}
+
 void
 WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const DistributionMapping& dm)
 {
+    // The persistent communication buffers are tied to the old grids
+    ablastr::utils::communication::ClearCommBuffers();
+    // So are the recorded GPU graphs of the field solves
+    m_field_solve_graphs.clear();
+
+    // The guard cells of the remade fields must be exchanged before the next FDTD push
+    if (lev == 0) {
+        m_fdtd_valid_guards_E = amrex::IntVect::TheZeroVector();
+        m_fdtd_valid_guards_B = amrex::IntVect::TheZeroVector();
+    }
+
+    // The grids themselves can only be changed on level 0 (see RemakeBaseGrids)
+    const bool new_grids = (ba != boxArray(lev));
 
     const auto RemakeMultiFab = [&](auto& mf, const bool redistribute){
         if (mf == nullptr) { return; }
-        const IntVect& ng = mf->nGrowVect();
-        auto pmf = std::remove_reference_t<decltype(mf)>{};
-        AllocInitMultiFab(pmf, mf->boxArray(), dm, mf->nComp(), ng, lev, mf->tags()[0]);
-        if (redistribute) { pmf->Redistribute(*mf, 0, 0, mf->nComp(), ng); }
+        auto pmf = new_grids ?
+            RemakeFabArrayOnGrids(*mf, ba, dm, redistribute, Geom(lev).periodicity()) :
+            RemakeFabArrayInPlace(*mf, dm, redistribute);
+        if constexpr (std::is_same_v<std::remove_reference_t<decltype(*mf)>, amrex::MultiFab>) {
+            multifab_map[pmf->tags()[0]] = pmf.get();
+        } else {
+            imultifab_map[pmf->tags()[0]] = pmf.get();
+        }
         mf = std::move(pmf);
     };
 
-    if (ba == boxArray(lev))
+    if (!new_grids || (lev == 0 && finest_level == 0 && !do_pml))
     {
-        if (ParallelDescriptor::NProcs() == 1) { return; }
+        if (!new_grids && ParallelDescriptor::NProcs() == 1) { return; }
 
         // Fine patch
         for (int idim=0; idim < 3; ++idim)
@@ -230,6 +662,9 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
         // phi_fp should be redistributed since we use the solution from
         // the last step as the initial guess for the next solve
         RemakeMultiFab(phi_fp[lev], true);
+        // The Poisson operators and the solution history belong to the old grids
+        m_phi_fp_previous[lev].reset();
+        if (m_poisson_solver_cache) { m_poisson_solver_cache->clear(); }
 
         if (WarpX::electromagnetic_solver_id == ElectromagneticSolverAlgo::HybridPIC) {
             RemakeMultiFab(m_hybrid_pic_model->rho_fp_temp[lev], true);
@@ -238,6 +673,7 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
 
 #ifdef AMREX_USE_EB
         RemakeMultiFab(m_distance_to_eb[lev], false);
+        m_near_eb_box[lev] = std::make_unique<amrex::LayoutData<int>>(ba, dm);
 
         int max_guard = guard_cells.ng_FieldSolver.max();
         m_field_factory[lev] = amrex::makeEBFabFactory(Geom(lev), ba, dm,
@@ -379,11 +815,14 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
             }
         }
 
+        if (new_grids) { SetBoxArray(lev, ba); }
         SetDistributionMap(lev, dm);
 
     } else
     {
-        WARPX_ABORT_WITH_MESSAGE("RemakeLevel: to be implemented");
+        WARPX_ABORT_WITH_MESSAGE(
+            "RemakeLevel: changing the grids is only implemented on level 0,"
+            " without mesh refinement or PML");
     }
 
     // Re-initialize diagnostic functors that stores pointers to the user-requested fields at level, lev.
@@ -423,6 +862,158 @@ WarpX::ComputeCostsHeuristic (amrex::Vector<std::unique_ptr<amrex::LayoutData<am
     }
 }
 
+amrex::Vector<std::unique_ptr<amrex::LayoutData<amrex::Real> > >
+WarpX::CostsModelVariables (int lev)
+{
+    const auto & mypc_ref = GetInstance().GetPartContainer();
+    const auto nSpecies = mypc_ref.nSpecies();
+
+    amrex::Vector<std::unique_ptr<amrex::LayoutData<amrex::Real> > > variables(nSpecies+1);
+    for (auto& variable : variables)
+    {
+        variable = std::make_unique<LayoutData<Real>>(costs[lev]->boxArray(),
+                                                      costs[lev]->DistributionMap());
+        for (const auto& i : variable->IndexArray()) { (*variable)[i] = 0.0_rt; }
+    }
+
+    // Cell loop
+    MultiFab* Ex = Efield_fp[lev][0].get();
+    for (MFIter mfi(*Ex, false); mfi.isValid(); ++mfi)
+    {
+        (*variables[0])[mfi.index()] = static_cast<Real>(mfi.growntilebox().numPts());
+    }
+
+    // Species loop
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
+        auto & myspc = mypc_ref.GetParticleContainer(i_s);
+        for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+        {
+            (*variables[i_s+1])[pti.index()] += static_cast<Real>(pti.numParticles());
+        }
+    }
+
+    return variables;
+}
+
+void
+WarpX::ComputeCostsAdaptive (amrex::Vector<std::unique_ptr<amrex::LayoutData<amrex::Real> > >& a_costs)
+{
+    const auto nSpecies = GetPartContainer().nSpecies();
+
+    // Until the first calibration, use the weights of the heuristic costs update
+    std::vector<Real> coefs = m_costs_adaptive_coefs;
+    if (static_cast<int>(coefs.size()) != nSpecies+1)
+    {
+        coefs.assign(nSpecies+1, costs_heuristic_particles_wt);
+        coefs[0] = costs_heuristic_cells_wt;
+    }
+
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        const auto variables = CostsModelVariables(lev);
+        for (const auto& i : a_costs[lev]->IndexArray())
+        {
+            Real cost = 0.0_rt;
+            for (int k = 0; k <= nSpecies; ++k) {
+                cost += coefs[k]*(*variables[k])[i];
+            }
+            (*a_costs[lev])[i] = cost;
+        }
+    }
+}
+
+void
+WarpX::CalibrateCostsAdaptive ()
+{
+    const auto nSpecies = GetPartContainer().nSpecies();
+    const int nvar = nSpecies+1;
+
+    // Normal equations of the least-squares fit of the measured costs of the
+    // boxes of all levels by a linear combination of the variables of the model
+    std::vector<double> matrix(nvar*nvar, 0.);
+    std::vector<double> rhs(nvar, 0.);
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        const auto variables = CostsModelVariables(lev);
+        for (const auto& i : costs[lev]->IndexArray())
+        {
+            const auto measured = static_cast<double>((*costs[lev])[i]);
+            for (int k = 0; k < nvar; ++k)
+            {
+                const auto xk = static_cast<double>((*variables[k])[i]);
+                rhs[k] += xk*measured;
+                for (int l = 0; l < nvar; ++l) {
+                    matrix[k*nvar+l] += xk*static_cast<double>((*variables[l])[i]);
+                }
+            }
+        }
+    }
+    ParallelDescriptor::ReduceRealSum(matrix.data(), nvar*nvar);
+    ParallelDescriptor::ReduceRealSum(rhs.data(), nvar);
+
+    // Exponential forgetting of the previous calibrations
+    if (static_cast<int>(m_costs_adaptive_rhs.size()) == nvar)
+    {
+        for (int k = 0; k < nvar*nvar; ++k) {
+            matrix[k] += costs_adaptive_decay*m_costs_adaptive_matrix[k];
+        }
+        for (int k = 0; k < nvar; ++k) {
+            rhs[k] += costs_adaptive_decay*m_costs_adaptive_rhs[k];
+        }
+    }
+    m_costs_adaptive_matrix = matrix;
+    m_costs_adaptive_rhs = rhs;
+
+    // Small ridge regularization; the coefficient of a variable that is zero
+    // in all boxes (e.g. a species without particles) is set to zero
+    for (int k = 0; k < nvar; ++k)
+    {
+        double& diag = matrix[k*nvar+k];
+        diag = (diag > 0.) ? diag*(1. + 1.e-10) : 1.;
+    }
+
+    // Gaussian elimination with partial pivoting
+    for (int k = 0; k < nvar; ++k)
+    {
+        int pivot = k;
+        for (int r = k+1; r < nvar; ++r) {
+            if (std::abs(matrix[r*nvar+k]) > std::abs(matrix[pivot*nvar+k])) { pivot = r; }
+        }
+        if (matrix[pivot*nvar+k] == 0.) { return; }
+        if (pivot != k)
+        {
+            for (int c = 0; c < nvar; ++c) { std::swap(matrix[k*nvar+c], matrix[pivot*nvar+c]); }
+            std::swap(rhs[k], rhs[pivot]);
+        }
+        for (int r = k+1; r < nvar; ++r)
+        {
+            const double factor = matrix[r*nvar+k]/matrix[k*nvar+k];
+            for (int c = k; c < nvar; ++c) { matrix[r*nvar+c] -= factor*matrix[k*nvar+c]; }
+            rhs[r] -= factor*rhs[k];
+        }
+    }
+    std::vector<Real> coefs(nvar);
+    for (int k = nvar-1; k >= 0; --k)
+    {
+        double x = rhs[k];
+        for (int c = k+1; c < nvar; ++c) { x -= matrix[k*nvar+c]*static_cast<double>(coefs[c]); }
+        // The costs cannot decrease with the number of cells or particles
+        coefs[k] = static_cast<Real>(std::max(x/matrix[k*nvar+k], 0.));
+    }
+
+    if (std::none_of(coefs.begin(), coefs.end(), [](Real c){ return c > 0.0_rt; })) { return; }
+    m_costs_adaptive_coefs = coefs;
+
+    if (verbose)
+    {
+        std::string msg = "Adaptive costs model: cost per cell " + std::to_string(coefs[0])
+            + ", cost per particle of each species";
+        for (int k = 1; k < nvar; ++k) { msg += " " + std::to_string(coefs[k]); }
+        amrex::Print() << Utils::TextMsg::Info(msg);
+    }
+}
+
 void
 WarpX::ResetCosts ()
 {
@@ -20,7 +20,16 @@ WarpXSumGuardCells(amrex::MultiFab& mf, const amrex::Periodicity& period,
                    const int icomp, const int ncomp)
 {
     amrex::IntVect const n_updated_guards = mf.nGrowVect();
-    ablastr::utils::communication::SumBoundary(mf, icomp, ncomp, src_ngrow, n_updated_guards, WarpX::do_single_precision_comms, period);
+    WarpXSumGuardCells(mf, period, src_ngrow, n_updated_guards, icomp, ncomp);
+}
+
+
+void
+WarpXSumGuardCells(amrex::MultiFab& mf, const amrex::Periodicity& period,
+                   const amrex::IntVect& src_ngrow, const amrex::IntVect& dst_ngrow,
+                   const int icomp, const int ncomp)
+{
+    ablastr::utils::communication::SumBoundary(mf, icomp, ncomp, src_ngrow, dst_ngrow, WarpX::do_single_precision_comms, period);
 }
 
 
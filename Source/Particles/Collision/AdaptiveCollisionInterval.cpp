@@ -0,0 +1,176 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "AdaptiveCollisionInterval.H"
+
+#include "Utils/Parser/ParserUtils.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXConst.H"
+#include "WarpX.H"
+
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Reduce.H>
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    using index_type = AdaptiveCollisionInterval::ParticleBins::index_type;
+
+    /** Sum of the weights, of the weighted velocities and of the weighted square velocities
+     *  of the particles I[Is:Ie] of a cell */
+    AMREX_GPU_HOST_DEVICE AMREX_INLINE
+    void CellSums (index_type Is, index_type Ie, index_type const* AMREX_RESTRICT I,
+                   amrex::ParticleReal const* AMREX_RESTRICT w,
+                   amrex::ParticleReal const* AMREX_RESTRICT ux,
+                   amrex::ParticleReal const* AMREX_RESTRICT uy,
+                   amrex::ParticleReal const* AMREX_RESTRICT uz,
+                   amrex::ParticleReal& wsum, amrex::ParticleReal& vx, amrex::ParticleReal& vy,
+                   amrex::ParticleReal& vz, amrex::ParticleReal& v2)
+    {
+        using namespace amrex::literals;
+        constexpr auto inv_c2 = amrex::ParticleReal(1._prt/(PhysConst::c*PhysConst::c));
+        wsum = 0._prt; vx = 0._prt; vy = 0._prt; vz = 0._prt; v2 = 0._prt;
+        for (index_type i = Is; i < Ie; ++i) {
+            const index_type ip = I[i];
+            const amrex::ParticleReal u2 = ux[ip]*ux[ip] + uy[ip]*uy[ip] + uz[ip]*uz[ip];
+            const amrex::ParticleReal inv_gamma = 1._prt/std::sqrt(1._prt + u2*inv_c2);
+            wsum += w[ip];
+            vx += w[ip]*ux[ip]*inv_gamma;
+            vy += w[ip]*uy[ip]*inv_gamma;
+            vz += w[ip]*uz[ip]*inv_gamma;
+            v2 += w[ip]*u2*inv_gamma*inv_gamma;
+        }
+        if (wsum > 0._prt) { vx /= wsum; vy /= wsum; vz /= wsum; v2 /= wsum; }
+    }
+}
+
+AdaptiveCollisionInterval::AdaptiveCollisionInterval (const std::string& collision_name)
+{
+    const amrex::ParmParse pp_collision_name(collision_name);
+    utils::parser::queryWithParser(pp_collision_name, "adaptive_ndt_max", m_ndt_max);
+    utils::parser::queryWithParser(pp_collision_name, "adaptive_nu_dt", m_nu_dt);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_ndt_max >= 1,
+        collision_name + ".adaptive_ndt_max must be at least 1.");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_nu_dt > 0.,
+        collision_name + ".adaptive_nu_dt must be positive.");
+}
+
+int
+AdaptiveCollisionInterval::getTileInterval (
+    int lev, amrex::MFIter const& mfi,
+    ParticleTileType& ptile_1, ParticleTileType& ptile_2,
+    ParticleBins const& bins_1, ParticleBins const& bins_2,
+    amrex::ParticleReal q1, amrex::ParticleReal q2,
+    amrex::ParticleReal m1, amrex::ParticleReal m2,
+    bool is_same_species, amrex::ParticleReal CoulombLog,
+    amrex::Real dt) const
+{
+    using namespace amrex::literals;
+
+    if (!enabled()) { return 1; }
+
+    auto const n_cells = static_cast<int>(bins_1.numBins());
+    if (n_cells == 0) { return m_ndt_max; }
+
+    const auto soa_1 = ptile_1.getParticleTileData();
+    const auto soa_2 = ptile_2.getParticleTileData();
+    amrex::ParticleReal const* AMREX_RESTRICT w1 = soa_1.m_rdata[PIdx::w];
+    amrex::ParticleReal const* AMREX_RESTRICT ux1 = soa_1.m_rdata[PIdx::ux];
+    amrex::ParticleReal const* AMREX_RESTRICT uy1 = soa_1.m_rdata[PIdx::uy];
+    amrex::ParticleReal const* AMREX_RESTRICT uz1 = soa_1.m_rdata[PIdx::uz];
+    amrex::ParticleReal const* AMREX_RESTRICT w2 = soa_2.m_rdata[PIdx::w];
+    amrex::ParticleReal const* AMREX_RESTRICT ux2 = soa_2.m_rdata[PIdx::ux];
+    amrex::ParticleReal const* AMREX_RESTRICT uy2 = soa_2.m_rdata[PIdx::uy];
+    amrex::ParticleReal const* AMREX_RESTRICT uz2 = soa_2.m_rdata[PIdx::uz];
+    index_type const* AMREX_RESTRICT indices_1 = bins_1.permutationPtr();
+    index_type const* AMREX_RESTRICT indices_2 = bins_2.permutationPtr();
+    index_type const* AMREX_RESTRICT cell_offsets_1 = bins_1.offsetsPtr();
+    index_type const* AMREX_RESTRICT cell_offsets_2 = bins_2.offsetsPtr();
+
+    amrex::Geometry const& geom = WarpX::GetInstance().Geom(lev);
+#if defined WARPX_DIM_1D_Z
+    auto dV = geom.CellSize(0);
+#elif defined WARPX_DIM_XZ
+    auto dV = geom.CellSize(0) * geom.CellSize(1);
+#elif defined WARPX_DIM_RZ
+    amrex::Box const& cbx = mfi.tilebox(amrex::IntVect::TheZeroVector()); //Cell-centered box
+    const auto lo = lbound(cbx);
+    const auto hi = ubound(cbx);
+    int const nz = hi.y-lo.y+1;
+    auto dr = geom.CellSize(0);
+    auto dz = geom.CellSize(1);
+#elif defined(WARPX_DIM_3D)
+    auto dV = geom.CellSize(0) * geom.CellSize(1) * geom.CellSize(2);
+#endif
+#if !defined WARPX_DIM_RZ
+    amrex::ignore_unused(mfi);
+#endif
+
+    // Largest collision frequency of the cells of the tile
+    amrex::ReduceOps<amrex::ReduceOpMax> reduce_op;
+    amrex::ReduceData<amrex::ParticleReal> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+    reduce_op.eval(n_cells, reduce_data,
+        [=] AMREX_GPU_DEVICE (int i_cell) -> ReduceTuple
+        {
+#if defined WARPX_DIM_RZ
+            const int ri = lo.x + i_cell/nz;
+            auto dV = MathConst::pi*(2.0_prt*ri+1.0_prt)*dr*dr*dz;
+#endif
+            const index_type N1 = cell_offsets_1[i_cell+1] - cell_offsets_1[i_cell];
+            const index_type N2 = cell_offsets_2[i_cell+1] - cell_offsets_2[i_cell];
+            if (N1 == 0 || N2 == 0 || (is_same_species && N1 < 2)) { return {0._prt}; }
+
+            amrex::ParticleReal w1s, v1x, v1y, v1z, v1sq;
+            CellSums(cell_offsets_1[i_cell], cell_offsets_1[i_cell+1], indices_1,
+                     w1, ux1, uy1, uz1, w1s, v1x, v1y, v1z, v1sq);
+            amrex::ParticleReal w2s, v2x, v2y, v2z, v2sq;
+            if (is_same_species) {
+                w2s = w1s; v2x = v1x; v2y = v1y; v2z = v1z; v2sq = v1sq;
+            } else {
+                CellSums(cell_offsets_2[i_cell], cell_offsets_2[i_cell+1], indices_2,
+                         w2, ux2, uy2, uz2, w2s, v2x, v2y, v2z, v2sq);
+            }
+            if (w1s <= 0._prt || w2s <= 0._prt) { return {0._prt}; }
+
+            const amrex::ParticleReal n1 = w1s/dV;
+            const amrex::ParticleReal n2 = w2s/dV;
+            const amrex::ParticleReal mu = m1*m2/(m1 + m2);
+            const amrex::ParticleReal ep0 = PhysConst::ep0;
+            // Mean square relative velocity of the particles of the two species
+            const amrex::ParticleReal urel2 = v1sq + v2sq - 2._prt*(v1x*v2x + v1y*v2y + v1z*v2z);
+            if (urel2 <= 0._prt) { return {std::numeric_limits<amrex::ParticleReal>::max()}; }
+
+            amrex::ParticleReal lnLmd = CoulombLog;
+            if (lnLmd <= 0._prt) {
+                const amrex::ParticleReal T1 = m1/3._prt*(v1sq - (v1x*v1x + v1y*v1y + v1z*v1z));
+                const amrex::ParticleReal T2 = m2/3._prt*(v2sq - (v2x*v2x + v2y*v2y + v2z*v2z));
+                amrex::ParticleReal inv_lmdD2 = 0._prt;
+                if (T1 > 0._prt) { inv_lmdD2 += n1*q1*q1/(ep0*T1); }
+                if (!is_same_species && T2 > 0._prt) { inv_lmdD2 += n2*q2*q2/(ep0*T2); }
+                const amrex::ParticleReal b0 = amrex::Math::abs(q1*q2)/
+                    (4._prt*MathConst::pi*ep0*mu*urel2);
+                const amrex::ParticleReal bq = PhysConst::hbar/(2._prt*mu*std::sqrt(urel2));
+                const amrex::ParticleReal bmin = amrex::max(b0, bq);
+                lnLmd = (inv_lmdD2 > 0._prt) ?
+                    amrex::max(2._prt, 0.5_prt*std::log(1._prt + 1._prt/(inv_lmdD2*bmin*bmin))) : 2._prt;
+            }
+
+            // Momentum-exchange frequency of a particle at the relative velocity urel
+            const amrex::ParticleReal nu = q1*q1*q2*q2*lnLmd/
+                (4._prt*MathConst::pi*ep0*ep0*mu*urel2*std::sqrt(urel2))*
+                amrex::max(n2/m1, n1/m2);
+            return {nu};
+        });
+    const auto nu_max = static_cast<amrex::Real>(amrex::get<0>(reduce_data.value()));
+
+    int interval = 1;
+    while (2*interval <= m_ndt_max && nu_max*(2*interval)*dt <= m_nu_dt) { interval *= 2; }
+    return interval;
+}
@@ -9,18 +9,181 @@
 #include "ImpactIonization.H"
 #include "Particles/ParticleCreation/FilterCopyTransform.H"
 #include "Particles/ParticleCreation/SmartCopy.H"
+#include "Particles/Pusher/GetAndSetPosition.H"
+#include "Utils/CounterBasedRandom.H"
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/ParticleUtils.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
+#include <AMReX_GpuQualifiers.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_Random.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Vector.H>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <string>
 
+namespace
+{
+    /** Number of particles skipped before the next collision candidate (at most m_max_skip),
+     *  when each particle is a candidate with a probability p, with m_log_no_collision_prob = log(1-p) */
+    struct GeometricSkip
+    {
+        double m_log_no_collision_prob;
+        long m_max_skip;
+
+        AMREX_GPU_HOST_DEVICE AMREX_INLINE
+        long operator() (amrex::RandomEngine const& engine) const
+        {
+            const double skip = std::log(static_cast<double>(amrex::Random(engine))) / m_log_no_collision_prob;
+            return (skip < static_cast<double>(m_max_skip)) ? static_cast<long>(skip) : m_max_skip;
+        }
+    };
+
+    /** Collision of the particle ip, once it has been selected as a collision candidate
+     *  (null-collision method). The random engine is either amrex::RandomEngine or
+     *  utils::random::CounterBasedRandomEngine; Random and RandomNormal are found by
+     *  argument-dependent lookup. */
+    struct BackgroundCollisionFunc
+    {
+        amrex::Real t;
+        amrex::ParserExecutor<4> n_a_func;
+        amrex::ParserExecutor<4> T_a_func;
+        ScatteringProcess::Executor const* scattering_processes;
+        int process_count;
+        amrex::ParticleReal nu_max;
+        ScatteringProcessTable::Executor scattering_table;
+        amrex::ParticleReal m, M, mc2;
+        GetParticlePosition<PIdx> GetPosition;
+        amrex::ParticleReal* AMREX_RESTRICT ux;
+        amrex::ParticleReal* AMREX_RESTRICT uy;
+        amrex::ParticleReal* AMREX_RESTRICT uz;
+
+        template <typename Engine>
+        AMREX_GPU_HOST_DEVICE AMREX_INLINE
+        void operator() (long ip, Engine const& engine) const
+        {
+            using namespace amrex::literals;
+            using std::sqrt;
+
+            constexpr auto c2 = PhysConst::c * PhysConst::c;
+
+            amrex::ParticleReal x, y, z;
+            GetPosition.AsStored(ip, x, y, z);
+
+            const amrex::ParticleReal n_a = n_a_func(x, y, z, t);
+            const amrex::ParticleReal T_a = T_a_func(x, y, z, t);
+
+            amrex::ParticleReal v_coll, v_coll2, sigma_E, nu_i = 0;
+            double gamma, E_coll;
+            amrex::ParticleReal ua_x, ua_y, ua_z, vx, vy, vz;
+            amrex::ParticleReal uCOM_x, uCOM_y, uCOM_z;
+            const amrex::ParticleReal col_select = Random(engine);
+
+            // get velocities of gas particles from a Maxwellian distribution
+            auto const vel_std = sqrt(PhysConst::kb * T_a / M);
+            ua_x = vel_std * RandomNormal(0_prt, 1.0_prt, engine);
+            ua_y = vel_std * RandomNormal(0_prt, 1.0_prt, engine);
+            ua_z = vel_std * RandomNormal(0_prt, 1.0_prt, engine);
+
+            // we assume the target particle is not relativistic (in
+            // the lab frame) and therefore we can transform the projectile
+            // velocity to a frame in which the target is stationary with
+            // a simple Galilean boost
+            // not doing the full Lorentz boost here saves us computation
+            // since most particles will not actually collide
+            vx = ux[ip] - ua_x;
+            vy = uy[ip] - ua_y;
+            vz = uz[ip] - ua_z;
+            v_coll2 = (vx*vx + vy*vy + vz*vz);
+            v_coll = sqrt(v_coll2);
+
+            // calculate the collision energy in eV
+            ParticleUtils::getCollisionEnergy(v_coll2, m, M, gamma, E_coll);
+
+            // position in the energy grid, shared by all cross sections
+            const auto E_coll_table = static_cast<amrex::ParticleReal>(E_coll);
+            int idx_E;
+            amrex::ParticleReal frac_E;
+            scattering_table.getInterpolation(E_coll_table, idx_E, frac_E);
+
+            // loop through all collision pathways
+            for (int i = 0; i < process_count; i++) {
+                auto const& scattering_process = *(scattering_processes + i);
+
+                // get collision cross-section
+                sigma_E = scattering_table.getCrossSection(i, E_coll_table, idx_E, frac_E);
+
+                // calculate normalized collision frequency
+                nu_i += n_a * sigma_E * v_coll / nu_max;
+
+                // check if this collision should be performed
+                if (col_select > nu_i) { continue; }
+
+                // charge exchange is implemented as a simple swap of the projectile
+                // and target velocities which doesn't require any of the Lorentz
+                // transformations below; note that if the projectile and target
+                // have the same mass this is identical to back scattering
+                if (scattering_process.m_type == ScatteringProcessType::CHARGE_EXCHANGE) {
+                    ux[ip] = ua_x;
+                    uy[ip] = ua_y;
+                    uz[ip] = ua_z;
+                    break;
+                }
+
+                // At this point the given particle has been chosen for a collision
+                // and so we perform the needed calculations to transform to the
+                // COM frame.
+                uCOM_x = static_cast<amrex::ParticleReal>(m * vx / (gamma * m + M));
+                uCOM_y = static_cast<amrex::ParticleReal>(m * vy / (gamma * m + M));
+                uCOM_z = static_cast<amrex::ParticleReal>(m * vz / (gamma * m + M));
+
+                // subtract any energy penalty of the collision from the
+                // projectile energy
+                if (scattering_process.m_energy_penalty > 0.0_prt) {
+                    ParticleUtils::getEnergy(v_coll2, m, E_coll);
+                    E_coll = (E_coll - scattering_process.m_energy_penalty) * PhysConst::q_e;
+                    const auto scale_fac = static_cast<amrex::ParticleReal>(
+                      std::sqrt(E_coll * (E_coll + 2.0_prt*mc2) / c2) / m / v_coll);
+                    vx *= scale_fac;
+                    vy *= scale_fac;
+                    vz *= scale_fac;
+                }
+
+                // transform to COM frame
+                ParticleUtils::doLorentzTransform(vx, vy, vz, uCOM_x, uCOM_y, uCOM_z);
+
+                if ((scattering_process.m_type == ScatteringProcessType::ELASTIC)
+                    || (scattering_process.m_type == ScatteringProcessType::EXCITATION)) {
+                    ParticleUtils::RandomizeVelocity(
+                        vx, vy, vz, sqrt(vx*vx + vy*vy + vz*vz), engine
+                    );
+                }
+                else if (scattering_process.m_type == ScatteringProcessType::BACK) {
+                    // elastic scattering with cos(chi) = -1 (i.e. 180 degrees)
+                    vx *= -1.0_prt;
+                    vy *= -1.0_prt;
+                    vz *= -1.0_prt;
+                }
+
+                // transform back to scattering frame
+                ParticleUtils::doLorentzTransform(vx, vy, vz, -uCOM_x, -uCOM_y, -uCOM_z);
+
+                // update particle velocity with new components in labframe
+                ux[ip] = vx + ua_x;
+                uy[ip] = vy + ua_y;
+                uz[ip] = vz + ua_z;
+                break;
+            }
+        }
+    };
+}
+
 BackgroundMCCCollision::BackgroundMCCCollision (std::string const& collision_name)
     : CollisionBase(collision_name)
 {
@@ -29,6 +192,9 @@ BackgroundMCCCollision::BackgroundMCCCollision (std::string const& collision_nam
 
     const amrex::ParmParse pp_collision_name(collision_name);
 
+    m_rng_stream = static_cast<std::uint32_t>(utils::random::Purpose::BackgroundMCC) ^
+        utils::random::hashString(collision_name);
+
     amrex::ParticleReal background_density = 0;
     if (utils::parser::queryWithParser(pp_collision_name, "background_density", background_density)) {
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
@@ -85,6 +251,8 @@ BackgroundMCCCollision::BackgroundMCCCollision (std::string const& collision_nam
     utils::parser::queryWithParser(
         pp_collision_name, "background_mass", m_background_mass);
 
+    pp_collision_name.query("geometric_skipping", m_geometric_skipping);
+
     // query for a list of collision processes
     // these could be elastic, excitation, charge_exchange, back, etc.
     amrex::Vector<std::string> scattering_process_names;
@@ -156,6 +324,10 @@ BackgroundMCCCollision::BackgroundMCCCollision (std::string const& collision_nam
         m_ionization_processes_exe.push_back(p.executor());
     }
 #endif
+
+    if (!m_scattering_processes.empty()) {
+        m_scattering_table = ScatteringProcessTable(m_scattering_processes);
+    }
 }
 
 /** Calculate the maximum collision frequency using a fixed energy grid that
@@ -319,147 +491,79 @@ void BackgroundMCCCollision::doBackgroundCollisionsWithinTile
     // get particle count
     const long np = pti.numParticles();
 
-    // get parsers for the background density and temperature
-    auto n_a_func = m_background_density_func;
-    auto T_a_func = m_background_temperature_func;
-
-    // get collision parameters
-    auto *scattering_processes = m_scattering_processes_exe.data();
-    auto const process_count  = static_cast<int>(m_scattering_processes_exe.size());
-
     auto const total_collision_prob = m_total_collision_prob;
-    auto const nu_max = m_nu_max;
 
-    // store projectile and target masses
+    // store projectile mass and precalculate often used value
     auto const m = m_mass1;
-    auto const M = m_background_mass;
-
-    // precalculate often used value
     constexpr auto c2 = PhysConst::c * PhysConst::c;
-    auto const mc2 = m*c2;
-
-    // we need particle positions in order to calculate the local density
-    // and temperature
-    auto GetPosition = GetParticlePosition<PIdx>(pti);
 
     // get Struct-Of-Array particle data, also called attribs
     auto& attribs = pti.GetAttribs();
-    amrex::ParticleReal* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr();
-    amrex::ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr();
-    amrex::ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr();
 
-    amrex::ParallelForRNG(np,
-                          [=] AMREX_GPU_HOST_DEVICE (long ip, amrex::RandomEngine const& engine)
+    auto const collide = BackgroundCollisionFunc{
+        t, m_background_density_func, m_background_temperature_func,
+        m_scattering_processes_exe.data(), static_cast<int>(m_scattering_processes_exe.size()),
+        m_nu_max, m_scattering_table.executor(), m, m_background_mass, m*c2,
+        // we need particle positions in order to calculate the local density
+        // and temperature
+        GetParticlePosition<PIdx>(pti),
+        attribs[PIdx::ux].dataPtr(), attribs[PIdx::uy].dataPtr(), attribs[PIdx::uz].dataPtr()};
+
+    if (WarpX::use_counter_based_rng) {
+        // One counter-based stream per particle, collision and step: the collisions do not
+        // depend on the decomposition of the domain and on the launch configuration
+        const auto* const AMREX_RESTRICT idcpu = pti.GetStructOfArrays().GetIdCPUData().data();
+        const auto step = static_cast<std::uint32_t>(WarpX::GetInstance().getistep(0));
+        const auto stream = m_rng_stream;
+        amrex::ParallelFor(np,
+                           [=] AMREX_GPU_DEVICE (long ip)
+                           {
+                             const utils::random::CounterBasedRandomEngine engine(idcpu[ip], step, stream);
+                             if (Random(engine) > total_collision_prob) { return; }
+                             collide(ip, engine);
+                           });
+        return;
+    }
+
+    // Null-collision method: each particle is a collision candidate with the probability
+    // total_collision_prob
+    if (!m_geometric_skipping) {
+        amrex::ParallelForRNG(np,
+                              [=] AMREX_GPU_HOST_DEVICE (long ip, amrex::RandomEngine const& engine)
+                              {
+                                // determine if this particle should collide
+                                if (amrex::Random(engine) > total_collision_prob) { return; }
+                                collide(ip, engine);
+                              });
+        return;
+    }
+
+    if (total_collision_prob <= 0._prt) { return; }
+
+    // Instead of drawing one random number per particle, each thread handles a chunk of
+    // particles, and jumps from one candidate to the next with a geometrically distributed
+    // number of skipped particles, which follows the same distribution. With low collision
+    // probabilities, only a few random numbers are drawn per chunk.
+    const long chunk_size = std::max(1L, std::min(256L,
+        static_cast<long>(1._prt/total_collision_prob)));
+    const long n_chunks = (np + chunk_size - 1)/chunk_size;
+    const double log_no_collision_prob = std::log1p(-static_cast<double>(total_collision_prob));
+
+    auto const get_skip = GeometricSkip{log_no_collision_prob, chunk_size};
+
+    amrex::ParallelForRNG(n_chunks,
+                          [=] AMREX_GPU_HOST_DEVICE (long ichunk, amrex::RandomEngine const& engine)
                           {
-                              // determine if this particle should collide
-                              if (amrex::Random(engine) > total_collision_prob) { return; }
-
-                              amrex::ParticleReal x, y, z;
-                              GetPosition.AsStored(ip, x, y, z);
-
-                              const amrex::ParticleReal n_a = n_a_func(x, y, z, t);
-                              const amrex::ParticleReal T_a = T_a_func(x, y, z, t);
-
-                              amrex::ParticleReal v_coll, v_coll2, sigma_E, nu_i = 0;
-                              double gamma, E_coll;
-                              amrex::ParticleReal ua_x, ua_y, ua_z, vx, vy, vz;
-                              amrex::ParticleReal uCOM_x, uCOM_y, uCOM_z;
-                              const amrex::ParticleReal col_select = amrex::Random(engine);
-
-                              // get velocities of gas particles from a Maxwellian distribution
-                              auto const vel_std = sqrt(PhysConst::kb * T_a / M);
-                              ua_x = vel_std * amrex::RandomNormal(0_prt, 1.0_prt, engine);
-                              ua_y = vel_std * amrex::RandomNormal(0_prt, 1.0_prt, engine);
-                              ua_z = vel_std * amrex::RandomNormal(0_prt, 1.0_prt, engine);
-
-                              // we assume the target particle is not relativistic (in
-                              // the lab frame) and therefore we can transform the projectile
-                              // velocity to a frame in which the target is stationary with
-                              // a simple Galilean boost
-                              // not doing the full Lorentz boost here saves us computation
-                              // since most particles will not actually collide
-                              vx = ux[ip] - ua_x;
-                              vy = uy[ip] - ua_y;
-                              vz = uz[ip] - ua_z;
-                              v_coll2 = (vx*vx + vy*vy + vz*vz);
-                              v_coll = std::sqrt(v_coll2);
-
-                              // calculate the collision energy in eV
-                              ParticleUtils::getCollisionEnergy(v_coll2, m, M, gamma, E_coll);
-
-                              // loop through all collision pathways
-                              for (int i = 0; i < process_count; i++) {
-                                  auto const& scattering_process = *(scattering_processes + i);
-
-                                  // get collision cross-section
-                                  sigma_E = scattering_process.getCrossSection(static_cast<amrex::ParticleReal>(E_coll));
-
-                                  // calculate normalized collision frequency
-                                  nu_i += n_a * sigma_E * v_coll / nu_max;
-
-                                  // check if this collision should be performed
-                                  if (col_select > nu_i) { continue; }
-
-                                  // charge exchange is implemented as a simple swap of the projectile
-                                  // and target velocities which doesn't require any of the Lorentz
-                                  // transformations below; note that if the projectile and target
-                                  // have the same mass this is identical to back scattering
-                                  if (scattering_process.m_type == ScatteringProcessType::CHARGE_EXCHANGE) {
-                                      ux[ip] = ua_x;
-                                      uy[ip] = ua_y;
-                                      uz[ip] = ua_z;
-                                      break;
-                                  }
-
-                                  // At this point the given particle has been chosen for a collision
-                                  // and so we perform the needed calculations to transform to the
-                                  // COM frame.
-                                  uCOM_x = static_cast<amrex::ParticleReal>(m * vx / (gamma * m + M));
-                                  uCOM_y = static_cast<amrex::ParticleReal>(m * vy / (gamma * m + M));
-                                  uCOM_z = static_cast<amrex::ParticleReal>(m * vz / (gamma * m + M));
-
-                                  // subtract any energy penalty of the collision from the
-                                  // projectile energy
-                                  if (scattering_process.m_energy_penalty > 0.0_prt) {
-                                      ParticleUtils::getEnergy(v_coll2, m, E_coll);
-                                      E_coll = (E_coll - scattering_process.m_energy_penalty) * PhysConst::q_e;
-                                      const auto scale_fac = static_cast<amrex::ParticleReal>(
-                                        std::sqrt(E_coll * (E_coll + 2.0_prt*mc2) / c2) / m / v_coll);
-                                      vx *= scale_fac;
-                                      vy *= scale_fac;
-                                      vz *= scale_fac;
-                                  }
-
-                                  // transform to COM frame
-                                  ParticleUtils::doLorentzTransform(vx, vy, vz, uCOM_x, uCOM_y, uCOM_z);
-
-                                  if ((scattering_process.m_type == ScatteringProcessType::ELASTIC)
-                                      || (scattering_process.m_type == ScatteringProcessType::EXCITATION)) {
-                                      ParticleUtils::RandomizeVelocity(
-                                          vx, vy, vz, sqrt(vx*vx + vy*vy + vz*vz), engine
-                                      );
-                                  }
-                                  else if (scattering_process.m_type == ScatteringProcessType::BACK) {
-                                      // elastic scattering with cos(chi) = -1 (i.e. 180 degrees)
-                                      vx *= -1.0_prt;
-                                      vy *= -1.0_prt;
-                                      vz *= -1.0_prt;
-                                  }
-
-                                  // transform back to scattering frame
-                                  ParticleUtils::doLorentzTransform(vx, vy, vz, -uCOM_x, -uCOM_y, -uCOM_z);
-
-                                  // update particle velocity with new components in labframe
-                                  ux[ip] = vx + ua_x;
-                                  uy[ip] = vy + ua_y;
-                                  uz[ip] = vz + ua_z;
-                                  break;
-                              }
+                            const long ip_end = std::min(np, (ichunk+1)*chunk_size);
+                            for (long ip = ichunk*chunk_size + get_skip(engine); ip < ip_end;
+                                 ip += 1 + get_skip(engine))
+                            {
+                              collide(ip, engine);
+                            }
                           }
                           );
 }
 
-
 void BackgroundMCCCollision::doBackgroundIonization
 ( int lev, amrex::LayoutData<amrex::Real>* cost,
   WarpXParticleContainer& species1, WarpXParticleContainer& species2, amrex::Real t)
@@ -503,7 +607,8 @@ void BackgroundMCCCollision::doBackgroundIonization
 
         const auto num_added = filterCopyTransformParticles<1>(species1, species2,
                                                                elec_tile, ion_tile, elec_tile, np_elec, np_ion,
-                                                               Filter, CopyElec, CopyIon, Transform
+                                                               Filter, CopyElec, CopyIon, Transform,
+                                                               species1.getCreationScratch(lev, pti.index(), pti.LocalTileIndex())
                                                                );
 
         setNewParticleIDs(elec_tile, np_elec, num_added);
@@ -76,4 +76,7 @@ DSMCFunc::DSMCFunc (
     // Link executor to appropriate ScatteringProcess executors
     m_exe.m_scattering_processes_data = m_scattering_processes_exe.data();
     m_exe.m_process_count = process_count;
+
+    m_scattering_table = ScatteringProcessTable(m_scattering_processes);
+    m_exe.m_scattering_table = m_scattering_table.executor();
 }
@@ -14,6 +14,7 @@
 #include "Particles/Collision/BinaryCollision/DSMC/SplitAndScatterFunc.H"
 #include "Particles/Collision/BinaryCollision/NuclearFusion/NuclearFusionFunc.H"
 #include "Particles/Collision/BinaryCollision/ParticleCreationFunc.H"
+#include "Particles/Collision/LangevinCoulomb/LangevinCoulombCollision.H"
 #include "Utils/TextMsg.H"
 
 #include <AMReX_ParmParse.H>
@@ -61,6 +62,9 @@ CollisionHandler::CollisionHandler(MultiParticleContainer const * const mypc)
                     collision_names[i], mypc
                 );
         }
+        else if (type == "langevincoulomb") {
+            allcollisions[i] = std::make_unique<LangevinCoulombCollision>(collision_names[i]);
+        }
         else if (type == "nuclearfusion") {
             allcollisions[i] =
                std::make_unique<BinaryCollision<NuclearFusionFunc, ParticleCreationFunc>>(
@@ -71,6 +75,8 @@ CollisionHandler::CollisionHandler(MultiParticleContainer const * const mypc)
             WARPX_ABORT_WITH_MESSAGE("Unknown collision type.");
         }
 
+        allcollisions[i]->setParticleBinsCache(&m_bins_cache);
+
     }
 
 }
@@ -85,10 +91,14 @@ CollisionHandler::CollisionHandler(MultiParticleContainer const * const mypc)
 void CollisionHandler::doCollisions ( amrex::Real cur_time, amrex::Real dt, MultiParticleContainer* mypc)
 {
 
+    // The particles were pushed since the last collision step
+    m_bins_cache.invalidate();
+
     for (auto& collision : allcollisions) {
         int const ndt = collision->get_ndt();
         if ( int(std::floor(cur_time/dt)) % ndt == 0 ) {
             collision->doCollisions(cur_time, dt*ndt, mypc);
+            if (collision->createsOrRemovesParticles()) { m_bins_cache.invalidate(); }
         }
     }
 
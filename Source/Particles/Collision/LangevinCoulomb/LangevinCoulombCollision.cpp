@@ -0,0 +1,445 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "LangevinCoulombCollision.H"
+
+#include "Particles/Collision/ParticleBinsCache.H"
+#include "Utils/Parser/ParserUtils.H"
+#include "Utils/ParticleUtils.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
+
+#include <AMReX_Algorithm.H>
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_LayoutData.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Random.H>
+#include <AMReX_REAL.H>
+
+#include <cmath>
+#include <string>
+
+namespace
+{
+    using index_type = LangevinCoulombCollision::index_type;
+    using SoaData_type = WarpXParticleContainer::ParticleTileType::ParticleTileDataType;
+
+    /** Quantities stored for each cell and each species */
+    struct CellIdx
+    {
+        enum {
+            do_collide = 0,
+            vx, vy, vz, T,             // moments before the update
+            vx_new, vy_new, vz_new, T_new, // moments after the relaxation
+            alpha,                     // drag factor of the Langevin step
+            n
+        };
+    };
+
+    /** Velocity of particle ip in the frame used for the cell moments: Cartesian, or
+     *  (r, theta, z) in RZ geometry, where the cells are rings */
+    struct LocalVelocity
+    {
+        amrex::ParticleReal* AMREX_RESTRICT ux;
+        amrex::ParticleReal* AMREX_RESTRICT uy;
+        amrex::ParticleReal* AMREX_RESTRICT uz;
+#if defined(WARPX_DIM_RZ)
+        amrex::ParticleReal const* AMREX_RESTRICT theta;
+#endif
+
+        LocalVelocity (SoaData_type const& soa)
+            : ux{soa.m_rdata[PIdx::ux]}, uy{soa.m_rdata[PIdx::uy]}, uz{soa.m_rdata[PIdx::uz]}
+#if defined(WARPX_DIM_RZ)
+            , theta{soa.m_rdata[PIdx::theta]}
+#endif
+        {}
+
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        void get (index_type ip, amrex::ParticleReal& u1, amrex::ParticleReal& u2,
+                  amrex::ParticleReal& u3) const
+        {
+#if defined(WARPX_DIM_RZ)
+            const amrex::ParticleReal c = std::cos(theta[ip]);
+            const amrex::ParticleReal s = std::sin(theta[ip]);
+            u1 = c*ux[ip] + s*uy[ip];
+            u2 = -s*ux[ip] + c*uy[ip];
+#else
+            u1 = ux[ip];
+            u2 = uy[ip];
+#endif
+            u3 = uz[ip];
+        }
+
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        void set (index_type ip, amrex::ParticleReal u1, amrex::ParticleReal u2,
+                  amrex::ParticleReal u3) const
+        {
+#if defined(WARPX_DIM_RZ)
+            const amrex::ParticleReal c = std::cos(theta[ip]);
+            const amrex::ParticleReal s = std::sin(theta[ip]);
+            ux[ip] = c*u1 - s*u2;
+            uy[ip] = s*u1 + c*u2;
+#else
+            ux[ip] = u1;
+            uy[ip] = u2;
+#endif
+            uz[ip] = u3;
+        }
+    };
+
+    /** Total weight, mean velocity and temperature of the particles I[Is:Ie] of a cell
+     *  (non-relativistic) */
+    AMREX_GPU_HOST_DEVICE AMREX_INLINE
+    void CellMoments (index_type Is, index_type Ie, index_type const* AMREX_RESTRICT I,
+                      amrex::ParticleReal const* AMREX_RESTRICT w, LocalVelocity const& u,
+                      amrex::ParticleReal m, amrex::ParticleReal& wsum, amrex::ParticleReal& vx,
+                      amrex::ParticleReal& vy, amrex::ParticleReal& vz, amrex::ParticleReal& T)
+    {
+        using namespace amrex::literals;
+        wsum = 0._prt; vx = 0._prt; vy = 0._prt; vz = 0._prt;
+        amrex::ParticleReal u2 = 0._prt;
+        for (index_type i = Is; i < Ie; ++i) {
+            amrex::ParticleReal u1p, u2p, u3p;
+            u.get(I[i], u1p, u2p, u3p);
+            const amrex::ParticleReal wp = w[I[i]];
+            wsum += wp;
+            vx += wp*u1p;
+            vy += wp*u2p;
+            vz += wp*u3p;
+            u2 += wp*(u1p*u1p + u2p*u2p + u3p*u3p);
+        }
+        if (wsum <= 0._prt) { T = 0._prt; return; }
+        vx /= wsum; vy /= wsum; vz /= wsum;
+        T = amrex::max(m/3._prt*(u2/wsum - (vx*vx + vy*vy + vz*vz)), 0._prt);
+    }
+
+    /** Langevin step of the particles of one species, followed by the shift and rescaling
+     *  of their velocities to the mean velocity and temperature of the relaxation */
+    void UpdateVelocities (int n_cells, index_type np, index_type const* AMREX_RESTRICT cell_offsets,
+                           index_type const* AMREX_RESTRICT indices, SoaData_type const& soa,
+                           amrex::ParticleReal m, amrex::ParticleReal* AMREX_RESTRICT cell_data)
+    {
+        using namespace amrex::literals;
+        const LocalVelocity u(soa);
+        amrex::ParticleReal const* AMREX_RESTRICT w = soa.m_rdata[PIdx::w];
+        constexpr int nc = CellIdx::n;
+
+        // Drag toward the new mean velocity and random kicks
+        amrex::ParallelForRNG(np,
+            [=] AMREX_GPU_DEVICE (index_type i, amrex::RandomEngine const& engine) noexcept
+            {
+                const int i_cell = amrex::bisect(cell_offsets, 0, n_cells, i);
+                amrex::ParticleReal const* AMREX_RESTRICT c = cell_data + nc*i_cell;
+                if (c[CellIdx::do_collide] == 0._prt) { return; }
+                const amrex::ParticleReal alpha = c[CellIdx::alpha];
+                const amrex::ParticleReal sigma = std::sqrt(amrex::max(
+                    (c[CellIdx::T_new] - alpha*alpha*c[CellIdx::T])/m, 0._prt));
+                const index_type ip = indices[i];
+                amrex::ParticleReal u1, u2, u3;
+                u.get(ip, u1, u2, u3);
+                u1 = c[CellIdx::vx_new] + alpha*(u1 - c[CellIdx::vx]) + sigma*amrex::RandomNormal(0._prt, 1._prt, engine);
+                u2 = c[CellIdx::vy_new] + alpha*(u2 - c[CellIdx::vy]) + sigma*amrex::RandomNormal(0._prt, 1._prt, engine);
+                u3 = c[CellIdx::vz_new] + alpha*(u3 - c[CellIdx::vz]) + sigma*amrex::RandomNormal(0._prt, 1._prt, engine);
+                u.set(ip, u1, u2, u3);
+            });
+
+        // Moments after the Langevin step, which differ from the new moments by the noise
+        amrex::ParallelFor(n_cells,
+            [=] AMREX_GPU_DEVICE (int i_cell) noexcept
+            {
+                amrex::ParticleReal* AMREX_RESTRICT c = cell_data + nc*i_cell;
+                if (c[CellIdx::do_collide] == 0._prt) { return; }
+                amrex::ParticleReal wsum;
+                CellMoments(cell_offsets[i_cell], cell_offsets[i_cell+1], indices, w, u, m,
+                            wsum, c[CellIdx::vx], c[CellIdx::vy], c[CellIdx::vz], c[CellIdx::T]);
+            });
+
+        // Shift and rescale the velocities, for the exact conservation of momentum and energy
+        amrex::ParallelFor(np,
+            [=] AMREX_GPU_DEVICE (index_type i) noexcept
+            {
+                const int i_cell = amrex::bisect(cell_offsets, 0, n_cells, i);
+                amrex::ParticleReal const* AMREX_RESTRICT c = cell_data + nc*i_cell;
+                if (c[CellIdx::do_collide] == 0._prt) { return; }
+                const amrex::ParticleReal scale = (c[CellIdx::T] > 0._prt) ?
+                    std::sqrt(c[CellIdx::T_new]/c[CellIdx::T]) : 0._prt;
+                const index_type ip = indices[i];
+                amrex::ParticleReal u1, u2, u3;
+                u.get(ip, u1, u2, u3);
+                u.set(ip, c[CellIdx::vx_new] + scale*(u1 - c[CellIdx::vx]),
+                          c[CellIdx::vy_new] + scale*(u2 - c[CellIdx::vy]),
+                          c[CellIdx::vz_new] + scale*(u3 - c[CellIdx::vz]));
+            });
+    }
+}
+
+LangevinCoulombCollision::LangevinCoulombCollision (std::string const& collision_name)
+    : CollisionBase(collision_name)
+{
+    using namespace amrex::literals;
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_species_names.size() == 1 || m_species_names.size() == 2,
+        "Collision " + collision_name + " (langevincoulomb) must have one or two species.");
+    if (m_species_names.size() == 1) { m_species_names.push_back(m_species_names[0]); }
+    m_isSameSpecies = (m_species_names[0] == m_species_names[1]);
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::n_rz_azimuthal_modes==1,
+        "RZ mode `warpx.n_rz_azimuthal_modes` must be 1 when using the langevincoulomb collisions.");
+
+    const amrex::ParmParse pp_collision_name(collision_name);
+    // default Coulomb log, if < 0, will be computed automatically
+    amrex::ParticleReal CoulombLog = -1.0_prt;
+    utils::parser::queryWithParser(pp_collision_name, "CoulombLog", CoulombLog);
+    m_CoulombLog = CoulombLog;
+}
+
+void
+LangevinCoulombCollision::doCollisions (amrex::Real cur_time, amrex::Real dt, MultiParticleContainer* mypc)
+{
+    WARPX_PROFILE("LangevinCoulombCollision::doCollisions()");
+    amrex::ignore_unused(cur_time);
+
+    auto& species1 = mypc->GetParticleContainerFromName(m_species_names[0]);
+    auto& species2 = mypc->GetParticleContainerFromName(m_species_names[1]);
+
+    // Enable tiling
+    amrex::MFItInfo info;
+    if (amrex::Gpu::notInLaunchRegion()) { info.EnableTiling(species1.tile_size); }
+
+    // Loop over refinement levels
+    for (int lev = 0; lev <= species1.finestLevel(); ++lev) {
+
+        amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+
+        if (m_bins_cache) {
+            // Create the entries of the shared bins outside of the parallel region
+            m_bins_cache->prepare(m_species_names[0], species1, lev, info);
+            if (!m_isSameSpecies) { m_bins_cache->prepare(m_species_names[1], species2, lev, info); }
+        }
+
+        // Loop over all grids/tiles at this level
+#ifdef AMREX_USE_OMP
+        info.SetDynamic(true);
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (amrex::MFIter mfi = species1.MakeMFIter(lev, info); mfi.isValid(); ++mfi) {
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                amrex::Gpu::synchronize();
+            }
+            auto wt = static_cast<amrex::Real>(amrex::second());
+
+            doCollisionsWithinTile(dt, lev, mfi, species1, species2);
+
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                amrex::Gpu::synchronize();
+                wt = static_cast<amrex::Real>(amrex::second()) - wt;
+                amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            }
+        }
+    }
+}
+
+LangevinCoulombCollision::ParticleBins&
+LangevinCoulombCollision::getParticleBins (
+    const std::string& species_name, int const lev, amrex::MFIter const& mfi,
+    ParticleTileType& ptile, ParticleBins& local_bins)
+{
+    if (m_bins_cache) {
+        return m_bins_cache->getBins(species_name, lev, mfi, ptile);
+    }
+    local_bins = ParticleUtils::findParticlesInEachCell(lev, mfi, ptile);
+    return local_bins;
+}
+
+void
+LangevinCoulombCollision::doCollisionsWithinTile (
+    amrex::Real dt, int const lev, amrex::MFIter const& mfi,
+    WarpXParticleContainer& species_1, WarpXParticleContainer& species_2)
+{
+    using namespace amrex::literals;
+
+    ParticleTileType& ptile_1 = species_1.ParticlesAt(lev, mfi);
+    ParticleTileType& ptile_2 = species_2.ParticlesAt(lev, mfi);
+    ParticleBins local_bins_1, local_bins_2;
+    ParticleBins& bins_1 = getParticleBins(m_species_names[0], lev, mfi, ptile_1, local_bins_1);
+    ParticleBins& bins_2 = m_isSameSpecies ? bins_1 :
+        getParticleBins(m_species_names[1], lev, mfi, ptile_2, local_bins_2);
+
+    auto const n_cells = static_cast<int>(bins_1.numBins());
+    if (n_cells == 0) { return; }
+
+    const auto soa_1 = ptile_1.getParticleTileData();
+    const auto soa_2 = ptile_2.getParticleTileData();
+    const LocalVelocity u_1(soa_1);
+    const LocalVelocity u_2(soa_2);
+    amrex::ParticleReal const* AMREX_RESTRICT w_1 = soa_1.m_rdata[PIdx::w];
+    amrex::ParticleReal const* AMREX_RESTRICT w_2 = soa_2.m_rdata[PIdx::w];
+    index_type const* AMREX_RESTRICT indices_1 = bins_1.permutationPtr();
+    index_type const* AMREX_RESTRICT indices_2 = bins_2.permutationPtr();
+    index_type const* AMREX_RESTRICT cell_offsets_1 = bins_1.offsetsPtr();
+    index_type const* AMREX_RESTRICT cell_offsets_2 = bins_2.offsetsPtr();
+    const amrex::ParticleReal q1 = species_1.getCharge();
+    const amrex::ParticleReal m1 = species_1.getMass();
+    const amrex::ParticleReal q2 = species_2.getCharge();
+    const amrex::ParticleReal m2 = species_2.getMass();
+    const bool is_same_species = m_isSameSpecies;
+    const amrex::ParticleReal CoulombLog = m_CoulombLog;
+    const auto dt_prt = static_cast<amrex::ParticleReal>(dt);
+
+    amrex::Geometry const& geom = WarpX::GetInstance().Geom(lev);
+#if defined WARPX_DIM_1D_Z
+    auto dV = geom.CellSize(0);
+#elif defined WARPX_DIM_XZ
+    auto dV = geom.CellSize(0) * geom.CellSize(1);
+#elif defined WARPX_DIM_RZ
+    amrex::Box const& cbx = mfi.tilebox(amrex::IntVect::TheZeroVector()); //Cell-centered box
+    const auto lo = lbound(cbx);
+    const auto hi = ubound(cbx);
+    int const nz = hi.y-lo.y+1;
+    auto dr = geom.CellSize(0);
+    auto dz = geom.CellSize(1);
+#elif defined(WARPX_DIM_3D)
+    auto dV = geom.CellSize(0) * geom.CellSize(1) * geom.CellSize(2);
+#endif
+
+    constexpr int nc = CellIdx::n;
+    amrex::Gpu::DeviceVector<amrex::ParticleReal> cell_data_1(nc*n_cells);
+    amrex::Gpu::DeviceVector<amrex::ParticleReal> cell_data_2(is_same_species ? 0 : nc*n_cells);
+    amrex::ParticleReal* AMREX_RESTRICT p_cell_data_1 = cell_data_1.dataPtr();
+    amrex::ParticleReal* AMREX_RESTRICT p_cell_data_2 = cell_data_2.dataPtr();
+
+    // Moments of the species and relaxation of their drift and temperatures in each cell
+    amrex::ParallelFor(n_cells,
+        [=] AMREX_GPU_DEVICE (int i_cell) noexcept
+        {
+#if defined WARPX_DIM_RZ
+            const int ri = lo.x + i_cell/nz;
+            auto dV = MathConst::pi*(2.0_prt*ri+1.0_prt)*dr*dr*dz;
+#endif
+            amrex::ParticleReal* AMREX_RESTRICT c1 = p_cell_data_1 + nc*i_cell;
+            amrex::ParticleReal* AMREX_RESTRICT c2 = is_same_species ? c1 : p_cell_data_2 + nc*i_cell;
+
+            const index_type N1 = cell_offsets_1[i_cell+1] - cell_offsets_1[i_cell];
+            const index_type N2 = cell_offsets_2[i_cell+1] - cell_offsets_2[i_cell];
+            c1[CellIdx::do_collide] = 0._prt;
+            c2[CellIdx::do_collide] = 0._prt;
+            // The temperatures are not defined with fewer than 2 particles per cell
+            if (N1 < 2 || N2 < 2) { return; }
+
+            amrex::ParticleReal w1s, w2s;
+            CellMoments(cell_offsets_1[i_cell], cell_offsets_1[i_cell+1], indices_1, w_1, u_1, m1,
+                        w1s, c1[CellIdx::vx], c1[CellIdx::vy], c1[CellIdx::vz], c1[CellIdx::T]);
+            if (!is_same_species) {
+                CellMoments(cell_offsets_2[i_cell], cell_offsets_2[i_cell+1], indices_2, w_2, u_2, m2,
+                            w2s, c2[CellIdx::vx], c2[CellIdx::vy], c2[CellIdx::vz], c2[CellIdx::T]);
+            } else {
+                w2s = w1s;
+            }
+            if (w1s <= 0._prt || w2s <= 0._prt) { return; }
+
+            const amrex::ParticleReal n1 = w1s/dV;
+            const amrex::ParticleReal n2 = w2s/dV;
+            const amrex::ParticleReal T1 = c1[CellIdx::T];
+            const amrex::ParticleReal T2 = c2[CellIdx::T];
+            const amrex::ParticleReal Wx = c1[CellIdx::vx] - c2[CellIdx::vx];
+            const amrex::ParticleReal Wy = c1[CellIdx::vy] - c2[CellIdx::vy];
+            const amrex::ParticleReal Wz = c1[CellIdx::vz] - c2[CellIdx::vz];
+            const amrex::ParticleReal W2 = Wx*Wx + Wy*Wy + Wz*Wz;
+            const amrex::ParticleReal vth2 = T1/m1 + T2/m2;
+            if (vth2 + W2 <= 0._prt) { return; }
+
+            const amrex::ParticleReal mu = m1*m2/(m1 + m2);
+            const amrex::ParticleReal ep0 = PhysConst::ep0;
+
+            // Coulomb logarithm, as in UpdateMomentumPerezElastic but with the cell moments
+            amrex::ParticleReal lnLmd = CoulombLog;
+            if (lnLmd <= 0._prt) {
+                amrex::ParticleReal inv_lmdD2 = 0._prt;
+                if (T1 > 0._prt) { inv_lmdD2 += n1*q1*q1/(ep0*T1); }
+                if (!is_same_species && T2 > 0._prt) { inv_lmdD2 += n2*q2*q2/(ep0*T2); }
+                const amrex::ParticleReal urel2 = 3._prt*vth2 + W2;
+                const amrex::ParticleReal b0 = amrex::Math::abs(q1*q2)/
+                    (4._prt*MathConst::pi*ep0*mu*urel2);
+                const amrex::ParticleReal bq = PhysConst::hbar/(2._prt*mu*std::sqrt(urel2));
+                const amrex::ParticleReal bmin = amrex::max(b0, bq);
+                lnLmd = (inv_lmdD2 > 0._prt) ?
+                    amrex::max(2._prt, 0.5_prt*std::log(1._prt + 1._prt/(inv_lmdD2*bmin*bmin))) : 2._prt;
+            }
+
+            // Momentum-exchange rate of two drifting Maxwellians: G/(ep0^2 m mu) times the
+            // density of the other species and q1^2 q2^2 lnLmd, with
+            // G = 1/(3 (2 pi)^(3/2) vth^3) F(x), F(x) = 3 sqrt(pi)/4 (erf(x) - 2x exp(-x^2)/sqrt(pi))/x^3,
+            // x = W/sqrt(2 vth^2), which tends to (4 pi W^3)^(-1) for a cold beam
+            amrex::ParticleReal G;
+            if (vth2 <= 0._prt) {
+                G = 1._prt/(4._prt*MathConst::pi*W2*std::sqrt(W2));
+            } else {
+                const amrex::ParticleReal x2 = W2/(2._prt*vth2);
+                if (x2 < 0.01_prt) {
+                    G = (1._prt - 0.6_prt*x2 + 3._prt/14._prt*x2*x2)/
+                        (3._prt*std::pow(2._prt*MathConst::pi*vth2, 1.5_prt));
+                } else {
+                    const amrex::ParticleReal x = std::sqrt(x2);
+                    G = (std::erf(x) - 2._prt*x*std::exp(-x2)/std::sqrt(MathConst::pi))/
+                        (4._prt*MathConst::pi*W2*std::sqrt(W2));
+                }
+            }
+            const amrex::ParticleReal coef = q1*q1*q2*q2*lnLmd*G/(ep0*ep0*mu);
+            const amrex::ParticleReal nu12 = n2*coef/m1;
+            const amrex::ParticleReal nu21 = n1*coef/m2;
+
+            if (is_same_species) {
+                // Only the isotropization, at the rate nu11: the drift and temperature are unchanged
+                c1[CellIdx::vx_new] = c1[CellIdx::vx];
+                c1[CellIdx::vy_new] = c1[CellIdx::vy];
+                c1[CellIdx::vz_new] = c1[CellIdx::vz];
+                c1[CellIdx::T_new] = T1;
+            } else {
+                // The relative drift decays, at constant total momentum
+                const amrex::ParticleReal rho1 = m1*n1;
+                const amrex::ParticleReal rho2 = m2*n2;
+                const amrex::ParticleReal f1 = rho1/(rho1 + rho2);
+                const amrex::ParticleReal f2 = rho2/(rho1 + rho2);
+                const amrex::ParticleReal decay_W = std::exp(-(nu12 + nu21)*dt_prt);
+                c1[CellIdx::vx_new] = f1*c1[CellIdx::vx] + f2*c2[CellIdx::vx] + f2*decay_W*Wx;
+                c1[CellIdx::vy_new] = f1*c1[CellIdx::vy] + f2*c2[CellIdx::vy] + f2*decay_W*Wy;
+                c1[CellIdx::vz_new] = f1*c1[CellIdx::vz] + f2*c2[CellIdx::vz] + f2*decay_W*Wz;
+                c2[CellIdx::vx_new] = c1[CellIdx::vx_new] - decay_W*Wx;
+                c2[CellIdx::vy_new] = c1[CellIdx::vy_new] - decay_W*Wy;
+                c2[CellIdx::vz_new] = c1[CellIdx::vz_new] - decay_W*Wz;
+
+                // The temperature difference decays, and the kinetic energy lost by the drift
+                // heats the species, at constant total energy
+                const amrex::ParticleReal heating = rho1*f2*W2*(1._prt - decay_W*decay_W)/3._prt;
+                const amrex::ParticleReal nu12_e = 2._prt*m1/(m1 + m2)*nu12;
+                const amrex::ParticleReal nu21_e = 2._prt*m2/(m1 + m2)*nu21;
+                const amrex::ParticleReal dT = (T1 - T2)*std::exp(-(nu12_e + nu21_e)*dt_prt);
+                const amrex::ParticleReal S = n1*T1 + n2*T2 + heating;
+                c1[CellIdx::T_new] = (S + n2*dT)/(n1 + n2);
+                c2[CellIdx::T_new] = (S - n1*dT)/(n1 + n2);
+                c2[CellIdx::alpha] = std::exp(-nu21*dt_prt);
+                c2[CellIdx::do_collide] = 1._prt;
+            }
+            c1[CellIdx::alpha] = std::exp(-nu12*dt_prt);
+            c1[CellIdx::do_collide] = 1._prt;
+        });
+
+    UpdateVelocities(n_cells, static_cast<index_type>(ptile_1.numParticles()), cell_offsets_1,
+                     indices_1, soa_1, m1, p_cell_data_1);
+    if (!is_same_species) {
+        UpdateVelocities(n_cells, static_cast<index_type>(ptile_2.numParticles()), cell_offsets_2,
+                         indices_2, soa_2, m2, p_cell_data_2);
+    }
+
+    amrex::Gpu::streamSynchronize();
+}
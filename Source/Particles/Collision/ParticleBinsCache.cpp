@@ -0,0 +1,59 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ParticleBinsCache.H"
+
+#include "Utils/ParticleUtils.H"
+#include "Utils/TextMsg.H"
+
+void
+ParticleBinsCache::prepare (const std::string& species_name, WarpXParticleContainer& pc,
+                            int lev, const amrex::MFItInfo& info)
+{
+    auto& bins_species = m_bins[species_name];
+    if (static_cast<int>(bins_species.size()) <= lev) {
+        bins_species.resize(lev+1);
+    }
+    auto& tiles = bins_species[lev];
+    for (amrex::MFIter mfi = pc.MakeMFIter(lev, info); mfi.isValid(); ++mfi) {
+        tiles.try_emplace(std::make_pair(mfi.index(), mfi.LocalTileIndex()));
+    }
+}
+
+ParticleBinsCache::ParticleBins&
+ParticleBinsCache::getBins (const std::string& species_name, int lev,
+                            const amrex::MFIter& mfi, ParticleTileType& ptile)
+{
+    auto const it_species = m_bins.find(species_name);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        it_species != m_bins.end() && static_cast<int>(it_species->second.size()) > lev,
+        "ParticleBinsCache::getBins: prepare was not called for species " + species_name);
+    auto& tiles = it_species->second[lev];
+    auto const it_tile = tiles.find(std::make_pair(mfi.index(), mfi.LocalTileIndex()));
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(it_tile != tiles.end(),
+        "ParticleBinsCache::getBins: unknown tile for species " + species_name);
+
+    Entry& entry = it_tile->second;
+    const auto np = static_cast<int>(ptile.numParticles());
+    if (!entry.is_valid || entry.num_particles != np) {
+        entry.bins = ParticleUtils::findParticlesInEachCell(lev, mfi, ptile);
+        entry.num_particles = np;
+        entry.is_valid = true;
+    }
+    return entry.bins;
+}
+
+void
+ParticleBinsCache::invalidate ()
+{
+    for (auto& bins_species : m_bins) {
+        for (auto& tiles : bins_species.second) {
+            for (auto& tile : tiles) {
+                tile.second.is_valid = false;
+            }
+        }
+    }
+}
@@ -0,0 +1,74 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ScatteringProcessTable.H"
+
+#include "Utils/TextMsg.H"
+
+#include <AMReX_Algorithm.H>
+
+#include <cmath>
+
+ScatteringProcessTable::ScatteringProcessTable (const amrex::Vector<ScatteringProcess>& processes)
+{
+    using namespace amrex::literals;
+
+    const auto process_count = static_cast<int>(processes.size());
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(process_count > 0,
+        "ScatteringProcessTable: at least one scattering process is needed");
+
+    // Shared energy grid: union of the energy ranges, with the smallest energy step
+    amrex::ParticleReal energy_lo = processes[0].getMinEnergyInput();
+    amrex::ParticleReal energy_hi = processes[0].getMaxEnergyInput();
+    amrex::ParticleReal dE = processes[0].getEnergyInputStep();
+    for (auto const& process : processes) {
+        energy_lo = amrex::min(energy_lo, process.getMinEnergyInput());
+        energy_hi = amrex::max(energy_hi, process.getMaxEnergyInput());
+        dE = amrex::min(dE, process.getEnergyInputStep());
+    }
+    const double n_steps = std::round((energy_hi - energy_lo)/dE);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(n_steps >= 1. && n_steps < double(1 << 24),
+        "ScatteringProcessTable: the energy ranges and steps of the cross-sections"
+        " give an invalid shared energy grid");
+    const auto grid_size = static_cast<int>(n_steps) + 1;
+    dE = (energy_hi - energy_lo)/static_cast<amrex::ParticleReal>(grid_size - 1);
+
+    // Resample all the processes, with one padding row at the end
+    m_sigmas_h.resize(static_cast<std::size_t>(grid_size + 1)*process_count);
+    for (int i = 0; i <= grid_size; ++i) {
+        const amrex::ParticleReal energy = energy_lo + static_cast<amrex::ParticleReal>(
+            amrex::min(i, grid_size-1)) * dE;
+        for (int iprocess = 0; iprocess < process_count; ++iprocess) {
+            m_sigmas_h[static_cast<std::size_t>(i)*process_count + iprocess] =
+                processes[iprocess].getCrossSection(energy);
+        }
+    }
+    m_energy_penalties_h.resize(process_count);
+    for (int iprocess = 0; iprocess < process_count; ++iprocess) {
+        m_energy_penalties_h[iprocess] = processes[iprocess].getEnergyPenalty();
+    }
+
+    m_exe_h.m_sigmas_data = m_sigmas_h.data();
+    m_exe_h.m_energy_penalties_data = m_energy_penalties_h.data();
+    m_exe_h.m_energy_lo = energy_lo;
+    m_exe_h.m_energy_hi = energy_hi;
+    m_exe_h.m_dE = dE;
+    m_exe_h.m_grid_size = grid_size;
+    m_exe_h.m_process_count = process_count;
+
+#ifdef AMREX_USE_GPU
+    m_exe_d = m_exe_h;
+    m_sigmas_d.resize(m_sigmas_h.size());
+    m_energy_penalties_d.resize(m_energy_penalties_h.size());
+    m_exe_d.m_sigmas_data = m_sigmas_d.data();
+    m_exe_d.m_energy_penalties_data = m_energy_penalties_d.data();
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, m_sigmas_h.begin(), m_sigmas_h.end(),
+                          m_sigmas_d.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, m_energy_penalties_h.begin(),
+                          m_energy_penalties_h.end(), m_energy_penalties_d.begin());
+    amrex::Gpu::streamSynchronize();
+#endif
+}
@@ -31,6 +31,10 @@ IonizationFilterFunc::IonizationFilterFunc (const WarpXParIter& a_pti, int lev,
                                             const amrex::Real* const AMREX_RESTRICT a_adk_exp_prefactor,
                                             const amrex::Real* const AMREX_RESTRICT a_adk_power,
                                             const amrex::Real* const AMREX_RESTRICT a_adk_correction_factors,
+                                            const amrex::Real* const AMREX_RESTRICT a_adk_table,
+                                            const amrex::Real* const AMREX_RESTRICT a_adk_table_x_max,
+                                            const amrex::Real* const AMREX_RESTRICT a_adk_table_inv_dx,
+                                            int a_adk_table_size,
                                             int a_comp,
                                             int a_atomic_number,
                                             int a_do_adk_correction,
@@ -40,6 +44,10 @@ IonizationFilterFunc::IonizationFilterFunc (const WarpXParIter& a_pti, int lev,
     m_adk_exp_prefactor{a_adk_exp_prefactor},
     m_adk_power{a_adk_power},
     m_adk_correction_factors{a_adk_correction_factors},
+    m_adk_table{a_adk_table},
+    m_adk_table_x_max{a_adk_table_x_max},
+    m_adk_table_inv_dx{a_adk_table_inv_dx},
+    m_adk_table_size{a_adk_table_size},
     comp{a_comp},
     m_atomic_number{a_atomic_number},
     m_do_adk_correction{a_do_adk_correction},
@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <iosfwd>
@@ -67,15 +68,25 @@ BreitWheelerEngine::init_lookup_tables_from_raw_data (
     const vector<char>& raw_data,
     const amrex::ParticleReal bw_minimum_chi_phot)
 {
-    auto raw_iter = raw_data.begin();
+    return init_lookup_tables_from_raw_data(
+        raw_data.data(), raw_data.size(), bw_minimum_chi_phot);
+}
+
+bool
+BreitWheelerEngine::init_lookup_tables_from_raw_data (
+    const char* raw_data, const std::size_t raw_size,
+    const amrex::ParticleReal bw_minimum_chi_phot)
+{
+    if (raw_size < sizeof(uint64_t)) { return false; }
+    const char* raw_iter = raw_data;
     const auto size_first = pxr_sr::get_out<uint64_t>(raw_iter);
-    if(size_first <= 0 || size_first >= raw_data.size() ) { return false; }
+    if(size_first <= 0 || size_first >= raw_size ) { return false; }
 
     const auto raw_dndt_table = vector<char>{
         raw_iter, raw_iter+static_cast<long>(size_first)};
 
     const auto raw_pair_prod_table = vector<char>{
-        raw_iter+static_cast<long>(size_first), raw_data.end()};
+        raw_iter+static_cast<long>(size_first), raw_data+raw_size};
 
     m_dndt_table = BW_dndt_table{raw_dndt_table};
     m_pair_prod_table = BW_pair_prod_table{raw_pair_prod_table};
@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <iosfwd>
@@ -66,15 +67,25 @@ QuantumSynchrotronEngine::init_lookup_tables_from_raw_data (
     const vector<char>& raw_data,
     const amrex::ParticleReal qs_minimum_chi_part)
 {
-    auto raw_iter = raw_data.begin();
+    return init_lookup_tables_from_raw_data(
+        raw_data.data(), raw_data.size(), qs_minimum_chi_part);
+}
+
+bool
+QuantumSynchrotronEngine::init_lookup_tables_from_raw_data (
+    const char* raw_data, const std::size_t raw_size,
+    const amrex::ParticleReal qs_minimum_chi_part)
+{
+    if (raw_size < sizeof(uint64_t)) { return false; }
+    const char* raw_iter = raw_data;
     const auto size_first = pxr_sr::get_out<uint64_t>(raw_iter);
-    if(size_first <= 0 || size_first >= raw_data.size() ) { return false; }
+    if(size_first <= 0 || size_first >= raw_size ) { return false; }
 
     const auto raw_dndt_table = vector<char>{
         raw_iter, raw_iter+static_cast<long>(size_first)};
 
     const auto raw_phot_em_table = vector<char>{
-        raw_iter+static_cast<long>(size_first), raw_data.end()};
+        raw_iter+static_cast<long>(size_first), raw_data+raw_size};
 
     m_dndt_table = QS_dndt_table{raw_dndt_table};
     m_phot_em_table = QS_phot_em_table{raw_phot_em_table};
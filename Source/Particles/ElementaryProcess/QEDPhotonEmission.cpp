@@ -8,13 +8,18 @@
 
 #include "Particles/ElementaryProcess/QEDPhotonEmission.H"
 
+#include "Utils/ParticleUtils.H"
 #include "WarpX.H"
 
 #include <AMReX_Box.H>
 #include <AMReX_FArrayBox.H>
+#include <AMReX_GpuContainers.H>
 #include <AMReX_IntVect.H>
+#include <AMReX_Random.H>
 
 #include <array>
+#include <cmath>
+#include <limits>
 
 PhotonEmissionTransformFunc::
 PhotonEmissionTransformFunc (QuantumSynchrotronGetOpticalDepth opt_depth_functor,
@@ -77,3 +82,174 @@ PhotonEmissionTransformFunc (QuantumSynchrotronGetOpticalDepth opt_depth_functor
 
     m_lo = amrex::lbound(box);
 }
+
+int mergeNewPhotons (int lev, amrex::MFIter const& mfi,
+                     WarpXParticleContainer::ParticleTileType& ptile,
+                     int old_size, int num_added,
+                     PhotonMergingParams const& params)
+{
+    using namespace amrex::literals;
+
+    if (num_added <= 2) { return 0; }
+
+    auto& soa = ptile.GetStructOfArrays();
+#if !defined(WARPX_DIM_1D_Z)
+    auto * const AMREX_RESTRICT x = soa.GetRealData(PIdx::x).data();
+#endif
+#if defined(WARPX_DIM_3D)
+    auto * const AMREX_RESTRICT y = soa.GetRealData(PIdx::y).data();
+#endif
+    auto * const AMREX_RESTRICT z = soa.GetRealData(PIdx::z).data();
+    auto * const AMREX_RESTRICT ux = soa.GetRealData(PIdx::ux).data();
+    auto * const AMREX_RESTRICT uy = soa.GetRealData(PIdx::uy).data();
+    auto * const AMREX_RESTRICT uz = soa.GetRealData(PIdx::uz).data();
+    auto * const AMREX_RESTRICT w = soa.GetRealData(PIdx::w).data();
+    auto * const AMREX_RESTRICT idcpu = soa.GetIdCPUData().data();
+
+    // The photons are grouped by cell: the photons of the cell `c` are
+    // `indices[cell_offsets[c]:cell_offsets[c+1]]`
+    auto bins = ParticleUtils::findParticlesInEachCell(lev, mfi, ptile);
+    const auto n_cells = static_cast<int>(bins.numBins());
+    auto *const indices = bins.permutationPtr();
+    auto *const cell_offsets = bins.offsetsPtr();
+
+    // Momentum bin of each new photon: logarithmic bins of the energy and uniform
+    // bins of the polar and azimuthal angles of the momentum. The photons that are not
+    // to be merged (already removed, or already processed) are labeled with no_bin.
+    constexpr int no_bin = std::numeric_limits<int>::min();
+    const int n_theta = params.n_theta;
+    const int n_phi = params.n_phi;
+    const auto bins_per_decade = static_cast<amrex::ParticleReal>(params.energy_bins_per_decade);
+    amrex::Gpu::DeviceVector<int> momentum_bin(num_added);
+    int * const AMREX_RESTRICT p_bin = momentum_bin.dataPtr();
+    amrex::ParallelFor(num_added, [=] AMREX_GPU_DEVICE (int i) noexcept
+    {
+        const int ip = old_size + i;
+        // for photons, u is the momentum divided by m_e, so that |u|/c is the energy in m_e c^2
+        const auto u_mag = std::sqrt(ux[ip]*ux[ip] + uy[ip]*uy[ip] + uz[ip]*uz[ip]);
+        if (!amrex::ParticleIDWrapper{idcpu[ip]}.is_valid() || u_mag <= 0._prt) {
+            p_bin[i] = no_bin;
+            return;
+        }
+        const int ie = static_cast<int>(std::floor(
+            bins_per_decade*std::log10(u_mag/PhysConst::c)));
+        const auto theta = std::acos(amrex::min(amrex::max(uz[ip]/u_mag, -1._prt), 1._prt));
+        const auto phi = std::atan2(uy[ip], ux[ip]) + MathConst::pi;
+        const int it = amrex::min(static_cast<int>(theta/MathConst::pi*n_theta), n_theta-1);
+        const int jp = amrex::min(static_cast<int>(phi/(2._prt*MathConst::pi)*n_phi), n_phi-1);
+        p_bin[i] = (ie*n_phi + jp)*n_theta + it;
+    });
+
+    // Merge the groups of new photons of each cell, the cells being processed in parallel
+    amrex::Gpu::DeviceVector<int> removed_in_cell(n_cells, 0);
+    int * const AMREX_RESTRICT p_removed = removed_in_cell.dataPtr();
+    amrex::ParallelForRNG(n_cells,
+        [=] AMREX_GPU_DEVICE (int i_cell, amrex::RandomEngine const& engine) noexcept
+    {
+        const auto cell_start = static_cast<int>(cell_offsets[i_cell]);
+        const auto cell_stop = static_cast<int>(cell_offsets[i_cell+1]);
+        int n_removed = 0;
+
+        for (int a = cell_start; a < cell_stop; ++a) {
+            const auto ia = static_cast<int>(indices[a]);
+            if (ia < old_size) { continue; }
+            const int bin = p_bin[ia - old_size];
+            if (bin == no_bin) { continue; }
+
+            // weighted sums of the positions, momenta and energies of the group
+            int n_group = 0;
+            int second = -1;
+            amrex::ParticleReal sw = 0._prt, sux = 0._prt, suy = 0._prt, suz = 0._prt;
+            amrex::ParticleReal su = 0._prt, sz = 0._prt;
+#if !defined(WARPX_DIM_1D_Z)
+            amrex::ParticleReal sx = 0._prt;
+#endif
+#if defined(WARPX_DIM_3D)
+            amrex::ParticleReal sy = 0._prt;
+#endif
+            for (int b = a; b < cell_stop; ++b) {
+                const auto ib = static_cast<int>(indices[b]);
+                if (ib < old_size || p_bin[ib - old_size] != bin) { continue; }
+                if (n_group == 1) { second = ib; }
+                ++n_group;
+                const amrex::ParticleReal wb = w[ib];
+                sw += wb;
+                sux += wb*ux[ib];
+                suy += wb*uy[ib];
+                suz += wb*uz[ib];
+                su += wb*std::sqrt(ux[ib]*ux[ib] + uy[ib]*uy[ib] + uz[ib]*uz[ib]);
+                sz += wb*z[ib];
+#if !defined(WARPX_DIM_1D_Z)
+                sx += wb*x[ib];
+#endif
+#if defined(WARPX_DIM_3D)
+                sy += wb*y[ib];
+#endif
+            }
+            const bool do_merge = n_group > 2 && sw > std::numeric_limits<amrex::ParticleReal>::min();
+
+            amrex::ParticleReal mux = 0._prt, muy = 0._prt, muz = 0._prt;
+            amrex::ParticleReal dux = 0._prt, duy = 0._prt, duz = 0._prt;
+            if (do_merge) {
+                // mean momentum of the group
+                mux = sux/sw;
+                muy = suy/sw;
+                muz = suz/sw;
+                const amrex::ParticleReal u_perp2 = mux*mux + muy*muy;
+                const amrex::ParticleReal u_perp = std::sqrt(u_perp2);
+                const amrex::ParticleReal mu_mag2 = u_perp2 + muz*muz;
+                const amrex::ParticleReal mu_mag = std::sqrt(mu_mag2);
+
+                // The two photons have momenta mu +/- v, with v perpendicular to mu: the
+                // momentum is conserved, and the energy is conserved when |mu|^2 + |v|^2 is
+                // the square of the mean energy of the group.
+                const amrex::ParticleReal mean_u = su/sw;
+                const amrex::ParticleReal v_mag2 = mean_u*mean_u - mu_mag2;
+                const amrex::ParticleReal v_mag = (v_mag2 > 0._prt) ? std::sqrt(v_mag2) : 0._prt;
+
+                // random direction of v in the plane perpendicular to mu
+                const amrex::ParticleReal phi = amrex::Random(engine) * 2._prt * MathConst::pi;
+                const amrex::ParticleReal vx = v_mag * std::cos(phi);
+                const amrex::ParticleReal vy = v_mag * std::sin(phi);
+
+                // rotation from the frame where mu is along z to the lab frame
+                const amrex::ParticleReal cos_theta = (mu_mag > 0._prt) ? muz / mu_mag : 1._prt;
+                const amrex::ParticleReal sin_theta = (mu_mag > 0._prt) ? u_perp / mu_mag : 0._prt;
+                const amrex::ParticleReal cos_phi = (u_perp > 0._prt) ? mux / u_perp : 1._prt;
+                const amrex::ParticleReal sin_phi = (u_perp > 0._prt) ? muy / u_perp : 0._prt;
+                dux = vx * cos_theta * cos_phi - vy * sin_phi;
+                duy = vx * cos_theta * sin_phi + vy * cos_phi;
+                duz = -vx * sin_theta;
+                n_removed += n_group - 2;
+            }
+
+            // The first two photons of the group are replaced by the merged photons and
+            // the other ones are removed. All the photons of the group are marked as processed.
+            for (int b = a; b < cell_stop; ++b) {
+                const auto ib = static_cast<int>(indices[b]);
+                if (ib < old_size || p_bin[ib - old_size] != bin) { continue; }
+                p_bin[ib - old_size] = no_bin;
+                if (!do_merge) { continue; }
+                if (ib == ia || ib == second) {
+                    const amrex::ParticleReal sign = (ib == ia) ? 1._prt : -1._prt;
+                    w[ib] = sw / 2._prt;
+#if !defined(WARPX_DIM_1D_Z)
+                    x[ib] = sx / sw;
+#endif
+#if defined(WARPX_DIM_3D)
+                    y[ib] = sy / sw;
+#endif
+                    z[ib] = sz / sw;
+                    ux[ib] = mux + sign*dux;
+                    uy[ib] = muy + sign*duy;
+                    uz[ib] = muz + sign*duz;
+                } else {
+                    idcpu[ib] = amrex::ParticleIdCpus::Invalid;
+                }
+            }
+        }
+        p_removed[i_cell] = n_removed;
+    });
+
+    return amrex::Reduce::Sum(n_cells, p_removed, 0);
+}
@@ -1,6 +1,7 @@
 #include "Particles/Gather/GetExternalFields.H"
 
 #include "AcceleratorLattice/AcceleratorLattice.H"
+#include "Initialization/ExternalFieldTimeSeries.H"
 
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
@@ -21,7 +22,9 @@ GetExternalEBField::GetExternalEBField (const WarpXParIter& a_pti, long a_offset
     const int lev = a_pti.GetLevel();
 
     AcceleratorLattice const & accelerator_lattice = warpx.get_accelerator_lattice(lev);
-    if (accelerator_lattice.m_lattice_defined) {
+    // The lattice is left out on the grids that no element overlaps,
+    // so that the push kernel is compiled without it when there are no other external fields
+    if (accelerator_lattice.m_lattice_defined && accelerator_lattice.HasActiveElements(a_pti)) {
         d_lattice_element_finder = accelerator_lattice.GetFinderDeviceInstance(a_pti, static_cast<int>(a_offset));
     }
 
@@ -41,7 +44,9 @@ GetExternalEBField::GetExternalEBField (const WarpXParIter& a_pti, long a_offset
     if (mypc.m_E_ext_particle_s == "parse_e_ext_particle_function" ||
         mypc.m_B_ext_particle_s == "parse_b_ext_particle_function" ||
         mypc.m_E_ext_particle_s == "repeated_plasma_lens" ||
-        mypc.m_B_ext_particle_s == "repeated_plasma_lens")
+        mypc.m_B_ext_particle_s == "repeated_plasma_lens" ||
+        mypc.m_E_ext_particle_s == "read_from_file" ||
+        mypc.m_B_ext_particle_s == "read_from_file")
     {
         m_time = warpx.gett_new(a_pti.GetLevel());
         m_get_position = GetParticlePosition<PIdx>(a_pti, a_offset);
@@ -65,6 +70,38 @@ GetExternalEBField::GetExternalEBField (const WarpXParIter& a_pti, long a_offset
         m_Bzfield_partparser = mypc.m_Bz_particle_parser->compile<num_arguments>();
     }
 
+    // Gather the time-independent fields from their values on the nodes, when these
+    // were evaluated on the current grids (otherwise, fall back to the parsers)
+    if (mypc.m_E_ext_particle_on_grid || mypc.m_B_ext_particle_on_grid) {
+        auto const& grid = mypc.m_ext_particle_fields_grid;
+        if (lev < static_cast<int>(grid.size()) && grid[lev] &&
+            grid[lev]->boxArray().CellEqual(warpx.boxArray(lev)) &&
+            grid[lev]->DistributionMap() == warpx.DistributionMap(lev))
+        {
+            m_ext_fields_grid = grid[lev]->const_array(a_pti);
+            m_grid_plo = warpx.Geom(lev).ProbLoArray();
+            m_grid_dxi = warpx.Geom(lev).InvCellSizeArray();
+            if (mypc.m_E_ext_particle_on_grid) { m_Etype = ExternalFieldInitType::ParserOnGrid; }
+            if (mypc.m_B_ext_particle_on_grid) { m_Btype = ExternalFieldInitType::ParserOnGrid; }
+        }
+    }
+
+    // Gather the fields read from the file, interpolated in time between the two
+    // iterations that bracket the current time
+    if (mypc.m_E_ext_particle_s == "read_from_file" ||
+        mypc.m_B_ext_particle_s == "read_from_file")
+    {
+        amrex::MultiFab const* file_fields = mypc.m_ext_particle_fields_file->getFields(lev);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(file_fields != nullptr,
+            "The external fields of the particles were not read from the file on the current grids");
+        m_file_fields_grid = file_fields->const_array(a_pti);
+        m_file_fields_weight = mypc.m_ext_particle_fields_file->getWeight(m_time);
+        m_grid_plo = warpx.Geom(lev).ProbLoArray();
+        m_grid_dxi = warpx.Geom(lev).InvCellSizeArray();
+        if (mypc.m_E_ext_particle_s == "read_from_file") { m_Etype = ExternalFieldInitType::ReadFromFile; }
+        if (mypc.m_B_ext_particle_s == "read_from_file") { m_Btype = ExternalFieldInitType::ReadFromFile; }
+    }
+
     if (mypc.m_E_ext_particle_s == "repeated_plasma_lens" ||
         mypc.m_B_ext_particle_s == "repeated_plasma_lens")
     {
@@ -259,6 +259,39 @@ LaserParticleContainer::LaserParticleContainer (AmrCore* amr_core, int ispecies,
         }
     }
 
+    pp_laser_name.query("do_grid_antenna", m_do_grid_antenna);
+    if (m_do_grid_antenna){
+#if defined(WARPX_DIM_RZ)
+        WARPX_ABORT_WITH_MESSAGE(m_laser_name + ".do_grid_antenna is not supported in RZ geometry");
+#endif
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            WarpX::gamma_boost <= 1. && !do_continuous_injection,
+            m_laser_name + ".do_grid_antenna requires a fixed antenna: it does not support "
+            "the boosted frame or do_continuous_injection");
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            WarpX::electromagnetic_solver_id != ElectromagneticSolverAlgo::PSATD,
+            m_laser_name + ".do_grid_antenna does not deposit the charge density of the antenna, "
+            "which the PSATD solver requires");
+        // The antenna plane must be a plane of the grid
+        bool is_aligned = false;
+#if defined(WARPX_DIM_3D)
+        const std::array<int, 3> grid_dirs = {0, 1, 2};
+#elif defined(WARPX_DIM_XZ)
+        const std::array<int, 3> grid_dirs = {0, -1, 1};
+#else
+        const std::array<int, 3> grid_dirs = {-1, -1, 0};
+#endif
+        for (int idir = 0; idir < 3; ++idir) {
+            if (grid_dirs[idir] >= 0 && std::abs(std::abs(m_nvec[idir]) - 1._rt) < 1.e-12) {
+                is_aligned = true;
+                m_grid_antenna_dir = grid_dirs[idir];
+                m_grid_antenna_lab_dir = idir;
+            }
+        }
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(is_aligned,
+            m_laser_name + ".do_grid_antenna requires the laser direction to be along an axis of the grid");
+    }
+
     //Init laser profile
 
     AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_e_max >= 0.,
@@ -281,7 +314,7 @@ LaserParticleContainer::LaserParticleContainer (AmrCore* amr_core, int ispecies,
 void
 LaserParticleContainer::ContinuousInjection (const RealBox& injection_box)
 {
-    if (!m_enabled) { return; }
+    if (!m_enabled || m_do_grid_antenna) { return; }
 
     // Input parameter injection_box contains small box where injection
     // should occur.
@@ -352,7 +385,7 @@ LaserParticleContainer::UpdateAntennaPosition (const amrex::Real dt)
 void
 LaserParticleContainer::InitData ()
 {
-    if (!m_enabled) { return; }
+    if (!m_enabled || m_do_grid_antenna) { return; }
 
     // Call InitData on max level to inject one laser particle per
     // finest cell.
@@ -369,7 +402,8 @@ LaserParticleContainer::InitData ()
 void
 LaserParticleContainer::InitData (int lev)
 {
-    if (!m_enabled) { return; }
+    // No antenna particles when the antenna current is deposited on the grid
+    if (!m_enabled || m_do_grid_antenna) { return; }
 
     // spacing of laser particles in the laser plane.
     // has to be done after geometry is set up.
@@ -581,6 +615,11 @@ LaserParticleContainer::Evolve (int lev,
     // Update laser profile
     m_up_laser_profile->update(t_lab);
 
+    if (m_do_grid_antenna) {
+        if (!skip_deposition) { DepositAntennaCurrent(lev, jx, jy, jz, t_lab); }
+        return;
+    }
+
     BL_ASSERT(OnSameGrids(lev,jx));
 
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
@@ -700,6 +739,114 @@ LaserParticleContainer::Evolve (int lev,
     }
 }
 
+void
+LaserParticleContainer::DepositAntennaCurrent (int lev, MultiFab& jx, MultiFab& jy,
+                                               MultiFab& jz, Real t_lab)
+{
+    WARPX_PROFILE("LaserParticleContainer::DepositAntennaCurrent()");
+
+    const auto problo = Geom(lev).ProbLoArray();
+    const auto dx = Geom(lev).CellSizeArray();
+    const int ndir = m_grid_antenna_dir;
+    const Real h = dx[ndir];
+    const Real pos_n = m_position[m_grid_antenna_lab_dir];
+    const RealBox injection_box = m_laser_injection_box;
+
+    // Copy member variables to tmp copies for GPU runs.
+    const Real tmp_u_X_0 = m_u_X[0];
+    const Real tmp_u_X_1 = m_u_X[1];
+    const Real tmp_u_X_2 = m_u_X[2];
+    const Real tmp_u_Y_0 = m_u_Y[0];
+    const Real tmp_u_Y_1 = m_u_Y[1];
+    const Real tmp_u_Y_2 = m_u_Y[2];
+    const Real tmp_position_0 = m_position[0];
+    const Real tmp_position_1 = m_position[1];
+    const Real tmp_position_2 = m_position[2];
+
+    const std::array<MultiFab*, 3> current = {&jx, &jy, &jz};
+    Gpu::DeviceVector<Real> plane_Xp, plane_Yp, amplitude_E;
+
+    for (int icomp = 0; icomp < 3; ++icomp)
+    {
+        if (m_p_X[icomp] == 0._rt) { continue; }
+        // Surface current of the antenna, divided by the width h of its linear shape
+        const Real coeff = -2._rt*PhysConst::ep0*PhysConst::c*m_p_X[icomp]/h;
+        const IntVect ixtype = current[icomp]->ixType().toIntVect();
+        amrex::GpuArray<Real, AMREX_SPACEDIM> shift;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            shift[idim] = (ixtype[idim] == 1) ? 0._rt : 0.5_rt;
+        }
+
+        for (MFIter mfi(*current[icomp]); mfi.isValid(); ++mfi)
+        {
+            // The nodes on the upper faces of a box are owned by the neighboring box,
+            // so that each point receives the current once before SumBoundary
+            Box bx = amrex::enclosedCells(mfi.validbox());
+            // Points within h of the antenna plane
+            const int i_lo = static_cast<int>(std::ceil((pos_n - h - problo[ndir])/h - shift[ndir]));
+            const int i_hi = static_cast<int>(std::floor((pos_n + h - problo[ndir])/h - shift[ndir]));
+            bx.setSmall(ndir, std::max(bx.smallEnd(ndir), i_lo));
+            bx.setBig(ndir, std::min(bx.bigEnd(ndir), i_hi));
+            if (!bx.ok()) { continue; }
+
+            const auto np = static_cast<int>(bx.numPts());
+            plane_Xp.resize(np);
+            plane_Yp.resize(np);
+            amplitude_E.resize(np);
+            Real* const AMREX_RESTRICT pXp = plane_Xp.dataPtr();
+            Real* const AMREX_RESTRICT pYp = plane_Yp.dataPtr();
+            Real* const AMREX_RESTRICT pamp = amplitude_E.dataPtr();
+            const amrex::Dim3 lo = amrex::lbound(bx);
+            const amrex::Dim3 len = amrex::length(bx);
+
+            // Coordinates of the points in the antenna plane
+            amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                const int n = (i-lo.x) + len.x*((j-lo.y) + len.y*(k-lo.z));
+                const IntVect iv(AMREX_D_DECL(i, j, k));
+                Real r[AMREX_SPACEDIM];
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    r[idim] = problo[idim] + (iv[idim] + shift[idim])*dx[idim];
+                }
+#if defined(WARPX_DIM_3D)
+                pXp[n] = tmp_u_X_0*(r[0]-tmp_position_0) + tmp_u_X_1*(r[1]-tmp_position_1) +
+                         tmp_u_X_2*(r[2]-tmp_position_2);
+                pYp[n] = tmp_u_Y_0*(r[0]-tmp_position_0) + tmp_u_Y_1*(r[1]-tmp_position_1) +
+                         tmp_u_Y_2*(r[2]-tmp_position_2);
+#elif defined(WARPX_DIM_XZ)
+                pXp[n] = tmp_u_X_0*(r[0]-tmp_position_0) + tmp_u_X_2*(r[1]-tmp_position_2);
+                pYp[n] = 0._rt;
+                amrex::ignore_unused(tmp_u_X_1, tmp_u_Y_0, tmp_u_Y_1, tmp_u_Y_2, tmp_position_1);
+#else
+                pXp[n] = tmp_u_X_2*(r[0]-tmp_position_2);
+                pYp[n] = 0._rt;
+                amrex::ignore_unused(tmp_u_X_0, tmp_u_X_1, tmp_u_Y_0, tmp_u_Y_1, tmp_u_Y_2,
+                                     tmp_position_0, tmp_position_1);
+#endif
+            });
+
+            // Laser amplitude at these points
+            m_up_laser_profile->fill_amplitude(np, pXp, pYp, t_lab, pamp);
+
+            auto const& jarr = current[icomp]->array(mfi);
+            amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                const int n = (i-lo.x) + len.x*((j-lo.y) + len.y*(k-lo.z));
+                const IntVect iv(AMREX_D_DECL(i, j, k));
+                Real r[AMREX_SPACEDIM];
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    r[idim] = problo[idim] + (iv[idim] + shift[idim])*dx[idim];
+                }
+                const Real w = 1._rt - std::abs(r[ndir] - pos_n)/h;
+                if (w > 0._rt && injection_box.contains(r)) {
+                    jarr(i,j,k) += coeff*w*pamp[n];
+                }
+            });
+
+            // This is necessary because of plane_Xp, plane_Yp and amplitude_E
+            amrex::Gpu::synchronize();
+        }
+    }
+}
+
 void
 LaserParticleContainer::PostRestart ()
 {
@@ -866,21 +1013,21 @@ LaserParticleContainer::update_laser_particle (WarpXParIter& pti,
     // When using the implicit solver, this function is called multiple times per timestep
     // (within the linear and nonlinear solver). Thus, the position of the particles needs to be reset
     // to the initial position (at the beginning of the timestep), before updating the particle position
-#if (AMREX_SPACEDIM >= 2)
-    ParticleReal* x_n = nullptr;
-    if (push_type == PushType::Implicit) {
-        x_n = pti.GetAttribs(particle_comps["x_n"]).dataPtr();
-    }
-#endif
-#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-    ParticleReal* y_n = nullptr;
-    if (push_type == PushType::Implicit) {
-        y_n = pti.GetAttribs(particle_comps["y_n"]).dataPtr();
-    }
-#endif
-    ParticleReal* z_n = nullptr;
+    // The differences with the start-of-step values are updated with the new values.
+    float* dx_n = nullptr;
+    float* dy_n = nullptr;
+    float* dz_n = nullptr;
+    float* dux_n = nullptr;
+    float* duy_n = nullptr;
+    float* duz_n = nullptr;
     if (push_type == PushType::Implicit) {
-        z_n = pti.GetAttribs(particle_comps["z_n"]).dataPtr();
+        auto& implicit_state = getImplicitState(pti.GetLevel(), pti.GetPairIndex());
+        dx_n = implicit_state[ImplicitIdx::dx_n].dataPtr();
+        dy_n = implicit_state[ImplicitIdx::dy_n].dataPtr();
+        dz_n = implicit_state[ImplicitIdx::dz_n].dataPtr();
+        dux_n = implicit_state[ImplicitIdx::dux_n].dataPtr();
+        duy_n = implicit_state[ImplicitIdx::duy_n].dataPtr();
+        duz_n = implicit_state[ImplicitIdx::duz_n].dataPtr();
     }
 
     // Copy member variables to tmp copies for GPU runs.
@@ -909,6 +1056,14 @@ LaserParticleContainer::update_laser_particle (WarpXParIter& pti,
             // Get the corresponding momenta
             const Real gamma =
                 static_cast<Real>(gamma_boost/std::sqrt(1. - v_over_c*v_over_c));
+            if (push_type == PushType::Implicit) {
+                const ParticleReal ux_n = puxp[i] + dux_n[i];
+                const ParticleReal uy_n = puyp[i] + duy_n[i];
+                const ParticleReal uz_n = puzp[i] + duz_n[i];
+                dux_n[i] = static_cast<float>(ux_n - gamma * vx);
+                duy_n[i] = static_cast<float>(uy_n - gamma * vy);
+                duz_n[i] = static_cast<float>(uz_n - gamma * vz);
+            }
             puxp[i] = gamma * vx;
             puyp[i] = gamma * vy;
             puzp[i] = gamma * vz;
@@ -920,26 +1075,33 @@ LaserParticleContainer::update_laser_particle (WarpXParIter& pti,
             // to the initial position (at the beginning of the timestep), before updating the particle position
 
             ParticleReal x=0., y=0., z=0.;
-            if (push_type == PushType::Explicit) {
-                GetPosition(i, x, y, z);
-            }
+            GetPosition(i, x, y, z);
 
 #if !defined(WARPX_DIM_1D_Z)
             if (push_type == PushType::Implicit) {
-                x = x_n[i];
+                const ParticleReal x_n = x + dx_n[i];
+                x = x_n + vx * dt;
+                dx_n[i] = static_cast<float>(x_n - x);
+            } else {
+                x += vx * dt;
             }
-            x += vx * dt;
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
             if (push_type == PushType::Implicit) {
-                y = y_n[i];
+                const ParticleReal y_n = y + dy_n[i];
+                y = y_n + vy * dt;
+                dy_n[i] = static_cast<float>(y_n - y);
+            } else {
+                y += vy * dt;
             }
-            y += vy * dt;
 #endif
             if (push_type == PushType::Implicit) {
-                z = z_n[i];
+                const ParticleReal z_n = z + dz_n[i];
+                z = z_n + vz * dt;
+                dz_n[i] = static_cast<float>(z_n - z);
+            } else {
+                z += vz * dt;
             }
-            z += vz * dt;
 
             SetPosition(i, x, y, z);
         }
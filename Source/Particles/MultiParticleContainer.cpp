@@ -35,6 +35,7 @@
 #include "Particles/WarpXParticleContainer.H"
 #include "SpeciesPhysicalProperties.H"
 #include "Utils/Parser/ParserUtils.H"
+#include "Utils/PhaseTimers.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -46,6 +47,8 @@
 
 #include "WarpX.H"
 
+#include <ablastr/parallelization/NodeSharedBuffer.H>
+#include <ablastr/utils/CommStats.H>
 #include <ablastr/utils/Communication.H>
 #include <ablastr/warn_manager/WarnManager.H>
 
@@ -58,6 +61,7 @@
 #include <AMReX_FabArray.H>
 #include <AMReX_Geometry.H>
 #include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuControl.H>
 #include <AMReX_GpuDevice.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_LayoutData.H>
@@ -75,8 +79,15 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
 #include <limits>
 #include <map>
+#include <optional>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -91,6 +102,59 @@ namespace
     {
         Array4< amrex::Real const > const Ex, Ey, Ez, Bx, By, Bz;
     };
+
+#ifdef WARPX_QED
+    /** Name of the file of the cache directory cache_dir holding the QED lookup table
+     * generated with the parameters params. The name is the table kind followed by a
+     * hash (64-bit FNV-1a) of the parameters and of the floating point precision.
+     */
+    std::string QedTableCacheFile (const std::string& cache_dir, const std::string& table_kind,
+                                   const std::vector<double>& params)
+    {
+        std::uint64_t hash = 14695981039346656037ULL;
+        const auto add_bytes = [&hash] (const void* data, std::size_t size) {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+        };
+        const auto precision = static_cast<int>(sizeof(amrex::ParticleReal));
+        add_bytes(&precision, sizeof(precision));
+        for (const double param : params) { add_bytes(&param, sizeof(param)); }
+
+        std::stringstream ss;
+        ss << cache_dir << "/" << table_kind << "_"
+           << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+        return ss.str();
+    }
+
+    /** Read the lookup table file filename into data, if it exists.
+     *
+     * @return true if the file could be read
+     */
+    bool ReadQedTableFromCache (const std::string& filename, amrex::Vector<char>& data)
+    {
+        std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+        if (!ifs.is_open()) { return false; }
+        data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        return !ifs.bad() && !data.empty();
+    }
+
+    /** Write the lookup table data in the cache file filename. The data is written in
+     * a temporary file, which is then renamed, so that concurrent jobs never read a
+     * partially written table.
+     */
+    void WriteQedTableInCache (const std::string& filename, const amrex::Vector<char>& data)
+    {
+        const std::string tmp_filename = filename + ".part";
+        if (!WarpXUtilIO::WriteBinaryDataOnFile(tmp_filename, data) ||
+            std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+            ablastr::warn_manager::WMRecordWarning("QED",
+                "Failed to write the lookup table in the cache file " + filename);
+        }
+    }
+#endif
 }
 
 MultiParticleContainer::MultiParticleContainer (AmrCore* amr_core)
@@ -121,8 +185,6 @@ MultiParticleContainer::MultiParticleContainer (AmrCore* amr_core)
         allcontainers[i]->m_deposit_on_main_grid = m_laser_deposit_on_main_grid[i-nspecies];
     }
 
-    pc_tmp = std::make_unique<PhysicalParticleContainer>(amr_core);
-
     // Setup particle collisions
     collisionhandler = std::make_unique<CollisionHandler>(this);
 
@@ -207,6 +269,50 @@ MultiParticleContainer::ReadParameters ()
 
         }
 
+        // Time-independent external fields can be evaluated once on the nodes of the
+        // grids, and then gathered by the particles, rather than evaluated for each particle
+        bool ext_particle_fields_on_grid = false;
+        pp_particles.query("ext_particle_fields_on_grid", ext_particle_fields_on_grid);
+        if (ext_particle_fields_on_grid) {
+            const auto time_independent = [] (const std::unique_ptr<amrex::Parser>& parser) {
+                return parser->symbols().count("t") == 0;
+            };
+#ifndef WARPX_DIM_RZ
+            // In the boosted frame, the lab-frame coordinates of a point depend on time
+            if (WarpX::gamma_boost <= 1._rt) {
+                m_E_ext_particle_on_grid = m_E_ext_particle_s == "parse_e_ext_particle_function" &&
+                    time_independent(m_Ex_particle_parser) && time_independent(m_Ey_particle_parser) &&
+                    time_independent(m_Ez_particle_parser);
+                m_B_ext_particle_on_grid = m_B_ext_particle_s == "parse_b_ext_particle_function" &&
+                    time_independent(m_Bx_particle_parser) && time_independent(m_By_particle_parser) &&
+                    time_independent(m_Bz_particle_parser);
+            }
+#endif
+            if (!m_E_ext_particle_on_grid && !m_B_ext_particle_on_grid) {
+                ablastr::warn_manager::WMRecordWarning("Particles",
+                    "particles.ext_particle_fields_on_grid is ignored: it requires external fields "
+                    "of the particles given by time-independent expressions, "
+                    "without boosted frame and not in RZ geometry",
+                    ablastr::warn_manager::WarnPriority::low);
+            }
+        }
+
+        // The external fields of the particles can be read from the iterations of an
+        // openPMD series, and interpolated in time between them
+        if (m_E_ext_particle_s == "read_from_file" || m_B_ext_particle_s == "read_from_file") {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::gamma_boost <= 1._rt,
+                "The external fields of the particles cannot be read from a file in boosted-frame simulations");
+            std::string read_fields_from_path;
+            pp_particles.get("read_fields_from_path", read_fields_from_path);
+            bool read_fields_prefetch = false;
+            pp_particles.query("read_fields_prefetch", read_fields_prefetch);
+            m_ext_particle_fields_file = std::make_unique<ExternalFieldTimeSeries>(
+                read_fields_from_path, m_E_ext_particle_s == "read_from_file",
+                m_B_ext_particle_s == "read_from_file", read_fields_prefetch);
+        }
+
+        pp_particles.query("concurrent_species_evolve", m_concurrent_species_evolve);
+
         // if the input string for E_ext_particle_s or B_ext_particle_s is
         // "repeated_plasma_lens" then the plasma lens properties
         // must be provided in the input file.
@@ -368,6 +474,9 @@ MultiParticleContainer::ReadParameters ()
             utils::parser::queryWithParser(
                 pp_qed_schwinger, "threshold_poisson_gaussian",
                 m_qed_schwinger_threshold_poisson_gaussian);
+            utils::parser::queryWithParser(
+                pp_qed_schwinger, "tile_skip_threshold",
+                m_qed_schwinger_tile_skip_threshold);
             utils::parser::queryWithParser(
                 pp_qed_schwinger, "xmin", m_qed_schwinger_xmin);
             utils::parser::queryWithParser(
@@ -405,7 +514,6 @@ MultiParticleContainer::AllocData ()
     for (auto& pc : allcontainers) {
         pc->AllocData();
     }
-    pc_tmp->AllocData();
 }
 
 void
@@ -416,8 +524,6 @@ MultiParticleContainer::InitData ()
     for (auto& pc : allcontainers) {
         pc->InitData();
     }
-    pc_tmp->InitData();
-
 }
 
 void
@@ -428,12 +534,17 @@ MultiParticleContainer::PostRestart ()
     for (auto& pc : allcontainers) {
         pc->PostRestart();
     }
-    pc_tmp->PostRestart();
 }
 
 void
 MultiParticleContainer::InitMultiPhysicsModules ()
 {
+    // The external fields read from a file are needed before the first push,
+    // e.g. by the diagnostics of the initial state
+    if (m_ext_particle_fields_file) {
+        m_ext_particle_fields_file->Update(WarpX::GetInstance().gett_new(0));
+    }
+
     // Init ionization module here instead of in the MultiParticleContainer
     // constructor because dt is required to compute ionization rate pre-factors
     for (auto& pc : allcontainers) {
@@ -459,9 +570,10 @@ MultiParticleContainer::Evolve (int lev,
                                 const MultiFab* cEx, const MultiFab* cEy, const MultiFab* cEz,
                                 const MultiFab* cBx, const MultiFab* cBy, const MultiFab* cBz,
                                 Real t, Real dt, DtType a_dt_type, bool skip_deposition,
-                                PushType push_type)
+                                PushType push_type, int species_begin, int species_end)
 {
-    if (! skip_deposition) {
+    if (species_end < 0) { species_end = nContainers(); }
+    if (! skip_deposition && species_begin == 0) {
         jx.setVal(0.0);
         jy.setVal(0.0);
         jz.setVal(0.0);
@@ -471,8 +583,43 @@ MultiParticleContainer::Evolve (int lev,
         if (rho) { rho->setVal(0.0); }
         if (crho) { crho->setVal(0.0); }
     }
-    for (auto& pc : allcontainers) {
-        pc->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
+    UpdateExtParticleFieldsGrid();
+    if (m_ext_particle_fields_file) { m_ext_particle_fields_file->Update(t); }
+
+    // Optionally, the species that allow it are evolved first, without synchronizing the
+    // device between their tiles, so that the kernels of the small species overlap with
+    // those of the others (they deposit into the same current with atomic additions)
+    std::vector<bool> concurrent(allcontainers.size(), false);
+#ifdef AMREX_USE_GPU
+    const bool timers = WarpX::getCosts(lev) &&
+        WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers;
+    if (m_concurrent_species_evolve && !timers && push_type == PushType::Explicit &&
+        !cjx && !cEx && !crho)
+    {
+        std::optional<amrex::Gpu::NoSyncRegion> no_sync;
+        int stream_offset = 0;
+        for (int i = species_begin; i < species_end; ++i) {
+            auto& pc = allcontainers[i];
+            if (!pc->canEvolveConcurrently()) { continue; }
+            concurrent[i] = true;
+            if (!no_sync) { no_sync.emplace(); }
+            pc->setConcurrentEvolve(true, stream_offset);
+            pc->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
+                       rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt, a_dt_type, skip_deposition, push_type);
+            pc->setConcurrentEvolve(false, 0);
+            // Start the next species on the stream after the last one used by this species
+            stream_offset += pc->numLocalTilesAtLevel(lev);
+        }
+        if (no_sync) {
+            no_sync.reset();
+            amrex::Gpu::streamSynchronizeAll();
+        }
+    }
+#endif
+
+    for (int i = species_begin; i < species_end; ++i) {
+        if (concurrent[i]) { continue; }
+        allcontainers[i]->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
                    rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt, a_dt_type, skip_deposition, push_type);
     }
 }
@@ -611,7 +758,12 @@ void
 MultiParticleContainer::SortParticlesByBin (amrex::IntVect bin_size)
 {
     for (auto& pc : allcontainers) {
-        if (WarpX::sort_particles_for_deposition) {
+        if (WarpX::sort_incremental || WarpX::sort_morton_order) {
+            // Bins of a single cell when sorting for deposition
+            pc->SortParticlesIncrementally(
+                WarpX::sort_particles_for_deposition ? amrex::IntVect(1) : bin_size,
+                WarpX::sort_morton_order);
+        } else if (WarpX::sort_particles_for_deposition) {
             pc->SortParticlesForDeposition(WarpX::sort_idx_type);
         } else {
             pc->SortParticlesByBin(bin_size);
@@ -622,6 +774,9 @@ MultiParticleContainer::SortParticlesByBin (amrex::IntVect bin_size)
 void
 MultiParticleContainer::Redistribute ()
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::ParticleCommunication);
+    const ablastr::utils::communication::ScopedCommSite comm_site("Redistribute");
+    const ablastr::utils::communication::ScopedCommWait comm_wait;
     for (auto& pc : allcontainers) {
         pc->Redistribute();
     }
@@ -646,6 +801,9 @@ MultiParticleContainer::deleteInvalidParticles ()
 void
 MultiParticleContainer::RedistributeLocal (const int num_ghost)
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::ParticleCommunication);
+    const ablastr::utils::communication::ScopedCommSite comm_site("Redistribute");
+    const ablastr::utils::communication::ScopedCommWait comm_wait;
     for (auto& pc : allcontainers) {
         pc->Redistribute(0, 0, 0, num_ghost);
     }
@@ -907,13 +1065,21 @@ MultiParticleContainer::doFieldIonization (int lev,
             auto& src_tile = pc_source ->ParticlesAt(lev, pti);
             auto& dst_tile = pc_product->ParticlesAt(lev, pti);
 
+            // Skip the tile if the field is too weak to ionize any of its particles
+            if (phys_pc_ptr->isIonizationNegligibleInTile(pti, Ex.nGrowVect(),
+                                                          Ex[pti], Ey[pti], Ez[pti],
+                                                          Bx[pti], By[pti], Bz[pti])) {
+                continue;
+            }
+
             auto Filter = phys_pc_ptr->getIonizationFunc(pti, lev, Ex.nGrowVect(),
                                                          Ex[pti], Ey[pti], Ez[pti],
                                                          Bx[pti], By[pti], Bz[pti]);
 
             const auto np_dst = dst_tile.numParticles();
             const auto num_added = filterCopyTransformParticles<1>(*pc_product, dst_tile, src_tile, np_dst,
-                                                                   Filter, Copy, Transform);
+                                                                   Filter, Copy, Transform,
+                                                                   pc_source->getCreationScratch(lev, pti.index(), pti.LocalTileIndex()));
 
             setNewParticleIDs(dst_tile, np_dst, num_added);
 
@@ -956,14 +1122,90 @@ void MultiParticleContainer::CheckIonizationProductSpecies()
     }
 }
 
-void MultiParticleContainer::ScrapeParticlesAtEB (const amrex::Vector<const amrex::MultiFab*>& distance_to_eb)
+void MultiParticleContainer::UpdateExtParticleFieldsGrid ()
+{
+    if (!m_E_ext_particle_on_grid && !m_B_ext_particle_on_grid) { return; }
+
+    auto& warpx = WarpX::GetInstance();
+    m_ext_particle_fields_grid.resize(warpx.finestLevel()+1);
+
+    for (int lev = 0; lev <= warpx.finestLevel(); ++lev) {
+        auto& grid = m_ext_particle_fields_grid[lev];
+        const amrex::BoxArray& ba = warpx.boxArray(lev);
+        const amrex::DistributionMapping& dm = warpx.DistributionMap(lev);
+        if (grid && grid->boxArray().CellEqual(ba) && grid->DistributionMap() == dm) { continue; }
+
+        // Use as many guard cells as the fields gathered by the particles
+        const amrex::IntVect ng = warpx.getField(FieldType::Efield_aux, lev, 0).nGrowVect();
+        grid = std::make_unique<amrex::MultiFab>(
+            amrex::convert(ba, amrex::IntVect::TheNodeVector()), dm, 6, ng);
+        grid->setVal(0._rt);
+
+        const bool E_on_grid = m_E_ext_particle_on_grid;
+        const bool B_on_grid = m_B_ext_particle_on_grid;
+        constexpr auto num_arguments = 4; //x,y,z,t
+        amrex::ParserExecutor<num_arguments> Ex_parser, Ey_parser, Ez_parser;
+        amrex::ParserExecutor<num_arguments> Bx_parser, By_parser, Bz_parser;
+        if (E_on_grid) {
+            Ex_parser = m_Ex_particle_parser->compile<num_arguments>();
+            Ey_parser = m_Ey_particle_parser->compile<num_arguments>();
+            Ez_parser = m_Ez_particle_parser->compile<num_arguments>();
+        }
+        if (B_on_grid) {
+            Bx_parser = m_Bx_particle_parser->compile<num_arguments>();
+            By_parser = m_By_particle_parser->compile<num_arguments>();
+            Bz_parser = m_Bz_particle_parser->compile<num_arguments>();
+        }
+
+        const auto plo = warpx.Geom(lev).ProbLoArray();
+        const auto dx = warpx.Geom(lev).CellSizeArray();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (amrex::MFIter mfi(*grid, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+            const amrex::Box bx = mfi.growntilebox();
+            const amrex::Array4<amrex::Real> fields = grid->array(mfi);
+            amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                // Position of the node, with the same conventions as GetParticlePosition
+#if defined(WARPX_DIM_3D)
+                const amrex::Real x = plo[0] + i*dx[0];
+                const amrex::Real y = plo[1] + j*dx[1];
+                const amrex::Real z = plo[2] + k*dx[2];
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                const amrex::Real x = plo[0] + i*dx[0];
+                const amrex::Real y = 0._rt;
+                const amrex::Real z = plo[1] + j*dx[1];
+                amrex::ignore_unused(k);
+#else
+                const amrex::Real x = 0._rt;
+                const amrex::Real y = 0._rt;
+                const amrex::Real z = plo[0] + i*dx[0];
+                amrex::ignore_unused(j, k);
+#endif
+                if (E_on_grid) {
+                    fields(i, j, k, 0) = Ex_parser(x, y, z, 0._rt);
+                    fields(i, j, k, 1) = Ey_parser(x, y, z, 0._rt);
+                    fields(i, j, k, 2) = Ez_parser(x, y, z, 0._rt);
+                }
+                if (B_on_grid) {
+                    fields(i, j, k, 3) = Bx_parser(x, y, z, 0._rt);
+                    fields(i, j, k, 4) = By_parser(x, y, z, 0._rt);
+                    fields(i, j, k, 5) = Bz_parser(x, y, z, 0._rt);
+                }
+            });
+        }
+    }
+}
+
+void MultiParticleContainer::ScrapeParticlesAtEB (const amrex::Vector<const amrex::MultiFab*>& distance_to_eb,
+                                                  const amrex::Vector<const amrex::LayoutData<int>*>& near_eb_box)
 {
 #ifdef AMREX_USE_EB
     for (auto& pc : allcontainers) {
-        scrapeParticlesAtEB(*pc, distance_to_eb, ParticleBoundaryProcess::Absorb());
+        scrapeParticlesAtEB(*pc, distance_to_eb, near_eb_box, ParticleBoundaryProcess::Absorb());
     }
 #else
-    amrex::ignore_unused(distance_to_eb);
+    amrex::ignore_unused(distance_to_eb, near_eb_box);
 #endif
 }
 
@@ -1018,6 +1260,24 @@ void MultiParticleContainer::InitQuantumSync ()
             ablastr::warn_manager::WarnPriority::low);
     }
 
+    // Optional merging of the photons created in a time step
+    pp_qed_qs.query("photon_merging", m_quantum_sync_photon_merging);
+    if (m_quantum_sync_photon_merging) {
+        utils::parser::queryWithParser(
+            pp_qed_qs, "photon_merging_n_theta", m_quantum_sync_photon_merging_n_theta);
+        utils::parser::queryWithParser(
+            pp_qed_qs, "photon_merging_n_phi", m_quantum_sync_photon_merging_n_phi);
+        utils::parser::queryWithParser(
+            pp_qed_qs, "photon_merging_energy_bins_per_decade",
+            m_quantum_sync_photon_merging_energy_bins_per_decade);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            m_quantum_sync_photon_merging_n_theta >= 1 &&
+            m_quantum_sync_photon_merging_n_phi >= 1 &&
+            m_quantum_sync_photon_merging_energy_bins_per_decade >= 1,
+            "qed_qs.photon_merging_n_theta, photon_merging_n_phi and "
+            "photon_merging_energy_bins_per_decade must be at least 1");
+    }
+
     // qs_minimum_chi_part is the minimum chi parameter to be
     // considered for Synchrotron emission. If a lepton has chi < chi_min,
     // the optical depth is not evolved and photon generation is ignored
@@ -1049,10 +1309,10 @@ void MultiParticleContainer::InitQuantumSync ()
         if(load_table_name.empty()){
             WARPX_ABORT_WITH_MESSAGE("Quantum Synchrotron table name should be provided");
         }
-        Vector<char> table_data;
-        ParallelDescriptor::ReadAndBcastFile(load_table_name, table_data);
+        const ablastr::parallelization::NodeSharedBuffer table_data(load_table_name);
         ParallelDescriptor::Barrier();
-        m_shr_p_qs_engine->init_lookup_tables_from_raw_data(table_data,
+        m_shr_p_qs_engine->init_lookup_tables_from_raw_data(
+            table_data.data(), table_data.size(),
             qs_minimum_chi_part);
     }
     else if(lookup_table_mode == "builtin"){
@@ -1108,11 +1368,10 @@ void MultiParticleContainer::InitBreitWheeler ()
         if(load_table_name.empty()){
             WARPX_ABORT_WITH_MESSAGE("Breit Wheeler table name should be provided");
         }
-        Vector<char> table_data;
-        ParallelDescriptor::ReadAndBcastFile(load_table_name, table_data);
+        const ablastr::parallelization::NodeSharedBuffer table_data(load_table_name);
         ParallelDescriptor::Barrier();
         m_shr_p_bw_engine->init_lookup_tables_from_raw_data(
-            table_data, bw_minimum_chi_part);
+            table_data.data(), table_data.size(), bw_minimum_chi_part);
     }
     else if(lookup_table_mode == "builtin"){
         ablastr::warn_manager::WMRecordWarning("QED",
@@ -1140,6 +1399,9 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
         !table_name.empty(),
         "qed_qs.save_table_in should be provided!");
 
+    std::string cache_dir;
+    pp_qed_qs.query("table_cache_dir", cache_dir);
+
     // qs_minimum_chi_part is the minimum chi parameter to be
     // considered for Synchrotron emission. If a lepton has chi < chi_min,
     // the optical depth is not evolved and photon generation is ignored
@@ -1201,22 +1463,50 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
             pp_qed_qs, "tab_em_frac_how_many", ctrl.phot_em_params.frac_how_many);
         //====================
 
-        m_shr_p_qs_engine->compute_lookup_tables(ctrl, qs_minimum_chi_part);
-        const auto data = m_shr_p_qs_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
+        std::string cache_file;
+        Vector<char> cached_data;
+        bool is_loaded_from_cache = false;
+        if (!cache_dir.empty()) {
+            constexpr int permission_flag_rwxrxrx = 0755;
+            amrex::UtilCreateDirectory(cache_dir, permission_flag_rwxrxrx);
+            cache_file = QedTableCacheFile(cache_dir, "qs", {
+                static_cast<double>(ctrl.dndt_params.chi_part_min),
+                static_cast<double>(ctrl.dndt_params.chi_part_max),
+                static_cast<double>(ctrl.dndt_params.chi_part_how_many),
+                static_cast<double>(ctrl.phot_em_params.chi_part_min),
+                static_cast<double>(ctrl.phot_em_params.chi_part_max),
+                static_cast<double>(ctrl.phot_em_params.chi_part_how_many),
+                static_cast<double>(ctrl.phot_em_params.frac_min),
+                static_cast<double>(ctrl.phot_em_params.frac_how_many)});
+            is_loaded_from_cache = ReadQedTableFromCache(cache_file, cached_data) &&
+                m_shr_p_qs_engine->init_lookup_tables_from_raw_data(
+                    cached_data.data(), cached_data.size(), qs_minimum_chi_part);
+        }
+
+        if (is_loaded_from_cache) {
+            ablastr::warn_manager::WMRecordWarning("QED",
+                "The Quantum Synchrotron table is read from the cache file: " + cache_file,
+                ablastr::warn_manager::WarnPriority::low);
+            WarpXUtilIO::WriteBinaryDataOnFile(table_name, cached_data);
+        }
+        else {
+            m_shr_p_qs_engine->compute_lookup_tables(ctrl, qs_minimum_chi_part);
+            const auto data = m_shr_p_qs_engine->export_lookup_tables_data();
+            const auto vdata = Vector<char>{data.begin(), data.end()};
+            WarpXUtilIO::WriteBinaryDataOnFile(table_name, vdata);
+            if (!cache_file.empty()) { WriteQedTableInCache(cache_file, vdata); }
+        }
     }
 
     ParallelDescriptor::Barrier();
-    Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
+    const ablastr::parallelization::NodeSharedBuffer table_data(table_name);
     ParallelDescriptor::Barrier();
 
     //No need to initialize from raw data for the processor that
     //has just generated the table
     if(!ParallelDescriptor::IOProcessor()){
         m_shr_p_qs_engine->init_lookup_tables_from_raw_data(
-            table_data, qs_minimum_chi_part);
+            table_data.data(), table_data.size(), qs_minimum_chi_part);
     }
 }
 
@@ -1230,6 +1520,9 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
         !table_name.empty(),
         "qed_bw.save_table_in should be provided!");
 
+    std::string cache_dir;
+    pp_qed_bw.query("table_cache_dir", cache_dir);
+
     // bw_minimum_chi_phot is the minimum chi parameter to be
     // considered for pair production. If a photon has chi < chi_min,
     // the optical depth is not evolved and photon generation is ignored
@@ -1286,22 +1579,49 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
             pp_qed_bw, "tab_pair_frac_how_many", ctrl.pair_prod_params.frac_how_many);
         //====================
 
-        m_shr_p_bw_engine->compute_lookup_tables(ctrl, bw_minimum_chi_part);
-        const auto data = m_shr_p_bw_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
+        std::string cache_file;
+        Vector<char> cached_data;
+        bool is_loaded_from_cache = false;
+        if (!cache_dir.empty()) {
+            constexpr int permission_flag_rwxrxrx = 0755;
+            amrex::UtilCreateDirectory(cache_dir, permission_flag_rwxrxrx);
+            cache_file = QedTableCacheFile(cache_dir, "bw", {
+                static_cast<double>(ctrl.dndt_params.chi_phot_min),
+                static_cast<double>(ctrl.dndt_params.chi_phot_max),
+                static_cast<double>(ctrl.dndt_params.chi_phot_how_many),
+                static_cast<double>(ctrl.pair_prod_params.chi_phot_min),
+                static_cast<double>(ctrl.pair_prod_params.chi_phot_max),
+                static_cast<double>(ctrl.pair_prod_params.chi_phot_how_many),
+                static_cast<double>(ctrl.pair_prod_params.frac_how_many)});
+            is_loaded_from_cache = ReadQedTableFromCache(cache_file, cached_data) &&
+                m_shr_p_bw_engine->init_lookup_tables_from_raw_data(
+                    cached_data.data(), cached_data.size(), bw_minimum_chi_part);
+        }
+
+        if (is_loaded_from_cache) {
+            ablastr::warn_manager::WMRecordWarning("QED",
+                "The Breit Wheeler table is read from the cache file: " + cache_file,
+                ablastr::warn_manager::WarnPriority::low);
+            WarpXUtilIO::WriteBinaryDataOnFile(table_name, cached_data);
+        }
+        else {
+            m_shr_p_bw_engine->compute_lookup_tables(ctrl, bw_minimum_chi_part);
+            const auto data = m_shr_p_bw_engine->export_lookup_tables_data();
+            const auto vdata = Vector<char>{data.begin(), data.end()};
+            WarpXUtilIO::WriteBinaryDataOnFile(table_name, vdata);
+            if (!cache_file.empty()) { WriteQedTableInCache(cache_file, vdata); }
+        }
     }
 
     ParallelDescriptor::Barrier();
-    Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
+    const ablastr::parallelization::NodeSharedBuffer table_data(table_name);
     ParallelDescriptor::Barrier();
 
     //No need to initialize from raw data for the processor that
     //has just generated the table
     if(!ParallelDescriptor::IOProcessor()){
         m_shr_p_bw_engine->init_lookup_tables_from_raw_data(
-            table_data, bw_minimum_chi_part);
+            table_data.data(), table_data.size(), bw_minimum_chi_part);
     }
 }
 
@@ -1362,6 +1682,9 @@ MultiParticleContainer::doQEDSchwinger ()
     const MultiFab & By = warpx.getField(FieldType::Bfield_aux, level_0,1);
     const MultiFab & Bz = warpx.getField(FieldType::Bfield_aux, level_0,2);
 
+    // Get the box representing global Schwinger boundaries
+    const amrex::Box global_schwinger_box = ComputeSchwingerGlobalBox();
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
@@ -1370,14 +1693,27 @@ MultiParticleContainer::doQEDSchwinger ()
         // Make the box cell centered to avoid creating particles twice on the tile edges
         amrex::Box box = enclosedCells(mfi.nodaltilebox());
 
-        // Get the box representing global Schwinger boundaries
-        const amrex::Box global_schwinger_box = ComputeSchwingerGlobalBox();
-
         // If Schwinger process is not activated anywhere in the current box, we move to the next
         // one. Otherwise we use the intersection of current box with global Schwinger box.
         if (!box.intersects(global_schwinger_box)) {continue;}
         box &= global_schwinger_box;
 
+        // If the fields are too weak to create pairs anywhere in the tile, we move to the
+        // next one, before evaluating the rate in each cell
+        if (m_qed_schwinger_tile_skip_threshold >= 0._rt) {
+            const auto maxabs = [&box] (const amrex::FArrayBox& fab) {
+                const amrex::Box b = amrex::convert(box, fab.box().ixType()) & fab.box();
+                return b.ok() ? fab.maxabs<amrex::RunOn::Device>(b, 0) : 0._rt;
+            };
+            const amrex::Real ex = maxabs(Ex[mfi]), ey = maxabs(Ey[mfi]), ez = maxabs(Ez[mfi]);
+            const amrex::Real bx = maxabs(Bx[mfi]), by = maxabs(By[mfi]), bz = maxabs(Bz[mfi]);
+            const amrex::Real pairs_per_cell_max = getSchwingerExpectedNumberUpperBound(dV, dt,
+                static_cast<amrex::ParticleReal>(std::sqrt(ex*ex + ey*ey + ez*ez)),
+                static_cast<amrex::ParticleReal>(std::sqrt(bx*bx + by*by + bz*bz)));
+            if (pairs_per_cell_max*static_cast<amrex::Real>(box.numPts()) <=
+                m_qed_schwinger_tile_skip_threshold) {continue;}
+        }
+
         const MyFieldList fieldsEB = {
             Ex[mfi].array(), Ey[mfi].array(), Ez[mfi].array(),
             Bx[mfi].array(), By[mfi].array(), Bz[mfi].array()};
@@ -1404,7 +1740,8 @@ MultiParticleContainer::doQEDSchwinger ()
         const auto num_added = filterCreateTransformFromFAB<1>( *pc_product_ele, *pc_product_pos, dst_ele_tile,
                                dst_pos_tile, box, fieldsEB, np_ele_dst,
                                np_pos_dst,Filter, CreateEle, CreatePos,
-                               Transform, geom_level_zero);
+                               Transform, geom_level_zero,
+                               pc_product_ele->getCreationScratch(level_0, mfi.index(), mfi.LocalTileIndex()));
 
         setNewParticleIDs(dst_ele_tile, np_ele_dst, num_added);
         setNewParticleIDs(dst_pos_tile, np_pos_dst, num_added);
@@ -1557,7 +1894,8 @@ void MultiParticleContainer::doQedBreitWheeler (int lev,
             const auto num_added = filterCopyTransformParticles<1>(*pc_product_ele, *pc_product_pos,
                                                       dst_ele_tile, dst_pos_tile,
                                                       src_tile, np_dst_ele, np_dst_pos,
-                                                      Filter, CopyEle, CopyPos, Transform);
+                                                      Filter, CopyEle, CopyPos, Transform,
+                                                      pc_source->getCreationScratch(lev, pti.index(), pti.LocalTileIndex()));
 
             setNewParticleIDs(dst_ele_tile, np_dst_ele, num_added);
             setNewParticleIDs(dst_pos_tile, np_dst_pos, num_added);
@@ -1602,6 +1940,11 @@ void MultiParticleContainer::doQedQuantumSync (int lev,
         const auto Filter   = phys_pc_ptr->getPhotonEmissionFilterFunc();
         const auto CopyPhot = copy_factory_phot.getSmartCopy();
 
+        PhotonMergingParams merging_params;
+        merging_params.n_theta = m_quantum_sync_photon_merging_n_theta;
+        merging_params.n_phi = m_quantum_sync_photon_merging_n_phi;
+        merging_params.energy_bins_per_decade = m_quantum_sync_photon_merging_energy_bins_per_decade;
+
         pc_source ->defineAllParticleTiles();
         pc_product_phot->defineAllParticleTiles();
 
@@ -1635,14 +1978,26 @@ void MultiParticleContainer::doQedQuantumSync (int lev,
 
             const auto num_added =
                 filterCopyTransformParticles<1>(*pc_product_phot, dst_tile, src_tile, np_dst,
-                                                Filter, CopyPhot, Transform);
+                                                Filter, CopyPhot, Transform,
+                                                pc_source->getCreationScratch(lev, pti.index(), pti.LocalTileIndex()));
 
             setNewParticleIDs(dst_tile, np_dst, num_added);
 
-            cleanLowEnergyPhotons(
+            const auto discarded = cleanLowEnergyPhotons(
                                   dst_tile, np_dst, num_added,
                                   m_quantum_sync_photon_creation_energy_threshold);
 
+            auto& stats = pc_source->m_quantum_sync_photon_stats;
+            amrex::HostDevice::Atomic::Add(&stats.discarded_weight, discarded[0]);
+            amrex::HostDevice::Atomic::Add(&stats.discarded_energy, discarded[1]);
+
+            if (m_quantum_sync_photon_merging) {
+                const auto num_merged = mergeNewPhotons(
+                    lev, pti, dst_tile, static_cast<int>(np_dst), static_cast<int>(num_added),
+                    merging_params);
+                amrex::HostDevice::Atomic::Add(&stats.merged, static_cast<amrex::Long>(num_merged));
+            }
+
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
             {
                 amrex::Gpu::synchronize();
@@ -9,6 +9,7 @@
 #include "EmbeddedBoundary/DistanceToEB.H"
 #include "Particles/ParticleBoundaryBuffer.H"
 #include "Particles/MultiParticleContainer.H"
+#include "Utils/ParticleUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "Particles/Pusher/GetAndSetPosition.H"
@@ -346,6 +347,16 @@ const std::vector<std::string>& ParticleBoundaryBuffer::getSpeciesNames() const
     return m_species_names;
 }
 
+amrex::Long ParticleBoundaryBuffer::MemoryUsage () const {
+    amrex::Long bytes = 0;
+    for (auto const& buffer : m_particle_containers) {
+        for (auto const& species_buffer : buffer) {
+            if (species_buffer.isDefined()) { bytes += ParticleUtils::MemoryUsage(species_buffer); }
+        }
+    }
+    return bytes;
+}
+
 void ParticleBoundaryBuffer::clearParticles () {
     for (int i = 0; i < numBoundaries(); ++i)
     {
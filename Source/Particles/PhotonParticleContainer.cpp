@@ -18,6 +18,8 @@
 #include "Particles/Pusher/UpdatePositionPhoton.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
 #include <AMReX_Array.H>
@@ -27,6 +29,7 @@
 #include <AMReX_Dim3.H>
 #include <AMReX_Extension.H>
 #include <AMReX_FArrayBox.H>
+#include <AMReX_GpuAtomic.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_IndexType.H>
@@ -116,24 +119,31 @@ PhotonParticleContainer::PushPX (WarpXParIter& pti,
     ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr() + offset;
     ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr() + offset;
 
+    auto copyAttribs = CopyParticleAttribs(pti, tmp_particle_data, offset);
+    const int do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf) );
+
+    const auto GetPosition = GetParticlePosition<PIdx>(pti, offset);
+    auto SetPosition = SetParticlePosition<PIdx>(pti, offset);
+
+    const auto getExternalEB = GetExternalEBField(pti, offset);
+
 #ifdef WARPX_QED
+    // If chi is below chi_min for all the photons of the tile, the optical depth is
+    // not evolved, and the fields do not need to be gathered
+    const bool is_chi_below_min = has_breit_wheeler() &&
+        isChiBelowMinimumInTile(pti, offset, np_to_push,
+                                exfab, eyfab, ezfab, bxfab, byfab, bzfab, box,
+                                m_shr_p_bw_engine->get_minimum_chi_phot());
+
     BreitWheelerEvolveOpticalDepth evolve_opt;
     amrex::ParticleReal* AMREX_RESTRICT p_optical_depth_BW = nullptr;
-    const bool local_has_breit_wheeler = has_breit_wheeler();
+    const bool local_has_breit_wheeler = has_breit_wheeler() && !is_chi_below_min;
     if (local_has_breit_wheeler) {
         evolve_opt = m_shr_p_bw_engine->build_evolve_functor();
         p_optical_depth_BW = pti.GetAttribs(particle_comps["opticalDepthBW"]).dataPtr() + offset;
     }
 #endif
 
-    auto copyAttribs = CopyParticleAttribs(pti, tmp_particle_data, offset);
-    const int do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf) );
-
-    const auto GetPosition = GetParticlePosition<PIdx>(pti, offset);
-    auto SetPosition = SetParticlePosition<PIdx>(pti, offset);
-
-    const auto getExternalEB = GetExternalEBField(pti, offset);
-
     const amrex::ParticleReal Ex_external_particle = m_E_external_particle[0];
     const amrex::ParticleReal Ey_external_particle = m_E_external_particle[1];
     const amrex::ParticleReal Ez_external_particle = m_E_external_particle[2];
@@ -196,17 +206,20 @@ PhotonParticleContainer::PushPX (WarpXParIter& pti,
             amrex::ParticleReal Byp = By_external_particle;
             amrex::ParticleReal Bzp = Bz_external_particle;
 
-            if(!t_do_not_gather){
-                // first gather E and B to the particle positions
-                doGatherShapeN(x, y, z, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                               ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
-                               ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
-                               dx_arr, xyzmin_arr, lo, n_rz_azimuthal_modes,
-                               nox, galerkin_interpolation);
+            // The fields are only used to evolve the optical depth
+            if constexpr (qed_control == has_qed) {
+                if(!t_do_not_gather){
+                    // first gather E and B to the particle positions
+                    doGatherShapeN(x, y, z, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                                   ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                                   ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                                   dx_arr, xyzmin_arr, lo, n_rz_azimuthal_modes,
+                                   nox, galerkin_interpolation);
+                }
             }
 
             [[maybe_unused]] const auto& getExternalEB_tmp = getExternalEB; // workaround for nvcc
-            if constexpr (exteb_control == has_exteb) {
+            if constexpr (exteb_control == has_exteb && qed_control == has_qed) {
                 getExternalEB(i, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
             }
 
@@ -240,19 +253,77 @@ PhotonParticleContainer::Evolve (int lev,
                                  MultiFab* rho, MultiFab* crho,
                                  const MultiFab* cEx, const MultiFab* cEy, const MultiFab* cEz,
                                  const MultiFab* cBx, const MultiFab* cBy, const MultiFab* cBz,
-                                 Real t, Real dt, DtType a_dt_type, bool skip_deposition,
+                                 Real t, Real dt, DtType a_dt_type, bool /*skip_deposition*/,
                                  PushType push_type)
 {
-    // This does gather, push and deposit.
-    // Push and deposit have been re-written for photons
-    PhysicalParticleContainer::Evolve (lev,
-                                       Ex, Ey, Ez,
-                                       Bx, By, Bz,
-                                       jx, jy, jz,
-                                       cjx, cjy, cjz,
-                                       rho, crho,
-                                       cEx, cEy, cEz,
-                                       cBx, cBy, cBz,
-                                       t, dt, a_dt_type, skip_deposition, push_type);
+    // Photons deposit neither charge nor current
+    constexpr bool skip_deposition = true;
 
+    // The fields are gathered only to evolve the optical depth of the Breit-Wheeler process
+#ifdef WARPX_QED
+    const bool needs_fields = has_breit_wheeler();
+#else
+    const bool needs_fields = false;
+#endif
+
+    if (needs_fields || push_type != PushType::Explicit || m_push_interval > 1 || do_splitting)
+    {
+        // This does gather and push.
+        // The push has been re-written for photons.
+        PhysicalParticleContainer::Evolve (lev,
+                                           Ex, Ey, Ez,
+                                           Bx, By, Bz,
+                                           jx, jy, jz,
+                                           cjx, cjy, cjz,
+                                           rho, crho,
+                                           cEx, cEy, cEz,
+                                           cBx, cBy, cBz,
+                                           t, dt, a_dt_type, skip_deposition, push_type);
+        return;
+    }
+
+    // Without gather, the photons only move in straight lines: the particles are neither
+    // partitioned into the gather and current buffers, nor are the fields filtered
+    WARPX_PROFILE("PhotonParticleContainer::Evolve()");
+
+    if (do_not_push) { return; }
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+
+    if (m_do_back_transformed_particles)
+    {
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            const auto np = pti.numParticles();
+            const auto t_lev = pti.GetLevel();
+            const auto index = pti.GetPairIndex();
+            tmp_particle_data.resize(finestLevel()+1);
+            for (int i = 0; i < TmpIdx::nattribs; ++i) {
+                tmp_particle_data[t_lev][index][i].resize(np);
+            }
+        }
+    }
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+    {
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+        }
+        auto wt = static_cast<amrex::Real>(amrex::second());
+
+        PushPX(pti, &Ex[pti], &Ey[pti], &Ez[pti], &Bx[pti], &By[pti], &Bz[pti],
+               Ex.nGrowVect(), 0, 0, pti.numParticles(), lev, lev, dt,
+               ScaleFields(false), a_dt_type);
+
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+            wt = static_cast<amrex::Real>(amrex::second()) - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[pti.index()], wt);
+        }
+    }
 }
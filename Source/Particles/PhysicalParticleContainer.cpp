@@ -10,18 +10,24 @@
  */
 #include "PhysicalParticleContainer.H"
 
-#include "Filter/NCIGodfreyFilter.H"
+#include "FieldSolver/Fields.H"
 #include "Initialization/InjectorDensity.H"
 #include "Initialization/InjectorMomentum.H"
 #include "Initialization/InjectorPosition.H"
 #include "MultiParticleContainer.H"
 #ifdef WARPX_QED
 #   include "Particles/ElementaryProcess/QEDInternals/BreitWheelerEngineWrapper.H"
+#   include "Particles/ElementaryProcess/QEDInternals/QedChiFunctions.H"
 #   include "Particles/ElementaryProcess/QEDInternals/QuantumSyncEngineWrapper.H"
 #endif
+#include "Particles/Deposition/CurrentDeposition.H"
+#include "Particles/Deposition/DepositionReal.H"
+#include "Particles/Deposition/SharedDepositionUtils.H"
 #include "Particles/Gather/FieldGather.H"
 #include "Particles/Gather/GetExternalFields.H"
 #include "Particles/ParticleCreation/DefaultInitialization.H"
+#include "Particles/ParticleCreation/FilterCopyTransform.H"
+#include "Particles/ParticleCreation/SmartCopy.H"
 #include "Particles/Pusher/CopyParticleAttribs.H"
 #include "Particles/Pusher/GetAndSetPosition.H"
 #include "Particles/Pusher/PushSelector.H"
@@ -64,7 +70,6 @@
 #include <AMReX_GpuBuffer.H>
 #include <AMReX_GpuControl.H>
 #include <AMReX_GpuDevice.H>
-#include <AMReX_GpuElixir.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_INT.H>
@@ -77,14 +82,17 @@
 #include <AMReX_PODVector.H>
 #include <AMReX_ParGDB.H>
 #include <AMReX_ParIter.H>
+#include <AMReX_OpenMP.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Particle.H>
 #include <AMReX_ParticleContainerBase.H>
 #include <AMReX_AmrParticles.H>
 #include <AMReX_ParticleTile.H>
+#include <AMReX_ParticleUtil.H>
 #include <AMReX_Print.H>
 #include <AMReX_Random.H>
+#include <AMReX_Reduce.H>
 #include <AMReX_SPACE.H>
 #include <AMReX_Scan.H>
 #include <AMReX_StructOfArrays.H>
@@ -103,6 +111,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <limits>
 #include <map>
@@ -195,54 +204,104 @@ namespace
     }
 
     /**
-     * \brief This function is called in AddPlasma when we want a particle to be removed at the
-     * next call to redistribute. It initializes all the particle properties to zero (to be safe
-     * and avoid any possible undefined behavior before the next call to redistribute) and sets
-     * the particle id to -1 so that it can be effectively deleted.
-     *
-     * \param idcpu particle id soa data
-     * \param pa particle real soa data
-     * \param ip index for soa data
-     * \param do_field_ionization whether species has ionization
-     * \param pi ionization level data
-     * \param has_quantum_sync whether species has quantum synchrotron
-     * \param p_optical_depth_QSR quantum synchrotron optical depth data
-     * \param has_breit_wheeler whether species has Breit-Wheeler
-     * \param p_optical_depth_BW Breit-Wheeler optical depth data
+     * \brief Filter functor of SplitParticles: selects the particles tagged
+     * with DoSplitParticleID (see WarpXParticleContainer::particlePostLocate)
      */
-    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
-    void ZeroInitializeAndSetNegativeID (
-        uint64_t * AMREX_RESTRICT idcpu,
-        const GpuArray<ParticleReal*,PIdx::nattribs>& pa, long& ip,
-        const bool& do_field_ionization, int* pi
-#ifdef WARPX_QED
-        ,const bool& has_quantum_sync, amrex::ParticleReal* AMREX_RESTRICT p_optical_depth_QSR
-        ,const bool& has_breit_wheeler, amrex::ParticleReal* AMREX_RESTRICT p_optical_depth_BW
-#endif
-        ) noexcept
+    struct SplitParticleFilterFunc
     {
-        pa[PIdx::z][ip] = 0._rt;
-#if (AMREX_SPACEDIM >= 2)
-        pa[PIdx::x][ip] = 0._rt;
-#endif
+        template <typename PData>
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        bool operator() (const PData& ptd, int i, const amrex::RandomEngine& /*engine*/) const noexcept
+        {
+            const amrex::Long id = amrex::ConstParticleIDWrapper{ptd.m_idcpu[i]};
+            return id == LongParticleIds::DoSplitParticleID;
+        }
+    };
+
+    /**
+     * \brief Transform functor of SplitParticles: shifts the positions of the split
+     * particles, divides the weight among them and tags them with NoSplitParticleID,
+     * so that they are not split again. The particle that was split is invalidated.
+     */
+    struct SplitParticleTransformFunc
+    {
+        int m_split_type;
+        amrex::GpuArray<ParticleReal,3> m_split_offset;
+        int m_cpuid;
+
+        template <typename DstData, typename SrcData>
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        void operator() (DstData& dst, SrcData& src, int i_src, int i_dst,
+                         amrex::RandomEngine const& /*engine*/) const noexcept
+        {
+            // split_type==0: split in two along each diagonal, otherwise in two along each axis
+            const int np_split = (m_split_type == 0) ? (1 << AMREX_SPACEDIM) : 2*AMREX_SPACEDIM;
+
 #if defined(WARPX_DIM_3D)
-        pa[PIdx::y][ip] = 0._rt;
+            const ParticleReal xp = src.m_rdata[PIdx::x][i_src];
+            const ParticleReal yp = src.m_rdata[PIdx::y][i_src];
+#elif defined(WARPX_DIM_RZ)
+            const ParticleReal rp = src.m_rdata[PIdx::x][i_src];
+            const ParticleReal thetap = src.m_rdata[PIdx::theta][i_src];
+            const ParticleReal xp = rp*std::cos(thetap);
+            const ParticleReal yp = rp*std::sin(thetap);
+#elif defined(WARPX_DIM_XZ)
+            const ParticleReal xp = src.m_rdata[PIdx::x][i_src];
 #endif
-        pa[PIdx::w ][ip] = 0._rt;
-        pa[PIdx::ux][ip] = 0._rt;
-        pa[PIdx::uy][ip] = 0._rt;
-        pa[PIdx::uz][ip] = 0._rt;
-#ifdef WARPX_DIM_RZ
-        pa[PIdx::theta][ip] = 0._rt;
+            const ParticleReal zp = src.m_rdata[PIdx::z][i_src];
+            const ParticleReal wp = src.m_rdata[PIdx::w][i_src];
+
+            for (int ic = 0; ic < np_split; ++ic) {
+                // Shift (-1, 0 or +1) of the split particle along x, y and z
+                int ishift = 0, jshift = 0, kshift = 0;
+#if defined(WARPX_DIM_3D)
+                if (m_split_type == 0) {
+                    ishift = 2*((ic >> 2) & 1) - 1;
+                    jshift = 2*((ic >> 1) & 1) - 1;
+                    kshift = 2*(ic & 1) - 1;
+                } else {
+                    const int shift = 2*(ic/3) - 1;
+                    if (ic % 3 == 0) { ishift = shift; }
+                    else if (ic % 3 == 1) { jshift = shift; }
+                    else { kshift = shift; }
+                }
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                if (m_split_type == 0) {
+                    ishift = 2*(ic >> 1) - 1;
+                    kshift = 2*(ic & 1) - 1;
+                } else {
+                    const int shift = 2*(ic/2) - 1;
+                    if (ic % 2 == 0) { ishift = shift; }
+                    else { kshift = shift; }
+                }
+#else
+                kshift = 2*ic - 1;
 #endif
-        if (do_field_ionization) {pi[ip] = 0;}
-#ifdef WARPX_QED
-        if (has_quantum_sync) {p_optical_depth_QSR[ip] = 0._rt;}
-        if (has_breit_wheeler) {p_optical_depth_BW[ip] = 0._rt;}
+                const int ip = i_dst + ic;
+#if defined(WARPX_DIM_3D)
+                dst.m_rdata[PIdx::x][ip] = xp + ishift*m_split_offset[0];
+                dst.m_rdata[PIdx::y][ip] = yp + jshift*m_split_offset[1];
+#elif defined(WARPX_DIM_RZ)
+                const ParticleReal x = xp + ishift*m_split_offset[0];
+                dst.m_rdata[PIdx::x][ip] = std::sqrt(x*x + yp*yp);
+                dst.m_rdata[PIdx::theta][ip] = std::atan2(yp, x);
+                amrex::ignore_unused(jshift);
+#elif defined(WARPX_DIM_XZ)
+                dst.m_rdata[PIdx::x][ip] = xp + ishift*m_split_offset[0];
+                amrex::ignore_unused(jshift);
+#else
+                amrex::ignore_unused(ishift, jshift);
 #endif
+                dst.m_rdata[PIdx::z][ip] = zp + kshift*m_split_offset[2];
+                dst.m_rdata[PIdx::w][ip] = wp/np_split;
+                dst.m_idcpu[ip] = amrex::SetParticleIDandCPU(
+                    LongParticleIds::NoSplitParticleID, m_cpuid);
+            }
 
-        idcpu[ip] = amrex::ParticleIdCpus::Invalid;
-    }
+            // invalidate the particle that was split
+            src.m_idcpu[i_src] = amrex::ParticleIdCpus::Invalid;
+        }
+    };
 }
 
 PhysicalParticleContainer::PhysicalParticleContainer (AmrCore* amr_core, int ispecies,
@@ -337,6 +396,9 @@ PhysicalParticleContainer::PhysicalParticleContainer (AmrCore* amr_core, int isp
     pp_species_name.query("do_not_deposit", do_not_deposit);
     pp_species_name.query("do_not_gather", do_not_gather);
     pp_species_name.query("do_not_push", do_not_push);
+    pp_species_name.query("push_interval", m_push_interval);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_push_interval >= 1,
+        species_name + ".push_interval must be a positive integer");
 
     pp_species_name.query("do_continuous_injection", do_continuous_injection);
     pp_species_name.query("initialize_self_fields", initialize_self_fields);
@@ -723,8 +785,10 @@ PhysicalParticleContainer::AddPlasmaFromFile(PlasmaInjector & plasma_injector,
     Gpu::HostVector<ParticleReal> particle_uy;
 
 #ifdef WARPX_USE_OPENPMD
-    //TODO: Make changes for read/write in multiple MPI ranks
-    if (ParallelDescriptor::IOProcessor()) {
+    // Each MPI rank reads a contiguous slice of the particles of the file.
+    // The particles are then moved to the rank that owns them by the
+    // Redistribute in AddNParticles.
+    {
         // take ownership of the series and close it when done
         auto series = std::move(plasma_injector.m_openpmd_input_series);
 
@@ -740,38 +804,48 @@ PhysicalParticleContainer::AddPlasmaFromFile(PlasmaInjector & plasma_injector,
         std::string const ps_name = it.particles.begin()->first;
         openPMD::ParticleSpecies ps = it.particles.begin()->second;
 
-        auto const npart = ps["position"]["x"].getExtent()[0];
+        auto const npart_total = ps["position"]["x"].getExtent()[0];
+
+        // Slice of the particles read by this rank
+        auto const nprocs = static_cast<std::uint64_t>(ParallelDescriptor::NProcs());
+        auto const myproc = static_cast<std::uint64_t>(ParallelDescriptor::MyProc());
+        auto const navg = npart_total/nprocs;
+        auto const nleft = npart_total - navg*nprocs;
+        auto const npart = (myproc < nleft) ? navg+1 : navg;
+        auto const ibegin = (myproc < nleft) ? myproc*(navg+1) : myproc*navg + nleft;
+        const openPMD::Offset chunk_offset = {ibegin};
+        const openPMD::Extent chunk_extent = {npart};
 #if !defined(WARPX_DIM_1D_Z)  // 2D, 3D, and RZ
-        const std::shared_ptr<ParticleReal> ptr_x = ps["position"]["x"].loadChunk<ParticleReal>();
-        const std::shared_ptr<ParticleReal> ptr_offset_x = ps["positionOffset"]["x"].loadChunk<ParticleReal>();
+        const std::shared_ptr<ParticleReal> ptr_x = ps["position"]["x"].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
+        const std::shared_ptr<ParticleReal> ptr_offset_x = ps["positionOffset"]["x"].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
         auto const position_unit_x = static_cast<ParticleReal>(ps["position"]["x"].unitSI());
         auto const position_offset_unit_x = static_cast<ParticleReal>(ps["positionOffset"]["x"].unitSI());
 #endif
 #if !(defined(WARPX_DIM_XZ) || defined(WARPX_DIM_1D_Z))
-        const std::shared_ptr<ParticleReal> ptr_y = ps["position"]["y"].loadChunk<ParticleReal>();
-        const std::shared_ptr<ParticleReal> ptr_offset_y = ps["positionOffset"]["y"].loadChunk<ParticleReal>();
+        const std::shared_ptr<ParticleReal> ptr_y = ps["position"]["y"].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
+        const std::shared_ptr<ParticleReal> ptr_offset_y = ps["positionOffset"]["y"].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
         auto const position_unit_y = static_cast<ParticleReal>(ps["position"]["y"].unitSI());
         auto const position_offset_unit_y = static_cast<ParticleReal>(ps["positionOffset"]["y"].unitSI());
 #endif
-        const std::shared_ptr<ParticleReal> ptr_z = ps["position"]["z"].loadChunk<ParticleReal>();
-        const std::shared_ptr<ParticleReal> ptr_offset_z = ps["positionOffset"]["z"].loadChunk<ParticleReal>();
+        const std::shared_ptr<ParticleReal> ptr_z = ps["position"]["z"].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
+        const std::shared_ptr<ParticleReal> ptr_offset_z = ps["positionOffset"]["z"].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
         auto const position_unit_z = static_cast<ParticleReal>(ps["position"]["z"].unitSI());
         auto const position_offset_unit_z = static_cast<ParticleReal>(ps["positionOffset"]["z"].unitSI());
-        const std::shared_ptr<ParticleReal> ptr_ux = ps["momentum"]["x"].loadChunk<ParticleReal>();
+        const std::shared_ptr<ParticleReal> ptr_ux = ps["momentum"]["x"].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
         auto const momentum_unit_x = static_cast<ParticleReal>(ps["momentum"]["x"].unitSI());
-        const std::shared_ptr<ParticleReal> ptr_uz = ps["momentum"]["z"].loadChunk<ParticleReal>();
+        const std::shared_ptr<ParticleReal> ptr_uz = ps["momentum"]["z"].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
         auto const momentum_unit_z = static_cast<ParticleReal>(ps["momentum"]["z"].unitSI());
-        const std::shared_ptr<ParticleReal> ptr_w = ps["weighting"][openPMD::RecordComponent::SCALAR].loadChunk<ParticleReal>();
+        const std::shared_ptr<ParticleReal> ptr_w = ps["weighting"][openPMD::RecordComponent::SCALAR].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
         auto const w_unit = static_cast<ParticleReal>(ps["weighting"][openPMD::RecordComponent::SCALAR].unitSI());
         std::shared_ptr<ParticleReal> ptr_uy = nullptr;
         auto momentum_unit_y = 1.0_prt;
         if (ps["momentum"].contains("y")) {
-            ptr_uy = ps["momentum"]["y"].loadChunk<ParticleReal>();
+            ptr_uy = ps["momentum"]["y"].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
             momentum_unit_y = static_cast<ParticleReal>(ps["momentum"]["y"].unitSI());
         }
         series->flush();  // shared_ptr data can be read now
 
-        if (q_tot != 0.0) {
+        if (q_tot != 0.0 && ParallelDescriptor::IOProcessor()) {
             std::stringstream warnMsg;
             warnMsg << " Loading particle species from file. " << ps_name << ".q_tot is ignored.";
             ablastr::warn_manager::WMRecordWarning("AddPlasmaFromFile",
@@ -813,7 +887,7 @@ PhysicalParticleContainer::AddPlasmaFromFile(PlasmaInjector & plasma_injector,
                 "Simulation box doesn't cover all particles",
                 ablastr::warn_manager::WarnPriority::high);
         }
-    } // IO Processor
+    }
     auto const np = static_cast<long>(particle_z.size());
     const amrex::Vector<ParticleReal> xp(particle_x.data(), particle_x.data() + np);
     const amrex::Vector<ParticleReal> yp(particle_y.data(), particle_y.data() + np);
@@ -856,6 +930,28 @@ PhysicalParticleContainer::DefaultInitializeRuntimeAttributes (
                                        0,pinned_tile.numParticles());
 }
 
+void
+PhysicalParticleContainer::DefaultInitializeRuntimeAttributes (
+    ParticleTileType& ptile,
+    int n_external_attr_real,
+    int n_external_attr_int,
+    int start, int stop)
+{
+    ParticleCreation::DefaultInitializeRuntimeAttributes(ptile,
+                                       n_external_attr_real, n_external_attr_int,
+                                       m_user_real_attribs, m_user_int_attribs,
+                                       particle_comps, particle_icomps,
+                                       amrex::GetVecOfPtrs(m_user_real_attrib_parser),
+                                       amrex::GetVecOfPtrs(m_user_int_attrib_parser),
+#ifdef WARPX_QED
+                                       true,
+                                       m_shr_p_bw_engine.get(),
+                                       m_shr_p_qs_engine.get(),
+#endif
+                                       ionization_initial_level,
+                                       start, stop);
+}
+
 
 void
 PhysicalParticleContainer::CheckAndAddParticle (
@@ -957,6 +1053,10 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
 {
     WARPX_PROFILE("PhysicalParticleContainer::AddPlasma()");
 
+    // The scratch buffers are kept for the next call in the continuous injection of the
+    // moving window, which injects in thin slabs, and released after a bulk injection
+    const bool keep_scratch = do_continuous_injection && part_realbox.ok();
+
     // If no part_realbox is provided, initialize particles in the whole domain
     const Geometry& geom = Geom(lev);
     if (!part_realbox.ok()) { part_realbox = geom.ProbDomain(); }
@@ -1017,12 +1117,44 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
         user_real_attrib_parserexec_pinned[ia] = m_user_real_attrib_parser[ia]->compile<7>();
     }
 
+    // Whether the positions of the candidate particles are drawn at random, in which case
+    // the random numbers of the candidate particles are all drawn in the first pass over the
+    // cells and stored for the second pass (see below)
+#ifdef WARPX_DIM_RZ
+    const bool store_candidates = plasma_injector.hasRandomPositions() || m_rz_random_theta;
+#else
+    const bool store_candidates = plasma_injector.hasRandomPositions();
+#endif
+
+#ifdef WARPX_QED
+    // If a QED effect is enabled, the corresponding optical depth
+    // has to be initialized
+    const bool loc_has_quantum_sync = has_quantum_sync();
+    const bool loc_has_breit_wheeler = has_breit_wheeler();
+
+    //If needed, get the appropriate functors from the engines
+    QuantumSynchrotronGetOpticalDepth quantum_sync_get_opt;
+    BreitWheelerGetOpticalDepth breit_wheeler_get_opt;
+    if(loc_has_quantum_sync){
+        quantum_sync_get_opt =
+            m_shr_p_qs_engine->build_optical_depth_functor();
+    }
+    if(loc_has_breit_wheeler){
+        breit_wheeler_get_opt =
+            m_shr_p_bw_engine->build_optical_depth_functor();
+    }
+#endif
+
+    if (static_cast<int>(m_injection_scratch.size()) < amrex::OpenMP::get_max_threads()) {
+        m_injection_scratch.resize(amrex::OpenMP::get_max_threads());
+    }
+
     MFItInfo info;
     if (do_tiling && Gpu::notInLaunchRegion()) {
         info.EnableTiling(tile_size);
     }
 #ifdef AMREX_USE_OMP
-    info.SetDynamic(true);
+    info.SetDynamic(WarpX::do_dynamic_scheduling);
 #pragma omp parallel if (not WarpX::serialize_initial_conditions)
 #endif
     for (MFIter mfi = MakeMFIter(lev, info); mfi.isValid(); ++mfi)
@@ -1077,9 +1209,14 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
                           overlap_realbox.lo(1),
                           overlap_realbox.lo(2))};
 
+        // Scratch buffers of this thread (the kernels of the previous tile are complete)
+        InjectionScratch& scratch = m_injection_scratch[amrex::OpenMP::get_thread_num()];
+
         // count the number of particles that each cell in overlap_box could add
-        Gpu::DeviceVector<amrex::Long> counts(overlap_box.numPts(), 0);
-        Gpu::DeviceVector<amrex::Long> offset(overlap_box.numPts());
+        auto& counts = scratch.counts;
+        auto& offset = scratch.offset;
+        counts.assign(overlap_box.numPts(), 0);
+        offset.resize(overlap_box.numPts());
         auto *pcounts = counts.data();
         const amrex::IntVect lrrfac = rrfac;
         Box fine_overlap_box; // default Box is NOT ok().
@@ -1134,10 +1271,193 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
 #endif
         });
 
-        // Max number of new particles. All of them are created,
-        // and invalid ones are then discarded
+        // Max number of new particles, i.e. the number of candidate particles
         const amrex::Long max_new_particles = Scan::ExclusiveSum(counts.size(), counts.data(), offset.data());
 
+#ifdef WARPX_DIM_RZ
+        const bool rz_random_theta = m_rz_random_theta;
+#endif
+
+        // Whether the candidate particle at the position r in the unit cell of the cell iv
+        // (at the angle theta in RZ) is actually injected, i.e. it is inside the tile, inside
+        // the bounds of the injector and where the density is above density_min
+        const auto is_injected = [=] AMREX_GPU_HOST_DEVICE (IntVect const& iv, XDim3 const& r,
+                                                            Real theta) noexcept -> bool
+        {
+            auto pos = getCellCoords(overlap_corner, dx, r, iv);
+#if defined(WARPX_DIM_3D)
+            amrex::ignore_unused(theta);
+            const bool inside_tile = tile_realbox.contains(XDim3{pos.x,pos.y,pos.z});
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+            const bool inside_tile = tile_realbox.contains(XDim3{pos.x,pos.z,0.0_rt});
+#else
+            amrex::ignore_unused(theta);
+            const bool inside_tile = tile_realbox.contains(XDim3{pos.z,0.0_rt,0.0_rt});
+#endif
+            if (!inside_tile) { return false; }
+            // Save the x and y values to use in the insideBounds checks.
+            // This is needed with WARPX_DIM_RZ since x and y are modified.
+            const Real xb = pos.x;
+            const Real yb = pos.y;
+#ifdef WARPX_DIM_RZ
+            // These x and y are used to get the density
+            pos.x = xb*std::cos(theta);
+            pos.y = xb*std::sin(theta);
+#elif defined(WARPX_DIM_XZ)
+            amrex::ignore_unused(theta);
+#endif
+            // If the particle is not within the species's (lab-frame)
+            // xmin, xmax, ymin, ymax, zmin, zmax, or if the density is below
+            // threshold, the particle is not injected.
+            // Include ballistic correction for plasma species with bulk motion
+            const Real z0 = applyBallisticCorrection(pos, inj_mom, gamma_boost,
+                                                     beta_boost, t);
+            return inj_pos->insideBounds(xb, yb, z0) &&
+                   (inj_rho->getDensity(pos.x, pos.y, z0) >= density_min);
+        };
+
+        // Same as is_injected, but also draws the random angle (RZ with one mode) and the
+        // momentum u of the candidate particle (the full lab-frame momentum in boosted-frame
+        // simulations). The random numbers are drawn in the same order as when the particles
+        // were initialized in a single pass: the angle after the check of the tile, and the
+        // momentum before (lab frame) or after (boosted frame) the check of the density.
+        const auto draw_candidate = [=] AMREX_GPU_HOST_DEVICE (IntVect const& iv, XDim3 const& r,
+                                                               Real theta_offset,
+                                                               amrex::RandomEngine const& engine,
+                                                               Real& theta, XDim3& u) noexcept -> bool
+        {
+            auto pos = getCellCoords(overlap_corner, dx, r, iv);
+#if defined(WARPX_DIM_3D)
+            amrex::ignore_unused(theta_offset, theta);
+            const bool inside_tile = tile_realbox.contains(XDim3{pos.x,pos.y,pos.z});
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+            const bool inside_tile = tile_realbox.contains(XDim3{pos.x,pos.z,0.0_rt});
+#else
+            amrex::ignore_unused(theta_offset, theta);
+            const bool inside_tile = tile_realbox.contains(XDim3{pos.z,0.0_rt,0.0_rt});
+#endif
+            if (!inside_tile) { return false; }
+            const Real xb = pos.x;
+            const Real yb = pos.y;
+#ifdef WARPX_DIM_RZ
+            // With only 1 mode, the angle doesn't matter so choose it randomly.
+            theta = (nmodes == 1 && rz_random_theta)?
+                (2._rt*MathConst::pi*amrex::Random(engine)):
+                (2._rt*MathConst::pi*r.y + theta_offset);
+            pos.x = xb*std::cos(theta);
+            pos.y = xb*std::sin(theta);
+#elif defined(WARPX_DIM_XZ)
+            amrex::ignore_unused(theta_offset, theta);
+#endif
+            const Real z0 = applyBallisticCorrection(pos, inj_mom, gamma_boost,
+                                                     beta_boost, t);
+            if (!inj_pos->insideBounds(xb, yb, z0)) { return false; }
+            if (gamma_boost == 1._rt) {
+                // Lab-frame simulation
+                u = inj_mom->getMomentum(pos.x, pos.y, z0, engine);
+                return inj_rho->getDensity(pos.x, pos.y, z0) >= density_min;
+            }
+            // Boosted-frame simulation
+            if (inj_rho->getDensity(pos.x, pos.y, z0) < density_min) { return false; }
+            u = inj_mom->getMomentum(pos.x, pos.y, 0._rt, engine);
+            return true;
+        };
+
+        // First pass: count the candidate particles that are actually injected in each cell,
+        // so that the particle tile is allocated with the exact number of injected particles.
+        // Regular positions are computed again in the second pass, so that only the counts per
+        // cell are stored, and the second pass draws the random numbers of the particles.
+        // Random positions cannot be drawn again identically: their random numbers are then
+        // all drawn in the first pass, in the same order as when the particles were initialized
+        // in a single pass, and the position, angle, momentum (and optical depths) of each
+        // candidate particle are stored between the two passes, with a flag.
+        auto& accepted_counts = scratch.accepted_counts;
+        auto& accepted_offset = scratch.accepted_offset;
+        accepted_counts.resize(overlap_box.numPts());
+        accepted_offset.resize(overlap_box.numPts());
+        auto *const paccepted_counts = accepted_counts.data();
+        auto *const paccepted_offset = accepted_offset.data();
+        const amrex::Long num_stored = store_candidates ? max_new_particles : 0;
+        scratch.accepted.resize(num_stored);
+        scratch.unit_positions.resize(num_stored);
+        scratch.momenta.resize(num_stored);
+        auto *const paccepted = scratch.accepted.data();
+        auto *const punit_positions = scratch.unit_positions.data();
+        auto *const pmomenta = scratch.momenta.data();
+#ifdef WARPX_DIM_RZ
+        scratch.thetas.resize(num_stored);
+        auto *const pthetas = scratch.thetas.data();
+#endif
+#ifdef WARPX_QED
+        scratch.optical_depths_QSR.resize(loc_has_quantum_sync ? num_stored : 0);
+        scratch.optical_depths_BW.resize(loc_has_breit_wheeler ? num_stored : 0);
+        auto *const poptical_depths_QSR = scratch.optical_depths_QSR.data();
+        auto *const poptical_depths_BW = scratch.optical_depths_BW.data();
+#endif
+        auto *const poffset = offset.data();
+        amrex::ParallelForRNG(overlap_box,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, amrex::RandomEngine const& engine) noexcept
+        {
+            const IntVect iv = IntVect(AMREX_D_DECL(i, j, k));
+            const auto index = overlap_box.index(iv);
+#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+            amrex::ignore_unused(k);
+#elif defined(WARPX_DIM_1D_Z)
+            amrex::ignore_unused(j,k);
+#endif
+            amrex::Long n_accepted = 0;
+            if (!store_candidates) {
+                // The regular positions do not draw random numbers
+                for (int i_part = 0; i_part < pcounts[index]; ++i_part)
+                {
+                    const XDim3 r = (fine_overlap_box.ok() && fine_overlap_box.contains(iv)) ?
+                        inj_pos->getPositionUnitBox(i_part, lrrfac, engine) :
+                        inj_pos->getPositionUnitBox(i_part, amrex::IntVect::TheUnitVector(), engine);
+                    if (is_injected(iv, r, 2._rt*MathConst::pi*r.y)) { ++n_accepted; }
+                }
+                paccepted_counts[index] = n_accepted;
+                return;
+            }
+
+            Real theta_offset = 0._rt;
+#ifdef WARPX_DIM_RZ
+            if (rz_random_theta) { theta_offset = amrex::Random(engine) * 2._rt * MathConst::pi; }
+#endif
+            for (int i_part = 0; i_part < pcounts[index]; ++i_part)
+            {
+                const XDim3 r = (fine_overlap_box.ok() && fine_overlap_box.contains(iv)) ?
+                  // In the refined injection region: use refinement ratio `lrrfac`
+                  inj_pos->getPositionUnitBox(i_part, lrrfac, engine) :
+                  // Otherwise: use 1 as the refinement ratio
+                  inj_pos->getPositionUnitBox(i_part, amrex::IntVect::TheUnitVector(), engine);
+                Real theta = 0._rt;
+                XDim3 u = {0._rt, 0._rt, 0._rt};
+                const bool accepted = draw_candidate(iv, r, theta_offset, engine, theta, u);
+                const long ic = poffset[index] + i_part;
+                punit_positions[ic] = r;
+                pmomenta[ic] = u;
+                paccepted[ic] = static_cast<char>(accepted);
+#ifdef WARPX_DIM_RZ
+                pthetas[ic] = theta;
+#endif
+                if (!accepted) { continue; }
+#ifdef WARPX_QED
+                if(loc_has_quantum_sync){
+                    poptical_depths_QSR[ic] = quantum_sync_get_opt(engine);
+                }
+                if(loc_has_breit_wheeler){
+                    poptical_depths_BW[ic] = breit_wheeler_get_opt(engine);
+                }
+#endif
+                ++n_accepted;
+            }
+            paccepted_counts[index] = n_accepted;
+        });
+
+        // Exact number of new particles
+        const amrex::Long num_new_particles =
+            Scan::ExclusiveSum(accepted_counts.size(), paccepted_counts, paccepted_offset);
+
         // Update NextID to include particles created in this function
         amrex::Long pid;
 #ifdef AMREX_USE_OMP
@@ -1145,10 +1465,10 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
 #endif
         {
             pid = ParticleType::NextID();
-            ParticleType::NextID(pid+max_new_particles);
+            ParticleType::NextID(pid+num_new_particles);
         }
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-            pid + max_new_particles < LongParticleIds::LastParticleID,
+            pid + num_new_particles < LongParticleIds::LastParticleID,
             "ERROR: overflow on particle id numbers");
 
         const int cpuid = ParallelDescriptor::MyProc();
@@ -1160,7 +1480,7 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
         }
 
         auto const old_size = static_cast<amrex::Long>(particle_tile.size());
-        auto const new_size = old_size + max_new_particles;
+        auto const new_size = old_size + num_new_particles;
         particle_tile.resize(new_size);
 
         auto& soa = particle_tile.GetStructOfArrays();
@@ -1214,10 +1534,6 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
         amrex::ParticleReal* p_optical_depth_QSR = nullptr;
         amrex::ParticleReal* p_optical_depth_BW  = nullptr;
 
-        // If a QED effect is enabled, the corresponding optical depth
-        // has to be initialized
-        const bool loc_has_quantum_sync = has_quantum_sync();
-        const bool loc_has_breit_wheeler = has_breit_wheeler();
         if (loc_has_quantum_sync) {
             p_optical_depth_QSR = soa.GetRealData(
                 particle_comps["opticalDepthQSR"]).data() + old_size;
@@ -1227,38 +1543,21 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
                 particle_comps["opticalDepthBW"]).data() + old_size;
         }
 
-        //If needed, get the appropriate functors from the engines
-        QuantumSynchrotronGetOpticalDepth quantum_sync_get_opt;
-        BreitWheelerGetOpticalDepth breit_wheeler_get_opt;
-        if(loc_has_quantum_sync){
-            quantum_sync_get_opt =
-                m_shr_p_qs_engine->build_optical_depth_functor();
-        }
-        if(loc_has_breit_wheeler){
-            breit_wheeler_get_opt =
-                m_shr_p_bw_engine->build_optical_depth_functor();
-        }
 #endif
 
         const bool loc_do_field_ionization = do_field_ionization;
         const int loc_ionization_initial_level = ionization_initial_level;
 
-        // Loop over all new particles and inject them (creates too many
-        // particles, in particular does not consider xmin, xmax etc.).
-        // The invalid ones are given negative ID and are deleted during the
-        // next redistribute.
-        auto *const poffset = offset.data();
-#ifdef WARPX_DIM_RZ
-        const bool rz_random_theta = m_rz_random_theta;
-#endif
+        // Second pass: loop over the injected particles and initialize them
         amrex::ParallelForRNG(overlap_box,
         [=] AMREX_GPU_DEVICE (int i, int j, int k, amrex::RandomEngine const& engine) noexcept
         {
             const IntVect iv = IntVect(AMREX_D_DECL(i, j, k));
             const auto index = overlap_box.index(iv);
-#ifdef WARPX_DIM_RZ
-            Real theta_offset = 0._rt;
-            if (rz_random_theta) { theta_offset = amrex::Random(engine) * 2._rt * MathConst::pi; }
+#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+            amrex::ignore_unused(k);
+#elif defined(WARPX_DIM_1D_Z)
+            amrex::ignore_unused(j,k);
 #endif
 
             Real scale_fac = 0.0_rt;
@@ -1272,137 +1571,54 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
 #endif
             }
 
+            // index of the next injected particle of this cell
+            amrex::Long ip_next = paccepted_offset[index];
             for (int i_part = 0; i_part < pcounts[index]; ++i_part)
             {
-                long ip = poffset[index] + i_part;
-                pa_idcpu[ip] = amrex::SetParticleIDandCPU(pid+ip, cpuid);
-                const XDim3 r = (fine_overlap_box.ok() && fine_overlap_box.contains(iv)) ?
-                  // In the refined injection region: use refinement ratio `lrrfac`
-                  inj_pos->getPositionUnitBox(i_part, lrrfac, engine) :
-                  // Otherwise: use 1 as the refinement ratio
-                  inj_pos->getPositionUnitBox(i_part, amrex::IntVect::TheUnitVector(), engine);
-                auto pos = getCellCoords(overlap_corner, dx, r, iv);
-
-#if defined(WARPX_DIM_3D)
-                if (!tile_realbox.contains(XDim3{pos.x,pos.y,pos.z})) {
-                    ZeroInitializeAndSetNegativeID(pa_idcpu, pa, ip, loc_do_field_ionization, pi
-#ifdef WARPX_QED
-                                                   ,loc_has_quantum_sync, p_optical_depth_QSR
-                                                   ,loc_has_breit_wheeler, p_optical_depth_BW
-#endif
-                                                   );
-                    continue;
-                }
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-                amrex::ignore_unused(k);
-                if (!tile_realbox.contains(XDim3{pos.x,pos.z,0.0_rt})) {
-                    ZeroInitializeAndSetNegativeID(pa_idcpu, pa, ip, loc_do_field_ionization, pi
-#ifdef WARPX_QED
-                                                   ,loc_has_quantum_sync, p_optical_depth_QSR
-                                                   ,loc_has_breit_wheeler, p_optical_depth_BW
-#endif
-                                                   );
-                    continue;
-                }
-#else
-                amrex::ignore_unused(j,k);
-                if (!tile_realbox.contains(XDim3{pos.z,0.0_rt,0.0_rt})) {
-                    ZeroInitializeAndSetNegativeID(pa_idcpu, pa, ip, loc_do_field_ionization, pi
-#ifdef WARPX_QED
-                                                   ,loc_has_quantum_sync, p_optical_depth_QSR
-                                                   ,loc_has_breit_wheeler, p_optical_depth_BW
+                const long ic = poffset[index] + i_part;
+                XDim3 r;
+                Real theta = 0._rt;
+                XDim3 u;
+                if (store_candidates) {
+                    if (!paccepted[ic]) { continue; }
+                    r = punit_positions[ic];
+                    u = pmomenta[ic];
+#ifdef WARPX_DIM_RZ
+                    theta = pthetas[ic];
 #endif
-                                                   );
-                    continue;
+                } else {
+                    // The regular positions do not draw random numbers
+                    r = (fine_overlap_box.ok() && fine_overlap_box.contains(iv)) ?
+                        inj_pos->getPositionUnitBox(i_part, lrrfac, engine) :
+                        inj_pos->getPositionUnitBox(i_part, amrex::IntVect::TheUnitVector(), engine);
+                    if (!draw_candidate(iv, r, 0._rt, engine, theta, u)) { continue; }
                 }
-#endif
 
-                // Save the x and y values to use in the insideBounds checks.
-                // This is needed with WARPX_DIM_RZ since x and y are modified.
-                const Real xb = pos.x;
-                const Real yb = pos.y;
+                const amrex::Long ip = ip_next++;
+                pa_idcpu[ip] = amrex::SetParticleIDandCPU(pid+ip, cpuid);
+                auto pos = getCellCoords(overlap_corner, dx, r, iv);
 
+#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                const Real xb = pos.x;
+#endif
 #ifdef WARPX_DIM_RZ
-                // Replace the x and y, setting an angle theta.
-                // These x and y are used to get the momentum and density
-                // With only 1 mode, the angle doesn't matter so
-                // choose it randomly.
-                const Real theta = (nmodes == 1 && rz_random_theta)?
-                    (2._rt*MathConst::pi*amrex::Random(engine)):
-                    (2._rt*MathConst::pi*r.y + theta_offset);
                 pos.x = xb*std::cos(theta);
                 pos.y = xb*std::sin(theta);
+#else
+                amrex::ignore_unused(theta);
 #endif
 
-                Real dens;
-                XDim3 u;
-                if (gamma_boost == 1._rt) {
-                    // Lab-frame simulation
-                    // If the particle is not within the species's
-                    // xmin, xmax, ymin, ymax, zmin, zmax, go to
-                    // the next generated particle.
-
-                    // include ballistic correction for plasma species with bulk motion
-                    const Real z0 = applyBallisticCorrection(pos, inj_mom, gamma_boost,
-                                                             beta_boost, t);
-                    if (!inj_pos->insideBounds(xb, yb, z0)) {
-                        ZeroInitializeAndSetNegativeID(pa_idcpu, pa, ip, loc_do_field_ionization, pi
-#ifdef WARPX_QED
-                                                   ,loc_has_quantum_sync, p_optical_depth_QSR
-                                                   ,loc_has_breit_wheeler, p_optical_depth_BW
-#endif
-                                                   );
-                        continue;
-                    }
-
-                    u = inj_mom->getMomentum(pos.x, pos.y, z0, engine);
-                    dens = inj_rho->getDensity(pos.x, pos.y, z0);
+                // The particle was checked to be within the species's (lab-frame)
+                // xmin, xmax, ymin, ymax, zmin, zmax and above density_min in the first pass
 
-                    // Remove particle if density below threshold
-                    if ( dens < density_min ){
-                        ZeroInitializeAndSetNegativeID(pa_idcpu, pa, ip, loc_do_field_ionization, pi
-#ifdef WARPX_QED
-                                                   ,loc_has_quantum_sync, p_optical_depth_QSR
-                                                   ,loc_has_breit_wheeler, p_optical_depth_BW
-#endif
-                                                   );
-                        continue;
-                    }
-                    // Cut density if above threshold
-                    dens = amrex::min(dens, density_max);
-                } else {
+                // include ballistic correction for plasma species with bulk motion
+                const Real z0 = applyBallisticCorrection(pos, inj_mom, gamma_boost,
+                                                         beta_boost, t);
+                // Cut density if above threshold
+                Real dens = amrex::min(inj_rho->getDensity(pos.x, pos.y, z0), density_max);
+                if (gamma_boost != 1._rt) {
                     // Boosted-frame simulation
-                    const Real z0_lab = applyBallisticCorrection(pos, inj_mom, gamma_boost,
-                                                                 beta_boost, t);
-
-                    // If the particle is not within the lab-frame zmin, zmax, etc.
-                    // go to the next generated particle.
-                    if (!inj_pos->insideBounds(xb, yb, z0_lab)) {
-                        ZeroInitializeAndSetNegativeID(pa_idcpu, pa, ip, loc_do_field_ionization, pi
-#ifdef WARPX_QED
-                                                   ,loc_has_quantum_sync, p_optical_depth_QSR
-                                                   ,loc_has_breit_wheeler, p_optical_depth_BW
-#endif
-                                                   );
-                        continue;
-                    }
-                    // call `getDensity` with lab-frame parameters
-                    dens = inj_rho->getDensity(pos.x, pos.y, z0_lab);
-                    // Remove particle if density below threshold
-                    if ( dens < density_min ){
-                        ZeroInitializeAndSetNegativeID(pa_idcpu, pa, ip, loc_do_field_ionization, pi
-#ifdef WARPX_QED
-                                                   ,loc_has_quantum_sync, p_optical_depth_QSR
-                                                   ,loc_has_breit_wheeler, p_optical_depth_BW
-#endif
-                                                   );
-                        continue;
-                    }
-                    // Cut density if above threshold
-                    dens = amrex::min(dens, density_max);
-
-                    // get the full momentum, including thermal motion
-                    u = inj_mom->getMomentum(pos.x, pos.y, 0._rt, engine);
+                    // u is the full momentum, including thermal motion (see draw_candidate)
                     const Real gamma_lab = std::sqrt( 1._rt+(u.x*u.x+u.y*u.y+u.z*u.z) );
                     const Real betaz_lab = u.z/(gamma_lab);
 
@@ -1418,11 +1634,13 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
 
 #ifdef WARPX_QED
                 if(loc_has_quantum_sync){
-                    p_optical_depth_QSR[ip] = quantum_sync_get_opt(engine);
+                    p_optical_depth_QSR[ip] = store_candidates ?
+                        poptical_depths_QSR[ic] : quantum_sync_get_opt(engine);
                 }
 
                 if(loc_has_breit_wheeler){
-                    p_optical_depth_BW[ip] = breit_wheeler_get_opt(engine);
+                    p_optical_depth_BW[ip] = store_candidates ?
+                        poptical_depths_BW[ic] : breit_wheeler_get_opt(engine);
                 }
 #endif
                 // Initialize user-defined integers with user-defined parser
@@ -1481,10 +1699,13 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
         }
     }
 
+    if (!keep_scratch) { m_injection_scratch.clear(); }
+
     // Remove particles that are inside the embedded boundaries
 #ifdef AMREX_USE_EB
     auto & distance_to_eb = WarpX::GetInstance().GetDistanceToEB();
-    scrapeParticlesAtEB( *this, amrex::GetVecOfConstPtrs(distance_to_eb), ParticleBoundaryProcess::Absorb());
+    scrapeParticlesAtEB( *this, amrex::GetVecOfConstPtrs(distance_to_eb),
+                         WarpX::GetInstance().GetNearEBBoxes(), ParticleBoundaryProcess::Absorb());
 #endif
 
     // The function that calls this is responsible for redistributing particles.
@@ -1555,6 +1776,21 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
     constexpr int level_zero = 0;
     const amrex::Real t = WarpX::GetInstance().gett_new(level_zero);
 
+    // With cache_flux_profile, the number of particles of each cell is drawn from the
+    // cached flux of the cell, and all the particles have the weight of the maximum flux
+    amrex::Real const* cached_flux = nullptr;
+    Box flux_plane_box;
+    int flux_normal_dir = -1;
+    amrex::Real flux_max = 0._rt;
+    if (plasma_injector.cache_flux_profile) {
+        auto const& flux_cache = GetFluxProfileCache(plasma_injector);
+        cached_flux = flux_cache.flux.dataPtr();
+        flux_plane_box = flux_cache.plane_box;
+        flux_normal_dir = flux_cache.normal_dir;
+        flux_max = flux_cache.flux_max;
+    }
+    const amrex::Real inv_flux_max = (flux_max > 0._rt) ? 1._rt/flux_max : 0._rt;
+
 #ifdef WARPX_DIM_RZ
     const int nmodes = WarpX::n_rz_azimuthal_modes;
     const bool rz_random_theta = m_rz_random_theta;
@@ -1566,7 +1802,7 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
         info.EnableTiling(tile_size);
     }
 #ifdef AMREX_USE_OMP
-    info.SetDynamic(true);
+    info.SetDynamic(WarpX::do_dynamic_scheduling);
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for (MFIter mfi = MakeMFIter(0, info); mfi.isValid(); ++mfi)
@@ -1678,7 +1914,16 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
                 } else {
                     r = 1;
                 }
-                pcounts[index] = num_ppc_int*r;
+                if (cached_flux) {
+                    IntVect iv_plane = iv + shifted;
+                    if (flux_normal_dir >= 0) { iv_plane[flux_normal_dir] = 0; }
+                    const amrex::Real mean_count = num_ppc_real*static_cast<amrex::Real>(r)*
+                        cached_flux[flux_plane_box.index(iv_plane)]*inv_flux_max;
+                    pcounts[index] = (mean_count > 0._rt) ?
+                        static_cast<int>(amrex::RandomPoisson(mean_count, engine)) : 0;
+                } else {
+                    pcounts[index] = num_ppc_int*r;
+                }
             }
 #if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
             amrex::ignore_unused(k);
@@ -1891,7 +2136,7 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
                     pu.y = sin_theta*ur + cos_theta*ut;
                 }
 #endif
-                const Real flux = inj_flux->getFlux(ppos.x, ppos.y, ppos.z, t);
+                const Real flux = cached_flux ? flux_max : inj_flux->getFlux(ppos.x, ppos.y, ppos.z, t);
                 // Remove particle if flux is negative or 0
                 if (flux <= 0) {
                     pa_idcpu[ip] = amrex::ParticleIdCpus::Invalid;
@@ -1981,7 +2226,8 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
     // Remove particles that are inside the embedded boundaries
 #ifdef AMREX_USE_EB
     auto & distance_to_eb = WarpX::GetInstance().GetDistanceToEB();
-    scrapeParticlesAtEB(tmp_pc, amrex::GetVecOfConstPtrs(distance_to_eb), ParticleBoundaryProcess::Absorb());
+    scrapeParticlesAtEB(tmp_pc, amrex::GetVecOfConstPtrs(distance_to_eb),
+                        WarpX::GetInstance().GetNearEBBoxes(), ParticleBoundaryProcess::Absorb());
 #endif
 
     // Redistribute the new particles that were added to the temporary container.
@@ -2011,6 +2257,75 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
     }
 }
 
+PhysicalParticleContainer::FluxProfileCache const&
+PhysicalParticleContainer::GetFluxProfileCache (PlasmaInjector const& plasma_injector)
+{
+    const Geometry& geom = Geom(0);
+    const auto problo = geom.ProbLoArray();
+    const auto dx = geom.CellSizeArray();
+
+#if defined(WARPX_DIM_3D)
+    const int normal_dir = plasma_injector.flux_normal_axis;
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    const int normal_dir = (plasma_injector.flux_normal_axis == 1) ? -1 : plasma_injector.flux_normal_axis/2;
+#else
+    const int normal_dir = (plasma_injector.flux_normal_axis == 2) ? 0 : -1;
+#endif
+    // Cells of the injection plane, in the whole domain
+    Box plane_box = geom.Domain();
+    if (normal_dir >= 0) {
+        plane_box.setSmall(normal_dir, 0);
+        plane_box.setBig(normal_dir, 0);
+    }
+
+    auto& cache = m_flux_profile_cache[&plasma_injector];
+    bool same_domain = !cache.flux.empty() && cache.plane_box == plane_box;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        same_domain = same_domain && cache.problo[idim] == problo[idim];
+    }
+    if (same_domain) { return cache; }
+
+    cache.plane_box = plane_box;
+    cache.normal_dir = normal_dir;
+    cache.problo = problo;
+    cache.flux.resize(plane_box.numPts());
+    amrex::Real* const pflux = cache.flux.dataPtr();
+
+    InjectorFlux* inj_flux = plasma_injector.getInjectorFlux();
+    const amrex::Real surface_flux_pos = plasma_injector.surface_flux_pos;
+    // The flux does not depend on time (checked by the PlasmaInjector)
+    const amrex::Real t = WarpX::GetInstance().gett_new(0);
+
+    amrex::ReduceOps<amrex::ReduceOpMax> reduce_op;
+    amrex::ReduceData<amrex::Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+    reduce_op.eval(plane_box, reduce_data,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+        {
+            const IntVect iv(AMREX_D_DECL(i, j, k));
+            amrex::Real c[AMREX_SPACEDIM];
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                c[idim] = (idim == normal_dir) ? surface_flux_pos :
+                    problo[idim] + (iv[idim] + 0.5_rt)*dx[idim];
+            }
+#if defined(WARPX_DIM_3D)
+            const amrex::Real x = c[0], y = c[1], z = c[2];
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+            const amrex::Real x = c[0], y = 0._rt, z = c[1];
+            amrex::ignore_unused(k);
+#else
+            const amrex::Real x = 0._rt, y = 0._rt, z = c[0];
+            amrex::ignore_unused(j, k);
+#endif
+            const amrex::Real flux = amrex::max(inj_flux->getFlux(x, y, z, t), 0._rt);
+            pflux[plane_box.index(iv)] = flux;
+            return {flux};
+        });
+    cache.flux_max = amrex::get<0>(reduce_data.value(reduce_op));
+
+    return cache;
+}
+
 void
 PhysicalParticleContainer::Evolve (int lev,
                                    const MultiFab& Ex, const MultiFab& Ey, const MultiFab& Ez,
@@ -2036,10 +2351,66 @@ PhysicalParticleContainer::Evolve (int lev,
 
     const bool has_buffer = cEx || cjx;
 
-    if (m_do_back_transformed_particles)
+    // Current density to which the pushed particles deposit
+    std::array<MultiFab*, 3> j_push = {&jx, &jy, &jz};
+
+    // With push_interval > 1, the species is only pushed every m_push_interval steps, with
+    // the time step m_push_interval*dt. The current deposited at the push is stored and
+    // added to the current of the simulation at every step, until the next push.
+    bool skip_push = false;
+    const bool use_subcycled_current = (m_push_interval > 1) && !skip_deposition && !do_not_deposit;
+    if (m_push_interval > 1)
     {
-        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
-        {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            push_type == PushType::Explicit && a_dt_type == DtType::Full && !has_buffer &&
+            !WarpX::do_multi_J && finestLevel() == 0 && !WarpX::do_moving_window,
+            species_name + ".push_interval > 1 requires an explicit solver without mesh refinement,"
+            " without warpx.do_multi_J and without moving window");
+
+        const bool is_push_step = (WarpX::GetInstance().getistep(lev) % m_push_interval == 0);
+        skip_push = !is_push_step;
+        dt *= static_cast<Real>(m_push_interval);
+
+        if (use_subcycled_current)
+        {
+            if (m_subcycled_current.size() <= static_cast<std::size_t>(lev)) {
+                m_subcycled_current.resize(lev+1);
+            }
+            auto& j_sub = m_subcycled_current[lev];
+            const std::array<const MultiFab*, 3> j_fields = {&jx, &jy, &jz};
+            for (int idir = 0; idir < 3; ++idir) {
+                const MultiFab& j = *j_fields[idir];
+                if (!j_sub[idir] ||
+                    j_sub[idir]->boxArray() != j.boxArray() ||
+                    j_sub[idir]->DistributionMap() != j.DistributionMap() ||
+                    j_sub[idir]->nGrowVect() != j.nGrowVect())
+                {
+                    // The stored current cannot be transferred to a new layout
+                    // (e.g. after load balancing) in the middle of the subcycle
+                    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(is_push_step,
+                        "The grids changed between two pushes of species " + species_name +
+                        ": the step must be a multiple of " + species_name + ".push_interval");
+                    j_sub[idir] = std::make_unique<MultiFab>(
+                        j.boxArray(), j.DistributionMap(), j.nComp(), j.nGrowVect());
+                }
+                if (is_push_step) { j_sub[idir]->setVal(0._rt); }
+                j_push[idir] = j_sub[idir].get();
+            }
+        }
+    }
+
+    // Whether the gather, push and current deposition are done in one kernel
+    const bool fuse_push_deposit = (push_type == PushType::Explicit) && (a_dt_type == DtType::Full)
+        && !has_buffer && !skip_deposition && !skip_push && canFusePushAndDeposit();
+    // Whether the charge density after the push is also deposited in that kernel
+    const bool fuse_rho_deposit = fuse_push_deposit && rho && !do_not_deposit &&
+        WarpX::electrostatic_solver_id == ElectrostaticSolverAlgo::None &&
+        rho->nComp() >= 2 && canFuseChargeDeposition();
+
+    if (m_do_back_transformed_particles)
+    {
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
             const auto np = pti.numParticles();
             const auto t_lev = pti.GetLevel();
             const auto index = pti.GetPairIndex();
@@ -2060,9 +2431,6 @@ PhysicalParticleContainer::Evolve (int lev,
         const int thread_num = 0;
 #endif
 
-        FArrayBox filtered_Ex, filtered_Ey, filtered_Ez;
-        FArrayBox filtered_Bx, filtered_By, filtered_Bz;
-
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
@@ -2071,7 +2439,13 @@ PhysicalParticleContainer::Evolve (int lev,
             }
             auto wt = static_cast<amrex::Real>(amrex::second());
 
-            const Box& box = pti.validbox();
+#ifdef AMREX_USE_GPU
+            if (m_concurrent_evolve) {
+                // Spread the tiles of the species evolved concurrently over the streams
+                amrex::Gpu::Device::setStreamIndex(
+                    (pti.LocalIndex() + m_evolve_stream_offset) % amrex::Gpu::numGpuStreams());
+            }
+#endif
 
             // Extract particle data
             auto& attribs = pti.GetAttribs();
@@ -2082,7 +2456,8 @@ PhysicalParticleContainer::Evolve (int lev,
 
             const long np = pti.numParticles();
 
-            // Data on the grid
+            // Data on the grid (with the NCI corrector, the fields filtered once per
+            // step by WarpX::ApplyNCIFilterToGatherFields)
             FArrayBox const* exfab = &Ex[pti];
             FArrayBox const* eyfab = &Ey[pti];
             FArrayBox const* ezfab = &Ez[pti];
@@ -2090,21 +2465,6 @@ PhysicalParticleContainer::Evolve (int lev,
             FArrayBox const* byfab = &By[pti];
             FArrayBox const* bzfab = &Bz[pti];
 
-            Elixir exeli, eyeli, ezeli, bxeli, byeli, bzeli;
-
-            if (WarpX::use_fdtd_nci_corr)
-            {
-                // Filter arrays Ex[pti], store the result in
-                // filtered_Ex and update pointer exfab so that it
-                // points to filtered_Ex (and do the same for all
-                // components of E and B).
-                applyNCIFilter(lev, pti.tilebox(), exeli, eyeli, ezeli, bxeli, byeli, bzeli,
-                               filtered_Ex, filtered_Ey, filtered_Ez,
-                               filtered_Bx, filtered_By, filtered_Bz,
-                               Ex[pti], Ey[pti], Ez[pti], Bx[pti], By[pti], Bz[pti],
-                               exfab, eyfab, ezfab, bxfab, byfab, bzfab);
-            }
-
             // Determine which particles deposit/gather in the buffer, and
             // which particles deposit/gather in the fine patch
             long nfine_current = np;
@@ -2138,7 +2498,64 @@ PhysicalParticleContainer::Evolve (int lev,
                 }
             }
 
-            if (! do_not_push)
+#ifdef AMREX_USE_OMP
+            // Split the tiles with many particles in chunks that are pushed and deposited in
+            // OpenMP tasks: the threads that are done with their own tiles (or that wait for
+            // the tasks of their tile) execute them, with their own current buffers
+            const long chunk_size = WarpXParticleContainer::omp_task_chunk_size;
+            const bool split_tile = chunk_size > 0 && np > 2*chunk_size && !has_buffer &&
+                !fuse_push_deposit && push_type == PushType::Explicit &&
+                !do_not_push && !skip_push && omp_get_num_threads() > 1;
+#else
+            const bool split_tile = false;
+#endif
+
+            if (split_tile)
+            {
+#ifdef AMREX_USE_OMP
+                WARPX_PROFILE_VAR_START(blp_fg);
+                const int e_is_nodal = Ex.is_nodal() and Ey.is_nodal() and Ez.is_nodal();
+                const int* const AMREX_RESTRICT ion_lev = (do_field_ionization)?
+                    pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr():nullptr;
+                // Deposit at t_{n+1/2}
+                const amrex::Real relative_time = -0.5_rt * dt;
+                for (long chunk_begin = 0; chunk_begin < np; chunk_begin += chunk_size)
+                {
+                    const long n_chunk = std::min(chunk_size, np - chunk_begin);
+#pragma omp task default(shared) firstprivate(chunk_begin, n_chunk)
+                    {
+                        const int task_thread_num = omp_get_thread_num();
+                        PushPX(pti, exfab, eyfab, ezfab,
+                               bxfab, byfab, bzfab,
+                               Ex.nGrowVect(), e_is_nodal,
+                               chunk_begin, n_chunk, lev, lev, dt, ScaleFields(false), a_dt_type);
+                        if (!skip_deposition)
+                        {
+                            // Unlike the particle attributes, ion_lev is not offset in DepositCurrent
+                            const int* const chunk_ion_lev = ion_lev ? ion_lev + chunk_begin : nullptr;
+                            DepositCurrent(pti, wp, uxp, uyp, uzp, chunk_ion_lev,
+                                           j_push[0], j_push[1], j_push[2],
+                                           chunk_begin, n_chunk, task_thread_num,
+                                           lev, lev, dt, relative_time, push_type);
+                        }
+                    }
+                }
+                // The tasks use the particles of the tile
+#pragma omp taskwait
+                WARPX_PROFILE_VAR_STOP(blp_fg);
+#endif
+            }
+            else if (fuse_push_deposit)
+            {
+                WARPX_PROFILE_VAR_START(blp_fg);
+                PushPXDepositCurrent(pti, exfab, eyfab, ezfab,
+                                     bxfab, byfab, bzfab,
+                                     Ex.nGrowVect(), np, lev, dt,
+                                     j_push[0], j_push[1], j_push[2], thread_num,
+                                     fuse_rho_deposit ? rho : nullptr);
+                WARPX_PROFILE_VAR_STOP(blp_fg);
+            }
+            else if (! do_not_push && ! skip_push)
             {
                 const long np_gather = (cEx) ? nfine_gather : np;
 
@@ -2164,9 +2581,6 @@ PhysicalParticleContainer::Evolve (int lev,
 
                 if (np_gather < np)
                 {
-                    const IntVect& ref_ratio = WarpX::RefRatio(lev-1);
-                    const Box& cbox = amrex::coarsen(box,ref_ratio);
-
                     // Data on the grid
                     FArrayBox const* cexfab = &(*cEx)[pti];
                     FArrayBox const* ceyfab = &(*cEy)[pti];
@@ -2175,20 +2589,6 @@ PhysicalParticleContainer::Evolve (int lev,
                     FArrayBox const* cbyfab = &(*cBy)[pti];
                     FArrayBox const* cbzfab = &(*cBz)[pti];
 
-                    if (WarpX::use_fdtd_nci_corr)
-                    {
-                        // Filter arrays (*cEx)[pti], store the result in
-                        // filtered_Ex and update pointer cexfab so that it
-                        // points to filtered_Ex (and do the same for all
-                        // components of E and B)
-                        applyNCIFilter(lev-1, cbox, exeli, eyeli, ezeli, bxeli, byeli, bzeli,
-                                       filtered_Ex, filtered_Ey, filtered_Ez,
-                                       filtered_Bx, filtered_By, filtered_Bz,
-                                       (*cEx)[pti], (*cEy)[pti], (*cEz)[pti],
-                                       (*cBx)[pti], (*cBy)[pti], (*cBz)[pti],
-                                       cexfab, ceyfab, cezfab, cbxfab, cbyfab, cbzfab);
-                    }
-
                     // Field gather and push for particles in gather buffers
                     e_is_nodal = cEx->is_nodal() and cEy->is_nodal() and cEz->is_nodal();
                     if (push_type == PushType::Explicit) {
@@ -2218,7 +2618,7 @@ PhysicalParticleContainer::Evolve (int lev,
                         pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr():nullptr;
 
                     // Deposit inside domains
-                    DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev, &jx, &jy, &jz,
+                    DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev, j_push[0], j_push[1], j_push[2],
                                    0, np_current, thread_num,
                                    lev, lev, dt, relative_time, push_type);
 
@@ -2232,7 +2632,7 @@ PhysicalParticleContainer::Evolve (int lev,
                 } // end of "if electrostatic_solver_id == ElectrostaticSolverAlgo::None"
             } // end of "if do_not_push"
 
-            if (rho && ! skip_deposition && ! do_not_deposit) {
+            if (rho && ! skip_deposition && ! do_not_deposit && ! fuse_rho_deposit) {
                 // Deposit charge after particle push, in component 1 of MultiFab rho.
                 // (Skipped for electrostatic solver, as this may lead to out-of-bounds)
                 if (WarpX::electrostatic_solver_id == ElectrostaticSolverAlgo::None) {
@@ -2251,7 +2651,10 @@ PhysicalParticleContainer::Evolve (int lev,
                 }
             }
 
-            amrex::Gpu::synchronize();
+            // The species evolved concurrently only synchronize at the end of all of them
+            if (!m_concurrent_evolve) {
+                amrex::Gpu::synchronize();
+            }
 
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
             {
@@ -2260,293 +2663,77 @@ PhysicalParticleContainer::Evolve (int lev,
             }
         }
     }
+
+    if (use_subcycled_current)
+    {
+        // Add the current of the last push (including the guard cells,
+        // which are summed later together with the other species)
+        MultiFab::Add(jx, *j_push[0], 0, 0, jx.nComp(), jx.nGrowVect());
+        MultiFab::Add(jy, *j_push[1], 0, 0, jy.nComp(), jy.nGrowVect());
+        MultiFab::Add(jz, *j_push[2], 0, 0, jz.nComp(), jz.nGrowVect());
+    }
+
     // Split particles at the end of the timestep.
     // When subcycling is ON, the splitting is done on the last call to
     // PhysicalParticleContainer::Evolve on the finest level, i.e., at the
     // end of the large timestep. Otherwise, the pushes on different levels
-    // are not consistent, and the call to Redistribute (inside
-    // SplitParticles) may result in split particles to deposit twice on the
-    // coarse level.
+    // are not consistent, and the split particles, which are only moved to
+    // their level by the Redistribute at the end of the step, may deposit
+    // twice on the coarse level.
     if (do_splitting && (a_dt_type == DtType::SecondHalf || a_dt_type == DtType::Full) ){
         SplitParticles(lev);
     }
 }
 
-void
-PhysicalParticleContainer::applyNCIFilter (
-    int lev, const Box& box,
-    Elixir& exeli, Elixir& eyeli, Elixir& ezeli,
-    Elixir& bxeli, Elixir& byeli, Elixir& bzeli,
-    FArrayBox& filtered_Ex, FArrayBox& filtered_Ey, FArrayBox& filtered_Ez,
-    FArrayBox& filtered_Bx, FArrayBox& filtered_By, FArrayBox& filtered_Bz,
-    const FArrayBox& Ex, const FArrayBox& Ey, const FArrayBox& Ez,
-    const FArrayBox& Bx, const FArrayBox& By, const FArrayBox& Bz,
-    FArrayBox const * & ex_ptr, FArrayBox const * & ey_ptr,
-    FArrayBox const * & ez_ptr, FArrayBox const * & bx_ptr,
-    FArrayBox const * & by_ptr, FArrayBox const * & bz_ptr)
-{
-
-    // Get instances of NCI Godfrey filters
-    const auto& nci_godfrey_filter_exeybz = WarpX::GetInstance().nci_godfrey_filter_exeybz;
-    const auto& nci_godfrey_filter_bxbyez = WarpX::GetInstance().nci_godfrey_filter_bxbyez;
-
-#if defined(WARPX_DIM_1D_Z)
-    const Box& tbox = amrex::grow(box, static_cast<int>(WarpX::noz));
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-    const Box& tbox = amrex::grow(box, {static_cast<int>(WarpX::nox),
-                static_cast<int>(WarpX::noz)});
-#else
-    const Box& tbox = amrex::grow(box, {static_cast<int>(WarpX::nox),
-                static_cast<int>(WarpX::noy),
-                static_cast<int>(WarpX::noz)});
-#endif
-
-    // Filter Ex (Both 2D and 3D)
-    filtered_Ex.resize(amrex::convert(tbox,Ex.box().ixType()));
-    // Safeguard for GPU
-    exeli = filtered_Ex.elixir();
-    // Apply filter on Ex, result stored in filtered_Ex
-
-    nci_godfrey_filter_exeybz[lev]->ApplyStencil(filtered_Ex, Ex, filtered_Ex.box());
-    // Update ex_ptr reference
-    ex_ptr = &filtered_Ex;
-
-    // Filter Ez
-    filtered_Ez.resize(amrex::convert(tbox,Ez.box().ixType()));
-    ezeli = filtered_Ez.elixir();
-    nci_godfrey_filter_bxbyez[lev]->ApplyStencil(filtered_Ez, Ez, filtered_Ez.box());
-    ez_ptr = &filtered_Ez;
-
-    // Filter By
-    filtered_By.resize(amrex::convert(tbox,By.box().ixType()));
-    byeli = filtered_By.elixir();
-    nci_godfrey_filter_bxbyez[lev]->ApplyStencil(filtered_By, By, filtered_By.box());
-    by_ptr = &filtered_By;
-#if defined(WARPX_DIM_3D)
-    // Filter Ey
-    filtered_Ey.resize(amrex::convert(tbox,Ey.box().ixType()));
-    eyeli = filtered_Ey.elixir();
-    nci_godfrey_filter_exeybz[lev]->ApplyStencil(filtered_Ey, Ey, filtered_Ey.box());
-    ey_ptr = &filtered_Ey;
-
-    // Filter Bx
-    filtered_Bx.resize(amrex::convert(tbox,Bx.box().ixType()));
-    bxeli = filtered_Bx.elixir();
-    nci_godfrey_filter_bxbyez[lev]->ApplyStencil(filtered_Bx, Bx, filtered_Bx.box());
-    bx_ptr = &filtered_Bx;
-
-    // Filter Bz
-    filtered_Bz.resize(amrex::convert(tbox,Bz.box().ixType()));
-    bzeli = filtered_Bz.elixir();
-    nci_godfrey_filter_exeybz[lev]->ApplyStencil(filtered_Bz, Bz, filtered_Bz.box());
-    bz_ptr = &filtered_Bz;
-#else
-    amrex::ignore_unused(eyeli, bxeli, bzeli,
-        filtered_Ey, filtered_Bx, filtered_Bz,
-        Ey, Bx, Bz, ey_ptr, bx_ptr, bz_ptr);
-#endif
-}
-
 // Loop over all particles in the particle container and
 // split particles tagged with p.id()=DoSplitParticleID
 void
 PhysicalParticleContainer::SplitParticles (int lev)
 {
-    auto& mypc = WarpX::GetInstance().GetPartContainer();
-    auto& pctmp_split = mypc.GetPCtmp();
-    RealVector psplit_x, psplit_y, psplit_z, psplit_w;
-    RealVector psplit_ux, psplit_uy, psplit_uz;
-    long np_split_to_add = 0;
-    long np_split;
-    if(split_type==0)
-    {
-        #if defined(WARPX_DIM_3D)
-           np_split = 8;
-        #elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-           np_split = 4;
-        #else
-           np_split = 2;
-        #endif
-    } else {
-        np_split = 2*AMREX_SPACEDIM;
+    WARPX_PROFILE("PhysicalParticleContainer::SplitParticles()");
+
+    const amrex::Vector<int> ppc_nd = plasma_injectors[0]->num_particles_per_cell_each_dim;
+    const std::array<Real,3>& dx = WarpX::CellSize(lev);
+    amrex::GpuArray<ParticleReal,3> split_offset = {static_cast<ParticleReal>(dx[0]/2._rt),
+                                                    static_cast<ParticleReal>(dx[1]/2._rt),
+                                                    static_cast<ParticleReal>(dx[2]/2._rt)};
+    if (ppc_nd[0] > 0){
+        // offset for split particles is computed as a function of cell size
+        // and number of particles per cell, so that a uniform distribution
+        // before splitting results in a uniform distribution after splitting
+        split_offset[0] /= ppc_nd[0];
+        split_offset[1] /= ppc_nd[1];
+        split_offset[2] /= ppc_nd[2];
     }
 
-    // Loop over particle interator
+    // The split particles are copies of the tagged particle, appended to the
+    // same tile, with shifted positions and a fraction of the weight
+    const SmartCopyFactory copy_factory(*this, *this);
+    const auto Copy = copy_factory.getSmartCopy();
+    const auto Filter = SplitParticleFilterFunc{};
+    const auto Transform = SplitParticleTransformFunc{split_type, split_offset,
+                                                      ParallelDescriptor::MyProc()};
+
+    // Number of split particles created for each tagged particle:
+    // split_type==0 splits along the diagonals, otherwise along each axis
+    constexpr int np_split_diagonals = 1 << AMREX_SPACEDIM;
+    constexpr int np_split_axes = 2*AMREX_SPACEDIM;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
     for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
     {
-        const auto GetPosition = GetParticlePosition<PIdx>(pti);
-
-        const amrex::Vector<int> ppc_nd = plasma_injectors[0]->num_particles_per_cell_each_dim;
-        const std::array<Real,3>& dx = WarpX::CellSize(lev);
-        amrex::Vector<Real> split_offset = {dx[0]/2._rt,
-                                            dx[1]/2._rt,
-                                            dx[2]/2._rt};
-        if (ppc_nd[0] > 0){
-            // offset for split particles is computed as a function of cell size
-            // and number of particles per cell, so that a uniform distribution
-            // before splitting results in a uniform distribution after splitting
-            split_offset[0] /= ppc_nd[0];
-            split_offset[1] /= ppc_nd[1];
-            split_offset[2] /= ppc_nd[2];
-        }
-        // particle Struct Of Arrays data
-        auto& attribs = pti.GetAttribs();
-        auto& wp  = attribs[PIdx::w ];
-        auto& uxp = attribs[PIdx::ux];
-        auto& uyp = attribs[PIdx::uy];
-        auto& uzp = attribs[PIdx::uz];
-
-        ParticleTileType& ptile = ParticlesAt(lev, pti);
-        auto& soa = ptile.GetStructOfArrays();
-        uint64_t * const AMREX_RESTRICT idcpu = soa.GetIdCPUData().data();
-
-        const long np = pti.numParticles();
-        for(int i=0; i<np; i++){
-            ParticleReal xp, yp, zp;
-            GetPosition(i, xp, yp, zp);
-            if (idcpu[i] == LongParticleIds::DoSplitParticleID){
-                // If particle is tagged, split it and put the
-                // split particles in local arrays psplit_x etc.
-                np_split_to_add += np_split;
-#if defined(WARPX_DIM_1D_Z)
-                // Split particle in two along z axis
-                // 2 particles in 1d, split_type doesn't matter? Discuss with Remi
-                for (int ishift = -1; ishift < 2; ishift +=2 ){
-                    // Add one particle with offset in z
-                    psplit_x.push_back( xp );
-                    psplit_y.push_back( yp );
-                    psplit_z.push_back( zp + ishift*split_offset[2] );
-                    psplit_ux.push_back( uxp[i] );
-                    psplit_uy.push_back( uyp[i] );
-                    psplit_uz.push_back( uzp[i] );
-                    psplit_w.push_back( wp[i]/np_split );
-                }
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-                if (split_type==0){
-                    // Split particle in two along each diagonals
-                    // 4 particles in 2d
-                    for (int ishift = -1; ishift < 2; ishift +=2 ){
-                        for (int kshift = -1; kshift < 2; kshift +=2 ){
-                            // Add one particle with offset in x and z
-                            psplit_x.push_back( xp + ishift*split_offset[0] );
-                            psplit_y.push_back( yp );
-                            psplit_z.push_back( zp + kshift*split_offset[2] );
-                            psplit_ux.push_back( uxp[i] );
-                            psplit_uy.push_back( uyp[i] );
-                            psplit_uz.push_back( uzp[i] );
-                            psplit_w.push_back( wp[i]/np_split );
-                        }
-                    }
-                } else {
-                    // Split particle in two along each axis
-                    // 4 particles in 2d
-                    for (int ishift = -1; ishift < 2; ishift +=2 ){
-                        // Add one particle with offset in x
-                        psplit_x.push_back( xp + ishift*split_offset[0] );
-                        psplit_y.push_back( yp );
-                        psplit_z.push_back( zp );
-                        psplit_ux.push_back( uxp[i] );
-                        psplit_uy.push_back( uyp[i] );
-                        psplit_uz.push_back( uzp[i] );
-                        psplit_w.push_back( wp[i]/np_split );
-                        // Add one particle with offset in z
-                        psplit_x.push_back( xp );
-                        psplit_y.push_back( yp );
-                        psplit_z.push_back( zp + ishift*split_offset[2] );
-                        psplit_ux.push_back( uxp[i] );
-                        psplit_uy.push_back( uyp[i] );
-                        psplit_uz.push_back( uzp[i] );
-                        psplit_w.push_back( wp[i]/np_split );
-                    }
-                }
-#elif defined(WARPX_DIM_3D)
-                if (split_type==0){
-                    // Split particle in two along each diagonals
-                    // 8 particles in 3d
-                    for (int ishift = -1; ishift < 2; ishift +=2 ){
-                        for (int jshift = -1; jshift < 2; jshift +=2 ){
-                            for (int kshift = -1; kshift < 2; kshift +=2 ){
-                                // Add one particle with offset in x, y and z
-                                psplit_x.push_back( xp + ishift*split_offset[0] );
-                                psplit_y.push_back( yp + jshift*split_offset[1] );
-                                psplit_z.push_back( zp + kshift*split_offset[2] );
-                                psplit_ux.push_back( uxp[i] );
-                                psplit_uy.push_back( uyp[i] );
-                                psplit_uz.push_back( uzp[i] );
-                                psplit_w.push_back( wp[i]/np_split );
-                            }
-                        }
-                    }
-                } else {
-                    // Split particle in two along each axis
-                    // 6 particles in 3d
-                    for (int ishift = -1; ishift < 2; ishift +=2 ){
-                        // Add one particle with offset in x
-                        psplit_x.push_back( xp + ishift*split_offset[0] );
-                        psplit_y.push_back( yp );
-                        psplit_z.push_back( zp );
-                        psplit_ux.push_back( uxp[i] );
-                        psplit_uy.push_back( uyp[i] );
-                        psplit_uz.push_back( uzp[i] );
-                        psplit_w.push_back( wp[i]/np_split );
-                        // Add one particle with offset in y
-                        psplit_x.push_back( xp );
-                        psplit_y.push_back( yp + ishift*split_offset[1] );
-                        psplit_z.push_back( zp );
-                        psplit_ux.push_back( uxp[i] );
-                        psplit_uy.push_back( uyp[i] );
-                        psplit_uz.push_back( uzp[i] );
-                        psplit_w.push_back( wp[i]/np_split );
-                        // Add one particle with offset in z
-                        psplit_x.push_back( xp );
-                        psplit_y.push_back( yp );
-                        psplit_z.push_back( zp + ishift*split_offset[2] );
-                        psplit_ux.push_back( uxp[i] );
-                        psplit_uy.push_back( uyp[i] );
-                        psplit_uz.push_back( uzp[i] );
-                        psplit_w.push_back( wp[i]/np_split );
-                    }
-                }
-#endif
-                // invalidate the particle
-                idcpu[i] = amrex::ParticleIdCpus::Invalid;
-            }
+        auto& ptile = ParticlesAt(lev, pti);
+        const auto np = ptile.numParticles();
+        if (split_type == 0) {
+            filterCopyTransformParticles<np_split_diagonals>(*this, ptile, ptile, np,
+                                                             Filter, Copy, Transform);
+        } else {
+            filterCopyTransformParticles<np_split_axes>(*this, ptile, ptile, np,
+                                                        Filter, Copy, Transform);
         }
     }
-    // Add local arrays psplit_x etc. to the temporary
-    // particle container pctmp_split. Split particles
-    // are tagged with p.id()=NoSplitParticleID so that
-    // they are not re-split when entering a higher level
-    // AddNParticles calls Redistribute, so that particles
-    // in pctmp_split are in the proper grids and tiles
-    const amrex::Vector<ParticleReal> xp(psplit_x.data(), psplit_x.data() + np_split_to_add);
-    const amrex::Vector<ParticleReal> yp(psplit_y.data(), psplit_y.data() + np_split_to_add);
-    const amrex::Vector<ParticleReal> zp(psplit_z.data(), psplit_z.data() + np_split_to_add);
-    const amrex::Vector<ParticleReal> uxp(psplit_ux.data(), psplit_ux.data() + np_split_to_add);
-    const amrex::Vector<ParticleReal> uyp(psplit_uy.data(), psplit_uy.data() + np_split_to_add);
-    const amrex::Vector<ParticleReal> uzp(psplit_uz.data(), psplit_uz.data() + np_split_to_add);
-    const amrex::Vector<ParticleReal> wp(psplit_w.data(), psplit_w.data() + np_split_to_add);
-
-    amrex::Vector<amrex::Vector<ParticleReal>> attr;
-    attr.push_back(wp);
-    const amrex::Vector<amrex::Vector<int>> attr_int;
-    pctmp_split.AddNParticles(lev,
-                              np_split_to_add,
-                              xp,
-                              yp,
-                              zp,
-                              uxp,
-                              uyp,
-                              uzp,
-                              1,
-                              attr,
-                              0, attr_int,
-                              1, LongParticleIds::NoSplitParticleID);
-    // Copy particles from tmp to current particle container
-    constexpr bool local_flag = true;
-    addParticles(pctmp_split,local_flag);
-    // Clear tmp container
-    pctmp_split.clearParticles();
 }
 
 void
@@ -2558,6 +2745,9 @@ PhysicalParticleContainer::PushP (int lev, Real dt,
 
     if (do_not_push) { return; }
 
+    // Species pushed every m_push_interval steps are staggered by half their own time step
+    dt *= static_cast<Real>(m_push_interval);
+
     const std::array<amrex::Real,3>& dx = WarpX::CellSize(std::max(lev,0));
 
 #ifdef AMREX_USE_OMP
@@ -2849,13 +3039,20 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
     const auto pusher_algo = WarpX::particle_pusher_algo;
     const auto do_crr = do_classical_radiation_reaction;
 #ifdef WARPX_QED
-    const auto do_sync = m_do_qed_quantum_sync;
+    // If chi is below chi_min for all the particles of the tile, the optical depth is
+    // not evolved, and the push is the same as without quantum synchrotron emission
+    const bool is_chi_below_min = m_do_qed_quantum_sync &&
+        isChiBelowMinimumInTile(pti, offset, np_to_push,
+                                exfab, eyfab, ezfab, bxfab, byfab, bzfab, box,
+                                m_shr_p_qs_engine->get_minimum_chi_part());
+
+    const auto do_sync = m_do_qed_quantum_sync && !is_chi_below_min;
     amrex::Real t_chi_max = 0.0;
     if (do_sync) { t_chi_max = m_shr_p_qs_engine->get_minimum_chi_part(); }
 
     QuantumSynchrotronEvolveOpticalDepth evolve_opt;
     amrex::ParticleReal* AMREX_RESTRICT p_optical_depth_QSR = nullptr;
-    const bool local_has_quantum_sync = has_quantum_sync();
+    const bool local_has_quantum_sync = has_quantum_sync() && !is_chi_below_min;
     if (local_has_quantum_sync) {
         evolve_opt = m_shr_p_qs_engine->build_evolve_functor();
         p_optical_depth_QSR = pti.GetAttribs(particle_comps["opticalDepthQSR"]).dataPtr()  + offset;
@@ -2864,6 +3061,121 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
 
     const auto t_do_not_gather = do_not_gather;
 
+    // Optionally gather the fields of all particles of the tile in a separate kernel,
+    // either the gradient of phi (the E and B fields on the grid are then not used),
+    // or with the field patch of each bin staged in shared memory
+    amrex::Gpu::DeviceVector<amrex::ParticleReal> gathered_fields;
+    const amrex::ParticleReal* AMREX_RESTRICT gathered_EB = nullptr;
+    if (WarpX::gather_E_from_phi && !do_not_gather)
+    {
+        WARPX_PROFILE("PhysicalParticleContainer::PushPX::GatherEFromPhi");
+        gathered_fields.resize(6*np_to_push, 0._prt);
+        amrex::ParticleReal* const Exg = gathered_fields.dataPtr();
+        amrex::ParticleReal* const Eyg = Exg + np_to_push;
+        amrex::ParticleReal* const Ezg = Eyg + np_to_push;
+        gathered_EB = Exg;
+
+        amrex::Array4<const amrex::Real> const& phi_arr = WarpX::GetInstance().getFieldPointer(
+            warpx::fields::FieldType::phi_fp, gather_lev)->const_array(pti);
+
+        amrex::ParallelFor(np_to_push, [=] AMREX_GPU_DEVICE (long ip)
+        {
+            amrex::ParticleReal xp, yp, zp;
+            getPosition(ip, xp, yp, zp);
+            doGatherEFromPhiShapeN(xp, yp, zp, Exg[ip], Eyg[ip], Ezg[ip],
+                                   phi_arr, dx_arr, xyzmin_arr, lo, nox);
+        });
+    }
+    else if (WarpX::do_shared_mem_field_gather && !do_not_gather &&
+        offset == 0 && np_to_push == pti.numParticles())
+    {
+        WARPX_PROFILE("PhysicalParticleContainer::PushPX::SharedGather");
+        gathered_fields.resize(6*np_to_push, 0._prt);
+        amrex::ParticleReal* const Exg = gathered_fields.dataPtr();
+        amrex::ParticleReal* const Eyg = Exg + np_to_push;
+        amrex::ParticleReal* const Ezg = Eyg + np_to_push;
+        amrex::ParticleReal* const Bxg = Ezg + np_to_push;
+        amrex::ParticleReal* const Byg = Bxg + np_to_push;
+        amrex::ParticleReal* const Bzg = Byg + np_to_push;
+        gathered_EB = Exg;
+
+        const Geometry& geom = Geom(gather_lev);
+        const auto dxi = geom.InvCellSizeArray();
+        const auto plo = geom.ProbLoArray();
+        const auto domain = geom.Domain();
+        const amrex::IntVect bin_size = WarpX::shared_tilesize;
+
+        // sort particles by bin
+        amrex::DenseBins<ParticleTileType::ParticleTileDataType> bins;
+        {
+            auto& ptile = ParticlesAt(lev, pti);
+            auto ptd = ptile.getParticleTileData();
+
+            const int ntiles = numTilesInBox(box, true, bin_size);
+
+            bins.build(ptile.numParticles(), ptd, ntiles,
+                    [=] AMREX_GPU_HOST_DEVICE (const ParticleType& p) -> unsigned int
+                    {
+                        Box tbox;
+                        auto iv = getParticleCell(p, plo, dxi, domain);
+                        AMREX_ASSERT(box.contains(iv));
+                        auto tid = getTileIndex(iv, box, true, bin_size, tbox);
+                        return static_cast<unsigned int>(tid);
+                    });
+        }
+
+        // get the maximum size necessary for shared mem
+#if AMREX_SPACEDIM > 0
+        const int sizeX = getMaxTboxAlongDim(box.size()[0], WarpX::shared_tilesize[0]);
+#endif
+#if AMREX_SPACEDIM > 1
+        const int sizeZ = getMaxTboxAlongDim(box.size()[1], WarpX::shared_tilesize[1]);
+#endif
+#if AMREX_SPACEDIM > 2
+        const int sizeY = getMaxTboxAlongDim(box.size()[2], WarpX::shared_tilesize[2]);
+#endif
+        const amrex::IntVect max_tbox_size( AMREX_D_DECL(sizeX,sizeZ,sizeY) );
+        const int tpb = WarpX::shared_mem_gather_tpb;
+
+        if (galerkin_interpolation) {
+            if        (nox == 1) {
+                doGatherSharedShapeN<1,1>(getPosition, Exg, Eyg, Ezg, Bxg, Byg, Bzg,
+                    exfab, eyfab, ezfab, bxfab, byfab, bzfab, bins, box, geom,
+                    max_tbox_size, bin_size, tpb, dx, xyzmin, lo, n_rz_azimuthal_modes);
+            } else if (nox == 2) {
+                doGatherSharedShapeN<2,1>(getPosition, Exg, Eyg, Ezg, Bxg, Byg, Bzg,
+                    exfab, eyfab, ezfab, bxfab, byfab, bzfab, bins, box, geom,
+                    max_tbox_size, bin_size, tpb, dx, xyzmin, lo, n_rz_azimuthal_modes);
+            } else if (nox == 3) {
+                doGatherSharedShapeN<3,1>(getPosition, Exg, Eyg, Ezg, Bxg, Byg, Bzg,
+                    exfab, eyfab, ezfab, bxfab, byfab, bzfab, bins, box, geom,
+                    max_tbox_size, bin_size, tpb, dx, xyzmin, lo, n_rz_azimuthal_modes);
+            } else if (nox == 4) {
+                doGatherSharedShapeN<4,1>(getPosition, Exg, Eyg, Ezg, Bxg, Byg, Bzg,
+                    exfab, eyfab, ezfab, bxfab, byfab, bzfab, bins, box, geom,
+                    max_tbox_size, bin_size, tpb, dx, xyzmin, lo, n_rz_azimuthal_modes);
+            }
+        } else {
+            if        (nox == 1) {
+                doGatherSharedShapeN<1,0>(getPosition, Exg, Eyg, Ezg, Bxg, Byg, Bzg,
+                    exfab, eyfab, ezfab, bxfab, byfab, bzfab, bins, box, geom,
+                    max_tbox_size, bin_size, tpb, dx, xyzmin, lo, n_rz_azimuthal_modes);
+            } else if (nox == 2) {
+                doGatherSharedShapeN<2,0>(getPosition, Exg, Eyg, Ezg, Bxg, Byg, Bzg,
+                    exfab, eyfab, ezfab, bxfab, byfab, bzfab, bins, box, geom,
+                    max_tbox_size, bin_size, tpb, dx, xyzmin, lo, n_rz_azimuthal_modes);
+            } else if (nox == 3) {
+                doGatherSharedShapeN<3,0>(getPosition, Exg, Eyg, Ezg, Bxg, Byg, Bzg,
+                    exfab, eyfab, ezfab, bxfab, byfab, bzfab, bins, box, geom,
+                    max_tbox_size, bin_size, tpb, dx, xyzmin, lo, n_rz_azimuthal_modes);
+            } else if (nox == 4) {
+                doGatherSharedShapeN<4,0>(getPosition, Exg, Eyg, Ezg, Bxg, Byg, Bzg,
+                    exfab, eyfab, ezfab, bxfab, byfab, bzfab, bins, box, geom,
+                    max_tbox_size, bin_size, tpb, dx, xyzmin, lo, n_rz_azimuthal_modes);
+            }
+        }
+    }
+
     enum exteb_flags : int { no_exteb, has_exteb };
     enum qed_flags : int { no_qed, has_qed };
 
@@ -2874,14 +3186,148 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
     int qed_runtime_flag = no_qed;
 #endif
 
+#ifndef AMREX_USE_GPU
+    // On CPU, do the field gather and the push in two separate loops. The pusher is
+    // selected at compile time in the second loop, which has no runtime branch and
+    // only accesses contiguous particle arrays, so that the compiler can vectorize it.
+    if (WarpX::do_vectorized_push && qed_runtime_flag == no_qed) {
+        amrex::Gpu::DeviceVector<amrex::ParticleReal> fields_on_particles(6*np_to_push);
+        amrex::ParticleReal* const AMREX_RESTRICT Exv = fields_on_particles.dataPtr();
+        amrex::ParticleReal* const AMREX_RESTRICT Eyv = Exv + np_to_push;
+        amrex::ParticleReal* const AMREX_RESTRICT Ezv = Eyv + np_to_push;
+        amrex::ParticleReal* const AMREX_RESTRICT Bxv = Ezv + np_to_push;
+        amrex::ParticleReal* const AMREX_RESTRICT Byv = Bxv + np_to_push;
+        amrex::ParticleReal* const AMREX_RESTRICT Bzv = Byv + np_to_push;
+
+        amrex::ParallelFor(
+            TypeList<CompileTimeOptions<no_exteb,has_exteb>>{},
+            {exteb_runtime_flag},
+            np_to_push,
+            [=] AMREX_GPU_DEVICE (long ip, auto exteb_control)
+        {
+            amrex::ParticleReal xp, yp, zp;
+            getPosition(ip, xp, yp, zp);
+
+            if (save_previous_position) {
+#if (AMREX_SPACEDIM >= 2)
+                x_old[ip] = xp;
+#endif
+#if defined(WARPX_DIM_3D)
+                y_old[ip] = yp;
+#endif
+                z_old[ip] = zp;
+            }
+
+            amrex::ParticleReal Exp = Ex_external_particle;
+            amrex::ParticleReal Eyp = Ey_external_particle;
+            amrex::ParticleReal Ezp = Ez_external_particle;
+            amrex::ParticleReal Bxp = Bx_external_particle;
+            amrex::ParticleReal Byp = By_external_particle;
+            amrex::ParticleReal Bzp = Bz_external_particle;
+
+            if (gathered_EB) {
+                Exp += gathered_EB[ip];
+                Eyp += gathered_EB[ip +   np_to_push];
+                Ezp += gathered_EB[ip + 2*np_to_push];
+                Bxp += gathered_EB[ip + 3*np_to_push];
+                Byp += gathered_EB[ip + 4*np_to_push];
+                Bzp += gathered_EB[ip + 5*np_to_push];
+            } else if(!t_do_not_gather){
+                doGatherShapeN(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                               ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                               ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                               dx_arr, xyzmin_arr, lo, n_rz_azimuthal_modes,
+                               nox, galerkin_interpolation);
+            }
+
+            [[maybe_unused]] const auto& getExternalEB_tmp = getExternalEB;
+            if constexpr (exteb_control == has_exteb) {
+                getExternalEB(ip, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
+            }
+
+            scaleFields(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
+
+            if (do_copy) {
+                //  Copy the old x and u for the BTD
+                copyAttribs(ip);
+            }
+
+            Exv[ip] = Exp;
+            Eyv[ip] = Eyp;
+            Ezv[ip] = Ezp;
+            Bxv[ip] = Bxp;
+            Byv[ip] = Byp;
+            Bzv[ip] = Bzp;
+        });
+
+        amrex::ParallelFor(
+            TypeList<CompileTimeOptions<ParticlePusherAlgo::Boris,
+                                        ParticlePusherAlgo::Vay,
+                                        ParticlePusherAlgo::HigueraCary>,
+                     CompileTimeOptions<0,1>>{},
+            {pusher_algo, do_crr ? 1 : 0},
+            np_to_push,
+            [=] AMREX_GPU_DEVICE (long ip, auto pusher_control, auto crr_control)
+        {
+            doParticleMomentumPushStatic<pusher_control, crr_control>(
+                ux[ip], uy[ip], uz[ip],
+                Exv[ip], Eyv[ip], Ezv[ip], Bxv[ip], Byv[ip], Bzv[ip],
+                ion_lev ? ion_lev[ip] : 1, m, q, dt);
+
+            amrex::ParticleReal xp, yp, zp;
+            getPosition(ip, xp, yp, zp);
+            UpdatePosition(xp, yp, zp, ux[ip], uy[ip], uz[ip], dt);
+            setPosition(ip, xp, yp, zp);
+        });
+        return;
+    }
+#endif
+
+    // The pusher (with or without classical radiation reaction) and the
+    // ionization are also compile time options of the kernel below
+    enum pusher_flags : int {
+        boris = ParticlePusherAlgo::Boris,
+        vay = ParticlePusherAlgo::Vay,
+        higuera_cary = ParticlePusherAlgo::HigueraCary,
+        boris_crr
+    };
+    enum ionization_flags : int { no_ionization, has_ionization };
+
+    const int pusher_runtime_flag =
+        do_crr ? boris_crr :
+        (pusher_algo == ParticlePusherAlgo::Vay) ? vay :
+        (pusher_algo == ParticlePusherAlgo::HigueraCary) ? higuera_cary : boris;
+    const int ionization_runtime_flag = ion_lev ? has_ionization : no_ionization;
+
+    if (Verbose() && !m_push_kernel_variant_reported) {
+        // 4 pushers x 2 ionization x 2 external EB (x 2 QED) variants are compiled
+        const char* pusher_names[] = {"boris", "vay", "higuera", "boris_radiation_reaction"};
+#ifdef WARPX_QED
+        const int n_variants = 32;
+#else
+        const int n_variants = 16;
+#endif
+        amrex::Print() << Utils::TextMsg::Info(
+            "PushPX kernel variant for species " + species_name + ": pusher = "
+            + pusher_names[pusher_runtime_flag]
+            + ", ionization = " + std::to_string(ionization_runtime_flag)
+            + ", external EB = " + std::to_string(exteb_runtime_flag)
+            + ", QED = " + std::to_string(qed_runtime_flag)
+            + " (one of " + std::to_string(n_variants) + " compiled variants)");
+        m_push_kernel_variant_reported = true;
+    }
+
     // Using this version of ParallelFor with compile time options
-    // improves performance when qed or external EB are not used by reducing
-    // register pressure.
+    // improves performance when qed, external EB or ionization are not
+    // used by reducing register pressure, and removes the branches on the pusher.
     amrex::ParallelFor(
-        TypeList<CompileTimeOptions<no_exteb,has_exteb>, CompileTimeOptions<no_qed  ,has_qed>>{},
-        {exteb_runtime_flag, qed_runtime_flag},
+        TypeList<CompileTimeOptions<no_exteb,has_exteb>, CompileTimeOptions<no_qed  ,has_qed>,
+                 CompileTimeOptions<boris,vay,higuera_cary,boris_crr>,
+                 CompileTimeOptions<no_ionization,has_ionization>>{},
+        {exteb_runtime_flag, qed_runtime_flag, pusher_runtime_flag, ionization_runtime_flag},
         np_to_push,
-        [=] AMREX_GPU_DEVICE (long ip, auto exteb_control, auto qed_control)
+        [=] AMREX_GPU_DEVICE (long ip, auto exteb_control, auto qed_control,
+                              auto pusher_control, auto ionization_control)
     {
         amrex::ParticleReal xp, yp, zp;
         getPosition(ip, xp, yp, zp);
@@ -2903,7 +3349,15 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
         amrex::ParticleReal Byp = By_external_particle;
         amrex::ParticleReal Bzp = Bz_external_particle;
 
-        if(!t_do_not_gather){
+        if (gathered_EB) {
+            // the fields were already gathered with shared memory
+            Exp += gathered_EB[ip];
+            Eyp += gathered_EB[ip +   np_to_push];
+            Ezp += gathered_EB[ip + 2*np_to_push];
+            Bxp += gathered_EB[ip + 3*np_to_push];
+            Byp += gathered_EB[ip + 4*np_to_push];
+            Bzp += gathered_EB[ip + 5*np_to_push];
+        } else if(!t_do_not_gather){
             // first gather E and B to the particle positions
             doGatherShapeN(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
                            ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
@@ -2919,6 +3373,11 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
 
         scaleFields(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
 
+        int ion_lev_p = 1;
+        if constexpr (ionization_control == has_ionization) {
+            ion_lev_p = ion_lev[ip];
+        }
+
 #ifdef WARPX_QED
         if (!do_sync)
 #endif
@@ -2928,14 +3387,15 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
                 copyAttribs(ip);
             }
 
-            doParticleMomentumPush<0>(ux[ip], uy[ip], uz[ip],
-                                      Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                                      ion_lev ? ion_lev[ip] : 1,
-                                      m, q, pusher_algo, do_crr,
-#ifdef WARPX_QED
-                                      t_chi_max,
-#endif
-                                      dt);
+            if constexpr (pusher_control == boris_crr) {
+                doParticleMomentumPushStatic<ParticlePusherAlgo::Boris, 1>(
+                    ux[ip], uy[ip], uz[ip], Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                    ion_lev_p, m, q, dt);
+            } else {
+                doParticleMomentumPushStatic<pusher_control, 0>(
+                    ux[ip], uy[ip], uz[ip], Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                    ion_lev_p, m, q, dt);
+            }
 
             UpdatePosition(xp, yp, zp, ux[ip], uy[ip], uz[ip], dt);
             setPosition(ip, xp, yp, zp);
@@ -2950,7 +3410,7 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
 
                 doParticleMomentumPush<1>(ux[ip], uy[ip], uz[ip],
                                           Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                                          ion_lev ? ion_lev[ip] : 1,
+                                          ion_lev_p,
                                           m, q, pusher_algo, do_crr,
                                           t_chi_max,
                                           dt);
@@ -2978,6 +3438,292 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
     });
 }
 
+bool
+PhysicalParticleContainer::canFusePushAndDeposit () const
+{
+    if (!WarpX::do_fused_push_deposit) { return false; }
+    if (WarpX::current_deposition_algo != CurrentDepositionAlgo::Esirkepov) { return false; }
+    if (WarpX::do_shared_mem_current_deposition) { return false; }
+    if (WarpX::grid_type == GridType::Collocated) { return false; }
+    if (do_field_ionization || m_do_back_transformed_particles || m_save_previous_position) {
+        return false;
+    }
+    if (do_not_push || do_not_deposit) { return false; }
+#ifdef WARPX_QED
+    if (m_do_qed_quantum_sync || has_quantum_sync()) { return false; }
+#endif
+    return true;
+}
+
+bool
+PhysicalParticleContainer::canFuseChargeDeposition ()
+{
+    if (WarpX::do_shared_mem_charge_deposition) { return false; }
+    if (WarpX::ncomps != 1) { return false; }
+    const auto& v_galilean = WarpX::GetInstance().m_v_galilean;
+    return v_galilean[0] == 0._rt && v_galilean[1] == 0._rt && v_galilean[2] == 0._rt;
+}
+
+bool
+PhysicalParticleContainer::canEvolveConcurrently () const
+{
+    if (WarpX::do_shared_mem_field_gather || WarpX::do_shared_mem_current_deposition ||
+        WarpX::do_shared_mem_charge_deposition) {
+        return false;
+    }
+    if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Vay) { return false; }
+    if (deposition_mixed_precision) { return false; }
+    if (do_splitting || m_push_interval > 1) { return false; }
+    return true;
+}
+
+void
+PhysicalParticleContainer::PushPXDepositCurrent (WarpXParIter& pti,
+                                                 amrex::FArrayBox const * exfab,
+                                                 amrex::FArrayBox const * eyfab,
+                                                 amrex::FArrayBox const * ezfab,
+                                                 amrex::FArrayBox const * bxfab,
+                                                 amrex::FArrayBox const * byfab,
+                                                 amrex::FArrayBox const * bzfab,
+                                                 const amrex::IntVect ngEB,
+                                                 const long np_to_push,
+                                                 int lev, amrex::Real dt,
+                                                 amrex::MultiFab * const jx,
+                                                 amrex::MultiFab * const jy,
+                                                 amrex::MultiFab * const jz,
+                                                 int const thread_num,
+                                                 amrex::MultiFab * const rho)
+{
+    // If no particles, do not do anything
+    if (np_to_push == 0) { return; }
+
+    // Fields are gathered from and current is deposited on the same level
+    const std::array<Real,3>& dx = WarpX::CellSize(std::max(lev,0));
+
+    // Box from which the fields are gathered
+    Box gather_box = pti.tilebox();
+    gather_box.grow(ngEB);
+
+    const auto getPosition = GetParticlePosition<PIdx>(pti);
+          auto setPosition = SetParticlePosition<PIdx>(pti);
+
+    const auto getExternalEB = GetExternalEBField(pti);
+
+    const amrex::ParticleReal Ex_external_particle = m_E_external_particle[0];
+    const amrex::ParticleReal Ey_external_particle = m_E_external_particle[1];
+    const amrex::ParticleReal Ez_external_particle = m_E_external_particle[2];
+    const amrex::ParticleReal Bx_external_particle = m_B_external_particle[0];
+    const amrex::ParticleReal By_external_particle = m_B_external_particle[1];
+    const amrex::ParticleReal Bz_external_particle = m_B_external_particle[2];
+
+    // Lower corner of tile box physical domain (take into account Galilean shift)
+    const std::array<amrex::Real, 3>& xyzmin_gather = WarpX::LowerCorner(gather_box, lev, 0._rt);
+    const Dim3 lo_gather = lbound(gather_box);
+
+    const bool galerkin_interpolation = WarpX::galerkin_interpolation;
+    const int nox = WarpX::nox;
+    const int n_rz_azimuthal_modes = WarpX::n_rz_azimuthal_modes;
+
+    const amrex::GpuArray<amrex::Real, 3> dx_arr = {dx[0], dx[1], dx[2]};
+    const amrex::GpuArray<amrex::Real, 3> xyzmin_gather_arr = {xyzmin_gather[0], xyzmin_gather[1], xyzmin_gather[2]};
+
+    amrex::Array4<const amrex::Real> const& ex_arr = exfab->array();
+    amrex::Array4<const amrex::Real> const& ey_arr = eyfab->array();
+    amrex::Array4<const amrex::Real> const& ez_arr = ezfab->array();
+    amrex::Array4<const amrex::Real> const& bx_arr = bxfab->array();
+    amrex::Array4<const amrex::Real> const& by_arr = byfab->array();
+    amrex::Array4<const amrex::Real> const& bz_arr = bzfab->array();
+
+    amrex::IndexType const ex_type = exfab->box().ixType();
+    amrex::IndexType const ey_type = eyfab->box().ixType();
+    amrex::IndexType const ez_type = ezfab->box().ixType();
+    amrex::IndexType const bx_type = bxfab->box().ixType();
+    amrex::IndexType const by_type = byfab->box().ixType();
+    amrex::IndexType const bz_type = bzfab->box().ixType();
+
+    // Box on which the current is deposited, same as in DepositCurrent
+    const WarpX& warpx = WarpX::GetInstance();
+    const amrex::IntVect& ng_J = warpx.get_ng_depos_J();
+    Box depos_box = pti.tilebox();
+    // Staggered tile boxes (different in each direction)
+    Box tbx = convert( depos_box, jx->ixType().toIntVect() );
+    Box tby = convert( depos_box, jy->ixType().toIntVect() );
+    Box tbz = convert( depos_box, jz->ixType().toIntVect() );
+    tbx.grow(ng_J);
+    tby.grow(ng_J);
+    tbz.grow(ng_J);
+    depos_box.grow(ng_J);
+
+#ifdef AMREX_USE_GPU
+    amrex::ignore_unused(thread_num);
+    // GPU, no tiling: j<xyz>_arr point to the full j<xyz> arrays, or, with mixed
+    // precision, to the buffers of the current stream (see DepositionReal)
+    [[maybe_unused]] const int i_buffer = deposition_mixed_precision ?
+        amrex::Gpu::Device::streamIndex() : 0;
+    Array4<DepositionReal> const& jx_arr =
+        depositionBuffer(jx->get(pti), tbx, local_jx[i_buffer]).array();
+    Array4<DepositionReal> const& jy_arr =
+        depositionBuffer(jy->get(pti), tby, local_jy[i_buffer]).array();
+    Array4<DepositionReal> const& jz_arr =
+        depositionBuffer(jz->get(pti), tbz, local_jz[i_buffer]).array();
+#else
+
+    // CPU, tiling: j<xyz>_arr point to the local_j<xyz>[thread_num] arrays
+    local_jx[thread_num].resize(tbx, jx->nComp());
+    local_jy[thread_num].resize(tby, jy->nComp());
+    local_jz[thread_num].resize(tbz, jz->nComp());
+
+    local_jx[thread_num].setVal(0.0);
+    local_jy[thread_num].setVal(0.0);
+    local_jz[thread_num].setVal(0.0);
+
+    Array4<DepositionReal> const& jx_arr = local_jx[thread_num].array();
+    Array4<DepositionReal> const& jy_arr = local_jy[thread_num].array();
+    Array4<DepositionReal> const& jz_arr = local_jz[thread_num].array();
+#endif
+
+    // Charge density after the push (component 1 of rho), deposited on the same box
+    amrex::Array4<amrex::Real> rho_arr;
+#ifndef AMREX_USE_GPU
+    Box tb_rho;
+#endif
+    if (rho) {
+#ifdef AMREX_USE_GPU
+        rho_arr = (*rho)[pti].array(1);
+#else
+        tb_rho = convert(pti.tilebox(), rho->ixType().toIntVect());
+        tb_rho.grow(ng_J);
+        tb_rho &= (*rho)[pti].box();
+        local_rho[thread_num].resize(tb_rho, 1);
+        local_rho[thread_num].setVal(0.0);
+        rho_arr = local_rho[thread_num].array();
+#endif
+    }
+#if defined(WARPX_DIM_3D)
+    const amrex::Real rho_invvol = 1.0_rt / (dx[0]*dx[1]*dx[2]);
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    const amrex::Real rho_invvol = 1.0_rt / (dx[0]*dx[2]);
+#elif defined(WARPX_DIM_1D_Z)
+    const amrex::Real rho_invvol = 1.0_rt / (dx[2]);
+#endif
+
+    // Lower corner of the deposition box (take into account Galilean shift)
+    const std::array<amrex::Real, 3>& xyzmin_depos = WarpX::LowerCorner(depos_box, lev, 0.5_rt*dt);
+    const Dim3 lo_depos = lbound(depos_box);
+
+    // Deposit at t_{n+1/2}
+    const amrex::Real relative_time = -0.5_rt * dt;
+
+    const amrex::XDim3 dinv{1.0_rt / dx[0], 1.0_rt / dx[1], 1.0_rt / dx[2]};
+    const amrex::XDim3 xyzmin_depos_dim3{xyzmin_depos[0], xyzmin_depos[1], xyzmin_depos[2]};
+#if defined(WARPX_DIM_3D)
+    const amrex::XDim3 invdtd{1.0_rt / (dt*dx[1]*dx[2]),
+                              1.0_rt / (dt*dx[0]*dx[2]),
+                              1.0_rt / (dt*dx[0]*dx[1])};
+    const amrex::Real invvol = 0._rt; // not used in 3D
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    const amrex::XDim3 invdtd{1.0_rt / (dt*dx[2]), 0._rt, 1.0_rt / (dt*dx[0])};
+    const amrex::Real invvol = 1.0_rt / (dx[0]*dx[2]);
+#elif defined(WARPX_DIM_1D_Z)
+    const amrex::XDim3 invdtd{0._rt, 0._rt, 1.0_rt / (dt*dx[0])};
+    const amrex::Real invvol = 1.0_rt / (dx[2]);
+#endif
+
+    auto& attribs = pti.GetAttribs();
+    const ParticleReal* const AMREX_RESTRICT wp = attribs[PIdx::w].dataPtr();
+    ParticleReal* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr();
+    ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr();
+    ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr();
+
+    const amrex::ParticleReal q = this->charge;
+    const amrex::ParticleReal m = this-> mass;
+
+    const auto pusher_algo = WarpX::particle_pusher_algo;
+    const auto do_crr = do_classical_radiation_reaction;
+#ifdef WARPX_QED
+    const amrex::Real t_chi_max = 0.0;
+#endif
+
+    const auto t_do_not_gather = do_not_gather;
+
+    enum exteb_flags : int { no_exteb, has_exteb };
+    const int exteb_runtime_flag = getExternalEB.isNoOp() ? no_exteb : has_exteb;
+    enum rho_flags : int { no_rho, has_rho };
+    const int rho_runtime_flag = rho ? has_rho : no_rho;
+
+    // The deposition order is a compile-time option, so that the shape
+    // factor arrays of the Esirkepov kernel can be kept in registers.
+    amrex::ParallelFor(
+        TypeList<CompileTimeOptions<no_exteb,has_exteb>, CompileTimeOptions<1,2,3,4>,
+                 CompileTimeOptions<no_rho,has_rho>>{},
+        {exteb_runtime_flag, nox, rho_runtime_flag},
+        np_to_push,
+        [=] AMREX_GPU_DEVICE (long ip, auto exteb_control, auto order_control, auto rho_control)
+    {
+        constexpr int depos_order = decltype(order_control)::value;
+        constexpr bool deposit_rho = (rho_control == has_rho);
+
+        amrex::ParticleReal xp, yp, zp;
+        getPosition(ip, xp, yp, zp);
+
+        amrex::ParticleReal Exp = Ex_external_particle;
+        amrex::ParticleReal Eyp = Ey_external_particle;
+        amrex::ParticleReal Ezp = Ez_external_particle;
+        amrex::ParticleReal Bxp = Bx_external_particle;
+        amrex::ParticleReal Byp = By_external_particle;
+        amrex::ParticleReal Bzp = Bz_external_particle;
+
+        if(!t_do_not_gather){
+            // first gather E and B to the particle positions
+            doGatherShapeN(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                           ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                           ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                           dx_arr, xyzmin_gather_arr, lo_gather, n_rz_azimuthal_modes,
+                           nox, galerkin_interpolation);
+        }
+
+        [[maybe_unused]] const auto& getExternalEB_tmp = getExternalEB;
+        if constexpr (exteb_control == has_exteb) {
+            getExternalEB(ip, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
+        }
+
+        doParticleMomentumPush<0>(ux[ip], uy[ip], uz[ip],
+                                  Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                                  1, m, q, pusher_algo, do_crr,
+#ifdef WARPX_QED
+                                  t_chi_max,
+#endif
+                                  dt);
+
+        UpdatePosition(xp, yp, zp, ux[ip], uy[ip], uz[ip], dt);
+        setPosition(ip, xp, yp, zp);
+
+        // Deposit the current (and the charge) of the pushed particle, while its
+        // position and momentum are still in registers
+        doEsirkepovDepositionShapeNKernel<depos_order, DepositionReal, deposit_rho>(
+            xp, yp, zp, q*wp[ip], ux[ip], uy[ip], uz[ip],
+            jx_arr, jy_arr, jz_arr,
+            dt, relative_time,
+            dinv, xyzmin_depos_dim3, invdtd, invvol,
+            lo_depos, n_rz_azimuthal_modes, rho_arr, rho_invvol);
+    });
+
+#ifndef AMREX_USE_GPU
+    // CPU, tiling: atomicAdd local_j<xyz> into j<xyz>
+    lockAddDeposited((*jx)[pti], local_jx[thread_num], tbx, jx->nComp());
+    lockAddDeposited((*jy)[pti], local_jy[thread_num], tby, jy->nComp());
+    lockAddDeposited((*jz)[pti], local_jz[thread_num], tbz, jz->nComp());
+    if (rho) {
+        (*rho)[pti].lockAdd(local_rho[thread_num], tb_rho, tb_rho, 0, 1, 1);
+    }
+#else
+    // GPU, mixed precision: add the buffers into j<xyz>
+    addDepositionBuffer(jx->get(pti), local_jx[i_buffer]);
+    addDepositionBuffer(jy->get(pti), local_jy[i_buffer]);
+    addDepositionBuffer(jz->get(pti), local_jz[i_buffer]);
+#endif
+}
+
 /* \brief Perform the implicit particle push operation in one fused kernel
  *        The main difference from PushPX is the order of operations:
  *         - push position by 1/2 dt
@@ -3023,6 +3769,7 @@ PhysicalParticleContainer::ImplicitPushXP (WarpXParIter& pti,
     // Add guard cells to the box.
     box.grow(ngEB);
 
+    const auto getPosition = GetParticlePosition<PIdx>(pti, offset);
     auto setPosition = SetParticlePosition(pti, offset);
 
     const auto getExternalEB = GetExternalEBField(pti, offset);
@@ -3065,16 +3812,19 @@ PhysicalParticleContainer::ImplicitPushXP (WarpXParIter& pti,
     ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr() + offset;
     ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr() + offset;
 
+    // Differences between the values at the start of the step and the current ones,
+    // updated below each time the position and momentum are updated
+    auto& implicit_state = getImplicitState(pti.GetLevel(), pti.GetPairIndex());
 #if (AMREX_SPACEDIM >= 2)
-    ParticleReal* x_n = pti.GetAttribs(particle_comps["x_n"]).dataPtr();
+    float* const AMREX_RESTRICT dx_n = implicit_state[ImplicitIdx::dx_n].dataPtr() + offset;
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-    ParticleReal* y_n = pti.GetAttribs(particle_comps["y_n"]).dataPtr();
+    float* const AMREX_RESTRICT dy_n = implicit_state[ImplicitIdx::dy_n].dataPtr() + offset;
 #endif
-    ParticleReal* z_n = pti.GetAttribs(particle_comps["z_n"]).dataPtr();
-    ParticleReal* ux_n = pti.GetAttribs(particle_comps["ux_n"]).dataPtr();
-    ParticleReal* uy_n = pti.GetAttribs(particle_comps["uy_n"]).dataPtr();
-    ParticleReal* uz_n = pti.GetAttribs(particle_comps["uz_n"]).dataPtr();
+    float* const AMREX_RESTRICT dz_n = implicit_state[ImplicitIdx::dz_n].dataPtr() + offset;
+    float* const AMREX_RESTRICT dux_n = implicit_state[ImplicitIdx::dux_n].dataPtr() + offset;
+    float* const AMREX_RESTRICT duy_n = implicit_state[ImplicitIdx::duy_n].dataPtr() + offset;
+    float* const AMREX_RESTRICT duz_n = implicit_state[ImplicitIdx::duz_n].dataPtr() + offset;
 
     const int do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf) );
     CopyParticleAttribs copyAttribs;
@@ -3125,166 +3875,225 @@ PhysicalParticleContainer::ImplicitPushXP (WarpXParIter& pti,
     amrex::Gpu::Buffer<amrex::Long> unconverged_particles({0});
     amrex::Long* unconverged_particles_ptr = unconverged_particles.data();
 
+    // Displacements of the previous iteration, used in the convergence test
+    amrex::Gpu::DeviceVector<amrex::ParticleReal> dxp_save(np_to_push);
+    amrex::Gpu::DeviceVector<amrex::ParticleReal> dyp_save(np_to_push);
+    amrex::Gpu::DeviceVector<amrex::ParticleReal> dzp_save(np_to_push);
+    amrex::ParticleReal* const AMREX_RESTRICT dxp_save_ptr = dxp_save.dataPtr();
+    amrex::ParticleReal* const AMREX_RESTRICT dyp_save_ptr = dyp_save.dataPtr();
+    amrex::ParticleReal* const AMREX_RESTRICT dzp_save_ptr = dzp_save.dataPtr();
+
+    // Worklist of the particles that have not converged yet, compacted after each
+    // iteration so that the iterations only touch the unconverged particles
+    amrex::Gpu::DeviceVector<long> active(np_to_push);
+    amrex::Gpu::DeviceVector<long> next_active(np_to_push);
+    amrex::Gpu::DeviceVector<int> done(np_to_push);
+    long* AMREX_RESTRICT active_ptr = active.dataPtr();
+    long* AMREX_RESTRICT next_active_ptr = next_active.dataPtr();
+    int* const AMREX_RESTRICT done_ptr = done.dataPtr();
+    amrex::ParallelFor(np_to_push, [=] AMREX_GPU_DEVICE (long i) { active_ptr[i] = i; });
+
+    auto idxg2 = static_cast<amrex::ParticleReal>(1._rt/(dx[0]*dx[0]));
+    auto idyg2 = static_cast<amrex::ParticleReal>(1._rt/(dx[1]*dx[1]));
+    auto idzg2 = static_cast<amrex::ParticleReal>(1._rt/(dx[2]*dx[2]));
+
+    long num_active = np_to_push;
+    amrex::Long total_iterations = 0;
+    int max_iterations_done = 0;
+    for (int iter=0; iter<max_iterations && num_active>0; ++iter) {
+
     // Using this version of ParallelFor with compile time options
     // improves performance when qed or external EB are not used by reducing
     // register pressure.
     amrex::ParallelFor(TypeList<CompileTimeOptions<no_exteb,has_exteb>,
                                 CompileTimeOptions<no_qed  ,has_qed>>{},
                        {exteb_runtime_flag, qed_runtime_flag},
-                       np_to_push, [=] AMREX_GPU_DEVICE (long ip, auto exteb_control,
+                       num_active, [=] AMREX_GPU_DEVICE (long i, auto exteb_control,
                                                          auto qed_control)
     {
+        const long ip = active_ptr[i];
+
         // Position advance starts from the position at the start of the step
         // but uses the most recent velocity.
 
+        amrex::ParticleReal xp, yp, zp;
+        getPosition(ip, xp, yp, zp);
 #if (AMREX_SPACEDIM >= 2)
-        amrex::ParticleReal xp = x_n[ip];
-        const amrex::ParticleReal xp_n = x_n[ip];
+        const amrex::ParticleReal xp_n = xp + dx_n[ip];
 #else
-        const amrex::ParticleReal xp = 0._rt;
         const amrex::ParticleReal xp_n = 0._rt;
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-        amrex::ParticleReal yp = y_n[ip];
-        const amrex::ParticleReal yp_n = y_n[ip];
+        const amrex::ParticleReal yp_n = yp + dy_n[ip];
 #else
-        const amrex::ParticleReal yp = 0._rt;
         const amrex::ParticleReal yp_n = 0._rt;
 #endif
-        amrex::ParticleReal zp = z_n[ip];
-        const amrex::ParticleReal zp_n = z_n[ip];
-
-        amrex::ParticleReal dxp, dxp_save;
-        amrex::ParticleReal dyp, dyp_save;
-        amrex::ParticleReal dzp, dzp_save;
-        auto idxg2 = static_cast<amrex::ParticleReal>(1._rt/(dx[0]*dx[0]));
-        auto idyg2 = static_cast<amrex::ParticleReal>(1._rt/(dx[1]*dx[1]));
-        auto idzg2 = static_cast<amrex::ParticleReal>(1._rt/(dx[2]*dx[2]));
-
-        amrex::ParticleReal step_norm = 1._prt;
-        for (int iter=0; iter<max_iterations;) {
-
-            dxp = 0.0;
-            dyp = 0.0;
-            dzp = 0.0;
-            UpdatePositionImplicit(dxp, dyp, dzp, ux_n[ip], uy_n[ip], uz_n[ip], ux[ip], uy[ip], uz[ip], 0.5_rt*dt);
+        const amrex::ParticleReal zp_n = zp + dz_n[ip];
+        const amrex::ParticleReal uxp_n = ux[ip] + dux_n[ip];
+        const amrex::ParticleReal uyp_n = uy[ip] + duy_n[ip];
+        const amrex::ParticleReal uzp_n = uz[ip] + duz_n[ip];
+
+        amrex::ParticleReal dxp = 0.0;
+        amrex::ParticleReal dyp = 0.0;
+        amrex::ParticleReal dzp = 0.0;
+        UpdatePositionImplicit(dxp, dyp, dzp, uxp_n, uyp_n, uzp_n, ux[ip], uy[ip], uz[ip], 0.5_rt*dt);
 #if !defined(WARPX_DIM_1D_Z)
-            xp = xp_n + dxp;
+        xp = xp_n + dxp;
+        dx_n[ip] = static_cast<float>(xp_n - xp);
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-            yp = yp_n + dyp;
+        yp = yp_n + dyp;
+        dy_n[ip] = static_cast<float>(yp_n - yp);
 #endif
-            zp = zp_n + dzp;
-            setPosition(ip, xp, yp, zp);
+        zp = zp_n + dzp;
+        dz_n[ip] = static_cast<float>(zp_n - zp);
+        setPosition(ip, xp, yp, zp);
 
-            PositionNorm( dxp, dyp, dzp, dxp_save, dyp_save, dzp_save,
-                          idxg2, idyg2, idzg2, step_norm, iter );
-            if( step_norm < particle_tolerance ) { break; }
+        amrex::ParticleReal step_norm = 1._prt;
+        PositionNorm( dxp, dyp, dzp, dxp_save_ptr[ip], dyp_save_ptr[ip], dzp_save_ptr[ip],
+                      idxg2, idyg2, idzg2, step_norm, iter );
+        if( step_norm < particle_tolerance ) {
+            done_ptr[i] = 1;
+            return;
+        }
 
-            amrex::ParticleReal Exp = Ex_external_particle;
-            amrex::ParticleReal Eyp = Ey_external_particle;
-            amrex::ParticleReal Ezp = Ez_external_particle;
-            amrex::ParticleReal Bxp = Bx_external_particle;
-            amrex::ParticleReal Byp = By_external_particle;
-            amrex::ParticleReal Bzp = Bz_external_particle;
+        amrex::ParticleReal Exp = Ex_external_particle;
+        amrex::ParticleReal Eyp = Ey_external_particle;
+        amrex::ParticleReal Ezp = Ez_external_particle;
+        amrex::ParticleReal Bxp = Bx_external_particle;
+        amrex::ParticleReal Byp = By_external_particle;
+        amrex::ParticleReal Bzp = Bz_external_particle;
 
-            if(!t_do_not_gather){
-                // first gather E and B to the particle positions
-                doGatherShapeNImplicit(xp_n, yp_n, zp_n, xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                                       ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
-                                       ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
-                                       dx_arr, xyzmin_arr, lo, n_rz_azimuthal_modes, nox,
-                                       depos_type );
-            }
+        if(!t_do_not_gather){
+            // first gather E and B to the particle positions
+            doGatherShapeNImplicit(xp_n, yp_n, zp_n, xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                                   ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                                   ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                                   dx_arr, xyzmin_arr, lo, n_rz_azimuthal_modes, nox,
+                                   depos_type );
+        }
 
-            // Externally applied E and B-field in Cartesian co-ordinates
-            [[maybe_unused]] const auto& getExternalEB_tmp = getExternalEB;
-            if constexpr (exteb_control == has_exteb) {
-                getExternalEB(ip, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
-            }
+        // Externally applied E and B-field in Cartesian co-ordinates
+        [[maybe_unused]] const auto& getExternalEB_tmp = getExternalEB;
+        if constexpr (exteb_control == has_exteb) {
+            getExternalEB(ip, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
+        }
 
-            scaleFields(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
+        scaleFields(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
 
-            if (do_copy) {
-                //  Copy the old x and u for the BTD
-                copyAttribs(ip);
-            }
+        if (do_copy) {
+            //  Copy the old x and u for the BTD
+            copyAttribs(ip);
+        }
 
-            // The momentum push starts with the velocity at the start of the step
-            ux[ip] = ux_n[ip];
-            uy[ip] = uy_n[ip];
-            uz[ip] = uz_n[ip];
+        // The momentum push starts with the velocity at the start of the step
+        ux[ip] = uxp_n;
+        uy[ip] = uyp_n;
+        uz[ip] = uzp_n;
 
 #ifdef WARPX_QED
-            if (!do_sync)
+        if (!do_sync)
 #endif
-            {
-                doParticleMomentumPush<0>(ux[ip], uy[ip], uz[ip],
+        {
+            doParticleMomentumPush<0>(ux[ip], uy[ip], uz[ip],
+                                      Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                                      ion_lev ? ion_lev[ip] : 1,
+                                      m, q, pusher_algo, do_crr,
+#ifdef WARPX_QED
+                                      t_chi_max,
+#endif
+                                      dt);
+        }
+#ifdef WARPX_QED
+        else {
+            if constexpr (qed_control == has_qed) {
+                doParticleMomentumPush<1>(ux[ip], uy[ip], uz[ip],
                                           Exp, Eyp, Ezp, Bxp, Byp, Bzp,
                                           ion_lev ? ion_lev[ip] : 1,
                                           m, q, pusher_algo, do_crr,
-#ifdef WARPX_QED
                                           t_chi_max,
-#endif
                                           dt);
             }
-#ifdef WARPX_QED
-            else {
-                if constexpr (qed_control == has_qed) {
-                    doParticleMomentumPush<1>(ux[ip], uy[ip], uz[ip],
-                                              Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                                              ion_lev ? ion_lev[ip] : 1,
-                                              m, q, pusher_algo, do_crr,
-                                              t_chi_max,
-                                              dt);
-                }
-            }
+        }
 #endif
 
 #ifdef WARPX_QED
-            [[maybe_unused]] auto foo_local_has_quantum_sync = local_has_quantum_sync;
-            [[maybe_unused]] auto *foo_podq = p_optical_depth_QSR;
-            [[maybe_unused]] const auto& foo_evolve_opt = evolve_opt; // have to do all these for nvcc
-            if constexpr (qed_control == has_qed) {
-                if (local_has_quantum_sync) {
-                    evolve_opt(ux[ip], uy[ip], uz[ip],
-                               Exp, Eyp, Ezp,Bxp, Byp, Bzp,
-                               dt, p_optical_depth_QSR[ip]);
-                }
+        [[maybe_unused]] auto foo_local_has_quantum_sync = local_has_quantum_sync;
+        [[maybe_unused]] auto *foo_podq = p_optical_depth_QSR;
+        [[maybe_unused]] const auto& foo_evolve_opt = evolve_opt; // have to do all these for nvcc
+        if constexpr (qed_control == has_qed) {
+            if (local_has_quantum_sync) {
+                evolve_opt(ux[ip], uy[ip], uz[ip],
+                           Exp, Eyp, Ezp,Bxp, Byp, Bzp,
+                           dt, p_optical_depth_QSR[ip]);
             }
+        }
 #else
-            amrex::ignore_unused(qed_control);
+        amrex::ignore_unused(qed_control);
 #endif
 
-            // Take average to get the time centered value
-            ux[ip] = 0.5_rt*(ux[ip] + ux_n[ip]);
-            uy[ip] = 0.5_rt*(uy[ip] + uy_n[ip]);
-            uz[ip] = 0.5_rt*(uz[ip] + uz_n[ip]);
+        // Take average to get the time centered value
+        ux[ip] = 0.5_rt*(ux[ip] + uxp_n);
+        uy[ip] = 0.5_rt*(uy[ip] + uyp_n);
+        uz[ip] = 0.5_rt*(uz[ip] + uzp_n);
+        dux_n[ip] = static_cast<float>(uxp_n - ux[ip]);
+        duy_n[ip] = static_cast<float>(uyp_n - uy[ip]);
+        duz_n[ip] = static_cast<float>(uzp_n - uz[ip]);
 
-            iter++;
+        done_ptr[i] = 0;
 
-            // particle did not converge
-            if ( iter > 1 && iter == max_iterations ) {
+        // particle reached the maximum number of iterations
+        if ( iter+1 == max_iterations ) {
+            done_ptr[i] = 1;
 #if !defined(AMREX_USE_GPU)
+            if ( iter > 0 ) {
                 std::stringstream convergenceMsg;
                 convergenceMsg << "Picard solver for particle failed to converge after " <<
-                    iter << " iterations. " << std::endl;
+                    iter+1 << " iterations. " << std::endl;
                 convergenceMsg << "Position step norm is " << step_norm <<
                     " and the tolerance is " << particle_tolerance << std::endl;
                 convergenceMsg << " ux = " << ux[ip] << ", uy = " << uy[ip] << ", uz = " << uz[ip] << std::endl;
                 convergenceMsg << " xp = " << xp     << ", yp = " << yp     << ", zp = " << zp;
                 ablastr::warn_manager::WMRecordWarning("ImplicitPushXP", convergenceMsg.str());
+            }
 #endif
 
-                // write signaling flag: how many particles did not converge?
-                amrex::Gpu::Atomic::Add(unconverged_particles_ptr, amrex::Long(1));
-            }
+            // write signaling flag: how many particles did not converge?
+            amrex::Gpu::Atomic::Add(unconverged_particles_ptr, amrex::Long(1));
+        }
+    });
 
-        } // end Picard iterations
+    // Keep the particles that have not converged in the worklist
+    const long num_next_active = amrex::Scan::PrefixSum<long>(num_active,
+        [=] AMREX_GPU_DEVICE (long i) -> long { return done_ptr[i] ? 0 : 1; },
+        [=] AMREX_GPU_DEVICE (long i, long const& s) {
+            if (!done_ptr[i]) { next_active_ptr[s] = active_ptr[i]; }
+        },
+        amrex::Scan::Type::exclusive, amrex::Scan::retSum);
+
+    // Particles that converged at this iteration were pushed iter times
+    if (num_next_active < num_active) {
+        total_iterations += static_cast<amrex::Long>(num_active - num_next_active)*iter;
+        max_iterations_done = std::max(max_iterations_done, iter);
+    }
+    num_active = num_next_active;
+    std::swap(active_ptr, next_active_ptr);
 
-    });
+    } // end Picard iterations
+
+    // Particles that reached the maximum number of iterations were counted above
+    // with one push less. A single iteration is not considered as a convergence failure.
+    auto const num_capped_particles = *(unconverged_particles.copyToHost());
+    total_iterations += num_capped_particles;
+    if (num_capped_particles > 0) { max_iterations_done = max_iterations; }
+    auto const num_unconverged_particles = (max_iterations > 1) ? num_capped_particles : 0;
+
+    m_implicit_iteration_stats.num_pushes += np_to_push;
+    m_implicit_iteration_stats.total_iterations += total_iterations;
+    m_implicit_iteration_stats.num_unconverged += num_unconverged_particles;
+    m_implicit_iteration_stats.max_iterations = std::max(
+        m_implicit_iteration_stats.max_iterations, max_iterations_done);
 
-    auto const num_unconverged_particles = *(unconverged_particles.copyToHost());
     if (num_unconverged_particles > 0) {
         ablastr::warn_manager::WMRecordWarning("ImplicitPushXP",
             "Picard solver for " +
@@ -3308,6 +4117,10 @@ PhysicalParticleContainer::InitIonizationModule ()
         charge = PhysConst::q_e;
     }
     utils::parser::queryWithParser(pp_species_name, "do_adk_correction", do_adk_correction);
+    utils::parser::queryWithParser(pp_species_name, "adk_table_points", adk_table_size);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(adk_table_size == 0 || adk_table_size >= 2,
+        species_name + ".adk_table_points must be 0 or at least 2");
+    pp_species_name.query("skip_weak_field_tiles", do_skip_weak_field_tiles);
 
     utils::parser::queryWithParser(
         pp_species_name, "ionization_initial_level", ionization_initial_level);
@@ -3378,6 +4191,155 @@ PhysicalParticleContainer::InitIonizationModule ()
     });
 
     Gpu::synchronize();
+
+    InitADKTable();
+}
+
+void
+PhysicalParticleContainer::InitADKTable ()
+{
+    const int nlevels = ion_atomic_number;
+    Vector<Real> h_adk_power(nlevels), h_adk_prefactor(nlevels), h_adk_exp_prefactor(nlevels);
+    Gpu::copy(Gpu::deviceToHost, adk_power.begin(), adk_power.end(), h_adk_power.begin());
+    Gpu::copy(Gpu::deviceToHost, adk_prefactor.begin(), adk_prefactor.end(),
+              h_adk_prefactor.begin());
+    Gpu::copy(Gpu::deviceToHost, adk_exp_prefactor.begin(), adk_exp_prefactor.end(),
+              h_adk_exp_prefactor.begin());
+    Vector<Real> h_correction_factors(4, 0._rt);
+    if (do_adk_correction) {
+        Gpu::copy(Gpu::deviceToHost, adk_correction_factors.begin(), adk_correction_factors.end(),
+                  h_correction_factors.begin());
+    }
+
+    // Logarithm of the ADK probability of level i (before division by the Lorentz factor)
+    // in the field E = -adk_exp_prefactor[i]/x, computed as in IonizationFilterFunc.
+    // It is computed directly, since the probability itself underflows at large x.
+    const auto adk_log_probability = [&] (int i, double x) {
+        const double E = -h_adk_exp_prefactor[i]/x;
+        double log_w = std::log(static_cast<double>(h_adk_prefactor[i])) +
+            static_cast<double>(h_adk_power[i]) * std::log(E) - x;
+        if (do_adk_correction) {
+            const double r = E / h_correction_factors[3];
+            log_w += h_correction_factors[0]*r*r + h_correction_factors[1]*r +
+                h_correction_factors[2];
+        }
+        return log_w;
+    };
+
+    // Below this value, the probability 1-exp(-w) rounds to zero
+    const double log_w_zero = std::log(std::numeric_limits<Real>::epsilon()/4.);
+
+    // x_max of each level: the largest x, scanned backward from the point where exp(-x)
+    // underflows, for which the probability is not zero
+    const double x_underflow = -std::log(static_cast<double>(std::numeric_limits<Real>::min()));
+    constexpr double x_step = 0.05;
+    Vector<Real> h_x_max(nlevels), h_inv_dx(nlevels);
+    ionization_field_threshold = std::numeric_limits<Real>::max();
+    for (int i = 0; i < nlevels; ++i) {
+        double x_max = 1.;
+        for (double x = x_underflow; x > 1.; x -= x_step) {
+            if (adk_log_probability(i, x) >= log_w_zero) {
+                x_max = std::min(x + x_step, x_underflow);
+                break;
+            }
+        }
+        h_x_max[i] = static_cast<Real>(x_max);
+        h_inv_dx[i] = (adk_table_size > 1 && x_max > 1.) ?
+            static_cast<Real>((adk_table_size - 1)/(x_max - 1.)) : 0._rt;
+        ionization_field_threshold = std::min(ionization_field_threshold,
+            static_cast<Real>(-h_adk_exp_prefactor[i]/x_max));
+    }
+
+    adk_table_x_max.resize(nlevels);
+    adk_table_inv_dx.resize(nlevels);
+    Gpu::copyAsync(Gpu::hostToDevice, h_x_max.begin(), h_x_max.end(), adk_table_x_max.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, h_inv_dx.begin(), h_inv_dx.end(), adk_table_inv_dx.begin());
+
+    // The logarithm of the probability is tabulated: it is a smooth function of x (a linear
+    // function without Zhang's correction, up to the slowly varying log(E) term), whereas the
+    // probability varies by orders of magnitude between two points of the table, so that
+    // interpolating it linearly would overestimate it
+    if (adk_table_size > 0) {
+        Vector<Real> h_adk_table(static_cast<std::size_t>(nlevels)*adk_table_size);
+        for (int i = 0; i < nlevels; ++i) {
+            const double dx = (h_x_max[i] - 1.)/(adk_table_size - 1);
+            for (int j = 0; j < adk_table_size; ++j) {
+                h_adk_table[i*adk_table_size + j] = static_cast<Real>(adk_log_probability(i, 1. + j*dx));
+            }
+        }
+        adk_table.resize(h_adk_table.size());
+        Gpu::copyAsync(Gpu::hostToDevice, h_adk_table.begin(), h_adk_table.end(),
+                       adk_table.begin());
+    }
+
+    Gpu::synchronize();
+}
+
+bool
+PhysicalParticleContainer::getFieldAmplitudeBounds (const WarpXParIter& pti, const long offset,
+                                                    amrex::FArrayBox const& exfab,
+                                                    amrex::FArrayBox const& eyfab,
+                                                    amrex::FArrayBox const& ezfab,
+                                                    amrex::FArrayBox const& bxfab,
+                                                    amrex::FArrayBox const& byfab,
+                                                    amrex::FArrayBox const& bzfab,
+                                                    const amrex::Box& box,
+                                                    amrex::Real& e_max, amrex::Real& b_max) const
+{
+    // Fields defined by parsers are not bounded by the fields on the grid
+    if (!GetExternalEBField(pti, offset).isNoOp()) { return false; }
+
+    // With several azimuthal modes, the gathered fields are sums over the modes,
+    // which are not bounded by the maximum of each component
+    if (WarpX::n_rz_azimuthal_modes > 1) { return false; }
+
+    // The gathered fields are weighted averages of the fields on the grid,
+    // so that each component is bounded by its maximum on the gather box
+    e_max = 0._rt;
+    b_max = 0._rt;
+    if (!do_not_gather) {
+        const auto maxabs = [&box] (amrex::FArrayBox const& fab) {
+            const amrex::Box b = amrex::grow(amrex::convert(box, fab.box().ixType()), 1)
+                & fab.box();
+            return b.ok() ? fab.maxabs<amrex::RunOn::Device>(b, 0) : 0._rt;
+        };
+        const amrex::Real ex = maxabs(exfab), ey = maxabs(eyfab), ez = maxabs(ezfab);
+        const amrex::Real bx = maxabs(bxfab), by = maxabs(byfab), bz = maxabs(bzfab);
+        e_max = std::sqrt(ex*ex + ey*ey + ez*ez);
+        b_max = std::sqrt(bx*bx + by*by + bz*bz);
+    }
+    e_max += std::sqrt(m_E_external_particle[0]*m_E_external_particle[0] +
+                       m_E_external_particle[1]*m_E_external_particle[1] +
+                       m_E_external_particle[2]*m_E_external_particle[2]);
+    b_max += std::sqrt(m_B_external_particle[0]*m_B_external_particle[0] +
+                       m_B_external_particle[1]*m_B_external_particle[1] +
+                       m_B_external_particle[2]*m_B_external_particle[2]);
+    return true;
+}
+
+amrex::ParticleReal
+PhysicalParticleContainer::getMaxLorentzFactor (const WarpXParIter& pti, const long offset,
+                                                const long np) const
+{
+    if (np == 0) { return 1._prt; }
+
+    const auto& attribs = pti.GetAttribs();
+    const ParticleReal* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr() + offset;
+    const ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr() + offset;
+    const ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr() + offset;
+
+    amrex::ReduceOps<amrex::ReduceOpMax> reduce_op;
+    amrex::ReduceData<amrex::ParticleReal> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+    reduce_op.eval(np, reduce_data,
+        [=] AMREX_GPU_DEVICE (long ip) -> ReduceTuple
+        {
+            return {ux[ip]*ux[ip] + uy[ip]*uy[ip] + uz[ip]*uz[ip]};
+        });
+    const amrex::ParticleReal u2_max = amrex::get<0>(reduce_data.value());
+
+    constexpr amrex::ParticleReal inv_c2 = 1._prt/(PhysConst::c*PhysConst::c);
+    return std::sqrt(1._prt + u2_max*inv_c2);
 }
 
 IonizationFilterFunc
@@ -3400,11 +4362,44 @@ PhysicalParticleContainer::getIonizationFunc (const WarpXParIter& pti,
                                 adk_exp_prefactor.dataPtr(),
                                 adk_power.dataPtr(),
                                 adk_correction_factors.dataPtr(),
+                                adk_table.dataPtr(),
+                                adk_table_x_max.dataPtr(),
+                                adk_table_inv_dx.dataPtr(),
+                                adk_table_size,
                                 particle_icomps["ionizationLevel"],
                                 ion_atomic_number,
                                 do_adk_correction};
 }
 
+bool
+PhysicalParticleContainer::isIonizationNegligibleInTile (const WarpXParIter& pti,
+                                                         amrex::IntVect ngEB,
+                                                         const amrex::FArrayBox& Ex,
+                                                         const amrex::FArrayBox& Ey,
+                                                         const amrex::FArrayBox& Ez,
+                                                         const amrex::FArrayBox& Bx,
+                                                         const amrex::FArrayBox& By,
+                                                         const amrex::FArrayBox& Bz) const
+{
+    // Skipping the tiles also skips the random draws of their particles
+    if (!do_skip_weak_field_tiles) { return false; }
+
+    WARPX_PROFILE("PhysicalParticleContainer::isIonizationNegligibleInTile()");
+
+    amrex::Box box = pti.tilebox();
+    box.grow(ngEB);
+
+    amrex::Real e_max = 0._rt;
+    amrex::Real b_max = 0._rt;
+    if (!getFieldAmplitudeBounds(pti, 0, Ex, Ey, Ez, Bx, By, Bz, box, e_max, b_max)) {
+        return false;
+    }
+
+    // The field in the frame of a particle is bounded by gamma*(|E| + c|B|)
+    const amrex::ParticleReal gamma_max = getMaxLorentzFactor(pti, 0, pti.numParticles());
+    return gamma_max*(e_max + PhysConst::c*b_max) < ionization_field_threshold;
+}
+
 PlasmaInjector* PhysicalParticleContainer::GetPlasmaInjector (int i)
 {
     if (i < 0 || i >= static_cast<int>(plasma_injectors.size())) {
@@ -3427,17 +4422,33 @@ void PhysicalParticleContainer::resample (const int timestep, const bool verbose
 
     WARPX_PROFILE_VAR_START(blp_resample_synchronization);
     const amrex::Real global_numparts = TotalNumberOfParticles();
+    const bool global_trigger = m_resampler.triggered(timestep, global_numparts);
+    // Without a global trigger, only the tiles with too many particles per cell are resampled
+    bool tile_trigger = false;
+    if (!global_trigger && m_resampler.hasTileTrigger()) {
+        for (int lev = 0; lev <= maxLevel() && !tile_trigger; lev++) {
+            for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti) {
+                if (m_resampler.triggeredInTile(pti)) {
+                    tile_trigger = true;
+                    break;
+                }
+            }
+        }
+        amrex::ParallelDescriptor::ReduceBoolOr(tile_trigger);
+    }
     WARPX_PROFILE_VAR_STOP(blp_resample_synchronization);
 
     WARPX_PROFILE_VAR_START(blp_resample_actual);
-    if (m_resampler.triggered(timestep, global_numparts))
+    if (global_trigger || tile_trigger)
     {
         Redistribute();
         for (int lev = 0; lev <= maxLevel(); lev++)
         {
             for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
             {
-                m_resampler(pti, lev, this);
+                if (global_trigger || m_resampler.triggeredInTile(pti)) {
+                    m_resampler(pti, lev, this);
+                }
             }
         }
         deleteInvalidParticles();
@@ -3466,6 +4477,37 @@ bool PhysicalParticleContainer::has_breit_wheeler () const
     return m_do_qed_breit_wheeler;
 }
 
+bool
+PhysicalParticleContainer::isChiBelowMinimumInTile (WarpXParIter& pti,
+                                                    const long offset,
+                                                    const long np_to_push,
+                                                    amrex::FArrayBox const * exfab,
+                                                    amrex::FArrayBox const * eyfab,
+                                                    amrex::FArrayBox const * ezfab,
+                                                    amrex::FArrayBox const * bxfab,
+                                                    amrex::FArrayBox const * byfab,
+                                                    amrex::FArrayBox const * bzfab,
+                                                    const amrex::Box& box,
+                                                    const amrex::ParticleReal chi_min) const
+{
+    if (!WarpX::do_qed_chi_prefilter || np_to_push == 0) { return false; }
+
+    WARPX_PROFILE("PhysicalParticleContainer::isChiBelowMinimumInTile");
+
+    amrex::Real e_max = 0._rt;
+    amrex::Real b_max = 0._rt;
+    if (!getFieldAmplitudeBounds(pti, offset, *exfab, *eyfab, *ezfab, *bxfab, *byfab, *bzfab,
+                                 box, e_max, b_max)) {
+        return false;
+    }
+
+    // gamma >= |u|/c also bounds the normalized energy of photons
+    const amrex::ParticleReal gamma_max = getMaxLorentzFactor(pti, offset, np_to_push);
+
+    return QedUtils::chi_upper_bound(gamma_max, static_cast<amrex::ParticleReal>(e_max),
+                                     static_cast<amrex::ParticleReal>(b_max)) < chi_min;
+}
+
 void
 PhysicalParticleContainer::
 set_breit_wheeler_engine_ptr (const std::shared_ptr<BreitWheelerEngine>& ptr)
@@ -8,6 +8,7 @@
 
 #include "VelocityCoincidenceThinning.H"
 #include "LevelingThinning.H"
+#include "Particles/WarpXParticleContainer.H"
 #include "Utils/TextMsg.H"
 
 #include <AMReX.H>
@@ -38,6 +39,11 @@ bool Resampling::triggered (const int timestep, const amrex::Real global_numpart
     return m_resampling_trigger.triggered(timestep, global_numparts);
 }
 
+bool Resampling::triggeredInTile (const WarpXParIter& pti) const
+{
+    return m_resampling_trigger.triggeredInTile(pti.numParticles(), pti.tilebox().numPts());
+}
+
 void Resampling::operator() (WarpXParIter& pti, const int lev, WarpXParticleContainer * const pc) const
 {
     (*m_resampling_algorithm)(pti, lev, pc);
@@ -24,6 +24,9 @@ ResamplingTrigger::ResamplingTrigger (const std::string& species_name)
 
     utils::parser::queryWithParser(
         pp_species_name, "resampling_trigger_max_avg_ppc", m_max_avg_ppc);
+
+    utils::parser::queryWithParser(
+        pp_species_name, "resampling_trigger_max_tile_ppc", m_max_tile_ppc);
 }
 
 bool ResamplingTrigger::triggered (const int timestep, const amrex::Real global_numparts) const
@@ -9,6 +9,13 @@
 
 #include "VelocityCoincidenceThinning.H"
 
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_Scan.H>
+
+#include <limits>
+#include <utility>
+
 
 VelocityCoincidenceThinning::VelocityCoincidenceThinning (const std::string& species_name)
 {
@@ -84,12 +91,14 @@ void VelocityCoincidenceThinning::operator() (WarpXParIter& pti, const int lev,
     auto * const AMREX_RESTRICT w = soa.GetRealData(PIdx::w).data();
     auto * const AMREX_RESTRICT idcpu = soa.GetIdCPUData().data();
 
-    // Using this function means that we must loop over the cells in the ParallelFor.
+    // The particles are grouped by cell: the particles of the cell `c` are
+    // `indices[cell_offsets[c]:cell_offsets[c+1]]`
     auto bins = ParticleUtils::findParticlesInEachCell(lev, pti, ptile);
 
-    const auto n_cells = static_cast<int>(bins.numBins());
+    const auto np = static_cast<int>(n_parts_in_tile);
     auto *const indices = bins.permutationPtr();
     auto *const cell_offsets = bins.offsetsPtr();
+    auto *const particle_cell = bins.binsPtr();
 
     const auto min_ppc = m_min_ppc;
     const auto cluster_weight = m_cluster_weight;
@@ -101,13 +110,7 @@ void VelocityCoincidenceThinning::operator() (WarpXParIter& pti, const int lev,
         "VelocityCoincidenceThinning does not yet work for massless particles."
     );
 
-    // create a GPU vector to hold the momentum cluster index for each particle
-    amrex::Gpu::DeviceVector<int> momentum_bin_number(n_parts_in_tile);
-    auto* momentum_bin_number_data = momentum_bin_number.data();
-
-    // create a GPU vector to hold the index sorting for the momentum bins
-    amrex::Gpu::DeviceVector<int> sorted_indices(n_parts_in_tile);
-    auto* sorted_indices_data = sorted_indices.data();
+    if (np == 0) { return; }
 
     constexpr auto c2 = PhysConst::c * PhysConst::c;
 
@@ -153,174 +156,279 @@ void VelocityCoincidenceThinning::operator() (WarpXParIter& pti, const int lev,
             std::ceil((velocityBinCalculator.uy_max - velocityBinCalculator.uy_min) / m_delta_u[1])
         );
     }
-    auto heapSort = HeapSort();
-
-    // Loop over cells
-    amrex::ParallelForRNG( n_cells,
-        [=] AMREX_GPU_DEVICE (int i_cell, amrex::RandomEngine const& engine) noexcept
-        {
-            // The particles that are in the cell `i_cell` are
-            // given by the `indices[cell_start:cell_stop]`
-            const auto cell_start = static_cast<int>(cell_offsets[i_cell]);
-            const auto cell_stop  = static_cast<int>(cell_offsets[i_cell+1]);
-            const auto cell_numparts = cell_stop - cell_start;
-
-            // do nothing for cells with less particles than min_ppc
-            // (this intentionally includes skipping empty cells, too)
-            if (cell_numparts < min_ppc) {
-                return;
-            }
 
-            // Loop over particles and label them with the appropriate momentum bin
-            // number. Also assign initial ordering to the sorted_indices array.
-            velocityBinCalculator(
-                ux, uy, uz, indices, momentum_bin_number_data, sorted_indices_data,
-                cell_start, cell_stop
-            );
+    // In the sorted order, the particle at position `p` is `perm[p]`, in the cell
+    // `pos_cell[p]` and the velocity bin `pos_bin[p]`
+    amrex::Gpu::DeviceVector<int> perm(np), perm_tmp(np);
+    amrex::Gpu::DeviceVector<int> pos_bin(np), pos_bin_tmp(np);
+    amrex::Gpu::DeviceVector<int> pos_cell(np);
+    int* perm_data = perm.dataPtr();
+    int* pos_bin_data = pos_bin.dataPtr();
+    int* const pos_cell_data = pos_cell.dataPtr();
+
+    // label the particles with their velocity bin, starting from the cell ordering
+    int max_bin = 0;
+    {
+        amrex::ReduceOps<amrex::ReduceOpMax> reduce_op;
+        amrex::ReduceData<int> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        reduce_op.eval(np, reduce_data, [=] AMREX_GPU_DEVICE (int ip) -> ReduceTuple {
+            const auto part_idx = static_cast<int>(indices[ip]);
+            const int bin = velocityBinCalculator(ux[part_idx], uy[part_idx], uz[part_idx]);
+            perm_data[ip] = part_idx;
+            pos_bin_data[ip] = bin;
+            pos_cell_data[ip] = static_cast<int>(particle_cell[part_idx]);
+            return {bin};
+        });
+        max_bin = amrex::get<0>(reduce_data.value(reduce_op));
+    }
 
-            // sort indices based on comparing values in momentum_bin_number
-            heapSort(sorted_indices_data, momentum_bin_number_data, cell_start, cell_numparts);
+    // Segmented radix sort: sort the particles by velocity bin within each cell,
+    // with one stable split on each bit of the bin numbers. The cells stay in place,
+    // so that only the bits of the velocity bins need to be sorted.
+    amrex::Gpu::DeviceVector<int> zeros_before(np);
+    int* const zeros_before_data = zeros_before.dataPtr();
+    for (int bit = 0; bit < 31 && (max_bin >> bit) > 0; ++bit)
+    {
+        const int* const bin_in = pos_bin_data;
+        const int total_zeros = amrex::Scan::PrefixSum<int>(np,
+            [=] AMREX_GPU_DEVICE (int ip) -> int { return ((bin_in[ip] >> bit) & 1) == 0; },
+            [=] AMREX_GPU_DEVICE (int ip, int const& s) { zeros_before_data[ip] = s; },
+            amrex::Scan::Type::exclusive, amrex::Scan::retSum);
+
+        const int* const perm_in = perm_data;
+        int* const perm_out = perm_tmp.dataPtr();
+        int* const bin_out = pos_bin_tmp.dataPtr();
+        amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int ip)
+        {
+            const int cell = pos_cell_data[ip];
+            const auto cell_start = static_cast<int>(cell_offsets[cell]);
+            const auto cell_stop = static_cast<int>(cell_offsets[cell+1]);
+            const int zeros_start = zeros_before_data[cell_start];
+            const int zeros_stop = (cell_stop < np) ? zeros_before_data[cell_stop] : total_zeros;
+            const int zeros_in_cell_before = zeros_before_data[ip] - zeros_start;
+            const int dst = (((bin_in[ip] >> bit) & 1) == 0) ?
+                cell_start + zeros_in_cell_before :
+                cell_start + (zeros_stop - zeros_start) + (ip - cell_start - zeros_in_cell_before);
+            perm_out[dst] = perm_in[ip];
+            bin_out[dst] = bin_in[ip];
+        });
+
+        std::swap(perm, perm_tmp);
+        std::swap(pos_bin, pos_bin_tmp);
+        perm_data = perm.dataPtr();
+        pos_bin_data = pos_bin.dataPtr();
+    }
 
-            // initialize variables used to hold cluster totals
-            int particles_in_bin = 0;
-            amrex::ParticleReal total_weight = 0._prt, total_energy = 0._prt;
-#if !defined(WARPX_DIM_1D_Z)
-            amrex::ParticleReal cluster_x = 0._prt;
-#endif
-#if defined(WARPX_DIM_3D)
-            amrex::ParticleReal cluster_y = 0._prt;
-#endif
-            amrex::ParticleReal cluster_z = 0._prt;
-            amrex::ParticleReal cluster_ux = 0._prt, cluster_uy = 0._prt, cluster_uz = 0._prt;
+    // Split the velocity bins into clusters whose weight is about cluster_weight: the
+    // particle at position `p` is in the part `floor(W_p / cluster_weight)` of its bin,
+    // where W_p is the weight of the particles before it in the bin.
+    amrex::Gpu::DeviceVector<int> pos_part(np, 0);
+    int* const pos_part_data = pos_part.dataPtr();
+    if (cluster_weight < std::numeric_limits<amrex::ParticleReal>::max())
+    {
+        // prefix sum of the weights in the sorted order
+        amrex::Gpu::DeviceVector<double> weight_before(np);
+        double* const weight_before_data = weight_before.dataPtr();
+        amrex::Scan::PrefixSum<double>(np,
+            [=] AMREX_GPU_DEVICE (int ip) -> double { return w[perm_data[ip]]; },
+            [=] AMREX_GPU_DEVICE (int ip, double const& s) { weight_before_data[ip] = s; },
+            amrex::Scan::Type::exclusive, amrex::Scan::noRetSum);
+
+        // first position of the velocity bin of each position
+        amrex::Gpu::DeviceVector<int> bin_start(np);
+        int* const bin_start_data = bin_start.dataPtr();
+        amrex::Scan::PrefixSum<int>(np,
+            [=] AMREX_GPU_DEVICE (int ip) -> int {
+                return (ip == 0 || pos_cell_data[ip] != pos_cell_data[ip-1]
+                        || pos_bin_data[ip] != pos_bin_data[ip-1]);
+            },
+            [=] AMREX_GPU_DEVICE (int ip, int const& s) {
+                // the bin of the position ip is s-1
+                if (ip == 0 || pos_cell_data[ip] != pos_cell_data[ip-1]
+                    || pos_bin_data[ip] != pos_bin_data[ip-1]) {
+                    bin_start_data[s-1] = ip;
+                }
+                pos_part_data[ip] = s;
+            },
+            amrex::Scan::Type::inclusive, amrex::Scan::noRetSum);
 
-            // Finally, loop through the particles in the cell and merge
-            // ones in the same momentum bin
-            for (int i = cell_start; i < cell_stop; ++i)
-            {
-                particles_in_bin += 1;
-                const auto part_idx = indices[sorted_indices_data[i]];
+        amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int ip)
+        {
+            const int start = bin_start_data[pos_part_data[ip] - 1];
+            const double weight_in_bin = weight_before_data[ip] - weight_before_data[start];
+            pos_part_data[ip] = static_cast<int>(weight_in_bin / static_cast<double>(cluster_weight));
+        });
+    }
 
-#if !defined(WARPX_DIM_1D_Z)
-                cluster_x += w[part_idx]*x[part_idx];
-#endif
+    // Find the clusters: the cluster `k` is made of the positions
+    // `cluster_start[k]:cluster_start[k+1]`
+    amrex::Gpu::DeviceVector<int> cluster_start(np+1);
+    int* const cluster_start_data = cluster_start.dataPtr();
+    amrex::Gpu::DeviceVector<int> pos_cluster(np);
+    int* const pos_cluster_data = pos_cluster.dataPtr();
+    const int n_clusters = amrex::Scan::PrefixSum<int>(np,
+        [=] AMREX_GPU_DEVICE (int ip) -> int {
+            return (ip == 0 || pos_cell_data[ip] != pos_cell_data[ip-1]
+                    || pos_bin_data[ip] != pos_bin_data[ip-1]
+                    || pos_part_data[ip] != pos_part_data[ip-1]);
+        },
+        [=] AMREX_GPU_DEVICE (int ip, int const& s) {
+            const bool is_start = (ip == 0 || pos_cell_data[ip] != pos_cell_data[ip-1]
+                                   || pos_bin_data[ip] != pos_bin_data[ip-1]
+                                   || pos_part_data[ip] != pos_part_data[ip-1]);
+            if (is_start) { cluster_start_data[s] = ip; }
+            pos_cluster_data[ip] = is_start ? s : s - 1;
+            if (ip == np - 1) { cluster_start_data[s + (is_start ? 1 : 0)] = np; }
+        },
+        amrex::Scan::Type::exclusive, amrex::Scan::retSum);
+
+    // Segmented reduction: weighted sums of the positions, momenta and energies of the
+    // particles of each cluster
 #if defined(WARPX_DIM_3D)
-                cluster_y += w[part_idx]*y[part_idx];
+    constexpr int n_sums = 8;
+#elif defined(WARPX_DIM_1D_Z)
+    constexpr int n_sums = 6;
+#else
+    constexpr int n_sums = 7;
 #endif
-                cluster_z += w[part_idx]*z[part_idx];
-                cluster_ux += w[part_idx]*ux[part_idx];
-                cluster_uy += w[part_idx]*uy[part_idx];
-                cluster_uz += w[part_idx]*uz[part_idx];
-                total_weight += w[part_idx];
-                total_energy += w[part_idx] * Algorithms::KineticEnergy(
-                    ux[part_idx], uy[part_idx], uz[part_idx], mass
-                );
-
-                // check if this is the last particle in the current momentum bin,
-                // or if the next particle would push the current cluster weight
-                // to exceed the maximum specified cluster weight
-                if (
-                    (i == cell_stop - 1)
-                    || (momentum_bin_number_data[sorted_indices_data[i]] != momentum_bin_number_data[sorted_indices_data[i + 1]])
-                    || (total_weight + w[indices[sorted_indices_data[i+1]]] > cluster_weight)
-                ) {
-                    // check if the bin has more than 2 particles in it
-                    if ( particles_in_bin > 2 && total_weight > std::numeric_limits<amrex::ParticleReal>::min() ){
-                        // get average quantities for the bin
+    enum { i_w = 0, i_ux, i_uy, i_uz, i_energy, i_z, i_x, i_y };
+    amrex::Gpu::DeviceVector<amrex::ParticleReal> cluster_sums(n_clusters*n_sums, 0._prt);
+    amrex::ParticleReal* const sums = cluster_sums.dataPtr();
+    amrex::Gpu::DeviceVector<int> cluster_is_merged(n_clusters, 0);
+    int* const is_merged = cluster_is_merged.dataPtr();
+
+    amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int ip)
+    {
+        const int part_idx = perm_data[ip];
+        amrex::ParticleReal* const s = sums + pos_cluster_data[ip]*n_sums;
+        const amrex::ParticleReal wp = w[part_idx];
+        amrex::Gpu::Atomic::AddNoRet(&s[i_w], wp);
+        amrex::Gpu::Atomic::AddNoRet(&s[i_ux], wp*ux[part_idx]);
+        amrex::Gpu::Atomic::AddNoRet(&s[i_uy], wp*uy[part_idx]);
+        amrex::Gpu::Atomic::AddNoRet(&s[i_uz], wp*uz[part_idx]);
+        amrex::Gpu::Atomic::AddNoRet(&s[i_energy], wp*Algorithms::KineticEnergy(
+            ux[part_idx], uy[part_idx], uz[part_idx], mass));
+        amrex::Gpu::Atomic::AddNoRet(&s[i_z], wp*z[part_idx]);
 #if !defined(WARPX_DIM_1D_Z)
-                        cluster_x /= total_weight;
+        amrex::Gpu::Atomic::AddNoRet(&s[i_x], wp*x[part_idx]);
 #endif
 #if defined(WARPX_DIM_3D)
-                        cluster_y /= total_weight;
+        amrex::Gpu::Atomic::AddNoRet(&s[i_y], wp*y[part_idx]);
 #endif
-                        cluster_z /= total_weight;
-                        cluster_ux /= total_weight;
-                        cluster_uy /= total_weight;
-                        cluster_uz /= total_weight;
-
-                        // perform merging of momentum bin particles
-                        auto u_perp2 = cluster_ux*cluster_ux + cluster_uy*cluster_uy;
-                        auto u_perp = std::sqrt(u_perp2);
-                        auto cluster_u_mag2 = u_perp2 + cluster_uz*cluster_uz;
-                        auto cluster_u_mag = std::sqrt(cluster_u_mag2);
-
-                        // calculate required velocity magnitude to achieve
-                        // energy conservation
-                        auto v_mag2 = total_energy / total_weight * (
-                            (total_energy / total_weight + 2._prt * mass * c2 )
-                            / (mass * mass * c2)
-                        );
-                        auto v_perp = (v_mag2 > cluster_u_mag2) ? std::sqrt(v_mag2 - cluster_u_mag2) : 0_prt;
-
-                        // choose random angle for new velocity vector
-                        auto phi = amrex::Random(engine) * MathConst::pi;
-
-                        // set new velocity components based on chosen phi
-                        auto vx = v_perp * std::cos(phi);
-                        auto vy = v_perp * std::sin(phi);
-
-                        // calculate rotation angles to parallel coord. frame
-                        auto cos_theta = (cluster_u_mag > 0._prt) ? cluster_uz / cluster_u_mag : 0._prt;
-                        auto sin_theta = (cluster_u_mag > 0._prt) ? u_perp / cluster_u_mag : 0._prt;
-                        auto cos_phi = (u_perp > 0._prt) ? cluster_ux / u_perp : 0._prt;
-                        auto sin_phi = (u_perp > 0._prt) ? cluster_uy / u_perp : 0._prt;
-
-                        // rotate new velocity vector to labframe
-                        auto ux_new = (
-                            vx * cos_theta * cos_phi - vy * sin_phi
-                            + cluster_u_mag * sin_theta * cos_phi
-                        );
-                        auto uy_new = (
-                            vx * cos_theta * sin_phi + vy * cos_phi
-                            + cluster_u_mag * sin_theta * sin_phi
-                        );
-                        auto uz_new = -vx * sin_theta + cluster_u_mag * cos_theta;
-
-                        // set the last two particles' attributes according to
-                        // the bin's aggregate values
-                        const auto part_idx2 = indices[sorted_indices_data[i - 1]];
-
-                        w[part_idx] = total_weight / 2._prt;
-                        w[part_idx2] = total_weight / 2._prt;
+    });
+
+    // Merge the particles of each cluster into its last two particles
+    amrex::ParallelForRNG( n_clusters,
+        [=] AMREX_GPU_DEVICE (int k, amrex::RandomEngine const& engine) noexcept
+        {
+            const int start = cluster_start_data[k];
+            const int stop = cluster_start_data[k+1];
+            const int particles_in_bin = stop - start;
+
+            // do nothing for cells with less particles than min_ppc
+            const int cell = pos_cell_data[start];
+            if (static_cast<int>(cell_offsets[cell+1] - cell_offsets[cell]) < min_ppc) {
+                return;
+            }
+
+            const amrex::ParticleReal* const s = sums + k*n_sums;
+            const amrex::ParticleReal total_weight = s[i_w];
+            const amrex::ParticleReal total_energy = s[i_energy];
+
+            // check if the bin has more than 2 particles in it
+            if ( particles_in_bin <= 2 || total_weight <= std::numeric_limits<amrex::ParticleReal>::min() ) {
+                return;
+            }
+            is_merged[k] = 1;
+
+            // get average quantities for the bin
 #if !defined(WARPX_DIM_1D_Z)
-                        x[part_idx] = cluster_x;
-                        x[part_idx2] = cluster_x;
+            const amrex::ParticleReal cluster_x = s[i_x] / total_weight;
 #endif
 #if defined(WARPX_DIM_3D)
-                        y[part_idx] = cluster_y;
-                        y[part_idx2] = cluster_y;
+            const amrex::ParticleReal cluster_y = s[i_y] / total_weight;
 #endif
-                        z[part_idx] = cluster_z;
-                        z[part_idx2] = cluster_z;
-
-                        ux[part_idx] = ux_new;
-                        uy[part_idx] = uy_new;
-                        uz[part_idx] = uz_new;
-                        ux[part_idx2] = 2._prt * cluster_ux - ux_new;
-                        uy[part_idx2] = 2._prt * cluster_uy - uy_new;
-                        uz[part_idx2] = 2._prt * cluster_uz - uz_new;
-
-                        // set ids of merged particles so they will be removed
-                        for (int j = 2; j < particles_in_bin; ++j){
-                            idcpu[indices[sorted_indices_data[i - j]]] = amrex::ParticleIdCpus::Invalid;
-                        }
-                    }
-
-                    // restart the tallies
-                    particles_in_bin = 0;
-                    total_weight = 0._prt;
-                    total_energy = 0._prt;
+            const amrex::ParticleReal cluster_z = s[i_z] / total_weight;
+            const amrex::ParticleReal cluster_ux = s[i_ux] / total_weight;
+            const amrex::ParticleReal cluster_uy = s[i_uy] / total_weight;
+            const amrex::ParticleReal cluster_uz = s[i_uz] / total_weight;
+
+            // perform merging of momentum bin particles
+            auto u_perp2 = cluster_ux*cluster_ux + cluster_uy*cluster_uy;
+            auto u_perp = std::sqrt(u_perp2);
+            auto cluster_u_mag2 = u_perp2 + cluster_uz*cluster_uz;
+            auto cluster_u_mag = std::sqrt(cluster_u_mag2);
+
+            // calculate required velocity magnitude to achieve
+            // energy conservation
+            auto v_mag2 = total_energy / total_weight * (
+                (total_energy / total_weight + 2._prt * mass * c2 )
+                / (mass * mass * c2)
+            );
+            auto v_perp = (v_mag2 > cluster_u_mag2) ? std::sqrt(v_mag2 - cluster_u_mag2) : 0_prt;
+
+            // choose random angle for new velocity vector
+            auto phi = amrex::Random(engine) * MathConst::pi;
+
+            // set new velocity components based on chosen phi
+            auto vx = v_perp * std::cos(phi);
+            auto vy = v_perp * std::sin(phi);
+
+            // calculate rotation angles to parallel coord. frame
+            auto cos_theta = (cluster_u_mag > 0._prt) ? cluster_uz / cluster_u_mag : 0._prt;
+            auto sin_theta = (cluster_u_mag > 0._prt) ? u_perp / cluster_u_mag : 0._prt;
+            auto cos_phi = (u_perp > 0._prt) ? cluster_ux / u_perp : 0._prt;
+            auto sin_phi = (u_perp > 0._prt) ? cluster_uy / u_perp : 0._prt;
+
+            // rotate new velocity vector to labframe
+            auto ux_new = (
+                vx * cos_theta * cos_phi - vy * sin_phi
+                + cluster_u_mag * sin_theta * cos_phi
+            );
+            auto uy_new = (
+                vx * cos_theta * sin_phi + vy * cos_phi
+                + cluster_u_mag * sin_theta * sin_phi
+            );
+            auto uz_new = -vx * sin_theta + cluster_u_mag * cos_theta;
+
+            // set the last two particles' attributes according to
+            // the bin's aggregate values
+            const auto part_idx = perm_data[stop - 1];
+            const auto part_idx2 = perm_data[stop - 2];
+
+            w[part_idx] = total_weight / 2._prt;
+            w[part_idx2] = total_weight / 2._prt;
 #if !defined(WARPX_DIM_1D_Z)
-                    cluster_x = 0_prt;
+            x[part_idx] = cluster_x;
+            x[part_idx2] = cluster_x;
 #endif
 #if defined(WARPX_DIM_3D)
-                    cluster_y = 0_prt;
+            y[part_idx] = cluster_y;
+            y[part_idx2] = cluster_y;
 #endif
-                    cluster_z = 0_prt;
-                    cluster_ux = 0_prt;
-                    cluster_uy = 0_prt;
-                    cluster_uz = 0_prt;
-                }
-            }
+            z[part_idx] = cluster_z;
+            z[part_idx2] = cluster_z;
+
+            ux[part_idx] = ux_new;
+            uy[part_idx] = uy_new;
+            uz[part_idx] = uz_new;
+            ux[part_idx2] = 2._prt * cluster_ux - ux_new;
+            uy[part_idx2] = 2._prt * cluster_uy - uy_new;
+            uz[part_idx2] = 2._prt * cluster_uz - uz_new;
         }
     );
+
+    // set ids of merged particles so they will be removed
+    amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int ip)
+    {
+        const int k = pos_cluster_data[ip];
+        if (is_merged[k] && ip < cluster_start_data[k+1] - 2) {
+            idcpu[perm_data[ip]] = amrex::ParticleIdCpus::Invalid;
+        }
+    });
+
+    // Make sure that the temporary arrays are not destroyed before
+    // the GPU kernels finish running
+    amrex::Gpu::streamSynchronize();
 }
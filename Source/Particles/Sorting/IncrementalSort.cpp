@@ -0,0 +1,153 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "Particles/Sorting/SortingUtils.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/WarpXProfilerWrapper.H"
+
+#include <AMReX_Box.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_ParticleTransformation.H>
+#include <AMReX_ParticleUtil.H>
+#include <AMReX_Scan.H>
+
+#include <algorithm>
+
+using namespace amrex;
+
+/* \brief Sort the particles of each tile by bin, moving only the particles
+ *        that are not already in the index range of their bin
+ *
+ *  After a counting of the particles per bin, the particles of bin `b` should
+ *  occupy the index range [start[b], start[b]+count[b]). A particle that is
+ *  already in the range of its own bin stays where it is. The other particles
+ *  ("movers") leave a hole at their current index. Since the holes in the
+ *  range of bin `b` are exactly as many as the movers that belong to bin `b`,
+ *  each mover can be written into one of the holes of its bin, so that only
+ *  the movers are copied. When the particles were sorted at the previous
+ *  step, this is usually a small fraction of the particles.
+ *
+ * \param bin_size number of cells per bin in each direction
+ * \param morton_order whether the bins are ordered along a Morton curve
+ */
+void
+WarpXParticleContainer::SortParticlesIncrementally (amrex::IntVect bin_size, bool morton_order)
+{
+    WARPX_PROFILE("WarpXParticleContainer::SortParticlesIncrementally");
+
+    for (int lev = 0; lev <= finestLevel(); ++lev)
+    {
+        const Geometry& geom = Geom(lev);
+        const auto dxi = geom.InvCellSizeArray();
+        const auto plo = geom.ProbLoArray();
+        const auto domain = geom.Domain();
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            auto& ptile = ParticlesAt(lev, pti);
+            const int np = static_cast<int>(ptile.numParticles());
+            if (np == 0) { continue; }
+
+            const Box box = pti.tilebox();
+            const int nbins = numTilesInBox(box, true, bin_size);
+            const auto ptd = ptile.getConstParticleTileData();
+
+            // Rank of each bin along the Morton curve, or nullptr for the linear order
+            Gpu::DeviceVector<int> bin_rank;
+            const int* bin_rank_ptr = nullptr;
+            if (morton_order) {
+                IntVect nbins_dir;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    nbins_dir[idim] = std::max(1, box.length(idim)/bin_size[idim]);
+                }
+                mortonBinRanks(nbins_dir, bin_rank);
+                bin_rank_ptr = bin_rank.dataPtr();
+            }
+
+            // Find the bin of each particle, and count the particles per bin
+            Gpu::DeviceVector<int> bin(np);
+            Gpu::DeviceVector<int> bin_count(nbins, 0);
+            Gpu::DeviceVector<int> bin_start(nbins);
+            int* const AMREX_RESTRICT bin_ptr = bin.dataPtr();
+            int* const AMREX_RESTRICT bin_count_ptr = bin_count.dataPtr();
+            int* const AMREX_RESTRICT bin_start_ptr = bin_start.dataPtr();
+            amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int i)
+            {
+                IntVect iv = getParticleCell(ptd, i, plo, dxi, domain);
+                // Guard against round-off at the edge of the tile
+                iv.min(box.bigEnd());
+                iv.max(box.smallEnd());
+                Box tbx;
+                int b = getTileIndex(iv, box, true, bin_size, tbx);
+                if (bin_rank_ptr) { b = bin_rank_ptr[b]; }
+                bin_ptr[i] = b;
+                Gpu::Atomic::AddNoRet(&bin_count_ptr[b], 1);
+            });
+            Scan::ExclusiveSum(nbins, bin_count_ptr, bin_start_ptr, Scan::noRetSum);
+
+            // Find the particles that are outside the index range of their bin,
+            // and store their indices in increasing order
+            Gpu::DeviceVector<int> mover_index(np);
+            int* const AMREX_RESTRICT mover_index_ptr = mover_index.dataPtr();
+            const int n_movers = Scan::PrefixSum<int>(np,
+                [=] AMREX_GPU_DEVICE (int i) -> int {
+                    const int b = bin_ptr[i];
+                    return (i < bin_start_ptr[b] || i >= bin_start_ptr[b] + bin_count_ptr[b]);
+                },
+                [=] AMREX_GPU_DEVICE (int i, int const& s) {
+                    const int b = bin_ptr[i];
+                    if (i < bin_start_ptr[b] || i >= bin_start_ptr[b] + bin_count_ptr[b]) {
+                        mover_index_ptr[s] = i;
+                    }
+                },
+                Scan::Type::exclusive, Scan::retSum);
+
+            // The tile is still sorted
+            if (n_movers == 0) { continue; }
+
+            // The holes left by the movers are ordered by bin, and the holes
+            // of bin `b` start at the index `mover_start[b]` in `mover_index`
+            Gpu::DeviceVector<int> mover_count(nbins, 0);
+            Gpu::DeviceVector<int> mover_start(nbins);
+            int* const AMREX_RESTRICT mover_count_ptr = mover_count.dataPtr();
+            int* const AMREX_RESTRICT mover_start_ptr = mover_start.dataPtr();
+            amrex::ParallelFor(n_movers, [=] AMREX_GPU_DEVICE (int k)
+            {
+                Gpu::Atomic::AddNoRet(&mover_count_ptr[bin_ptr[mover_index_ptr[k]]], 1);
+            });
+            Scan::ExclusiveSum(nbins, mover_count_ptr, mover_start_ptr, Scan::noRetSum);
+
+            // Assign each mover to one of the holes of its bin
+            Gpu::DeviceVector<int> dst_index(n_movers);
+            int* const AMREX_RESTRICT dst_index_ptr = dst_index.dataPtr();
+            amrex::ParallelFor(n_movers, [=] AMREX_GPU_DEVICE (int k)
+            {
+                const int b = bin_ptr[mover_index_ptr[k]];
+                const int slot = Gpu::Atomic::Add(&mover_start_ptr[b], 1);
+                dst_index_ptr[k] = mover_index_ptr[slot];
+            });
+
+            // Copy the movers to a temporary tile, and write them back into the holes
+            ParticleTileType ptile_tmp;
+            ptile_tmp.define(NumRuntimeRealComps(), NumRuntimeIntComps());
+            ptile_tmp.resize(n_movers);
+            amrex::gatherParticles(ptile_tmp, ptile, n_movers, mover_index_ptr);
+            amrex::scatterParticles(ptile, ptile_tmp, n_movers, dst_index_ptr);
+
+            // Make sure that the temporary arrays are not destroyed before
+            // the GPU kernels finish running
+            Gpu::streamSynchronize();
+        }
+    }
+}
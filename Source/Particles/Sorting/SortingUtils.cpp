@@ -8,6 +8,10 @@
 
 #include "SortingUtils.H"
 
+#include <AMReX_Scan.H>
+
+#include <algorithm>
+
 void fillWithConsecutiveIntegers( amrex::Gpu::DeviceVector<int>& v )
 {
 #ifdef AMREX_USE_GPU
@@ -20,3 +24,46 @@ void fillWithConsecutiveIntegers( amrex::Gpu::DeviceVector<int>& v )
     std::iota( v.begin(), v.end(), 0L );
 #endif
 }
+
+void mortonBinRanks( amrex::IntVect const& nbins, amrex::Gpu::DeviceVector<int>& rank )
+{
+    // number of bits of the bin coordinates in each direction
+    amrex::IntVect nbits(0);
+    int total_bits = 0;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        while ((1 << nbits[idim]) < nbins[idim]) { ++nbits[idim]; }
+        total_bits += nbits[idim];
+    }
+    int max_bits = 0;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) { max_bits = std::max(max_bits, nbits[idim]); }
+
+    rank.resize(AMREX_D_TERM(nbins[0], *nbins[1], *nbins[2]));
+    int* const AMREX_RESTRICT rank_ptr = rank.dataPtr();
+
+    // Loop over the Morton codes, and number the codes of the bins of the tile
+    const int ncodes = 1 << total_bits;
+    auto bin_of_code = [=] AMREX_GPU_HOST_DEVICE (int code) -> int
+    {
+        amrex::IntVect iv(0);
+        int pos = 0;
+        for (int bit = 0; bit < max_bits; ++bit) {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                if (bit < nbits[idim]) {
+                    iv[idim] |= ((code >> pos) & 1) << bit;
+                    ++pos;
+                }
+            }
+        }
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (iv[idim] >= nbins[idim]) { return -1; }
+        }
+        return AMREX_D_TERM(iv[0], + nbins[0]*iv[1], + nbins[0]*nbins[1]*iv[2]);
+    };
+    amrex::Scan::PrefixSum<int>(ncodes,
+        [=] AMREX_GPU_DEVICE (int code) -> int { return bin_of_code(code) >= 0; },
+        [=] AMREX_GPU_DEVICE (int code, int const& s) {
+            const int b = bin_of_code(code);
+            if (b >= 0) { rank_ptr[b] = s; }
+        },
+        amrex::Scan::Type::exclusive, amrex::Scan::noRetSum);
+}
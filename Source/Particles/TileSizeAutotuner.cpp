@@ -0,0 +1,107 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "TileSizeAutotuner.H"
+
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/Parser/ParserUtils.H"
+#include "Utils/TextMsg.H"
+
+#include <AMReX_GpuControl.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+TileSizeAutotuner::TileSizeAutotuner ()
+{
+    const amrex::ParmParse pp_particles("particles");
+    pp_particles.query("tile_size_autotune", m_enabled);
+    if (!m_enabled) { return; }
+
+    utils::parser::queryWithParser(
+        pp_particles, "tile_size_autotune_steps", m_steps_per_candidate);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_steps_per_candidate >= 1,
+        "particles.tile_size_autotune_steps must be at least 1");
+    utils::parser::queryArrWithParser(
+        pp_particles, "tile_size_autotune_factors", m_factors);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_factors.empty() &&
+        std::all_of(m_factors.begin(), m_factors.end(), [](amrex::Real f){ return f > 0; }),
+        "particles.tile_size_autotune_factors must be positive");
+
+    // Without tiling (e.g. on GPU), the tile size is not used
+    m_enabled = WarpXParticleContainer::do_tiling && amrex::Gpu::notInLaunchRegion();
+    m_start_round = m_enabled;
+}
+
+void TileSizeAutotuner::beginStep (MultiParticleContainer& mypc, const int verbose)
+{
+    if (m_start_round) {
+        // Candidates around the current tile size
+        const amrex::IntVect base = WarpXParticleContainer::tile_size;
+        m_candidates.clear();
+        for (const auto factor : m_factors) {
+            amrex::IntVect candidate;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                candidate[idim] = std::max(1, static_cast<int>(std::lround(base[idim]*factor)));
+            }
+            if (std::find(m_candidates.begin(), m_candidates.end(), candidate) == m_candidates.end()) {
+                m_candidates.push_back(candidate);
+            }
+        }
+        m_times.assign(m_candidates.size(), amrex::Real(0));
+        m_candidate = 0;
+        m_step_count = 0;
+        m_start_round = false;
+        m_is_tuning = m_candidates.size() > 1;
+        if (m_is_tuning) { setTileSize(m_candidates[0], mypc); }
+        return;
+    }
+
+    if (!m_is_tuning || m_step_count < m_steps_per_candidate) { return; }
+
+    // All the steps of the candidate are done
+    amrex::ParallelDescriptor::ReduceRealMax(m_times[m_candidate]);
+    m_step_count = 0;
+    ++m_candidate;
+    if (m_candidate < static_cast<int>(m_candidates.size())) {
+        setTileSize(m_candidates[m_candidate], mypc);
+        return;
+    }
+
+    // End of the round: keep the fastest tile size
+    m_is_tuning = false;
+    const auto best = static_cast<int>(
+        std::min_element(m_times.begin(), m_times.end()) - m_times.begin());
+    setTileSize(m_candidates[best], mypc);
+    if (verbose) {
+        std::stringstream ss;
+        ss << "Particle tile size autotuning selected " << m_candidates[best]
+           << " (" << m_times[best]/m_steps_per_candidate << " s per step)";
+        amrex::Print() << Utils::TextMsg::Info(ss.str());
+    }
+}
+
+void TileSizeAutotuner::endStep (const amrex::Real step_time)
+{
+    if (!m_is_tuning) { return; }
+    m_times[m_candidate] += step_time;
+    ++m_step_count;
+}
+
+void TileSizeAutotuner::setTileSize (const amrex::IntVect& tile_size,
+                                     MultiParticleContainer& mypc) const
+{
+    if (tile_size == WarpXParticleContainer::tile_size) { return; }
+    WarpXParticleContainer::tile_size = tile_size;
+    // Move the particles to the tiles of the new size
+    mypc.Redistribute();
+    mypc.defineAllParticleTiles();
+}
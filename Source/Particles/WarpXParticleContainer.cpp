@@ -16,6 +16,8 @@
 #include "Pusher/GetAndSetPosition.H"
 #include "Pusher/UpdatePosition.H"
 #include "ParticleBoundaries_K.H"
+#include "ParticleTileBatch.H"
+#include "Utils/PhaseTimers.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
@@ -59,6 +61,7 @@
 #include <AMReX_ParticleTransformation.H>
 #include <AMReX_ParticleUtil.H>
 #include <AMReX_Random.H>
+#include <AMReX_Reduce.H>
 #include <AMReX_Utility.H>
 #ifdef AMREX_USE_EB
 #   include "EmbeddedBoundary/ParticleBoundaryProcess.H"
@@ -74,6 +77,79 @@
 
 using namespace amrex;
 
+namespace
+{
+    /** Data of a tile for the batched position push */
+    struct PushXTileData
+    {
+        GetParticlePosition<PIdx> get_position;
+        SetParticlePosition<PIdx> set_position;
+        ParticleReal* ux;
+        ParticleReal* uy;
+        ParticleReal* uz;
+    };
+
+    /** Data of a tile for the batched boundary conditions */
+    struct BoundaryTileData
+    {
+        GetParticlePosition<PIdx> get_position;
+        SetParticlePosition<PIdx> set_position;
+        uint64_t* idcpu;
+        ParticleReal* ux;
+        ParticleReal* uy;
+        ParticleReal* uz;
+    };
+
+    /** Boundary conditions of the particle i of a tile */
+    struct ApplyBoundariesToParticle
+    {
+#ifndef WARPX_DIM_1D_Z
+        Real xmin, xmax;
+#endif
+#ifdef WARPX_DIM_3D
+        Real ymin, ymax;
+#endif
+        Real zmin, zmax;
+        ParticleBoundaries::ParticleBoundariesData boundary_conditions;
+
+        AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+        void operator() (BoundaryTileData const& tile, long i,
+                         amrex::RandomEngine const& engine) const noexcept
+        {
+            // skip particles that are already flagged for removal
+            auto pidw = amrex::ParticleIDWrapper{tile.idcpu[i]};
+            if (!pidw.is_valid()) { return; }
+
+            ParticleReal x, y, z;
+            tile.get_position.AsStored(i, x, y, z);
+            // Note that for RZ, (x, y, z) is actually (r, theta, z).
+
+            bool particle_lost = false;
+            ApplyParticleBoundaries::apply_boundaries(
+#ifndef WARPX_DIM_1D_Z
+                                                      x, xmin, xmax,
+#endif
+#if (defined WARPX_DIM_3D) || (defined WARPX_DIM_RZ)
+                                                      y,
+#endif
+#if (defined WARPX_DIM_3D)
+                                                      ymin, ymax,
+#endif
+                                                      z, zmin, zmax,
+                                                      tile.ux[i], tile.uy[i], tile.uz[i], particle_lost,
+                                                      boundary_conditions, engine);
+
+            if (particle_lost) {
+                pidw.make_invalid();
+            } else {
+                tile.set_position.AsStored(i, x, y, z);
+            }
+        }
+    };
+}
+
+int WarpXParticleContainer::omp_task_chunk_size = 0;
+
 WarpXParIter::WarpXParIter (ContainerType& pc, int level)
     : amrex::ParIterSoA<PIdx::nattribs, 0>(pc, level,
              MFItInfo().SetDynamic(WarpX::do_dynamic_scheduling))
@@ -115,9 +191,15 @@ WarpXParticleContainer::WarpXParticleContainer (AmrCore* amr_core, int ispecies)
 #endif
 
     local_rho.resize(num_threads);
-    local_jx.resize(num_threads);
-    local_jy.resize(num_threads);
-    local_jz.resize(num_threads);
+#ifdef AMREX_USE_GPU
+    // On GPU, the current buffers are only used with mixed precision, one per stream
+    const int num_buffers = deposition_mixed_precision ? amrex::Gpu::numGpuStreams() : 1;
+#else
+    const int num_buffers = num_threads;
+#endif
+    local_jx.resize(num_buffers);
+    local_jy.resize(num_buffers);
+    local_jz.resize(num_buffers);
 
     // The boundary conditions are read in in ReadBCParams but a child class
     // can allow these value to be overwritten if different boundary
@@ -144,6 +226,9 @@ WarpXParticleContainer::ReadParameters ()
     {
         const ParmParse pp_particles("particles");
         pp_particles.query("do_tiling", do_tiling);
+        pp_particles.query("omp_task_chunk_size", omp_task_chunk_size);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(omp_task_chunk_size >= 0,
+            "particles.omp_task_chunk_size must be non-negative");
         initialized = true;
     }
 }
@@ -157,6 +242,30 @@ WarpXParticleContainer::AllocData ()
     resizeData();
 }
 
+namespace
+{
+    /** Range [ibegin, iend) of the n particles added by AddNParticles that are created
+     *  by this MPI rank (all of them if uniqueparticles, otherwise an even share) */
+    void GetLocalParticleRange (long n, int uniqueparticles, long& ibegin, long& iend)
+    {
+        ibegin = 0;
+        iend = n;
+        if (!uniqueparticles) {
+            const int myproc = amrex::ParallelDescriptor::MyProc();
+            const int nprocs = amrex::ParallelDescriptor::NProcs();
+            const auto navg = n/nprocs;
+            const auto nleft = n - navg * nprocs;
+            if (myproc < nleft) {
+                ibegin = myproc*(navg+1);
+                iend = ibegin + navg+1;
+            } else {
+                ibegin = myproc*navg + nleft;
+                iend = ibegin + navg;
+            }
+        }
+    }
+}
+
 void
 WarpXParticleContainer::AddNParticles (int /*lev*/, long n,
                                        amrex::Vector<amrex::ParticleReal> const & x,
@@ -180,19 +289,7 @@ WarpXParticleContainer::AddNParticles (int /*lev*/, long n,
 
     long ibegin = 0;
     long iend = n;
-    if (!uniqueparticles) {
-        const int myproc = amrex::ParallelDescriptor::MyProc();
-        const int nprocs = amrex::ParallelDescriptor::NProcs();
-        const auto navg = n/nprocs;
-        const auto nleft = n - navg * nprocs;
-        if (myproc < nleft) {
-            ibegin = myproc*(navg+1);
-            iend = ibegin + navg+1;
-        } else {
-            ibegin = myproc*navg + nleft;
-            iend = ibegin + navg;
-        }
-    }
+    GetLocalParticleRange(n, uniqueparticles, ibegin, iend);
 
     //  Add to grid 0 and tile 0
     // Redistribute() will move them to proper places.
@@ -301,7 +398,130 @@ WarpXParticleContainer::AddNParticles (int /*lev*/, long n,
     // Remove particles that are inside the embedded boundaries
 #ifdef AMREX_USE_EB
     auto & distance_to_eb = WarpX::GetInstance().GetDistanceToEB();
-    scrapeParticlesAtEB( *this, amrex::GetVecOfConstPtrs(distance_to_eb), ParticleBoundaryProcess::Absorb());
+    scrapeParticlesAtEB( *this, amrex::GetVecOfConstPtrs(distance_to_eb),
+                         WarpX::GetInstance().GetNearEBBoxes(), ParticleBoundaryProcess::Absorb());
+    deleteInvalidParticles();
+#endif
+}
+
+void
+WarpXParticleContainer::AddNParticlesDevice (int /*lev*/, long n,
+                                             amrex::ParticleReal const* x,
+                                             amrex::ParticleReal const* y,
+                                             amrex::ParticleReal const* z,
+                                             amrex::ParticleReal const* ux,
+                                             amrex::ParticleReal const* uy,
+                                             amrex::ParticleReal const* uz,
+                                             const int nattr_real,
+                                             amrex::Vector<amrex::ParticleReal const*> const & attr_real,
+                                             const int nattr_int,
+                                             amrex::Vector<int const*> const & attr_int,
+                                             int uniqueparticles, amrex::Long id)
+{
+    using namespace amrex::literals;
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE((PIdx::nattribs + nattr_real - 1) <= NumRealComps(),
+                                     "Too many real attributes specified");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(nattr_int <= NumIntComps(),
+                                     "Too many integer attributes specified");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(nattr_real >= 1 &&
+                                     static_cast<int>(attr_real.size()) >= nattr_real &&
+                                     static_cast<int>(attr_int.size()) >= nattr_int,
+                                     "AddNParticlesDevice: missing attribute arrays");
+
+    long ibegin = 0;
+    long iend = n;
+    GetLocalParticleRange(n, uniqueparticles, ibegin, iend);
+    const long np = iend - ibegin;
+
+    if (np > 0)
+    {
+        //  Add to grid 0 and tile 0
+        // Redistribute() will move them to proper places.
+        auto& particle_tile = DefineAndReturnParticleTile(0, 0, 0);
+        const auto old_np = static_cast<long>(particle_tile.numParticles());
+        particle_tile.resize(old_np + np);
+
+        amrex::Long pid = id;
+        if (id == -1) {
+            pid = ParticleType::NextID();
+            ParticleType::NextID(pid + np);
+        }
+        const bool same_id = (id != -1);
+        const int myproc = amrex::ParallelDescriptor::MyProc();
+
+        const auto ptd = particle_tile.getParticleTileData();
+        amrex::ParticleReal const* AMREX_RESTRICT w = attr_real[0];
+#if !defined(WARPX_DIM_3D) && !defined(WARPX_DIM_RZ)
+        amrex::ignore_unused(y);
+#endif
+#if defined(WARPX_DIM_1D_Z)
+        amrex::ignore_unused(x);
+#endif
+        amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long i) noexcept
+        {
+            const long is = ibegin + i;
+            const long ip = old_np + i;
+
+            ptd.m_idcpu[ip] = amrex::SetParticleIDandCPU(same_id ? pid : pid + i, myproc);
+
+#if defined(WARPX_DIM_3D)
+            ptd.m_rdata[PIdx::x][ip] = x[is];
+            ptd.m_rdata[PIdx::y][ip] = y[is];
+#elif defined(WARPX_DIM_RZ)
+            ptd.m_rdata[PIdx::x][ip] = std::sqrt(x[is]*x[is] + y[is]*y[is]);
+            ptd.m_rdata[PIdx::theta][ip] = std::atan2(y[is], x[is]);
+#elif defined(WARPX_DIM_XZ)
+            ptd.m_rdata[PIdx::x][ip] = x[is];
+#endif
+            ptd.m_rdata[PIdx::z][ip] = z[is];
+            ptd.m_rdata[PIdx::w][ip] = w[is];
+            ptd.m_rdata[PIdx::ux][ip] = ux[is];
+            ptd.m_rdata[PIdx::uy][ip] = uy[is];
+            ptd.m_rdata[PIdx::uz][ip] = uz[is];
+
+            for (int comp = PIdx::uz+1; comp < PIdx::nattribs; ++comp)
+            {
+#ifdef WARPX_DIM_RZ
+                if (comp == PIdx::theta) { continue; }
+#endif
+                ptd.m_rdata[comp][ip] = 0.0_prt;
+            }
+        });
+
+        // Initialize nattr_real - 1 runtime real attributes from the attr_real arrays
+        auto& soa = particle_tile.GetStructOfArrays();
+        for (int j = PIdx::nattribs; j < PIdx::nattribs + nattr_real - 1; ++j)
+        {
+            amrex::ParticleReal const* src = attr_real[j - PIdx::nattribs + 1];
+            amrex::Gpu::copyAsync(amrex::Gpu::deviceToDevice, src + ibegin, src + iend,
+                                  soa.GetRealData(j).begin() + old_np);
+        }
+
+        // Initialize nattr_int runtime integer attributes from the attr_int arrays
+        for (int j = 0; j < nattr_int; ++j)
+        {
+            int const* src = attr_int[j];
+            amrex::Gpu::copyAsync(amrex::Gpu::deviceToDevice, src + ibegin, src + iend,
+                                  soa.GetIntData(j).begin() + old_np);
+        }
+
+        // Default initialize the other real and integer runtime attributes
+        DefaultInitializeRuntimeAttributes(particle_tile, nattr_real - 1, nattr_int,
+                                           static_cast<int>(old_np), static_cast<int>(old_np + np));
+
+        // the input arrays are owned by the caller
+        amrex::Gpu::streamSynchronize();
+    }
+
+    // Move particles to their appropriate tiles
+    Redistribute();
+
+    // Remove particles that are inside the embedded boundaries
+#ifdef AMREX_USE_EB
+    auto & distance_to_eb = WarpX::GetInstance().GetDistanceToEB();
+    scrapeParticlesAtEB( *this, amrex::GetVecOfConstPtrs(distance_to_eb),
+                         WarpX::GetInstance().GetNearEBBoxes(), ParticleBoundaryProcess::Absorb());
     deleteInvalidParticles();
 #endif
 }
@@ -315,7 +535,17 @@ WarpXParticleContainer::deleteInvalidParticles () {
 #endif
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti) {
             ParticleTileType& ptile = ParticlesAt(lev, pti);
-            removeInvalidParticles( ptile );
+
+            // Usually only a few tiles contain invalid particles (e.g. particles
+            // scraped at the embedded boundary): only the idcpu array is read to
+            // check this, instead of compacting every component of every tile
+            const uint64_t* const AMREX_RESTRICT idcpu =
+                ptile.GetStructOfArrays().GetIdCPUData().data();
+            const bool has_invalid = amrex::Reduce::AnyOf(ptile.numParticles(), idcpu,
+                [=] AMREX_GPU_DEVICE (uint64_t const& id) noexcept
+                { return !amrex::ConstParticleIDWrapper{id}.is_valid(); });
+
+            if (has_invalid) { removeInvalidParticles( ptile ); }
         }
     }
 }
@@ -351,6 +581,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                                         int const thread_num, const int lev, int const depos_lev,
                                         amrex::Real const dt, amrex::Real const relative_time, PushType push_type)
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::CurrentDeposition);
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE((depos_lev==(lev-1)) ||
                                      (depos_lev==(lev  )),
                                      "Deposition buffers only work for lev-1");
@@ -420,28 +651,29 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
         tilebox = amrex::coarsen(pti.tilebox(),ref_ratio);
     }
 
-#ifndef AMREX_USE_GPU
     // Staggered tile boxes (different in each direction)
     Box tbx = convert( tilebox, jx->ixType().toIntVect() );
     Box tby = convert( tilebox, jy->ixType().toIntVect() );
     Box tbz = convert( tilebox, jz->ixType().toIntVect() );
-#endif
+    tbx.grow(ng_J);
+    tby.grow(ng_J);
+    tbz.grow(ng_J);
 
     tilebox.grow(ng_J);
 
 #ifdef AMREX_USE_GPU
     amrex::ignore_unused(thread_num);
-    // GPU, no tiling: j<xyz>_arr point to the full j<xyz> arrays
-    auto & jx_fab = jx->get(pti);
-    auto & jy_fab = jy->get(pti);
-    auto & jz_fab = jz->get(pti);
-    Array4<Real> const& jx_arr = jx->array(pti);
-    Array4<Real> const& jy_arr = jy->array(pti);
-    Array4<Real> const& jz_arr = jz->array(pti);
+    // GPU, no tiling: j<xyz>_arr point to the full j<xyz> arrays, or, with mixed
+    // precision, to the buffers of the current stream (see DepositionReal)
+    [[maybe_unused]] const int i_buffer = deposition_mixed_precision ?
+        amrex::Gpu::Device::streamIndex() : 0;
+    auto & jx_fab = depositionBuffer(jx->get(pti), tbx, local_jx[i_buffer]);
+    auto & jy_fab = depositionBuffer(jy->get(pti), tby, local_jy[i_buffer]);
+    auto & jz_fab = depositionBuffer(jz->get(pti), tbz, local_jz[i_buffer]);
+    Array4<DepositionReal> const& jx_arr = jx_fab.array();
+    Array4<DepositionReal> const& jy_arr = jy_fab.array();
+    Array4<DepositionReal> const& jz_arr = jz_fab.array();
 #else
-    tbx.grow(ng_J);
-    tby.grow(ng_J);
-    tbz.grow(ng_J);
 
     // CPU, tiling: j<xyz>_arr point to the local_j<xyz>[thread_num] arrays
     local_jx[thread_num].resize(tbx, jx->nComp());
@@ -456,9 +688,9 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
     auto & jx_fab = local_jx[thread_num];
     auto & jy_fab = local_jy[thread_num];
     auto & jz_fab = local_jz[thread_num];
-    Array4<Real> const& jx_arr = local_jx[thread_num].array();
-    Array4<Real> const& jy_arr = local_jy[thread_num].array();
-    Array4<Real> const& jz_arr = local_jz[thread_num].array();
+    Array4<DepositionReal> const& jx_arr = local_jx[thread_num].array();
+    Array4<DepositionReal> const& jy_arr = local_jy[thread_num].array();
+    Array4<DepositionReal> const& jz_arr = local_jz[thread_num].array();
 #endif
 
     const auto GetPosition = GetParticlePosition<PIdx>(pti, offset);
@@ -530,7 +762,40 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
             amrex::Abort("Cannot do shared memory deposition with implicit algorithm");
         }
         if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Esirkepov) {
-            WARPX_ABORT_WITH_MESSAGE("Cannot do shared memory deposition with Esirkepov algorithm");
+            // the bins index all the particles of the tile
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(offset == 0 && np_to_deposit == pti.numParticles(),
+                "Shared memory Esirkepov deposition requires to deposit all the particles of a tile");
+            WARPX_PROFILE_VAR_START(esirkepov_current_dep_kernel);
+            if (WarpX::nox == 1){
+                doEsirkepovDepositionSharedShapeN<1>(
+                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                        jx_fab, jy_fab, jz_fab, np_to_deposit, dt, relative_time, dx,
+                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                        bins, box, geom, max_tbox_size);
+            } else if (WarpX::nox == 2){
+                doEsirkepovDepositionSharedShapeN<2>(
+                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                        jx_fab, jy_fab, jz_fab, np_to_deposit, dt, relative_time, dx,
+                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                        bins, box, geom, max_tbox_size);
+            } else if (WarpX::nox == 3){
+                doEsirkepovDepositionSharedShapeN<3>(
+                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                        jx_fab, jy_fab, jz_fab, np_to_deposit, dt, relative_time, dx,
+                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                        bins, box, geom, max_tbox_size);
+            } else if (WarpX::nox == 4){
+                doEsirkepovDepositionSharedShapeN<4>(
+                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                        jx_fab, jy_fab, jz_fab, np_to_deposit, dt, relative_time, dx,
+                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                        bins, box, geom, max_tbox_size);
+            }
+            WARPX_PROFILE_VAR_STOP(esirkepov_current_dep_kernel);
         }
         else if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Villasenor) {
             WARPX_ABORT_WITH_MESSAGE("Cannot do shared memory deposition with Villasenor algorithm");
@@ -538,6 +803,9 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
         else if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Vay) {
             WARPX_ABORT_WITH_MESSAGE("Cannot do shared memory deposition with Vay algorithm");
         }
+        else if (WarpX::current_deposition_algo == CurrentDepositionAlgo::DirectBlocked) {
+            WARPX_ABORT_WITH_MESSAGE("Cannot do shared memory deposition with blocked direct algorithm");
+        }
         else {
             WARPX_PROFILE_VAR_START(direct_current_dep_kernel);
             if        (WarpX::nox == 1){
@@ -602,28 +870,26 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                         WarpX::n_rz_azimuthal_modes);
                 }
             } else if (push_type == PushType::Implicit) {
+                const auto step_start = GetImplicitStepStart(pti, offset, np_to_deposit);
 #if (AMREX_SPACEDIM >= 2)
-                auto& xp_n = pti.GetAttribs(particle_comps["x_n"]);
-                const ParticleReal* xp_n_data = xp_n.dataPtr() + offset;
+                const ParticleReal* xp_n_data = step_start[ImplicitIdx::dx_n].dataPtr();
 #else
                 const ParticleReal* xp_n_data = nullptr;
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-                auto& yp_n = pti.GetAttribs(particle_comps["y_n"]);
-                const ParticleReal* yp_n_data = yp_n.dataPtr() + offset;
+                const ParticleReal* yp_n_data = step_start[ImplicitIdx::dy_n].dataPtr();
 #else
                 const ParticleReal* yp_n_data = nullptr;
 #endif
-                auto& zp_n = pti.GetAttribs(particle_comps["z_n"]);
-                const ParticleReal* zp_n_data = zp_n.dataPtr() + offset;
-                auto& uxp_n = pti.GetAttribs(particle_comps["ux_n"]);
-                auto& uyp_n = pti.GetAttribs(particle_comps["uy_n"]);
-                auto& uzp_n = pti.GetAttribs(particle_comps["uz_n"]);
+                const ParticleReal* zp_n_data = step_start[ImplicitIdx::dz_n].dataPtr();
+                const ParticleReal* uxp_n_data = step_start[ImplicitIdx::dux_n].dataPtr();
+                const ParticleReal* uyp_n_data = step_start[ImplicitIdx::duy_n].dataPtr();
+                const ParticleReal* uzp_n_data = step_start[ImplicitIdx::duz_n].dataPtr();
                 if        (WarpX::nox == 1){
                     doChargeConservingDepositionShapeNImplicit<1>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n_data, uyp_n_data, uzp_n_data,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dx, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -631,7 +897,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                     doChargeConservingDepositionShapeNImplicit<2>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n_data, uyp_n_data, uzp_n_data,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dx, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -639,7 +905,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                     doChargeConservingDepositionShapeNImplicit<3>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n_data, uyp_n_data, uzp_n_data,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dx, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -647,7 +913,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                     doChargeConservingDepositionShapeNImplicit<4>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n_data, uyp_n_data, uzp_n_data,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dx, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -655,28 +921,26 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
             }
         } else if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Villasenor) {
             if (push_type == PushType::Implicit) {
+                const auto step_start = GetImplicitStepStart(pti, offset, np_to_deposit);
 #if (AMREX_SPACEDIM >= 2)
-                auto& xp_n = pti.GetAttribs(particle_comps["x_n"]);
-                const ParticleReal* xp_n_data = xp_n.dataPtr() + offset;
+                const ParticleReal* xp_n_data = step_start[ImplicitIdx::dx_n].dataPtr();
 #else
                 const ParticleReal* xp_n_data = nullptr;
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-                auto& yp_n = pti.GetAttribs(particle_comps["y_n"]);
-                const ParticleReal* yp_n_data = yp_n.dataPtr() + offset;
+                const ParticleReal* yp_n_data = step_start[ImplicitIdx::dy_n].dataPtr();
 #else
                 const ParticleReal* yp_n_data = nullptr;
 #endif
-                auto& zp_n = pti.GetAttribs(particle_comps["z_n"]);
-                const ParticleReal* zp_n_data = zp_n.dataPtr() + offset;
-                auto& uxp_n = pti.GetAttribs(particle_comps["ux_n"]);
-                auto& uyp_n = pti.GetAttribs(particle_comps["uy_n"]);
-                auto& uzp_n = pti.GetAttribs(particle_comps["uz_n"]);
+                const ParticleReal* zp_n_data = step_start[ImplicitIdx::dz_n].dataPtr();
+                const ParticleReal* uxp_n_data = step_start[ImplicitIdx::dux_n].dataPtr();
+                const ParticleReal* uyp_n_data = step_start[ImplicitIdx::duy_n].dataPtr();
+                const ParticleReal* uzp_n_data = step_start[ImplicitIdx::duz_n].dataPtr();
                 if (WarpX::nox == 1){
                     doVillasenorDepositionShapeNImplicit<1>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n_data, uyp_n_data, uzp_n_data,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dx, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -684,7 +948,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                     doVillasenorDepositionShapeNImplicit<2>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n_data, uyp_n_data, uzp_n_data,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dx, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -692,7 +956,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                     doVillasenorDepositionShapeNImplicit<3>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n_data, uyp_n_data, uzp_n_data,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dx, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -700,7 +964,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                     doVillasenorDepositionShapeNImplicit<4>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n_data, uyp_n_data, uzp_n_data,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dx, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -738,6 +1002,72 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                         jx_fab, jy_fab, jz_fab, np_to_deposit, dt, relative_time, dx, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
             }
+        } else if (WarpX::current_deposition_algo == CurrentDepositionAlgo::DirectBlocked) {
+            if (push_type == PushType::Implicit) {
+                WARPX_ABORT_WITH_MESSAGE("The blocked direct algorithm cannot be used with implicit algorithm.");
+            }
+            // Sort the particles by cell, and the cells by super-cell, so that the
+            // consecutive particles deposited by a thread share their stencils and the
+            // threads of a block work on neighboring cells. This needs the bins to index
+            // all the particles of the tile.
+            WARPX_PROFILE_VAR_START(blp_sort);
+            amrex::DenseBins<ParticleTileType::ParticleTileDataType> bins;
+            const unsigned int* perm = nullptr;
+            const amrex::IntVect supercell = WarpX::blocked_deposition_supercell_size;
+            if (supercell.allGT(0) && offset == 0 && np_to_deposit == pti.numParticles()) {
+                const Geometry& geom = Geom(depos_lev);
+                const auto dxi = geom.InvCellSizeArray();
+                const auto plo = geom.ProbLoArray();
+                const auto domain = geom.Domain();
+                const Box box = tilebox;
+                const int ncells = AMREX_D_TERM(supercell[0], *supercell[1], *supercell[2]);
+                const int nbins = numTilesInBox(box, true, supercell) * ncells;
+
+                auto& ptile = ParticlesAt(lev, pti);
+                auto ptd = ptile.getParticleTileData();
+                bins.build(ptile.numParticles(), ptd, nbins,
+                    [=] AMREX_GPU_HOST_DEVICE (const ParticleType& p) -> unsigned int
+                    {
+                        Box tbox;
+                        const auto iv = amrex::min(amrex::max(
+                            getParticleCell(p, plo, dxi, domain), box.smallEnd()), box.bigEnd());
+                        const auto tid = getTileIndex(iv, box, true, supercell, tbox);
+                        return static_cast<unsigned int>(tid*ncells + tbox.index(iv));
+                    });
+                perm = bins.permutationPtr();
+            }
+            WARPX_PROFILE_VAR_STOP(blp_sort);
+            WARPX_PROFILE_VAR_START(direct_current_dep_kernel);
+            if        (WarpX::nox == 1){
+                doDepositionBlockedShapeN<1>(
+                    GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                    uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                    jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dx,
+                    xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                    WarpX::blocked_deposition_chunk_size, perm);
+            } else if (WarpX::nox == 2){
+                doDepositionBlockedShapeN<2>(
+                    GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                    uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                    jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dx,
+                    xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                    WarpX::blocked_deposition_chunk_size, perm);
+            } else if (WarpX::nox == 3){
+                doDepositionBlockedShapeN<3>(
+                    GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                    uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                    jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dx,
+                    xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                    WarpX::blocked_deposition_chunk_size, perm);
+            } else if (WarpX::nox == 4){
+                doDepositionBlockedShapeN<4>(
+                    GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                    uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                    jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dx,
+                    xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                    WarpX::blocked_deposition_chunk_size, perm);
+            }
+            WARPX_PROFILE_VAR_STOP(direct_current_dep_kernel);
         } else { // Direct deposition
             if (push_type == PushType::Explicit) {
                 if        (WarpX::nox == 1){
@@ -766,13 +1096,14 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                         xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
                 }
             } else if (push_type == PushType::Implicit) {
-                auto& uxp_n = pti.GetAttribs(particle_comps["ux_n"]);
-                auto& uyp_n = pti.GetAttribs(particle_comps["uy_n"]);
-                auto& uzp_n = pti.GetAttribs(particle_comps["uz_n"]);
+                const auto step_start = GetImplicitStepStart(pti, offset, np_to_deposit);
+                const ParticleReal* uxp_n_data = step_start[ImplicitIdx::dux_n].dataPtr();
+                const ParticleReal* uyp_n_data = step_start[ImplicitIdx::duy_n].dataPtr();
+                const ParticleReal* uzp_n_data = step_start[ImplicitIdx::duz_n].dataPtr();
                 if        (WarpX::nox == 1){
                     doDepositionShapeNImplicit<1>(
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n_data, uyp_n_data, uzp_n_data,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset,
                         ion_lev,
                         jx_fab, jy_fab, jz_fab, np_to_deposit, dx,
@@ -780,7 +1111,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                 } else if (WarpX::nox == 2){
                     doDepositionShapeNImplicit<2>(
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n_data, uyp_n_data, uzp_n_data,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset,
                         ion_lev,
                         jx_fab, jy_fab, jz_fab, np_to_deposit, dx,
@@ -788,7 +1119,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                 } else if (WarpX::nox == 3){
                     doDepositionShapeNImplicit<3>(
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n_data, uyp_n_data, uzp_n_data,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset,
                         ion_lev,
                         jx_fab, jy_fab, jz_fab, np_to_deposit, dx,
@@ -796,7 +1127,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                 } else if (WarpX::nox == 4){
                     doDepositionShapeNImplicit<4>(
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n_data, uyp_n_data, uzp_n_data,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset,
                         ion_lev,
                         jx_fab, jy_fab, jz_fab, np_to_deposit, dx,
@@ -810,9 +1141,16 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
 #ifndef AMREX_USE_GPU
     // CPU, tiling: atomicAdd local_j<xyz> into j<xyz>
     WARPX_PROFILE_VAR_START(blp_accumulate);
-    (*jx)[pti].lockAdd(local_jx[thread_num], tbx, tbx, 0, 0, jx->nComp());
-    (*jy)[pti].lockAdd(local_jy[thread_num], tby, tby, 0, 0, jy->nComp());
-    (*jz)[pti].lockAdd(local_jz[thread_num], tbz, tbz, 0, 0, jz->nComp());
+    lockAddDeposited((*jx)[pti], local_jx[thread_num], tbx, jx->nComp());
+    lockAddDeposited((*jy)[pti], local_jy[thread_num], tby, jy->nComp());
+    lockAddDeposited((*jz)[pti], local_jz[thread_num], tbz, jz->nComp());
+    WARPX_PROFILE_VAR_STOP(blp_accumulate);
+#else
+    // GPU, mixed precision: add the buffers into j<xyz>
+    WARPX_PROFILE_VAR_START(blp_accumulate);
+    addDepositionBuffer(jx->get(pti), local_jx[i_buffer]);
+    addDepositionBuffer(jy->get(pti), local_jy[i_buffer]);
+    addDepositionBuffer(jz->get(pti), local_jz[i_buffer]);
     WARPX_PROFILE_VAR_STOP(blp_accumulate);
 #endif
 }
@@ -883,6 +1221,7 @@ WarpXParticleContainer::DepositCharge (WarpXParIter& pti, RealVector const& wp,
                                        const long offset, const long np_to_deposit,
                                        const int thread_num, const int lev, const int depos_lev)
 {
+    const utils::timers::ScopedPhaseTimer phase_timer(utils::timers::Phase::ChargeDeposition);
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         rho->nComp() >= icomp - 1,
         "Cannot deposit charge in rho component icomp=" + std::to_string(icomp) +
@@ -1463,6 +1802,30 @@ WarpXParticleContainer::PushX (int lev, amrex::Real dt)
 
     amrex::LayoutData<amrex::Real>* costs = WarpX::getCosts(lev);
 
+    // The timers of the load balancing costs measure each tile separately
+    if (WarpX::batch_particle_launches && amrex::Gpu::inLaunchRegion() &&
+        !(costs && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers))
+    {
+        ParticleTileBatch<PushXTileData> batch;
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            auto& attribs = pti.GetAttribs();
+            batch.addTile({GetParticlePosition<PIdx>(pti), SetParticlePosition<PIdx>(pti),
+                           attribs[PIdx::ux].dataPtr(), attribs[PIdx::uy].dataPtr(),
+                           attribs[PIdx::uz].dataPtr()},
+                          pti.numParticles());
+        }
+        batch.ParallelFor(
+            [=] AMREX_GPU_DEVICE (PushXTileData const& tile, amrex::Long i) {
+                ParticleReal x, y, z;
+                tile.get_position(i, x, y, z);
+                UpdatePosition(x, y, z, tile.ux[i], tile.uy[i], tile.uz[i], dt);
+                tile.set_position(i, x, y, z);
+            }
+        );
+        return;
+    }
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
@@ -1518,8 +1881,9 @@ void WarpXParticleContainer::defineAllParticleTiles () noexcept
     // Call the parent class's method
     NamedComponentParticleContainer<amrex::DefaultAllocator>::defineAllParticleTiles();
 
-    // Resize the tmp_particle_data (no present in parent class)
+    // Resize the tmp_particle_data and the creation_scratch (no present in parent class)
     tmp_particle_data.resize(finestLevel()+1);
+    creation_scratch.resize(finestLevel()+1);
     for (int lev = 0; lev <= finestLevel(); ++lev)
     {
         for (auto mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
@@ -1527,10 +1891,96 @@ void WarpXParticleContainer::defineAllParticleTiles () noexcept
             const int grid_id = mfi.index();
             const int tile_id = mfi.LocalTileIndex();
             tmp_particle_data[lev][std::make_pair(grid_id,tile_id)];
+            creation_scratch[lev][std::make_pair(grid_id,tile_id)];
+        }
+    }
+}
+
+void WarpXParticleContainer::AllocateImplicitState ()
+{
+    // The map is filled in serial, as in defineAllParticleTiles
+    implicit_state.resize(finestLevel()+1);
+    for (int lev = 0; lev <= finestLevel(); ++lev)
+    {
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            const long np = pti.numParticles();
+            auto& state = implicit_state[lev][pti.GetPairIndex()];
+#if (AMREX_SPACEDIM >= 2)
+            state[ImplicitIdx::dx_n].resize(np);
+#endif
+#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
+            state[ImplicitIdx::dy_n].resize(np);
+#endif
+            state[ImplicitIdx::dz_n].resize(np);
+            state[ImplicitIdx::dux_n].resize(np);
+            state[ImplicitIdx::duy_n].resize(np);
+            state[ImplicitIdx::duz_n].resize(np);
+            for (auto& delta : state) {
+                float* const AMREX_RESTRICT d = delta.dataPtr();
+                amrex::ParallelFor(static_cast<long>(delta.size()),
+                    [=] AMREX_GPU_DEVICE (long ip) { d[ip] = 0.f; });
+            }
         }
     }
 }
 
+void WarpXParticleContainer::FreeImplicitState ()
+{
+    // The kernels that read the state may still be running
+    amrex::Gpu::synchronize();
+    for (auto& state_lev : implicit_state) {
+        state_lev.clear();
+    }
+}
+
+WarpXParticleContainer::ImplicitStepStart
+WarpXParticleContainer::GetImplicitStepStart (WarpXParIter& pti, long offset, long np)
+{
+    auto& state = getImplicitState(pti.GetLevel(), pti.GetPairIndex());
+    const auto GetPosition = GetParticlePosition<PIdx>(pti, offset);
+    auto& attribs = pti.GetAttribs();
+    const ParticleReal* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr() + offset;
+    const ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr() + offset;
+    const ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr() + offset;
+
+    ImplicitStepStart step_start;
+    for (auto& v : step_start) { v.resize(np); }
+#if (AMREX_SPACEDIM >= 2)
+    const float* const AMREX_RESTRICT dx_n = state[ImplicitIdx::dx_n].dataPtr() + offset;
+    ParticleReal* const AMREX_RESTRICT x_n = step_start[ImplicitIdx::dx_n].dataPtr();
+#endif
+#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
+    const float* const AMREX_RESTRICT dy_n = state[ImplicitIdx::dy_n].dataPtr() + offset;
+    ParticleReal* const AMREX_RESTRICT y_n = step_start[ImplicitIdx::dy_n].dataPtr();
+#endif
+    const float* const AMREX_RESTRICT dz_n = state[ImplicitIdx::dz_n].dataPtr() + offset;
+    ParticleReal* const AMREX_RESTRICT z_n = step_start[ImplicitIdx::dz_n].dataPtr();
+    const float* const AMREX_RESTRICT dux_n = state[ImplicitIdx::dux_n].dataPtr() + offset;
+    const float* const AMREX_RESTRICT duy_n = state[ImplicitIdx::duy_n].dataPtr() + offset;
+    const float* const AMREX_RESTRICT duz_n = state[ImplicitIdx::duz_n].dataPtr() + offset;
+    ParticleReal* const AMREX_RESTRICT ux_n = step_start[ImplicitIdx::dux_n].dataPtr();
+    ParticleReal* const AMREX_RESTRICT uy_n = step_start[ImplicitIdx::duy_n].dataPtr();
+    ParticleReal* const AMREX_RESTRICT uz_n = step_start[ImplicitIdx::duz_n].dataPtr();
+
+    amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long ip)
+    {
+        ParticleReal xp, yp, zp;
+        GetPosition(ip, xp, yp, zp);
+#if (AMREX_SPACEDIM >= 2)
+        x_n[ip] = xp + dx_n[ip];
+#endif
+#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
+        y_n[ip] = yp + dy_n[ip];
+#endif
+        z_n[ip] = zp + dz_n[ip];
+        ux_n[ip] = ux[ip] + dux_n[ip];
+        uy_n[ip] = uy[ip] + duy_n[ip];
+        uz_n[ip] = uz[ip] + duz_n[ip];
+    });
+    return step_start;
+}
+
 // This function is called in Redistribute, just after locate
 void
 WarpXParticleContainer::particlePostLocate(ParticleType& p,
@@ -1561,70 +2011,82 @@ WarpXParticleContainer::ApplyBoundaryConditions (){
     // Periodic boundaries are handled in AMReX code
     if (m_boundary_conditions.CheckAll(ParticleBoundaryType::Periodic)) { return; }
 
-    auto boundary_conditions = m_boundary_conditions.data;
+    const bool batched = WarpX::batch_particle_launches && amrex::Gpu::inLaunchRegion();
 
     for (int lev = 0; lev <= finestLevel(); ++lev)
     {
+        // Since the last redistribution, the particles moved by less than c*dt relative to
+        // the grid, and the moving window or the Galilean grid by less than c*dt too:
+        // only the tiles within this distance of a non-periodic domain boundary can have
+        // particles outside of the domain.
+        const amrex::Geometry& geom = Geom(lev);
+        const amrex::Box& domain_box = geom.Domain();
+        const amrex::Real max_shift = 2*PhysConst::c*WarpX::GetInstance().getdt(0);
+        amrex::IntVect boundary_margin;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            boundary_margin[idim] = static_cast<int>(std::ceil(max_shift/geom.CellSize(idim))) + 1;
+        }
+
+        ApplyBoundariesToParticle apply_boundaries;
+#ifndef WARPX_DIM_1D_Z
+        apply_boundaries.xmin = geom.ProbLo(0);
+        apply_boundaries.xmax = geom.ProbHi(0);
+#endif
+#ifdef WARPX_DIM_3D
+        apply_boundaries.ymin = geom.ProbLo(1);
+        apply_boundaries.ymax = geom.ProbHi(1);
+#endif
+        apply_boundaries.zmin = geom.ProbLo(WARPX_ZINDEX);
+        apply_boundaries.zmax = geom.ProbHi(WARPX_ZINDEX);
+        apply_boundaries.boundary_conditions = m_boundary_conditions.data;
+
+        ParticleTileBatch<BoundaryTileData> batch;
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
-            auto GetPosition = GetParticlePosition<PIdx>(pti);
-            auto SetPosition = SetParticlePosition<PIdx>(pti);
-#ifndef WARPX_DIM_1D_Z
-            const Real xmin = Geom(lev).ProbLo(0);
-            const Real xmax = Geom(lev).ProbHi(0);
-#endif
-#ifdef WARPX_DIM_3D
-            const Real ymin = Geom(lev).ProbLo(1);
-            const Real ymax = Geom(lev).ProbHi(1);
-#endif
-            const Real zmin = Geom(lev).ProbLo(WARPX_ZINDEX);
-            const Real zmax = Geom(lev).ProbHi(WARPX_ZINDEX);
+            const amrex::Box tile_box = amrex::grow(pti.tilebox(), boundary_margin);
+            bool near_boundary = false;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                if (!geom.isPeriodic(idim) &&
+                    (tile_box.smallEnd(idim) < domain_box.smallEnd(idim) ||
+                     tile_box.bigEnd(idim) > domain_box.bigEnd(idim))) {
+                    near_boundary = true;
+                }
+            }
+            if (!near_boundary) { continue; }
 
             ParticleTileType& ptile = ParticlesAt(lev, pti);
 
             auto& soa = ptile.GetStructOfArrays();
-            uint64_t * const AMREX_RESTRICT idcpu = soa.GetIdCPUData().data();
-            amrex::ParticleReal * const AMREX_RESTRICT ux = soa.GetRealData(PIdx::ux).data();
-            amrex::ParticleReal * const AMREX_RESTRICT uy = soa.GetRealData(PIdx::uy).data();
-            amrex::ParticleReal * const AMREX_RESTRICT uz = soa.GetRealData(PIdx::uz).data();
+            const BoundaryTileData tile{GetParticlePosition<PIdx>(pti), SetParticlePosition<PIdx>(pti),
+                                        soa.GetIdCPUData().data(),
+                                        soa.GetRealData(PIdx::ux).data(),
+                                        soa.GetRealData(PIdx::uy).data(),
+                                        soa.GetRealData(PIdx::uz).data()};
+
+            // With batched launches, the tiles near the boundaries are done in one kernel below
+            if (batched) {
+                batch.addTile(tile, pti.numParticles());
+                continue;
+            }
 
             // Loop over particles and apply BC to each particle
             amrex::ParallelForRNG(
                 pti.numParticles(),
                 [=] AMREX_GPU_DEVICE (long i, amrex::RandomEngine const& engine) {
-                    // skip particles that are already flagged for removal
-                    auto pidw = amrex::ParticleIDWrapper{idcpu[i]};
-                    if (!pidw.is_valid()) { return; }
-
-                    ParticleReal x, y, z;
-                    GetPosition.AsStored(i, x, y, z);
-                    // Note that for RZ, (x, y, z) is actually (r, theta, z).
-
-                    bool particle_lost = false;
-                    ApplyParticleBoundaries::apply_boundaries(
-#ifndef WARPX_DIM_1D_Z
-                                                              x, xmin, xmax,
-#endif
-#if (defined WARPX_DIM_3D) || (defined WARPX_DIM_RZ)
-                                                              y,
-#endif
-#if (defined WARPX_DIM_3D)
-                                                              ymin, ymax,
-#endif
-                                                              z, zmin, zmax,
-                                                              ux[i], uy[i], uz[i], particle_lost,
-                                                              boundary_conditions, engine);
-
-                    if (particle_lost) {
-                        pidw.make_invalid();
-                    } else {
-                        SetPosition.AsStored(i, x, y, z);
-                    }
+                    apply_boundaries(tile, i, engine);
                 }
             );
         }
+
+        batch.ParallelForRNG(
+            [=] AMREX_GPU_DEVICE (BoundaryTileData const& tile, amrex::Long i,
+                                  amrex::RandomEngine const& engine) {
+                apply_boundaries(tile, i, engine);
+            }
+        );
     }
 }
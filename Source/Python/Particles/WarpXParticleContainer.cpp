@@ -8,6 +8,9 @@
 
 #include <Particles/WarpXParticleContainer.H>
 
+#include <cstdint>
+#include <vector>
+
 
 void init_WarpXParIter (py::module& m)
 {
@@ -85,6 +88,40 @@ void init_WarpXParticleContainer (py::module& m)
             py::arg("nattr_int"), py::arg("attr_int"),
             py::arg("uniqueparticles"), py::arg("id")=-1
         )
+        .def("add_n_particles_device",
+            [](WarpXParticleContainer& pc, int lev, int n,
+                std::uintptr_t x, std::uintptr_t y, std::uintptr_t z,
+                std::uintptr_t ux, std::uintptr_t uy, std::uintptr_t uz,
+                const std::vector<std::uintptr_t>& attr_real,
+                const std::vector<std::uintptr_t>& attr_int,
+                int uniqueparticles, int id
+            ) {
+                auto const as_real = [](std::uintptr_t ptr) {
+                    return reinterpret_cast<amrex::ParticleReal const*>(ptr);
+                };
+                amrex::Vector<amrex::ParticleReal const*> attr;
+                for (auto const ptr : attr_real) { attr.push_back(as_real(ptr)); }
+                amrex::Vector<int const*> iattr;
+                for (auto const ptr : attr_int) { iattr.push_back(reinterpret_cast<int const*>(ptr)); }
+
+                pc.AddNParticlesDevice(
+                    lev, n, as_real(x), as_real(y), as_real(z), as_real(ux), as_real(uy), as_real(uz),
+                    static_cast<int>(attr.size()), attr, static_cast<int>(iattr.size()), iattr,
+                    uniqueparticles, id
+                );
+            },
+            py::arg("lev"), py::arg("n"),
+            py::arg("x"), py::arg("y"), py::arg("z"),
+            py::arg("ux"), py::arg("uy"), py::arg("uz"),
+            py::arg("attr_real"), py::arg("attr_int"),
+            py::arg("uniqueparticles"), py::arg("id")=-1,
+            "Add n particles from contiguous arrays of ParticleReal (int for attr_int) given by "
+            "their addresses, which must be accessible on the device (e.g. CuPy arrays on GPU)"
+        )
+        .def_property_readonly_static("particle_real_size",
+            [](py::object /* pc */) { return sizeof(amrex::ParticleReal); },
+            "Size in bytes of the floating point type of the particle attributes"
+        )
         .def("get_comp_index",
             [](WarpXParticleContainer& pc, std::string comp_name)
             {
@@ -101,6 +138,14 @@ void init_WarpXParticleContainer (py::module& m)
             },
             py::arg("comp_name")
         )
+        .def_property_readonly("real_comp_names",
+            [](WarpXParticleContainer& pc) { return pc.getParticleComps(); },
+            "Dictionary of the names and indices of the particle real components"
+        )
+        .def_property_readonly("int_comp_names",
+            [](WarpXParticleContainer& pc) { return pc.getParticleiComps(); },
+            "Dictionary of the names and indices of the particle int components"
+        )
         .def("num_local_tiles_at_level",
             &WarpXParticleContainer::numLocalTilesAtLevel,
             py::arg("level")
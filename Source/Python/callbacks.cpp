@@ -8,21 +8,59 @@
  */
 #include "callbacks.H"
 
+#include "WarpX.H"
+#include "Utils/Parser/IntervalsParser.H"
+
 #include <cstdlib>
 #include <exception>
 #include <iostream>
+#include <utility>
 
 
 std::map< std::string, std::function<void()> > warpx_callback_py_map;
 
-void InstallPythonCallback ( const std::string& name, std::function<void()> callback )
+namespace
+{
+    /** Intervals of the Python callbacks that are not called at every step */
+    std::map< std::string, utils::parser::IntervalsParser > warpx_callback_py_intervals;
+
+    /** A native callback and the steps at which it is called */
+    struct NativeCallbackEntry
+    {
+        NativeCallback callback;
+        bool every_step;
+        utils::parser::IntervalsParser intervals;
+    };
+
+    /** Native callbacks of each location */
+    std::map< std::string, std::vector< NativeCallbackEntry > > warpx_callback_native_map;
+}
+
+void InstallPythonCallback ( const std::string& name, std::function<void()> callback,
+                             const std::string& intervals )
 {
     warpx_callback_py_map[name] = std::move(callback);
+    if (intervals.empty()) {
+        warpx_callback_py_intervals.erase(name);
+    } else {
+        warpx_callback_py_intervals[name] =
+            utils::parser::IntervalsParser(std::vector<std::string>{intervals});
+    }
+}
+
+void InstallNativeCallback ( const std::string& name, NativeCallback callback,
+                             const std::string& intervals )
+{
+    warpx_callback_native_map[name].push_back(
+        NativeCallbackEntry{callback, intervals.empty(), intervals.empty() ?
+            utils::parser::IntervalsParser{} :
+            utils::parser::IntervalsParser(std::vector<std::string>{intervals})});
 }
 
 bool IsPythonCallbackInstalled ( const std::string& name )
 {
-    return (warpx_callback_py_map.count(name) == 1u);
+    return (warpx_callback_py_map.count(name) == 1u) ||
+        (warpx_callback_native_map.count(name) == 1u);
 }
 
 // Execute Python callbacks of the type given by the input string
@@ -30,8 +68,26 @@ void ExecutePythonCallback ( const std::string& name )
 {
     if ( IsPythonCallbackInstalled(name) ) {
         WARPX_PROFILE("warpx_py_" + name);
+        const int step = WarpX::GetInstance().getistep(0);
+
+        // Native callbacks: plain function calls, the Python interpreter is not involved
+        const auto native = warpx_callback_native_map.find(name);
+        if (native != warpx_callback_native_map.end()) {
+            for (const auto& entry : native->second) {
+                if (entry.every_step || entry.intervals.contains(step)) { entry.callback(step); }
+            }
+        }
+
+        const auto python = warpx_callback_py_map.find(name);
+        if (python == warpx_callback_py_map.end()) { return; }
+
+        // Skip the call (and the acquisition of the GIL) outside of the intervals
+        const auto intervals = warpx_callback_py_intervals.find(name);
+        if (intervals != warpx_callback_py_intervals.end() &&
+            !intervals->second.contains(step)) { return; }
+
         try {
-            warpx_callback_py_map[name]();
+            python->second();
         } catch (std::exception &e) {
             std::cerr << "Python callback '" << name << "' failed!" << std::endl;
             std::cerr << e.what() << std::endl;
@@ -50,4 +106,10 @@ void ExecutePythonCallback ( const std::string& name )
 void ClearPythonCallback ( const std::string& name )
 {
     warpx_callback_py_map.erase(name);
+    warpx_callback_py_intervals.erase(name);
+}
+
+void ClearNativeCallbacks ( const std::string& name )
+{
+    warpx_callback_native_map.erase(name);
 }
@@ -9,8 +9,13 @@
 #include <WarpX.H>  // todo: move this out to Python/WarpX.cpp
 #include <Utils/WarpXUtil.H>  // todo: move to its own Python/Utils.cpp
 #include <Utils/WarpXVersion.H>
+#include <Utils/Parser/IntervalsParser.H>
 #include <Initialization/WarpXAMReXInit.H>
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #define STRINGIFY(x) #x
 #define MACRO_STRINGIFY(x) STRINGIFY(x)
 #define CONCAT_NAME(PRE, SUF) PRE ## SUF
@@ -126,7 +131,26 @@ PYBIND11_MODULE(PYWARPX_MODULE_NAME, m) {
     m.def("getMyProc", [](){return amrex::ParallelDescriptor::MyProc();} );
 
     // Expose the python callback function installation and removal functions
-    m.def("add_python_callback", &InstallPythonCallback);
+    m.def("add_python_callback", &InstallPythonCallback,
+        py::arg("name"), py::arg("callback"), py::arg("intervals") = "");
     m.def("remove_python_callback", &ClearPythonCallback);
     m.def("execute_python_callback", &ExecutePythonCallback, py::arg("name"));
+
+    // Native callbacks are given as the address of a compiled function void f(int step),
+    // e.g. from ctypes
+    m.def("add_native_callback",
+        [](const std::string& name, std::uintptr_t address, const std::string& intervals) {
+            InstallNativeCallback(name, reinterpret_cast<NativeCallback>(address), intervals);
+        },
+        py::arg("name"), py::arg("address"), py::arg("intervals") = "");
+    m.def("remove_native_callbacks", &ClearNativeCallbacks, py::arg("name"));
+
+    // Expose the intervals parser, to select the steps of the Python callbacks
+    py::class_<utils::parser::IntervalsParser>(m, "IntervalsParser")
+        .def(py::init([](const std::string& intervals) {
+                return utils::parser::IntervalsParser(std::vector<std::string>{intervals});
+            }),
+            py::arg("intervals"))
+        .def("contains", &utils::parser::IntervalsParser::contains, py::arg("n"))
+    ;
 }
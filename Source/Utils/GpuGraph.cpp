@@ -0,0 +1,85 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "GpuGraph.H"
+
+#include "Utils/TextMsg.H"
+
+#include <AMReX_GpuDevice.H>
+
+#if defined(AMREX_USE_CUDA)
+#   define WARPX_GPU_GRAPH_CHECK(call) \
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE((call) == cudaSuccess, "GpuGraph: " #call " failed")
+#elif defined(AMREX_USE_HIP)
+#   define WARPX_GPU_GRAPH_CHECK(call) \
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE((call) == hipSuccess, "GpuGraph: " #call " failed")
+#endif
+
+namespace utils
+{
+    GpuGraph::~GpuGraph ()
+    {
+        reset();
+    }
+
+    void
+    GpuGraph::reset ()
+    {
+#if defined(AMREX_USE_CUDA)
+        if (m_exec) { cudaGraphExecDestroy(m_exec); }
+#elif defined(AMREX_USE_HIP)
+        if (m_exec) { hipGraphExecDestroy(m_exec); }
+#endif
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+        m_exec = nullptr;
+#endif
+        m_recorded = false;
+    }
+
+    void
+    GpuGraph::beginCapture ()
+    {
+        // Operations queued before the recording must not end up in the graph
+        amrex::Gpu::streamSynchronize();
+#if defined(AMREX_USE_CUDA)
+        WARPX_GPU_GRAPH_CHECK(cudaStreamBeginCapture(amrex::Gpu::gpuStream(),
+                                                     cudaStreamCaptureModeThreadLocal));
+#elif defined(AMREX_USE_HIP)
+        WARPX_GPU_GRAPH_CHECK(hipStreamBeginCapture(amrex::Gpu::gpuStream(),
+                                                    hipStreamCaptureModeThreadLocal));
+#endif
+    }
+
+    void
+    GpuGraph::endCapture ()
+    {
+#if defined(AMREX_USE_CUDA)
+        cudaGraph_t graph = nullptr;
+        WARPX_GPU_GRAPH_CHECK(cudaStreamEndCapture(amrex::Gpu::gpuStream(), &graph));
+        WARPX_GPU_GRAPH_CHECK(cudaGraphInstantiate(&m_exec, graph, nullptr, nullptr, 0));
+        cudaGraphDestroy(graph);
+        m_recorded = true;
+#elif defined(AMREX_USE_HIP)
+        hipGraph_t graph = nullptr;
+        WARPX_GPU_GRAPH_CHECK(hipStreamEndCapture(amrex::Gpu::gpuStream(), &graph));
+        WARPX_GPU_GRAPH_CHECK(hipGraphInstantiate(&m_exec, graph, nullptr, nullptr, 0));
+        hipGraphDestroy(graph);
+        m_recorded = true;
+#endif
+    }
+
+    void
+    GpuGraph::launch ()
+    {
+#if defined(AMREX_USE_CUDA)
+        WARPX_GPU_GRAPH_CHECK(cudaGraphLaunch(m_exec, amrex::Gpu::gpuStream()));
+#elif defined(AMREX_USE_HIP)
+        WARPX_GPU_GRAPH_CHECK(hipGraphLaunch(m_exec, amrex::Gpu::gpuStream()));
+#endif
+        // As at the end of the MFIter loops that were recorded
+        amrex::Gpu::streamSynchronize();
+    }
+}
@@ -0,0 +1,147 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "HardwareCounters.H"
+
+#include "Utils/TextMsg.H"
+
+#include <AMReX.H>
+#include <AMReX_OpenMP.H>
+
+#ifdef WARPX_USE_PAPI
+#   include <papi.h>
+#endif
+
+#include <utility>
+
+namespace
+{
+    using namespace utils::hwcounters;
+
+    /** Names of the events being counted */
+    std::vector<std::string> s_events;
+    /** Accumulated counts of each region */
+    std::map<std::string, RegionCounts> s_regions;
+#ifdef WARPX_USE_PAPI
+    int s_event_set = PAPI_NULL;
+
+    void checkPAPI (int status, std::string const& what)
+    {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(status == PAPI_OK,
+            "HardwareCounters: " + what + " failed: " + std::string(PAPI_strerror(status)));
+    }
+#endif
+
+    bool isMasterThread ()
+    {
+        return amrex::OpenMP::get_thread_num() == 0;
+    }
+}
+
+namespace utils::hwcounters
+{
+    void HardwareCounters::Initialize (std::vector<std::string> const& events)
+    {
+#ifdef WARPX_USE_PAPI
+        if (m_enabled) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(events == s_events,
+                "HardwareCounters: all the diagnostics must count the same events");
+            return;
+        }
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!events.empty() &&
+            static_cast<int>(events.size()) <= max_events,
+            "HardwareCounters: between 1 and " + std::to_string(max_events) +
+            " events can be counted");
+
+        const int version = PAPI_library_init(PAPI_VER_CURRENT);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(version == PAPI_VER_CURRENT,
+            "HardwareCounters: PAPI_library_init failed");
+        checkPAPI(PAPI_create_eventset(&s_event_set), "PAPI_create_eventset");
+        for (auto const& event : events) {
+            int code = 0;
+            checkPAPI(PAPI_event_name_to_code(const_cast<char*>(event.c_str()), &code),
+                      "PAPI_event_name_to_code(" + event + ")");
+            checkPAPI(PAPI_add_event(s_event_set, code), "PAPI_add_event(" + event + ")");
+        }
+        checkPAPI(PAPI_start(s_event_set), "PAPI_start");
+
+        s_events = events;
+        s_regions.clear();
+        m_enabled = true;
+
+        amrex::ExecOnFinalize([] () {
+            Counts values{};
+            PAPI_stop(s_event_set, values.data());
+            PAPI_cleanup_eventset(s_event_set);
+            PAPI_destroy_eventset(&s_event_set);
+            PAPI_shutdown();
+            s_events.clear();
+            s_regions.clear();
+            m_enabled = false;
+        });
+#else
+        amrex::ignore_unused(events);
+        WARPX_ABORT_WITH_MESSAGE(
+            "HardwareCounters: WarpX must be compiled with PAPI (WarpX_PAPI=ON or USE_PAPI=TRUE)");
+#endif
+    }
+
+    std::vector<std::string> const& HardwareCounters::EventNames ()
+    {
+        return s_events;
+    }
+
+    Counts HardwareCounters::Read ()
+    {
+        Counts values{};
+#ifdef WARPX_USE_PAPI
+        if (m_enabled) { PAPI_read(s_event_set, values.data()); }
+#endif
+        return values;
+    }
+
+    void HardwareCounters::Accumulate (std::string const& region, Counts const& start,
+                                       Counts const& stop)
+    {
+        auto& counts = s_regions[region];
+        ++counts.calls;
+        for (int i = 0; i < max_events; ++i) {
+            counts.counts[i] += stop[i] - start[i];
+        }
+    }
+
+    std::map<std::string, RegionCounts> HardwareCounters::GetAndReset ()
+    {
+        std::map<std::string, RegionCounts> regions;
+        std::swap(regions, s_regions);
+        return regions;
+    }
+
+    Region::Region (std::string const& name, bool start_now)
+        : m_name{name}
+    {
+        if (start_now) { start(); }
+    }
+
+    Region::~Region ()
+    {
+        stop();
+    }
+
+    void Region::start ()
+    {
+        if (!HardwareCounters::IsEnabled() || !isMasterThread() || m_running) { return; }
+        m_running = true;
+        m_start = HardwareCounters::Read();
+    }
+
+    void Region::stop ()
+    {
+        if (!m_running) { return; }
+        m_running = false;
+        HardwareCounters::Accumulate(m_name, m_start, HardwareCounters::Read());
+    }
+}
@@ -0,0 +1,110 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "PhaseTimers.H"
+
+#include "Utils/TextMsg.H"
+
+#include <AMReX_GpuDevice.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_Utility.H>
+
+#include <vector>
+
+namespace
+{
+    using namespace utils::timers;
+
+    /** Phases currently entered, the innermost last */
+    std::vector<Phase> s_stack;
+    /** Accumulated time of each phase */
+    std::array<double, num_phases> s_times{};
+    /** Time of the last phase transition */
+    double s_last = 0.;
+    /** Time at which the accumulation started */
+    double s_start = 0.;
+
+    bool isMasterThread ()
+    {
+        return amrex::OpenMP::get_thread_num() == 0;
+    }
+
+    double now ()
+    {
+        amrex::Gpu::streamSynchronize();
+        return amrex::second();
+    }
+
+    /** Attribute the time since the last transition to the innermost phase */
+    double accumulate ()
+    {
+        const double t = now();
+        if (!s_stack.empty()) {
+            s_times[static_cast<int>(s_stack.back())] += t - s_last;
+        }
+        s_last = t;
+        return t;
+    }
+}
+
+namespace utils::timers
+{
+    std::string PhaseName (Phase phase)
+    {
+        switch (phase) {
+            case Phase::ParticlePush: return "particle_push";
+            case Phase::CurrentDeposition: return "current_deposition";
+            case Phase::ChargeDeposition: return "charge_deposition";
+            case Phase::FieldSolve: return "field_solve";
+            case Phase::FieldCommunication: return "field_comm";
+            case Phase::SourceCommunication: return "source_comm";
+            case Phase::ParticleCommunication: return "particle_comm";
+            case Phase::Diagnostics: return "diagnostics";
+            default:
+                WARPX_ABORT_WITH_MESSAGE("Unknown phase");
+        }
+        return "";
+    }
+
+    void PhaseTimers::Enable (bool enable)
+    {
+        if (enable && !m_enabled) {
+            s_times.fill(0.);
+            s_start = s_last = now();
+        }
+        m_enabled = enable;
+    }
+
+    void PhaseTimers::Start (Phase phase)
+    {
+        if (!isMasterThread()) { return; }
+        if (m_enabled) { accumulate(); }
+        s_stack.push_back(phase);
+    }
+
+    void PhaseTimers::Stop ()
+    {
+        if (!isMasterThread() || s_stack.empty()) { return; }
+        if (m_enabled) { accumulate(); }
+        s_stack.pop_back();
+    }
+
+    std::array<double, num_phases+1> PhaseTimers::GetAndReset ()
+    {
+        std::array<double, num_phases+1> times{};
+        if (!m_enabled) { return times; }
+
+        const double t = accumulate();
+        for (int i = 0; i < num_phases; ++i) {
+            times[i] = s_times[i];
+        }
+        times[num_phases] = t - s_start;
+
+        s_times.fill(0.);
+        s_start = t;
+        return times;
+    }
+}
@@ -213,8 +213,12 @@ namespace SpeciesUtils {
             const GetTemperature getTemp(*h_mom_temp);
             h_mom_vel = std::make_unique<VelocityProperties>(pp_species, source_name);
             const GetVelocity getVel(*h_mom_vel);
-            // Construct InjectorMomentum with InjectorMomentumJuttner.
-            h_inj_mom.reset(new InjectorMomentum((InjectorMomentumJuttner*)nullptr, getTemp, getVel));
+            // Construct InjectorMomentum with InjectorMomentumJuttner, with the tabulated
+            // inverse cumulative distribution function of the speed if it was computed
+            auto const& inverse_cdf = h_mom_temp->m_juttner_inverse_cdf;
+            h_inj_mom.reset(new InjectorMomentum((InjectorMomentumJuttner*)nullptr, getTemp, getVel,
+                inverse_cdf.empty() ? nullptr : inverse_cdf.dataPtr(),
+                static_cast<int>(inverse_cdf.size())));
         } else if (mom_dist_s == "radial_expansion") {
             amrex::Real u_over_r = 0._rt;
             utils::parser::queryWithParser(pp_species, source_name, "u_over_r", u_over_r);
@@ -0,0 +1,257 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "TransferAudit.H"
+
+#include "Utils/TextMsg.H"
+
+#include <AMReX.H>
+#include <AMReX_OpenMP.H>
+
+#ifdef WARPX_USE_CUPTI
+#   include <cuda_runtime_api.h>
+#   include <cupti.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace utils::transfer_audit;
+
+    /** Transfers of each region */
+    std::map<std::string, RegionTransfers> s_regions;
+    /** Managed-memory events */
+    ManagedMemoryEvents s_managed;
+    /** Profiled regions entered by the master thread */
+    std::vector<std::string const*> s_region_stack;
+    /** The counters are updated from the CUPTI callbacks, possibly from other threads */
+    std::mutex s_mutex;
+
+    bool isMasterThread ()
+    {
+        return amrex::OpenMP::get_thread_num() == 0;
+    }
+
+#ifdef WARPX_USE_CUPTI
+    CUpti_SubscriberHandle s_subscriber;
+
+    void checkCUPTI (CUptiResult status, std::string const& what)
+    {
+        if (status != CUPTI_SUCCESS) {
+            const char* msg = nullptr;
+            cuptiGetResultString(status, &msg);
+            WARPX_ABORT_WITH_MESSAGE("TransferAudit: " + what + " failed: " +
+                std::string(msg ? msg : "unknown error"));
+        }
+    }
+
+    void recordCopy (cudaMemcpyKind kind, std::size_t count)
+    {
+        if (kind == cudaMemcpyHostToDevice) {
+            TransferAudit::Record(true, static_cast<long long>(count));
+        } else if (kind == cudaMemcpyDeviceToHost) {
+            TransferAudit::Record(false, static_cast<long long>(count));
+        }
+    }
+
+    /** Runtime API callback: count the copies when they are issued */
+    void CUPTIAPI runtimeCallback (void* /*userdata*/, CUpti_CallbackDomain domain,
+                                   CUpti_CallbackId cbid, const void* cbdata)
+    {
+        if (domain != CUPTI_CB_DOMAIN_RUNTIME_API) { return; }
+        auto const* info = static_cast<CUpti_CallbackData const*>(cbdata);
+        if (info->callbackSite != CUPTI_API_ENTER) { return; }
+        switch (cbid) {
+            case CUPTI_RUNTIME_TRACE_CBID_cudaMemcpy_v3020: {
+                auto const* p = static_cast<cudaMemcpy_v3020_params const*>(info->functionParams);
+                recordCopy(p->kind, p->count);
+                break;
+            }
+            case CUPTI_RUNTIME_TRACE_CBID_cudaMemcpyAsync_v3020: {
+                auto const* p = static_cast<cudaMemcpyAsync_v3020_params const*>(info->functionParams);
+                recordCopy(p->kind, p->count);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    constexpr std::size_t activity_buffer_size = 1024*1024;
+    constexpr std::size_t activity_buffer_align = 8;
+
+    void CUPTIAPI bufferRequested (uint8_t** buffer, size_t* size, size_t* max_num_records)
+    {
+        *buffer = static_cast<uint8_t*>(std::aligned_alloc(activity_buffer_align, activity_buffer_size));
+        *size = activity_buffer_size;
+        *max_num_records = 0;
+    }
+
+    /** Activity API callback: accumulate the managed-memory counters */
+    void CUPTIAPI bufferCompleted (CUcontext /*ctx*/, uint32_t /*stream_id*/, uint8_t* buffer,
+                                   size_t /*size*/, size_t valid_size)
+    {
+        CUpti_Activity* record = nullptr;
+        {
+            const std::lock_guard<std::mutex> lock(s_mutex);
+            while (cuptiActivityGetNextRecord(buffer, valid_size, &record) == CUPTI_SUCCESS) {
+                if (record->kind != CUPTI_ACTIVITY_KIND_UNIFIED_MEMORY_COUNTER) { continue; }
+                auto const* um = reinterpret_cast<CUpti_ActivityUnifiedMemoryCounter2 const*>(record);
+                const auto value = static_cast<long long>(um->value);
+                switch (um->counterKind) {
+                    case CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_CPU_PAGE_FAULT_COUNT:
+                        s_managed.cpu_page_faults += value; break;
+                    case CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_GPU_PAGE_FAULT:
+                        s_managed.gpu_page_faults += value; break;
+                    case CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_BYTES_TRANSFER_HTOD:
+                        s_managed.htod_bytes += value; break;
+                    case CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_BYTES_TRANSFER_DTOH:
+                        s_managed.dtoh_bytes += value; break;
+                    default:
+                        break;
+                }
+            }
+        }
+        std::free(buffer);
+    }
+#endif
+}
+
+namespace utils::transfer_audit
+{
+    void TransferAudit::Initialize ()
+    {
+#ifdef WARPX_USE_CUPTI
+        if (m_enabled) { return; }
+
+        checkCUPTI(cuptiSubscribe(&s_subscriber, runtimeCallback, nullptr), "cuptiSubscribe");
+        checkCUPTI(cuptiEnableCallback(1, s_subscriber, CUPTI_CB_DOMAIN_RUNTIME_API,
+                                       CUPTI_RUNTIME_TRACE_CBID_cudaMemcpy_v3020),
+                   "cuptiEnableCallback(cudaMemcpy)");
+        checkCUPTI(cuptiEnableCallback(1, s_subscriber, CUPTI_CB_DOMAIN_RUNTIME_API,
+                                       CUPTI_RUNTIME_TRACE_CBID_cudaMemcpyAsync_v3020),
+                   "cuptiEnableCallback(cudaMemcpyAsync)");
+
+        std::array<CUpti_ActivityUnifiedMemoryCounterConfig, 4> config{};
+        const std::array<CUpti_ActivityUnifiedMemoryCounterKind, 4> kinds = {
+            CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_CPU_PAGE_FAULT_COUNT,
+            CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_GPU_PAGE_FAULT,
+            CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_BYTES_TRANSFER_HTOD,
+            CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_BYTES_TRANSFER_DTOH};
+        for (std::size_t i = 0; i < kinds.size(); ++i) {
+            config[i].scope = CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_SCOPE_PROCESS_SINGLE_DEVICE;
+            config[i].kind = kinds[i];
+            config[i].deviceId = 0;
+            config[i].enable = 1;
+        }
+        checkCUPTI(cuptiActivityRegisterCallbacks(bufferRequested, bufferCompleted),
+                   "cuptiActivityRegisterCallbacks");
+        checkCUPTI(cuptiActivityConfigureUnifiedMemoryCounter(config.data(),
+                                                              static_cast<uint32_t>(config.size())),
+                   "cuptiActivityConfigureUnifiedMemoryCounter");
+        checkCUPTI(cuptiActivityEnable(CUPTI_ACTIVITY_KIND_UNIFIED_MEMORY_COUNTER),
+                   "cuptiActivityEnable");
+
+        s_regions.clear();
+        s_managed = ManagedMemoryEvents{};
+        m_enabled = true;
+
+        amrex::ExecOnFinalize([] () {
+            cuptiActivityDisable(CUPTI_ACTIVITY_KIND_UNIFIED_MEMORY_COUNTER);
+            cuptiActivityFlushAll(0);
+            cuptiUnsubscribe(s_subscriber);
+            s_regions.clear();
+            s_region_stack.clear();
+            m_enabled = false;
+        });
+#else
+        WARPX_ABORT_WITH_MESSAGE(
+            "TransferAudit: WarpX must be compiled for CUDA with CUPTI (WarpX_CUPTI=ON or USE_CUPTI=TRUE)");
+#endif
+    }
+
+    void TransferAudit::Record (bool host_to_device, long long bytes)
+    {
+        if (!m_enabled) { return; }
+        const std::lock_guard<std::mutex> lock(s_mutex);
+        // The copies of the other threads can not be attributed to the regions of the master thread
+        auto const& region = (isMasterThread() && !s_region_stack.empty()) ?
+            *s_region_stack.back() : unattributed_region;
+        auto& transfers = s_regions[region];
+        if (host_to_device) {
+            ++transfers.htod_copies;
+            transfers.htod_bytes += bytes;
+        } else {
+            ++transfers.dtoh_copies;
+            transfers.dtoh_bytes += bytes;
+        }
+    }
+
+    void TransferAudit::PushRegion (std::string const& name)
+    {
+        const std::lock_guard<std::mutex> lock(s_mutex);
+        s_region_stack.push_back(&name);
+    }
+
+    void TransferAudit::PopRegion (std::string const& name)
+    {
+        const std::lock_guard<std::mutex> lock(s_mutex);
+        // the regions started and stopped explicitly are not necessarily nested
+        const auto it = std::find(s_region_stack.rbegin(), s_region_stack.rend(), &name);
+        if (it != s_region_stack.rend()) { s_region_stack.erase(std::next(it).base()); }
+    }
+
+    std::map<std::string, RegionTransfers> TransferAudit::GetAndReset ()
+    {
+        std::map<std::string, RegionTransfers> regions;
+        const std::lock_guard<std::mutex> lock(s_mutex);
+        std::swap(regions, s_regions);
+        return regions;
+    }
+
+    ManagedMemoryEvents TransferAudit::GetAndResetManagedMemory ()
+    {
+#ifdef WARPX_USE_CUPTI
+        // deliver the pending activity records
+        if (m_enabled) { cuptiActivityFlushAll(0); }
+#endif
+        const std::lock_guard<std::mutex> lock(s_mutex);
+        return std::exchange(s_managed, ManagedMemoryEvents{});
+    }
+
+    Region::Region (std::string const& name, bool start_now)
+        : m_name{name}
+    {
+        if (start_now) { start(); }
+    }
+
+    Region::~Region ()
+    {
+        stop();
+    }
+
+    void Region::start ()
+    {
+        if (!TransferAudit::IsEnabled() || !isMasterThread() || m_running) { return; }
+        m_running = true;
+        TransferAudit::PushRegion(m_name);
+    }
+
+    void Region::stop ()
+    {
+        if (!m_running) { return; }
+        m_running = false;
+        TransferAudit::PopRegion(m_name);
+    }
+}
@@ -58,6 +58,7 @@ const std::map<std::string, int> electrostatic_solver_algo_to_int = {
 const std::map<std::string, int> poisson_solver_algo_to_int = {
     {"multigrid", PoissonSolverAlgo::Multigrid},
     {"fft", PoissonSolverAlgo::IntegratedGreenFunction},
+    {"spectral", PoissonSolverAlgo::Spectral},
     {"default", PoissonSolverAlgo::Multigrid }
 };
 
@@ -71,6 +72,7 @@ const std::map<std::string, int> particle_pusher_algo_to_int = {
 const std::map<std::string, int> current_deposition_algo_to_int = {
     {"esirkepov",  CurrentDepositionAlgo::Esirkepov },
     {"direct",     CurrentDepositionAlgo::Direct },
+    {"direct_blocked", CurrentDepositionAlgo::DirectBlocked },
     {"vay",        CurrentDepositionAlgo::Vay },
     {"villasenor", CurrentDepositionAlgo::Villasenor },
     {"default",    CurrentDepositionAlgo::Esirkepov } // NOTE: overwritten for PSATD and Hybrid-PIC below
@@ -108,6 +110,7 @@ const std::map<std::string, int> rho_in_time_to_int = {
 const std::map<std::string, int> load_balance_costs_update_algo_to_int = {
     {"timers",    LoadBalanceCostsUpdateAlgo::Timers },
     {"heuristic", LoadBalanceCostsUpdateAlgo::Heuristic },
+    {"adaptive",  LoadBalanceCostsUpdateAlgo::Adaptive },
     {"default",   LoadBalanceCostsUpdateAlgo::Timers }
 };
 
@@ -20,6 +20,7 @@
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXProfilerWrapper.H"
 
+#include <ablastr/utils/CommStats.H>
 #include <ablastr/utils/Communication.H>
 
 #include <AMReX_Array.H>
@@ -463,6 +464,7 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
 {
     using namespace amrex::literals;
     WARPX_PROFILE("WarpX::shiftMF()");
+    const ablastr::utils::communication::ScopedCommSite comm_site("shiftMF");
     const amrex::BoxArray& ba = mf.boxArray();
     const amrex::DistributionMapping& dm = mf.DistributionMap();
     const int nc = mf.nComp();
@@ -470,8 +472,15 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
 
     AMREX_ALWAYS_ASSERT(ng[dir] >= num_shift);
 
+    // On CPU, the data is shifted in place, by looping over the cells in the order in which
+    // each cell is read before being overwritten. On GPU, the cells are updated concurrently,
+    // so that the data is first copied to a temporary MultiFab.
+#ifdef AMREX_USE_GPU
     amrex::MultiFab tmpmf(ba, dm, nc, ng);
     amrex::MultiFab::Copy(tmpmf, mf, 0, 0, nc, ng);
+#else
+    amrex::MultiFab& tmpmf = mf;
+#endif
 
     if ( WarpX::safe_guard_cells ) {
         // Fill guard cells.
@@ -584,10 +593,32 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
         } else {
             dstBox.growLo(dir,  num_shift);
         }
+#ifdef AMREX_USE_GPU
         AMREX_PARALLEL_FOR_4D ( dstBox, nc, i, j, k, n,
         {
             dstfab(i,j,k,n) = srcfab(i+shift.x,j+shift.y,k+shift.z,n);
         })
+#else
+        // Loop forward when the data moves toward lower indices, backward otherwise
+        const amrex::Dim3 lo = amrex::lbound(dstBox);
+        const amrex::Dim3 hi = amrex::ubound(dstBox);
+        if (num_shift > 0) {
+            for (int n = 0; n < nc; ++n) {
+            for (int k = lo.z; k <= hi.z; ++k) {
+            for (int j = lo.y; j <= hi.y; ++j) {
+            AMREX_PRAGMA_SIMD
+            for (int i = lo.x; i <= hi.x; ++i) {
+                dstfab(i,j,k,n) = srcfab(i+shift.x,j+shift.y,k+shift.z,n);
+            }}}}
+        } else {
+            for (int n = 0; n < nc; ++n) {
+            for (int k = hi.z; k >= lo.z; --k) {
+            for (int j = hi.y; j >= lo.y; --j) {
+            for (int i = hi.x; i >= lo.x; --i) {
+                dstfab(i,j,k,n) = srcfab(i+shift.x,j+shift.y,k+shift.z,n);
+            }}}}
+        }
+#endif
 
         if (cost && update_cost_flag &&
             WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
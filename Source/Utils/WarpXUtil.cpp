@@ -499,3 +499,16 @@ namespace WarpXUtilLoadBalance
         return consistent;
     }
 }
+
+namespace WarpXUtilMemory
+{
+    amrex::Long MemoryUsage (const amrex::MultiFab& mf)
+    {
+        if (!mf.isDefined()) { return 0; }
+        amrex::Long bytes = 0;
+        for (int i = 0; i < mf.local_size(); ++i) {
+            bytes += mf.atLocalIdx(i).nBytesOwned();
+        }
+        return bytes;
+    }
+}
@@ -30,11 +30,14 @@
 #include "FieldSolver/WarpX_FDTD.H"
 #include "Filter/NCIGodfreyFilter.H"
 #include "Initialization/ExternalField.H"
+#include "Parallelization/GridSizeAutotuner.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Fluids/MultiFluidContainer.H"
 #include "Fluids/WarpXFluidContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
+#include "Particles/TileSizeAutotuner.H"
 #include "AcceleratorLattice/AcceleratorLattice.H"
+#include "Utils/GpuGraph.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
@@ -43,6 +46,7 @@
 
 #include "FieldSolver/ImplicitSolvers/ImplicitSolverLibrary.H"
 
+#include <ablastr/fields/PoissonSolver.H>
 #include <ablastr/utils/SignalHandling.H>
 #include <ablastr/warn_manager/WarnManager.H>
 
@@ -78,11 +82,16 @@
 #include <AMReX_SPACE.H>
 #include <AMReX_iMultiFab.H>
 
+#ifdef AMREX_USE_OMP
+#   include <omp.h>
+#endif
+
 #include <algorithm>
 #include <cmath>
 #include <limits>
 #include <optional>
 #include <random>
+#include <sstream>
 #include <string>
 #include <utility>
 
@@ -96,6 +105,7 @@ int WarpX::moving_window_dir = -1;
 Real WarpX::moving_window_v = std::numeric_limits<amrex::Real>::max();
 
 bool WarpX::fft_do_time_averaging = false;
+bool WarpX::fft_do_batched = false;
 
 amrex::IntVect WarpX::m_fill_guards_fields  = amrex::IntVect(0);
 amrex::IntVect WarpX::m_fill_guards_current = amrex::IntVect(0);
@@ -138,6 +148,14 @@ amrex::IntVect WarpX::shared_tilesize(AMREX_D_DECL(14,14,0));
 amrex::IntVect WarpX::shared_tilesize(AMREX_D_DECL(1,1,1));
 #endif
 int WarpX::shared_mem_current_tpb = 128;
+bool WarpX::do_shared_mem_field_gather = false;
+int WarpX::shared_mem_gather_tpb = 128;
+int WarpX::blocked_deposition_chunk_size = 8;
+amrex::IntVect WarpX::blocked_deposition_supercell_size(AMREX_D_DECL(4,4,4));
+bool WarpX::do_fused_push_deposit = false;
+bool WarpX::do_vectorized_push = true;
+bool WarpX::do_qed_chi_prefilter = false;
+bool WarpX::use_counter_based_rng = false;
 
 amrex::Vector<FieldBoundaryType> WarpX::field_boundary_lo(AMREX_SPACEDIM,FieldBoundaryType::PML);
 amrex::Vector<FieldBoundaryType> WarpX::field_boundary_hi(AMREX_SPACEDIM,FieldBoundaryType::PML);
@@ -186,20 +204,38 @@ bool WarpX::sort_particles_for_deposition = false;
 #endif
 
 amrex::IntVect WarpX::sort_idx_type(AMREX_D_DECL(0,0,0));
+bool WarpX::sort_incremental = false;
+bool WarpX::sort_morton_order = false;
+bool WarpX::batch_particle_launches = false;
+bool WarpX::tight_current_guard_sum = false;
 
 bool WarpX::do_dynamic_scheduling = true;
+bool WarpX::numa_aware = false;
 
 int WarpX::electrostatic_solver_id;
 int WarpX::poisson_solver_id;
+bool WarpX::igf_distributed_fft = false;
 Real WarpX::self_fields_required_precision = 1.e-11_rt;
 Real WarpX::self_fields_absolute_tolerance = 0.0_rt;
 int WarpX::self_fields_max_iters = 200;
 int WarpX::self_fields_verbosity = 2;
+bool WarpX::self_fields_reuse_operator = false;
+bool WarpX::self_fields_extrapolate_guess = false;
+bool WarpX::gather_E_from_phi = false;
+Real WarpX::self_fields_beta_tolerance = 0.0_rt;
 
 bool WarpX::do_subcycling = false;
 bool WarpX::do_multi_J = false;
 int WarpX::do_multi_J_n_depositions;
 bool WarpX::safe_guard_cells = false;
+bool WarpX::overlap_comm_compute = false;
+int WarpX::fdtd_temporal_blocking = 1;
+bool WarpX::fdtd_fused_leapfrog = false;
+bool WarpX::fdtd_fuse_divergence_cleaning = false;
+bool WarpX::overlap_level_field_solves = false;
+bool WarpX::use_gpu_graphs = false;
+bool WarpX::skip_quiescent_boxes = false;
+int WarpX::fdtd_fused_block_size = 8;
 
 std::map<std::string, amrex::MultiFab *> WarpX::multifab_map;
 std::map<std::string, amrex::iMultiFab *> WarpX::imultifab_map;
@@ -310,6 +346,23 @@ WarpX::WarpX ()
     // Particle Boundary Buffer (i.e., scraped particles on boundary)
     m_particle_boundary_buffer = std::make_unique<ParticleBoundaryBuffer>();
 
+    // Autotuning of the particle tile size (after the particle containers read do_tiling)
+    m_tile_size_autotuner = std::make_unique<TileSizeAutotuner>();
+
+    // Autotuning of the grid size of level 0
+    m_grid_size_autotuner = std::make_unique<GridSizeAutotuner>();
+    if (m_grid_size_autotuner->isEnabled()) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            max_level == 0 && !isAnyBoundaryPML() && numprocs == amrex::IntVect(0),
+            "warpx.grid_size_autotune is not implemented with mesh refinement, PML or warpx.numprocs");
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            evolve_scheme == EvolveScheme::Explicit && !use_fdtd_nci_corr && !do_fluid_species &&
+            electromagnetic_solver_id != ElectromagneticSolverAlgo::HybridPIC &&
+            electrostatic_solver_id != ElectrostaticSolverAlgo::LabFrameElectroMagnetostatic,
+            "warpx.grid_size_autotune is only implemented for the explicit electromagnetic and"
+            " electrostatic solvers, without the NCI corrector or fluid species");
+    }
+
     // Fluid Container
     if (do_fluid_species) {
         myfl = std::make_unique<MultiFluidContainer>(nlevs_max);
@@ -322,6 +375,7 @@ WarpX::WarpX ()
     G_fp.resize(nlevs_max);
     rho_fp.resize(nlevs_max);
     phi_fp.resize(nlevs_max);
+    m_phi_fp_previous.resize(nlevs_max);
     current_fp.resize(nlevs_max);
     Efield_fp.resize(nlevs_max);
     Bfield_fp.resize(nlevs_max);
@@ -347,6 +401,7 @@ WarpX::WarpX ()
     m_edge_lengths.resize(nlevs_max);
     m_face_areas.resize(nlevs_max);
     m_distance_to_eb.resize(nlevs_max);
+    m_near_eb_box.resize(nlevs_max);
     m_flag_info_face.resize(nlevs_max);
     m_flag_ext_face.resize(nlevs_max);
     m_borrowing.resize(nlevs_max);
@@ -388,6 +443,10 @@ WarpX::WarpX ()
 
     Efield_cax.resize(nlevs_max);
     Bfield_cax.resize(nlevs_max);
+    Efield_aux_nci.resize(nlevs_max);
+    Bfield_aux_nci.resize(nlevs_max);
+    Efield_cax_nci.resize(nlevs_max);
+    Bfield_cax_nci.resize(nlevs_max);
     current_buffer_masks.resize(nlevs_max);
     gather_buffer_masks.resize(nlevs_max);
     current_buf.resize(nlevs_max);
@@ -415,7 +474,8 @@ WarpX::WarpX ()
     // Default values listed here for the case AMREX_USE_GPU are determined
     // from single-GPU tests on Summit.
     if (costs_heuristic_cells_wt<=0. && costs_heuristic_particles_wt<=0.
-        && WarpX::load_balance_costs_update_algo==LoadBalanceCostsUpdateAlgo::Heuristic)
+        && (WarpX::load_balance_costs_update_algo==LoadBalanceCostsUpdateAlgo::Heuristic
+            || WarpX::load_balance_costs_update_algo==LoadBalanceCostsUpdateAlgo::Adaptive))
     {
 #ifdef AMREX_USE_GPU
         if (WarpX::electromagnetic_solver_id == ElectromagneticSolverAlgo::PSATD) {
@@ -658,6 +718,7 @@ WarpX::ReadParameters ()
 
         utils::parser::queryWithParser(pp_warpx, "cfl", cfl);
         pp_warpx.query("verbose", verbose);
+        pp_warpx.query("dry_run_performance", m_dry_run_performance);
         utils::parser::queryWithParser(pp_warpx, "regrid_int", regrid_int);
         pp_warpx.query("do_subcycling", do_subcycling);
         pp_warpx.query("do_multi_J", do_multi_J);
@@ -668,14 +729,23 @@ WarpX::ReadParameters ()
         }
         pp_warpx.query("use_hybrid_QED", use_hybrid_QED);
         pp_warpx.query("safe_guard_cells", safe_guard_cells);
+        pp_warpx.query("overlap_comm_compute", overlap_comm_compute);
+        utils::parser::queryWithParser(pp_warpx, "fdtd_temporal_blocking", fdtd_temporal_blocking);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fdtd_temporal_blocking >= 1,
+            "warpx.fdtd_temporal_blocking must be at least 1");
+        pp_warpx.query("fdtd_fused_leapfrog", fdtd_fused_leapfrog);
+        pp_warpx.query("fdtd_fuse_divergence_cleaning", fdtd_fuse_divergence_cleaning);
+        pp_warpx.query("overlap_level_field_solves", overlap_level_field_solves);
+        pp_warpx.query("use_gpu_graphs", use_gpu_graphs);
+        pp_warpx.query("skip_quiescent_boxes", skip_quiescent_boxes);
+        utils::parser::queryWithParser(pp_warpx, "fdtd_fused_block_size", fdtd_fused_block_size);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fdtd_fused_block_size >= 1,
+            "warpx.fdtd_fused_block_size must be at least 1");
         std::vector<std::string> override_sync_intervals_string_vec = {"1"};
         pp_warpx.queryarr("override_sync_intervals", override_sync_intervals_string_vec);
         override_sync_intervals =
             utils::parser::IntervalsParser(override_sync_intervals_string_vec);
 
-        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(do_subcycling != 1 || max_level <= 1,
-                                         "Subcycling method 1 only works for 2 levels.");
-
         ReadBoostedFrameParameters(gamma_boost, beta_boost, boost_direction);
 
         // queryWithParser returns 1 if argument zmax_plasma_to_compute_max_step is
@@ -753,6 +823,35 @@ WarpX::ReadParameters ()
             utils::parser::queryWithParser(
                 pp_warpx, "self_fields_max_iters", self_fields_max_iters);
             pp_warpx.query("self_fields_verbosity", self_fields_verbosity);
+            pp_warpx.query("self_fields_reuse_operator", self_fields_reuse_operator);
+            pp_warpx.query("self_fields_extrapolate_guess", self_fields_extrapolate_guess);
+            if (self_fields_reuse_operator) {
+                m_poisson_solver_cache = std::make_unique<ablastr::fields::PoissonSolverCache>();
+            }
+        }
+        if (electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrame)
+        {
+            pp_warpx.query("gather_E_from_phi", gather_E_from_phi);
+            if (gather_E_from_phi) {
+#if defined(WARPX_DIM_RZ) || defined(AMREX_USE_EB)
+                WARPX_ABORT_WITH_MESSAGE(
+                    "warpx.gather_E_from_phi is not implemented in RZ geometry and with embedded boundaries");
+#endif
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(max_level == 0,
+                    "warpx.gather_E_from_phi is not implemented with mesh refinement");
+                // The E and B fields on the grid are then not seen by the particles
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                    m_p_ext_field_params->E_ext_grid_type == ExternalFieldType::default_zero &&
+                    m_p_ext_field_params->B_ext_grid_type == ExternalFieldType::default_zero,
+                    "warpx.gather_E_from_phi cannot be used with external fields on the grid");
+            }
+        }
+        if (electrostatic_solver_id == ElectrostaticSolverAlgo::Relativistic)
+        {
+            utils::parser::queryWithParser(
+                pp_warpx, "self_fields_beta_tolerance", self_fields_beta_tolerance);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(self_fields_beta_tolerance >= 0._rt,
+                "warpx.self_fields_beta_tolerance must be non-negative");
         }
 
         poisson_solver_id = GetAlgorithmInteger(pp_warpx, "poisson_solver");
@@ -775,6 +874,33 @@ WarpX::ReadParameters ()
         "The FFT Poisson solver is not implemented in labframe-electromagnetostatic mode yet."
         );
 
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        poisson_solver_id!=PoissonSolverAlgo::Spectral ||
+        electrostatic_solver_id!=ElectrostaticSolverAlgo::LabFrameElectroMagnetostatic,
+        "The spectral Poisson solver is not implemented in labframe-electromagnetostatic mode yet."
+        );
+#if !(defined(WARPX_DIM_3D) || defined(WARPX_DIM_XZ))
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        poisson_solver_id!=PoissonSolverAlgo::Spectral,
+        "The spectral Poisson solver only works in 3D and 2D Cartesian geometry.");
+#endif
+#ifndef WARPX_USE_FFT
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        poisson_solver_id!=PoissonSolverAlgo::Spectral,
+        "To use the spectral Poisson solver, compile with WARPX_USE_FFT=ON.");
+#endif
+#ifdef AMREX_USE_EB
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        poisson_solver_id!=PoissonSolverAlgo::Spectral,
+        "The spectral Poisson solver does not support embedded boundaries.");
+#endif
+
+        pp_warpx.query("igf_distributed_fft", igf_distributed_fft);
+#ifndef WARPX_USE_HEFFTE
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!igf_distributed_fft,
+            "warpx.igf_distributed_fft requires WarpX to be built with heFFTe (WarpX_HEFFTE=ON)");
+#endif
+
         // Parse the input file for domain boundary potentials
         const ParmParse pp_boundary("boundary");
         bool potential_specified = false;
@@ -881,6 +1007,31 @@ WarpX::ReadParameters ()
                 "requested shared memory for current deposition, but shared memory is only available for CUDA or HIP");
 #endif
         pp_warpx.query("shared_mem_current_tpb", shared_mem_current_tpb);
+        pp_warpx.query("do_shared_mem_field_gather", do_shared_mem_field_gather);
+#if !(defined(AMREX_USE_HIP) || defined(AMREX_USE_CUDA))
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_shared_mem_field_gather,
+                "requested shared memory for field gather, but shared memory is only available for CUDA or HIP");
+#endif
+#ifdef WARPX_DIM_RZ
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_shared_mem_field_gather,
+                "shared memory field gather is not implemented in RZ geometry");
+#endif
+        pp_warpx.query("shared_mem_gather_tpb", shared_mem_gather_tpb);
+        utils::parser::queryWithParser(
+            pp_warpx, "blocked_deposition_chunk_size", blocked_deposition_chunk_size);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(blocked_deposition_chunk_size > 0,
+            "warpx.blocked_deposition_chunk_size must be positive");
+        Vector<int> vect_supercell_size(AMREX_SPACEDIM, 4);
+        if (utils::parser::queryArrWithParser(pp_warpx, "blocked_deposition_supercell_size",
+                                              vect_supercell_size, 0, AMREX_SPACEDIM)) {
+            for (int i=0; i<AMREX_SPACEDIM; i++) {
+                blocked_deposition_supercell_size[i] = vect_supercell_size[i];
+            }
+        }
+        pp_warpx.query("do_fused_push_deposit", do_fused_push_deposit);
+        pp_warpx.query("do_vectorized_push", do_vectorized_push);
+        pp_warpx.query("do_qed_chi_prefilter", do_qed_chi_prefilter);
+        pp_warpx.query("use_counter_based_rng", use_counter_based_rng);
 
         // initialize the shared tilesize
         Vector<int> vect_shared_tilesize(AMREX_SPACEDIM, 1);
@@ -1062,6 +1213,29 @@ WarpX::ReadParameters ()
 
         pp_warpx.query("do_dynamic_scheduling", do_dynamic_scheduling);
 
+        pp_warpx.query("numa_aware", numa_aware);
+        if (numa_aware) {
+#ifdef AMREX_USE_GPU
+            ablastr::warn_manager::WMRecordWarning("Performance",
+                "warpx.numa_aware is ignored on GPU",
+                ablastr::warn_manager::WarnPriority::low);
+            numa_aware = false;
+#else
+            // The memory pages are placed on the NUMA domain of the thread that touches
+            // them first: the tiles are assigned to the threads in the same way in all loops
+            do_dynamic_scheduling = false;
+#   ifdef AMREX_USE_OMP
+            if (omp_get_proc_bind() == omp_proc_bind_false) {
+                ablastr::warn_manager::WMRecordWarning("Performance",
+                    "warpx.numa_aware is used, but the OpenMP threads are not bound to cores: "
+                    "set e.g. OMP_PROC_BIND=close and OMP_PLACES=cores, and bind the MPI ranks "
+                    "to the sockets with the MPI launcher.",
+                    ablastr::warn_manager::WarnPriority::medium);
+            }
+#   endif
+#endif
+        }
+
         // Integer that corresponds to the type of grid used in the simulation
         // (collocated, staggered, hybrid)
         grid_type = static_cast<short>(GetAlgorithmInteger(pp_warpx, "grid_type"));
@@ -1205,12 +1379,51 @@ WarpX::ReadParameters ()
         }
 
         // implicit evolve schemes not setup to use mirrors
+        if (use_gpu_graphs) {
+#if !defined(AMREX_USE_CUDA) && !defined(AMREX_USE_HIP)
+            WARPX_ABORT_WITH_MESSAGE("warpx.use_gpu_graphs requires a CUDA or HIP build");
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                (electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC) &&
+                evolve_scheme == EvolveScheme::Explicit &&
+                em_solver_medium == MediumForEM::Vacuum && fdtd_temporal_blocking == 1,
+                "warpx.use_gpu_graphs is only implemented for the explicit Yee and CKC"
+                " solvers, in vacuum, without warpx.fdtd_temporal_blocking");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(amrex::Gpu::numGpuStreams() == 1,
+                "warpx.use_gpu_graphs requires amrex.max_gpu_streams = 1");
+        }
+
+        if (overlap_level_field_solves) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                (electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC) &&
+                evolve_scheme == EvolveScheme::Explicit && fdtd_temporal_blocking == 1,
+                "warpx.overlap_level_field_solves is only implemented for the explicit Yee and CKC"
+                " solvers, without warpx.fdtd_temporal_blocking");
+        }
+
         if (evolve_scheme == EvolveScheme::SemiImplicitEM ||
             evolve_scheme == EvolveScheme::ThetaImplicitEM) {
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE( num_mirrors == 0,
                 "Mirrors cannot be used with Implicit evolve schemes.");
         }
 
+        // Sum the guard cells of the current of all but the last species
+        // while the last species deposits its current
+        const ParmParse pp_warpx("warpx");
+        pp_warpx.query("overlap_sum_boundary_J", m_overlap_sum_boundary_J);
+        if (m_overlap_sum_boundary_J) {
+#ifdef WARPX_DIM_RZ
+            WARPX_ABORT_WITH_MESSAGE("warpx.overlap_sum_boundary_J is not implemented in RZ geometry");
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                max_level == 0 && evolve_scheme == EvolveScheme::Explicit &&
+                electromagnetic_solver_id != ElectromagneticSolverAlgo::PSATD && !do_current_centering,
+                "warpx.overlap_sum_boundary_J can only be used without mesh refinement, "
+                "with the explicit evolve scheme and a finite-difference solver");
+        }
+
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
             current_deposition_algo != CurrentDepositionAlgo::Esirkepov ||
             !do_current_centering,
@@ -1309,6 +1522,83 @@ WarpX::ReadParameters ()
             macroscopic_solver_algo = GetAlgorithmInteger(pp_algo,"macroscopic_sigma_method");
         }
 
+        if (fdtd_temporal_blocking > 1) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                (electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC) &&
+                grid_type != GridType::Collocated &&
+                evolve_scheme == EvolveScheme::Explicit &&
+                em_solver_medium == MediumForEM::Vacuum,
+                "warpx.fdtd_temporal_blocking > 1 is only implemented for the explicit Yee and CKC"
+                " solvers on staggered grids, in vacuum");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                max_level == 0 && !do_moving_window && !do_dive_cleaning && !do_divb_cleaning &&
+                !safe_guard_cells,
+                "warpx.fdtd_temporal_blocking > 1 is not implemented with mesh refinement,"
+                " the moving window, divergence cleaning or warpx.safe_guard_cells");
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                    (field_boundary_lo[idim] == FieldBoundaryType::Periodic ||
+                     field_boundary_lo[idim] == FieldBoundaryType::PEC) &&
+                    (field_boundary_hi[idim] == FieldBoundaryType::Periodic ||
+                     field_boundary_hi[idim] == FieldBoundaryType::PEC),
+                    "warpx.fdtd_temporal_blocking > 1 is only implemented with periodic or PEC field boundaries");
+            }
+        }
+
+        if (fdtd_fused_leapfrog) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                (electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC) &&
+                grid_type != GridType::Collocated &&
+                evolve_scheme == EvolveScheme::Explicit &&
+                em_solver_medium == MediumForEM::Vacuum,
+                "warpx.fdtd_fused_leapfrog is only implemented for the explicit Yee and CKC"
+                " solvers on staggered grids, in vacuum");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                max_level == 0 && !do_moving_window && !do_dive_cleaning && !do_divb_cleaning,
+                "warpx.fdtd_fused_leapfrog is not implemented with mesh refinement,"
+                " the moving window or divergence cleaning");
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                    field_boundary_lo[idim] == FieldBoundaryType::Periodic &&
+                    field_boundary_hi[idim] == FieldBoundaryType::Periodic,
+                    "warpx.fdtd_fused_leapfrog is only implemented with periodic field boundaries");
+            }
+        }
+
+        if (fdtd_fuse_divergence_cleaning) {
+#ifdef WARPX_DIM_RZ
+            WARPX_ABORT_WITH_MESSAGE(
+                "warpx.fdtd_fuse_divergence_cleaning is not implemented in RZ geometry");
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                (electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC) &&
+                evolve_scheme == EvolveScheme::Explicit &&
+                em_solver_medium == MediumForEM::Vacuum,
+                "warpx.fdtd_fuse_divergence_cleaning is only implemented for the explicit Yee and CKC"
+                " solvers, in vacuum");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!use_gpu_graphs,
+                "warpx.fdtd_fuse_divergence_cleaning is not implemented with warpx.use_gpu_graphs");
+        }
+
+        if (skip_quiescent_boxes) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                (electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC) &&
+                evolve_scheme == EvolveScheme::Explicit &&
+                em_solver_medium == MediumForEM::Vacuum,
+                "warpx.skip_quiescent_boxes is only implemented for the explicit Yee and CKC"
+                " solvers, in vacuum");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                max_level == 0 && !do_dive_cleaning && !do_divb_cleaning &&
+                fdtd_temporal_blocking == 1 && !fdtd_fused_leapfrog && !use_gpu_graphs,
+                "warpx.skip_quiescent_boxes is not implemented with mesh refinement,"
+                " divergence cleaning, warpx.fdtd_temporal_blocking, warpx.fdtd_fused_leapfrog"
+                " or warpx.use_gpu_graphs");
+        }
+
         if (evolve_scheme == EvolveScheme::SemiImplicitEM ||
             evolve_scheme == EvolveScheme::ThetaImplicitEM) {
 
@@ -1338,6 +1628,14 @@ WarpX::ReadParameters ()
         pp_algo.queryarr("load_balance_intervals", load_balance_intervals_string_vec);
         load_balance_intervals = utils::parser::IntervalsParser(
             load_balance_intervals_string_vec);
+        pp_algo.query("load_balance_incremental", load_balance_incremental);
+        if (load_balance_incremental) {
+            utils::parser::queryWithParser(pp_algo, "load_balance_incremental_tolerance",
+                load_balance_incremental_tolerance);
+            utils::parser::queryWithParser(pp_algo, "load_balance_incremental_max_moved_boxes",
+                load_balance_incremental_max_moved_boxes);
+        }
+        pp_algo.query("load_balance_topology_aware", load_balance_topology_aware);
         pp_algo.query("load_balance_with_sfc", load_balance_with_sfc);
         // Knapsack factor only used with non-SFC strategy
         if (!load_balance_with_sfc) {
@@ -1346,12 +1644,24 @@ WarpX::ReadParameters ()
         utils::parser::queryWithParser(pp_algo, "load_balance_efficiency_ratio_threshold",
                         load_balance_efficiency_ratio_threshold);
         load_balance_costs_update_algo = static_cast<short>(GetAlgorithmInteger(pp_algo, "load_balance_costs_update"));
-        if (WarpX::load_balance_costs_update_algo==LoadBalanceCostsUpdateAlgo::Heuristic) {
+        if (WarpX::load_balance_costs_update_algo==LoadBalanceCostsUpdateAlgo::Heuristic
+            || WarpX::load_balance_costs_update_algo==LoadBalanceCostsUpdateAlgo::Adaptive) {
             utils::parser::queryWithParser(
                 pp_algo, "costs_heuristic_cells_wt", costs_heuristic_cells_wt);
             utils::parser::queryWithParser(
                 pp_algo, "costs_heuristic_particles_wt", costs_heuristic_particles_wt);
         }
+        if (WarpX::load_balance_costs_update_algo==LoadBalanceCostsUpdateAlgo::Adaptive) {
+            std::vector<std::string> costs_calibration_intervals_string_vec = {"0"};
+            pp_algo.queryarr("costs_calibration_intervals", costs_calibration_intervals_string_vec);
+            costs_calibration_intervals = utils::parser::IntervalsParser(
+                costs_calibration_intervals_string_vec);
+            utils::parser::queryWithParser(
+                pp_algo, "costs_adaptive_decay", costs_adaptive_decay);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                costs_adaptive_decay >= 0._rt && costs_adaptive_decay < 1._rt,
+                "algo.costs_adaptive_decay must be in [0, 1)");
+        }
 
         // Parse algo.particle_shape and check that input is acceptable
         // (do this only if there is at least one particle or laser species)
@@ -1437,6 +1747,22 @@ WarpX::ReadParameters ()
                 sort_idx_type[i] = vect_sort_idx_type[i];
             }
         }
+        pp_warpx.query("sort_incremental", sort_incremental);
+        std::string sort_bin_order = "linear";
+        pp_warpx.query("sort_bin_order", sort_bin_order);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(sort_bin_order == "linear" || sort_bin_order == "morton",
+            "warpx.sort_bin_order must be linear or morton");
+        sort_morton_order = (sort_bin_order == "morton");
+        // The incremental sort uses the bins of the cell centered grid
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            !(sort_incremental || sort_morton_order) || !sort_particles_for_deposition ||
+            sort_idx_type == amrex::IntVect(AMREX_D_DECL(0,0,0)),
+            "warpx.sort_idx_type must be 0 (cell centered) when warpx.sort_particles_for_deposition "
+            "is combined with warpx.sort_incremental or warpx.sort_bin_order = morton");
+
+        pp_warpx.query("batch_particle_launches", batch_particle_launches);
+
+        pp_warpx.query("tight_current_guard_sum", tight_current_guard_sum);
 
     }
 
@@ -1482,6 +1808,16 @@ WarpX::ReadParameters ()
     {
         const ParmParse pp_psatd("psatd");
         pp_psatd.query("periodic_single_box_fft", fft_periodic_single_box);
+        pp_psatd.query("distributed_fft", fft_distributed);
+        if (fft_distributed) {
+#if defined(WARPX_DIM_RZ) || defined(WARPX_DIM_1D_Z)
+            WARPX_ABORT_WITH_MESSAGE(
+                "psatd.distributed_fft is only implemented in 2D and 3D Cartesian geometry");
+#endif
+            // The distributed FFT is a global FFT over the periodic domain, without
+            // guard cells, as with periodic_single_box_fft, but decomposed in several boxes
+            fft_periodic_single_box = true;
+        }
 
         std::string nox_str;
         std::string noy_str;
@@ -1565,6 +1901,7 @@ WarpX::ReadParameters ()
         }
 
         pp_psatd.query("do_time_averaging", fft_do_time_averaging);
+        pp_psatd.query("do_batched_fft", fft_do_batched);
 
         if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Vay)
         {
@@ -2083,6 +2420,10 @@ WarpX::ClearLevel (int lev)
 
         Efield_cax[lev][i].reset();
         Bfield_cax[lev][i].reset();
+        Efield_aux_nci[lev][i].reset();
+        Bfield_aux_nci[lev][i].reset();
+        Efield_cax_nci[lev][i].reset();
+        Bfield_cax_nci[lev][i].reset();
         current_buf[lev][i].reset();
     }
 
@@ -2100,6 +2441,8 @@ WarpX::ClearLevel (int lev)
     G_fp  [lev].reset();
     rho_fp[lev].reset();
     phi_fp[lev].reset();
+    m_phi_fp_previous[lev].reset();
+    if (m_poisson_solver_cache) { m_poisson_solver_cache->clear(); }
     F_cp  [lev].reset();
     G_cp  [lev].reset();
     rho_cp[lev].reset();
@@ -2152,7 +2495,10 @@ WarpX::AllocLevelData (int lev, const BoxArray& ba, const DistributionMapping& d
         WarpX::pml_ncell,
         this->refRatio(),
         use_filter,
-        bilinear_filter.stencil_length_each_dir);
+        bilinear_filter.stencil_length_each_dir,
+        WarpX::fdtd_temporal_blocking,
+        WarpX::fdtd_fused_leapfrog,
+        (m_hybrid_pic_model) ? m_hybrid_pic_model->m_substeps_per_exchange : 0);
 
 
 #ifdef AMREX_USE_EB
@@ -2189,6 +2535,31 @@ WarpX::AllocLevelData (int lev, const BoxArray& ba, const DistributionMapping& d
 
 }
 
+namespace
+{
+    /** Print the guard cells of the nodal auxiliary grid, and the memory saved by not
+     *  allocating as many guard cells as for the fine patch
+     *
+     * @param[in] nba nodal box array of the auxiliary grid
+     * @param[in] ng_fp guard cells of the fine patch
+     * @param[in] ng_aux guard cells of the auxiliary grid
+     * @param[in] ncomps total number of components of the auxiliary fields
+     */
+    void PrintAuxGuardCellsReport (const amrex::BoxArray& nba, const amrex::IntVect& ng_fp,
+                                   const amrex::IntVect& ng_aux, int ncomps)
+    {
+        amrex::Long saved_points = 0;
+        for (int i = 0; i < static_cast<int>(nba.size()); ++i) {
+            saved_points += amrex::grow(nba[i], ng_fp).numPts() - amrex::grow(nba[i], ng_aux).numPts();
+        }
+        const double saved_MB = static_cast<double>(saved_points) * ncomps * sizeof(amrex::Real) / 1.e6;
+        std::stringstream ss;
+        ss << "Guard cells of the auxiliary E and B fields: " << ng_aux
+           << " (fine patch: " << ng_fp << "), saving " << saved_MB << " MB in total";
+        amrex::Print() << Utils::TextMsg::Info(ss.str());
+    }
+}
+
 void
 WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm,
                       const IntVect& ngEB, IntVect& ngJ, const IntVect& ngRho,
@@ -2390,6 +2761,7 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
     constexpr int nc_ls = 1;
     amrex::IntVect ng_ls(2);
     AllocInitMultiFab(m_distance_to_eb[lev], amrex::convert(ba, IntVect::TheNodeVector()), dm, nc_ls, ng_ls, lev, "m_distance_to_eb");
+    m_near_eb_box[lev] = std::make_unique<amrex::LayoutData<int>>(ba, dm);
 
     // EB info are needed only at the finest level
     if (lev == maxLevel())
@@ -2455,11 +2827,13 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
     if (electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrame ||
         electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameElectroMagnetostatic)
     {
-        const IntVect ngPhi = IntVect( AMREX_D_DECL(1,1,1) );
+        // With gather_E_from_phi, the particles gather the gradient of phi in the guard
+        // cells of E, which needs one more guard cell of phi
+        const IntVect ngPhi = gather_E_from_phi ? ngEB + 1 : IntVect( AMREX_D_DECL(1,1,1) );
         AllocInitMultiFab(phi_fp[lev], amrex::convert(ba, phi_nodal_flag), dm, ncomps, ngPhi, lev, "phi_fp", 0.0_rt);
     }
 
-    if (do_subcycling == 1 && lev == 0)
+    if (do_subcycling == 1 && lev < max_level)
     {
         AllocInitMultiFab(current_store[lev][0], amrex::convert(ba,jx_nodal_flag),dm,ncomps,ngJ,lev, "current_store[x]");
         AllocInitMultiFab(current_store[lev][1], amrex::convert(ba,jy_nodal_flag),dm,ncomps,ngJ,lev, "current_store[y]");
@@ -2492,10 +2866,18 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
                 && ba.size() == 1 && lev == 0, // domain is decomposed in a single box
                 "The option `psatd.periodic_single_box_fft` can only be used for a periodic domain, decomposed in a single box");
 #   else
-            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-                geom[0].isAllPeriodic()        // domain is periodic in all directions
-                && ba.size() == 1 && lev == 0, // domain is decomposed in a single box
-                "The option `psatd.periodic_single_box_fft` can only be used for a periodic domain, decomposed in a single box");
+            if (fft_distributed) {
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                    geom[0].isAllPeriodic()  // domain is periodic in all directions
+                    && lev == 0 && max_level == 0
+                    && ba.size() == ParallelDescriptor::NProcs(), // one box per MPI rank
+                    "The option `psatd.distributed_fft` can only be used for a periodic domain, without mesh refinement, decomposed in one box per MPI rank");
+            } else {
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                    geom[0].isAllPeriodic()        // domain is periodic in all directions
+                    && ba.size() == 1 && lev == 0, // domain is decomposed in a single box
+                    "The option `psatd.periodic_single_box_fft` can only be used for a periodic domain, decomposed in a single box");
+            }
 #   endif
         }
         // Get the cell-centered box
@@ -2542,13 +2924,17 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
         // Create aux multifabs on Nodal Box Array
         BoxArray const nba = amrex::convert(ba,IntVect::TheNodeVector());
 
-        AllocInitMultiFab(Bfield_aux[lev][0], nba, dm, ncomps, ngEB, lev, "Bfield_aux[x]", 0.0_rt);
-        AllocInitMultiFab(Bfield_aux[lev][1], nba, dm, ncomps, ngEB, lev, "Bfield_aux[y]", 0.0_rt);
-        AllocInitMultiFab(Bfield_aux[lev][2], nba, dm, ncomps, ngEB, lev, "Bfield_aux[z]", 0.0_rt);
+        // Without mesh refinement, the aux grid only needs the guard cells read by the field gather
+        const IntVect ngAux = (lev == 0 && maxLevel() == 0) ? guard_cells.ng_alloc_aux : ngEB;
+        if (ngAux != ngEB && verbose) { PrintAuxGuardCellsReport(nba, ngEB, ngAux, 6*ncomps); }
+
+        AllocInitMultiFab(Bfield_aux[lev][0], nba, dm, ncomps, ngAux, lev, "Bfield_aux[x]", 0.0_rt);
+        AllocInitMultiFab(Bfield_aux[lev][1], nba, dm, ncomps, ngAux, lev, "Bfield_aux[y]", 0.0_rt);
+        AllocInitMultiFab(Bfield_aux[lev][2], nba, dm, ncomps, ngAux, lev, "Bfield_aux[z]", 0.0_rt);
 
-        AllocInitMultiFab(Efield_aux[lev][0], nba, dm, ncomps, ngEB, lev, "Efield_aux[x]", 0.0_rt);
-        AllocInitMultiFab(Efield_aux[lev][1], nba, dm, ncomps, ngEB, lev, "Efield_aux[y]", 0.0_rt);
-        AllocInitMultiFab(Efield_aux[lev][2], nba, dm, ncomps, ngEB, lev, "Efield_aux[z]", 0.0_rt);
+        AllocInitMultiFab(Efield_aux[lev][0], nba, dm, ncomps, ngAux, lev, "Efield_aux[x]", 0.0_rt);
+        AllocInitMultiFab(Efield_aux[lev][1], nba, dm, ncomps, ngAux, lev, "Efield_aux[y]", 0.0_rt);
+        AllocInitMultiFab(Efield_aux[lev][2], nba, dm, ncomps, ngAux, lev, "Efield_aux[z]", 0.0_rt);
     } else if (lev == 0) {
         if (!WarpX::fft_do_time_averaging) {
             // In this case, the aux grid is simply an alias of the fp grid
@@ -2820,6 +3206,7 @@ void WarpX::AllocLevelSpectralSolver (amrex::Vector<std::unique_ptr<SpectralSolv
                                                 solver_dt,
                                                 pml_flag,
                                                 fft_periodic_single_box,
+                                                fft_distributed,
                                                 update_with_rho,
                                                 fft_do_time_averaging,
                                                 psatd_solution_type,
@@ -3332,6 +3719,9 @@ WarpX::AllocInitMultiFab (
     mf = std::make_unique<amrex::MultiFab>(ba, dm, ncomp, ngrow, tag);
     if (initial_value) {
         mf->setVal(*initial_value);
+    } else if (numa_aware) {
+        // First touch by the threads that process the tiles
+        mf->setVal(0.0_rt);
     }
     multifab_map[name_with_suffix] = mf.get();
 }
@@ -3352,6 +3742,9 @@ WarpX::AllocInitMultiFab (
     mf = std::make_unique<amrex::iMultiFab>(ba, dm, ncomp, ngrow, tag);
     if (initial_value) {
         mf->setVal(*initial_value);
+    } else if (numa_aware) {
+        // First touch by the threads that process the tiles
+        mf->setVal(0);
     }
     imultifab_map[name_with_suffix] = mf.get();
 }
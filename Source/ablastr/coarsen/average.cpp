@@ -18,6 +18,7 @@
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
 
+#include <array>
 #include <memory>
 
 namespace ablastr::coarsen::average
@@ -82,4 +83,72 @@ namespace ablastr::coarsen::average
         Loop(mf_dst, mf_src, ncomp, ngrow, crse_ratio);
     }
 
+    void
+    Coarsen (
+        std::array<amrex::MultiFab*, 3> const & mf_dst,
+        std::array<amrex::MultiFab const*, 3> const & mf_src,
+        amrex::IntVect const crse_ratio
+    )
+    {
+        BL_PROFILE("ablastr::coarsen::Coarsen(3)");
+
+        const int ncomp = mf_src[0]->nComp();
+        std::array<amrex::GpuArray<int,3>, 3> sf, sc;
+        std::array<amrex::IntVect, 3> ngrow;
+        auto cr = amrex::GpuArray<int,3>{1,1,1}; // coarsening ratio
+        for (int i=0; i<AMREX_SPACEDIM; ++i) { cr[i] = crse_ratio[i]; }
+        for (int n = 0; n < 3; ++n) {
+            ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(mf_src[n]->ixType() == mf_dst[n]->ixType(),
+                                               "source MultiFab and destination MultiFab have different IndexType");
+            ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(
+                mf_src[n]->nComp() == ncomp && mf_dst[n]->nComp() == ncomp &&
+                mf_dst[n]->boxArray().CellEqual(mf_dst[0]->boxArray()) &&
+                mf_dst[n]->DistributionMap() == mf_dst[0]->DistributionMap(),
+                "Coarsen: the three MultiFabs must have the same layout");
+            // Number of guard cells to fill on coarse patch (round up int division)
+            ngrow[n] = (mf_src[n]->nGrowVect() + crse_ratio-1) / crse_ratio;
+            sf[n] = amrex::GpuArray<int,3>{0,0,0};
+            sc[n] = amrex::GpuArray<int,3>{0,0,0};
+            for (int i=0; i<AMREX_SPACEDIM; ++i) {
+                sf[n][i] = mf_src[n]->ixType()[i];
+                sc[n][i] = mf_dst[n]->ixType()[i];
+            }
+        }
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (amrex::MFIter mfi(*mf_dst[0], amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+            std::array<amrex::Box, 3> bx, cbx;
+            std::array<amrex::Array4<amrex::Real>, 3> arr_dst;
+            std::array<amrex::Array4<amrex::Real const>, 3> arr_src;
+            for (int n = 0; n < 3; ++n) {
+                const amrex::IntVect stag = mf_dst[n]->ixType().toIntVect();
+                // All the points of the tile (with guard cells), and the ones that are coarsened
+                bx[n] = mfi.tilebox(stag, mf_dst[n]->nGrowVect());
+                cbx[n] = mfi.tilebox(stag, ngrow[n]);
+                arr_dst[n] = mf_dst[n]->array(mfi);
+                arr_src[n] = mf_src[n]->const_array(mfi);
+            }
+            const auto sf0 = sf[0], sf1 = sf[1], sf2 = sf[2];
+            const auto sc0 = sc[0], sc1 = sc[1], sc2 = sc[2];
+            const auto cbx0 = cbx[0], cbx1 = cbx[1], cbx2 = cbx[2];
+            const auto dst0 = arr_dst[0], dst1 = arr_dst[1], dst2 = arr_dst[2];
+            const auto src0 = arr_src[0], src1 = arr_src[1], src2 = arr_src[2];
+            ParallelFor(bx[0], ncomp, bx[1], ncomp, bx[2], ncomp,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) {
+                    dst0(i, j, k, n) = cbx0.contains(i, j, k) ?
+                        Interp(src0, sf0, sc0, cr, i, j, k, n) : amrex::Real(0.);
+                },
+                [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) {
+                    dst1(i, j, k, n) = cbx1.contains(i, j, k) ?
+                        Interp(src1, sf1, sc1, cr, i, j, k, n) : amrex::Real(0.);
+                },
+                [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) {
+                    dst2(i, j, k, n) = cbx2.contains(i, j, k) ?
+                        Interp(src2, sf2, sc2, cr, i, j, k, n) : amrex::Real(0.);
+                });
+        }
+    }
+
 } // namespace ablastr::coarsen::average
@@ -9,6 +9,7 @@
 #include <ablastr/constant.H>
 #include <ablastr/warn_manager/WarnManager.H>
 #include <ablastr/math/fft/AnyFFT.H>
+#include <ablastr/utils/TextMsg.H>
 
 #include <AMReX_Array4.H>
 #include <AMReX_BaseFab.H>
@@ -19,27 +20,218 @@
 #include <AMReX_DistributionMapping.H>
 #include <AMReX_FabArray.H>
 #include <AMReX_GpuControl.H>
+#include <AMReX_GpuDevice.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_MLLinOp.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_REAL.H>
 
 #include <array>
+#include <complex>
+#include <numeric>
 
 
 namespace ablastr::fields {
 
+namespace
+{
+    using SpectralField = IGFGreenFunctionCache::SpectralField;
+
+    /** Define the boxes, distribution mapping and (if distributed) FFT plan of the
+     *  doubled domain of the convolution
+     */
+    void
+    defineDecomposition (IGFGreenFunctionCache & igf, amrex::Box const & realspace_box)
+    {
+        amrex::IntVect const n = realspace_box.length();
+        if (!igf.distributed) {
+            // The global FFT is performed on a single rank: one box
+            igf.realspace_ba = amrex::BoxArray( realspace_box );
+            igf.spectralspace_ba = amrex::BoxArray( amrex::Box(
+                {0,0,0},
+                {n[0]/2, n[1]-1, n[2]-1},
+                amrex::IntVect::TheNodeVector() ) );
+            igf.dm.define( igf.realspace_ba );
+            return;
+        }
+
+        // One slab along z per MPI rank, with the same slabs in real and spectral space
+        int const nprocs = amrex::ParallelDescriptor::NProcs();
+        ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(n[2] >= nprocs,
+            "The distributed IGF solver needs at least one cell along z per MPI rank");
+        amrex::BoxList real_boxes(amrex::IndexType::TheNodeType());
+        amrex::BoxList spectral_boxes(amrex::IndexType::TheNodeType());
+        for (int rank = 0; rank < nprocs; ++rank) {
+            int const klo = static_cast<int>((static_cast<long>(n[2])*rank)/nprocs);
+            int const khi = static_cast<int>((static_cast<long>(n[2])*(rank+1))/nprocs) - 1;
+            real_boxes.push_back( amrex::Box(
+                {realspace_box.smallEnd(0), realspace_box.smallEnd(1), realspace_box.smallEnd(2)+klo},
+                {realspace_box.bigEnd(0), realspace_box.bigEnd(1), realspace_box.smallEnd(2)+khi},
+                amrex::IntVect::TheNodeVector() ) );
+            spectral_boxes.push_back( amrex::Box(
+                {0, 0, klo}, {n[0]/2, n[1]-1, khi}, amrex::IntVect::TheNodeVector() ) );
+        }
+        igf.realspace_ba = amrex::BoxArray( real_boxes );
+        igf.spectralspace_ba = amrex::BoxArray( spectral_boxes );
+        amrex::Vector<int> pmap(nprocs);
+        std::iota(pmap.begin(), pmap.end(), 0);
+        igf.dm.define( std::move(pmap) );
+
+#ifdef ABLASTR_USE_HEFFTE
+        int const rank = amrex::ParallelDescriptor::MyProc();
+        amrex::Box const & real_slab = igf.realspace_ba[rank];
+        amrex::Box const & spectral_slab = igf.spectralspace_ba[rank];
+        // heFFTe boxes use global indices starting at 0, with the first index running fastest
+        heffte::box3d<> const inbox(
+            {0, 0, real_slab.smallEnd(2) - realspace_box.smallEnd(2)},
+            {n[0]-1, n[1]-1, real_slab.bigEnd(2) - realspace_box.smallEnd(2)});
+        heffte::box3d<> const outbox(
+            {0, 0, spectral_slab.smallEnd(2)},
+            {spectral_slab.bigEnd(0), spectral_slab.bigEnd(1), spectral_slab.bigEnd(2)});
+        // The real-to-complex FFT halves the first direction
+        int const r2c_direction = 0;
+        igf.distributed_plan = std::make_unique<heffte::fft3d_r2c<IGFGreenFunctionCache::heffte_backend>>(
+#   ifdef AMREX_USE_GPU
+            amrex::Gpu::gpuStream(),
+#   endif
+            inbox, outbox, r2c_direction, amrex::ParallelDescriptor::Communicator());
+#endif
+    }
+
+    /** Real-to-complex FFT over the doubled domain */
+    void
+    forwardFFT (IGFGreenFunctionCache & igf, amrex::MultiFab & real_field, SpectralField & spectral_field)
+    {
+        for ( amrex::MFIter mfi(igf.realspace_ba, igf.dm); mfi.isValid(); ++mfi ){
+#ifdef ABLASTR_USE_HEFFTE
+            if (igf.distributed) {
+                // Collective over all MPI ranks, which own exactly one slab each
+                igf.distributed_plan->forward(real_field[mfi].dataPtr(),
+                    reinterpret_cast<std::complex<amrex::Real>*>(spectral_field[mfi].dataPtr()));
+                continue;
+            }
+#endif
+            // Note: the size of the real-space box and spectral-space box
+            // differ when using real-to-complex FFT. When initializing
+            // the FFT plan, the valid dimensions are those of the real-space box.
+            const amrex::IntVect fft_size = igf.realspace_ba[mfi].length();
+            auto plan = ablastr::math::anyfft::CreatePlan(
+                fft_size, real_field[mfi].dataPtr(),
+                reinterpret_cast<ablastr::math::anyfft::Complex*>(spectral_field[mfi].dataPtr()),
+                ablastr::math::anyfft::direction::R2C, AMREX_SPACEDIM);
+            ablastr::math::anyfft::Execute(plan);
+            amrex::Gpu::streamSynchronize();
+            ablastr::math::anyfft::DestroyPlan(plan);
+        }
+    }
+
+    /** Complex-to-real FFT over the doubled domain (not normalized) */
+    void
+    backwardFFT (IGFGreenFunctionCache & igf, SpectralField & spectral_field, amrex::MultiFab & real_field)
+    {
+        for ( amrex::MFIter mfi(igf.realspace_ba, igf.dm); mfi.isValid(); ++mfi ){
+#ifdef ABLASTR_USE_HEFFTE
+            if (igf.distributed) {
+                igf.distributed_plan->backward(
+                    reinterpret_cast<std::complex<amrex::Real>*>(spectral_field[mfi].dataPtr()),
+                    real_field[mfi].dataPtr());
+                continue;
+            }
+#endif
+            const amrex::IntVect fft_size = igf.realspace_ba[mfi].length();
+            auto plan = ablastr::math::anyfft::CreatePlan(
+                fft_size, real_field[mfi].dataPtr(),
+                reinterpret_cast<ablastr::math::anyfft::Complex*>(spectral_field[mfi].dataPtr()),
+                ablastr::math::anyfft::direction::C2R, AMREX_SPACEDIM);
+            ablastr::math::anyfft::Execute(plan);
+            amrex::Gpu::streamSynchronize();
+            ablastr::math::anyfft::DestroyPlan(plan);
+        }
+    }
+
+    /** Fill the integrated Green function on the doubled domain and store its FFT */
+    void
+    computeGreenFunctionFFT (IGFGreenFunctionCache & igf, amrex::Box const & realspace_box)
+    {
+        using namespace amrex::literals;
+
+        BL_PROFILE("Initialize Green function");
+
+        amrex::MultiFab tmp_G = amrex::MultiFab(igf.realspace_ba, igf.dm, 1, 0);
+
+        amrex::IntVect const lo = realspace_box.smallEnd();
+        // Number of points of the original domain in each direction
+        amrex::IntVect const n = igf.domain.length();
+        amrex::Real const dx = igf.cell_size[0];
+        amrex::Real const dy = igf.cell_size[1];
+        amrex::Real const dz = igf.cell_size[2];
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (amrex::MFIter mfi(tmp_G, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+
+            amrex::Box const bx = mfi.tilebox();
+            amrex::Array4<amrex::Real> const tmp_G_arr = tmp_G.array(mfi);
+
+            // Each point of the doubled domain is filled independently, so that the
+            // domain can be split between MPI ranks: the second half of each direction
+            // holds the mirror image of the first half, and the middle plane is zero
+            amrex::ParallelFor( bx,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+                {
+                    int i0 = i - lo[0];
+                    int j0 = j - lo[1];
+                    int k0 = k - lo[2];
+                    if (i0 == n[0] || j0 == n[1] || k0 == n[2]) {
+                        tmp_G_arr(i,j,k) = 0._rt;
+                        return;
+                    }
+                    if (i0 > n[0]) { i0 = 2*n[0] - i0; }
+                    if (j0 > n[1]) { j0 = 2*n[1] - j0; }
+                    if (k0 > n[2]) { k0 = 2*n[2] - k0; }
+                    amrex::Real const x = i0*dx;
+                    amrex::Real const y = j0*dy;
+                    amrex::Real const z = k0*dz;
+
+                    tmp_G_arr(i,j,k) = 1._rt/(4._rt*ablastr::constant::math::pi*ablastr::constant::SI::ep0) * (
+                        IntegratedPotential( x+0.5_rt*dx, y+0.5_rt*dy, z+0.5_rt*dz )
+                      - IntegratedPotential( x-0.5_rt*dx, y+0.5_rt*dy, z+0.5_rt*dz )
+                      - IntegratedPotential( x+0.5_rt*dx, y-0.5_rt*dy, z+0.5_rt*dz )
+                      - IntegratedPotential( x+0.5_rt*dx, y+0.5_rt*dy, z-0.5_rt*dz )
+                      + IntegratedPotential( x+0.5_rt*dx, y-0.5_rt*dy, z-0.5_rt*dz )
+                      + IntegratedPotential( x-0.5_rt*dx, y+0.5_rt*dy, z-0.5_rt*dz )
+                      + IntegratedPotential( x-0.5_rt*dx, y-0.5_rt*dy, z+0.5_rt*dz )
+                      - IntegratedPotential( x-0.5_rt*dx, y-0.5_rt*dy, z-0.5_rt*dz )
+                    );
+                }
+            );
+        }
+
+        igf.G_fft = std::make_unique<SpectralField>( igf.spectralspace_ba, igf.dm, 1, 0 );
+        forwardFFT( igf, tmp_G, *igf.G_fft );
+    }
+}
+
 void
 computePhiIGF ( amrex::MultiFab const & rho,
                 amrex::MultiFab & phi,
                 std::array<amrex::Real, 3> const & cell_size,
-                amrex::BoxArray const & ba )
+                amrex::BoxArray const & ba,
+                bool const do_distributed_fft,
+                IGFGreenFunctionCache * cache )
 {
     using namespace amrex::literals;
 
+#ifndef ABLASTR_USE_HEFFTE
+    ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE( !do_distributed_fft,
+        "The distributed IGF solver requires a build with heFFTe (WarpX_HEFFTE=ON)");
+#endif
+
     // Define box that encompasses the full domain
     amrex::Box domain = ba.minimalBox();
     domain.surroundingNodes(); // get nodal points, since `phi` and `rho` are nodal
@@ -50,147 +242,51 @@ computePhiIGF ( amrex::MultiFab const & rho,
     int const nz = domain.length(2);
 
     // Allocate 2x wider arrays for the convolution of rho with the Green function
-    // This also defines the box arrays for the global FFT: contains only one box;
     amrex::Box const realspace_box = amrex::Box(
         {domain.smallEnd(0), domain.smallEnd(1), domain.smallEnd(2)},
         {2*nx-1+domain.smallEnd(0), 2*ny-1+domain.smallEnd(1), 2*nz-1+domain.smallEnd(2)},
         amrex::IntVect::TheNodeVector() );
-    amrex::BoxArray const realspace_ba = amrex::BoxArray( realspace_box );
-    amrex::Box const spectralspace_box = amrex::Box(
-        {0,0,0},
-        {nx, 2*ny-1, 2*nz-1},
-        amrex::IntVect::TheNodeVector() );
-    amrex::BoxArray const spectralspace_ba = amrex::BoxArray( spectralspace_box );
-    // Define a distribution mapping for the global FFT, with only one box
-    amrex::DistributionMapping dm_global_fft;
-    dm_global_fft.define( realspace_ba );
+
+    // The FFT of the Green function only changes with the domain size and the cell size
+    IGFGreenFunctionCache local_igf;
+    IGFGreenFunctionCache & igf = cache ? *cache : local_igf;
+    if (!igf.matches(domain, cell_size, do_distributed_fft)) {
+        igf.clear();
+        igf.domain = domain;
+        igf.cell_size = cell_size;
+        igf.distributed = do_distributed_fft;
+        defineDecomposition( igf, realspace_box );
+        computeGreenFunctionFFT( igf, realspace_box );
+    } else if (igf.domain.smallEnd() != domain.smallEnd()) {
+        // The domain moved (e.g., moving window): the spectral-space boxes and the FFT
+        // plans use indices relative to the domain, only the real-space boxes move
+        igf.realspace_ba.shift( domain.smallEnd() - igf.domain.smallEnd() );
+        igf.domain = domain;
+    }
+
     // Allocate required arrays
-    amrex::MultiFab tmp_rho = amrex::MultiFab(realspace_ba, dm_global_fft, 1, 0);
+    amrex::MultiFab tmp_rho = amrex::MultiFab(igf.realspace_ba, igf.dm, 1, 0);
     tmp_rho.setVal(0);
-    amrex::MultiFab tmp_G = amrex::MultiFab(realspace_ba, dm_global_fft, 1, 0);
-    tmp_G.setVal(0);
-    // Allocate corresponding arrays in Fourier space
-    using SpectralField = amrex::FabArray< amrex::BaseFab< amrex::GpuComplex< amrex::Real > > >;
-    SpectralField tmp_rho_fft = SpectralField( spectralspace_ba, dm_global_fft, 1, 0 );
-    SpectralField tmp_G_fft = SpectralField( spectralspace_ba, dm_global_fft, 1, 0 );
+    SpectralField tmp_rho_fft = SpectralField( igf.spectralspace_ba, igf.dm, 1, 0 );
 
     // Copy from rho to tmp_rho
     tmp_rho.ParallelCopy( rho, 0, 0, 1, amrex::IntVect::TheZeroVector(), amrex::IntVect::TheZeroVector() );
 
-    // Compute the integrated Green function
-    {
-    BL_PROFILE("Initialize Green function");
-    amrex::BoxArray const domain_ba = amrex::BoxArray( domain );
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
-#endif
-    for (amrex::MFIter mfi(domain_ba, dm_global_fft,amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+    // Perform forward FFT of rho
+    forwardFFT( igf, tmp_rho, tmp_rho_fft );
 
-        amrex::Box const bx = mfi.tilebox();
+    // Multiply tmp_rho_fft by the FFT of the Green function in spectral space
+    // Store the result in-place in tmp_rho_fft, since the Green function may be reused
+    amrex::Multiply( tmp_rho_fft, *igf.G_fft, 0, 0, 1, 0);
 
-        amrex::IntVect const lo = realspace_box.smallEnd();
-        amrex::IntVect const hi = realspace_box.bigEnd();
-
-        // Fill values of the Green function
-        amrex::Real const dx = cell_size[0];
-        amrex::Real const dy = cell_size[1];
-        amrex::Real const dz = cell_size[2];
-        amrex::Array4<amrex::Real> const tmp_G_arr = tmp_G.array(mfi);
-        amrex::ParallelFor( bx,
-            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
-            {
-                int const i0 = i - lo[0];
-                int const j0 = j - lo[1];
-                int const k0 = k - lo[2];
-                amrex::Real const x = i0*dx;
-                amrex::Real const y = j0*dy;
-                amrex::Real const z = k0*dz;
-
-                amrex::Real const G_value = 1._rt/(4._rt*ablastr::constant::math::pi*ablastr::constant::SI::ep0) * (
-                    IntegratedPotential( x+0.5_rt*dx, y+0.5_rt*dy, z+0.5_rt*dz )
-                  - IntegratedPotential( x-0.5_rt*dx, y+0.5_rt*dy, z+0.5_rt*dz )
-                  - IntegratedPotential( x+0.5_rt*dx, y-0.5_rt*dy, z+0.5_rt*dz )
-                  - IntegratedPotential( x+0.5_rt*dx, y+0.5_rt*dy, z-0.5_rt*dz )
-                  + IntegratedPotential( x+0.5_rt*dx, y-0.5_rt*dy, z-0.5_rt*dz )
-                  + IntegratedPotential( x-0.5_rt*dx, y+0.5_rt*dy, z-0.5_rt*dz )
-                  + IntegratedPotential( x-0.5_rt*dx, y-0.5_rt*dy, z+0.5_rt*dz )
-                  - IntegratedPotential( x-0.5_rt*dx, y-0.5_rt*dy, z-0.5_rt*dz )
-                );
-
-                tmp_G_arr(i,j,k) = G_value;
-                // Fill the rest of the array by periodicity
-                if (i0>0) {tmp_G_arr(hi[0]+1-i0, j         , k         ) = G_value;}
-                if (j0>0) {tmp_G_arr(i         , hi[1]+1-j0, k         ) = G_value;}
-                if (k0>0) {tmp_G_arr(i         , j         , hi[2]+1-k0) = G_value;}
-                if ((i0>0)&&(j0>0)) {tmp_G_arr(hi[0]+1-i0, hi[1]+1-j0, k         ) = G_value;}
-                if ((j0>0)&&(k0>0)) {tmp_G_arr(i         , hi[1]+1-j0, hi[2]+1-k0) = G_value;}
-                if ((i0>0)&&(k0>0)) {tmp_G_arr(hi[0]+1-i0, j         , hi[2]+1-k0) = G_value;}
-                if ((i0>0)&&(j0>0)&&(k0>0)) {tmp_G_arr(hi[0]+1-i0, hi[1]+1-j0, hi[2]+1-k0) = G_value;}
-            }
-        );
-    }
-    }
+    // Inverse FFT: is done in the array of rho
+    backwardFFT( igf, tmp_rho_fft, tmp_rho );
 
-    // Perform forward FFTs
-    auto forward_plan_rho = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm_global_fft);
-    auto forward_plan_G = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm_global_fft);
-    // Loop over boxes perform FFTs
-    for ( amrex::MFIter mfi(realspace_ba, dm_global_fft); mfi.isValid(); ++mfi ){
-
-        // Note: the size of the real-space box and spectral-space box
-        // differ when using real-to-complex FFT. When initializing
-        // the FFT plan, the valid dimensions are those of the real-space box.
-        const amrex::IntVect fft_size = realspace_ba[mfi].length();
-
-        // FFT of rho
-        forward_plan_rho[mfi] = ablastr::math::anyfft::CreatePlan(
-            fft_size, tmp_rho[mfi].dataPtr(),
-            reinterpret_cast<ablastr::math::anyfft::Complex*>(tmp_rho_fft[mfi].dataPtr()),
-            ablastr::math::anyfft::direction::R2C, AMREX_SPACEDIM);
-        ablastr::math::anyfft::Execute(forward_plan_rho[mfi]);
-
-        // FFT of G
-        forward_plan_G[mfi] = ablastr::math::anyfft::CreatePlan(
-            fft_size, tmp_G[mfi].dataPtr(),
-            reinterpret_cast<ablastr::math::anyfft::Complex*>(tmp_G_fft[mfi].dataPtr()),
-            ablastr::math::anyfft::direction::R2C, AMREX_SPACEDIM);
-        ablastr::math::anyfft::Execute(forward_plan_G[mfi]);
-
-    }
-
-    // Multiply tmp_G_fft and tmp_rho_fft in spectral space
-    // Store the result in-place in Gtmp_G_fft, to save memory
-    amrex::Multiply( tmp_G_fft, tmp_rho_fft, 0, 0, 1, 0);
-
-    // Perform inverse FFT
-    auto backward_plan = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm_global_fft);
-    // Loop over boxes perform FFTs
-    for ( amrex::MFIter mfi(spectralspace_ba, dm_global_fft); mfi.isValid(); ++mfi ){
-
-        // Note: the size of the real-space box and spectral-space box
-        // differ when using real-to-complex FFT. When initializing
-        // the FFT plan, the valid dimensions are those of the real-space box.
-        const amrex::IntVect fft_size = realspace_ba[mfi].length();
-
-        // Inverse FFT: is done in-place, in the array of G
-        backward_plan[mfi] = ablastr::math::anyfft::CreatePlan(
-            fft_size, tmp_G[mfi].dataPtr(),
-            reinterpret_cast<ablastr::math::anyfft::Complex*>( tmp_G_fft[mfi].dataPtr()),
-            ablastr::math::anyfft::direction::C2R, AMREX_SPACEDIM);
-        ablastr::math::anyfft::Execute(backward_plan[mfi]);
-    }
     // Normalize, since (FFT + inverse FFT) results in a factor N
     const amrex::Real normalization = 1._rt / realspace_box.numPts();
-    tmp_G.mult( normalization );
-
-    // Copy from tmp_G to phi
-    phi.ParallelCopy( tmp_G, 0, 0, 1, amrex::IntVect::TheZeroVector(), phi.nGrowVect() );
+    tmp_rho.mult( normalization );
 
-    // Loop to destroy FFT plans
-    for ( amrex::MFIter mfi(spectralspace_ba, dm_global_fft); mfi.isValid(); ++mfi ){
-        ablastr::math::anyfft::DestroyPlan(forward_plan_G[mfi]);
-        ablastr::math::anyfft::DestroyPlan(forward_plan_rho[mfi]);
-        ablastr::math::anyfft::DestroyPlan(backward_plan[mfi]);
-    }
+    // Copy from tmp_rho to phi
+    phi.ParallelCopy( tmp_rho, 0, 0, 1, amrex::IntVect::TheZeroVector(), phi.nGrowVect() );
 }
 } // namespace ablastr::fields
@@ -0,0 +1,275 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of ABLASTR.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "SpectralPoissonSolver.H"
+
+#include <ablastr/constant.H>
+#include <ablastr/math/fft/AnyFFT.H>
+#include <ablastr/profiler/ProfilerWrapper.H>
+#include <ablastr/utils/TextMsg.H>
+
+#include <AMReX.H>
+#include <AMReX_Array4.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <cmath>
+
+
+namespace ablastr::fields {
+
+namespace
+{
+    /** @brief Node of the nodal domain, and sign, that correspond to the point m of the
+     *         extended periodic domain along one direction
+     *
+     * @param[in] m index in the extended domain, between 0 and period-1
+     * @param[in] n number of cells of the nodal domain
+     * @param[in] period number of points of the extended domain: n (periodic),
+     *            2n (same condition on both ends) or 4n (Dirichlet on one end only)
+     * @param[in] dirichlet_lo whether the lower end is a Dirichlet boundary
+     * @param[in] dirichlet_hi whether the upper end is a Dirichlet boundary
+     * @param[out] sign multiplied by -1 for each odd reflection
+     * @return index of the node, relative to the lower end of the nodal domain
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    int
+    mirrorIndex (int m, int n, int period, bool dirichlet_lo, bool dirichlet_hi,
+                 amrex::Real & sign)
+    {
+        // Odd reflection about a Dirichlet end, even reflection about a Neumann end
+        amrex::Real const sign_lo = dirichlet_lo ? -1._rt : 1._rt;
+        amrex::Real const sign_hi = dirichlet_hi ? -1._rt : 1._rt;
+        if (period == n || m <= n) { return m; }
+        if (m <= 2*n) { sign *= sign_hi; return 2*n - m; }
+        // Quarter-wave extension, with different conditions on both ends
+        if (m <= 3*n) { sign = -sign; return m - 2*n; }
+        sign *= sign_lo;
+        return 4*n - m;
+    }
+
+    /** Whether the node iv is on a Dirichlet boundary of the nodal domain [lo, hi] */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    bool
+    isDirichletNode (amrex::IntVect const & iv, amrex::IntVect const & lo, amrex::IntVect const & hi,
+                     amrex::GpuArray<bool, AMREX_SPACEDIM> const & dirichlet_lo,
+                     amrex::GpuArray<bool, AMREX_SPACEDIM> const & dirichlet_hi)
+    {
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if ((dirichlet_lo[idim] && iv[idim] == lo[idim]) ||
+                (dirichlet_hi[idim] && iv[idim] == hi[idim])) { return true; }
+        }
+        return false;
+    }
+
+    /** Define the work arrays and FFT plans for the nodal domain `domain` */
+    void
+    definePlans (SpectralPoissonCache & cache, amrex::Box const & domain)
+    {
+        cache.clear();
+        cache.domain = domain;
+
+        amrex::IntVect period;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            int const n = domain.length(idim) - 1;
+            bool const periodic = cache.lobc[idim] == amrex::LinOpBCType::Periodic;
+            period[idim] = periodic ? n : ((cache.lobc[idim] == cache.hibc[idim]) ? 2*n : 4*n);
+        }
+        cache.period = period;
+
+        // All the arrays are on the I/O rank, where the FFTs are performed
+        cache.dm.define(amrex::Vector<int>{amrex::ParallelDescriptor::IOProcessorNumber()});
+
+        cache.rhs = std::make_unique<amrex::MultiFab>(amrex::BoxArray(domain), cache.dm, 1, 0);
+        cache.phi = std::make_unique<amrex::MultiFab>(amrex::BoxArray(domain), cache.dm, 1, 0);
+
+        amrex::Box const ext_box(amrex::IntVect(0), period - 1, amrex::IntVect::TheNodeVector());
+        amrex::IntVect spectral_hi = period - 1;
+        spectral_hi[0] = period[0]/2;
+        amrex::Box const spectral_box(amrex::IntVect(0), spectral_hi, amrex::IntVect::TheNodeVector());
+        cache.ext = std::make_unique<amrex::MultiFab>(amrex::BoxArray(ext_box), cache.dm, 1, 0);
+        cache.ext_fft = std::make_unique<SpectralPoissonCache::SpectralField>(
+            amrex::BoxArray(spectral_box), cache.dm, 1, 0);
+
+        for (amrex::MFIter mfi(*cache.ext); mfi.isValid(); ++mfi) {
+            cache.forward_plan = ablastr::math::anyfft::CreatePlan(
+                period, (*cache.ext)[mfi].dataPtr(),
+                reinterpret_cast<ablastr::math::anyfft::Complex*>((*cache.ext_fft)[mfi].dataPtr()),
+                ablastr::math::anyfft::direction::R2C, AMREX_SPACEDIM);
+            cache.backward_plan = ablastr::math::anyfft::CreatePlan(
+                period, (*cache.ext)[mfi].dataPtr(),
+                reinterpret_cast<ablastr::math::anyfft::Complex*>((*cache.ext_fft)[mfi].dataPtr()),
+                ablastr::math::anyfft::direction::C2R, AMREX_SPACEDIM);
+            cache.has_plans = true;
+        }
+    }
+}
+
+void
+SpectralPoissonCache::clear ()
+{
+    if (has_plans) {
+        ablastr::math::anyfft::DestroyPlan(forward_plan);
+        ablastr::math::anyfft::DestroyPlan(backward_plan);
+        has_plans = false;
+    }
+    rhs.reset();
+    phi.reset();
+    ext.reset();
+    ext_fft.reset();
+}
+
+void
+computePhiSpectral (amrex::MultiFab const & rho,
+                    amrex::MultiFab & phi,
+                    amrex::Geometry const & geom,
+                    amrex::Array<amrex::Real, AMREX_SPACEDIM> const & sigma,
+                    amrex::Array<amrex::LinOpBCType, AMREX_SPACEDIM> const & lobc,
+                    amrex::Array<amrex::LinOpBCType, AMREX_SPACEDIM> const & hibc,
+                    SpectralPoissonCache * cache)
+{
+    using namespace amrex::literals;
+
+    ABLASTR_PROFILE("computePhiSpectral");
+
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        for (auto const bc : {lobc[idim], hibc[idim]}) {
+            ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(
+                bc == amrex::LinOpBCType::Periodic || bc == amrex::LinOpBCType::Dirichlet ||
+                bc == amrex::LinOpBCType::Neumann,
+                "The spectral Poisson solver only supports periodic, Dirichlet and Neumann boundaries");
+        }
+        ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(
+            (lobc[idim] == amrex::LinOpBCType::Periodic) == (hibc[idim] == amrex::LinOpBCType::Periodic),
+            "The spectral Poisson solver needs periodic boundaries on both ends of a direction");
+    }
+
+    amrex::Box const domain = amrex::surroundingNodes(geom.Domain());
+
+    // The work arrays and plans only change with the size of the domain and the boundaries
+    SpectralPoissonCache local_cache;
+    SpectralPoissonCache & spc = cache ? *cache : local_cache;
+    if (!spc.matches(domain, lobc, hibc)) {
+        spc.lobc = lobc;
+        spc.hibc = hibc;
+        definePlans(spc, domain);
+    } else if (spc.domain.smallEnd() != domain.smallEnd()) {
+        // The domain moved (e.g., moving window): the extended domain uses indices
+        // relative to the domain, only the arrays of the nodal domain move
+        spc.domain = domain;
+        spc.rhs = std::make_unique<amrex::MultiFab>(amrex::BoxArray(domain), spc.dm, 1, 0);
+        spc.phi = std::make_unique<amrex::MultiFab>(amrex::BoxArray(domain), spc.dm, 1, 0);
+    }
+
+    // Gather rho, and phi with its Dirichlet boundary values, on the rank of the FFTs
+    spc.rhs->ParallelCopy( rho, 0, 0, 1, amrex::IntVect::TheZeroVector(), amrex::IntVect::TheZeroVector() );
+    spc.phi->ParallelCopy( phi, 0, 0, 1, amrex::IntVect::TheZeroVector(), amrex::IntVect::TheZeroVector() );
+
+    amrex::IntVect const lo = domain.smallEnd();
+    amrex::IntVect const hi = domain.bigEnd();
+    amrex::IntVect const period = spc.period;
+    amrex::GpuArray<bool, AMREX_SPACEDIM> dirichlet_lo, dirichlet_hi;
+    amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> coef;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        dirichlet_lo[idim] = lobc[idim] == amrex::LinOpBCType::Dirichlet;
+        dirichlet_hi[idim] = hibc[idim] == amrex::LinOpBCType::Dirichlet;
+        coef[idim] = sigma[idim] / (geom.CellSize(idim)*geom.CellSize(idim));
+    }
+    amrex::Real const inv_ep0 = 1._rt / ablastr::constant::SI::ep0;
+    amrex::Real const normalization = 1._rt / static_cast<amrex::Real>(amrex::Box(
+        amrex::IntVect(0), period - 1).numPts());
+
+    for (amrex::MFIter mfi(*spc.ext); mfi.isValid(); ++mfi) {
+        amrex::Array4<amrex::Real> const rhs_arr = spc.rhs->array(mfi);
+        amrex::Array4<amrex::Real> const phi_arr = spc.phi->array(mfi);
+        amrex::Array4<amrex::Real> const ext_arr = spc.ext->array(mfi);
+        amrex::Array4<amrex::GpuComplex<amrex::Real>> const fft_arr = spc.ext_fft->array(mfi);
+
+        // Right-hand side on the nodes that are solved for: the Dirichlet boundary
+        // values are moved to the right-hand side, and the Dirichlet nodes are zero
+        amrex::ParallelFor( domain,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                amrex::ignore_unused(j, k);
+                amrex::IntVect const iv(AMREX_D_DECL(i,j,k));
+                if (isDirichletNode(iv, lo, hi, dirichlet_lo, dirichlet_hi)) {
+                    rhs_arr(iv) = 0._rt;
+                    return;
+                }
+                amrex::Real r = -rhs_arr(iv)*inv_ep0;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    for (int s = -1; s <= 1; s += 2) {
+                        amrex::IntVect ivn = iv;
+                        ivn[idim] += s;
+                        if (ivn[idim] >= lo[idim] && ivn[idim] <= hi[idim] && isDirichletNode(ivn, lo, hi, dirichlet_lo, dirichlet_hi)) {
+                            r -= coef[idim]*phi_arr(ivn);
+                        }
+                    }
+                }
+                rhs_arr(iv) = r;
+            });
+
+        // Extend the right-hand side to the periodic domain
+        amrex::Box const ext_box = (*spc.ext)[mfi].box();
+        amrex::ParallelFor( ext_box,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                amrex::ignore_unused(j, k);
+                amrex::IntVect const m(AMREX_D_DECL(i,j,k));
+                amrex::IntVect iv;
+                amrex::Real sign = 1._rt;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    iv[idim] = lo[idim] + mirrorIndex(m[idim], hi[idim] - lo[idim], period[idim],
+                                                      dirichlet_lo[idim], dirichlet_hi[idim], sign);
+                }
+                ext_arr(m) = sign*rhs_arr(iv);
+            });
+
+        ablastr::math::anyfft::Execute(spc.forward_plan);
+
+        // Divide each mode by the eigenvalue of the discrete Laplacian (and normalize
+        // the FFTs); the constant mode of a fully periodic or Neumann domain is zero
+        amrex::ParallelFor( (*spc.ext_fft)[mfi].box(),
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                amrex::ignore_unused(j, k);
+                amrex::IntVect const kv(AMREX_D_DECL(i,j,k));
+                amrex::Real eigenvalue = 0._rt;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    amrex::Real const theta = 2._rt*ablastr::constant::math::pi*kv[idim]/period[idim];
+                    eigenvalue -= coef[idim]*(2._rt - 2._rt*std::cos(theta));
+                }
+                fft_arr(kv) = (kv == amrex::IntVect(0)) ? amrex::GpuComplex<amrex::Real>{0._rt, 0._rt}
+                                                         : fft_arr(kv)*(normalization/eigenvalue);
+            });
+
+        ablastr::math::anyfft::Execute(spc.backward_plan);
+
+        // Potential on the nodes that are solved for; the last node of a periodic
+        // direction is the first one
+        amrex::ParallelFor( domain,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                amrex::ignore_unused(j, k);
+                amrex::IntVect const iv(AMREX_D_DECL(i,j,k));
+                if (isDirichletNode(iv, lo, hi, dirichlet_lo, dirichlet_hi)) { return; }
+                amrex::IntVect m = iv - lo;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    if (m[idim] == period[idim]) { m[idim] = 0; }
+                }
+                phi_arr(iv) = ext_arr(m);
+            });
+    }
+
+    // Scatter phi back to the grids of the level
+    phi.ParallelCopy( *spc.phi, 0, 0, 1, amrex::IntVect::TheZeroVector(), amrex::IntVect::TheZeroVector() );
+    phi.FillBoundary( geom.periodicity() );
+}
+
+} // namespace ablastr::fields
@@ -10,6 +10,16 @@
 #include "ablastr/utils/TextMsg.H"
 #include "ablastr/profiler/ProfilerWrapper.H"
 
+#include <AMReX_Arena.H>
+#include <AMReX_GpuDevice.H>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
 namespace ablastr::math::anyfft
 {
 
@@ -27,40 +37,89 @@ namespace ablastr::math::anyfft
 
     std::string cufftErrorToString (const cufftResult& err);
 
+    namespace
+    {
+        /** Plan shared by all the boxes of the same shape */
+        struct CachedPlan
+        {
+            cufftHandle plan; /**< cuFFT plan, created without its own work area */
+            std::size_t work_size = 0; /**< size of the work area needed by the plan */
+            int count = 0; /**< number of FFTplan that use this plan */
+        };
+
+        /** Shape, direction, dimensionality and number of transforms of a plan */
+        using PlanKey = std::tuple<std::array<int,3>, direction, int, int>;
+
+        std::map<PlanKey, CachedPlan> s_plans;
+
+        /** Work areas shared by all the plans, one per GPU stream, since the boxes
+         *  transformed on the same stream are transformed in sequence */
+        std::vector<void*> s_work_areas;
+        std::size_t s_work_size = 0;
+
+        void assert_cufft_result (std::string const& name, cufftResult const& result)
+        {
+            ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(result == CUFFT_SUCCESS,
+                name + " failed! Error: " + cufftErrorToString(result));
+        }
+
+        void free_work_areas ()
+        {
+            for (auto* work_area : s_work_areas) {
+                if (work_area) { amrex::The_Arena()->free(work_area); }
+            }
+            s_work_areas.clear();
+            s_work_size = 0;
+        }
+    }
+
     FFTplan CreatePlan(const amrex::IntVect& real_size, amrex::Real * const real_array,
-                       Complex * const complex_array, const direction dir, const int dim)
+                       Complex * const complex_array, const direction dir, const int dim,
+                       const int howmany)
     {
         FFTplan fft_plan;
         ABLASTR_PROFILE("ablastr::math::anyfft::CreatePlan");
 
-        // Initialize fft_plan.m_plan with the vendor fft plan.
-        cufftResult result;
-        if (dir == direction::R2C){
-            if (dim == 3) {
-                result = cufftPlan3d(
-                    &(fft_plan.m_plan), real_size[2], real_size[1], real_size[0], VendorR2C);
-            } else if (dim == 2) {
-                result = cufftPlan2d(
-                    &(fft_plan.m_plan), real_size[1], real_size[0], VendorR2C);
-            } else {
-                ABLASTR_ABORT_WITH_MESSAGE("only dim=2 and dim=3 have been implemented");
-            }
-        } else {
-            if (dim == 3) {
-                result = cufftPlan3d(
-                    &(fft_plan.m_plan), real_size[2], real_size[1], real_size[0], VendorC2R);
-            } else if (dim == 2) {
-                result = cufftPlan2d(
-                    &(fft_plan.m_plan), real_size[1], real_size[0], VendorC2R);
+        if (dim != 2 && dim != 3) {
+            ABLASTR_ABORT_WITH_MESSAGE("only dim=2 and dim=3 have been implemented");
+        }
+
+        // Swap dimensions: AMReX FAB are Fortran-order but cuFFT is C-order
+        int n[3] = {0, 0, 0};
+        for (int d = 0; d < dim; ++d) { n[d] = real_size[dim-1-d]; }
+
+        // Reuse the plan of a box of the same shape, if any
+        const PlanKey key{{n[0], n[1], n[2]}, dir, dim, howmany};
+        auto& cached = s_plans[key];
+        if (cached.count == 0) {
+            // Distance between two consecutive transforms, in the real and complex arrays
+            int real_dist = 1;
+            for (int d = 0; d < dim; ++d) { real_dist *= real_size[d]; }
+            const int complex_dist = (real_dist / real_size[0]) * (real_size[0]/2 + 1);
+
+            // Initialize the vendor fft plan, without allocating its work area
+            assert_cufft_result("cufftCreate", cufftCreate(&(cached.plan)));
+            assert_cufft_result("cufftSetAutoAllocation", cufftSetAutoAllocation(cached.plan, 0));
+            cufftResult result;
+            if (dir == direction::R2C){
+                result = cufftMakePlanMany(
+                    cached.plan, dim, n,
+                    nullptr, 1, real_dist,
+                    nullptr, 1, complex_dist,
+                    VendorR2C, howmany, &(cached.work_size));
             } else {
-                ABLASTR_ABORT_WITH_MESSAGE("only dim=2 and dim=3 have been implemented");
+                result = cufftMakePlanMany(
+                    cached.plan, dim, n,
+                    nullptr, 1, complex_dist,
+                    nullptr, 1, real_dist,
+                    VendorC2R, howmany, &(cached.work_size));
             }
+            assert_cufft_result("cufftplan", result);
         }
-
-        ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(result == CUFFT_SUCCESS,
-            "cufftplan failed! Error: " + cufftErrorToString(result));
+        ++cached.count;
 
         // Store meta-data in fft_plan
+        fft_plan.m_plan = cached.plan;
         fft_plan.m_real_array = real_array;
         fft_plan.m_complex_array = complex_array;
         fft_plan.m_dir = dir;
@@ -72,14 +131,38 @@ namespace ablastr::math::anyfft
     void DestroyPlan(FFTplan& fft_plan)
     {
         ABLASTR_PROFILE("ablastr::math::anyfft::DestroyPlan");
-        cufftDestroy( fft_plan.m_plan );
+        for (auto it = s_plans.begin(); it != s_plans.end(); ++it) {
+            if (it->second.plan != fft_plan.m_plan) { continue; }
+            if (--(it->second.count) == 0) {
+                cufftDestroy( it->second.plan );
+                s_plans.erase(it);
+            }
+            break;
+        }
+        if (s_plans.empty()) { free_work_areas(); }
     }
 
     void Execute(FFTplan& fft_plan){
         ABLASTR_PROFILE("ablastr::math::anyfft::Execute");
+
+        // Work area of the current stream, grown to the largest size needed by the plans
+        std::size_t work_size = 0;
+        for (auto const& [key, cached] : s_plans) {
+            work_size = std::max(work_size, cached.work_size);
+        }
+        if (work_size > s_work_size) {
+            amrex::Gpu::streamSynchronizeAll();
+            free_work_areas();
+            s_work_size = work_size;
+        }
+        s_work_areas.resize(amrex::Gpu::numGpuStreams(), nullptr);
+        void*& work_area = s_work_areas[amrex::Gpu::Device::streamIndex()];
+        if (!work_area && s_work_size > 0) { work_area = amrex::The_Arena()->alloc(s_work_size); }
+
         // make sure that this is done on the same GPU stream as the above copy
         cudaStream_t stream = amrex::Gpu::Device::cudaStream();
         cufftSetStream ( fft_plan.m_plan, stream);
+        cufftSetWorkArea ( fft_plan.m_plan, work_area);
         cufftResult result;
         if (fft_plan.m_dir == direction::R2C){
 #ifdef AMREX_USE_FLOAT
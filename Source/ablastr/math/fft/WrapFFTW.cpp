@@ -13,6 +13,10 @@
 #include <AMReX_IntVect.H>
 #include <AMReX_REAL.H>
 
+#include <array>
+#include <map>
+#include <tuple>
+
 namespace ablastr::math::anyfft
 {
 
@@ -21,19 +25,35 @@ namespace ablastr::math::anyfft
     void cleanup(){/*nothing to do*/}
 
 #ifdef AMREX_USE_FLOAT
-    const auto VendorCreatePlanR2C3D = fftwf_plan_dft_r2c_3d;
-    const auto VendorCreatePlanC2R3D = fftwf_plan_dft_c2r_3d;
-    const auto VendorCreatePlanR2C2D = fftwf_plan_dft_r2c_2d;
-    const auto VendorCreatePlanC2R2D = fftwf_plan_dft_c2r_2d;
+    const auto VendorCreatePlanR2CMany = fftwf_plan_many_dft_r2c;
+    const auto VendorCreatePlanC2RMany = fftwf_plan_many_dft_c2r;
+    const auto VendorAlignmentOf = fftwf_alignment_of;
 #else
-    const auto VendorCreatePlanR2C3D = fftw_plan_dft_r2c_3d;
-    const auto VendorCreatePlanC2R3D = fftw_plan_dft_c2r_3d;
-    const auto VendorCreatePlanR2C2D = fftw_plan_dft_r2c_2d;
-    const auto VendorCreatePlanC2R2D = fftw_plan_dft_c2r_2d;
+    const auto VendorCreatePlanR2CMany = fftw_plan_many_dft_r2c;
+    const auto VendorCreatePlanC2RMany = fftw_plan_many_dft_c2r;
+    const auto VendorAlignmentOf = fftw_alignment_of;
 #endif
 
+    namespace
+    {
+        /** Plan shared by all the boxes of the same shape */
+        struct CachedPlan
+        {
+            VendorFFTPlan plan = nullptr;
+            int count = 0; /**< number of FFTplan that use this plan */
+        };
+
+        /** Shape, direction, dimensionality and number of transforms of a plan, and
+         *  alignment of its arrays: a plan can only be executed on other arrays that
+         *  have the same alignment as the arrays it was created with */
+        using PlanKey = std::tuple<std::array<int,3>, direction, int, int, int, int>;
+
+        std::map<PlanKey, CachedPlan> s_plans;
+    }
+
     FFTplan CreatePlan(const amrex::IntVect& real_size, amrex::Real * const real_array,
-                       Complex * const complex_array, const direction dir, const int dim)
+                       Complex * const complex_array, const direction dir, const int dim,
+                       const int howmany)
     {
         FFTplan fft_plan;
 
@@ -47,31 +67,40 @@ namespace ablastr::math::anyfft
 #   endif
 #endif
 
-        // Initialize fft_plan.m_plan with the vendor fft plan.
+        if (dim != 2 && dim != 3) {
+            ABLASTR_ABORT_WITH_MESSAGE(
+                "only dim=2 and dim=3 have been implemented. Should be easy to add dim=1.");
+        }
+
         // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
-        if (dir == direction::R2C){
-            if (dim == 3) {
-                fft_plan.m_plan = VendorCreatePlanR2C3D(
-                    real_size[2], real_size[1], real_size[0], real_array, complex_array, FFTW_ESTIMATE);
-            } else if (dim == 2) {
-                fft_plan.m_plan = VendorCreatePlanR2C2D(
-                    real_size[1], real_size[0], real_array, complex_array, FFTW_ESTIMATE);
-            } else {
-                ABLASTR_ABORT_WITH_MESSAGE(
-                    "only dim=2 and dim=3 have been implemented");
-            }
-        } else if (dir == direction::C2R){
-            if (dim == 3) {
-                fft_plan.m_plan = VendorCreatePlanC2R3D(
-                    real_size[2], real_size[1], real_size[0], complex_array, real_array, FFTW_ESTIMATE);
-            } else if (dim == 2) {
-                fft_plan.m_plan = VendorCreatePlanC2R2D(
-                    real_size[1], real_size[0], complex_array, real_array, FFTW_ESTIMATE);
-            } else {
-                ABLASTR_ABORT_WITH_MESSAGE(
-                    "only dim=2 and dim=3 have been implemented. Should be easy to add dim=1.");
+        int n[3] = {0, 0, 0};
+        for (int d = 0; d < dim; ++d) { n[d] = real_size[dim-1-d]; }
+
+        // Reuse the plan of a box of the same shape, if any
+        const PlanKey key{{n[0], n[1], n[2]}, dir, dim, howmany,
+            VendorAlignmentOf(real_array), VendorAlignmentOf(reinterpret_cast<amrex::Real*>(complex_array))};
+        auto& cached = s_plans[key];
+        if (cached.count == 0) {
+            // Distance between two consecutive transforms, in the real and complex arrays
+            int real_dist = 1;
+            for (int d = 0; d < dim; ++d) { real_dist *= real_size[d]; }
+            const int complex_dist = (real_dist / real_size[0]) * (real_size[0]/2 + 1);
+
+            // Initialize the vendor fft plan.
+            if (dir == direction::R2C){
+                cached.plan = VendorCreatePlanR2CMany(
+                    dim, n, howmany,
+                    real_array, nullptr, 1, real_dist,
+                    complex_array, nullptr, 1, complex_dist, FFTW_ESTIMATE);
+            } else if (dir == direction::C2R){
+                cached.plan = VendorCreatePlanC2RMany(
+                    dim, n, howmany,
+                    complex_array, nullptr, 1, complex_dist,
+                    real_array, nullptr, 1, real_dist, FFTW_ESTIMATE);
             }
         }
+        ++cached.count;
+        fft_plan.m_plan = cached.plan;
 
         // Store meta-data in fft_plan
         fft_plan.m_real_array = real_array;
@@ -84,18 +113,34 @@ namespace ablastr::math::anyfft
 
     void DestroyPlan(FFTplan& fft_plan)
     {
+        for (auto it = s_plans.begin(); it != s_plans.end(); ++it) {
+            if (it->second.plan != fft_plan.m_plan) { continue; }
+            if (--(it->second.count) == 0) {
 #  ifdef AMREX_USE_FLOAT
-        fftwf_destroy_plan( fft_plan.m_plan );
+                fftwf_destroy_plan( it->second.plan );
 #  else
-        fftw_destroy_plan( fft_plan.m_plan );
+                fftw_destroy_plan( it->second.plan );
 #  endif
+                s_plans.erase(it);
+            }
+            break;
+        }
     }
 
     void Execute(FFTplan& fft_plan){
+        // The plan may be shared with other boxes: execute it on the arrays of this box
+        if (fft_plan.m_dir == direction::R2C){
 #  ifdef AMREX_USE_FLOAT
-        fftwf_execute( fft_plan.m_plan );
+            fftwf_execute_dft_r2c( fft_plan.m_plan, fft_plan.m_real_array, fft_plan.m_complex_array );
 #  else
-        fftw_execute( fft_plan.m_plan );
+            fftw_execute_dft_r2c( fft_plan.m_plan, fft_plan.m_real_array, fft_plan.m_complex_array );
 #  endif
+        } else {
+#  ifdef AMREX_USE_FLOAT
+            fftwf_execute_dft_c2r( fft_plan.m_plan, fft_plan.m_complex_array, fft_plan.m_real_array );
+#  else
+            fftw_execute_dft_c2r( fft_plan.m_plan, fft_plan.m_complex_array, fft_plan.m_real_array );
+#  endif
+        }
     }
 }
@@ -9,6 +9,11 @@
 
 #include "ablastr/utils/TextMsg.H"
 
+#include <array>
+#include <map>
+#include <string>
+#include <tuple>
+
 namespace ablastr::math::anyfft
 {
     void setup()
@@ -30,10 +35,23 @@ namespace ablastr::math::anyfft
             ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(status == rocfft_status_success,
                 name + " failed! Error: " + rocfftErrorToString(status));
         }
+
+        /** Plan shared by all the boxes of the same shape */
+        struct CachedPlan
+        {
+            rocfft_plan plan = nullptr;
+            int count = 0; /**< number of FFTplan that use this plan */
+        };
+
+        /** Shape, direction, dimensionality and number of transforms of a plan */
+        using PlanKey = std::tuple<std::array<std::size_t,3>, direction, int, int>;
+
+        std::map<PlanKey, CachedPlan> s_plans;
     }
 
     FFTplan CreatePlan (const amrex::IntVect& real_size, amrex::Real * const real_array,
-                        Complex * const complex_array, const direction dir, const int dim)
+                        Complex * const complex_array, const direction dir, const int dim,
+                        const int howmany)
     {
         FFTplan fft_plan;
 
@@ -41,23 +59,31 @@ namespace ablastr::math::anyfft
                                                     std::size_t(real_size[1]),
                                                     std::size_t(real_size[2]))};
 
-        // Initialize fft_plan.m_plan with the vendor fft plan.
-        rocfft_status result = rocfft_plan_create(&(fft_plan.m_plan),
-                                                  rocfft_placement_notinplace,
-                                                  (dir == direction::R2C)
-                                                      ? rocfft_transform_type_real_forward
-                                                      : rocfft_transform_type_real_inverse,
+        // Reuse the plan of a box of the same shape, if any
+        std::array<std::size_t,3> shape{0, 0, 0};
+        for (int d = 0; d < dim; ++d) { shape[d] = lengths[d]; }
+        auto& cached = s_plans[PlanKey{shape, dir, dim, howmany}];
+        if (cached.count == 0) {
+            // Initialize the vendor fft plan.
+            rocfft_status result = rocfft_plan_create(&(cached.plan),
+                                                      rocfft_placement_notinplace,
+                                                      (dir == direction::R2C)
+                                                          ? rocfft_transform_type_real_forward
+                                                          : rocfft_transform_type_real_inverse,
 #ifdef AMREX_USE_FLOAT
-                                                  rocfft_precision_single,
+                                                      rocfft_precision_single,
 #else
-                                                  rocfft_precision_double,
+                                                      rocfft_precision_double,
 #endif
-                                                  dim, lengths,
-                                                  1, // number of transforms,
-                                                  nullptr);
-        assert_rocfft_status("rocfft_plan_create", result);
+                                                      dim, lengths,
+                                                      howmany, // number of transforms,
+                                                      nullptr);
+            assert_rocfft_status("rocfft_plan_create", result);
+        }
+        ++cached.count;
 
         // Store meta-data in fft_plan
+        fft_plan.m_plan = cached.plan;
         fft_plan.m_real_array = real_array;
         fft_plan.m_complex_array = complex_array;
         fft_plan.m_dir = dir;
@@ -68,7 +94,14 @@ namespace ablastr::math::anyfft
 
     void DestroyPlan (FFTplan& fft_plan)
     {
-        rocfft_plan_destroy( fft_plan.m_plan );
+        for (auto it = s_plans.begin(); it != s_plans.end(); ++it) {
+            if (it->second.plan != fft_plan.m_plan) { continue; }
+            if (--(it->second.count) == 0) {
+                rocfft_plan_destroy( it->second.plan );
+                s_plans.erase(it);
+            }
+            break;
+        }
     }
 
     void Execute (FFTplan& fft_plan)
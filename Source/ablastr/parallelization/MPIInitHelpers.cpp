@@ -20,11 +20,13 @@
 #include <hip/hip_runtime.h>
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <utility>
 #include <stdexcept>
 #include <sstream>
+#include <vector>
 
 
 namespace ablastr::parallelization
@@ -107,4 +109,38 @@ namespace ablastr::parallelization
 #endif
     }
 
+    std::vector<int>
+    node_of_ranks ()
+    {
+#ifdef AMREX_USE_MPI
+        const MPI_Comm comm = amrex::ParallelDescriptor::Communicator();
+        const int rank = amrex::ParallelDescriptor::MyProc();
+        const int nprocs = amrex::ParallelDescriptor::NProcs();
+
+        // The lowest rank of each node identifies the node
+        MPI_Comm node_comm = MPI_COMM_NULL;
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+        int node_leader = rank;
+        MPI_Allreduce(&rank, &node_leader, 1, MPI_INT, MPI_MIN, node_comm);
+        MPI_Comm_free(&node_comm);
+
+        std::vector<int> leaders(nprocs);
+        MPI_Allgather(&node_leader, 1, MPI_INT, leaders.data(), 1, MPI_INT, comm);
+
+        std::vector<int> sorted_leaders = leaders;
+        std::sort(sorted_leaders.begin(), sorted_leaders.end());
+        sorted_leaders.erase(std::unique(sorted_leaders.begin(), sorted_leaders.end()),
+                             sorted_leaders.end());
+        std::vector<int> nodes(nprocs);
+        for (int r = 0; r < nprocs; ++r) {
+            nodes[r] = static_cast<int>(
+                std::lower_bound(sorted_leaders.begin(), sorted_leaders.end(), leaders[r])
+                - sorted_leaders.begin());
+        }
+        return nodes;
+#else
+        return std::vector<int>(1, 0);
+#endif
+    }
+
 } // namespace ablastr::parallelization
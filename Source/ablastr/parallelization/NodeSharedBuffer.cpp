@@ -0,0 +1,117 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of ABLASTR.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "NodeSharedBuffer.H"
+
+#include "ablastr/utils/TextMsg.H"
+
+#include <AMReX_INT.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <algorithm>
+#include <fstream>
+
+namespace ablastr::parallelization
+{
+    namespace
+    {
+        /** Read the whole file into dst, which must hold size bytes */
+        void read_file (const std::string& filename, char* dst, std::size_t size)
+        {
+            std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+            ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(ifs.is_open(), "Failed to open file " + filename);
+            ifs.read(dst, static_cast<std::streamsize>(size));
+            ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(ifs.good(), "Failed to read file " + filename);
+        }
+
+        /** Size of the file in bytes */
+        std::size_t file_size (const std::string& filename)
+        {
+            std::ifstream ifs(filename, std::ios::in | std::ios::binary | std::ios::ate);
+            ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(ifs.is_open(), "Failed to open file " + filename);
+            return static_cast<std::size_t>(ifs.tellg());
+        }
+    }
+
+    NodeSharedBuffer::NodeSharedBuffer (const std::string& filename)
+    {
+        const bool is_io_proc = amrex::ParallelDescriptor::IOProcessor();
+
+        auto size = static_cast<amrex::Long>(is_io_proc ? file_size(filename) : 0);
+        amrex::ParallelDescriptor::Bcast(&size, 1, amrex::ParallelDescriptor::IOProcessorNumber());
+        m_size = static_cast<std::size_t>(size);
+
+#if defined(AMREX_USE_MPI)
+        MPI_Comm const comm = amrex::ParallelDescriptor::Communicator();
+        int rank = 0;
+        MPI_Comm_rank(comm, &rank);
+
+        // ranks that share memory, and one leader (node_rank 0) per node
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &m_node_comm);
+        int node_rank = 0;
+        MPI_Comm_rank(m_node_comm, &node_rank);
+        const int is_leader = (node_rank == 0) ? 1 : 0;
+        MPI_Comm leaders_comm = MPI_COMM_NULL;
+        MPI_Comm_split(comm, is_leader ? 0 : MPI_UNDEFINED, rank, &leaders_comm);
+
+        char* base = nullptr;
+        MPI_Win_allocate_shared(
+            static_cast<MPI_Aint>(is_leader ? m_size : 0), 1, MPI_INFO_NULL, m_node_comm,
+            &base, &m_win);
+        if (!is_leader) {
+            MPI_Aint leader_size = 0;
+            int disp_unit = 0;
+            MPI_Win_shared_query(m_win, 0, &leader_size, &disp_unit, &base);
+        }
+        MPI_Win_fence(0, m_win);
+
+        if (is_leader) {
+            // root of the broadcast: the leader of the node of the I/O processor
+            int io_leader = is_io_proc ? rank : -1;
+            MPI_Allreduce(MPI_IN_PLACE, &io_leader, 1, MPI_INT, MPI_MAX, leaders_comm);
+            ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(io_leader >= 0,
+                "NodeSharedBuffer: the I/O processor must be the first rank of its node");
+            int io_leader_in_leaders = 0;
+            {
+                MPI_Group group_comm, group_leaders;
+                MPI_Comm_group(comm, &group_comm);
+                MPI_Comm_group(leaders_comm, &group_leaders);
+                MPI_Group_translate_ranks(group_comm, 1, &io_leader, group_leaders,
+                                          &io_leader_in_leaders);
+                MPI_Group_free(&group_comm);
+                MPI_Group_free(&group_leaders);
+            }
+
+            if (is_io_proc) { read_file(filename, base, m_size); }
+
+            // broadcast in chunks, since MPI counts are int
+            constexpr std::size_t max_chunk = std::size_t(1) << 30;
+            for (std::size_t offset = 0; offset < m_size; offset += max_chunk) {
+                const std::size_t chunk = std::min(max_chunk, m_size - offset);
+                MPI_Bcast(base + offset, static_cast<int>(chunk), MPI_CHAR,
+                          io_leader_in_leaders, leaders_comm);
+            }
+            MPI_Comm_free(&leaders_comm);
+        }
+
+        MPI_Win_fence(0, m_win);
+        m_data = base;
+#else
+        m_local_data.resize(m_size);
+        read_file(filename, m_local_data.data(), m_size);
+        m_data = m_local_data.data();
+#endif
+    }
+
+    NodeSharedBuffer::~NodeSharedBuffer ()
+    {
+#if defined(AMREX_USE_MPI)
+        if (m_win != MPI_WIN_NULL) { MPI_Win_free(&m_win); }
+        if (m_node_comm != MPI_COMM_NULL) { MPI_Comm_free(&m_node_comm); }
+#endif
+    }
+
+} // namespace ablastr::parallelization
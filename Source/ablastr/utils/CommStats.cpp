@@ -0,0 +1,120 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "CommStats.H"
+
+#include <AMReX_GpuDevice.H>
+#include <AMReX_Utility.H>
+
+#include <utility>
+#include <vector>
+
+
+namespace ablastr::utils::communication
+{
+
+namespace
+{
+    /** Call sites currently entered, the innermost last */
+    std::vector<std::string> s_sites;
+    /** Call sites of the non-blocking communications in flight */
+    std::map<void const*, std::string> s_pending;
+    /** Accumulated counters of each call site */
+    std::map<std::string, CommSiteStats> s_stats;
+
+    std::string const& currentSite ()
+    {
+        static std::string const other = "other";
+        return s_sites.empty() ? other : s_sites.back();
+    }
+} // namespace
+
+void CommStats::Enable (bool enable)
+{
+    if (enable && !m_enabled) {
+        s_stats.clear();
+        s_pending.clear();
+    }
+    m_enabled = enable;
+}
+
+void CommStats::PushSite (std::string const& site)
+{
+    s_sites.push_back(site);
+}
+
+void CommStats::PopSite ()
+{
+    if (!s_sites.empty()) { s_sites.pop_back(); }
+}
+
+void CommStats::RecordExchange (amrex::FabArrayBase::CommMetaData const& md,
+                                int ncomp, std::size_t value_size)
+{
+    if (!m_enabled) { return; }
+
+    auto const count = [&] (auto const& tags, double& messages, double& bytes) {
+        if (!tags) { return; }
+        for (auto const& rank_tags : *tags) {
+            messages += 1.;
+            for (auto const& tag : rank_tags.second) {
+                bytes += static_cast<double>(tag.sbox.numPts()) * ncomp * value_size;
+            }
+        }
+    };
+
+    auto& stats = s_stats[currentSite()];
+    count(md.m_SndTags, stats.messages_sent, stats.bytes_sent);
+    count(md.m_RcvTags, stats.messages_received, stats.bytes_received);
+}
+
+void CommStats::StartPending (void const* key)
+{
+    if (!m_enabled) { return; }
+    s_pending[key] = currentSite();
+}
+
+void CommStats::RecordWait (double time, void const* key)
+{
+    if (!m_enabled) { return; }
+
+    std::string site = currentSite();
+    if (key) {
+        auto const it = s_pending.find(key);
+        if (it != s_pending.end()) {
+            site = std::move(it->second);
+            s_pending.erase(it);
+        }
+    }
+    auto& stats = s_stats[site];
+    stats.calls += 1.;
+    stats.wait_time += time;
+}
+
+std::map<std::string, CommSiteStats> CommStats::GetAndReset ()
+{
+    std::map<std::string, CommSiteStats> stats;
+    std::swap(stats, s_stats);
+    return stats;
+}
+
+ScopedCommWait::ScopedCommWait (void const* key)
+    : m_key{key}
+{
+    if (!CommStats::IsEnabled()) { return; }
+    // do not attribute the kernels launched before the communication to it
+    amrex::Gpu::streamSynchronize();
+    m_start = amrex::second();
+}
+
+ScopedCommWait::~ScopedCommWait ()
+{
+    if (!CommStats::IsEnabled()) { return; }
+    amrex::Gpu::streamSynchronize();
+    CommStats::RecordWait(amrex::second() - m_start, m_key);
+}
+
+} // namespace ablastr::utils::communication
@@ -6,6 +6,9 @@
  */
 #include "Communication.H"
 
+#include "CommStats.H"
+
+#include <AMReX.H>
 #include <AMReX_BaseFab.H>
 #include <AMReX_BLProfiler.H>
 #include <AMReX_IntVect.H>
@@ -18,13 +21,147 @@
 #include <AMReX_ParmParse.H>
 
 #include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 
 namespace ablastr::utils::communication
 {
 
+namespace
+{
+    using CommBuffer = amrex::FabArray<amrex::BaseFab<comm_float_type> >;
+    using CommBufferKey = std::pair<amrex::BDKey, std::vector<int> >;
+
+    /** A single-precision buffer, and whether a communication currently uses it */
+    struct CommBufferSlot
+    {
+        std::unique_ptr<CommBuffer> buffer;
+        bool in_use = false;
+    };
+
+    /** Persistent state of the communication routines, kept between calls */
+    struct CommCache
+    {
+        //! buffers per layout (std::deque, so that slots are not moved when adding more)
+        std::map<CommBufferKey, std::deque<CommBufferSlot> > buffers;
+        //! buffers of the FillBoundary operations that were started but not finished
+        std::map<amrex::MultiFab const*, CommBufferSlot*> in_flight;
+        //! buffers, components and updated guard cells of the SumBoundary operations in flight
+        std::map<amrex::MultiFab const*, std::tuple<CommBufferSlot*, int, int, amrex::IntVect> > sum_in_flight;
+        std::optional<bool> always_sync;
+        bool finalize_registered = false;
+    };
+
+    CommCache& GetCommCache ()
+    {
+        static CommCache cache;
+        return cache;
+    }
+
+    /** Whether ablastr.fillboundary_always_sync is set, read only once */
+    bool AlwaysSync ()
+    {
+        auto& cache = GetCommCache();
+        if (!cache.always_sync.has_value()) {
+            const amrex::ParmParse pp_ablastr("ablastr");
+            bool do_nodal_sync_input = false;
+            pp_ablastr.query("fillboundary_always_sync", do_nodal_sync_input);
+            cache.always_sync = do_nodal_sync_input;
+        }
+        return cache.always_sync.value();
+    }
+
+    /** Reserve a single-precision buffer with the same layout as mf
+     *
+     * A free buffer of the same layout is reused if there is one, otherwise a
+     * new one is allocated. The buffer holds a copy of the BoxArray and
+     * DistributionMapping of mf, so that their reference IDs stay valid as
+     * long as the buffer is cached. The buffer must be given back with
+     * ReleaseCommBuffer.
+     */
+    CommBufferSlot& AcquireCommBuffer (amrex::MultiFab const& mf, int ncomp)
+    {
+        auto& cache = GetCommCache();
+
+        std::vector<int> layout;
+        const amrex::IntVect ixtype = mf.ixType().toIntVect();
+        const amrex::IntVect ngrow = mf.nGrowVect();
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            layout.push_back(ixtype[idim]);
+            layout.push_back(ngrow[idim]);
+        }
+        layout.push_back(ncomp);
+
+        auto& slots = cache.buffers[CommBufferKey{mf.getBDKey(), layout}];
+        auto slot = std::find_if(slots.begin(), slots.end(),
+                                 [] (CommBufferSlot const& s) { return !s.in_use; });
+        if (slot == slots.end()) {
+            slots.emplace_back();
+            slot = std::prev(slots.end());
+            slot->buffer = std::make_unique<CommBuffer>(mf.boxArray(), mf.DistributionMap(), ncomp, ngrow);
+            // the buffers must be freed before the memory arenas are
+            if (!cache.finalize_registered) {
+                amrex::ExecOnFinalize([] () {
+                    ClearCommBuffers();
+                    GetCommCache().finalize_registered = false;
+                });
+                cache.finalize_registered = true;
+            }
+        }
+        slot->in_use = true;
+        return *slot;
+    }
+
+    void ReleaseCommBuffer (CommBufferSlot& slot)
+    {
+        slot.in_use = false;
+    }
+
+    /** Size of the values exchanged */
+    std::size_t commValueSize (bool do_single_precision_comms)
+    {
+        return do_single_precision_comms ? sizeof(comm_float_type) : sizeof(amrex::Real);
+    }
+
+    /** Count the messages and bytes of a FillBoundary of mf */
+    void RecordFillBoundary (amrex::MultiFab const& mf, amrex::IntVect const& ng,
+                             bool do_single_precision_comms, const amrex::Periodicity &period,
+                             bool do_nodal_sync)
+    {
+        if (!CommStats::IsEnabled()) { return; }
+        CommStats::RecordExchange(mf.getFB(ng, period, false, false, do_nodal_sync),
+                                  mf.nComp(), commValueSize(do_single_precision_comms));
+    }
+
+    /** Count the messages and bytes of a ParallelCopy (or SumBoundary) from src to dst */
+    void RecordParallelCopy (amrex::MultiFab const& dst, amrex::MultiFab const& src, int num_comp,
+                             amrex::IntVect const& src_nghost, amrex::IntVect const& dst_nghost,
+                             bool do_single_precision_comms, const amrex::Periodicity &period)
+    {
+        if (!CommStats::IsEnabled()) { return; }
+        CommStats::RecordExchange(dst.getCPC(dst_nghost, src, src_nghost, period),
+                                  num_comp, commValueSize(do_single_precision_comms));
+    }
+} // namespace
+
+void ClearCommBuffers ()
+{
+    auto& cache = GetCommCache();
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(cache.in_flight.empty(),
+        "ClearCommBuffers: a FillBoundary_nowait was not finished");
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(cache.sum_in_flight.empty(),
+        "ClearCommBuffers: a SumBoundary_nowait was not finished");
+    cache.buffers.clear();
+    cache.always_sync.reset();
+}
+
 void ParallelCopy(amrex::MultiFab &dst, const amrex::MultiFab &src, int src_comp, int dst_comp, int num_comp,
                   const amrex::IntVect &src_nghost, const amrex::IntVect &dst_nghost,
                   bool do_single_precision_comms, const amrex::Periodicity &period,
@@ -32,6 +169,9 @@ void ParallelCopy(amrex::MultiFab &dst, const amrex::MultiFab &src, int src_comp
 {
     BL_PROFILE("ablastr::utils::communication::ParallelCopy");
 
+    RecordParallelCopy(dst, src, num_comp, src_nghost, dst_nghost, do_single_precision_comms, period);
+    const ScopedCommWait comm_wait;
+
     using ablastr::utils::communication::comm_float_type;
 
     if (do_single_precision_comms)
@@ -80,19 +220,16 @@ void FillBoundary (amrex::MultiFab &mf,
     // nodal_sync argument
     const bool do_nodal_sync_arg = nodal_sync.value_or(false);
 
-    const amrex::ParmParse pp_ablastr("ablastr");
-    bool do_nodal_sync_input = false;
-    pp_ablastr.query("fillboundary_always_sync", do_nodal_sync_input);
-
     // logic: inputs overwrite argument unless argument is true
-    bool const do_nodal_sync = do_nodal_sync_arg || do_nodal_sync_input;
+    bool const do_nodal_sync = do_nodal_sync_arg || AlwaysSync();
+
+    RecordFillBoundary(mf, ng, do_single_precision_comms, period, do_nodal_sync);
+    const ScopedCommWait comm_wait;
 
     if (do_single_precision_comms)
     {
-        amrex::FabArray<amrex::BaseFab<comm_float_type> > mf_tmp(mf.boxArray(),
-                                                            mf.DistributionMap(),
-                                                            mf.nComp(),
-                                                            mf.nGrowVect());
+        CommBufferSlot& slot = AcquireCommBuffer(mf, mf.nComp());
+        CommBuffer& mf_tmp = *slot.buffer;
 
         mixedCopy(mf_tmp, mf, 0, 0, mf.nComp(), mf.nGrowVect());
 
@@ -103,6 +240,7 @@ void FillBoundary (amrex::MultiFab &mf,
         }
 
         mixedCopy(mf, mf_tmp, 0, 0, mf.nComp(), mf.nGrowVect());
+        ReleaseCommBuffer(slot);
     }
     else
     {
@@ -114,6 +252,86 @@ void FillBoundary (amrex::MultiFab &mf,
     }
 }
 
+void FillBoundary_nowait (amrex::MultiFab &mf,
+                          amrex::IntVect ng,
+                          bool do_single_precision_comms,
+                          const amrex::Periodicity &period,
+                          std::optional<bool> nodal_sync)
+{
+    BL_PROFILE("ablastr::utils::communication::FillBoundary_nowait");
+
+    // logic: inputs overwrite argument unless argument is true
+    bool const do_nodal_sync = nodal_sync.value_or(false) || AlwaysSync();
+
+    RecordFillBoundary(mf, ng, do_single_precision_comms, period, do_nodal_sync);
+    CommStats::StartPending(&mf);
+
+    if (do_single_precision_comms)
+    {
+        auto& cache = GetCommCache();
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(cache.in_flight.count(&mf) == 0,
+            "FillBoundary_nowait: a FillBoundary of this MultiFab is already in flight");
+
+        CommBufferSlot& slot = AcquireCommBuffer(mf, mf.nComp());
+        cache.in_flight[&mf] = &slot;
+        CommBuffer& mf_tmp = *slot.buffer;
+
+        mixedCopy(mf_tmp, mf, 0, 0, mf.nComp(), mf.nGrowVect());
+
+        if (do_nodal_sync) {
+            mf_tmp.FillBoundaryAndSync_nowait(0, mf.nComp(), ng, period);
+        } else {
+            mf_tmp.FillBoundary_nowait(ng, period);
+        }
+    }
+    else
+    {
+        if (do_nodal_sync) {
+            mf.FillBoundaryAndSync_nowait(0, mf.nComp(), ng, period);
+        } else {
+            mf.FillBoundary_nowait(ng, period);
+        }
+    }
+}
+
+void FillBoundary_finish (amrex::MultiFab &mf,
+                          bool do_single_precision_comms,
+                          std::optional<bool> nodal_sync)
+{
+    BL_PROFILE("ablastr::utils::communication::FillBoundary_finish");
+
+    bool const do_nodal_sync = nodal_sync.value_or(false) || AlwaysSync();
+    const ScopedCommWait comm_wait(&mf);
+
+    if (do_single_precision_comms)
+    {
+        auto& cache = GetCommCache();
+        auto const it = cache.in_flight.find(&mf);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(it != cache.in_flight.end(),
+            "FillBoundary_finish: no FillBoundary_nowait in flight for this MultiFab");
+        CommBufferSlot& slot = *(it->second);
+        cache.in_flight.erase(it);
+        CommBuffer& mf_tmp = *slot.buffer;
+
+        if (do_nodal_sync) {
+            mf_tmp.FillBoundaryAndSync_finish();
+        } else {
+            mf_tmp.FillBoundary_finish();
+        }
+
+        mixedCopy(mf, mf_tmp, 0, 0, mf.nComp(), mf.nGrowVect());
+        ReleaseCommBuffer(slot);
+    }
+    else
+    {
+        if (do_nodal_sync) {
+            mf.FillBoundaryAndSync_finish();
+        } else {
+            mf.FillBoundary_finish();
+        }
+    }
+}
+
 void FillBoundary (amrex::MultiFab &mf, bool do_single_precision_comms, const amrex::Periodicity &period, std::optional<bool> nodal_sync)
 {
     amrex::IntVect const ng = mf.n_grow;
@@ -156,17 +374,19 @@ SumBoundary (amrex::MultiFab &mf,
 {
     BL_PROFILE("ablastr::utils::communication::SumBoundary");
 
+    RecordParallelCopy(mf, mf, num_comps, src_ng, dst_ng, do_single_precision_comms, period);
+    const ScopedCommWait comm_wait;
+
     if (do_single_precision_comms)
     {
-        amrex::FabArray<amrex::BaseFab<comm_float_type> > mf_tmp(mf.boxArray(),
-                                                                 mf.DistributionMap(),
-                                                                 num_comps,
-                                                                 mf.nGrowVect());
+        CommBufferSlot& slot = AcquireCommBuffer(mf, num_comps);
+        CommBuffer& mf_tmp = *slot.buffer;
         mixedCopy(mf_tmp, mf, start_comp, 0, num_comps, mf.nGrowVect());
 
         mf_tmp.SumBoundary(0, num_comps, src_ng, dst_ng, period);
 
         mixedCopy(mf, mf_tmp, 0, start_comp, num_comps, dst_ng);
+        ReleaseCommBuffer(slot);
     }
     else
     {
@@ -174,6 +394,66 @@ SumBoundary (amrex::MultiFab &mf,
     }
 }
 
+void
+SumBoundary_nowait (amrex::MultiFab &mf,
+                    int start_comp,
+                    int num_comps,
+                    amrex::IntVect src_ng,
+                    amrex::IntVect dst_ng,
+                    bool do_single_precision_comms,
+                    const amrex::Periodicity &period)
+{
+    BL_PROFILE("ablastr::utils::communication::SumBoundary_nowait");
+
+    RecordParallelCopy(mf, mf, num_comps, src_ng, dst_ng, do_single_precision_comms, period);
+    CommStats::StartPending(&mf);
+
+    if (do_single_precision_comms)
+    {
+        auto& cache = GetCommCache();
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(cache.sum_in_flight.count(&mf) == 0,
+            "SumBoundary_nowait: a SumBoundary of this MultiFab is already in flight");
+
+        CommBufferSlot& slot = AcquireCommBuffer(mf, num_comps);
+        cache.sum_in_flight[&mf] = std::make_tuple(&slot, start_comp, num_comps, dst_ng);
+        CommBuffer& mf_tmp = *slot.buffer;
+        mixedCopy(mf_tmp, mf, start_comp, 0, num_comps, mf.nGrowVect());
+
+        mf_tmp.SumBoundary_nowait(0, num_comps, src_ng, dst_ng, period);
+    }
+    else
+    {
+        mf.SumBoundary_nowait(start_comp, num_comps, src_ng, dst_ng, period);
+    }
+}
+
+void SumBoundary_finish (amrex::MultiFab &mf, bool do_single_precision_comms)
+{
+    BL_PROFILE("ablastr::utils::communication::SumBoundary_finish");
+
+    const ScopedCommWait comm_wait(&mf);
+
+    if (do_single_precision_comms)
+    {
+        auto& cache = GetCommCache();
+        auto const it = cache.sum_in_flight.find(&mf);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(it != cache.sum_in_flight.end(),
+            "SumBoundary_finish: no SumBoundary_nowait in flight for this MultiFab");
+        auto [slot, start_comp, num_comps, dst_ng] = it->second;
+        cache.sum_in_flight.erase(it);
+        CommBuffer& mf_tmp = *(slot->buffer);
+
+        mf_tmp.SumBoundary_finish();
+
+        mixedCopy(mf, mf_tmp, 0, start_comp, num_comps, dst_ng);
+        ReleaseCommBuffer(*slot);
+    }
+    else
+    {
+        mf.SumBoundary_finish();
+    }
+}
+
 void OverrideSync (amrex::MultiFab &mf,
                    bool do_single_precision_comms,
                    const amrex::Periodicity &period)
@@ -184,10 +464,8 @@ void OverrideSync (amrex::MultiFab &mf,
 
     if (do_single_precision_comms)
     {
-        amrex::FabArray<amrex::BaseFab<comm_float_type> > mf_tmp(mf.boxArray(),
-                                                                 mf.DistributionMap(),
-                                                                 mf.nComp(),
-                                                                 mf.nGrowVect());
+        CommBufferSlot& slot = AcquireCommBuffer(mf, mf.nComp());
+        CommBuffer& mf_tmp = *slot.buffer;
 
         mixedCopy(mf_tmp, mf, 0, 0, mf.nComp(), mf.nGrowVect());
 
@@ -195,6 +473,7 @@ void OverrideSync (amrex::MultiFab &mf,
         amrex::OverrideSync(mf_tmp, *msk, period);
 
         mixedCopy(mf, mf_tmp, 0, 0, mf.nComp(), mf.nGrowVect());
+        ReleaseCommBuffer(slot);
     }
     else
     {
@@ -11,18 +11,24 @@
 #include <AMReX_ParmParse.H>
 #include <AMReX_Print.H>
 
+#include <fstream>
 #include <ios>
 #include <string>
+#include <vector>
 
 
 void
-ablastr::utils::write_used_inputs_file (std::string const & filename)
+ablastr::utils::write_used_inputs_file (std::string const & filename,
+                                        std::vector<std::string> const & comments)
 {
     amrex::Print() << "For full input parameters, see the file: " << filename << "\n\n";
 
     if (amrex::ParallelDescriptor::IOProcessor()) {
         std::ofstream jobInfoFile;
         jobInfoFile.open(filename.c_str(), std::ios::out);
+        for (auto const & comment : comments) {
+            jobInfoFile << "# " << comment << "\n";
+        }
         amrex::ParmParse::dumpTable(jobInfoFile, true);
         jobInfoFile.close();
     }
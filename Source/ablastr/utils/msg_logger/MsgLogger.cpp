@@ -13,9 +13,9 @@
 #include <AMReX_ParallelDescriptor.H>
 
 #include <algorithm>
-#include <array>
-#include <memory>
-#include <numeric>
+#include <cstddef>
+#include <map>
+#include <utility>
 
 namespace abl_msg_logger = ablastr::utils::msg_logger;
 namespace abl_ser = ablastr::utils::serialization;
@@ -27,72 +27,66 @@ using namespace abl_msg_logger;
 namespace
 {
     /**
-    * \brief This collective function returns the messages of the "gather rank"
-    * as a byte array.
-    *
-    * @param[in] my_msgs the messages of the current rank
-    * @param[in] gather_rank the ID of the "gather rank"
-    * @param[in] my_rank the ID of the current rank
-    * @return the messages of the "gather rank" as a byte array
+    * Closed intervals [first, last] of MPI ranks, sorted and non-overlapping
     */
-    std::vector<char>
-    get_serialized_gather_rank_msgs(
-        const std::vector<Msg>& my_msgs,
-        int gather_rank,
-        int my_rank);
+    using RankRanges = std::vector<std::pair<int, int>>;
 
     /**
-    * \brief This function generates data to send back to the "gather rank"
-    *
-    * @param[in] serialized_gather_rank_msgs the serialized messages of the gather rank
-    * @param[in] gather_rank_how_many_msgs number of messages of the "gather rank"
-    * @param[in] my_msg_map messages and counters of the current rank (as a map)
-    * @param[in] is_gather_rank true if the rank is the "gather rank", false otherwise
-    * @return a byte array to send back to the "gather rank" (or a dummy vector in case is_gather_rank is true)
+    * Messages merged during the reduction, with their global counters
+    * and the ranges of the emitting ranks
     */
-    std::vector<char>
-    compute_package_for_gather_rank(
-        const std::vector<char>& serialized_gather_rank_msgs,
-        std::int64_t gather_rank_how_many_msgs,
-        const std::map<Msg, std::int64_t>& my_msg_map,
-        bool is_gather_rank
-    );
+    using MsgMap = std::map<Msg, std::pair<std::int64_t, RankRanges>>;
 
     /**
-    * \brief This collective function gathers data generated with compute_package_for_gather_rank
-    * to the gather rank.
-    * If my_rank != gather_rank the function returns dummy data. Otherwise the function returns
-    * a pair containing:
-    * 1) a byte array containing info on messages seen by other ranks
-    * 2) a vector of displacements to access data corresponding to a given rank
+    * \brief This function merges the rank ranges other into ranges,
+    * coalescing contiguous and overlapping intervals
     *
-    * @param[in] package_for_gather_rank a byte array generated by compute_package_for_gather_rank
-    * @param[in] gather_rank the ID of the "gather rank"
-    * @param[in] my_rank the ID of the current rank
-    * @return (see function description)
+    * @param[in,out] ranges the rank ranges to be updated
+    * @param[in] other the rank ranges to be added
     */
-    std::pair<std::vector<char>, std::vector<int>>
-    gather_all_data(
-        const std::vector<char>& package_for_gather_rank,
-        int gather_rank, int my_rank);
+    void merge_rank_ranges(
+        RankRanges& ranges,
+        const RankRanges& other);
 
     /**
-    * \brief This function converts a vector of Msg struct into a byte array
+    * \brief This function converts a MsgMap into a byte array
     *
-    * @param[in] msgs the vector of Msg struct
+    * @param[in] msg_map the messages with counters and rank ranges
     * @return a byte array
     */
-    std::vector<char> serialize_msgs(
-        const std::vector<Msg>& msgs);
+    std::vector<char> serialize_msg_map(
+        const MsgMap& msg_map);
 
     /**
-    * \brief This function converts a byte array into a vector of Msg struct
+    * \brief This function merges the messages of a byte array generated with
+    * serialize_msg_map into msg_map: the counters of identical messages are summed
+    * and their rank ranges are merged.
     *
     * @param[in] serialized the byte array
-    * @return a vector of Msg struct
+    * @param[in,out] msg_map the messages with counters and rank ranges
+    */
+    void merge_serialized_msg_map(
+        const std::vector<char>& serialized,
+        MsgMap& msg_map);
+
+    /**
+    * \brief This collective function reduces the messages of all the ranks
+    * on the root rank along a binomial tree. At each level of the tree a rank
+    * receives the messages of its children and merges them with its own ones,
+    * so that identical messages are sent only once per level and the number of
+    * communication steps grows as log2(num_procs).
+    *
+    * @param[in] msg_map the messages of the current rank
+    * @param[in] my_rank the ID of the current rank
+    * @param[in] root_rank the ID of the rank where the messages are reduced
+    * @param[in] num_procs the number of ranks
+    * @return the messages of all the ranks on the root rank, an empty map otherwise
     */
-    std::vector<Msg> deserialize_msgs(
-        const std::vector<char>& serialized);
+    MsgMap reduce_msg_map(
+        MsgMap msg_map,
+        int my_rank,
+        int root_rank,
+        int num_procs);
 }
 #endif
 
@@ -256,50 +250,42 @@ Logger::collective_gather_msgs_with_counter_and_ranks() const
         return one_rank_gather_msgs_with_counter_and_ranks();
     }
 
-    // Find out who is the "gather rank" and how many messages it has
-    const auto my_msgs = get_msgs();
-    const auto how_many_msgs = static_cast<int>(my_msgs.size());
-    const auto [gather_rank, gather_rank_how_many_msgs] =
-        find_gather_rank_and_its_msgs(how_many_msgs);
+    // Messages of the current rank, emitted by the current rank only
+    auto msg_map = MsgMap{};
+    for (const auto& el : m_messages) {
+        msg_map.emplace(el.first,
+            std::make_pair(el.second, RankRanges{{m_rank, m_rank}}));
+    }
+
+    // Reduce the messages of all the ranks on the I/O rank
+    msg_map = ::reduce_msg_map(
+        std::move(msg_map), m_rank, m_io_rank, m_num_procs);
 
-    // If the "gather rank" has zero messages there are no messages at all
-    if(gather_rank_how_many_msgs == 0) {
+    if (m_rank != m_io_rank) {
         return std::vector<MsgWithCounterAndRanks>{};
     }
 
-    // All the ranks receive the msgs of the "gather rank" as a byte array
-    const auto serialized_gather_rank_msgs =
-        ::get_serialized_gather_rank_msgs(my_msgs, gather_rank, m_rank);
-
-    // Each rank assembles a message to send back to the "gather rank"
-    const bool is_gather_rank = (gather_rank == m_rank);
-    const auto package_for_gather_rank =
-        ::compute_package_for_gather_rank(
-            serialized_gather_rank_msgs,
-            gather_rank_how_many_msgs,
-            m_messages, is_gather_rank);
-
-    // Send back all the data to the "gather rank"
-    const auto [all_data, displacements] =
-        ::gather_all_data(
-            package_for_gather_rank,
-            gather_rank, m_rank);
-
-    // Use the gathered data to generate (on the "gather rank") a vector of all the
-    // messages seen by all the ranks with the corresponding counters and
-    // emitting rank lists.
-    auto msgs_with_counter_and_ranks =
-        compute_msgs_with_counter_and_ranks(
-            m_messages,
-            all_data,
-            displacements,
-            gather_rank);
-
-    // If the current rank is not the I/O rank, send msgs_with_counter_and_ranks
-    // to the I/O rank
-    swap_with_io_rank(
-        msgs_with_counter_and_ranks,
-        gather_rank);
+    // Expand the rank ranges, unless a message is emitted by all the ranks
+    std::vector<MsgWithCounterAndRanks> msgs_with_counter_and_ranks;
+    msgs_with_counter_and_ranks.reserve(msg_map.size());
+    for (const auto& [msg, counter_and_ranges] : msg_map) {
+        const auto& [counter, ranges] = counter_and_ranges;
+        const bool all_ranks = (ranges.size() == 1) &&
+            (ranges.front().first == 0) && (ranges.front().second == m_num_procs-1);
+        auto ranks = std::vector<int>{};
+        if (!all_ranks) {
+            for (const auto& [first, last] : ranges) {
+                for (int rr = first; rr <= last; ++rr) {
+                    ranks.push_back(rr);
+                }
+            }
+        }
+        msgs_with_counter_and_ranks.emplace_back(
+            MsgWithCounterAndRanks{
+                MsgWithCounter{msg, counter},
+                all_ranks,
+                std::move(ranks)});
+    }
 
     return msgs_with_counter_and_ranks;
 #else
@@ -325,339 +311,111 @@ Logger::one_rank_gather_msgs_with_counter_and_ranks() const
 
 #ifdef AMREX_USE_MPI
 
-std::pair<int,int> Logger::find_gather_rank_and_its_msgs(int how_many_msgs) const
+namespace
 {
-    int max_items = 0;
-    int max_rank = 0;
-
-    const auto num_msg =
-        amrex::ParallelDescriptor::Gather(how_many_msgs, m_io_rank);
-
-    const auto m_am_i_io = (m_rank == m_io_rank);
-    if (m_am_i_io){
-        const auto it_max = std::max_element(num_msg.begin(), num_msg.end());
-        max_items = *it_max;
-
-        //In case of an "ex aequo" the I/O rank should be the gather rank
-        max_rank = (max_items == how_many_msgs) ?
-            m_io_rank : static_cast<int>(it_max - num_msg.begin());
-    }
-
-    auto package = std::array<int,2>{max_rank, max_items};
-    amrex::ParallelDescriptor::Bcast(package.data(), 2, m_io_rank);
-
-    return std::make_pair(package[0], package[1]);
-}
-
-std::vector<MsgWithCounterAndRanks>
-Logger::compute_msgs_with_counter_and_ranks(
-    const std::map<Msg,std::int64_t>& my_msg_map,
-    const std::vector<char>& all_data,
-    const std::vector<int>& displacements,
-    const int gather_rank) const
+void merge_rank_ranges(
+    RankRanges& ranges,
+    const RankRanges& other)
 {
-    if(m_rank != gather_rank) { return std::vector<MsgWithCounterAndRanks>{}; }
-
-    std::vector<MsgWithCounterAndRanks> msgs_with_counter_and_ranks;
-
-    // Put messages of the gather rank in msgs_with_counter_and_ranks
-    msgs_with_counter_and_ranks.reserve(my_msg_map.size());
-    for (const auto& el : my_msg_map)
-    {
-        msgs_with_counter_and_ranks.emplace_back(
-            MsgWithCounterAndRanks{
-                MsgWithCounter{el.first, el.second},
-                false,
-                std::vector<int>{m_rank}});
-    }
-
-    // We need a temporary map
-    std::map<Msg, MsgWithCounterAndRanks> tmap;
-
-#ifdef AMREX_USE_OMP
-    #pragma omp parallel for
-#endif
-    for(int rr = 0; rr < m_num_procs; ++rr){ //for each rank
-        if(rr == gather_rank) { // (skip gather_rank)
-            continue;
-        }
-
-        // get counters generated by rank rr
-        auto it = all_data.begin() + displacements[rr];
-        const auto counters_rr = abl_ser::get_out_vec<std::int64_t>(it);
-
-         //for each counter from rank rr
-        std::int64_t c = 0;
-        for (const auto& counter : counters_rr){
-#ifdef AMREX_USE_OMP
-            #pragma omp atomic
-#endif
-            msgs_with_counter_and_ranks[c].msg_with_counter.counter +=
-                counter; //update corresponding global counter
-
-            //and add rank to rank list if it has emitted the message
-            if (counter > 0){
-#ifdef AMREX_USE_OMP
-            #pragma omp critical
-#endif
-                {
-                    msgs_with_counter_and_ranks[c].ranks.push_back(rr);
-                }
-            }
-            c++;
+    ranges.insert(ranges.end(), other.begin(), other.end());
+    std::sort(ranges.begin(), ranges.end());
+
+    auto merged = RankRanges{};
+    merged.reserve(ranges.size());
+    for (const auto& range : ranges){
+        if (!merged.empty() && range.first <= merged.back().second + 1){
+            merged.back().second = std::max(merged.back().second, range.second);
         }
-
-        // for each additional message coming from rank rr
-        const auto how_many_additional_msgs_with_counter = abl_ser::get_out<int>(it);
-        for(int i = 0; i < how_many_additional_msgs_with_counter; ++i){
-
-            //deserialize the message
-            const auto serialized_msg_with_counter = abl_ser::get_out_vec<char>(it);
-            auto msg_with_counter =
-                MsgWithCounter::deserialize(serialized_msg_with_counter.begin());
-
-            //and eventually add it to the temporary map
-#ifdef AMREX_USE_OMP
-            #pragma omp critical
-#endif
-            {
-                if (tmap.find(msg_with_counter.msg) == tmap.end()){
-                    const auto msg_with_counter_and_ranks =
-                        MsgWithCounterAndRanks{
-                            msg_with_counter,
-                            false,
-                            std::vector<int>{rr}
-                        };
-                    tmap[msg_with_counter.msg] = msg_with_counter_and_ranks;
-                }
-                else{
-                    tmap[msg_with_counter.msg].msg_with_counter.counter +=
-                        msg_with_counter.counter;
-                    tmap[msg_with_counter.msg].ranks.push_back(rr);
-                }
-            }
+        else{
+            merged.push_back(range);
         }
     }
 
-    // Check if messages emitted by "gather rank" are actually emitted by all ranks
-    const auto ssize = static_cast<int>(msgs_with_counter_and_ranks.size());
-    for (int i = 0; i < ssize; ++i){
-        const auto how_many =
-            static_cast<int>(msgs_with_counter_and_ranks[i].ranks.size());
-        if(how_many == m_num_procs){
-            msgs_with_counter_and_ranks[i].all_ranks = true;
-            // trick to force free memory
-            std::vector<int>{}.swap(msgs_with_counter_and_ranks[i].ranks);
-        }
-    }
-
-    // Add elements from the temporary map
-    for(const auto& el : tmap){
-        msgs_with_counter_and_ranks.push_back(el.second);
-    }
-
-    // Sort affected ranks lists
-    for(auto& el : msgs_with_counter_and_ranks){
-        std::sort(el.ranks.begin(), el.ranks.end());
-    }
-
-    return msgs_with_counter_and_ranks;
-}
-
-void Logger::swap_with_io_rank(
-    std::vector<MsgWithCounterAndRanks>& msgs_with_counter_and_ranks,
-    int gather_rank) const
-{
-    if (gather_rank != m_io_rank){
-        if(m_rank == gather_rank){
-            auto package = std::vector<char>{};
-            for (const auto& el: msgs_with_counter_and_ranks) {
-                abl_ser::put_in_vec<char>(el.serialize(), package);
-            }
-
-            auto package_size = static_cast<int>(package.size());
-            amrex::ParallelDescriptor::Send(&package_size, 1, m_io_rank, 0);
-            amrex::ParallelDescriptor::Send(package, m_io_rank, 1);
-            const auto list_size = static_cast<int>(msgs_with_counter_and_ranks.size());
-            amrex::ParallelDescriptor::Send(&list_size, 1, m_io_rank, 2);
-        }
-        else if (m_rank == m_io_rank){
-            int vec_size = 0;
-            amrex::ParallelDescriptor::Recv(&vec_size, 1, gather_rank, 0);
-            std::vector<char> package(vec_size);
-            amrex::ParallelDescriptor::Recv(package, gather_rank, 1);
-            int list_size = 0;
-            amrex::ParallelDescriptor::Recv(&list_size, 1, gather_rank, 2);
-            auto it = package.cbegin();
-            for (int i = 0; i < list_size; ++i){
-                const auto vec = abl_ser::get_out_vec<char>(it);
-                msgs_with_counter_and_ranks.emplace_back(
-                    MsgWithCounterAndRanks::deserialize(vec.begin())
-                );
-            }
-        }
-    }
+    ranges = std::move(merged);
 }
 
-namespace
+std::vector<char> serialize_msg_map(
+    const MsgMap& msg_map)
 {
-std::vector<char>
-get_serialized_gather_rank_msgs(
-    const std::vector<Msg>& my_msgs,
-    const int gather_rank,
-    const int my_rank)
-{
-    const bool is_gather_rank = (my_rank == gather_rank);
-
-    auto serialized_gather_rank_msgs = std::vector<char>{};
-    int size_serialized_gather_rank_msgs = 0;
-
-    if (is_gather_rank){
-        serialized_gather_rank_msgs = ::serialize_msgs(my_msgs);
-        size_serialized_gather_rank_msgs = static_cast<int>(
-            serialized_gather_rank_msgs.size());
-    }
-
-    amrex::ParallelDescriptor::Bcast(
-        &size_serialized_gather_rank_msgs, 1, gather_rank);
-
-    if (!is_gather_rank) {
-        serialized_gather_rank_msgs.resize(
-            size_serialized_gather_rank_msgs);
-    }
-
-    amrex::ParallelDescriptor::Bcast(
-        serialized_gather_rank_msgs.data(),
-        size_serialized_gather_rank_msgs, gather_rank);
+    auto serialized = std::vector<char>{};
 
-    return serialized_gather_rank_msgs;
-}
+    abl_ser::put_in(static_cast<int>(msg_map.size()), serialized);
 
-std::vector<char>
-compute_package_for_gather_rank(
-    const std::vector<char>& serialized_gather_rank_msgs,
-    const std::int64_t gather_rank_how_many_msgs,
-    const std::map<Msg, std::int64_t>& my_msg_map,
-    const bool is_gather_rank)
-{
-    if(!is_gather_rank){
-        auto package = std::vector<char>{};
-
-        //generates a copy of the message map
-        auto msgs_to_send = std::map<Msg, std::int64_t>{my_msg_map};
-
-        // For each message of the "gather rank" store how many times
-        // the message has been emitted by the current ranks.
-        const auto gather_rank_msgs =
-            ::deserialize_msgs(serialized_gather_rank_msgs);
-        std::vector<std::int64_t> gather_rank_msg_counters(gather_rank_how_many_msgs);
-        std::int64_t counter = 0;
-        for (const auto& msg : gather_rank_msgs){
-            const auto pp = msgs_to_send.find(msg);
-            if (pp != msgs_to_send.end()){
-                gather_rank_msg_counters[counter] += pp->second;
-                // Remove messages already seen by "gather rank" from
-                // the messages to send back
-                msgs_to_send.erase(msg);
-            }
-            counter++;
-        }
-        abl_ser::put_in_vec(gather_rank_msg_counters, package);
+    for (const auto& [msg, counter_and_ranges] : msg_map){
+        const auto& [counter, ranges] = counter_and_ranges;
+        abl_ser::put_in_vec(msg.serialize(), serialized);
+        abl_ser::put_in(counter, serialized);
 
-        // Add the additional messages seen by the current rank to the package
-        abl_ser::put_in(static_cast<int>(msgs_to_send.size()), package);
-        for (const auto& el : msgs_to_send) {
-            abl_ser::put_in_vec<char>(
-                MsgWithCounter{el.first, el.second}.serialize(), package);
+        auto flat_ranges = std::vector<int>{};
+        flat_ranges.reserve(2*ranges.size());
+        for (const auto& [first, last] : ranges){
+            flat_ranges.push_back(first);
+            flat_ranges.push_back(last);
         }
-
-        return package;
+        abl_ser::put_in_vec(flat_ranges, serialized);
     }
 
-    return std::vector<char>{};
-}
-
-std::pair<std::vector<char>, std::vector<int>>
-gather_all_data(
-    const std::vector<char>& package_for_gather_rank,
-    const int gather_rank, const int my_rank)
-{
-    auto package_lengths = std::vector<int>{};
-    auto all_data = std::vector<char>{};
-    auto displacements = std::vector<int>{};
-
-    if(gather_rank != my_rank){
-        amrex::ParallelDescriptor::Gather(
-            static_cast<int>(package_for_gather_rank.size()), gather_rank);
-        amrex::ParallelDescriptor::Gatherv(
-            package_for_gather_rank.data(),
-            static_cast<int>(package_for_gather_rank.size()),
-            all_data.data(),
-            package_lengths,
-            displacements,
-            gather_rank);
-    }
-    else{
-        const int zero_size = 0;
-        package_lengths =
-            amrex::ParallelDescriptor::Gather(zero_size, gather_rank);
-
-        // Compute displacements
-        // Given (n1, n2, n3, n4, ..., n_n) we need (0, n1, n1+n2, n1+n2+n3, ...),
-        // but partial_sum gives us (n1,n1+n2, n1+n2+n3, n1+n2+n3+n4, ...).
-        // Rotating this last vector by one is just shifting: (n1+n2+n3+n4+...,n1, n1+n2, n1+n2+n3, ...).
-        // Then we just need to replace the first element with zero: (0,n1, n1+n2, n1+n2+n3, ...).
-        displacements.resize(package_lengths.size());
-        std::partial_sum(package_lengths.begin(), package_lengths.end(),
-            displacements.begin());
-        const auto total_sum = displacements.back();
-        std::rotate(displacements.rbegin(),
-            displacements.rbegin()+1,
-            displacements.rend());
-        displacements[0] = 0;
-
-        all_data.resize(total_sum);
-
-        amrex::ParallelDescriptor::Gatherv(
-            static_cast<char*>(nullptr),
-            0,
-            all_data.data(),
-            package_lengths,
-            displacements,
-            gather_rank);
-    }
-    return std::make_pair(all_data, displacements);
+    return serialized;
 }
 
-std::vector<char> serialize_msgs(
-    const std::vector<Msg>& msgs)
+void merge_serialized_msg_map(
+    const std::vector<char>& serialized,
+    MsgMap& msg_map)
 {
-    auto serialized = std::vector<char>{};
+    auto it = serialized.begin();
 
-    const auto how_many = static_cast<int> (msgs.size());
-    abl_ser::put_in (how_many, serialized);
+    const auto how_many = abl_ser::get_out<int>(it);
+    for (int i = 0; i < how_many; ++i){
+        const auto vv = abl_ser::get_out_vec<char>(it);
+        const auto msg = Msg::deserialize(vv.begin());
+        const auto counter = abl_ser::get_out<std::int64_t>(it);
+        const auto flat_ranges = abl_ser::get_out_vec<int>(it);
+
+        auto ranges = RankRanges{};
+        ranges.reserve(flat_ranges.size()/2);
+        for (std::size_t j = 0; j+1 < flat_ranges.size(); j += 2){
+            ranges.emplace_back(flat_ranges[j], flat_ranges[j+1]);
+        }
 
-    for (const auto& msg : msgs){
-        abl_ser::put_in_vec(msg.serialize(), serialized);
+        auto& [global_counter, global_ranges] = msg_map[msg];
+        global_counter += counter;
+        merge_rank_ranges(global_ranges, ranges);
     }
-    return serialized;
 }
 
-std::vector<Msg> deserialize_msgs(
-    const std::vector<char>& serialized)
+MsgMap reduce_msg_map(
+    MsgMap msg_map,
+    const int my_rank,
+    const int root_rank,
+    const int num_procs)
 {
-    auto it = serialized.begin();
-
-    const auto how_many = abl_ser::get_out<int>(it);
-    auto msgs = std::vector<Msg>{};
-    msgs.reserve(how_many);
+    // Ranks relative to the root rank, which is the root of the tree
+    const int rel_rank = (my_rank - root_rank + num_procs) % num_procs;
+
+    for (int mask = 1; mask < num_procs; mask <<= 1){
+        if ((rel_rank & mask) != 0){
+            // Send the messages of the subtree to the parent and leave
+            const int parent = (rel_rank - mask + root_rank) % num_procs;
+            const auto package = ::serialize_msg_map(msg_map);
+            auto package_size = static_cast<int>(package.size());
+            amrex::ParallelDescriptor::Send(&package_size, 1, parent, 0);
+            amrex::ParallelDescriptor::Send(package, parent, 1);
+            return MsgMap{};
+        }
 
-    for (int i = 0; i < how_many; ++i){
-        const auto vv = abl_ser::get_out_vec<char>(it);
-        msgs.emplace_back(Msg::deserialize(vv.begin()));
+        // Receive and merge the messages of the subtree of the child, if any
+        const int rel_child = rel_rank + mask;
+        if (rel_child < num_procs){
+            const int child = (rel_child + root_rank) % num_procs;
+            int package_size = 0;
+            amrex::ParallelDescriptor::Recv(&package_size, 1, child, 0);
+            std::vector<char> package(package_size);
+            amrex::ParallelDescriptor::Recv(package, child, 1);
+            ::merge_serialized_msg_map(package, msg_map);
+        }
     }
 
-    return msgs;
+    return msg_map;
 }
 }
 
@@ -26,7 +26,7 @@ int main(int argc, char* argv[])
 
         auto& warpx = WarpX::GetInstance();
         warpx.InitData();
-        warpx.Evolve();
+        if (!warpx.DryRunPerformance()) { warpx.Evolve(); }
         const auto is_warpx_verbose = warpx.Verbose();
         WarpX::Finalize();
 
@@ -0,0 +1,297 @@
+/* Copyright 2026 agent
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+/*
+ * Microbenchmarks of the particle kernels of WarpX (current deposition, field gather and
+ * momentum pushers), run on synthetic tiles with randomly distributed particles.
+ *
+ * Usage: kernel_benchmarks [bench.tile_sizes = 8 16 32] [bench.ppc = 1 8 32]
+ *                          [bench.shape_orders = 1 2 3] [bench.repetitions = 10]
+ *
+ * The precision is the one of the build (WarpX_PRECISION and WarpX_PARTICLE_PRECISION).
+ * The bandwidth is the nominal one, i.e. the particle and field data that the kernels need
+ * to read and write, divided by the measured time.
+ */
+
+#include "Particles/Deposition/CurrentDeposition.H"
+#include "Particles/Gather/FieldGather.H"
+#include "Particles/Pusher/UpdateMomentumBoris.H"
+#include "Particles/Pusher/UpdateMomentumHigueraCary.H"
+#include "Particles/Pusher/UpdateMomentumVay.H"
+#include "Utils/WarpXConst.H"
+
+#include <AMReX.H>
+#include <AMReX_Box.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_IndexType.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Random.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Utility.H>
+
+#include <cmath>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace amrex::literals;
+
+namespace
+{
+    /** Synthetic particles, uniformly distributed in a tile */
+    struct Particles
+    {
+        amrex::Gpu::DeviceVector<amrex::ParticleReal> x, y, z, ux, uy, uz, w;
+        amrex::Gpu::DeviceVector<amrex::ParticleReal> Ex, Ey, Ez, Bx, By, Bz;
+
+        Particles (long np, amrex::Real length)
+            : x(np), y(np), z(np), ux(np), uy(np), uz(np), w(np),
+              Ex(np), Ey(np), Ez(np), Bx(np), By(np), Bz(np)
+        {
+            auto* px = x.dataPtr(); auto* py = y.dataPtr(); auto* pz = z.dataPtr();
+            auto* pux = ux.dataPtr(); auto* puy = uy.dataPtr(); auto* puz = uz.dataPtr();
+            auto* pw = w.dataPtr();
+            constexpr amrex::ParticleReal u_th = 0.1_prt*PhysConst::c;
+            amrex::ParallelForRNG(np,
+                [=] AMREX_GPU_DEVICE (long ip, amrex::RandomEngine const& engine) {
+                    px[ip] = amrex::Random(engine)*length;
+                    py[ip] = amrex::Random(engine)*length;
+                    pz[ip] = amrex::Random(engine)*length;
+                    pux[ip] = amrex::RandomNormal(0._prt, u_th, engine);
+                    puy[ip] = amrex::RandomNormal(0._prt, u_th, engine);
+                    puz[ip] = amrex::RandomNormal(0._prt, u_th, engine);
+                    pw[ip] = 1._prt;
+                });
+            amrex::Gpu::streamSynchronize();
+        }
+    };
+
+    /** Average time (s) of a kernel over several repetitions, after a warm-up run */
+    template <typename F>
+    double timeKernel (int repetitions, F&& kernel)
+    {
+        kernel();
+        amrex::Gpu::streamSynchronize();
+        const double start = amrex::second();
+        for (int i = 0; i < repetitions; ++i) { kernel(); }
+        amrex::Gpu::streamSynchronize();
+        return (amrex::second() - start)/repetitions;
+    }
+
+    void printHeader ()
+    {
+        amrex::Print() << std::setw(20) << "kernel" << std::setw(7) << "order"
+                       << std::setw(6) << "tile" << std::setw(6) << "ppc"
+                       << std::setw(16) << "particles/s" << std::setw(12) << "GB/s" << "\n";
+    }
+
+    void printResult (const std::string& kernel, int order, int tile_size, int ppc,
+                      long np, double time, double bytes)
+    {
+        amrex::Print() << std::setw(20) << kernel << std::setw(7) << order
+                       << std::setw(6) << tile_size << std::setw(6) << ppc
+                       << std::setw(16) << std::scientific << std::setprecision(3)
+                       << static_cast<double>(np)/time
+                       << std::setw(12) << std::fixed << std::setprecision(2)
+                       << bytes/time*1.e-9 << "\n";
+    }
+
+    /** Benchmark the direct current deposition and the field gather at a given shape order */
+    template <int order>
+    void benchmarkShape (Particles& p, long np, amrex::Box const& tile, int tile_size,
+                         int ppc, int repetitions)
+    {
+        // Staggering of the Yee grid
+        const amrex::IndexType jx_type(amrex::IntVect(AMREX_D_DECL(0,1,1)));
+        const amrex::IndexType jy_type(amrex::IntVect(AMREX_D_DECL(1,0,1)));
+        const amrex::IndexType jz_type(amrex::IntVect(AMREX_D_DECL(1,1,0)));
+        const amrex::IndexType bx_type(amrex::IntVect(AMREX_D_DECL(1,0,0)));
+        const amrex::IndexType by_type(amrex::IntVect(AMREX_D_DECL(0,1,0)));
+        const amrex::IndexType bz_type(amrex::IntVect(AMREX_D_DECL(0,0,1)));
+
+        const int ng = order + 1;
+        amrex::FArrayBox jx(amrex::convert(amrex::grow(tile, ng), jx_type), 1, amrex::The_Async_Arena());
+        amrex::FArrayBox jy(amrex::convert(amrex::grow(tile, ng), jy_type), 1, amrex::The_Async_Arena());
+        amrex::FArrayBox jz(amrex::convert(amrex::grow(tile, ng), jz_type), 1, amrex::The_Async_Arena());
+        amrex::FArrayBox bx(amrex::convert(amrex::grow(tile, ng), bx_type), 1, amrex::The_Async_Arena());
+        amrex::FArrayBox by(amrex::convert(amrex::grow(tile, ng), by_type), 1, amrex::The_Async_Arena());
+        amrex::FArrayBox bz(amrex::convert(amrex::grow(tile, ng), bz_type), 1, amrex::The_Async_Arena());
+        jx.setVal<amrex::RunOn::Device>(0._rt);
+        jy.setVal<amrex::RunOn::Device>(0._rt);
+        jz.setVal<amrex::RunOn::Device>(0._rt);
+        bx.setVal<amrex::RunOn::Device>(1._rt);
+        by.setVal<amrex::RunOn::Device>(1._rt);
+        bz.setVal<amrex::RunOn::Device>(1._rt);
+
+        const auto jx_arr = jx.array();
+        const auto jy_arr = jy.array();
+        const auto jz_arr = jz.array();
+        const auto lo = amrex::lbound(tile);
+        const amrex::IntVect jx_iv = jx_type.toIntVect();
+        const amrex::IntVect jy_iv = jy_type.toIntVect();
+        const amrex::IntVect jz_iv = jz_type.toIntVect();
+
+        const auto* AMREX_RESTRICT x = p.x.dataPtr();
+        const auto* AMREX_RESTRICT y = p.y.dataPtr();
+        const auto* AMREX_RESTRICT z = p.z.dataPtr();
+        const auto* AMREX_RESTRICT ux = p.ux.dataPtr();
+        const auto* AMREX_RESTRICT uy = p.uy.dataPtr();
+        const auto* AMREX_RESTRICT uz = p.uz.dataPtr();
+        const auto* AMREX_RESTRICT w = p.w.dataPtr();
+
+        // Unit cells, starting at the origin
+        const amrex::Real dxi = 1._rt;
+        const amrex::Real xmin = 0._rt;
+        const amrex::Real invvol = 1._rt;
+        constexpr amrex::ParticleReal q = PhysConst::q_e;
+        constexpr amrex::ParticleReal clightsq = 1._prt/(PhysConst::c*PhysConst::c);
+
+        constexpr auto cells_per_particle = static_cast<double>(
+            AMREX_D_TERM((order+1),*(order+1),*(order+1)));
+
+        // Direct current deposition
+        const double t_depos = timeKernel(repetitions, [&] () {
+            amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long ip) {
+                const amrex::ParticleReal gaminv = 1._prt/std::sqrt(1._prt +
+                    (ux[ip]*ux[ip] + uy[ip]*uy[ip] + uz[ip]*uz[ip])*clightsq);
+                doDepositionShapeNKernel<order>(x[ip], y[ip], z[ip], q*w[ip],
+                    ux[ip]*gaminv, uy[ip]*gaminv, uz[ip]*gaminv,
+                    jx_arr, jy_arr, jz_arr, jx_iv, jy_iv, jz_iv, 0._rt,
+                    AMREX_D_DECL(dxi, dxi, dxi), AMREX_D_DECL(xmin, xmin, xmin),
+                    invvol, lo, 1);
+            });
+        });
+        // 7 particle attributes read, 3 current components read and written in each cell
+        printResult("deposition_direct", order, tile_size, ppc, np, t_depos,
+            static_cast<double>(np)*(7.*sizeof(amrex::ParticleReal) +
+                                     6.*cells_per_particle*sizeof(amrex::Real)));
+
+        // Field gather (the current density arrays are used as electric field)
+        const auto ex_arr = jx.const_array();
+        const auto ey_arr = jy.const_array();
+        const auto ez_arr = jz.const_array();
+        const auto bx_arr = bx.const_array();
+        const auto by_arr = by.const_array();
+        const auto bz_arr = bz.const_array();
+        auto* AMREX_RESTRICT Ex = p.Ex.dataPtr();
+        auto* AMREX_RESTRICT Ey = p.Ey.dataPtr();
+        auto* AMREX_RESTRICT Ez = p.Ez.dataPtr();
+        auto* AMREX_RESTRICT Bx = p.Bx.dataPtr();
+        auto* AMREX_RESTRICT By = p.By.dataPtr();
+        auto* AMREX_RESTRICT Bz = p.Bz.dataPtr();
+        const amrex::GpuArray<amrex::Real, 3> dx = {1._rt, 1._rt, 1._rt};
+        const amrex::GpuArray<amrex::Real, 3> xyzmin = {0._rt, 0._rt, 0._rt};
+
+        const double t_gather = timeKernel(repetitions, [&] () {
+            amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long ip) {
+                amrex::ParticleReal Exp = 0._prt, Eyp = 0._prt, Ezp = 0._prt;
+                amrex::ParticleReal Bxp = 0._prt, Byp = 0._prt, Bzp = 0._prt;
+                doGatherShapeN<order, 0>(x[ip], y[ip], z[ip], Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                    ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                    jx_type, jy_type, jz_type, bx_type, by_type, bz_type,
+                    dx, xyzmin, lo, 1);
+                Ex[ip] = Exp; Ey[ip] = Eyp; Ez[ip] = Ezp;
+                Bx[ip] = Bxp; By[ip] = Byp; Bz[ip] = Bzp;
+            });
+        });
+        // 3 positions read, 6 fields written, 6 field components read in each cell
+        printResult("gather", order, tile_size, ppc, np, t_gather,
+            static_cast<double>(np)*(9.*sizeof(amrex::ParticleReal) +
+                                     6.*cells_per_particle*sizeof(amrex::Real)));
+    }
+
+    /** Benchmark the momentum pushers, which do not depend on the shape order */
+    void benchmarkPushers (Particles& p, long np, int tile_size, int ppc, int repetitions)
+    {
+        auto* AMREX_RESTRICT ux = p.ux.dataPtr();
+        auto* AMREX_RESTRICT uy = p.uy.dataPtr();
+        auto* AMREX_RESTRICT uz = p.uz.dataPtr();
+        const auto* AMREX_RESTRICT Ex = p.Ex.dataPtr();
+        const auto* AMREX_RESTRICT Ey = p.Ey.dataPtr();
+        const auto* AMREX_RESTRICT Ez = p.Ez.dataPtr();
+        const auto* AMREX_RESTRICT Bx = p.Bx.dataPtr();
+        const auto* AMREX_RESTRICT By = p.By.dataPtr();
+        const auto* AMREX_RESTRICT Bz = p.Bz.dataPtr();
+        constexpr amrex::ParticleReal q = PhysConst::q_e;
+        constexpr amrex::ParticleReal m = PhysConst::m_e;
+        constexpr amrex::Real dt = 1.e-15_rt;
+        // 3 momenta read and written, 6 fields read
+        const double bytes = static_cast<double>(np)*12.*sizeof(amrex::ParticleReal);
+
+        const double t_boris = timeKernel(repetitions, [&] () {
+            amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long ip) {
+                UpdateMomentumBoris(ux[ip], uy[ip], uz[ip], Ex[ip], Ey[ip], Ez[ip],
+                                    Bx[ip], By[ip], Bz[ip], q, m, dt);
+            });
+        });
+        printResult("push_boris", 0, tile_size, ppc, np, t_boris, bytes);
+
+        const double t_vay = timeKernel(repetitions, [&] () {
+            amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long ip) {
+                UpdateMomentumVay(ux[ip], uy[ip], uz[ip], Ex[ip], Ey[ip], Ez[ip],
+                                  Bx[ip], By[ip], Bz[ip], q, m, dt);
+            });
+        });
+        printResult("push_vay", 0, tile_size, ppc, np, t_vay, bytes);
+
+        const double t_hc = timeKernel(repetitions, [&] () {
+            amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long ip) {
+                UpdateMomentumHigueraCary(ux[ip], uy[ip], uz[ip], Ex[ip], Ey[ip], Ez[ip],
+                                          Bx[ip], By[ip], Bz[ip], q, m, dt);
+            });
+        });
+        printResult("push_higuera_cary", 0, tile_size, ppc, np, t_hc, bytes);
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        const amrex::ParmParse pp_bench("bench");
+        std::vector<int> tile_sizes = {8, 16, 32};
+        std::vector<int> ppcs = {1, 8, 32};
+        std::vector<int> shape_orders = {1, 2, 3};
+        int repetitions = 10;
+        pp_bench.queryarr("tile_sizes", tile_sizes);
+        pp_bench.queryarr("ppc", ppcs);
+        pp_bench.queryarr("shape_orders", shape_orders);
+        pp_bench.query("repetitions", repetitions);
+
+        amrex::Print() << "Precision of the fields: " << sizeof(amrex::Real)*8
+                       << " bits, of the particles: " << sizeof(amrex::ParticleReal)*8
+                       << " bits\n";
+        printHeader();
+
+        for (const int tile_size : tile_sizes) {
+            const amrex::Box tile(amrex::IntVect(0), amrex::IntVect(tile_size-1));
+            for (const int ppc : ppcs) {
+                const long np = tile.numPts()*ppc;
+                Particles p(np, static_cast<amrex::Real>(tile_size));
+                for (const int order : shape_orders) {
+                    if (order == 1) {
+                        benchmarkShape<1>(p, np, tile, tile_size, ppc, repetitions);
+                    } else if (order == 2) {
+                        benchmarkShape<2>(p, np, tile, tile_size, ppc, repetitions);
+                    } else if (order == 3) {
+                        benchmarkShape<3>(p, np, tile, tile_size, ppc, repetitions);
+                    } else if (order == 4) {
+                        benchmarkShape<4>(p, np, tile, tile_size, ppc, repetitions);
+                    } else {
+                        amrex::Abort("bench.shape_orders must be between 1 and 4");
+                    }
+                }
+                benchmarkPushers(p, np, tile_size, ppc, repetitions);
+            }
+        }
+    }
+    amrex::Finalize();
+}
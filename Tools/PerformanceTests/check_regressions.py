@@ -0,0 +1,166 @@
+# Copyright 2026 agent
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+Machine-independent performance regression check.
+
+Runs the automated_test_* inputs of this directory with a WarpX executable, and
+optionally the kernel microbenchmarks (built with -DWarpX_BENCHMARKS=ON). It
+collects the per-phase timings written by the PhaseTimings reduced diagnostics
+and the throughput and bandwidth of the kernels, and compares them to a stored
+baseline. A metric regresses if it is worse than the baseline by more than the
+threshold. The script then exits with a non-zero status.
+
+Example:
+    python check_regressions.py --executable ./warpx.3d --benchmarks ./kernel_benchmarks.3d \\
+        --launcher "mpiexec -n 4" --n_steps 50 --peak_bandwidth 2039 \\
+        --baseline baseline_a100.json
+"""
+
+import argparse
+import glob
+import json
+import os
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+
+script_dir = os.path.dirname(os.path.abspath(__file__))
+
+
+def run_simulation(args, input_file):
+    """Run one input file and return the average (over the outputs, skipping the
+    first one) of the maximum over the MPI ranks of the time of each phase"""
+    run_dir = tempfile.mkdtemp(prefix='warpx_perf_')
+    shutil.copy(input_file, run_dir)
+    command = shlex.split(args.launcher) + [
+        os.path.abspath(args.executable), os.path.basename(input_file),
+        'max_step={}'.format(args.n_steps)]
+    subprocess.run(command, cwd=run_dir, check=True,
+                   stdout=subprocess.DEVNULL)
+
+    timeline = os.path.join(run_dir, 'diags', 'reducedfiles', 'phase_timings.jsonl')
+    with open(timeline) as f:
+        outputs = [json.loads(line) for line in f if line.strip()]
+    # The first output includes the initialization and the warm-up of the caches
+    outputs = outputs[1:] if len(outputs) > 1 else outputs
+
+    metrics = {}
+    for phase in outputs[0]:
+        if phase in ('step', 'time') or not isinstance(outputs[0][phase], dict):
+            continue
+        metrics[phase + '_time'] = sum(o[phase]['max'] for o in outputs)/len(outputs)
+    metrics['step_time'] = sum(o['step']['max'] for o in outputs)/len(outputs)
+    # Load imbalance: ratio of the maximum to the average time of a step
+    metrics['step_imbalance'] = sum(o['step']['max']/max(o['step']['avg'], 1.e-30)
+                                    for o in outputs)/len(outputs)
+
+    if not args.keep_runs:
+        shutil.rmtree(run_dir)
+    return metrics
+
+
+def run_benchmarks(args):
+    """Run the kernel microbenchmarks and return their throughput and bandwidth"""
+    command = shlex.split(args.launcher) + [os.path.abspath(args.benchmarks)]
+    output = subprocess.run(command, check=True, capture_output=True, text=True).stdout
+
+    metrics = {}
+    for line in output.splitlines():
+        words = line.split()
+        # kernel order tile ppc particles/s GB/s
+        if len(words) != 6 or words[0] == 'kernel':
+            continue
+        name = '{}_order{}_tile{}_ppc{}'.format(*words[:4])
+        metrics[name + '_particles_per_s'] = float(words[4])
+        metrics[name + '_GBps'] = float(words[5])
+        if args.peak_bandwidth:
+            metrics[name + '_roofline_fraction'] = float(words[5])/args.peak_bandwidth
+    return metrics
+
+
+def higher_is_better(metric):
+    return metric.endswith(('_particles_per_s', '_GBps', '_roofline_fraction'))
+
+
+def compare(results, baseline, threshold):
+    """Return the list of the metrics that regressed with respect to the baseline"""
+    regressions = []
+    for test, metrics in results.items():
+        for metric, value in metrics.items():
+            reference = baseline.get(test, {}).get(metric)
+            if reference is None or reference == 0.:
+                continue
+            change = value/reference - 1.
+            if higher_is_better(metric):
+                change = -change
+            if change > threshold:
+                regressions.append((test, metric, reference, value, change))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--executable', help='WarpX executable (3D)')
+    parser.add_argument('--benchmarks', help='kernel_benchmarks executable')
+    parser.add_argument('--tests', default='automated_test_*',
+                        help='glob pattern of the input files to run')
+    parser.add_argument('--launcher', default='',
+                        help='command used to launch the executables, e.g. "mpiexec -n 4"')
+    parser.add_argument('--n_steps', type=int, default=50, help='number of steps of each test')
+    parser.add_argument('--peak_bandwidth', type=float, default=None,
+                        help='peak memory bandwidth of the device (GB/s), for the roofline fraction')
+    parser.add_argument('--baseline', help='JSON file of the baseline results')
+    parser.add_argument('--threshold', type=float, default=0.05,
+                        help='relative degradation above which a metric regresses')
+    parser.add_argument('--output', default='perf_results.json',
+                        help='JSON file in which the results are written')
+    parser.add_argument('--update_baseline', action='store_true',
+                        help='write the results to the baseline file instead of comparing')
+    parser.add_argument('--keep_runs', action='store_true',
+                        help='keep the directories of the simulations')
+    args = parser.parse_args()
+
+    results = {}
+    if args.executable:
+        for input_file in sorted(glob.glob(os.path.join(script_dir, args.tests))):
+            test = os.path.basename(input_file)
+            print('Running ' + test)
+            results[test] = run_simulation(args, input_file)
+    if args.benchmarks:
+        print('Running the kernel benchmarks')
+        results['kernel_benchmarks'] = run_benchmarks(args)
+
+    with open(args.output, 'w') as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+
+    if args.baseline is None:
+        return 0
+    if args.update_baseline:
+        with open(args.baseline, 'w') as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+        print('Baseline written to ' + args.baseline)
+        return 0
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+    regressions = compare(results, baseline, args.threshold)
+    for test, metric, reference, value, change in regressions:
+        print('REGRESSION {}: {} = {:.4g} (baseline {:.4g}, {:+.1f}%)'.format(
+            test, metric, value, reference, 100.*change))
+    if regressions:
+        print('{} metric(s) regressed by more than {:.1f}%'.format(
+            len(regressions), 100.*args.threshold))
+        return 1
+    print('No regression above {:.1f}%'.format(100.*args.threshold))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -459,6 +459,8 @@ function(warpx_print_summary)
         message("    PYTHON IPO: ${WarpX_PYTHON_IPO}")
     endif()
     message("    OPENPMD: ${WarpX_OPENPMD}")
+    message("    PAPI: ${WarpX_PAPI}")
+    message("    CUPTI: ${WarpX_CUPTI}")
     message("    QED: ${WarpX_QED}")
     message("    QED table generation: ${WarpX_QED_TABLE_GEN}")
     message("    QED tools: ${WarpX_QED_TOOLS}")